@@ -44,6 +44,18 @@ Array<std::complex<double>> conj(const Array<std::complex<double>> &carray)
   return arrayTransformResult (carray, [](std::complex<double> v) { return std::conj(v); });
 }
 
+Array<std::complex<float>> conj(const ArrayExecPolicy& policy,
+                                const Array<std::complex<float>> &carray)
+{
+  return arrayTransformResult (policy, carray, [](std::complex<float> v) { return std::conj(v); });
+}
+
+Array<std::complex<double>> conj(const ArrayExecPolicy& policy,
+                                 const Array<std::complex<double>> &carray)
+{
+  return arrayTransformResult (policy, carray, [](std::complex<double> v) { return std::conj(v); });
+}
+
 Matrix<std::complex<float>> conj(const Matrix<std::complex<float>> &carray)
 {
   return Matrix<std::complex<float>>(conj ((const Array<std::complex<float>>&)carray));
@@ -115,6 +127,38 @@ void phase(Array<double> &rarray, const Array<std::complex<double>> &carray)
   arrayTransform (carray, rarray, [](std::complex<double> v) { return std::arg(v); });
 }
 
+Array<float> amplitude(const ArrayExecPolicy& policy,
+                       const Array<std::complex<float>> &carray)
+{
+  Array<float> rarray(carray.shape());
+  arrayTransform (policy, carray, rarray, [](std::complex<float> v) { return std::abs(v); });
+  return rarray;
+}
+
+Array<double> amplitude(const ArrayExecPolicy& policy,
+                        const Array<std::complex<double>> &carray)
+{
+  Array<double> rarray(carray.shape());
+  arrayTransform (policy, carray, rarray, [](std::complex<double> v) { return std::abs(v); });
+  return rarray;
+}
+
+Array<float> phase(const ArrayExecPolicy& policy,
+                   const Array<std::complex<float>> &carray)
+{
+  Array<float> rarray(carray.shape());
+  arrayTransform (policy, carray, rarray, [](std::complex<float> v) { return std::arg(v); });
+  return rarray;
+}
+
+Array<double> phase(const ArrayExecPolicy& policy,
+                    const Array<std::complex<double>> &carray)
+{
+  Array<double> rarray(carray.shape());
+  arrayTransform (policy, carray, rarray, [](std::complex<double> v) { return std::arg(v); });
+  return rarray;
+}
+
 Array<float> real(const Array<std::complex<float>> &carray)
 {
   Array<float> rarray(carray.shape());
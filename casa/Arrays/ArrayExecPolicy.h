@@ -0,0 +1,245 @@
+//# ArrayExecPolicy.h: Execution policy for element-wise Array functions
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_ARRAYEXECPOLICY_2_H
+#define CASA_ARRAYEXECPOLICY_2_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+//    Execution policy for element-wise Array functions.
+// </summary>
+//
+// <reviewed reviewer="" date="" tests="tArrayExecPolicy">
+//
+// <synopsis>
+// An ArrayExecPolicy can be given as the first argument of functions like
+// <src>arrayTransform</src>, <src>arrayTransformInPlace</src>, and
+// math functions like <src>sqrt</src> and <src>amplitude</src> to tell how
+// the elements can be processed. It resembles the execution policies
+// of C++17.
+// <ul>
+//  <li> <src>Sequential</src> processes the elements in order in the
+//       calling thread, as the functions without a policy do.
+//  <li> <src>Parallel</src> splits the elements into chunks of at least
+//       <src>grainSize</src> elements which are processed by multiple
+//       threads using OpenMP.
+//  <li> <src>ParallelUnsequenced</src> is the same as Parallel, but also
+//       tells that the operation on the elements in a chunk can be
+//       vectorized (using <src>omp simd</src>).
+// </ul>
+// The operation has to be thread-safe for the parallel policies and must
+// not throw an exception. Only contiguous arrays are processed in parallel;
+// otherwise the sequential function is used.
+// <br>If casacore is built without OpenMP (see the USE_OPENMP option)
+// the parallel policies process the elements sequentially. Also inside a
+// parallel section no nested threads are started, unless nesting is
+// enabled in OpenMP.
+// <p>
+// The grain size defaults to 65536 elements, which can be changed for all
+// policies using <src>setDefaultGrainSize</src>. It should be large enough
+// to make the overhead of starting the threads negligible.
+// The maximum number of threads defaults to the OpenMP maximum
+// (i.e., env.var. OMP_NUM_THREADS or the number of cores).
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   Array<Complex> vis(IPosition(3,4,4096,100000));
+//   Array<Float> amp = amplitude (ArrayExecPolicy::par(), vis);
+//   arrayTransformInPlace (ArrayExecPolicy::parUnseq(), amp,
+//                          [](Float v) { return v*v; });
+// </srcblock>
+// </example>
+//
+// <motivation>
+// Element-wise operations on image planes of gigabytes should use all
+// cores of a node.
+// </motivation>
+
+class ArrayExecPolicy
+{
+public:
+  enum Mode {
+    Sequential,
+    Parallel,
+    ParallelUnsequenced
+  };
+
+  // Create a policy. A grain size or number of threads 0 means the default.
+  explicit ArrayExecPolicy (Mode mode = Sequential, size_t grainSize = 0,
+                            unsigned maxThreads = 0)
+    : itsMode       (mode),
+      itsGrainSize  (grainSize),
+      itsMaxThreads (maxThreads)
+  {}
+
+  // Create the various policies.
+  // <group>
+  static ArrayExecPolicy seq()
+    { return ArrayExecPolicy (Sequential); }
+  static ArrayExecPolicy par (size_t grainSize = 0, unsigned maxThreads = 0)
+    { return ArrayExecPolicy (Parallel, grainSize, maxThreads); }
+  static ArrayExecPolicy parUnseq (size_t grainSize = 0,
+                                   unsigned maxThreads = 0)
+    { return ArrayExecPolicy (ParallelUnsequenced, grainSize, maxThreads); }
+  // </group>
+
+  Mode mode() const
+    { return itsMode; }
+
+  bool sequential() const
+    { return itsMode == Sequential; }
+
+  bool unsequenced() const
+    { return itsMode == ParallelUnsequenced; }
+
+  // Get the minimum number of elements per chunk.
+  size_t grainSize() const
+    { return itsGrainSize > 0  ?  itsGrainSize : defaultGrainSize(); }
+
+  // Get the maximum number of threads to use.
+  unsigned maxThreads() const
+  {
+#ifdef _OPENMP
+    if (omp_in_parallel()  &&  !omp_get_nested()) {
+      return 1;
+    }
+    return itsMaxThreads > 0  ?  itsMaxThreads : omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+
+  // Get the number of chunks (i.e., threads) to use for n elements.
+  size_t nchunk (size_t n) const
+  {
+    if (itsMode == Sequential) {
+      return 1;
+    }
+    return std::max (size_t(1), std::min (size_t(maxThreads()),
+                                          n / grainSize()));
+  }
+
+  // Get or set the default grain size for all policies.
+  // <group>
+  static size_t defaultGrainSize()
+    { return defaultGrain(); }
+  static void setDefaultGrainSize (size_t grainSize)
+    { defaultGrain() = std::max (size_t(1), grainSize); }
+  // </group>
+
+private:
+  static std::atomic<size_t>& defaultGrain()
+  {
+    static std::atomic<size_t> grain(65536);
+    return grain;
+  }
+
+  Mode     itsMode;
+  size_t   itsGrainSize;
+  unsigned itsMaxThreads;
+};
+
+
+namespace arrays_internal {
+
+  // Process n elements in chunks using the policy. The function is called
+  // as <src>func(start, end)</src> for each chunk.
+  template<typename Func>
+  inline void arrayParallelFor (const ArrayExecPolicy& policy, size_t n,
+                                Func func)
+  {
+    long nchunk = policy.nchunk (n);
+    if (nchunk <= 1) {
+      func (size_t(0), n);
+      return;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nchunk) schedule(static,1)
+#endif
+    for (long i=0; i<nchunk; ++i) {
+      func (n*i/nchunk, n*(i+1)/nchunk);
+    }
+  }
+
+  // Apply the operator to the n elements of contiguous data.
+  // <group>
+  template<typename T, typename RES, typename UnaryOperator>
+  inline void parTransform (const ArrayExecPolicy& policy, size_t n,
+                            const T* in, RES* out, UnaryOperator op)
+  {
+    bool unseq = policy.unsequenced();
+    arrayParallelFor (policy, n, [=](size_t st, size_t end) {
+        if (unseq) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+          for (size_t i=st; i<end; ++i) {
+            out[i] = op(in[i]);
+          }
+        } else {
+          for (size_t i=st; i<end; ++i) {
+            out[i] = op(in[i]);
+          }
+        }
+      });
+  }
+  template<typename L, typename R, typename RES, typename BinaryOperator>
+  inline void parTransform (const ArrayExecPolicy& policy, size_t n,
+                            const L* left, const R* right, RES* out,
+                            BinaryOperator op)
+  {
+    bool unseq = policy.unsequenced();
+    arrayParallelFor (policy, n, [=](size_t st, size_t end) {
+        if (unseq) {
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+          for (size_t i=st; i<end; ++i) {
+            out[i] = op(left[i], right[i]);
+          }
+        } else {
+          for (size_t i=st; i<end; ++i) {
+            out[i] = op(left[i], right[i]);
+          }
+        }
+      });
+  }
+  // </group>
+
+} //# NAMESPACE ARRAYS_INTERNAL - END
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -0,0 +1,440 @@
+//# ArrayExpr.h: Lazy element-wise expressions of Arrays
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_ARRAYEXPR_2_H
+#define CASA_ARRAYEXPR_2_H
+
+#include "Array.h"
+
+#include <cmath>
+#include <complex>
+#include <type_traits>
+#include <utility>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+//    Lazy element-wise expressions of Arrays.
+// </summary>
+// <reviewed reviewer="" date="" tests="tArrayExpr">
+//
+// <prerequisite>
+//   <li> <linkto class=Array>Array</linkto>
+//   <li> ArrayMath
+// </prerequisite>
+//
+// <synopsis>
+// The arithmetic operators and functions in ArrayMath.h create a new
+// Array for each operation, so an expression like
+// <src>a*b + c*conj(d)</src> creates four temporary arrays and reads and
+// writes each of them. For large arrays the memory traffic of these
+// temporaries dominates the time spent.
+// <br>The classes in this file form an expression template layer.
+// Wrapping an array in <src>arrayExpr</src> makes the operators and
+// functions on it build an expression object instead of an array.
+// Nothing is calculated until the expression is assigned to an array
+// using <src>assignExpr</src> (or turned into a new array using
+// <src>evalExpr</src>). The entire expression is then evaluated in a single
+// loop without creating temporaries.
+// <p>
+// The following is supported:
+// <ul>
+//  <li> The binary operators +, -, *, and / of two expressions, an
+//       expression and an Array, or an expression and a scalar.
+//       Mixed types (e.g. a Complex and a Float array) are possible as far
+//       as the element types support the operator.
+//  <li> Unary minus.
+//  <li> The functions conj, real, imag, abs, norm, arg, sqrt, exp, log,
+//       sin, and cos.
+// </ul>
+// All arrays in an expression must have the same shape; otherwise an
+// ArrayConformanceError is thrown when the expression is built.
+// A non-contiguous array (e.g. a slice) is copied when wrapped, so it is
+// better to wrap contiguous arrays only.
+// <br>The evaluation is element by element, so the target array can be used
+// in the expression itself, e.g. to do an in-place update.
+// <p>
+// An expression keeps references to the data of its arrays, so it must
+// be evaluated while the arrays still exist and have not been resized.
+// Usually the expression is a temporary in the <src>assignExpr</src> call.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   Array<Complex> a(shape), b(shape), c(shape), d(shape), res;
+//   ...
+//   // Same result as res = a*b + c*conj(d), but without temporaries.
+//   assignExpr (res, arrayExpr(a)*b + arrayExpr(c)*conj(arrayExpr(d)));
+//   // In-place scaling and addition.
+//   assignExpr (a, arrayExpr(a)*Complex(2,0) + b);
+// </srcblock>
+// </example>
+//
+// <motivation>
+// Element-wise arithmetic on large data cubes (e.g. in calibration) is
+// bound by the memory bandwidth. Fusing the operations removes most of
+// the memory traffic.
+// </motivation>
+//
+// <group name="Array expressions">
+
+// Base class of all expression nodes. It is only used to recognize
+// expression types in the operators.
+class ArrayExprBase
+{};
+
+// Test if a type is an expression node.
+template<typename E> struct IsArrayExpr
+  : std::is_base_of<ArrayExprBase, typename std::decay<E>::type> {};
+
+// Test if a type can be used as a scalar in an expression.
+template<typename S> struct IsArrayExprScalar
+  : std::is_arithmetic<S> {};
+template<typename S> struct IsArrayExprScalar<std::complex<S>>
+  : std::true_type {};
+
+// Leaf node referencing the data of an Array.
+template<typename T>
+class ArrayExprArray : public ArrayExprBase
+{
+public:
+  typedef T value_type;
+
+  template<typename Alloc>
+  explicit ArrayExprArray (const Array<T, Alloc>& arr)
+    : itsShape (arr.shape())
+  {
+    if (arr.contiguousStorage()) {
+      itsData = arr.data();
+    } else {
+      itsCopy.resize (arr.shape());
+      std::copy (arr.begin(), arr.end(), itsCopy.data());
+      itsData = itsCopy.data();
+    }
+  }
+
+  const IPosition& shape() const
+    { return itsShape; }
+
+  T operator[] (size_t i) const
+    { return itsData[i]; }
+
+private:
+  IPosition itsShape;
+  Array<T>  itsCopy;     //# only used for a non-contiguous array
+  const T*  itsData;
+};
+
+// Leaf node for a scalar. It has an empty shape.
+template<typename T>
+class ArrayExprScalar : public ArrayExprBase
+{
+public:
+  typedef T value_type;
+
+  explicit ArrayExprScalar (const T& value)
+    : itsValue (value)
+  {}
+
+  const IPosition& shape() const
+    { return itsShape; }
+
+  T operator[] (size_t) const
+    { return itsValue; }
+
+private:
+  IPosition itsShape;
+  T         itsValue;
+};
+
+// Node applying a binary operation to two nodes.
+template<typename L, typename R, typename Op>
+class ArrayExprBinary : public ArrayExprBase
+{
+public:
+  typedef typename std::decay<decltype(std::declval<Op>()
+                     (std::declval<typename L::value_type>(),
+                      std::declval<typename R::value_type>()))>::type
+                                                              value_type;
+
+  ArrayExprBinary (const L& left, const R& right, const char* name)
+    : itsLeft (left),
+      itsRight (right)
+  {
+    if (left.shape().empty()) {
+      itsShape = right.shape();
+    } else {
+      itsShape = left.shape();
+      if (! right.shape().empty()  &&
+          ! right.shape().isEqual (left.shape())) {
+        throwArrayShapes (left.shape(), right.shape(), name);
+      }
+    }
+  }
+
+  const IPosition& shape() const
+    { return itsShape; }
+
+  value_type operator[] (size_t i) const
+    { return Op() (itsLeft[i], itsRight[i]); }
+
+private:
+  L         itsLeft;
+  R         itsRight;
+  IPosition itsShape;
+};
+
+// Node applying a unary operation to a node.
+template<typename E, typename Op>
+class ArrayExprUnary : public ArrayExprBase
+{
+public:
+  typedef typename std::decay<decltype(std::declval<Op>()
+                     (std::declval<typename E::value_type>()))>::type
+                                                              value_type;
+
+  explicit ArrayExprUnary (const E& expr)
+    : itsExpr (expr)
+  {}
+
+  const IPosition& shape() const
+    { return itsExpr.shape(); }
+
+  value_type operator[] (size_t i) const
+    { return Op() (itsExpr[i]); }
+
+private:
+  E itsExpr;
+};
+
+// The operations used in the expression nodes.
+namespace ArrayExprOp {
+  struct Plus {
+    template<typename A, typename B>
+    auto operator() (const A& a, const B& b) const -> decltype(a+b)
+      { return a+b; }
+  };
+  struct Minus {
+    template<typename A, typename B>
+    auto operator() (const A& a, const B& b) const -> decltype(a-b)
+      { return a-b; }
+  };
+  struct Multiplies {
+    template<typename A, typename B>
+    auto operator() (const A& a, const B& b) const -> decltype(a*b)
+      { return a*b; }
+  };
+  struct Divides {
+    template<typename A, typename B>
+    auto operator() (const A& a, const B& b) const -> decltype(a/b)
+      { return a/b; }
+  };
+  struct Negate {
+    template<typename A>
+    A operator() (const A& a) const
+      { return -a; }
+  };
+  struct Conj {
+    template<typename A>
+    std::complex<A> operator() (const std::complex<A>& a) const
+      { return std::conj(a); }
+    template<typename A>
+    A operator() (const A& a) const
+      { return a; }
+  };
+  struct Real {
+    template<typename A>
+    A operator() (const std::complex<A>& a) const
+      { return a.real(); }
+    template<typename A>
+    A operator() (const A& a) const
+      { return a; }
+  };
+  struct Imag {
+    template<typename A>
+    A operator() (const std::complex<A>& a) const
+      { return a.imag(); }
+    template<typename A>
+    A operator() (const A&) const
+      { return A(0); }
+  };
+  struct Norm {
+    template<typename A>
+    A operator() (const std::complex<A>& a) const
+      { return a.real()*a.real() + a.imag()*a.imag(); }
+    template<typename A>
+    A operator() (const A& a) const
+      { return a*a; }
+  };
+  struct Arg {
+    template<typename A>
+    A operator() (const std::complex<A>& a) const
+      { return std::arg(a); }
+    template<typename A>
+    A operator() (const A& a) const
+      { return a < A(0)  ?  A(M_PI) : A(0); }
+  };
+  struct Abs {
+    template<typename A>
+    auto operator() (const A& a) const -> decltype(std::abs(a))
+      { return std::abs(a); }
+  };
+  struct Sqrt {
+    template<typename A>
+    auto operator() (const A& a) const -> decltype(std::sqrt(a))
+      { return std::sqrt(a); }
+  };
+  struct Exp {
+    template<typename A>
+    auto operator() (const A& a) const -> decltype(std::exp(a))
+      { return std::exp(a); }
+  };
+  struct Log {
+    template<typename A>
+    auto operator() (const A& a) const -> decltype(std::log(a))
+      { return std::log(a); }
+  };
+  struct Sin {
+    template<typename A>
+    auto operator() (const A& a) const -> decltype(std::sin(a))
+      { return std::sin(a); }
+  };
+  struct Cos {
+    template<typename A>
+    auto operator() (const A& a) const -> decltype(std::cos(a))
+      { return std::cos(a); }
+  };
+}
+
+// Wrap an Array to start an expression.
+template<typename T, typename Alloc>
+inline ArrayExprArray<T> arrayExpr (const Array<T, Alloc>& arr)
+  { return ArrayExprArray<T> (arr); }
+
+// Evaluate the expression and store the result in the target array.
+// If the target array is empty, it is resized to the shape of the
+// expression. Otherwise the shapes must be equal.
+template<typename T, typename Alloc, typename E>
+void assignExpr (Array<T, Alloc>& target, const E& expr)
+{
+  static_assert (IsArrayExpr<E>::value,
+                 "assignExpr needs an array expression");
+  if (target.empty()) {
+    target.resize (expr.shape());
+  } else if (! target.shape().isEqual (expr.shape())) {
+    throwArrayShapes (target.shape(), expr.shape(), "assignExpr");
+  }
+  size_t n = target.nelements();
+  if (target.contiguousStorage()) {
+    T* data = target.data();
+    for (size_t i=0; i<n; ++i) {
+      data[i] = expr[i];
+    }
+  } else {
+    size_t i = 0;
+    for (auto iter=target.begin(); iter!=target.end(); ++iter, ++i) {
+      *iter = expr[i];
+    }
+  }
+}
+
+// Evaluate the expression into a new array.
+template<typename E>
+Array<typename E::value_type> evalExpr (const E& expr)
+{
+  Array<typename E::value_type> result;
+  assignExpr (result, expr);
+  return result;
+}
+
+// </group>
+
+// The operators and functions on expressions.
+// They are only enabled if at least one operand is an expression.
+// <group name="Array expression operators">
+#define CASA_ARRAYEXPR_BINARY(OPER, OP, NAME)                                \
+template<typename L, typename R,                                             \
+         typename std::enable_if<IsArrayExpr<L>::value  &&                   \
+                                 IsArrayExpr<R>::value, int>::type = 0>      \
+inline ArrayExprBinary<L, R, ArrayExprOp::OP>                                \
+OPER (const L& left, const R& right)                                         \
+  { return ArrayExprBinary<L, R, ArrayExprOp::OP> (left, right, NAME); }    \
+template<typename L, typename T, typename Alloc,                             \
+         typename std::enable_if<IsArrayExpr<L>::value, int>::type = 0>      \
+inline ArrayExprBinary<L, ArrayExprArray<T>, ArrayExprOp::OP>                \
+OPER (const L& left, const Array<T, Alloc>& right)                           \
+  { return ArrayExprBinary<L, ArrayExprArray<T>, ArrayExprOp::OP>            \
+      (left, ArrayExprArray<T>(right), NAME); }                              \
+template<typename T, typename Alloc, typename R,                             \
+         typename std::enable_if<IsArrayExpr<R>::value, int>::type = 0>      \
+inline ArrayExprBinary<ArrayExprArray<T>, R, ArrayExprOp::OP>                \
+OPER (const Array<T, Alloc>& left, const R& right)                           \
+  { return ArrayExprBinary<ArrayExprArray<T>, R, ArrayExprOp::OP>            \
+      (ArrayExprArray<T>(left), right, NAME); }                              \
+template<typename L, typename S,                                             \
+         typename std::enable_if<IsArrayExpr<L>::value  &&                   \
+                                 IsArrayExprScalar<S>::value, int>::type = 0>\
+inline ArrayExprBinary<L, ArrayExprScalar<S>, ArrayExprOp::OP>               \
+OPER (const L& left, const S& right)                                         \
+  { return ArrayExprBinary<L, ArrayExprScalar<S>, ArrayExprOp::OP>           \
+      (left, ArrayExprScalar<S>(right), NAME); }                             \
+template<typename S, typename R,                                             \
+         typename std::enable_if<IsArrayExprScalar<S>::value  &&             \
+                                 IsArrayExpr<R>::value, int>::type = 0>      \
+inline ArrayExprBinary<ArrayExprScalar<S>, R, ArrayExprOp::OP>               \
+OPER (const S& left, const R& right)                                         \
+  { return ArrayExprBinary<ArrayExprScalar<S>, R, ArrayExprOp::OP>           \
+      (ArrayExprScalar<S>(left), right, NAME); }
+
+CASA_ARRAYEXPR_BINARY(operator+, Plus, "+")
+CASA_ARRAYEXPR_BINARY(operator-, Minus, "-")
+CASA_ARRAYEXPR_BINARY(operator*, Multiplies, "*")
+CASA_ARRAYEXPR_BINARY(operator/, Divides, "/")
+#undef CASA_ARRAYEXPR_BINARY
+
+#define CASA_ARRAYEXPR_UNARY(FUNC, OP)                                       \
+template<typename E,                                                         \
+         typename std::enable_if<IsArrayExpr<E>::value, int>::type = 0>      \
+inline ArrayExprUnary<E, ArrayExprOp::OP> FUNC (const E& expr)               \
+  { return ArrayExprUnary<E, ArrayExprOp::OP> (expr); }
+
+CASA_ARRAYEXPR_UNARY(operator-, Negate)
+CASA_ARRAYEXPR_UNARY(conj, Conj)
+CASA_ARRAYEXPR_UNARY(real, Real)
+CASA_ARRAYEXPR_UNARY(imag, Imag)
+CASA_ARRAYEXPR_UNARY(norm, Norm)
+CASA_ARRAYEXPR_UNARY(arg, Arg)
+CASA_ARRAYEXPR_UNARY(abs, Abs)
+CASA_ARRAYEXPR_UNARY(sqrt, Sqrt)
+CASA_ARRAYEXPR_UNARY(exp, Exp)
+CASA_ARRAYEXPR_UNARY(log, Log)
+CASA_ARRAYEXPR_UNARY(sin, Sin)
+CASA_ARRAYEXPR_UNARY(cos, Cos)
+#undef CASA_ARRAYEXPR_UNARY
+// </group>
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -27,6 +27,7 @@
 #define CASA_ARRAYLOGICAL_2_H
 
 //# Includes
+#include "ArrayExecPolicy.h"
 #include "ArrayFwd.h"
 #include "IPosition.h"
 
@@ -263,6 +264,43 @@ template<class T> LogicalArray isInf    (const Array<T> &array);
 template<class T> LogicalArray isFinite (const Array<T> &array);
 // </group>
 
+// 
+// Element by element comparisons using an execution policy to process
+// large arrays in parallel (see
+// <linkto class=ArrayExecPolicy>ArrayExecPolicy</linkto>).
+// The comparison operator (e.g. <src>std::less<T>()</src>) gives the
+// result for each pair of elements; a scalar behaves as if it were a
+// conformant array filled with the value.
+//
+// <thrown>
+//    <li> ArrayConformanceError
+// </thrown>
+//
+// <group>
+template<typename T, typename CompareOperator>
+LogicalArray arrayCompare (const ArrayExecPolicy& policy,
+                           const Array<T>& left, const Array<T>& right,
+                           CompareOperator op);
+template<typename T, typename CompareOperator>
+LogicalArray arrayCompare (const ArrayExecPolicy& policy,
+                           const Array<T>& left, T right,
+                           CompareOperator op);
+template<typename T, typename CompareOperator>
+LogicalArray arrayCompare (const ArrayExecPolicy& policy,
+                           T left, const Array<T>& right,
+                           CompareOperator op);
+template<class T> LogicalArray near (const ArrayExecPolicy& policy,
+                                     const Array<T> &l, const Array<T> &r,
+                                     double tol);
+template<class T> LogicalArray nearAbs (const ArrayExecPolicy& policy,
+                                        const Array<T> &l, const Array<T> &r,
+                                        double tol);
+template<class T> LogicalArray isNaN    (const ArrayExecPolicy& policy,
+                                         const Array<T> &array);
+template<class T> LogicalArray isFinite (const ArrayExecPolicy& policy,
+                                         const Array<T> &array);
+// </group>
+
 // 
 // Element by element comparisons between an array and a scalar, which
 // behaves as if it were a conformant array filled with the value "val."
@@ -600,6 +600,77 @@ LogicalArray isFinite (const Array<T> &array)
   return result;
 }
 
+template<typename T, typename CompareOperator>
+LogicalArray arrayCompare (const ArrayExecPolicy& policy,
+                           const Array<T>& left, const Array<T>& right,
+                           CompareOperator op)
+{
+  checkArrayShapes (left, right, "arrayCompare");
+  LogicalArray result(left.shape());
+  arrayTransform (policy, left, right, result, op);
+  return result;
+}
+
+template<typename T, typename CompareOperator>
+LogicalArray arrayCompare (const ArrayExecPolicy& policy,
+                           const Array<T>& left, T right,
+                           CompareOperator op)
+{
+  LogicalArray result(left.shape());
+  arrayTransform (policy, left, right, result, op);
+  return result;
+}
+
+template<typename T, typename CompareOperator>
+LogicalArray arrayCompare (const ArrayExecPolicy& policy,
+                           T left, const Array<T>& right,
+                           CompareOperator op)
+{
+  LogicalArray result(right.shape());
+  arrayTransform (policy, left, right, result, op);
+  return result;
+}
+
+template<class T>
+LogicalArray near (const ArrayExecPolicy& policy,
+                   const Array<T> &l, const Array<T>& r, double tol)
+{
+  checkArrayShapes (l, r, "near");
+  LogicalArray result(l.shape());
+  arrayTransform (policy, l, r, result, [tol](T left, T right){ return arrays_internal::near(left, right, tol); });
+  return result;
+}
+
+template<class T>
+LogicalArray nearAbs (const ArrayExecPolicy& policy,
+                      const Array<T> &l, const Array<T>& r, double tol)
+{
+  checkArrayShapes (l, r, "nearAbs");
+  LogicalArray result(l.shape());
+  arrayTransform (policy, l, r, result, [tol](T left, T right){ return arrays_internal::nearAbs(left, right, tol); });
+  return result;
+}
+
+template<class T>
+LogicalArray isNaN (const ArrayExecPolicy& policy, const Array<T> &array)
+{
+  LogicalArray result(array.shape());
+  using std::isnan;
+  using arrays_internal::isnan;
+  arrayTransform (policy, array, result, [](T val){ return isnan(val);} );
+  return result;
+}
+
+template<class T>
+LogicalArray isFinite (const ArrayExecPolicy& policy, const Array<T> &array)
+{
+  LogicalArray result(array.shape());
+  using std::isfinite;
+  using arrays_internal::isfinite;
+  arrayTransform (policy, array, result, [](T val){ return isfinite(val);} );
+  return result;
+}
+
 template<class T>
 LogicalArray near (const Array<T> &l, const Array<T>& r, double tol)
 {
@@ -27,6 +27,7 @@
 #define CASA_ARRAYMATH_2_H
 
 #include "Array.h"
+#include "ArrayExecPolicy.h"
 
 #include <algorithm>
 #include <cassert>
@@ -334,6 +335,154 @@ inline void arrayTransformInPlace (Array<T, Alloc>& arr, UnaryOperator op)
 }
 // </group>
 
+// The same transform functions as above, but using an execution policy.
+// If the policy is not sequential and all arrays are contiguous, the
+// elements are processed in parallel chunks (see
+// <linkto class=ArrayExecPolicy>ArrayExecPolicy</linkto>).
+// Otherwise the function without a policy is used.
+// The operator must be thread-safe and must not throw an exception.
+// <group>
+template<typename L, typename R, typename RES, typename BinaryOperator, typename AllocL, typename AllocR, typename AllocRES>
+inline void arrayTransform (const ArrayExecPolicy& policy,
+                            const Array<L, AllocL>& left, const Array<R, AllocR>& right,
+                            Array<RES, AllocRES>& result, BinaryOperator op)
+{
+  if (policy.sequential()  ||  !left.contiguousStorage()  ||
+      !right.contiguousStorage()  ||  !result.contiguousStorage()) {
+    arrayTransform (left, right, result, op);
+  } else {
+    arrays_internal::parTransform (policy, result.nelements(), left.data(),
+                                   right.data(), result.data(), op);
+  }
+}
+
+template<typename L, typename R, typename RES, typename BinaryOperator, typename Alloc, typename AllocRES>
+inline void arrayTransform (const ArrayExecPolicy& policy,
+                            const Array<L, Alloc>& left, R right,
+                            Array<RES, AllocRES>& result, BinaryOperator op)
+{
+  if (policy.sequential()  ||  !left.contiguousStorage()  ||
+      !result.contiguousStorage()) {
+    arrayTransform (left, right, result, op);
+  } else {
+    arrays_internal::parTransform (policy, result.nelements(), left.data(),
+                                   result.data(),
+                                   [op, right](const L& l) { return op(l, right); });
+  }
+}
+
+template<typename L, typename R, typename RES, typename BinaryOperator, typename Alloc, typename AllocRES>
+inline void arrayTransform (const ArrayExecPolicy& policy,
+                            L left, const Array<R, Alloc>& right,
+                            Array<RES, AllocRES>& result, BinaryOperator op)
+{
+  if (policy.sequential()  ||  !right.contiguousStorage()  ||
+      !result.contiguousStorage()) {
+    arrayTransform (left, right, result, op);
+  } else {
+    arrays_internal::parTransform (policy, result.nelements(), right.data(),
+                                   result.data(),
+                                   [op, left](const R& r) { return op(left, r); });
+  }
+}
+
+template<typename T, typename RES, typename UnaryOperator, typename Alloc, typename AllocRES>
+inline void arrayTransform (const ArrayExecPolicy& policy,
+                            const Array<T, Alloc>& arr,
+                            Array<RES, AllocRES>& result, UnaryOperator op)
+{
+  if (policy.sequential()  ||  !arr.contiguousStorage()  ||
+      !result.contiguousStorage()) {
+    arrayTransform (arr, result, op);
+  } else {
+    arrays_internal::parTransform (policy, result.nelements(), arr.data(),
+                                   result.data(), op);
+  }
+}
+
+template<typename T, typename BinaryOperator, typename Alloc>
+inline Array<T, Alloc> arrayTransformResult (const ArrayExecPolicy& policy,
+                                             const Array<T, Alloc>& left,
+                                             const Array<T, Alloc>& right,
+                                             BinaryOperator op)
+{
+  Array<T, Alloc> res(left.shape());
+  arrayTransform (policy, left, right, res, op);
+  return res;
+}
+
+template<typename T, typename BinaryOperator, typename Alloc>
+inline Array<T, Alloc> arrayTransformResult (const ArrayExecPolicy& policy,
+                                             const Array<T, Alloc>& left, T right,
+                                             BinaryOperator op)
+{
+  Array<T, Alloc> res(left.shape());
+  arrayTransform (policy, left, right, res, op);
+  return res;
+}
+
+template<typename T, typename BinaryOperator, typename Alloc>
+inline Array<T, Alloc> arrayTransformResult (const ArrayExecPolicy& policy,
+                                             T left, const Array<T, Alloc>& right,
+                                             BinaryOperator op)
+{
+  Array<T, Alloc> res(right.shape());
+  arrayTransform (policy, left, right, res, op);
+  return res;
+}
+
+template<typename T, typename UnaryOperator, typename Alloc>
+inline Array<T, Alloc> arrayTransformResult (const ArrayExecPolicy& policy,
+                                             const Array<T, Alloc>& arr,
+                                             UnaryOperator op)
+{
+  Array<T, Alloc> res(arr.shape());
+  arrayTransform (policy, arr, res, op);
+  return res;
+}
+
+template<typename L, typename R, typename BinaryOperator, typename AllocL, typename AllocR>
+inline void arrayTransformInPlace (const ArrayExecPolicy& policy,
+                                   Array<L, AllocL>& left,
+                                   const Array<R, AllocR>& right,
+                                   BinaryOperator op)
+{
+  if (policy.sequential()  ||  !left.contiguousStorage()  ||
+      !right.contiguousStorage()) {
+    arrayTransformInPlace (left, right, op);
+  } else {
+    arrays_internal::parTransform (policy, left.nelements(), left.data(),
+                                   right.data(), left.data(), op);
+  }
+}
+
+template<typename L, typename R, typename BinaryOperator, typename Alloc>
+inline void arrayTransformInPlace (const ArrayExecPolicy& policy,
+                                   Array<L, Alloc>& left, R right,
+                                   BinaryOperator op)
+{
+  if (policy.sequential()  ||  !left.contiguousStorage()) {
+    arrayTransformInPlace (left, right, op);
+  } else {
+    arrays_internal::parTransform (policy, left.nelements(), left.data(),
+                                   left.data(),
+                                   [op, right](const L& l) { return op(l, right); });
+  }
+}
+
+template<typename T, typename UnaryOperator, typename Alloc>
+inline void arrayTransformInPlace (const ArrayExecPolicy& policy,
+                                   Array<T, Alloc>& arr, UnaryOperator op)
+{
+  if (policy.sequential()  ||  !arr.contiguousStorage()) {
+    arrayTransformInPlace (arr, op);
+  } else {
+    arrays_internal::parTransform (policy, arr.nelements(), arr.data(),
+                                   arr.data(), op);
+  }
+}
+// </group>
+
 // 
 // Element by element arithmetic modifying left in-place. left and other
 // must be conformant.
@@ -477,6 +626,18 @@ template<typename T, typename Alloc> Array<T, Alloc> sinh(const Array<T, Alloc>
 template<typename T, typename Alloc> Array<T, Alloc> sqrt(const Array<T, Alloc> &a);
 // </group>
 
+// 
+// Some of the functions above using an execution policy to process
+// large arrays in parallel (see
+// <linkto class=ArrayExecPolicy>ArrayExecPolicy</linkto>).
+// <group>
+template<typename T, typename Alloc> Array<T, Alloc> exp(const ArrayExecPolicy& policy, const Array<T, Alloc> &a);
+template<typename T, typename Alloc> Array<T, Alloc> log(const ArrayExecPolicy& policy, const Array<T, Alloc> &a);
+template<typename T, typename Alloc> Array<T, Alloc> sqrt(const ArrayExecPolicy& policy, const Array<T, Alloc> &a);
+template<typename T, typename Alloc> Array<T, Alloc> pow(const ArrayExecPolicy& policy, const Array<T, Alloc> &a, const Array<T, Alloc> &b);
+template<typename T, typename Alloc> Array<T, Alloc> pow(const ArrayExecPolicy& policy, const Array<T, Alloc> &a, const T &b);
+// </group>
+
 // 
 // Transcendental function applied to the array on an element-by-element
 // basis. Although a template function, this does not make sense for all
@@ -873,6 +1034,9 @@ Array<std::complex<double>> conj(const Array<std::complex<double>> &carray);
 // Modifies rarray in place. rarray must be conformant.
 void conj(Array<std::complex<float>> &rarray, const Array<std::complex<float>> &carray);
 void conj(Array<std::complex<double>> &rarray, const Array<std::complex<double>> &carray);
+// Using an execution policy.
+Array<std::complex<float>> conj(const ArrayExecPolicy& policy, const Array<std::complex<float>> &carray);
+Array<std::complex<double>> conj(const ArrayExecPolicy& policy, const Array<std::complex<double>> &carray);
 //# The following are implemented to make the compiler find the right conversion
 //# more often.
 Matrix<std::complex<float>> conj(const Matrix<std::complex<float>> &carray);
@@ -928,6 +1092,9 @@ Array<double> amplitude(const Array<std::complex<double>> &carray);
 // Modifies rarray in place. rarray must be conformant.
 void         amplitude(Array<float> &rarray, const Array<std::complex<float>> &carray);
 void         amplitude(Array<double> &rarray, const Array<std::complex<double>> &carray);
+// Using an execution policy.
+Array<float>  amplitude(const ArrayExecPolicy& policy, const Array<std::complex<float>> &carray);
+Array<double> amplitude(const ArrayExecPolicy& policy, const Array<std::complex<double>> &carray);
 // </group>
 
 // 
@@ -940,6 +1107,9 @@ Array<double> phase(const Array<std::complex<double>> &carray);
 // Modifies rarray in place. rarray must be conformant.
 void         phase(Array<float> &rarray, const Array<std::complex<float>> &carray);
 void         phase(Array<double> &rarray, const Array<std::complex<double>> &carray);
+// Using an execution policy.
+Array<float>  phase(const ArrayExecPolicy& policy, const Array<std::complex<float>> &carray);
+Array<double> phase(const ArrayExecPolicy& policy, const Array<std::complex<double>> &carray);
 // </group>
 
 // Copy an array of complex into an array of real,imaginary pairs. The
@@ -33,6 +33,7 @@
 #include "ArrayUtil.h"
 #include "VectorIter.h"
 #include "ArrayError.h"
+#include "ArraySimd.h"
 #include "ElementFunctions.h"
 
 #include <algorithm>
@@ -598,22 +599,8 @@ template<typename T, typename Alloc> void minMax(T &minVal, T &maxVal, const Arr
                      "Array has no elements"));	
   }
   if (array.contiguousStorage()) {
-    // minimal scope as some compilers may spill onto stack otherwise
-    T minv = array.data()[0];
-    T maxv = minv;
-    typename Array<T, Alloc>::const_contiter iterEnd = array.cend();
-    for (typename Array<T, Alloc>::const_contiter iter = array.cbegin();
-         iter!=iterEnd; ++iter) {
-      if (*iter < minv) {
-        minv = *iter;
-      }
-      // no else allows compiler to use branchless instructions
-      if (*iter > maxv) {
-        maxv = *iter;
-      }
-    }
-    maxVal = maxv;
-    minVal = minv;
+    arrays_internal::simdMinMax (minVal, maxVal, array.data(),
+                                 array.nelements());
   } else {
     T minv = array.data()[0];
     T maxv = minv;
@@ -760,6 +747,32 @@ template<typename T, typename Alloc> Array<T, Alloc> sqrt(const Array<T, Alloc>
     return arrayTransformResult (a, [](T a){ return std::sqrt(a);});
 }
 
+template<typename T, typename Alloc> Array<T, Alloc> exp(const ArrayExecPolicy& policy, const Array<T, Alloc> &a)
+{
+    return arrayTransformResult (policy, a, [](T v){ return std::exp(v); });
+}
+
+template<typename T, typename Alloc> Array<T, Alloc> log(const ArrayExecPolicy& policy, const Array<T, Alloc> &a)
+{
+    return arrayTransformResult (policy, a, [](T v){ return std::log(v); });
+}
+
+template<typename T, typename Alloc> Array<T, Alloc> sqrt(const ArrayExecPolicy& policy, const Array<T, Alloc> &a)
+{
+    return arrayTransformResult (policy, a, [](T v){ return std::sqrt(v); });
+}
+
+template<typename T, typename Alloc> Array<T, Alloc> pow(const ArrayExecPolicy& policy, const Array<T, Alloc> &a, const Array<T, Alloc> &b)
+{
+    checkArrayShapes (a, b, "pow");
+    return arrayTransformResult (policy, a, b, [](T l, T r) { return std::pow(l, r); });
+}
+
+template<typename T, typename Alloc> Array<T, Alloc> pow(const ArrayExecPolicy& policy, const Array<T, Alloc> &a, const T &b)
+{
+    return arrayTransformResult (policy, a, b, [](T l, T r) { return std::pow(l, r); });
+}
+
 template<typename T, typename Alloc> Array<T, Alloc> square(const Array<T, Alloc> &a)
 {
     return arrayTransformResult (a, [](T a){ return a*a; });
@@ -916,7 +929,7 @@ template<typename T, typename Alloc> Array<T, Alloc> floormod(const Array<T, All
 template<typename T, typename Alloc> T sum(const Array<T, Alloc> &a)
 {
   return a.contiguousStorage() ?
-    std::accumulate(a.cbegin(), a.cend(), T(), std::plus<T>()) :
+    arrays_internal::simdSum (a.data(), a.nelements()) :
     std::accumulate(a.begin(),  a.end(),  T(), std::plus<T>());
 }
 
@@ -924,7 +937,7 @@ template<typename T, typename Alloc> T sumsqr(const Array<T, Alloc> &a)
 {
   auto sumsqr = [](T left, T right) { return left + right*right;};
   return a.contiguousStorage() ?
-    std::accumulate(a.cbegin(), a.cend(), T(), sumsqr) :
+    arrays_internal::simdSumSqr (a.data(), a.nelements()) :
     std::accumulate(a.begin(),  a.end(),  T(), sumsqr);
 }
 
@@ -1053,11 +1066,7 @@ template<typename T, typename Alloc> T rms(const Array<T, Alloc> &a)
 	throw(ArrayError("::rms(const Array<T, Alloc> &) - Need at least 1 "
 			 "element"));
     }
-    auto sumsqr = [](T left, T right) { return left + right*right; };
-  T sum = a.contiguousStorage() ?
-      std::accumulate(a.cbegin(), a.cend(), T(), sumsqr) :
-      std::accumulate(a.begin(),  a.end(),  T(), sumsqr);
-    return T(std::sqrt(sum/T(1.0*a.nelements())));
+    return T(std::sqrt(sumsqr(a)/T(1.0*a.nelements())));
 }
 
 // <thrown>
@@ -26,6 +26,7 @@
 #include "ArrayPartMath.h"
 #include "ArrayIter.h"
 #include "ArrayError.h"
+#include "ArraySimd.h"
 
 #include <cassert>
 #include <complex>
@@ -49,6 +50,10 @@ template<typename T, typename Alloc> Array<T, Alloc> partialSums (const Array<T,
 				 collapseAxes);
   Array<T, Alloc> result (resShape);
   result = 0;
+  // Nothing to add for an empty array.
+  if (array.empty()) {
+    return result;
+  }
   bool deleteData, deleteRes;
   const T* arrData = array.getStorage (deleteData);
   const T* data = arrData;
@@ -59,28 +64,34 @@ template<typename T, typename Alloc> Array<T, Alloc> partialSums (const Array<T,
   // cont tells if any data are contiguous.
   // stax gives the first non-contiguous axis.
   // n0 gives the number of contiguous elements.
+  // Otherwise the leading result axes give rows of n0 contiguous values
+  // which are added for the nrow rows of the collapse axes following them.
+  // The result pointer is back at the start of the row after that.
   bool cont = true;
   size_t n0 = nelemCont;
-  int incr0 = incr(0);
+  size_t nrow = 1;
   if (nelemCont <= 1) {
     cont = false;
-    n0 = shape(0);
-    stax = 1;
+    stax = partialRowHelper (n0, nrow, shape, collapseAxes);
   }
   // Loop through all data and assemble as needed.
   IPosition pos(ndim, 0);
   while (true) {
     if (cont) {
-      T tmp = *res;
-      for (size_t i=0; i<n0; i++) {
-	tmp += *data++;
+      // A kernel call is not worth it for a few values.
+      if (n0 < 32) {
+        T tmp = *res;
+        for (size_t i=0; i<n0; i++) {
+          tmp += data[i];
+        }
+        *res = tmp;
+      } else {
+        *res += arrays_internal::simdSum (data, n0);
       }
-      *res = tmp;
+      data += n0;
     } else {
-      for (size_t i=0; i<n0; i++) {
-	*res += *data++;
-	res += incr0;
-      }
+      arrays_internal::simdAddRows (res, data, n0, nrow);
+      data += n0*nrow;
     }
     size_t ax;
     for (ax=stax; ax<ndim; ax++) {
@@ -334,6 +345,10 @@ template<typename T, typename Alloc> Array<T, Alloc> partialMaxs (const Array<T,
 				 collapseAxes);
   Array<T, Alloc> result (resShape);
   result = 0;
+  // Nothing to do if the result is empty.
+  if (result.empty()) {
+    return result;
+  }
   bool deleteData, deleteRes;
   const T* arrData = array.getStorage (deleteData);
   const T* data = arrData;
@@ -352,34 +367,40 @@ template<typename T, typename Alloc> Array<T, Alloc> partialMaxs (const Array<T,
   // cont tells if any data are contiguous.
   // stax gives the first non-contiguous axis.
   // n0 gives the number of contiguous elements.
+  // Otherwise the leading result axes give rows of n0 contiguous values
+  // which are combined for the nrow rows of the collapse axes following
+  // them. The result pointer is back at the start of the row after that.
   bool cont = true;
   size_t n0 = nelemCont;
-  int incr0 = incr(0);
+  size_t nrow = 1;
   if (nelemCont <= 1) {
     cont = false;
-    n0 = shape(0);
-    stax = 1;
+    stax = partialRowHelper (n0, nrow, shape, collapseAxes);
   }
   // Loop through all data and assemble as needed.
   IPosition pos(ndim, 0);
   while (true) {
     if (cont) {
-      T tmp = *res;
-      for (size_t i=0; i<n0; i++) {
-	if (*data > tmp) {
-	  tmp = *data;
-	}
-	data++;
+      // A kernel call is not worth it for a few values.
+      if (n0 < 32) {
+        T tmp = *res;
+        for (size_t i=0; i<n0; i++) {
+          if (data[i] > tmp) {
+            tmp = data[i];
+          }
+        }
+        *res = tmp;
+      } else {
+        T minv, maxv;
+        arrays_internal::simdMinMax (minv, maxv, data, n0);
+        if (maxv > *res) {
+          *res = maxv;
+        }
       }
-      *res = tmp;
+      data += n0;
     } else {
-      for (size_t i=0; i<n0; i++) {
-	if (*data > *res) {
-	  *res = *data;
-	}
-	data++;
-	res += incr0;
-      }
+      arrays_internal::simdMaxRows (res, data, n0, nrow);
+      data += n0*nrow;
     }
     size_t ax;
     for (ax=stax; ax<ndim; ax++) {
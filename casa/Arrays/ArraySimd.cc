@@ -0,0 +1,293 @@
+//# ArraySimd.cc: Vectorized kernels for Array reductions
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include "ArraySimd.h"
+
+//# On x86_64 GCC can create clones of a function for several instruction
+//# sets and select one at load time (using an ifunc resolver).
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 6 && \
+    defined(__x86_64__) && defined(__ELF__)
+# define CASA_SIMD_CLONES \
+    __attribute__((target_clones("avx512f","avx2","default")))
+#else
+# define CASA_SIMD_CLONES
+#endif
+
+//# The helpers must be inlined in the clones to be compiled for their
+//# instruction set.
+#if defined(__GNUC__)
+# define CASA_SIMD_INLINE inline __attribute__((always_inline))
+#else
+# define CASA_SIMD_INLINE inline
+#endif
+
+namespace casacore {
+namespace arrays_internal {
+
+namespace {
+
+  // The number of independent accumulators. It is a multiple of 2,
+  // so the real and imaginary parts of complex values use different lanes.
+  const size_t nlane = 16;
+
+  // Sum the values (or their squares) into nlane accumulators.
+  template<typename T, bool SQUARE>
+  CASA_SIMD_INLINE void sumLanes (T* acc, const T* data, size_t n)
+  {
+    for (size_t k=0; k<nlane; ++k) {
+      acc[k] = 0;
+    }
+    size_t nv = n - n%nlane;
+    for (size_t i=0; i<nv; i+=nlane) {
+      for (size_t k=0; k<nlane; ++k) {
+        acc[k] += (SQUARE  ?  data[i+k] * data[i+k] : data[i+k]);
+      }
+    }
+    for (size_t i=nv; i<n; ++i) {
+      acc[i-nv] += (SQUARE  ?  data[i] * data[i] : data[i]);
+    }
+  }
+
+  template<typename T, bool SQUARE>
+  CASA_SIMD_INLINE T sumReal (const T* data, size_t n)
+  {
+    T acc[nlane];
+    sumLanes<T,SQUARE> (acc, data, n);
+    T sum = 0;
+    for (size_t k=0; k<nlane; ++k) {
+      sum += acc[k];
+    }
+    return sum;
+  }
+
+  template<typename T>
+  CASA_SIMD_INLINE std::complex<T> sumComplex (const std::complex<T>* data,
+                                               size_t n)
+  {
+    T acc[nlane];
+    sumLanes<T,false> (acc, reinterpret_cast<const T*>(data), 2*n);
+    T re = 0;
+    T im = 0;
+    for (size_t k=0; k<nlane; k+=2) {
+      re += acc[k];
+      im += acc[k+1];
+    }
+    return std::complex<T> (re, im);
+  }
+
+  // The square of a complex value is (re*re - im*im, 2*re*im).
+  template<typename T>
+  CASA_SIMD_INLINE std::complex<T> sumSqrComplex (const std::complex<T>* data,
+                                                  size_t n)
+  {
+    const size_t nc = nlane/2;
+    const T* d = reinterpret_cast<const T*>(data);
+    T accr[nc];
+    T acci[nc];
+    for (size_t k=0; k<nc; ++k) {
+      accr[k] = acci[k] = 0;
+    }
+    size_t nv = n - n%nc;
+    for (size_t i=0; i<nv; i+=nc) {
+      for (size_t k=0; k<nc; ++k) {
+        T re = d[2*(i+k)];
+        T im = d[2*(i+k)+1];
+        accr[k] += re*re - im*im;
+        acci[k] += 2*re*im;
+      }
+    }
+    T re = 0;
+    T im = 0;
+    for (size_t k=0; k<nc; ++k) {
+      re += accr[k];
+      im += acci[k];
+    }
+    for (size_t i=nv; i<n; ++i) {
+      T dr = d[2*i];
+      T di = d[2*i+1];
+      re += dr*dr - di*di;
+      im += 2*dr*di;
+    }
+    return std::complex<T> (re, im);
+  }
+
+  template<typename T>
+  CASA_SIMD_INLINE void minMaxReal (T& minVal, T& maxVal,
+                                    const T* data, size_t n)
+  {
+    T minv[nlane];
+    T maxv[nlane];
+    for (size_t k=0; k<nlane; ++k) {
+      minv[k] = maxv[k] = data[0];
+    }
+    size_t nv = n - n%nlane;
+    for (size_t i=0; i<nv; i+=nlane) {
+      for (size_t k=0; k<nlane; ++k) {
+        T v = data[i+k];
+        minv[k] = (v < minv[k]  ?  v : minv[k]);
+        maxv[k] = (v > maxv[k]  ?  v : maxv[k]);
+      }
+    }
+    for (size_t i=nv; i<n; ++i) {
+      T v = data[i];
+      minv[0] = (v < minv[0]  ?  v : minv[0]);
+      maxv[0] = (v > maxv[0]  ?  v : maxv[0]);
+    }
+    T mn = minv[0];
+    T mx = maxv[0];
+    for (size_t k=1; k<nlane; ++k) {
+      if (minv[k] < mn) mn = minv[k];
+      if (maxv[k] > mx) mx = maxv[k];
+    }
+    minVal = mn;
+    maxVal = mx;
+  }
+
+  // If the number of lanes is a multiple of the row length (e.g. the
+  // polarizations of a visibility cube), the rows are seen as a single
+  // array, where lane k accumulates column k%ncol. Otherwise the rows are
+  // long enough to vectorize the loop over a row.
+  template<typename T>
+  CASA_SIMD_INLINE void addRows (T* res, const T* data,
+                                 size_t ncol, size_t nrow)
+  {
+    if (ncol == 0  ||  nrow == 0) {
+      return;
+    }
+    if (nlane % ncol == 0) {
+      T acc[nlane];
+      sumLanes<T,false> (acc, data, ncol*nrow);
+      for (size_t k=0; k<nlane; ++k) {
+        res[k%ncol] += acc[k];
+      }
+    } else {
+      for (size_t j=0; j<nrow; ++j) {
+        for (size_t i=0; i<ncol; ++i) {
+          res[i] += data[i];
+        }
+        data += ncol;
+      }
+    }
+  }
+
+  template<typename T>
+  CASA_SIMD_INLINE void maxRows (T* res, const T* data,
+                                 size_t ncol, size_t nrow)
+  {
+    if (ncol == 0  ||  nrow == 0) {
+      return;
+    }
+    size_t n = ncol*nrow;
+    if (nlane % ncol == 0) {
+      T acc[nlane];
+      for (size_t k=0; k<nlane; ++k) {
+        acc[k] = res[k%ncol];
+      }
+      size_t nv = n - n%nlane;
+      for (size_t i=0; i<nv; i+=nlane) {
+        for (size_t k=0; k<nlane; ++k) {
+          acc[k] = (data[i+k] > acc[k]  ?  data[i+k] : acc[k]);
+        }
+      }
+      for (size_t i=nv; i<n; ++i) {
+        acc[i-nv] = (data[i] > acc[i-nv]  ?  data[i] : acc[i-nv]);
+      }
+      for (size_t k=0; k<nlane; ++k) {
+        if (acc[k] > res[k%ncol]) {
+          res[k%ncol] = acc[k];
+        }
+      }
+    } else {
+      for (size_t j=0; j<nrow; ++j) {
+        for (size_t i=0; i<ncol; ++i) {
+          res[i] = (data[i] > res[i]  ?  data[i] : res[i]);
+        }
+        data += ncol;
+      }
+    }
+  }
+
+} //# end anonymous namespace
+
+
+CASA_SIMD_CLONES
+float simdSum (const float* data, size_t n)
+  { return sumReal<float,false> (data, n); }
+CASA_SIMD_CLONES
+double simdSum (const double* data, size_t n)
+  { return sumReal<double,false> (data, n); }
+CASA_SIMD_CLONES
+std::complex<float> simdSum (const std::complex<float>* data, size_t n)
+  { return sumComplex (data, n); }
+CASA_SIMD_CLONES
+std::complex<double> simdSum (const std::complex<double>* data, size_t n)
+  { return sumComplex (data, n); }
+
+CASA_SIMD_CLONES
+float simdSumSqr (const float* data, size_t n)
+  { return sumReal<float,true> (data, n); }
+CASA_SIMD_CLONES
+double simdSumSqr (const double* data, size_t n)
+  { return sumReal<double,true> (data, n); }
+CASA_SIMD_CLONES
+std::complex<float> simdSumSqr (const std::complex<float>* data, size_t n)
+  { return sumSqrComplex (data, n); }
+CASA_SIMD_CLONES
+std::complex<double> simdSumSqr (const std::complex<double>* data, size_t n)
+  { return sumSqrComplex (data, n); }
+
+CASA_SIMD_CLONES
+void simdMinMax (float& minVal, float& maxVal, const float* data, size_t n)
+  { minMaxReal (minVal, maxVal, data, n); }
+CASA_SIMD_CLONES
+void simdMinMax (double& minVal, double& maxVal, const double* data, size_t n)
+  { minMaxReal (minVal, maxVal, data, n); }
+
+CASA_SIMD_CLONES
+void simdAddRows (float* res, const float* data, size_t ncol, size_t nrow)
+  { addRows (res, data, ncol, nrow); }
+CASA_SIMD_CLONES
+void simdAddRows (double* res, const double* data, size_t ncol, size_t nrow)
+  { addRows (res, data, ncol, nrow); }
+CASA_SIMD_CLONES
+void simdAddRows (std::complex<float>* res, const std::complex<float>* data,
+                  size_t ncol, size_t nrow)
+  { addRows (reinterpret_cast<float*>(res),
+             reinterpret_cast<const float*>(data), 2*ncol, nrow); }
+CASA_SIMD_CLONES
+void simdAddRows (std::complex<double>* res, const std::complex<double>* data,
+                  size_t ncol, size_t nrow)
+  { addRows (reinterpret_cast<double*>(res),
+             reinterpret_cast<const double*>(data), 2*ncol, nrow); }
+
+CASA_SIMD_CLONES
+void simdMaxRows (float* res, const float* data, size_t ncol, size_t nrow)
+  { maxRows (res, data, ncol, nrow); }
+CASA_SIMD_CLONES
+void simdMaxRows (double* res, const double* data, size_t ncol, size_t nrow)
+  { maxRows (res, data, ncol, nrow); }
+
+} //# NAMESPACE ARRAYS_INTERNAL - END
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,142 @@
+//# ArraySimd.h: Vectorized kernels for Array reductions
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_ARRAYSIMD_2_H
+#define CASA_ARRAYSIMD_2_H
+
+#include <complex>
+#include <cstddef>
+#include <numeric>
+
+namespace casacore {
+namespace arrays_internal {
+
+// <summary>
+//    Vectorized kernels for reductions of contiguous data.
+// </summary>
+//
+// <synopsis>
+// The reduction functions in ArrayMath (sum, sumsqr, mean, rms, min, max,
+// minMax) and ArrayPartMath (partialSums, partialMaxs) use these kernels
+// for contiguous data.
+// <br>The templated versions are straightforward loops used for all data
+// types. The overloads for float, double, and their complex counterparts
+// are implemented in ArraySimd.cc. They use several independent
+// accumulators, so the compiler can vectorize the loops. On x86_64 with
+// GCC they are compiled for multiple instruction sets (AVX-512, AVX2, and
+// the default) and the best one for the CPU is chosen at run time.
+// <br>Note that using several accumulators changes the order of the
+// summation, so the result of a sum can differ slightly (in the last bits)
+// from a sequential sum.
+// <p>
+// For partial reductions the data are seen as a matrix of nrow rows of
+// ncol contiguous values. The rows are reduced into the ncol result values.
+// </synopsis>
+//
+// <group name="SIMD kernels">
+
+// Sum the values.
+template<typename T>
+inline T simdSum (const T* data, size_t n)
+  { return std::accumulate (data, data+n, T()); }
+float simdSum (const float* data, size_t n);
+double simdSum (const double* data, size_t n);
+std::complex<float> simdSum (const std::complex<float>* data, size_t n);
+std::complex<double> simdSum (const std::complex<double>* data, size_t n);
+
+// Sum the squares of the values.
+template<typename T>
+inline T simdSumSqr (const T* data, size_t n)
+{
+  T sum = T();
+  for (size_t i=0; i<n; ++i) {
+    sum += data[i] * data[i];
+  }
+  return sum;
+}
+float simdSumSqr (const float* data, size_t n);
+double simdSumSqr (const double* data, size_t n);
+std::complex<float> simdSumSqr (const std::complex<float>* data, size_t n);
+std::complex<double> simdSumSqr (const std::complex<double>* data, size_t n);
+
+// Get the minimum and maximum value (n must be > 0).
+// As in the sequential loop, NaN values are ignored unless the first
+// value is NaN.
+template<typename T>
+inline void simdMinMax (T& minVal, T& maxVal, const T* data, size_t n)
+{
+  T minv = data[0];
+  T maxv = minv;
+  for (size_t i=1; i<n; ++i) {
+    if (data[i] < minv) minv = data[i];
+    if (data[i] > maxv) maxv = data[i];
+  }
+  minVal = minv;
+  maxVal = maxv;
+}
+void simdMinMax (float& minVal, float& maxVal, const float* data, size_t n);
+void simdMinMax (double& minVal, double& maxVal, const double* data, size_t n);
+
+// Add the rows to the result: <src>res[i] += sum(data[j*ncol + i])</src>.
+template<typename T>
+inline void simdAddRows (T* res, const T* data, size_t ncol, size_t nrow)
+{
+  for (size_t j=0; j<nrow; ++j) {
+    for (size_t i=0; i<ncol; ++i) {
+      res[i] += data[i];
+    }
+    data += ncol;
+  }
+}
+void simdAddRows (float* res, const float* data, size_t ncol, size_t nrow);
+void simdAddRows (double* res, const double* data, size_t ncol, size_t nrow);
+void simdAddRows (std::complex<float>* res, const std::complex<float>* data,
+                  size_t ncol, size_t nrow);
+void simdAddRows (std::complex<double>* res, const std::complex<double>* data,
+                  size_t ncol, size_t nrow);
+
+// Take the maximum of the rows and the result:
+// <src>res[i] = max(res[i], data[j*ncol + i])</src>.
+template<typename T>
+inline void simdMaxRows (T* res, const T* data, size_t ncol, size_t nrow)
+{
+  for (size_t j=0; j<nrow; ++j) {
+    for (size_t i=0; i<ncol; ++i) {
+      if (data[i] > res[i]) {
+        res[i] = data[i];
+      }
+    }
+    data += ncol;
+  }
+}
+void simdMaxRows (float* res, const float* data, size_t ncol, size_t nrow);
+void simdMaxRows (double* res, const double* data, size_t ncol, size_t nrow);
+
+// </group>
+
+} //# NAMESPACE ARRAYS_INTERNAL - END
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -183,6 +183,15 @@ size_t partialFuncHelper (int& nelemCont,
 			IPosition& resultShape, IPosition& incr,
 			const IPosition& sourceShape,
 			const IPosition& collapseAxes);
+
+// Get the number of contiguous values (the leading non-collapsed axes)
+// and the number of rows (the collapse axes following them) to be combined
+// in a single step. It returns the first axis after the collapse axes.
+// It is used by partialSums and partialMaxs if the first axis is not
+// collapsed.
+size_t partialRowHelper (size_t& ncol, size_t& nrow,
+                         const IPosition& sourceShape,
+                         const IPosition& collapseAxes);
 // </group>
 
 
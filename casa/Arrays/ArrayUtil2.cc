@@ -32,6 +32,8 @@
 #include "Array.h"
 #include "ArrayUtil.h"
 
+#include <vector>
+
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
   
 Vector<std::string> strToVector (const std::string& str, char delim)
@@ -122,6 +124,27 @@ size_t partialFuncHelper (int& nelemCont,
   return stax;
 }
 
+size_t partialRowHelper (size_t& ncol, size_t& nrow,
+                         const IPosition& sourceShape,
+                         const IPosition& collapseAxes)
+{
+  size_t ndim = sourceShape.nelements();
+  std::vector<bool> collapse(ndim, false);
+  for (size_t i=0; i<collapseAxes.nelements(); ++i) {
+    collapse[collapseAxes[i]] = true;
+  }
+  size_t axis = 0;
+  ncol = 1;
+  while (axis < ndim  &&  !collapse[axis]) {
+    ncol *= sourceShape[axis++];
+  }
+  nrow = 1;
+  while (axis < ndim  &&  collapse[axis]) {
+    nrow *= sourceShape[axis++];
+  }
+  return axis;
+}
+
 size_t reorderArrayHelper (IPosition& newShape, IPosition& incr,
 			 const IPosition& shape, const IPosition& newAxisOrder)
 {
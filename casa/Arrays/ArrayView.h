@@ -0,0 +1,579 @@
+//# ArrayView.h: Non-owning N-dimensional views of Array data
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_ARRAYVIEW_2_H
+#define CASA_ARRAYVIEW_2_H
+
+#include "Array.h"
+#include "ArrayError.h"
+#include "Slicer.h"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+//    Non-owning N-dimensional view of Array data.
+// </summary>
+//
+// <reviewed reviewer="" date="" tests="tArrayView">
+//
+// <prerequisite>
+//   <li> <linkto class=Array>Array</linkto>
+// </prerequisite>
+//
+// <synopsis>
+// Taking a section of an Array (using a Slicer) or iterating through it
+// (using ArrayIterator, VectorIterator, etc.) creates reference Arrays.
+// Each of them allocates the Array object, its IPositions, and updates
+// the reference count of the shared storage. In inner loops over lines or
+// planes of a cube this overhead can be significant.
+// <br>An ArrayView is a lightweight object holding a pointer to the data
+// and the shape and strides (in elements) of at most
+// <src>ArrayView::MaxNdim</src> axes in fixed-size members. Creating,
+// copying, slicing, and iterating views never allocates memory and never
+// touches the reference count of the Array storage.
+// <p>
+// A view does not own the data; the Array it is created from must stay
+// alive (and must not be resized) while the view is used.
+// An <src>ArrayView<const T></src> gives read-only access and can be
+// created from a const Array.
+// <p>
+// The elements can be accessed by index, by the STL-style iterator,
+// or (fastest) by the function <src>forEach</src>.
+// Sub-views can be obtained by slicing an axis, slicing all axes, or
+// by fixing the index of an axis (which removes the axis).
+// Class <linkto class=ArrayViewIterator>ArrayViewIterator</linkto>
+// iterates through a view taking sub-views (e.g. lines or planes).
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   Array<float> cube(IPosition(3,512,512,64));
+//   // Iterate through the planes and sum each plane.
+//   ArrayViewIterator<const float> iter(arrayView(cube), 2);
+//   for (; !iter.pastEnd(); iter.next()) {
+//     float sum = 0;
+//     forEach (iter.cursor(), [&sum](float v) { sum += v; });
+//   }
+//   // Set the spectrum at pixel (10,20) to 0.
+//   ArrayView<float> spectrum = arrayView(cube).index(0,10).index(0,20);
+//   forEach (spectrum, [](float& v) { v = 0; });
+// </srcblock>
+// </example>
+//
+// <motivation>
+// Lattice and imaging code iterate over planes and lines of large cubes.
+// Avoiding the creation of reference Arrays in each step removes the
+// allocation overhead from the inner loops.
+// </motivation>
+
+template<typename T>
+class ArrayView
+{
+public:
+  // The maximum dimensionality of a view.
+  enum { MaxNdim = 8 };
+
+  typedef T value_type;
+  typedef typename std::remove_const<T>::type nonconst_value_type;
+
+  // Forward iterator through all elements of a view (first axis varies
+  // fastest).
+  class iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T                         value_type;
+    typedef std::ptrdiff_t            difference_type;
+    typedef T*                        pointer;
+    typedef T&                        reference;
+
+    iterator()
+      : itsView(0), itsPtr(0)
+    {}
+    iterator (const ArrayView<T>* view, T* ptr)
+      : itsView (view),
+        itsPtr  (ptr)
+    {
+      for (size_t i=0; i<MaxNdim; ++i) {
+        itsPos[i] = 0;
+      }
+    }
+    T& operator*() const
+      { return *itsPtr; }
+    T* operator->() const
+      { return itsPtr; }
+    iterator& operator++()
+    {
+      const ArrayView<T>& v = *itsView;
+      for (size_t ax=0; ax<v.itsNdim; ++ax) {
+        itsPtr += v.itsStride[ax];
+        if (++itsPos[ax] < v.itsShape[ax]) {
+          return *this;
+        }
+        itsPtr -= v.itsShape[ax] * v.itsStride[ax];
+        itsPos[ax] = 0;
+      }
+      itsPtr = 0;
+      return *this;
+    }
+    iterator operator++ (int)
+      { iterator tmp(*this); ++*this; return tmp; }
+    bool operator== (const iterator& that) const
+      { return itsPtr == that.itsPtr; }
+    bool operator!= (const iterator& that) const
+      { return itsPtr != that.itsPtr; }
+  private:
+    const ArrayView<T>* itsView;
+    T*                  itsPtr;
+    ssize_t             itsPos[MaxNdim];
+  };
+
+  // An empty view.
+  ArrayView()
+    : itsData(0), itsNdim(0), itsNels(0)
+  {}
+
+  // Create a view of data with the given shape and strides (in elements).
+  ArrayView (T* data, size_t ndim, const ssize_t* shape,
+             const ssize_t* stride)
+    : itsData (data),
+      itsNdim (ndim)
+  {
+    checkNdim (ndim);
+    for (size_t i=0; i<ndim; ++i) {
+      itsShape[i]  = shape[i];
+      itsStride[i] = stride[i];
+    }
+    setNels();
+  }
+
+  // Create a view of all data of an Array.
+  // A view of a const Array must have a const element type.
+  // <group>
+  template<typename Alloc>
+  explicit ArrayView (Array<nonconst_value_type, Alloc>& arr)
+    { init (arr.data(), arr); }
+  template<typename Alloc>
+  explicit ArrayView (const Array<nonconst_value_type, Alloc>& arr)
+  {
+    static_assert (std::is_const<T>::value,
+                   "a view of a const Array must have a const type");
+    init (arr.data(), arr);
+  }
+  // </group>
+
+  // A non-const view converts to a const view.
+  template<typename U, typename = typename std::enable_if
+           <std::is_same<const U, T>::value>::type>
+  ArrayView (const ArrayView<U>& that)
+    : itsData (that.data()),
+      itsNdim (that.ndim()),
+      itsNels (that.nelements())
+  {
+    for (size_t i=0; i<itsNdim; ++i) {
+      itsShape[i]  = that.shape(i);
+      itsStride[i] = that.stride(i);
+    }
+  }
+
+  // Get the dimensionality.
+  size_t ndim() const
+    { return itsNdim; }
+
+  // Get the length or the stride (in elements) of an axis.
+  // <group>
+  ssize_t shape (size_t axis) const
+    { return itsShape[axis]; }
+  ssize_t stride (size_t axis) const
+    { return itsStride[axis]; }
+  // </group>
+
+  // Get the shape as an IPosition.
+  // Note that this allocates memory if ndim exceeds 4.
+  IPosition shape() const
+  {
+    IPosition shp(itsNdim);
+    for (size_t i=0; i<itsNdim; ++i) {
+      shp[i] = itsShape[i];
+    }
+    return shp;
+  }
+
+  // Get the number of elements.
+  size_t nelements() const
+    { return itsNels; }
+  size_t size() const
+    { return itsNels; }
+  bool empty() const
+    { return itsNels == 0; }
+
+  // Get a pointer to the first element.
+  T* data() const
+    { return itsData; }
+
+  // Are the data contiguous?
+  bool contiguous() const
+  {
+    ssize_t step = 1;
+    for (size_t i=0; i<itsNdim; ++i) {
+      if (itsShape[i] > 1  &&  itsStride[i] != step) {
+        return false;
+      }
+      step *= itsShape[i];
+    }
+    return true;
+  }
+
+  // Access an element. No bounds checking is done.
+  // <group>
+  T& operator() (ssize_t i0) const
+    { return itsData[i0*itsStride[0]]; }
+  T& operator() (ssize_t i0, ssize_t i1) const
+    { return itsData[i0*itsStride[0] + i1*itsStride[1]]; }
+  T& operator() (ssize_t i0, ssize_t i1, ssize_t i2) const
+    { return itsData[i0*itsStride[0] + i1*itsStride[1] + i2*itsStride[2]]; }
+  T& operator() (const IPosition& pos) const
+  {
+    ssize_t offset = 0;
+    for (size_t i=0; i<itsNdim; ++i) {
+      offset += pos[i] * itsStride[i];
+    }
+    return itsData[offset];
+  }
+  // </group>
+
+  // Get a view of part of an axis (with the given increment).
+  // The dimensionality is unchanged.
+  ArrayView<T> slice (size_t axis, ssize_t start, ssize_t length,
+                      ssize_t inc = 1) const
+  {
+    checkAxis (axis);
+    if (start < 0  ||  length < 0  ||  inc < 1  ||
+        (length > 0  &&  start + (length-1)*inc >= itsShape[axis])) {
+      throw ArraySlicerError ("ArrayView::slice: invalid start, length, "
+                              "or increment");
+    }
+    ArrayView<T> view(*this);
+    view.itsData += start * itsStride[axis];
+    view.itsShape[axis] = length;
+    view.itsStride[axis] *= inc;
+    view.setNels();
+    return view;
+  }
+
+  // Get a view of a section of all axes. The dimensionality is unchanged.
+  // A Slicer must be fixed (i.e., not use MimicSource).
+  // <group>
+  ArrayView<T> slice (const IPosition& blc, const IPosition& trc,
+                      const IPosition& inc) const
+  {
+    if (blc.size() != itsNdim  ||  trc.size() != itsNdim  ||
+        inc.size() != itsNdim) {
+      throw ArrayNDimError (blc.size(), itsNdim,
+                            "ArrayView::slice: invalid dimensionality");
+    }
+    ArrayView<T> view(*this);
+    for (size_t i=0; i<itsNdim; ++i) {
+      view = view.slice (i, blc[i], (trc[i] - blc[i]) / inc[i] + 1, inc[i]);
+    }
+    return view;
+  }
+  ArrayView<T> slice (const Slicer& slicer) const
+  {
+    if (! slicer.isFixed()) {
+      throw ArraySlicerError ("ArrayView::slice: Slicer is not fixed");
+    }
+    return slice (slicer.start(), slicer.end(), slicer.stride());
+  }
+  // </group>
+
+  // Get the view for the given index of an axis. The axis is removed,
+  // so the dimensionality is one less.
+  ArrayView<T> index (size_t axis, ssize_t index) const
+  {
+    checkAxis (axis);
+    if (index < 0  ||  index >= itsShape[axis]) {
+      throw ArrayIndexError ("ArrayView::index: index out of bounds");
+    }
+    ArrayView<T> view;
+    view.itsData = itsData + index * itsStride[axis];
+    view.itsNdim = itsNdim - 1;
+    for (size_t i=0, j=0; i<itsNdim; ++i) {
+      if (i != axis) {
+        view.itsShape[j]  = itsShape[i];
+        view.itsStride[j] = itsStride[i];
+        ++j;
+      }
+    }
+    view.setNels();
+    return view;
+  }
+
+  // Get the STL-style iterators.
+  // <group>
+  iterator begin() const
+    { return iterator (this, itsNels == 0  ?  0 : itsData); }
+  iterator end() const
+    { return iterator (this, 0); }
+  // </group>
+
+private:
+  template<typename U> friend class ArrayView;
+  template<typename U> friend class ArrayViewIterator;
+
+  template<typename Alloc>
+  void init (T* data, const Array<nonconst_value_type, Alloc>& arr)
+  {
+    itsData = data;
+    itsNdim = arr.ndim();
+    checkNdim (itsNdim);
+    const IPosition& shape = arr.shape();
+    const IPosition& steps = arr.steps();
+    for (size_t i=0; i<itsNdim; ++i) {
+      itsShape[i]  = shape[i];
+      itsStride[i] = steps[i];
+    }
+    itsNels = arr.nelements();
+  }
+
+  void setNels()
+  {
+    itsNels = itsNdim == 0  ?  0 : 1;
+    for (size_t i=0; i<itsNdim; ++i) {
+      itsNels *= itsShape[i];
+    }
+  }
+
+  static void checkNdim (size_t ndim)
+  {
+    if (ndim > MaxNdim) {
+      throw ArrayNDimError (ndim, MaxNdim,
+                            "ArrayView: too many dimensions");
+    }
+  }
+
+  void checkAxis (size_t axis) const
+  {
+    if (axis >= itsNdim) {
+      throw ArrayError ("ArrayView: axis exceeds dimensionality");
+    }
+  }
+
+  T*      itsData;
+  size_t  itsNdim;
+  size_t  itsNels;
+  ssize_t itsShape[MaxNdim];
+  ssize_t itsStride[MaxNdim];
+};
+
+
+// <summary>
+//    Iterate through an ArrayView taking sub-views.
+// </summary>
+//
+// <synopsis>
+// The iterator steps through the iteration axes of a view; at each step
+// the cursor is a view of the cursor axes. It is similar to ArrayIterator,
+// but the cursor is a view which is updated in place, so iterating does
+// not allocate memory.
+// <br>The first iteration axis varies fastest.
+// </synopsis>
+
+template<typename T>
+class ArrayViewIterator
+{
+public:
+  // Iterate over the first <src>byDim</src> axes (e.g. byDim=1 iterates
+  // through the lines and byDim=2 through the planes of a cube).
+  ArrayViewIterator (const ArrayView<T>& view, size_t byDim)
+  {
+    if (byDim > view.ndim()) {
+      throw ArrayIteratorError ("ArrayViewIterator: byDim exceeds "
+                                "dimensionality");
+    }
+    bool cursor[ArrayView<T>::MaxNdim];
+    for (size_t i=0; i<view.ndim(); ++i) {
+      cursor[i] = i < byDim;
+    }
+    init (view, cursor);
+  }
+
+  // Iterate with the given cursor axes (in increasing order).
+  ArrayViewIterator (const ArrayView<T>& view, const IPosition& cursorAxes)
+  {
+    bool cursor[ArrayView<T>::MaxNdim];
+    for (size_t i=0; i<view.ndim(); ++i) {
+      cursor[i] = false;
+    }
+    for (size_t i=0; i<cursorAxes.size(); ++i) {
+      if (cursorAxes[i] < 0  ||  size_t(cursorAxes[i]) >= view.ndim()) {
+        throw ArrayIteratorError ("ArrayViewIterator: invalid cursor axis");
+      }
+      cursor[cursorAxes[i]] = true;
+    }
+    init (view, cursor);
+  }
+
+  // Is the iterator past the end?
+  bool pastEnd() const
+    { return itsPastEnd; }
+
+  // Move the cursor to the next position.
+  void next()
+  {
+    for (size_t i=0; i<itsNiter; ++i) {
+      itsCursor.itsData += itsIterStride[i];
+      if (++itsPos[i] < itsIterShape[i]) {
+        return;
+      }
+      itsCursor.itsData -= itsIterShape[i] * itsIterStride[i];
+      itsPos[i] = 0;
+    }
+    itsPastEnd = true;
+  }
+
+  // Move the cursor to the start.
+  void reset()
+  {
+    itsCursor.itsData = itsStart;
+    for (size_t i=0; i<itsNiter; ++i) {
+      itsPos[i] = 0;
+    }
+    itsPastEnd = itsEmpty;
+  }
+
+  // Get the current cursor.
+  const ArrayView<T>& cursor() const
+    { return itsCursor; }
+
+  // Get the position on the given iteration axis (0 is the first
+  // iteration axis).
+  ssize_t pos (size_t iterAxis) const
+    { return itsPos[iterAxis]; }
+
+  // Get the number of iteration axes.
+  size_t niterAxes() const
+    { return itsNiter; }
+
+private:
+  void init (const ArrayView<T>& view, const bool* cursor)
+  {
+    itsStart = view.data();
+    itsCursor.itsData = itsStart;
+    itsCursor.itsNdim = 0;
+    itsNiter = 0;
+    for (size_t i=0; i<view.ndim(); ++i) {
+      if (cursor[i]) {
+        itsCursor.itsShape[itsCursor.itsNdim]  = view.shape(i);
+        itsCursor.itsStride[itsCursor.itsNdim] = view.stride(i);
+        itsCursor.itsNdim++;
+      } else {
+        itsIterShape[itsNiter]  = view.shape(i);
+        itsIterStride[itsNiter] = view.stride(i);
+        itsPos[itsNiter] = 0;
+        itsNiter++;
+      }
+    }
+    itsCursor.setNels();
+    //# A 0-dim cursor contains a single element.
+    if (itsCursor.itsNdim == 0) {
+      itsCursor.itsNels = 1;
+    }
+    itsEmpty = view.empty();
+    itsPastEnd = itsEmpty;
+  }
+
+  ArrayView<T> itsCursor;
+  T*           itsStart;
+  size_t       itsNiter;
+  bool         itsPastEnd;
+  bool         itsEmpty;
+  ssize_t      itsIterShape[ArrayView<T>::MaxNdim];
+  ssize_t      itsIterStride[ArrayView<T>::MaxNdim];
+  ssize_t      itsPos[ArrayView<T>::MaxNdim];
+};
+
+
+// Get a view of an Array.
+// <group>
+template<typename T, typename Alloc>
+inline ArrayView<T> arrayView (Array<T, Alloc>& arr)
+  { return ArrayView<T> (arr); }
+template<typename T, typename Alloc>
+inline ArrayView<const T> arrayView (const Array<T, Alloc>& arr)
+  { return ArrayView<const T> (arr); }
+// </group>
+
+// Apply a function to all elements of a view. The function gets a
+// reference to the element. The loop over the first axis is the
+// innermost loop.
+template<typename T, typename Func>
+void forEach (const ArrayView<T>& view, Func func)
+{
+  if (view.empty()) {
+    return;
+  }
+  size_t ndim = view.ndim();
+  if (view.contiguous()) {
+    T* data = view.data();
+    size_t n = view.nelements();
+    for (size_t i=0; i<n; ++i) {
+      func (data[i]);
+    }
+    return;
+  }
+  ssize_t n0 = view.shape(0);
+  ssize_t s0 = view.stride(0);
+  ssize_t pos[ArrayView<T>::MaxNdim];
+  for (size_t i=0; i<ndim; ++i) {
+    pos[i] = 0;
+  }
+  T* ptr = view.data();
+  while (true) {
+    for (ssize_t i=0; i<n0; ++i) {
+      func (ptr[i*s0]);
+    }
+    size_t ax;
+    for (ax=1; ax<ndim; ++ax) {
+      ptr += view.stride(ax);
+      if (++pos[ax] < view.shape(ax)) {
+        break;
+      }
+      ptr -= view.shape(ax) * view.stride(ax);
+      pos[ax] = 0;
+    }
+    if (ax >= ndim) {
+      break;
+    }
+  }
+}
+
+} //# NAMESPACE CASACORE - END
+
+#endif
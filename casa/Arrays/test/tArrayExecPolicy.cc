@@ -0,0 +1,209 @@
+//# tArrayExecPolicy.cc: This program tests the execution policies of Array functions
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include "../ArrayExecPolicy.h"
+#include "../ArrayMath.h"
+#include "../ArrayLogical.h"
+#include "../ArrayError.h"
+
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace casacore;
+
+BOOST_AUTO_TEST_SUITE(array_exec_policy)
+
+// Use a small grain size to get multiple chunks.
+const ArrayExecPolicy policies[] = { ArrayExecPolicy::seq(),
+                                     ArrayExecPolicy::par(100),
+                                     ArrayExecPolicy::parUnseq(100) };
+
+Array<float> makeArray (const IPosition& shape)
+{
+  Array<float> arr(shape);
+  indgen (arr, float(0.5), float(0.25));
+  return arr;
+}
+
+Array<std::complex<float>> makeComplex (const IPosition& shape)
+{
+  Array<std::complex<float>> arr(shape);
+  size_t i = 0;
+  for (std::complex<float>& v : arr) {
+    v = std::complex<float> (float(i%7) - 3, float(i%5) + 0.5);
+    ++i;
+  }
+  return arr;
+}
+
+BOOST_AUTO_TEST_CASE( policy )
+{
+  ArrayExecPolicy seq;
+  BOOST_CHECK (seq.sequential());
+  BOOST_CHECK_EQUAL (seq.nchunk(100000000), 1u);
+  ArrayExecPolicy par = ArrayExecPolicy::par (1000, 4);
+  BOOST_CHECK (par.mode() == ArrayExecPolicy::Parallel);
+  BOOST_CHECK (!par.unsequenced());
+  BOOST_CHECK_EQUAL (par.grainSize(), 1000u);
+  BOOST_CHECK_EQUAL (par.nchunk(10), 1u);
+  BOOST_CHECK (par.nchunk(100000) <= 4);
+  BOOST_CHECK (par.nchunk(100000) <= par.maxThreads());
+  BOOST_CHECK (ArrayExecPolicy::parUnseq().unsequenced());
+  size_t grain = ArrayExecPolicy::defaultGrainSize();
+  ArrayExecPolicy::setDefaultGrainSize (10);
+  BOOST_CHECK_EQUAL (ArrayExecPolicy::par().grainSize(), 10u);
+  ArrayExecPolicy::setDefaultGrainSize (grain);
+  BOOST_CHECK_EQUAL (ArrayExecPolicy::par().grainSize(), grain);
+}
+
+BOOST_AUTO_TEST_CASE( chunks )
+{
+  // All elements must be processed exactly once.
+  for (const ArrayExecPolicy& policy : policies) {
+    for (size_t n : {0, 1, 99, 100, 1001, 12345}) {
+      std::vector<int> count(n, 0);
+      arrays_internal::arrayParallelFor (policy, n,
+        [&count](size_t st, size_t end) {
+          for (size_t i=st; i<end; ++i) count[i]++;
+        });
+      BOOST_CHECK (std::all_of (count.begin(), count.end(),
+                                [](int c) { return c == 1; }));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE( transform )
+{
+  IPosition shape(3,10,20,15);
+  Array<float> a = makeArray(shape);
+  Array<float> b = a + float(1);
+  Array<float> expAdd = a + b;
+  Array<float> expMul = a * float(3);
+  Array<float> expSub = float(2) - a;
+  for (const ArrayExecPolicy& policy : policies) {
+    Array<float> res(shape);
+    arrayTransform (policy, a, b, res, std::plus<float>());
+    BOOST_CHECK (allEQ (res, expAdd));
+    arrayTransform (policy, a, float(3), res, std::multiplies<float>());
+    BOOST_CHECK (allEQ (res, expMul));
+    arrayTransform (policy, float(2), a, res, std::minus<float>());
+    BOOST_CHECK (allEQ (res, expSub));
+    arrayTransform (policy, a, res, [](float v) { return 2*v; });
+    BOOST_CHECK (allEQ (res, a + a));
+    BOOST_CHECK (allEQ (arrayTransformResult (policy, a, b, std::plus<float>()),
+                        expAdd));
+    BOOST_CHECK (allEQ (arrayTransformResult (policy, a, float(3),
+                                              std::multiplies<float>()),
+                        expMul));
+    BOOST_CHECK (allEQ (arrayTransformResult (policy, float(2), a,
+                                              std::minus<float>()),
+                        expSub));
+    Array<float> c = a.copy();
+    arrayTransformInPlace (policy, c, b, std::plus<float>());
+    BOOST_CHECK (allEQ (c, expAdd));
+    c = a;
+    arrayTransformInPlace (policy, c, float(3), std::multiplies<float>());
+    BOOST_CHECK (allEQ (c, expMul));
+    c = a;
+    arrayTransformInPlace (policy, c, [](float v) { return -v; });
+    BOOST_CHECK (allEQ (c, -a));
+  }
+}
+
+BOOST_AUTO_TEST_CASE( non_contiguous )
+{
+  // Non-contiguous arrays are processed sequentially.
+  Array<float> a = makeArray(IPosition(2,40,50));
+  Array<float> sub = a(IPosition(2,0,0), IPosition(2,39,49), IPosition(2,2,1));
+  Array<float> exp = sqrt(sub);
+  Array<float> res(sub.shape());
+  arrayTransform (ArrayExecPolicy::par(10), sub, res,
+                  [](float v) { return std::sqrt(v); });
+  BOOST_CHECK (allEQ (res, exp));
+  arrayTransformInPlace (ArrayExecPolicy::par(10), sub,
+                         [](float v) { return std::sqrt(v); });
+  BOOST_CHECK (allEQ (a(IPosition(2,0,0), IPosition(2,39,49),
+                        IPosition(2,2,1)), exp));
+}
+
+BOOST_AUTO_TEST_CASE( math_functions )
+{
+  IPosition shape(2,100,30);
+  Array<float> a = makeArray(shape);
+  Array<float> b = a / float(100);
+  Array<std::complex<float>> c = makeComplex(shape);
+  Array<std::complex<double>> dc(shape);
+  convertArray (dc, c);
+  for (const ArrayExecPolicy& policy : policies) {
+    BOOST_CHECK (allEQ (sqrt(policy, a), sqrt(a)));
+    BOOST_CHECK (allEQ (exp(policy, b), exp(b)));
+    BOOST_CHECK (allEQ (log(policy, a), log(a)));
+    BOOST_CHECK (allEQ (pow(policy, a, b), pow(a, b)));
+    BOOST_CHECK (allEQ (pow(policy, a, float(1.5)), pow(a, float(1.5))));
+    BOOST_CHECK (allEQ (amplitude(policy, c), amplitude(c)));
+    BOOST_CHECK (allEQ (phase(policy, c), phase(c)));
+    BOOST_CHECK (allEQ (conj(policy, c), conj(c)));
+    BOOST_CHECK (allEQ (amplitude(policy, dc), amplitude(dc)));
+    BOOST_CHECK (allEQ (phase(policy, dc), phase(dc)));
+    BOOST_CHECK (allEQ (conj(policy, dc), conj(dc)));
+  }
+  BOOST_CHECK_THROW (pow(ArrayExecPolicy::par(), a, Array<float>(IPosition(1,3))),
+                     ArrayConformanceError);
+}
+
+BOOST_AUTO_TEST_CASE( comparisons )
+{
+  IPosition shape(2,100,30);
+  Array<float> a = makeArray(shape);
+  Array<float> b = float(400) - a;
+  Array<float> n = a.copy();
+  n.data()[123] = std::numeric_limits<float>::quiet_NaN();
+  n.data()[2345] = std::numeric_limits<float>::infinity();
+  for (const ArrayExecPolicy& policy : policies) {
+    BOOST_CHECK (allEQ (arrayCompare (policy, a, b, std::less<float>()),
+                        a < b));
+    BOOST_CHECK (allEQ (arrayCompare (policy, a, float(200),
+                                      std::greater_equal<float>()),
+                        a >= float(200)));
+    BOOST_CHECK (allEQ (arrayCompare (policy, float(200), a,
+                                      std::equal_to<float>()),
+                        float(200) == a));
+    BOOST_CHECK (allEQ (near (policy, a, b, 1e-5), near (a, b, 1e-5)));
+    BOOST_CHECK (allEQ (nearAbs (policy, a, b, 10.), nearAbs (a, b, 10.)));
+    BOOST_CHECK (allEQ (isNaN (policy, n), isNaN (n)));
+    BOOST_CHECK (allEQ (isFinite (policy, n), isFinite (n)));
+  }
+  BOOST_CHECK_THROW (arrayCompare (ArrayExecPolicy::par(), a,
+                                   Array<float>(IPosition(1,3)),
+                                   std::less<float>()),
+                     ArrayConformanceError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
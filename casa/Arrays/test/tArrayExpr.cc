@@ -0,0 +1,147 @@
+//# tArrayExpr.cc: This program tests the lazy Array expressions
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include "../ArrayExpr.h"
+#include "../ArrayMath.h"
+#include "../ArrayLogical.h"
+#include "../ArrayError.h"
+
+#include <complex>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace casacore;
+
+BOOST_AUTO_TEST_SUITE(array_expr)
+
+typedef std::complex<float> Cplx;
+
+Array<Cplx> makeArray (const IPosition& shape, float start)
+{
+  Array<Cplx> arr(shape);
+  float v = start;
+  for (Cplx& elem : arr) {
+    elem = Cplx(v, -0.5f*v);
+    v += 1;
+  }
+  return arr;
+}
+
+BOOST_AUTO_TEST_CASE( complex_fused )
+{
+  IPosition shape(3,4,5,6);
+  Array<Cplx> a = makeArray(shape, 1);
+  Array<Cplx> b = makeArray(shape, 2);
+  Array<Cplx> c = makeArray(shape, 3);
+  Array<Cplx> d = makeArray(shape, 4);
+  Array<Cplx> res;
+  assignExpr (res, arrayExpr(a)*b + arrayExpr(c)*conj(arrayExpr(d)));
+  BOOST_CHECK (res.shape() == shape);
+  BOOST_CHECK (allNearAbs (res, a*b + c*conj(d), 1e-3));
+  Array<Cplx> res2 = evalExpr (-arrayExpr(a)/b - Cplx(2,1));
+  BOOST_CHECK (allNearAbs (res2, -a/b - Cplx(2,1), 1e-5));
+  Array<Cplx> res3 = evalExpr (Cplx(2,1) * arrayExpr(a) - b);
+  BOOST_CHECK (allNearAbs (res3, Cplx(2,1)*a - b, 1e-4));
+}
+
+BOOST_AUTO_TEST_CASE( functions )
+{
+  IPosition shape(2,7,3);
+  Array<Cplx> a = makeArray(shape, 1);
+  Array<float> re = evalExpr (real(arrayExpr(a)));
+  Array<float> im = evalExpr (imag(arrayExpr(a)));
+  BOOST_CHECK (allEQ (re, real(a)));
+  BOOST_CHECK (allEQ (im, imag(a)));
+  BOOST_CHECK (allNearAbs (evalExpr(abs(arrayExpr(a))), amplitude(a), 1e-4));
+  BOOST_CHECK (allNearAbs (evalExpr(norm(arrayExpr(a))),
+                           real(a*conj(a)), 1e-3));
+  BOOST_CHECK (allNearAbs (evalExpr(arg(arrayExpr(a))), phase(a), 1e-6));
+  Array<float> f = re / float(30);
+  BOOST_CHECK (allNearAbs (evalExpr(sqrt(arrayExpr(f))), sqrt(f), 1e-6));
+  BOOST_CHECK (allNearAbs (evalExpr(exp(arrayExpr(f))), exp(f), 1e-5));
+  BOOST_CHECK (allNearAbs (evalExpr(log(arrayExpr(f))), log(f), 1e-5));
+  BOOST_CHECK (allNearAbs (evalExpr(sin(arrayExpr(f)) + cos(arrayExpr(f))),
+                           sin(f) + cos(f), 1e-5));
+  // Functions on real values.
+  BOOST_CHECK (allEQ (evalExpr(conj(arrayExpr(f))), f));
+  BOOST_CHECK (allEQ (evalExpr(imag(arrayExpr(f))), float(0)));
+  BOOST_CHECK (allNearAbs (evalExpr(norm(arrayExpr(f))), f*f, 1e-6));
+}
+
+BOOST_AUTO_TEST_CASE( mixed_types )
+{
+  IPosition shape(2,5,6);
+  Array<Cplx> a = makeArray(shape, 1);
+  Array<float> w(shape);
+  indgen (w, float(1));
+  Array<Cplx> res = evalExpr (arrayExpr(a) * arrayExpr(w) + 1.f);
+  Array<Cplx> exp(shape);
+  for (size_t i=0; i<res.nelements(); ++i) {
+    exp.data()[i] = a.data()[i] * w.data()[i] + 1.f;
+  }
+  BOOST_CHECK (allNearAbs (res, exp, 1e-4));
+  Array<float> wsq = evalExpr (arrayExpr(w) * w);
+  BOOST_CHECK (allEQ (wsq, w*w));
+}
+
+BOOST_AUTO_TEST_CASE( in_place )
+{
+  IPosition shape(3,4,5,6);
+  Array<Cplx> a = makeArray(shape, 1);
+  Array<Cplx> b = makeArray(shape, 2);
+  Array<Cplx> exp = a*Cplx(2,0) + b;
+  assignExpr (a, arrayExpr(a)*Cplx(2,0) + b);
+  BOOST_CHECK (allNearAbs (a, exp, 1e-4));
+}
+
+BOOST_AUTO_TEST_CASE( non_contiguous )
+{
+  Array<Cplx> a = makeArray(IPosition(2,6,8), 1);
+  Array<Cplx> b = makeArray(IPosition(2,3,4), 2);
+  Array<Cplx> sub = a(IPosition(2,0,0), IPosition(2,4,6), IPosition(2,2,2));
+  BOOST_CHECK (! sub.contiguousStorage());
+  Array<Cplx> exp = sub*b;
+  Array<Cplx> res = evalExpr (arrayExpr(sub) * b);
+  BOOST_CHECK (allNearAbs (res, exp, 1e-4));
+  // Assign to a non-contiguous target.
+  assignExpr (sub, arrayExpr(b) * b);
+  BOOST_CHECK (allNearAbs (a(IPosition(2,0,0), IPosition(2,4,6),
+                             IPosition(2,2,2)), b*b, 1e-4));
+}
+
+BOOST_AUTO_TEST_CASE( shape_errors )
+{
+  Array<Cplx> a(IPosition(2,4,5), Cplx());
+  Array<Cplx> b(IPosition(2,5,4), Cplx());
+  BOOST_CHECK_THROW (arrayExpr(a) + b, ArrayConformanceError);
+  BOOST_CHECK_THROW (arrayExpr(a) * conj(arrayExpr(b)),
+                     ArrayConformanceError);
+  Array<Cplx> res(IPosition(1,20));
+  BOOST_CHECK_THROW (assignExpr (res, arrayExpr(a) + a),
+                     ArrayConformanceError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
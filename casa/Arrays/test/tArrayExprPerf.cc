@@ -0,0 +1,86 @@
+//# tArrayExprPerf.cc: Compare the speed of fused and ArrayMath expressions
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include "../ArrayExpr.h"
+#include "../ArrayMath.h"
+
+#include <chrono>
+#include <complex>
+#include <cstdlib>
+#include <iostream>
+
+using namespace casacore;
+
+// This program compares the throughput of the fused evaluation of
+// a*b + c*conj(d) for complex arrays with the evaluation by the
+// ArrayMath operators (which create temporary arrays).
+// The number of elements can be given as the first argument;
+// it defaults to 10^8 (which needs about 5 GBytes of memory).
+
+typedef std::complex<float> Cplx;
+
+double elapsed (const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double>
+    (std::chrono::steady_clock::now() - start).count();
+}
+
+void report (const char* name, size_t n, double sec)
+{
+  std::cout << name << ": " << sec << " sec, "
+            << n / sec / 1e6 << " Melem/sec" << std::endl;
+}
+
+int main (int argc, const char* argv[])
+{
+  size_t n = 100000000;
+  if (argc > 1) {
+    n = std::strtoul (argv[1], 0, 10);
+  }
+  IPosition shape(1, n);
+  Array<Cplx> a(shape, Cplx(1,2));
+  Array<Cplx> b(shape, Cplx(3,-1));
+  Array<Cplx> c(shape, Cplx(0.5,0.5));
+  Array<Cplx> d(shape, Cplx(2,1));
+  Array<Cplx> res1(shape);
+  Array<Cplx> res2(shape);
+  std::cout << "a*b + c*conj(d) for " << n << " complex elements"
+            << std::endl;
+  auto start = std::chrono::steady_clock::now();
+  res1 = a*b + c*conj(d);
+  double tmath = elapsed (start);
+  report ("ArrayMath", n, tmath);
+  start = std::chrono::steady_clock::now();
+  assignExpr (res2, arrayExpr(a)*b + arrayExpr(c)*conj(arrayExpr(d)));
+  double texpr = elapsed (start);
+  report ("fused    ", n, texpr);
+  std::cout << "speedup  : " << tmath / texpr << std::endl;
+  if (res1.data()[n/2] != res2.data()[n/2]) {
+    std::cout << "Results differ" << std::endl;
+    return 1;
+  }
+  return 0;
+}
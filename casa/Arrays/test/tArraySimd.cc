@@ -0,0 +1,237 @@
+//# tArraySimd.cc: This program tests the vectorized Array reductions
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include "../ArraySimd.h"
+#include "../ArrayMath.h"
+#include "../ArrayPartMath.h"
+#include "../ArrayLogical.h"
+
+#include <complex>
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace casacore;
+
+BOOST_AUTO_TEST_SUITE(array_simd)
+
+template<typename T>
+Array<T> makeArray (const IPosition& shape)
+{
+  Array<T> arr(shape);
+  indgen (arr);
+  arr -= T(arr.nelements() / 3);
+  return arr;
+}
+
+template<typename T>
+Array<std::complex<T>> makeComplex (const IPosition& shape)
+{
+  Array<std::complex<T>> arr(shape);
+  size_t i = 0;
+  for (std::complex<T>& v : arr) {
+    v = std::complex<T> (T(i%7) - 3, T(i%5) + 0.5);
+    ++i;
+  }
+  return arr;
+}
+
+// Check the kernels for all sizes around the number of lanes.
+template<typename T>
+void checkReal()
+{
+  for (size_t n=1; n<70; ++n) {
+    Array<T> arr = makeArray<T> (IPosition(1,n));
+    const T* data = arr.data();
+    BOOST_CHECK_EQUAL (arrays_internal::simdSum (data, n),
+                       std::accumulate (data, data+n, T()));
+    T sumsq = 0;
+    T minv = data[0];
+    T maxv = data[0];
+    for (size_t i=0; i<n; ++i) {
+      sumsq += data[i] * data[i];
+      minv = std::min (minv, data[i]);
+      maxv = std::max (maxv, data[i]);
+    }
+    BOOST_CHECK_EQUAL (arrays_internal::simdSumSqr (data, n), sumsq);
+    T mn, mx;
+    arrays_internal::simdMinMax (mn, mx, data, n);
+    BOOST_CHECK_EQUAL (mn, minv);
+    BOOST_CHECK_EQUAL (mx, maxv);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( real_kernels )
+{
+  checkReal<float>();
+  checkReal<double>();
+  checkReal<int>();
+}
+
+template<typename T>
+void checkComplex()
+{
+  for (size_t n=1; n<40; ++n) {
+    Array<std::complex<T>> arr = makeComplex<T> (IPosition(1,n));
+    const std::complex<T>* data = arr.data();
+    std::complex<T> sum;
+    std::complex<T> sumsq;
+    for (size_t i=0; i<n; ++i) {
+      sum += data[i];
+      sumsq += data[i] * data[i];
+    }
+    BOOST_CHECK (arrays_internal::simdSum (data, n) == sum);
+    BOOST_CHECK (arrays_internal::simdSumSqr (data, n) == sumsq);
+  }
+}
+
+BOOST_AUTO_TEST_CASE( complex_kernels )
+{
+  checkComplex<float>();
+  checkComplex<double>();
+}
+
+BOOST_AUTO_TEST_CASE( nan_values )
+{
+  Array<float> arr = makeArray<float> (IPosition(1,40));
+  arr.data()[17] = std::numeric_limits<float>::quiet_NaN();
+  float mn, mx;
+  minMax (mn, mx, arr);
+  BOOST_CHECK_EQUAL (mn, -13);
+  BOOST_CHECK_EQUAL (mx, 26);
+  arr.data()[0] = std::numeric_limits<float>::quiet_NaN();
+  minMax (mn, mx, arr);
+  BOOST_CHECK (std::isnan(mn)  &&  std::isnan(mx));
+}
+
+BOOST_AUTO_TEST_CASE( reductions )
+{
+  Array<double> arr = makeArray<double> (IPosition(3,5,7,3));
+  BOOST_CHECK_EQUAL (sum(arr), 1785);
+  BOOST_CHECK_EQUAL (mean(arr), 17);
+  BOOST_CHECK_EQUAL (min(arr), -35);
+  BOOST_CHECK_EQUAL (max(arr), 69);
+  BOOST_CHECK_CLOSE (rms(arr), std::sqrt(sumsqr(arr)/105), 1e-10);
+  // Non-contiguous arrays use the iterator loops.
+  Array<double> sub = arr(IPosition(3,1,0,0), IPosition(3,3,6,2));
+  BOOST_CHECK_EQUAL (sum(sub), sum(sub.copy()));
+  BOOST_CHECK_EQUAL (max(sub), max(sub.copy()));
+  Array<std::complex<float>> carr = makeComplex<float> (IPosition(2,4,9));
+  BOOST_CHECK (sum(carr) == std::complex<float>(-3, 88));
+}
+
+// Check partialSums and partialMaxs against a straightforward calculation.
+template<typename T>
+void checkPartial (const Array<T>& arr, const IPosition& collapseAxes)
+{
+  Array<T> sums = partialSums (arr, collapseAxes);
+  Array<T> maxs = partialMaxs (arr, collapseAxes);
+  IPosition resShape = sums.shape();
+  Array<T> expSums(resShape, T());
+  Array<T> expMaxs(resShape);
+  IPosition otherAxes = IPosition::otherAxes (arr.ndim(), collapseAxes);
+  Array<bool> set(resShape, false);
+  IPosition pos(arr.ndim(), 0);
+  IPosition respos(resShape.size(), 0);
+  for (size_t i=0; i<arr.nelements(); ++i) {
+    for (size_t j=0; j<otherAxes.size(); ++j) {
+      respos[j] = pos[otherAxes[j]];
+    }
+    T v = arr(pos);
+    expSums(respos) += v;
+    if (!set(respos)  ||  v > expMaxs(respos)) {
+      expMaxs(respos) = v;
+      set(respos) = true;
+    }
+    for (size_t ax=0; ax<arr.ndim(); ++ax) {
+      if (++pos[ax] < arr.shape()[ax]) break;
+      pos[ax] = 0;
+    }
+  }
+  BOOST_CHECK (allEQ (sums, expSums));
+  BOOST_CHECK (allEQ (maxs, expMaxs));
+}
+
+BOOST_AUTO_TEST_CASE( partial_reductions )
+{
+  Array<float> arr = makeArray<float> (IPosition(4,4,6,5,3));
+  checkPartial (arr, IPosition(1,0));
+  checkPartial (arr, IPosition(1,1));
+  checkPartial (arr, IPosition(1,2));
+  checkPartial (arr, IPosition(1,3));
+  checkPartial (arr, IPosition(2,1,2));
+  checkPartial (arr, IPosition(2,1,3));
+  checkPartial (arr, IPosition(2,0,2));
+  checkPartial (arr, IPosition(3,0,1,3));
+  checkPartial (arr, IPosition(4,0,1,2,3));
+  // A first axis of length 1 is handled as non-contiguous.
+  Array<double> arr1 = makeArray<double> (IPosition(3,1,6,5));
+  checkPartial (arr1, IPosition(1,0));
+  checkPartial (arr1, IPosition(2,0,2));
+  checkPartial (makeArray<int> (IPosition(3,4,6,5)), IPosition(1,1));
+}
+
+BOOST_AUTO_TEST_CASE( partial_empty )
+{
+  // Empty leading or trailing non-collapsed axes give an empty result.
+  Array<float> sums = partialSums (Array<float>(IPosition(2,0,5)),
+                                   IPosition(1,1));
+  BOOST_CHECK (sums.shape() == IPosition(1,0));
+  checkPartial (Array<float>(IPosition(2,0,5)), IPosition(1,1));
+  checkPartial (Array<double>(IPosition(3,3,5,0)), IPosition(1,1));
+  checkPartial (Array<int>(IPosition(3,0,5,2)), IPosition(2,1,2));
+  // Summing an empty collapse axis gives zeroes.
+  sums = partialSums (Array<float>(IPosition(2,4,0)), IPosition(1,1));
+  BOOST_CHECK (sums.shape() == IPosition(1,4));
+  BOOST_CHECK (allEQ (sums, 0.f));
+  // The kernels do nothing for empty rows.
+  float res[2] = {1, 2};
+  float data[1] = {3};
+  arrays_internal::simdAddRows (res, data, 0, 5);
+  arrays_internal::simdMaxRows (res, data, 0, 5);
+  arrays_internal::simdAddRows (res, data, 2, 0);
+  arrays_internal::simdMaxRows (res, data, 2, 0);
+  BOOST_CHECK (res[0] == 1  &&  res[1] == 2);
+}
+
+BOOST_AUTO_TEST_CASE( partial_complex )
+{
+  // Sum the channels of a visibility cube.
+  Array<std::complex<float>> arr = makeComplex<float> (IPosition(3,4,16,10));
+  Array<std::complex<float>> sums = partialSums (arr, IPosition(1,1));
+  BOOST_CHECK (sums.shape() == IPosition(2,4,10));
+  for (size_t row=0; row<10; ++row) {
+    for (size_t pol=0; pol<4; ++pol) {
+      std::complex<float> exp;
+      for (size_t chan=0; chan<16; ++chan) {
+        exp += arr(IPosition(3,pol,chan,row));
+      }
+      BOOST_CHECK (sums(IPosition(2,pol,row)) == exp);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,261 @@
+//# tArrayView.cc: This program tests the non-owning Array views
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include "../ArrayView.h"
+#include "../ArrayIter.h"
+#include "../ArrayMath.h"
+#include "../ArrayLogical.h"
+#include "../Slicer.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <boost/test/unit_test.hpp>
+
+//# Count the heap allocations to check that views do not allocate.
+//# Note that this file is linked into a program with other tests, so the
+//# replaced operators are used by all of them.
+namespace {
+  std::atomic<size_t> nalloc(0);
+}
+
+void* operator new (size_t size)
+{
+  ++nalloc;
+  void* ptr = std::malloc (size == 0  ?  1 : size);
+  if (ptr == 0) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+void* operator new[] (size_t size)
+  { return operator new (size); }
+void operator delete (void* ptr) noexcept
+  { std::free (ptr); }
+void operator delete[] (void* ptr) noexcept
+  { std::free (ptr); }
+void operator delete (void* ptr, size_t) noexcept
+  { std::free (ptr); }
+void operator delete[] (void* ptr, size_t) noexcept
+  { std::free (ptr); }
+
+using namespace casacore;
+
+BOOST_AUTO_TEST_SUITE(array_view)
+
+Array<int> makeCube()
+{
+  Array<int> arr(IPosition(3,5,4,3));
+  indgen (arr);
+  return arr;
+}
+
+BOOST_AUTO_TEST_CASE( full_view )
+{
+  Array<int> arr = makeCube();
+  ArrayView<int> view = arrayView(arr);
+  BOOST_CHECK_EQUAL (view.ndim(), 3u);
+  BOOST_CHECK_EQUAL (view.shape(), arr.shape());
+  BOOST_CHECK_EQUAL (view.nelements(), arr.nelements());
+  BOOST_CHECK (view.contiguous());
+  BOOST_CHECK_EQUAL (view(1,2,1), arr(IPosition(3,1,2,1)));
+  BOOST_CHECK_EQUAL (view(IPosition(3,4,3,2)), arr(IPosition(3,4,3,2)));
+  view(0,0,0) = -1;
+  BOOST_CHECK_EQUAL (arr(IPosition(3,0)), -1);
+  // Iterate using the STL-style iterator.
+  Array<int>::const_iterator ait = arr.begin();
+  size_t n = 0;
+  for (int v : view) {
+    BOOST_CHECK_EQUAL (v, *ait);
+    ++ait;
+    ++n;
+  }
+  BOOST_CHECK_EQUAL (n, arr.nelements());
+  // A view of a const Array is read-only.
+  const Array<int>& carr = arr;
+  ArrayView<const int> cview = arrayView(carr);
+  BOOST_CHECK_EQUAL (cview(4,3,2), view(4,3,2));
+  ArrayView<const int> cview2 (view);
+  BOOST_CHECK_EQUAL (cview2.data(), view.data());
+}
+
+BOOST_AUTO_TEST_CASE( empty_view )
+{
+  Array<int> arr;
+  ArrayView<int> view = arrayView(arr);
+  BOOST_CHECK (view.empty());
+  BOOST_CHECK (view.begin() == view.end());
+  size_t n = 0;
+  forEach (view, [&n](int) { ++n; });
+  BOOST_CHECK_EQUAL (n, 0u);
+}
+
+BOOST_AUTO_TEST_CASE( slice_view )
+{
+  Array<int> arr = makeCube();
+  ArrayView<int> view = arrayView(arr);
+  IPosition blc(3,1,0,1);
+  IPosition trc(3,4,3,2);
+  IPosition inc(3,2,3,1);
+  Array<int> sub = arr(blc, trc, inc);
+  ArrayView<int> sview = view.slice (blc, trc, inc);
+  BOOST_CHECK_EQUAL (sview.shape(), sub.shape());
+  BOOST_CHECK (! sview.contiguous());
+  Array<int>::const_iterator ait = sub.begin();
+  for (ArrayView<int>::iterator it=sview.begin(); it!=sview.end(); ++it) {
+    BOOST_CHECK_EQUAL (*it, *ait);
+    ++ait;
+  }
+  // Slicing using a Slicer gives the same result.
+  ArrayView<int> sview2 = view.slice (Slicer(blc, trc, inc,
+                                             Slicer::endIsLast));
+  BOOST_CHECK_EQUAL (sview2.data(), sview.data());
+  BOOST_CHECK_EQUAL (sview2.shape(), sview.shape());
+  BOOST_CHECK_THROW (view.slice (Slicer(IPosition(3,0),
+                                        IPosition(3,Slicer::MimicSource),
+                                        Slicer::endIsLast)),
+                     ArraySlicerError);
+  // Slice a single axis.
+  ArrayView<int> lview = view.slice (1, 1, 2);
+  BOOST_CHECK_EQUAL (lview.shape(), IPosition(3,5,2,3));
+  BOOST_CHECK_EQUAL (lview(0,0,0), arr(IPosition(3,0,1,0)));
+  BOOST_CHECK_THROW (view.slice (1, 3, 2), ArraySlicerError);
+  BOOST_CHECK_THROW (view.slice (3, 0, 1), ArrayError);
+  // Fix the index of an axis.
+  ArrayView<int> spec = view.index(0,2).index(0,3);
+  BOOST_CHECK_EQUAL (spec.ndim(), 1u);
+  BOOST_CHECK_EQUAL (spec.shape(0), 3);
+  for (ssize_t i=0; i<3; ++i) {
+    BOOST_CHECK_EQUAL (spec(i), arr(IPosition(3,2,3,i)));
+  }
+  BOOST_CHECK_THROW (view.index (1, 4), ArrayIndexError);
+}
+
+BOOST_AUTO_TEST_CASE( foreach_view )
+{
+  Array<int> arr = makeCube();
+  ArrayView<int> view = arrayView(arr);
+  ArrayView<int> sview = view.slice (IPosition(3,1,1,0), IPosition(3,3,3,2),
+                                     IPosition(3,1,2,1));
+  int sum = 0;
+  forEach (sview, [&sum](int v) { sum += v; });
+  BOOST_CHECK_EQUAL (sum, casacore::sum (arr(IPosition(3,1,1,0),
+                                            IPosition(3,3,3,2),
+                                            IPosition(3,1,2,1))));
+  forEach (sview, [](int& v) { v = 0; });
+  BOOST_CHECK (allEQ (arr(IPosition(3,1,1,0), IPosition(3,3,3,2),
+                          IPosition(3,1,2,1)), 0));
+}
+
+BOOST_AUTO_TEST_CASE( iterate_view )
+{
+  Array<int> arr = makeCube();
+  // Iterate by planes and compare with ArrayIterator.
+  {
+    ArrayViewIterator<const int> iter(arrayView(arr), 2);
+    ArrayIterator<int> aiter(arr, 2);
+    size_t n = 0;
+    for (; !iter.pastEnd(); iter.next(), aiter.next()) {
+      BOOST_CHECK (! aiter.pastEnd());
+      BOOST_CHECK_EQUAL (iter.cursor().shape(), aiter.array().shape());
+      BOOST_CHECK_EQUAL (iter.cursor().data(), aiter.array().data());
+      ++n;
+    }
+    BOOST_CHECK (aiter.pastEnd());
+    BOOST_CHECK_EQUAL (n, 3u);
+    iter.reset();
+    BOOST_CHECK (! iter.pastEnd());
+    BOOST_CHECK_EQUAL (iter.cursor().data(), arr.data());
+  }
+  // Iterate with cursor axis 1 (non-contiguous lines).
+  {
+    ArrayViewIterator<int> iter(arrayView(arr), IPosition(1,1));
+    BOOST_CHECK_EQUAL (iter.niterAxes(), 2u);
+    ArrayIterator<int> aiter(arr, IPosition(1,1));
+    for (; !iter.pastEnd(); iter.next(), aiter.next()) {
+      const ArrayView<int>& cursor = iter.cursor();
+      Array<int> line = aiter.array();
+      BOOST_CHECK_EQUAL (cursor.nelements(), line.nelements());
+      for (ssize_t i=0; i<cursor.shape(0); ++i) {
+        BOOST_CHECK_EQUAL (cursor(i), line(IPosition(1,i)));
+      }
+    }
+    BOOST_CHECK (aiter.pastEnd());
+  }
+  // A 0-dim cursor iterates over the elements.
+  {
+    ArrayViewIterator<int> iter(arrayView(arr), 0);
+    size_t n = 0;
+    for (; !iter.pastEnd(); iter.next()) {
+      BOOST_CHECK_EQUAL (*iter.cursor().data(), int(n));
+      ++n;
+    }
+    BOOST_CHECK_EQUAL (n, arr.nelements());
+  }
+  BOOST_CHECK_THROW (ArrayViewIterator<int>(arrayView(arr), 4),
+                     ArrayIteratorError);
+}
+
+BOOST_AUTO_TEST_CASE( no_allocations )
+{
+  Array<float> cube(IPosition(4,8,16,16,4));
+  indgen (cube);
+  const IPosition blc(4,1,2,3,0);
+  const IPosition trc(4,6,14,15,3);
+  const IPosition inc(4,1,2,3,1);
+  const Slicer slicer(blc, trc, inc, Slicer::endIsLast);
+  double total = 0;
+  size_t nstart = nalloc;
+  for (int rep=0; rep<10; ++rep) {
+    ArrayView<const float> view = arrayView(cube);
+    // Slice and iterate by lines.
+    ArrayView<const float> sview = view.slice (slicer);
+    for (ArrayViewIterator<const float> iter(sview, 1);
+         !iter.pastEnd(); iter.next()) {
+      forEach (iter.cursor(), [&total](float v) { total += v; });
+    }
+    // Iterate the planes and take a spectrum from each plane.
+    for (ArrayViewIterator<const float> iter(view, IPosition(2,1,2));
+         !iter.pastEnd(); iter.next()) {
+      ArrayView<const float> spec = iter.cursor().index(1, 3);
+      for (float v : spec) {
+        total += v;
+      }
+    }
+    ArrayView<const float> pix = view.index(0,2).slice(0, 1, 5, 3);
+    total += pix(1,1,1);
+  }
+  BOOST_CHECK_EQUAL (size_t(nalloc) - nstart, 0u);
+  BOOST_CHECK (total > 0);
+  // Iterating with an ArrayIterator does allocate.
+  nstart = nalloc;
+  ArrayIterator<float> aiter(cube, 1);
+  BOOST_CHECK (size_t(nalloc) > nstart);
+  BOOST_CHECK (! aiter.pastEnd());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,304 @@
+//# HugePageAllocator.cc: Allocator for large arrays using huge pages and NUMA
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/Containers/HugePageAllocator.h>
+#include <casacore/casa/Containers/Allocator.h>
+#include <casacore/casa/OS/MemoryTrace.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#if defined(AIPS_LINUX)
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# define CASA_HUGEPAGE_MMAP
+#endif
+
+//# The NUMA policies of mbind (see linux/mempolicy.h).
+#ifndef MPOL_BIND
+# define MPOL_BIND 2
+#endif
+#ifndef MPOL_INTERLEAVE
+# define MPOL_INTERLEAVE 3
+#endif
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+namespace {
+
+  // The global state. The options are atomics, so they can be read
+  // without locking. The registry of mapped blocks is guarded by the
+  // mutex; it is only used for large blocks which are allocated rarely.
+  struct HugePageState
+  {
+    HugePageState()
+      : minThreshold (HugePageAllocatorBase::Options().threshold),
+        mappedBytes  (0)
+    {
+      storeOptions (HugePageAllocatorBase::Options());
+    }
+    void storeOptions (const HugePageAllocatorBase::Options& opt)
+    {
+      //# Lower the minimum first, so a thread seeing the new threshold
+      //# also sees the new minimum.
+      if (opt.threshold < minThreshold) {
+        minThreshold = opt.threshold;
+      }
+      threshold  = opt.threshold;
+      hugePages  = opt.hugePages;
+      numaPolicy = opt.numaPolicy;
+      numaNode   = opt.numaNode;
+    }
+    std::atomic<size_t> threshold;
+    std::atomic<Int>    hugePages;
+    std::atomic<Int>    numaPolicy;
+    std::atomic<Int>    numaNode;
+    //# The lowest threshold ever set. A smaller block cannot be mapped.
+    std::atomic<size_t> minThreshold;
+    std::mutex mutex;
+    //# The mapped blocks and their mapped sizes.
+    std::map<void*,size_t> blocks;
+    size_t mappedBytes;
+  };
+
+  // The state is never destructed, because blocks can be freed
+  // by destructors of static objects.
+  HugePageState& hugePageState()
+  {
+    static std::aligned_storage<sizeof(HugePageState),
+                                alignof(HugePageState)>::type storage;
+    static HugePageState* state = new (&storage) HugePageState();
+    return *state;
+  }
+
+  void* alignedAlloc (size_t nbytes)
+  {
+    void* ptr = 0;
+    if (posix_memalign (&ptr, CASA_DEFAULT_ALIGNMENT,
+                        nbytes == 0  ?  1 : nbytes) != 0) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+
+  // Parse a node list like "0-3,5".
+  std::vector<Int> parseNodeList (const std::string& list)
+  {
+    std::vector<Int> nodes;
+    std::istringstream istr(list);
+    std::string part;
+    while (std::getline (istr, part, ',')) {
+      if (! part.empty()) {
+        size_t pos = part.find ('-');
+        Int st = atoi (part.c_str());
+        Int end = (pos == std::string::npos  ?  st :
+                   atoi (part.c_str() + pos + 1));
+        for (Int i=st; i<=end; ++i) {
+          nodes.push_back (i);
+        }
+      }
+    }
+    return nodes;
+  }
+
+#ifdef CASA_HUGEPAGE_MMAP
+  // Set the NUMA policy of the mapped memory. Errors are ignored.
+  void setNumaPolicy (void* ptr, size_t len,
+                      const HugePageAllocatorBase::Options& opt)
+  {
+    const std::vector<Int>& nodes = HugePageAllocatorBase::numaNodes();
+    if (opt.numaPolicy == HugePageAllocatorBase::NumaDefault  ||
+        nodes.size() < 2) {
+      return;
+    }
+    const size_t nbits = 8*sizeof(unsigned long);
+    std::vector<unsigned long> mask ((nodes.back() + nbits) / nbits, 0);
+    int mode;
+    if (opt.numaPolicy == HugePageAllocatorBase::NumaInterleave) {
+      mode = MPOL_INTERLEAVE;
+      for (Int node : nodes) {
+        mask[node/nbits] |= 1UL << (node%nbits);
+      }
+    } else {
+      mode = MPOL_BIND;
+      Int node = opt.numaNode;
+      if (node < 0  ||  node > nodes.back()) {
+        return;
+      }
+      mask[node/nbits] |= 1UL << (node%nbits);
+    }
+# ifdef SYS_mbind
+    //# The kernel uses maxnode-1 bits of the mask.
+    syscall (SYS_mbind, ptr, len, mode, mask.data(),
+             mask.size()*nbits + 1, 0);
+# else
+    (void)ptr; (void)len; (void)mode;
+# endif
+  }
+
+  // Map a block aligned to the huge page size.
+  void* mapBlock (size_t len, const HugePageAllocatorBase::Options& opt)
+  {
+    void* ptr = MAP_FAILED;
+# ifdef MAP_HUGETLB
+    if (opt.hugePages == HugePageAllocatorBase::ExplicitHugePages) {
+      ptr = mmap (0, len, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+# endif
+    if (ptr == MAP_FAILED) {
+      // Map an extra huge page and unmap the unaligned head and tail.
+      size_t align = HugePageAllocatorBase::hugePageSize();
+      void* mptr = mmap (0, len + align, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (mptr == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+      char* start = static_cast<char*>(mptr);
+      char* aligned = start + (align - size_t(start) % align) % align;
+      if (aligned > start) {
+        munmap (start, aligned - start);
+      }
+      size_t tail = (start + len + align) - (aligned + len);
+      if (tail > 0) {
+        munmap (aligned + len, tail);
+      }
+      ptr = aligned;
+# ifdef MADV_HUGEPAGE
+      if (opt.hugePages != HugePageAllocatorBase::NoHugePages) {
+        madvise (ptr, len, MADV_HUGEPAGE);
+      }
+# endif
+    }
+    setNumaPolicy (ptr, len, opt);
+    return ptr;
+  }
+#endif
+
+} //# end anonymous namespace
+
+
+HugePageAllocatorBase::Options HugePageAllocatorBase::options()
+{
+  HugePageState& state = hugePageState();
+  Options opt;
+  opt.threshold  = state.threshold;
+  opt.hugePages  = HugePages(Int(state.hugePages));
+  opt.numaPolicy = NumaPolicy(Int(state.numaPolicy));
+  opt.numaNode   = state.numaNode;
+  return opt;
+}
+
+void HugePageAllocatorBase::setOptions (const Options& options)
+{
+  HugePageState& state = hugePageState();
+  // The lock only serializes concurrent setOptions calls.
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.storeOptions (options);
+}
+
+void* HugePageAllocatorBase::allocate (size_t nbytes)
+{
+  HugePageState& state = hugePageState();
+  void* ptr;
+#ifdef CASA_HUGEPAGE_MMAP
+  if (nbytes > 0  &&  nbytes >= state.threshold) {
+    Options opt = options();
+    size_t align = hugePageSize();
+    size_t len = (nbytes + align - 1) / align * align;
+    ptr = mapBlock (len, opt);
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.blocks[ptr] = len;
+    state.mappedBytes += len;
+  } else {
+    ptr = alignedAlloc (nbytes);
+  }
+#else
+  (void)state;
+  ptr = alignedAlloc (nbytes);
+#endif
+  traceMemoryAlloc (ptr, nbytes, " HugePageAllocator");
+  return ptr;
+}
+
+void HugePageAllocatorBase::deallocate (void* ptr, size_t nbytes)
+{
+  if (! ptr) {
+    return;
+  }
+  traceMemoryFree (ptr, " HugePageAllocator");
+#ifdef CASA_HUGEPAGE_MMAP
+  HugePageState& state = hugePageState();
+  // A block smaller than any threshold used cannot be mapped, so it
+  // can be freed without looking in the registry.
+  if (nbytes == 0  ||  nbytes < state.minThreshold) {
+    free (ptr);
+    return;
+  }
+  size_t len = 0;
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    std::map<void*,size_t>::iterator iter = state.blocks.find (ptr);
+    if (iter != state.blocks.end()) {
+      len = iter->second;
+      state.mappedBytes -= len;
+      state.blocks.erase (iter);
+    }
+  }
+  if (len > 0) {
+    munmap (ptr, len);
+    return;
+  }
+#endif
+  free (ptr);
+}
+
+const std::vector<Int>& HugePageAllocatorBase::numaNodes()
+{
+  static std::vector<Int> nodes = []() {
+    std::ifstream ifs("/sys/devices/system/node/online");
+    std::string list;
+    if (ifs) {
+      std::getline (ifs, list);
+    }
+    return parseNodeList (list);
+  }();
+  return nodes;
+}
+
+size_t HugePageAllocatorBase::mappedBytes()
+{
+  HugePageState& state = hugePageState();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.mappedBytes;
+}
+
+} //# NAMESPACE CASACORE - END
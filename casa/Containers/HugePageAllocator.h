@@ -0,0 +1,248 @@
+//# HugePageAllocator.h: Allocator for large arrays using huge pages and NUMA
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_CONTAINERS_HUGEPAGEALLOCATOR_H
+#define CASA_CONTAINERS_HUGEPAGEALLOCATOR_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Allocation of large memory blocks using huge pages and NUMA placement.
+// </summary>
+//
+// <use visibility=export>
+//
+// <reviewed reviewer="" date="" tests="tHugePageAllocator.cc" demos="">
+// </reviewed>
+//
+// <synopsis>
+// HugePageAllocatorBase does the work for the
+// <linkto class=HugePageAllocator>HugePageAllocator</linkto>.
+// <br>Blocks smaller than the threshold (default 32 MB) are allocated
+// like the AlignedAllocator does (aligned to CASA_DEFAULT_ALIGNMENT).
+// Larger blocks are directly mapped from the system using an anonymous
+// mmap, aligned to 2 MB. Depending on the option, the mapping is
+// <ul>
+//  <li> <src>NoHugePages</src>: a normal mapping.
+//  <li> <src>TransparentHugePages</src>: advised (using madvise) to use
+//       transparent huge pages. This is the default.
+//  <li> <src>ExplicitHugePages</src>: mapped from the reserved huge pages
+//       (see /proc/sys/vm/nr_hugepages). If not enough huge pages are
+//       available, transparent huge pages are used.
+// </ul>
+// Huge pages reduce the number of TLB misses when accessing large arrays
+// (e.g. in FFTs and lattice iteration) randomly or with large strides.
+// <p>
+// Furthermore, on a NUMA system the pages of a large block can be placed
+// using a NUMA policy:
+// <ul>
+//  <li> <src>NumaDefault</src>: the system default, i.e., a page is placed
+//       on the node of the thread touching it first (first-touch).
+//  <li> <src>NumaInterleave</src>: the pages are interleaved over all nodes,
+//       which balances the memory bandwidth of all nodes for data used by
+//       all threads.
+//  <li> <src>NumaBind</src>: the pages are placed on the given node.
+// </ul>
+// The policy is set using the mbind system call, so libnuma is not
+// needed. It is silently ignored if not supported by the system.
+// <br>When using the default policy, the function
+// <src>firstTouchFill</src> can be used to initialize the data with
+// multiple OpenMP threads, so each thread's part of the data is placed on
+// its node. Subsequent OpenMP loops with static scheduling over the data
+// will then mainly access local memory.
+// <p>
+// The huge page and NUMA functionality is only available on Linux. On
+// other systems large blocks are also allocated with aligned malloc.
+// <br>The options are global and can be changed at any time using
+// <src>setOptions</src>. They are read without locking. The mapped blocks
+// are registered, so they are correctly freed after the options have
+// changed. A block smaller than the lowest threshold ever set cannot have
+// been mapped, so it is freed without a lookup in the registry. Therefore
+// <src>deallocate</src> must be given the size used in
+// <src>allocate</src> (as required for an allocator).
+// </synopsis>
+
+class HugePageAllocatorBase
+{
+public:
+  enum HugePages {
+    NoHugePages,
+    TransparentHugePages,
+    ExplicitHugePages
+  };
+
+  enum NumaPolicy {
+    NumaDefault,
+    NumaInterleave,
+    NumaBind
+  };
+
+  struct Options {
+    Options()
+      : threshold (32*1024*1024),
+        hugePages (TransparentHugePages),
+        numaPolicy(NumaDefault),
+        numaNode  (0)
+    {}
+    // Blocks of at least this number of bytes are mapped.
+    size_t     threshold;
+    HugePages  hugePages;
+    NumaPolicy numaPolicy;
+    // The node used for NumaBind.
+    Int        numaNode;
+  };
+
+  // Get or set the options.
+  // <group>
+  static Options options();
+  static void setOptions (const Options&);
+  // </group>
+
+  // Allocate a block of the given number of bytes.
+  // It throws std::bad_alloc if the memory cannot be allocated.
+  static void* allocate (size_t nbytes);
+
+  // Free a block of the given number of bytes.
+  static void deallocate (void* ptr, size_t nbytes);
+
+  // The size of a huge page (2 MB).
+  static size_t hugePageSize()
+    { return 2*1024*1024; }
+
+  // Get the NUMA nodes available (an empty vector on a non-NUMA system).
+  static const std::vector<Int>& numaNodes();
+
+  // Get the number of bytes in mapped blocks.
+  static size_t mappedBytes();
+
+  // Fill the data with the value using multiple OpenMP threads, where
+  // each thread fills a contiguous part (like a loop using static
+  // scheduling). It makes the pages of each part local to the thread's
+  // NUMA node (first-touch). The data must be uninitialized memory
+  // (e.g. from <src>Array(shape, Array<T>::uninitialized)</src>) or
+  // contain trivial values.
+  template<typename T>
+  static void firstTouchFill (T* data, size_t n, const T& value = T())
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (long long i=0; i<(long long)(n); ++i) {
+      new (data+i) T(value);
+    }
+  }
+};
+
+
+// <summary>
+// Allocator for large arrays using huge pages and NUMA placement.
+// </summary>
+//
+// <use visibility=export>
+//
+// <reviewed reviewer="" date="" tests="tHugePageAllocator.cc" demos="">
+// </reviewed>
+//
+// <synopsis>
+// HugePageAllocator is a standard-conforming allocator which can be used
+// as the Alloc template parameter of Array (and of STL containers).
+// It is stateless; the global options are set with
+// <src>HugePageAllocatorBase::setOptions</src>.
+// See <linkto class=HugePageAllocatorBase>HugePageAllocatorBase</linkto>
+// for the details.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   HugePageAllocatorBase::Options opt;
+//   opt.numaPolicy = HugePageAllocatorBase::NumaInterleave;
+//   HugePageAllocatorBase::setOptions (opt);
+//   typedef Array<Float, HugePageAllocator<Float>> BigArray;
+//   BigArray cube(IPosition(3,4096,4096,16), BigArray::uninitialized);
+//   HugePageAllocatorBase::firstTouchFill (cube.data(), cube.nelements(),
+//                                          Float(0));
+// </srcblock>
+// </example>
+
+template<typename T>
+class HugePageAllocator
+{
+public:
+  typedef T              value_type;
+  typedef T*             pointer;
+  typedef const T*       const_pointer;
+  typedef T&             reference;
+  typedef const T&       const_reference;
+  typedef size_t         size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template<typename TOther>
+  struct rebind {
+    typedef HugePageAllocator<TOther> other;
+  };
+
+  HugePageAllocator() noexcept
+  {}
+  template<typename TOther>
+  HugePageAllocator (const HugePageAllocator<TOther>&) noexcept
+  {}
+
+  pointer allocate (size_type elements, const void* = 0)
+  {
+    if (elements > max_size()) {
+      throw std::bad_alloc();
+    }
+    return static_cast<pointer>
+      (HugePageAllocatorBase::allocate (elements * sizeof(T)));
+  }
+
+  void deallocate (pointer ptr, size_type elements)
+    { HugePageAllocatorBase::deallocate (ptr, elements * sizeof(T)); }
+
+  size_type max_size() const noexcept
+    { return std::numeric_limits<size_type>::max() / sizeof(T); }
+};
+
+template<typename T, typename U>
+inline bool operator== (const HugePageAllocator<T>&,
+                        const HugePageAllocator<U>&)
+  { return true; }
+template<typename T, typename U>
+inline bool operator!= (const HugePageAllocator<T>&,
+                        const HugePageAllocator<U>&)
+  { return false; }
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
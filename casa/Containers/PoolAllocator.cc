@@ -0,0 +1,443 @@
+//# PoolAllocator.cc: Thread-caching size-class pool allocator
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/Containers/PoolAllocator.h>
+#include <casacore/casa/Containers/Allocator.h>
+#include <casacore/casa/OS/MemoryTrace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+namespace {
+
+  // Size classes of 32..512 bytes in steps of 32, followed by 4 classes
+  // per power of 2 up to 4 MB.
+  const size_t nsmallClass = 16;
+  const size_t maxPooled   = 4*1024*1024;
+  const size_t nclass      = nsmallClass + 4*(22-9);
+  // Index of the counters of the unpooled (large) blocks.
+  const size_t largeClass  = nclass;
+  // The maximum number of bytes per size class in a thread's free list.
+  const size_t maxThreadCacheBytes = 2*1024*1024;
+
+  size_t sizeClass (size_t nbytes)
+  {
+    if (nbytes <= 512) {
+      return nbytes == 0  ?  0 : (nbytes-1) / 32;
+    }
+    size_t m = nbytes - 1;
+    size_t p = 9;
+    while ((m >> (p+1)) != 0) {
+      ++p;
+    }
+    return nsmallClass + (p-9)*4 + ((m >> (p-2)) & 3);
+  }
+
+  size_t classSize (size_t cls)
+  {
+    if (cls < nsmallClass) {
+      return (cls+1) * 32;
+    }
+    size_t c = cls - nsmallClass;
+    return (5 + c%4) << (7 + c/4);
+  }
+
+  // The maximum number of blocks in a thread's free list.
+  size_t threadCacheLimit (size_t cls)
+    { return std::max (size_t(2), maxThreadCacheBytes / classSize(cls)); }
+
+  void* alignedAlloc (size_t nbytes)
+  {
+    void* ptr = 0;
+    if (posix_memalign (&ptr, CASA_DEFAULT_ALIGNMENT, nbytes) != 0) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  }
+
+  // A free block contains the pointer to the next free block.
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  // A counter only updated by its owning thread, but read by others.
+  // It avoids the cost of an atomic read-modify-write.
+  typedef std::atomic<Int64> Counter;
+  inline void addCount (Counter& counter, Int64 n)
+    { counter.store (counter.load(std::memory_order_relaxed) + n,
+                     std::memory_order_relaxed); }
+
+  struct ThreadCache;
+
+  // The central free lists and statistics.
+  struct CentralPool
+  {
+    CentralPool()
+      : liveBytes (0),
+        peakBytes (0),
+        defaultPooling (true)
+    {
+      for (size_t i=0; i<nclass; ++i) {
+        head[i]  = 0;
+        count[i] = 0;
+      }
+      for (size_t i=0; i<=nclass; ++i) {
+        nalloc[i] = 0;
+        nlive[i]  = 0;
+      }
+    }
+
+    void addLive (Int64 nbytes)
+    {
+      Int64 live = liveBytes.fetch_add (nbytes, std::memory_order_relaxed)
+                   + nbytes;
+      Int64 peak = peakBytes.load (std::memory_order_relaxed);
+      while (live > peak  &&
+             !peakBytes.compare_exchange_weak (peak, live,
+                                               std::memory_order_relaxed)) {
+      }
+    }
+
+    std::mutex mutex;
+    FreeBlock* head[nclass];
+    //# The count is atomic, so it can be tested without locking.
+    std::atomic<size_t> count[nclass];
+    //# Counts of exited threads and of blocks (de)allocated without cache.
+    Int64      nalloc[nclass+1];
+    Int64      nlive[nclass+1];
+    std::vector<ThreadCache*> threads;
+    std::atomic<Int64> liveBytes;
+    std::atomic<Int64> peakBytes;
+    std::atomic<bool>  defaultPooling;
+  };
+
+  // The central pool is never destructed, because blocks can be freed
+  // by destructors of static objects.
+  CentralPool& centralPool()
+  {
+    static std::aligned_storage<sizeof(CentralPool),
+                                alignof(CentralPool)>::type storage;
+    static CentralPool* pool = new (&storage) CentralPool();
+    return *pool;
+  }
+
+  // The free lists and statistics of a thread.
+  struct ThreadCache
+  {
+    ThreadCache();
+    ~ThreadCache();
+
+    // Move the first n blocks of a free list to the central pool.
+    // The central mutex must be locked.
+    void moveToCentral (size_t cls, size_t n);
+
+    FreeBlock* head[nclass];
+    Counter    count[nclass];
+    Counter    nalloc[nclass+1];
+    Counter    nlive[nclass+1];
+  };
+
+  //# Tells if the thread cache has been destructed at thread exit.
+  thread_local bool theirCacheDestructed = false;
+  //# The pooling mode of a thread (-1 is default).
+  thread_local int theirPooling = -1;
+
+  ThreadCache::ThreadCache()
+  {
+    for (size_t i=0; i<nclass; ++i) {
+      head[i] = 0;
+      count[i].store (0);
+    }
+    for (size_t i=0; i<=nclass; ++i) {
+      nalloc[i].store (0);
+      nlive[i].store (0);
+    }
+    CentralPool& central = centralPool();
+    std::lock_guard<std::mutex> lock(central.mutex);
+    central.threads.push_back (this);
+  }
+
+  ThreadCache::~ThreadCache()
+  {
+    CentralPool& central = centralPool();
+    std::lock_guard<std::mutex> lock(central.mutex);
+    for (size_t i=0; i<nclass; ++i) {
+      moveToCentral (i, count[i].load());
+    }
+    for (size_t i=0; i<=nclass; ++i) {
+      central.nalloc[i] += nalloc[i].load();
+      central.nlive[i]  += nlive[i].load();
+    }
+    central.threads.erase (std::find (central.threads.begin(),
+                                      central.threads.end(), this));
+    theirCacheDestructed = true;
+  }
+
+  void ThreadCache::moveToCentral (size_t cls, size_t n)
+  {
+    CentralPool& central = centralPool();
+    for (size_t i=0; i<n; ++i) {
+      FreeBlock* block = head[cls];
+      head[cls] = block->next;
+      block->next = central.head[cls];
+      central.head[cls] = block;
+    }
+    addCount (count[cls], -Int64(n));
+    central.count[cls] += n;
+  }
+
+  ThreadCache* threadCache()
+  {
+    if (theirCacheDestructed) {
+      return 0;
+    }
+    thread_local ThreadCache cache;
+    return &cache;
+  }
+
+  // Count an allocation (n=1) or deallocation (n=-1) of a size class.
+  void countBlock (ThreadCache* cache, size_t cls, Int64 n)
+  {
+    if (cache) {
+      if (n > 0) {
+        addCount (cache->nalloc[cls], 1);
+      }
+      addCount (cache->nlive[cls], n);
+    } else {
+      CentralPool& central = centralPool();
+      std::lock_guard<std::mutex> lock(central.mutex);
+      if (n > 0) {
+        central.nalloc[cls]++;
+      }
+      central.nlive[cls] += n;
+    }
+  }
+
+  bool usePooling()
+  {
+    return theirPooling < 0  ?  centralPool().defaultPooling.load() :
+                                theirPooling > 0;
+  }
+
+  void freeList (FreeBlock* block)
+  {
+    while (block) {
+      FreeBlock* next = block->next;
+      free (block);
+      block = next;
+    }
+  }
+
+} //# end anonymous namespace
+
+
+void* PoolAllocatorBase::allocate (size_t nbytes)
+{
+  CentralPool& central = centralPool();
+  if (nbytes > maxPooled) {
+    void* ptr = alignedAlloc (nbytes);
+    central.addLive (nbytes);
+    countBlock (threadCache(), largeClass, 1);
+    traceMemoryAlloc (ptr, nbytes, " PoolAllocator");
+    return ptr;
+  }
+  size_t cls  = sizeClass (nbytes);
+  size_t size = classSize (cls);
+  ThreadCache* cache = threadCache();
+  void* ptr = 0;
+  if (cache) {
+    if (! cache->head[cls]  &&  central.count[cls] > 0) {
+      // Get a batch of blocks from the central pool.
+      std::lock_guard<std::mutex> lock(central.mutex);
+      size_t n = std::min (central.count[cls].load(),
+                           std::max (size_t(1), threadCacheLimit(cls) / 2));
+      for (size_t i=0; i<n; ++i) {
+        FreeBlock* block = central.head[cls];
+        central.head[cls] = block->next;
+        block->next = cache->head[cls];
+        cache->head[cls] = block;
+      }
+      central.count[cls] -= n;
+      addCount (cache->count[cls], n);
+    }
+    if (cache->head[cls]) {
+      FreeBlock* block = cache->head[cls];
+      cache->head[cls] = block->next;
+      addCount (cache->count[cls], -1);
+      ptr = block;
+    }
+  }
+  countBlock (cache, cls, 1);
+  if (! ptr) {
+    ptr = alignedAlloc (size);
+  }
+  central.addLive (size);
+  traceMemoryAlloc (ptr, nbytes, " PoolAllocator");
+  return ptr;
+}
+
+void PoolAllocatorBase::deallocate (void* ptr, size_t nbytes)
+{
+  if (! ptr) {
+    return;
+  }
+  traceMemoryFree (ptr, " PoolAllocator");
+  CentralPool& central = centralPool();
+  ThreadCache* cache = threadCache();
+  if (nbytes > maxPooled) {
+    free (ptr);
+    central.addLive (-Int64(nbytes));
+    countBlock (cache, largeClass, -1);
+    return;
+  }
+  size_t cls = sizeClass (nbytes);
+  central.addLive (-Int64(classSize(cls)));
+  countBlock (cache, cls, -1);
+  if (!cache  ||  !usePooling()) {
+    free (ptr);
+    return;
+  }
+  FreeBlock* block = static_cast<FreeBlock*>(ptr);
+  block->next = cache->head[cls];
+  cache->head[cls] = block;
+  addCount (cache->count[cls], 1);
+  size_t limit = threadCacheLimit (cls);
+  if (size_t(cache->count[cls].load(std::memory_order_relaxed)) > limit) {
+    std::lock_guard<std::mutex> lock(central.mutex);
+    cache->moveToCentral (cls, limit/2 + 1);
+  }
+}
+
+size_t PoolAllocatorBase::blockSize (size_t nbytes)
+{
+  return nbytes > maxPooled  ?  nbytes : classSize(sizeClass(nbytes));
+}
+
+size_t PoolAllocatorBase::maxPooledSize()
+{
+  return maxPooled;
+}
+
+Bool PoolAllocatorBase::defaultPooling()
+{
+  return centralPool().defaultPooling.load();
+}
+
+void PoolAllocatorBase::setDefaultPooling (Bool pooling)
+{
+  centralPool().defaultPooling.store (pooling);
+}
+
+Bool PoolAllocatorBase::pooling()
+{
+  return usePooling();
+}
+
+int PoolAllocatorBase::threadPooling()
+{
+  return theirPooling;
+}
+
+void PoolAllocatorBase::setThreadPooling (int mode)
+{
+  theirPooling = mode;
+}
+
+void PoolAllocatorBase::release()
+{
+  ThreadCache* cache = threadCache();
+  if (cache) {
+    for (size_t i=0; i<nclass; ++i) {
+      freeList (cache->head[i]);
+      cache->head[i] = 0;
+      cache->count[i].store (0);
+    }
+  }
+  CentralPool& central = centralPool();
+  std::lock_guard<std::mutex> lock(central.mutex);
+  for (size_t i=0; i<nclass; ++i) {
+    freeList (central.head[i]);
+    central.head[i]  = 0;
+    central.count[i] = 0;
+  }
+}
+
+PoolAllocatorStatistics PoolAllocatorBase::statistics()
+{
+  CentralPool& central = centralPool();
+  PoolAllocatorStatistics stats;
+  stats.liveBytes   = central.liveBytes.load();
+  stats.peakBytes   = central.peakBytes.load();
+  stats.cachedBytes = 0;
+  std::lock_guard<std::mutex> lock(central.mutex);
+  for (size_t i=0; i<=nclass; ++i) {
+    PoolAllocatorStatistics::SizeClass sc;
+    sc.blockSize = (i == largeClass  ?  0 : classSize(i));
+    sc.nalloc    = central.nalloc[i];
+    sc.nlive     = central.nlive[i];
+    sc.ncached   = (i == largeClass  ?  0 : Int64(central.count[i].load()));
+    for (const ThreadCache* cache : central.threads) {
+      sc.nalloc += cache->nalloc[i].load (std::memory_order_relaxed);
+      sc.nlive  += cache->nlive[i].load (std::memory_order_relaxed);
+      if (i != largeClass) {
+        sc.ncached += cache->count[i].load (std::memory_order_relaxed);
+      }
+    }
+    stats.cachedBytes += sc.ncached * sc.blockSize;
+    if (sc.nalloc > 0  ||  sc.nlive != 0  ||  sc.ncached > 0) {
+      stats.sizeClasses.push_back (sc);
+    }
+  }
+  return stats;
+}
+
+
+std::ostream& operator<< (std::ostream& os,
+                          const PoolAllocatorStatistics& stats)
+{
+  os << "PoolAllocator: live=" << stats.liveBytes
+     << " peak=" << stats.peakBytes
+     << " cached=" << stats.cachedBytes << " bytes" << std::endl;
+  for (const PoolAllocatorStatistics::SizeClass& sc : stats.sizeClasses) {
+    os << "  ";
+    if (sc.blockSize == 0) {
+      os << "   large";
+    } else {
+      os << std::setw(8) << sc.blockSize;
+    }
+    os << "  nalloc=" << sc.nalloc << " nlive=" << sc.nlive
+       << " ncached=" << sc.ncached << std::endl;
+  }
+  return os;
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,288 @@
+//# PoolAllocator.h: Thread-caching size-class pool allocator
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_CONTAINERS_POOLALLOCATOR_H
+#define CASA_CONTAINERS_POOLALLOCATOR_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+
+#include <cstddef>
+#include <iosfwd>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Statistics of the pool allocator.
+// </summary>
+// <synopsis>
+// The statistics are collected by all threads using a PoolAllocator.
+// They can be obtained using <src>PoolAllocatorBase::statistics()</src>
+// or <src>MemoryTrace::poolStatistics()</src>.
+// </synopsis>
+struct PoolAllocatorStatistics
+{
+  struct SizeClass {
+    // The size of the blocks in this size class (0 means the blocks
+    // too large to be pooled).
+    size_t blockSize;
+    // The number of allocations done.
+    Int64  nalloc;
+    // The number of blocks in use.
+    Int64  nlive;
+    // The number of free blocks kept in the pool (in the central pool and
+    // in the caches of the threads).
+    Int64  ncached;
+  };
+  // The number of bytes in use (in blocks handed out).
+  Int64  liveBytes;
+  // The maximum number of bytes in use at the same time.
+  Int64  peakBytes;
+  // The number of bytes kept in the pool for reuse.
+  Int64  cachedBytes;
+  // The counts for all size classes which have been used.
+  std::vector<SizeClass> sizeClasses;
+};
+
+std::ostream& operator<< (std::ostream&, const PoolAllocatorStatistics&);
+
+
+// <summary>
+// Thread-caching size-class pool allocator.
+// </summary>
+//
+// <use visibility=export>
+//
+// <reviewed reviewer="" date="" tests="tPoolAllocator.cc" demos="">
+// </reviewed>
+//
+// <synopsis>
+// PoolAllocatorBase does the work for the
+// <linkto class=PoolAllocator>PoolAllocator</linkto>.
+// <br>Requests up to <src>maxPooledSize()</src> bytes are rounded up
+// to a size class. Up to 512 bytes the size classes are multiples of 32
+// bytes; above that each power of 2 is divided into 4 size classes
+// (thus at most 25% is wasted). Larger requests are directly
+// allocated and freed.
+// <br>A freed block is put in a free list of the calling thread, so the
+// next allocation of the same size class in that thread reuses it without
+// any locking. If a thread's free list grows too large, half of it is moved
+// to a central free list (guarded by a mutex) where other threads can get
+// the blocks from. When a thread ends its free lists are moved to the
+// central ones. The memory in the free lists is only given back
+// to the system by <src>release()</src>.
+// <br>All blocks are aligned to CASA_DEFAULT_ALIGNMENT bytes.
+// <p>
+// Pooling can be switched off, in which case the blocks are directly
+// freed (but still rounded up to their size class, so pooling can be
+// switched on and off at any time). The default is on; it can be changed
+// for all threads using <src>setDefaultPooling</src> or for a scope in
+// the current thread using a
+// <linkto class=PoolAllocatorScope>PoolAllocatorScope</linkto> object.
+// <p>
+// The statistics (live bytes, peak, and per-size-class counts) are
+// collected with little overhead; only the live bytes and peak are
+// updated atomically. Each allocation and deallocation is traced in the
+// file of <linkto class=MemoryTrace>MemoryTrace</linkto> if opened.
+// </synopsis>
+
+class PoolAllocatorBase
+{
+public:
+  // Allocate a block of at least the given number of bytes.
+  // It throws std::bad_alloc if the memory cannot be allocated.
+  static void* allocate (size_t nbytes);
+
+  // Free a block allocated with the given number of bytes.
+  static void deallocate (void* ptr, size_t nbytes);
+
+  // Get the size that is actually allocated for a request.
+  static size_t blockSize (size_t nbytes);
+
+  // Get the largest pooled size.
+  static size_t maxPooledSize();
+
+  // Get or set the default for pooling. It can be overridden per thread
+  // by a PoolAllocatorScope.
+  // <group>
+  static Bool defaultPooling();
+  static void setDefaultPooling (Bool pooling);
+  // </group>
+
+  // Is pooling done in the current thread?
+  static Bool pooling();
+
+  // Free the blocks in the central free lists and in the free lists of the
+  // current thread.
+  static void release();
+
+  // Get the current statistics.
+  static PoolAllocatorStatistics statistics();
+
+private:
+  friend class PoolAllocatorScope;
+  // Get or set the pooling mode of the current thread
+  // (-1 is default, 0 is off, 1 is on).
+  // <group>
+  static int threadPooling();
+  static void setThreadPooling (int mode);
+  // </group>
+};
+
+
+// <summary>
+// Allocator using the thread-caching pool.
+// </summary>
+//
+// <use visibility=export>
+//
+// <reviewed reviewer="" date="" tests="tPoolAllocator.cc" demos="">
+// </reviewed>
+//
+// <synopsis>
+// PoolAllocator is a standard-conforming allocator which can be used
+// as the Alloc template parameter of Array (and of STL containers).
+// It is stateless, so all instances are equal and arrays using it
+// can share storage.
+// It is meant for programs allocating and freeing many arrays of the
+// same shape (e.g. the visibilities of each row), where malloc and free
+// would take a significant part of the time.
+// See <linkto class=PoolAllocatorBase>PoolAllocatorBase</linkto>
+// for the details.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   typedef Array<Complex, PoolAllocator<Complex>> PoolArray;
+//   for (rownr_t row=0; row<nrow; ++row) {
+//     PoolArray data(IPosition(2,4,nchan));    // no malloc after first row
+//     ...
+//   }
+//   cout << PoolAllocatorBase::statistics();
+// </srcblock>
+// </example>
+
+template<typename T>
+class PoolAllocator
+{
+public:
+  typedef T              value_type;
+  typedef T*             pointer;
+  typedef const T*       const_pointer;
+  typedef T&             reference;
+  typedef const T&       const_reference;
+  typedef size_t         size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template<typename TOther>
+  struct rebind {
+    typedef PoolAllocator<TOther> other;
+  };
+
+  PoolAllocator() noexcept
+  {}
+  template<typename TOther>
+  PoolAllocator (const PoolAllocator<TOther>&) noexcept
+  {}
+
+  pointer allocate (size_type elements, const void* = 0)
+  {
+    if (elements > max_size()) {
+      throw std::bad_alloc();
+    }
+    return static_cast<pointer>
+      (PoolAllocatorBase::allocate (elements * sizeof(T)));
+  }
+
+  void deallocate (pointer ptr, size_type elements)
+    { PoolAllocatorBase::deallocate (ptr, elements * sizeof(T)); }
+
+  size_type max_size() const noexcept
+    { return std::numeric_limits<size_type>::max() / sizeof(T); }
+};
+
+template<typename T, typename U>
+inline bool operator== (const PoolAllocator<T>&, const PoolAllocator<U>&)
+  { return true; }
+template<typename T, typename U>
+inline bool operator!= (const PoolAllocator<T>&, const PoolAllocator<U>&)
+  { return false; }
+
+
+// <summary>
+// Switch pooling on or off for a scope.
+// </summary>
+//
+// <use visibility=export>
+//
+// <synopsis>
+// The constructor sets the pooling mode of the PoolAllocator for the
+// current thread, while the destructor restores the previous mode.
+// Optionally the destructor releases the free blocks kept by the thread
+// and the central pool.
+// </synopsis>
+//
+// <example>
+// <srcblock>
+//   {
+//     // Do not keep blocks in this memory-hungry step.
+//     PoolAllocatorScope scope(False);
+//     ...
+//   }
+// </srcblock>
+// </example>
+
+class PoolAllocatorScope
+{
+public:
+  explicit PoolAllocatorScope (Bool pooling = True,
+                               Bool releaseAtEnd = False)
+    : itsOldMode     (PoolAllocatorBase::threadPooling()),
+      itsReleaseAtEnd(releaseAtEnd)
+    { PoolAllocatorBase::setThreadPooling (pooling ? 1 : 0); }
+
+  ~PoolAllocatorScope()
+  {
+    PoolAllocatorBase::setThreadPooling (itsOldMode);
+    if (itsReleaseAtEnd) {
+      PoolAllocatorBase::release();
+    }
+  }
+
+private:
+  PoolAllocatorScope (const PoolAllocatorScope&);
+  PoolAllocatorScope& operator= (const PoolAllocatorScope&);
+
+  int  itsOldMode;
+  Bool itsReleaseAtEnd;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -80,7 +80,9 @@ RecordDescRep::~RecordDescRep()
 
 void RecordDescRep::addFieldName (const String& fieldName, DataType type)
 {
-    if (fieldNumber(fieldName) >= 0) {
+    // Inserting in the name map tells if the field already exists,
+    // so the name is hashed only once.
+    if (! name_map_p.insert (std::make_pair(fieldName, Int(n_p))).second) {
 	throw (AipsError ("RecordDesc::addField() - field " +
 			  fieldName + " already has been defined"));
     }
@@ -88,7 +90,6 @@ void RecordDescRep::addFieldName (const String& fieldName, DataType type)
     uInt n = n_p - 1;
     types_p[n] = type;
     names_p[n] = fieldName;
-    name_map_p.insert (std::make_pair(fieldName, n));
     sub_records_p[n] = 0;
     is_array_p[n] = False;
     shapes_p[n].resize(1);
@@ -357,7 +358,8 @@ void RecordDescRep::setShape (const IPosition& shape, Int whichField)
 
 Int RecordDescRep::fieldNumber (const String& fieldName) const
 {
-    std::map<String,Int>::const_iterator iter = name_map_p.find (fieldName);
+    std::unordered_map<String,Int>::const_iterator iter =
+      name_map_p.find (fieldName);
     return (iter == name_map_p.end()  ?  -1 : iter->second);
 }
 
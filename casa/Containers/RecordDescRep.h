@@ -32,8 +32,9 @@
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/iosfwd.h>
-#include <map>
+#include <unordered_map>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -287,8 +288,10 @@ private:
     Block<String> tableDescNames_p;
     // Comments for each field.
     Block<String> comments_p;
-    // Mapping of field name to field number.
-    std::map<String,Int> name_map_p;
+    // Mapping of field name to field number. It is hashed, so finding
+    // a field by name takes constant time (on average) for records
+    // with many fields.
+    std::unordered_map<String,Int> name_map_p;
 };
 
 inline uInt RecordDescRep::nfields() const
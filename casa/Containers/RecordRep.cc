@@ -35,7 +35,9 @@
 #include <casacore/casa/Utilities/ValType.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
+#include <algorithm>
 #include <cstring>                  //# for memmove with gcc-4.3
+#include <new>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -43,19 +45,28 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 
 RecordRep::RecordRep ()
-: nused_p (0)
+: nused_p      (0),
+  freeSlots_p  (0),
+  nslots_p     (0),
+  nfreeSlots_p (0)
 {}
 	
 RecordRep::RecordRep (const RecordDesc& description)
-: desc_p  (description),
-  nused_p (0)
+: desc_p       (description),
+  nused_p      (0),
+  freeSlots_p  (0),
+  nslots_p     (0),
+  nfreeSlots_p (0)
 {
     restructure (desc_p, True);
 }
 
 RecordRep::RecordRep (const RecordRep& other)
-: desc_p  (other.desc_p),
-  nused_p (0)
+: desc_p       (other.desc_p),
+  nused_p      (0),
+  freeSlots_p  (0),
+  nslots_p     (0),
+  nfreeSlots_p (0)
 {
     restructure (desc_p, False);
     copy_other (other);
@@ -73,6 +84,102 @@ RecordRep& RecordRep::operator= (const RecordRep& other)
 RecordRep::~RecordRep()
 {
     delete_myself (desc_p.nfields());
+    releaseScalarSlots();
+}
+
+Bool RecordRep::isSlotScalar (DataType type)
+{
+    switch (type) {
+    case TpBool:
+    case TpUChar:
+    case TpShort:
+    case TpInt:
+    case TpUInt:
+    case TpInt64:
+    case TpFloat:
+    case TpDouble:
+    case TpComplex:
+    case TpDComplex:
+	return True;
+    default:
+	return False;
+    }
+}
+
+RecordRep::ScalarSlot* RecordRep::linkSlots (ScalarSlot* chunk, uInt nslots,
+					     ScalarSlot* next)
+{
+    // Link the slots in order, so consecutive fields get adjacent slots.
+    for (uInt i=0; i<nslots-1; i++) {
+	chunk[i].next = chunk + i + 1;
+    }
+    chunk[nslots-1].next = next;
+    return chunk;
+}
+
+void RecordRep::addScalarChunk (uInt nslots)
+{
+    ScalarSlot* chunk = new ScalarSlot[nslots];
+    slotChunks_p.push_back (chunk);
+    freeSlots_p   = linkSlots (chunk, nslots, freeSlots_p);
+    nslots_p     += nslots;
+    nfreeSlots_p += nslots;
+}
+
+void RecordRep::releaseScalarSlots()
+{
+    for (ScalarSlot* chunk : slotChunks_p) {
+	delete [] chunk;
+    }
+    slotChunks_p.clear();
+    freeSlots_p  = 0;
+    nslots_p     = 0;
+    nfreeSlots_p = 0;
+}
+
+void RecordRep::reserveScalarSlots (const RecordDesc& desc)
+{
+    uInt nrscalar = 0;
+    for (uInt i=0; i<desc.nfields(); i++) {
+	if (isSlotScalar (DataType(desc.type(i)))) {
+	    nrscalar++;
+	}
+    }
+    if (nfreeSlots_p == nslots_p) {
+	// No slot is in use, so all scalars can be put in a single chunk.
+	if (slotChunks_p.size() > 1  ||  nrscalar > nslots_p) {
+	    releaseScalarSlots();
+	    if (nrscalar > 0) {
+		addScalarChunk (nrscalar);
+	    }
+	} else if (nslots_p > 0) {
+	    // Relink the free slots of the single chunk in order.
+	    freeSlots_p = linkSlots (slotChunks_p[0], nslots_p, 0);
+	}
+    } else if (nrscalar > nfreeSlots_p) {
+	addScalarChunk (nrscalar - nfreeSlots_p);
+    }
+}
+
+void* RecordRep::allocScalarSlot()
+{
+    if (freeSlots_p == 0) {
+	addScalarChunk (std::max (8u, nslots_p));
+    }
+    ScalarSlot* slot = freeSlots_p;
+    freeSlots_p = slot->next;
+    nfreeSlots_p--;
+    return slot;
+}
+
+void RecordRep::freeScalarSlot (void* ptr)
+{
+    if (ptr) {
+	ScalarSlot* slot = static_cast<ScalarSlot*>(ptr);
+	slot->next  = freeSlots_p;
+	freeSlots_p = slot;
+	nfreeSlots_p++;
+    }
 }
 
 void RecordRep::restructure (const RecordDesc& newDescription, Bool recursive)
@@ -80,6 +187,7 @@ void RecordRep::restructure (const RecordDesc& newDescription, Bool recursive)
     delete_myself (desc_p.nfields());
     desc_p  = newDescription;
     nused_p = desc_p.nfields();
+    reserveScalarSlots (desc_p);
     datavec_p.resize (nused_p);
     datavec_p = static_cast<void*>(0);
     data_p.resize (nused_p);
@@ -104,8 +212,11 @@ Int RecordRep::fieldNumber (const String& name) const
 void RecordRep::addDataPtr (void* ptr)
 {
     if (nused_p >= data_p.nelements()) {
-	datavec_p.resize (nused_p + 16);
-	data_p.resize (nused_p + 16);
+        // Grow geometrically to avoid quadratic behaviour when adding
+        // many fields one by one.
+        uInt newSize = std::max (16u, 2*nused_p);
+	datavec_p.resize (newSize);
+	data_p.resize (newSize);
     }
     datavec_p[nused_p] = 0;
     data_p[nused_p++] = ptr;
@@ -284,57 +395,25 @@ void* RecordRep::createDataField (DataType type, const IPosition& shape)
     }
     switch (type) {
     case TpBool:
-	{
-	    Bool* ptr = new Bool;
-	    *ptr = False;
-	    return ptr;
-	}
+	return new (allocScalarSlot()) Bool(False);
     case TpUChar:
-	{
-	    uChar* ptr = new uChar;
-	    *ptr = 0;
-	    return ptr;
-	}
+	return new (allocScalarSlot()) uChar(0);
     case TpShort:
-	{
-	    Short* ptr = new Short;
-	    *ptr = 0;
-	    return ptr;
-	}
+	return new (allocScalarSlot()) Short(0);
     case TpInt:
-	{
-	    Int* ptr = new Int;
-	    *ptr = 0;
-	    return ptr;
-	}
+	return new (allocScalarSlot()) Int(0);
     case TpUInt:
-	{
-	    uInt* ptr = new uInt;
-	    *ptr = 0;
-	    return ptr;
-	}
+	return new (allocScalarSlot()) uInt(0);
     case TpInt64:
-	{
-	    Int64* ptr = new Int64;
-	    *ptr = 0;
-	    return ptr;
-	}
+	return new (allocScalarSlot()) Int64(0);
     case TpFloat:
-	{
-	    float* ptr = new float;
-	    *ptr = 0.0;
-	    return ptr;
-	}
+	return new (allocScalarSlot()) float(0.0);
     case TpDouble:
-	{
-	    double* ptr = new double;
-	    *ptr = 0.0;
-	    return ptr;
-	}
+	return new (allocScalarSlot()) double(0.0);
     case TpComplex:
-	return new Complex;
+	return new (allocScalarSlot()) Complex;
     case TpDComplex:
-	return new DComplex;
+	return new (allocScalarSlot()) DComplex;
     case TpString:
 	return new String;
     case TpArrayBool:
@@ -466,43 +545,43 @@ void RecordRep::deleteDataField (DataType type, void* ptr, void* vecptr)
 {
     switch (type) {
     case TpBool:
-	delete static_cast<Bool*>(ptr);
+	freeScalarSlot (ptr);
 	delete static_cast<Array<Bool>*>(vecptr);
 	break;
     case TpUChar:
-	delete static_cast<uChar*>(ptr);
+	freeScalarSlot (ptr);
 	delete static_cast<Array<uChar>*>(vecptr);
 	break;
     case TpShort:
-	delete static_cast<Short*>(ptr);
+	freeScalarSlot (ptr);
 	delete static_cast<Array<Short>*>(vecptr);
 	break;
     case TpInt:
-	delete static_cast<Int*>(ptr);
+	freeScalarSlot (ptr);
 	delete static_cast<Array<Int>*>(vecptr);
 	break;
     case TpUInt:
-	delete static_cast<uInt*>(ptr);
+	freeScalarSlot (ptr);
 	delete static_cast<Array<uInt>*>(vecptr);
 	break;
     case TpInt64:
-	delete static_cast<Int64*>(ptr);
+	freeScalarSlot (ptr);
 	delete static_cast<Array<Int64>*>(vecptr);
 	break;
     case TpFloat:
-	delete static_cast<float*>(ptr);
+	freeScalarSlot (ptr);
 	delete static_cast<Array<float>*>(vecptr);
 	break;
     case TpDouble:
-	delete static_cast<double*>(ptr);
+	freeScalarSlot (ptr);
 	delete static_cast<Array<double>*>(vecptr);
 	break;
     case TpComplex:
-	delete static_cast<Complex*>(ptr);
+	freeScalarSlot (ptr);
 	delete static_cast<Array<Complex>*>(vecptr);
 	break;
     case TpDComplex:
-	delete static_cast<DComplex*>(ptr);
+	freeScalarSlot (ptr);
 	delete static_cast<Array<DComplex>*>(vecptr);
 	break;
     case TpString:
@@ -32,6 +32,7 @@
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Containers/RecordDesc.h>
 #include <casacore/casa/Containers/RecordInterface.h>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -64,6 +65,13 @@ class String;
 // it in this indirect way, it is easier to extend the data block.
 // It also means that RecordFieldPtr objects always have the correct
 // pointer and do not need to be adjusted when the data block is extended.
+// <br>The values of numeric scalar fields (Bool till DComplex) are not
+// allocated one by one on the heap, but are kept in slots of chunks owned
+// by the RecordRep. When (re)structuring a record, all its numeric scalars
+// are put in a single chunk, so they are contiguous in memory. A slot
+// never moves, so a pointer to a value stays valid as long as the field
+// exists. The field names are looked up using a hashed index in the
+// RecordDesc.
 // <p>
 // Despite the fact that the data pointers have type void*, the
 // functions are completely type safe. This is done by passing the
@@ -277,6 +285,21 @@ protected:
     // It is used to be able to access a scalar as an 1D array.
     void makeDataVec (Int whichField, DataType type);
 
+    // Tell if the data type is a numeric scalar held in a slot.
+    static Bool isSlotScalar (DataType type);
+
+    // Make sure there are enough free slots for the numeric scalars
+    // in the description. If no slot is in use, they are put in a
+    // single chunk. It should be called when restructuring a record.
+    void reserveScalarSlots (const RecordDesc& desc);
+
+    // Get a slot for a numeric scalar value. A new chunk is allocated
+    // if no slot is free.
+    void* allocScalarSlot();
+
+    // Put a slot back in the free list (a null pointer is ignored).
+    void freeScalarSlot (void* ptr);
+
     // Get a Scalar/ArrayKeywordSet object as a Record.
     // (type 0 = ScalarKeywordSet;  type 1 = ArrayKeywordSet).
     void getKeySet (AipsIO& os, uInt version, uInt type);
@@ -299,6 +322,33 @@ protected:
     Block<void*> datavec_p;
     // #Entries used in data_p.
     uInt         nused_p;
+
+private:
+    // A slot can hold the value of any numeric scalar type.
+    union ScalarSlot {
+	ScalarSlot* next;
+	Int64       ival;
+	double      dval[2];
+    };
+
+    // Link the slots of a chunk in order, where the last one points
+    // to <src>next</src>. It returns the first slot.
+    static ScalarSlot* linkSlots (ScalarSlot* chunk, uInt nslots,
+				  ScalarSlot* next);
+
+    // Add a chunk with the given number of slots to the free list.
+    void addScalarChunk (uInt nslots);
+
+    // Free all chunks. No slot should be in use anymore.
+    void releaseScalarSlots();
+
+    // The chunks of slots for the numeric scalar values.
+    std::vector<ScalarSlot*> slotChunks_p;
+    // The list of free slots.
+    ScalarSlot*  freeSlots_p;
+    // Total number of slots and number of free slots.
+    uInt         nslots_p;
+    uInt         nfreeSlots_p;
 };
 
 
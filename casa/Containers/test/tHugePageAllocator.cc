@@ -0,0 +1,129 @@
+//# tHugePageAllocator.cc: Test program for class HugePageAllocator
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Containers/HugePageAllocator.h>
+#include <casacore/casa/Containers/Allocator.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <vector>
+#include <casacore/casa/namespace.h>
+
+void testSmall()
+{
+  // Small blocks are not mapped.
+  size_t mapped = HugePageAllocatorBase::mappedBytes();
+  void* ptr = HugePageAllocatorBase::allocate (1000);
+  AlwaysAssertExit (size_t(ptr) % CASA_DEFAULT_ALIGNMENT == 0);
+  AlwaysAssertExit (HugePageAllocatorBase::mappedBytes() == mapped);
+  HugePageAllocatorBase::deallocate (ptr, 1000);
+}
+
+void testLarge (HugePageAllocatorBase::HugePages hugePages,
+                HugePageAllocatorBase::NumaPolicy numaPolicy)
+{
+  HugePageAllocatorBase::Options opt;
+  opt.threshold  = 1024*1024;
+  opt.hugePages  = hugePages;
+  opt.numaPolicy = numaPolicy;
+  HugePageAllocatorBase::setOptions (opt);
+  AlwaysAssertExit (HugePageAllocatorBase::options().threshold == 1024*1024);
+  AlwaysAssertExit (HugePageAllocatorBase::options().hugePages == hugePages);
+  AlwaysAssertExit (HugePageAllocatorBase::options().numaPolicy == numaPolicy);
+  size_t nbytes = 5*1024*1024 + 100;
+  char* ptr = static_cast<char*>(HugePageAllocatorBase::allocate (nbytes));
+#if defined(AIPS_LINUX)
+  size_t psz = HugePageAllocatorBase::hugePageSize();
+  AlwaysAssertExit (size_t(ptr) % psz == 0);
+  AlwaysAssertExit (HugePageAllocatorBase::mappedBytes() ==
+                    (nbytes + psz - 1) / psz * psz);
+#endif
+  for (size_t i=0; i<nbytes; i+=4096) {
+    ptr[i] = char(i/4096);
+  }
+  ptr[nbytes-1] = 1;
+  for (size_t i=0; i<nbytes; i+=4096) {
+    AlwaysAssertExit (ptr[i] == char(i/4096));
+  }
+  // The block is freed correctly after a change of options.
+  HugePageAllocatorBase::setOptions (HugePageAllocatorBase::Options());
+  HugePageAllocatorBase::deallocate (ptr, nbytes);
+  AlwaysAssertExit (HugePageAllocatorBase::mappedBytes() == 0);
+}
+
+void testArray()
+{
+  HugePageAllocatorBase::Options opt;
+  opt.threshold = 1024*1024;
+  HugePageAllocatorBase::setOptions (opt);
+  typedef Array<Float, HugePageAllocator<Float>> BigArray;
+  {
+    BigArray arr(IPosition(2,1024,1024), BigArray::uninitialized);
+    HugePageAllocatorBase::firstTouchFill (arr.data(), arr.nelements(),
+                                           Float(2));
+    for (const Float& v : arr) {
+      AlwaysAssertExit (v == 2);
+    }
+#if defined(AIPS_LINUX)
+    AlwaysAssertExit (HugePageAllocatorBase::mappedBytes() >= 4*1024*1024);
+#endif
+    BigArray arr2 = arr * Float(3);
+    AlwaysAssertExit (arr2.data()[12345] == 6);
+    arr2.resize (IPosition(1,10));
+  }
+  AlwaysAssertExit (HugePageAllocatorBase::mappedBytes() == 0);
+  // It can also be used in STL containers.
+  std::vector<Double, HugePageAllocator<Double>> vec(1000000, 1.);
+  AlwaysAssertExit (vec[999999] == 1.);
+  HugePageAllocatorBase::setOptions (HugePageAllocatorBase::Options());
+}
+
+int main()
+{
+  try {
+    const std::vector<Int>& nodes = HugePageAllocatorBase::numaNodes();
+    for (Int node : nodes) {
+      AlwaysAssertExit (node >= 0);
+    }
+    testSmall();
+    testLarge (HugePageAllocatorBase::NoHugePages,
+               HugePageAllocatorBase::NumaDefault);
+    testLarge (HugePageAllocatorBase::TransparentHugePages,
+               HugePageAllocatorBase::NumaInterleave);
+    testLarge (HugePageAllocatorBase::ExplicitHugePages,
+               HugePageAllocatorBase::NumaBind);
+    testArray();
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,222 @@
+//# tPoolAllocator.cc: Test program for class PoolAllocator
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Containers/PoolAllocator.h>
+#include <casacore/casa/Containers/Allocator.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/OS/MemoryTrace.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <thread>
+#include <vector>
+#include <casacore/casa/namespace.h>
+
+// Find the statistics of the size class of the given block size.
+const PoolAllocatorStatistics::SizeClass*
+findClass (const PoolAllocatorStatistics& stats, size_t blockSize)
+{
+  for (const PoolAllocatorStatistics::SizeClass& sc : stats.sizeClasses) {
+    if (sc.blockSize == blockSize) {
+      return &sc;
+    }
+  }
+  return 0;
+}
+
+void testSizeClasses()
+{
+  AlwaysAssertExit (PoolAllocatorBase::blockSize(1) == 32);
+  AlwaysAssertExit (PoolAllocatorBase::blockSize(32) == 32);
+  AlwaysAssertExit (PoolAllocatorBase::blockSize(33) == 64);
+  AlwaysAssertExit (PoolAllocatorBase::blockSize(512) == 512);
+  AlwaysAssertExit (PoolAllocatorBase::blockSize(513) == 640);
+  AlwaysAssertExit (PoolAllocatorBase::blockSize(1024) == 1024);
+  AlwaysAssertExit (PoolAllocatorBase::blockSize(1025) == 1280);
+  AlwaysAssertExit (PoolAllocatorBase::blockSize(32768) == 32768);
+  AlwaysAssertExit (PoolAllocatorBase::blockSize(32769) == 40960);
+  size_t maxSize = PoolAllocatorBase::maxPooledSize();
+  AlwaysAssertExit (PoolAllocatorBase::blockSize(maxSize) == maxSize);
+  AlwaysAssertExit (PoolAllocatorBase::blockSize(maxSize+1) == maxSize+1);
+  // The waste is at most 25% above 512 bytes.
+  for (size_t n=513; n<maxSize; n+=n/7) {
+    size_t bs = PoolAllocatorBase::blockSize(n);
+    AlwaysAssertExit (bs >= n  &&  bs <= n + n/4 + 1);
+  }
+}
+
+void testReuse()
+{
+  // A block freed is reused by the next allocation of the same size class.
+  void* ptr1 = PoolAllocatorBase::allocate (1000);
+  AlwaysAssertExit (size_t(ptr1) % CASA_DEFAULT_ALIGNMENT == 0);
+  PoolAllocatorBase::deallocate (ptr1, 1000);
+  void* ptr2 = PoolAllocatorBase::allocate (1010);
+  AlwaysAssertExit (ptr2 == ptr1);
+  PoolAllocatorStatistics stats = PoolAllocatorBase::statistics();
+  const PoolAllocatorStatistics::SizeClass* sc = findClass (stats, 1024);
+  AlwaysAssertExit (sc != 0);
+  AlwaysAssertExit (sc->nalloc == 2);
+  AlwaysAssertExit (sc->nlive == 1);
+  AlwaysAssertExit (sc->ncached == 0);
+  AlwaysAssertExit (stats.liveBytes >= 1024);
+  PoolAllocatorBase::deallocate (ptr2, 1010);
+  // Without pooling the block is freed.
+  {
+    PoolAllocatorScope scope(False);
+    AlwaysAssertExit (! PoolAllocatorBase::pooling());
+    void* ptr3 = PoolAllocatorBase::allocate (1000);
+    AlwaysAssertExit (ptr3 == ptr1);
+    PoolAllocatorBase::deallocate (ptr3, 1000);
+    sc = findClass (PoolAllocatorBase::statistics(), 1024);
+    AlwaysAssertExit (sc->ncached == 0);
+  }
+  AlwaysAssertExit (PoolAllocatorBase::pooling());
+  // Large blocks are not pooled.
+  size_t large = PoolAllocatorBase::maxPooledSize() + 8;
+  void* ptr4 = PoolAllocatorBase::allocate (large);
+  stats = PoolAllocatorBase::statistics();
+  sc = findClass (stats, 0);
+  AlwaysAssertExit (sc != 0  &&  sc->nlive == 1);
+  AlwaysAssertExit (stats.peakBytes >= Int64(large));
+  PoolAllocatorBase::deallocate (ptr4, large);
+  AlwaysAssertExit (findClass (PoolAllocatorBase::statistics(), 0)->nlive
+                    == 0);
+}
+
+void testArray()
+{
+  typedef Array<Complex, PoolAllocator<Complex>> PoolArray;
+  IPosition shape(2,4,64);
+  size_t bs = PoolAllocatorBase::blockSize (shape.product() * sizeof(Complex));
+  const PoolAllocatorStatistics::SizeClass* sc =
+    findClass (PoolAllocatorBase::statistics(), bs);
+  Int64 nalloc = (sc ? sc->nalloc : 0);
+  for (int i=0; i<100; ++i) {
+    PoolArray arr(shape, Complex(i,1));
+    PoolArray arr2 = arr + arr;
+    for (const Complex& v : arr2) {
+      AlwaysAssertExit (v == Complex(2*i,2));
+    }
+    PoolArray ref(arr2);
+    AlwaysAssertExit (ref.data() == arr2.data());
+  }
+  PoolAllocatorStatistics stats = PoolAllocatorBase::statistics();
+  sc = findClass (stats, bs);
+  AlwaysAssertExit (sc != 0);
+  AlwaysAssertExit (sc->nalloc - nalloc == 200);
+  AlwaysAssertExit (sc->nlive == 0);
+  AlwaysAssertExit (sc->ncached == 2);
+  AlwaysAssertExit (MemoryTrace::poolStatistics().liveBytes ==
+                    stats.liveBytes);
+  // A resize also uses the allocator.
+  PoolArray arr(IPosition(1,10));
+  arr.resize (IPosition(1,1000));
+  AlwaysAssertExit (arr.nelements() == 1000);
+}
+
+void testThreads()
+{
+  // Blocks allocated in one thread can be freed in another.
+  std::vector<void*> ptrs(1000);
+  std::thread thr1([&ptrs]() {
+      for (void*& ptr : ptrs) {
+        ptr = PoolAllocatorBase::allocate (200);
+      }
+    });
+  thr1.join();
+  std::vector<std::thread> threads;
+  for (int t=0; t<4; ++t) {
+    threads.push_back (std::thread([&ptrs, t]() {
+          for (size_t i=t; i<ptrs.size(); i+=4) {
+            PoolAllocatorBase::deallocate (ptrs[i], 200);
+          }
+          for (int i=0; i<10000; ++i) {
+            void* ptr = PoolAllocatorBase::allocate (100 + i%1000);
+            PoolAllocatorBase::deallocate (ptr, 100 + i%1000);
+          }
+        }));
+  }
+  for (std::thread& thr : threads) {
+    thr.join();
+  }
+  PoolAllocatorStatistics stats = PoolAllocatorBase::statistics();
+  for (const PoolAllocatorStatistics::SizeClass& sc : stats.sizeClasses) {
+    AlwaysAssertExit (sc.nlive == 0);
+  }
+  // The blocks of the ended threads are in the central pool.
+  const PoolAllocatorStatistics::SizeClass* sc = findClass (stats, 224);
+  AlwaysAssertExit (sc->ncached >= 1000);
+  AlwaysAssertExit (stats.cachedBytes > 0);
+  cout << stats;
+  PoolAllocatorBase::release();
+  stats = PoolAllocatorBase::statistics();
+  AlwaysAssertExit (stats.cachedBytes == 0);
+}
+
+void timeRows (size_t nrow)
+{
+  IPosition shape(2,4,1024);
+  {
+    Timer timer;
+    for (size_t i=0; i<nrow; ++i) {
+      Array<Complex> arr(shape);
+      arr.data()[0] = Complex(i);
+    }
+    timer.show ("std::allocator  ");
+  }
+  {
+    Timer timer;
+    for (size_t i=0; i<nrow; ++i) {
+      Array<Complex, PoolAllocator<Complex>> arr(shape);
+      arr.data()[0] = Complex(i);
+    }
+    timer.show ("PoolAllocator   ");
+  }
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    testSizeClasses();
+    testReuse();
+    testArray();
+    testThreads();
+    if (argc > 1) {
+      timeRows (atoi(argv[1]));
+    }
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
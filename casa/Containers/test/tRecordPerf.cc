@@ -0,0 +1,144 @@
+//# tRecordPerf.cc: Measure the performance of Record operations
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Containers/RecordField.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/Exceptions/Error.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+
+// This program measures the time to define, get, and copy the fields
+// of records with 10 to 1000 fields (mostly scalars, some strings and
+// arrays). The total number of field operations per test can be given
+// as the first argument; it defaults to 10^7.
+
+double elapsed (const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double>
+    (std::chrono::steady_clock::now() - start).count();
+}
+
+void report (const char* name, uInt nfield, size_t nop, double sec)
+{
+  std::cout << "  " << name << " nfield=" << nfield << ": "
+            << sec / nop * 1e9 << " ns/field" << std::endl;
+}
+
+// Define the fields (every 8th field is a String, every 16th an Array).
+void defineFields (Record& rec, const std::vector<String>& names)
+{
+  for (uInt i=0; i<names.size(); ++i) {
+    if (i%16 == 15) {
+      rec.define (names[i], Array<Float>(IPosition(1,4), Float(i)));
+    } else if (i%8 == 7) {
+      rec.define (names[i], String("value"));
+    } else if (i%2 == 0) {
+      rec.define (names[i], Double(i));
+    } else {
+      rec.define (names[i], Int(i));
+    }
+  }
+}
+
+void timeRecord (uInt nfield, size_t nop)
+{
+  std::vector<String> names(nfield);
+  for (uInt i=0; i<nfield; ++i) {
+    names[i] = "FIELD_" + String::toString(i);
+  }
+  size_t nrep = std::max (size_t(1), nop / nfield);
+  // Define the fields in a new record.
+  auto start = std::chrono::steady_clock::now();
+  for (size_t rep=0; rep<nrep; ++rep) {
+    Record rec;
+    defineFields (rec, names);
+  }
+  report ("define", nfield, nrep*nfield, elapsed(start));
+  Record rec;
+  defineFields (rec, names);
+  // Get the scalar fields by name.
+  double sum = 0;
+  start = std::chrono::steady_clock::now();
+  for (size_t rep=0; rep<nrep; ++rep) {
+    for (uInt i=0; i<nfield; i+=2) {
+      sum += rec.asDouble (names[i]);
+    }
+  }
+  report ("get   ", nfield, nrep*(nfield/2), elapsed(start));
+  // Redefine the existing fields by name.
+  start = std::chrono::steady_clock::now();
+  for (size_t rep=0; rep<nrep; ++rep) {
+    for (uInt i=0; i<nfield; i+=2) {
+      rec.define (names[i], Double(rep));
+    }
+  }
+  report ("put   ", nfield, nrep*(nfield/2), elapsed(start));
+  // Make a deep copy of the record (a copy shares the data until
+  // made unique).
+  start = std::chrono::steady_clock::now();
+  for (size_t rep=0; rep<nrep; ++rep) {
+    Record copy(rec);
+    copy.makeUnique();
+    sum += copy.nfields();
+  }
+  report ("copy  ", nfield, nrep*nfield, elapsed(start));
+  // Assign to a record with the same structure.
+  Record copy(rec);
+  start = std::chrono::steady_clock::now();
+  for (size_t rep=0; rep<nrep; ++rep) {
+    copy.assign (rec);
+  }
+  report ("assign", nfield, nrep*nfield, elapsed(start));
+  if (sum < 0) {
+    std::cout << sum << std::endl;
+  }
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    size_t nop = 10000000;
+    if (argc > 1) {
+      nop = std::strtoul (argv[1], 0, 10);
+    }
+    std::cout << "Record performance (" << nop << " operations per test)"
+              << std::endl;
+    for (uInt nfield : {10, 100, 1000}) {
+      timeRecord (nfield, nop);
+    }
+  } catch (const std::exception& x) {
+    std::cout << "Unexpected exception: " << x.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -26,6 +26,7 @@
 #include <casacore/casa/IO/AipsIO.h>
 #include <casacore/casa/IO/TypeIO.h>
 #include <casacore/casa/IO/CanonicalIO.h>
+#include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/IO/ByteIO.h>
 #include <casacore/casa/IO/RegularFileIO.h>
 #include <casacore/casa/IO/MFFileIO.h>
@@ -987,6 +988,34 @@ uInt AipsIO::getend()
 }
 
 
+// getRawObject reads the length of the next object using getNextType,
+// repositions to the start of the object and reads it as is.
+// It adds the length read to the object being read.
+Bool AipsIO::getRawObject (Block<uChar>& bytes)
+{
+    if (level_p == 0  ||  hasCachedType_p  ||  !seekable_p
+    ||  dynamic_cast<CanonicalIO*>(io_p.get()) == 0) {
+        return False;
+    }
+    testget();
+    Int64 pos = getpos();
+    getNextType();
+    uInt len = objtln_p[level_p];
+    hasCachedType_p = False;
+    level_p--;
+    io_p->seek (pos);
+    uInt mlen = CanonicalConversion::canonicalSize (&magicval_p);
+    bytes.resize (mlen + len, True, False);
+    CanonicalConversion::fromLocal (bytes.storage(), magicval_p);
+    if (io_p->byteIO().read (len, bytes.storage() + mlen) != len) {
+        throw AipsError ("AipsIO::getRawObject: object could not be read");
+    }
+    objlen_p[level_p] += len;
+    testgetLength();
+    return True;
+}
+
+
 // Throw errors on behalf of testput and testget.
 // testget and testput are inline and it would be a bit expensive to
 // get these (expanded) statements in all instances.
@@ -402,6 +402,16 @@ public:
     // stream in sync). If not, an exception is thrown.
     uInt getend();
 
+    // Read the next object as raw bytes without interpreting it, so its
+    // interpretation can be deferred. It can only be used for an object
+    // nested in the object being read.
+    // The bytes are preceeded by the magic value, thus they form a
+    // complete object that can later be read by an AipsIO object using a
+    // MemoryIO object.
+    // False is returned (and nothing is read) if the file is not seekable
+    // or not in canonical format.
+    Bool getRawObject (Block<uChar>& bytes);
+
 private:
     // Initialize everything for the open.
     // It checks if there is no outstanding open file.
@@ -26,8 +26,10 @@
 
 //# Includes
 #include <casacore/casa/IO/BucketCache.h>
+#include <casacore/casa/IO/BucketCacheManager.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
+#include <algorithm>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -56,11 +58,14 @@ BucketCache::BucketCache (BucketFile* file, Int64 startOffset,
   its_SlotNr        (nrOfBuckets, Int(-1)),
   its_BucketNr      (cacheSize, uInt(0)),
   its_Dirty         (cacheSize, uInt(0)),
-  its_LRU           (cacheSize, uInt(0)),
-  its_LRUCounter    (0),
+  its_LRU           (cacheSize, uInt64(0)),
+  its_LastStamp     (0),
+  its_NrInMemory    (0),
   its_Buffer        (0),
   its_NrOfFree      (0),
-  its_FirstFree     (-1)
+  its_FirstFree     (-1),
+  its_Manager       (&BucketCacheManager::instance()),
+  its_InBudget      (False)
 {
     initStatistics();
     // The bucketsize must be set.
@@ -87,10 +92,13 @@ BucketCache::BucketCache (BucketFile* file, Int64 startOffset,
 	    its_CurNrOfBuckets = its_NewNrOfBuckets;
 	}
     }
+    // Register in the process-wide memory budget.
+    its_Manager->add (this);
 }
 
 BucketCache::~BucketCache()
 {
+    its_Manager->remove (this);
     // Clear the entire cache.
     // It is not flushed (that should have been done before).
     // In that way no needless flushes are done for a temporary table.
@@ -100,16 +108,21 @@ BucketCache::~BucketCache()
 
 void BucketCache::clear (uInt fromSlot, Bool doFlush)
 {
+    std::unique_lock<std::recursive_mutex> lck = lock (False);
     if (doFlush) {
         flush (fromSlot);
     }
+    uInt nrdel = 0;
     for (uInt i=fromSlot; i<its_CacheSizeUsed; i++) {
-	its_DeleteCallBack (its_Owner, its_Cache[i]);
-	its_Cache[i] = 0;
-	its_SlotNr[its_BucketNr[i]] = -1;
+	if (its_Cache[i] != 0) {
+	    deleteSlot (i);
+	    nrdel++;
+	}
+    }
+    if (nrdel > 0  &&  its_InBudget) {
+	its_Manager->release (uInt64(nrdel) * its_BucketSize);
     }
     if (fromSlot == 0) {
-	its_LRUCounter = 0;
 	initStatistics();
     }
     if (fromSlot < its_CacheSizeUsed) {
@@ -117,8 +130,19 @@ void BucketCache::clear (uInt fromSlot, Bool doFlush)
     }
 }
 
+void BucketCache::deleteSlot (uInt slotNr)
+{
+    its_DeleteCallBack (its_Owner, its_Cache[slotNr]);
+    its_Cache[slotNr] = 0;
+    its_SlotNr[its_BucketNr[slotNr]] = -1;
+    its_LRU[slotNr]   = 0;
+    its_Dirty[slotNr] = 0;
+    its_NrInMemory--;
+}
+
 Bool BucketCache::flush (uInt fromSlot)
 {
+    std::unique_lock<std::recursive_mutex> lck = lock (False);
     // Initialize remaining buckets when everything has to be flushed.
     if (fromSlot == 0  &&  its_NewNrOfBuckets > 0) {
 	initializeBuckets (its_NewNrOfBuckets - 1);
@@ -135,6 +159,7 @@ Bool BucketCache::flush (uInt fromSlot)
 
 void BucketCache::resize (uInt cacheSize)
 {
+    std::unique_lock<std::recursive_mutex> lck = lock (False);
     // Clear the part of the cache to be deleted.
     clear (cacheSize);
     // The cache must contain at least one slot.
@@ -168,6 +193,7 @@ void BucketCache::resize (uInt cacheSize)
 void BucketCache::resync (uInt nrBucket, uInt nrOfFreeBucket,
 			  Int firstFreeBucket)
 {
+    std::unique_lock<std::recursive_mutex> lck = lock (False);
     // Clear the entire cache, so data will be reread.
     // Set it to the new size.
     clear();
@@ -187,24 +213,37 @@ uInt BucketCache::nBucket() const
 
 void BucketCache::setDirty()
 {
+    std::unique_lock<std::recursive_mutex> lck = lock (False);
     its_Dirty[its_ActualSlot] = 1;
 }
 
 
+std::unique_lock<std::recursive_mutex> BucketCache::lock (Bool mayJoin)
+{
+    if (!its_InBudget  &&  mayJoin  &&  its_Manager->isLimited()) {
+        its_Manager->join (this);
+    }
+    if (its_InBudget) {
+        return std::unique_lock<std::recursive_mutex> (its_Mutex);
+    }
+    return std::unique_lock<std::recursive_mutex>();
+}
+
 void BucketCache::setLRU()
 {
-    // When the LRU counter would wrap, clear all LRU info in the cache.
-    if (its_LRUCounter == 4294967295u) {
-	its_LRUCounter = 0;
-	for (uInt i=0; i<its_CacheSizeUsed; i++) {
-	    its_LRU[i] = 0;
-	}
+    // Use a process-wide stamp if taking part in the memory budget, so
+    // buckets of different caches can be compared by the BucketCacheManager.
+    // The stamps of a cache must keep increasing.
+    its_LastStamp++;
+    if (its_InBudget) {
+        its_LastStamp = std::max (its_LastStamp, its_Manager->nextStamp());
     }
-    its_LRU[its_ActualSlot] = ++its_LRUCounter;
+    its_LRU[its_ActualSlot] = its_LastStamp;
 }
 
 char* BucketCache::getBucket (uInt bucketNr)
 {
+    std::unique_lock<std::recursive_mutex> lck = lock (True);
     if (bucketNr >= its_NewNrOfBuckets) {
 	throw (indexError<Int> (bucketNr));
     }
@@ -232,8 +271,50 @@ char* BucketCache::getBucket (uInt bucketNr)
     return its_Cache[its_ActualSlot];
 }
 
+uInt BucketCache::prefetch (uInt bucketNr, uInt nrBucket)
+{
+    std::unique_lock<std::recursive_mutex> lck = lock (True);
+    uInt endNr = std::min (uInt64(bucketNr) + nrBucket,
+                           uInt64(its_CurNrOfBuckets));
+    while (bucketNr < endNr  &&  its_SlotNr[bucketNr] >= 0) {
+        bucketNr++;
+    }
+    uInt maxNr = std::max (uInt(1), uInt(16*1024*1024 / its_BucketSize));
+    maxNr = std::min (maxNr, its_CacheSize);
+    uInt nr = 0;
+    while (bucketNr + nr < endNr  &&  nr < maxNr  &&
+           its_SlotNr[bucketNr + nr] < 0) {
+        nr++;
+    }
+    // A single bucket is read by getBucket.
+    if (nr <= 1) {
+        return 0;
+    }
+    // Read into a pooled (aligned) buffer to avoid copying the data.
+    char* buf;
+    size_t bufSize;
+    const char* data = its_file->readBuffer
+      (buf, bufSize, nr * its_BucketSize,
+       its_StartOffset + Int64(bucketNr) * its_BucketSize);
+    try {
+        for (uInt i=0; i<nr; ++i) {
+            getSlot (bucketNr + i);
+            its_Cache[its_ActualSlot] = its_ReadCallBack
+                                (its_Owner, data + size_t(i) * its_BucketSize);
+            nread_p++;
+        }
+    } catch (...) {
+        BucketFile::releaseBuffer (buf, bufSize);
+        throw;
+    }
+    BucketFile::releaseBuffer (buf, bufSize);
+    nprefetch_p++;
+    return nr;
+}
+
 void BucketCache::extend (uInt nrBucket)
 {
+    std::unique_lock<std::recursive_mutex> lck = lock (False);
     its_NewNrOfBuckets += nrBucket;
     uInt oldSize = its_SlotNr.nelements();
     if (oldSize < its_NewNrOfBuckets) {
@@ -250,6 +331,7 @@ void BucketCache::extend (uInt nrBucket)
     
 uInt BucketCache::addBucket (char* data)
 {
+    std::unique_lock<std::recursive_mutex> lck = lock (True);
     uInt bucketNr;
     if (its_FirstFree >= 0) {
 	// There is a free list, so get the first bucket from it.
@@ -280,19 +362,19 @@ void BucketCache::removeBucket()
     // Removing a bucket means adding it to the beginning of the free list.
     // Thus store the bucket nr of the first free in this bucket
     // and make this bucket the first free.
+    std::unique_lock<std::recursive_mutex> lck = lock (False);
     uInt bucketNr = its_BucketNr[its_ActualSlot];
     CanonicalConversion::fromLocal (its_Buffer, its_FirstFree);
     its_file->seek (its_StartOffset + Int64(bucketNr) * its_BucketSize);
     its_file->write (its_Buffer, its_BucketSize);
-    its_Dirty[its_ActualSlot] = 0;
     its_FirstFree = bucketNr;
     its_NrOfFree++;
     // Delete the stuff for this bucket.
-    // Set the LRU to zero, so it will be reused first.
-    its_DeleteCallBack (its_Owner, its_Cache[its_ActualSlot]);
-    its_Cache[its_ActualSlot] = 0;
-    its_SlotNr[bucketNr] = -1;
-    its_LRU[its_ActualSlot] = 0;
+    // Its LRU is set to zero, so it will be reused first.
+    deleteSlot (its_ActualSlot);
+    if (its_InBudget) {
+        its_Manager->release (its_BucketSize);
+    }
     its_ActualSlot = 0;
 }
 
@@ -321,29 +403,81 @@ void BucketCache::checkOffset (uInt length, Int64 offset) const
 
 void BucketCache::getSlot (uInt bucketNr)
 {
+    // Use a new slot if available, otherwise the least recently used one
+    // (which can be empty if its bucket was removed).
+    uInt slotNr;
     if (its_CacheSizeUsed < its_CacheSize) {
-	its_ActualSlot = its_CacheSizeUsed++;
+	slotNr = its_CacheSizeUsed;
     }else{
-	its_ActualSlot = 0;
-	uInt least = its_LRU[0];
+	slotNr = 0;
+	uInt64 least = its_LRU[0];
 	for (uInt i=1; i<its_CacheSizeUsed; i++) {
 	    if (its_LRU[i] < least) {
 		least = its_LRU[i];
-		its_ActualSlot = i;
+		slotNr = i;
 	    }
 	}
+    }
+    // If the slot is empty, memory for the new bucket is needed.
+    // If the memory maximum is reached and no older buckets in other
+    // caches can be removed, reuse the least recently used bucket.
+    if (its_InBudget  &&
+        (slotNr == its_CacheSizeUsed  ||  its_Cache[slotNr] == 0)) {
+	uInt oldSlot = 0;
+	uInt64 stamp = 0;
+	if (its_Manager->isLimited()) {
+	    stamp = oldestSlot (oldSlot);
+	}
+	if (! its_Manager->reserve (this, its_BucketSize, stamp)) {
+	    slotNr = oldSlot;
+	}
+    }
+    if (slotNr == its_CacheSizeUsed) {
+	its_CacheSizeUsed++;
+    }
+    its_ActualSlot = slotNr;
+    if (its_Cache[its_ActualSlot] != 0) {
 	if (its_Dirty[its_ActualSlot]) {
 	    writeBucket (its_ActualSlot);
 	}
-	if (its_Cache[its_ActualSlot] != 0) {
-	    its_DeleteCallBack (its_Owner, its_Cache[its_ActualSlot]);
-	    its_Cache[its_ActualSlot] = 0;
-	    its_SlotNr[its_BucketNr[its_ActualSlot]] = -1;
-	}
+	deleteSlot (its_ActualSlot);
     }
     setLRU();
     its_BucketNr[its_ActualSlot] = bucketNr;
     its_SlotNr[bucketNr] = its_ActualSlot;
+    // The caller fills the slot.
+    its_NrInMemory++;
+}
+
+uInt64 BucketCache::oldestSlot (uInt& slotNr) const
+{
+    uInt64 least = 0;
+    for (uInt i=0; i<its_CacheSizeUsed; i++) {
+	if (its_Cache[i] != 0  &&  (least == 0  ||  its_LRU[i] < least)) {
+	    least  = its_LRU[i];
+	    slotNr = i;
+	}
+    }
+    return least;
+}
+
+uInt64 BucketCache::oldestCleanSlot (uInt& slotNr) const
+{
+    uInt64 least = 0;
+    for (uInt i=0; i<its_CacheSizeUsed; i++) {
+	if (its_Cache[i] != 0  &&  its_Dirty[i] == 0  &&  i != its_ActualSlot
+        &&  (least == 0  ||  its_LRU[i] < least)) {
+	    least  = its_LRU[i];
+	    slotNr = i;
+	}
+    }
+    return least;
+}
+
+void BucketCache::evictSlot (uInt slotNr)
+{
+    deleteSlot (slotNr);
+    nevict_p++;
 }
 
 
@@ -401,6 +535,12 @@ void BucketCache::showStatistics (ostream& os) const
     if (nwrite_p > 0) {
 	os << "#writes:   " << nwrite_p << endl;
     }
+    if (nevict_p > 0) {
+	os << "#evicted:  " << nevict_p << endl;
+    }
+    if (nprefetch_p > 0) {
+	os << "#prefetch: " << nprefetch_p << endl;
+    }
     os << "#accesses: " << naccess_p;
     if (naccess_p > 0) {
 	os << "        hit-rate:  "
@@ -416,6 +556,8 @@ void BucketCache::initStatistics()
     nread_p   = 0;
     ninit_p   = 0;
     nwrite_p  = 0;
+    nevict_p  = 0;
+    nprefetch_p = 0;
 }
 
 } //# NAMESPACE CASACORE - END
@@ -31,6 +31,8 @@
 #include <casacore/casa/IO/BucketFile.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
+#include <atomic>
+#include <mutex>
 
 //# Forward clarations
 #include <casacore/casa/iosfwd.h>
@@ -38,6 +40,9 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+//# Forward Declarations
+class BucketCacheManager;
+
 // <summary>
 // Define the type of the static read and write function.
 // </summary>
@@ -207,6 +212,19 @@ typedef void (*BucketCacheDeleteBuffer) (void* ownerObject, char* buffer);
 // </srcblock>
 // </example>
 
+// <note>
+// All BucketCache objects in a process share a memory budget kept by
+// class <linkto class=BucketCacheManager>BucketCacheManager</linkto>.
+// If a maximum is set, getting a bucket can remove unchanged buckets from
+// other caches. A cache takes part in the budget from the first time it
+// gets a bucket while a maximum is set. From then on the public functions
+// lock the cache, so another thread can only remove buckets when the cache
+// is not in use. A cache not taking part (e.g., when no maximum is set)
+// is neither locked nor counted in the budget, so it is as fast as before.
+// Only the pointer to the current bucket (i.e., the one returned by the
+// last getBucket or addBucket) is guaranteed to remain valid.
+// </note>
+
 // <todo asof="$DATE:$">
 //   <li> When ready, use HashMap for the internal maps.
 // </todo>
@@ -214,6 +232,8 @@ typedef void (*BucketCacheDeleteBuffer) (void* ownerObject, char* buffer);
 
 class BucketCache
 {
+friend class BucketCacheManager;
+
 public:
 
     // Create the cache for (a part of) a file.
@@ -274,6 +294,16 @@ public:
     // A pointer to the data in converted format is returned.
     char* getBucket (uInt bucketNr);
 
+    // Read the given buckets into the cache using a single file read.
+    // It is meant to read consecutive buckets in a large block when
+    // streaming through a file (e.g. when using O_DIRECT).
+    // Buckets already in the cache at the start are skipped and reading
+    // stops at the next bucket in the cache or not in the file yet.
+    // At most as many buckets as fit in the cache (and at most 16 MB)
+    // are read. It returns the number of buckets read.
+    // Thereafter getBucket has to be used to make a bucket current.
+    uInt prefetch (uInt bucketNr, uInt nrBucket);
+
     // Extend the file with the given number of buckets.
     // The buckets get initialized when they are acquired
     // (using getBucket) for the first time.
@@ -352,21 +382,36 @@ private:
     Block<uInt>  its_BucketNr;
     // Determine if a block is dirty (i.e. changed) (1=dirty).
     Block<uInt>  its_Dirty;
-    // Determine when a block is used for the last time.
-    Block<uInt>  its_LRU;
-    // The Least Recently Used counter.
-    uInt         its_LRUCounter;
+    // Determine when a block is used for the last time (0 = not used).
+    // It is a process-wide stamp (see BucketCacheManager) if the cache
+    // takes part in the memory budget, otherwise a stamp of this cache.
+    Block<uInt64> its_LRU;
+    // The last LRU stamp given.
+    uInt64       its_LastStamp;
+    // The number of slots holding a bucket.
+    std::atomic<uInt> its_NrInMemory;
     // The internal buffer.
     char*        its_Buffer;
     // The number of free buckets.
     uInt its_NrOfFree;
     // The first free bucket (-1 = no free buckets).
     Int  its_FirstFree;
+    // The manager of the process-wide memory budget.
+    BucketCacheManager* its_Manager;
+    // Does the cache take part in the memory budget?
+    // It is only set (by BucketCacheManager) and never cleared.
+    std::atomic<Bool> its_InBudget;
     // The statistics.
     uInt naccess_p;
     uInt nread_p;
     uInt ninit_p;
     uInt nwrite_p;
+    uInt nevict_p;
+    uInt nprefetch_p;
+    // The mutex to protect the cache against removal of buckets by
+    // BucketCacheManager when used by another thread.
+    // It is only used if the cache takes part in the memory budget.
+    std::recursive_mutex its_Mutex;
 
 
     // Copy constructor is not possible.
@@ -375,12 +420,35 @@ private:
     // Assignment is not possible.
     BucketCache& operator= (const BucketCache&);
 
+    // Lock the cache if it takes part in the memory budget.
+    // If <src>mayJoin</src> is True and a memory maximum is set, the cache
+    // starts taking part in it. That should only be done by the public
+    // functions getting a bucket, because the cache must not be in use.
+    std::unique_lock<std::recursive_mutex> lock (Bool mayJoin);
+
     // Set the LRU information for the current slot.
     void setLRU();
 
     // Get a cache slot for the bucket.
+    // If a memory maximum is set and reached, unchanged buckets in other
+    // caches or the least recently used bucket in this cache are removed.
     void getSlot (uInt bucketNr);
 
+    // Remove the bucket in the given slot from the cache.
+    // Its memory is not released in the BucketCacheManager.
+    void deleteSlot (uInt slotNr);
+
+    // Get the least recently used slot holding a bucket.
+    // It returns its LRU stamp (0 = no such slot).
+    uInt64 oldestSlot (uInt& slotNr) const;
+
+    // Get the least recently used slot holding an unchanged bucket other
+    // than the current bucket. It returns its LRU stamp (0 = no such slot).
+    uInt64 oldestCleanSlot (uInt& slotNr) const;
+
+    // Remove an unchanged bucket on behalf of BucketCacheManager.
+    void evictSlot (uInt slotNr);
+
     // Write a bucket.
     void writeBucket (uInt slotNr);
 
@@ -0,0 +1,187 @@
+//# BucketCacheManager.cc: Process-wide memory budget for bucket caches
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/casa/IO/BucketCacheManager.h>
+#include <casacore/casa/IO/BucketCache.h>
+#include <casacore/casa/System/AipsrcValue.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+BucketCacheManager::BucketCacheManager()
+: itsMaxMemory (0),
+  itsUsed      (0),
+  itsNevicted  (0),
+  itsStamp     (0)
+{
+    // The aipsrc value is given in MBytes.
+    Int maxMB;
+    AipsrcValue<Int>::find (maxMB, "table.cache.maxmemory", 0);
+    if (maxMB > 0) {
+        itsMaxMemory = uInt64(maxMB) * 1024 * 1024;
+    }
+}
+
+BucketCacheManager& BucketCacheManager::instance()
+{
+    // The object is never deleted, because caches might still be
+    // destructed at program exit.
+    static BucketCacheManager* manager = new BucketCacheManager();
+    return *manager;
+}
+
+uInt64 BucketCacheManager::maxMemory()
+{
+    return instance().itsMaxMemory;
+}
+
+void BucketCacheManager::setMaxMemory (uInt64 nbytes)
+{
+    instance().itsMaxMemory = nbytes;
+}
+
+uInt64 BucketCacheManager::memoryUsed()
+{
+    BucketCacheManager& mgr = instance();
+    std::lock_guard<std::mutex> lock(mgr.itsMutex);
+    // Add the memory of the caches not taking part in the budget.
+    uInt64 used = mgr.itsUsed;
+    for (std::set<BucketCache*>::const_iterator iter = mgr.itsCaches.begin();
+         iter != mgr.itsCaches.end(); ++iter) {
+        if (! (*iter)->its_InBudget) {
+            used += uInt64((*iter)->its_NrInMemory) * (*iter)->its_BucketSize;
+        }
+    }
+    return used;
+}
+
+uInt BucketCacheManager::nregistered()
+{
+    BucketCacheManager& mgr = instance();
+    std::lock_guard<std::mutex> lock(mgr.itsMutex);
+    return mgr.itsCaches.size();
+}
+
+uInt64 BucketCacheManager::nevicted()
+{
+    BucketCacheManager& mgr = instance();
+    std::lock_guard<std::mutex> lock(mgr.itsMutex);
+    return mgr.itsNevicted;
+}
+
+void BucketCacheManager::add (BucketCache* cache)
+{
+    std::lock_guard<std::mutex> lock(itsMutex);
+    itsCaches.insert (cache);
+}
+
+void BucketCacheManager::remove (BucketCache* cache)
+{
+    std::lock_guard<std::mutex> lock(itsMutex);
+    itsCaches.erase (cache);
+}
+
+void BucketCacheManager::join (BucketCache* cache)
+{
+    // Joining is done under the lock, so evictOther cannot remove a bucket
+    // of the cache before its memory is counted.
+    std::lock_guard<std::mutex> lock(itsMutex);
+    itsUsed += uInt64(cache->its_NrInMemory) * cache->its_BucketSize;
+    // Its older buckets got stamps of the cache itself; let the
+    // process-wide stamp follow them.
+    if (cache->its_LastStamp > itsStamp) {
+        itsStamp = cache->its_LastStamp;
+    }
+    cache->its_InBudget = True;
+}
+
+Bool BucketCacheManager::reserve (BucketCache* cache, uInt64 nbytes,
+                                  uInt64 stamp)
+{
+    std::lock_guard<std::mutex> lock(itsMutex);
+    uInt64 maxMemory = itsMaxMemory;
+    if (maxMemory > 0) {
+        // If the cache has no bucket to reuse, any other bucket can go.
+        uInt64 maxStamp = (stamp > 0  ?  stamp : ~uInt64(0));
+        while (itsUsed + nbytes > maxMemory) {
+            if (! evictOther (cache, maxStamp)) {
+                if (stamp > 0) {
+                    return False;
+                }
+                break;
+            }
+        }
+    }
+    itsUsed += nbytes;
+    return True;
+}
+
+void BucketCacheManager::release (uInt64 nbytes)
+{
+    std::lock_guard<std::mutex> lock(itsMutex);
+    itsUsed = (nbytes < itsUsed  ?  itsUsed - nbytes : 0);
+}
+
+Bool BucketCacheManager::evictOther (BucketCache* cache, uInt64 stamp)
+{
+    // Find the oldest unchanged bucket in the other caches.
+    // A cache in use by another thread is skipped. The cache holding the
+    // oldest bucket found so far is kept locked.
+    BucketCache* best = 0;
+    uInt bestSlot = 0;
+    uInt64 bestStamp = stamp;
+    for (std::set<BucketCache*>::iterator iter = itsCaches.begin();
+         iter != itsCaches.end(); ++iter) {
+        BucketCache* other = *iter;
+        if (other == cache  ||  ! other->its_InBudget  ||
+            ! other->its_Mutex.try_lock()) {
+            continue;
+        }
+        uInt slot;
+        uInt64 oldest = other->oldestCleanSlot (slot);
+        if (oldest > 0  &&  oldest < bestStamp) {
+            if (best) {
+                best->its_Mutex.unlock();
+            }
+            best      = other;
+            bestSlot  = slot;
+            bestStamp = oldest;
+        } else {
+            other->its_Mutex.unlock();
+        }
+    }
+    if (best == 0) {
+        return False;
+    }
+    best->evictSlot (bestSlot);
+    best->its_Mutex.unlock();
+    itsUsed = (best->its_BucketSize < itsUsed  ?
+               itsUsed - best->its_BucketSize : 0);
+    itsNevicted++;
+    return True;
+}
+
+} //# NAMESPACE CASACORE - END
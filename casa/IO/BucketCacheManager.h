@@ -0,0 +1,182 @@
+//# BucketCacheManager.h: Process-wide memory budget for bucket caches
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_BUCKETCACHEMANAGER_H
+#define CASA_BUCKETCACHEMANAGER_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <atomic>
+#include <mutex>
+#include <set>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class BucketCache;
+
+
+// <summary>
+// Process-wide memory budget for all bucket caches
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tBucketCacheManager">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=BucketCache>BucketCache</linkto>
+// </prerequisite>
+
+// <synopsis>
+// Each storage manager (e.g., StandardStMan, IncrementalStMan, and the
+// hypercubes of the TiledStMan's) has its own BucketCache, whose size is
+// determined independently. A process opening many tables can therefore
+// use a lot of memory, while limiting the individual cache sizes makes
+// the caches thrash.
+// <br>BucketCacheManager keeps track of the memory used by all
+// BucketCache objects in the process. Every BucketCache registers itself
+// when constructed. A cache takes part in the memory budget from the first
+// time it gets a bucket while a maximum is set; its buckets in memory are
+// counted from then on. If a maximum is set, a cache needing memory for a
+// bucket first tries to make room by removing the least recently used
+// buckets from all caches. If those are older than its own least recently
+// used bucket, they are removed from the other caches; otherwise the cache
+// reuses the slot of its own least recently used bucket. In this way the
+// buckets in memory are approximately the most recently used ones in the
+// process.
+// <p>
+// The maximum is a soft limit for the following reasons:
+// <ul>
+//  <li> Only unchanged buckets are removed from another cache, because
+//       writing a bucket has to be done by the owner of the cache.
+//  <li> The current bucket of a cache is never removed, because its
+//       data may be in use.
+//  <li> A cache being used by another thread is skipped.
+//  <li> A cache not used since the maximum was set does not take part
+//       yet, so its buckets are not counted and cannot be removed.
+// </ul>
+// <p>
+// The maximum can be set with function <src>setMaxMemory</src> or with
+// the aipsrc variable <src>table.cache.maxmemory</src> (in MBytes).
+// By default there is no maximum, in which case the individual cache sizes
+// determine the memory used, as before. The caches do not take part in
+// the budget then, so their accesses do not lock or use the manager.
+// <br>Note that the memory of a bucket is taken as the bucket size in the
+// file, while its size in memory can differ somewhat.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   // Allow 512 MByte for all bucket caches in this process.
+//   BucketCacheManager::setMaxMemory (512*1024*1024);
+//   ...
+//   cout << BucketCacheManager::memoryUsed() << endl;
+// </srcblock>
+// </example>
+
+class BucketCacheManager
+{
+public:
+    // Get the maximum memory to use (in bytes). 0 means unlimited.
+    // The first time it is read from aipsrc variable
+    // <src>table.cache.maxmemory</src> (in MBytes).
+    static uInt64 maxMemory();
+
+    // Set the maximum memory to use (in bytes). 0 means unlimited.
+    // It is used when buckets are read the next time; buckets already
+    // in memory are not removed.
+    static void setMaxMemory (uInt64 nbytes);
+
+    // Get the memory (in bytes) currently used by all bucket caches.
+    static uInt64 memoryUsed();
+
+    // Get the number of registered bucket caches.
+    static uInt nregistered();
+
+    // Get the number of buckets removed from a cache to make room for
+    // a bucket in another cache.
+    static uInt64 nevicted();
+
+private:
+    friend class BucketCache;
+
+    BucketCacheManager();
+
+    // Get the single instance.
+    static BucketCacheManager& instance();
+
+    // Register or unregister a cache.
+    // <group>
+    void add (BucketCache*);
+    void remove (BucketCache*);
+    // </group>
+
+    // Let a registered cache take part in the memory budget.
+    // The memory of its buckets in memory is counted.
+    void join (BucketCache*);
+
+    // Get the next (process-wide) LRU stamp.
+    uInt64 nextStamp()
+        { return ++itsStamp; }
+
+    // Try to reserve the memory for a bucket in the given cache.
+    // If the maximum would be exceeded, the unchanged buckets of other
+    // caches that are older than the given stamp are removed.
+    // False is returned if no room could be made, in which case the cache
+    // has to reuse its own least recently used bucket (with that stamp).
+    // A stamp 0 means that the cache has no bucket to reuse, so any
+    // bucket of another cache can be removed and the memory is always
+    // reserved.
+    Bool reserve (BucketCache*, uInt64 nbytes, uInt64 stamp);
+
+    // Is a maximum set?
+    Bool isLimited() const
+        { return itsMaxMemory > 0; }
+
+    // Release the memory of a bucket.
+    void release (uInt64 nbytes);
+
+    // Remove the least recently used bucket older than the given stamp
+    // from the caches other than the given one.
+    // False is returned if no such bucket could be found.
+    Bool evictOther (BucketCache*, uInt64 stamp);
+
+    std::mutex             itsMutex;
+    std::set<BucketCache*> itsCaches;
+    std::atomic<uInt64>    itsMaxMemory;
+    uInt64                 itsUsed;
+    uInt64                 itsNevicted;
+    std::atomic<uInt64>    itsStamp;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -31,6 +31,7 @@
 #include <casacore/casa/IO/FilebufIO.h>
 #include <casacore/casa/IO/MFFileIO.h>
 #include <casacore/casa/OS/Path.h>
+#include <casacore/casa/OS/File.h>
 #include <casacore/casa/OS/DOos.h>
 #include <casacore/casa/Logging/LogIO.h>
 #include <casacore/casa/Utilities/Assert.h>
@@ -40,6 +41,10 @@
 #include <fcntl.h>
 #include <errno.h>                // needed for errno
 #include <casacore/casa/string.h>          // needed for strerror
+#include <stdlib.h>                        // for posix_memalign
+#include <algorithm>
+#include <mutex>
+#include <vector>
 
 #if defined(AIPS_DARWIN) || defined(AIPS_BSD)
 #undef trace3OPEN
@@ -48,13 +53,100 @@
 #define trace2OPEN open
 #undef traceLSEEK
 #define traceLSEEK lseek
+#undef tracePREAD
+#define tracePREAD pread
 #endif
 
+//# The alignment needed for O_DIRECT.
+#define bf_od_align (size_t(4096))
+
+
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+//# Pool of aligned buffers used for O_DIRECT reads of all BucketFiles.
+//# A buffer is taken from the pool for a read and given back thereafter,
+//# so only a few (large) buffers exist at any time. The pool keeps at most
+//# 4 buffers and 64 MB; a buffer exceeding that is freed when given back.
+class BucketFileBufferPool
+{
+public:
+  // Get a buffer of at least the given size.
+  static char* get (size_t& size)
+  {
+    std::lock_guard<std::mutex> lock(theirMutex);
+    // Use the smallest free buffer that is large enough.
+    size_t inx = theirFree.size();
+    for (size_t i=0; i<theirFree.size(); ++i) {
+      if (theirFree[i].first >= size  &&
+          (inx == theirFree.size()  ||  theirFree[i].first < theirFree[inx].first)) {
+        inx = i;
+      }
+    }
+    if (inx < theirFree.size()) {
+      char* buf = theirFree[inx].second;
+      size = theirFree[inx].first;
+      theirBytes -= size;
+      theirFree.erase (theirFree.begin() + inx);
+      return buf;
+    }
+    // Allocate a new buffer (at least 1 MB to avoid many small ones).
+    size = std::max (size, size_t(1024*1024));
+    void* buf = 0;
+    if (posix_memalign (&buf, bf_od_align, size) != 0) {
+      throw AllocError ("BucketFile: failed to allocate aligned buffer", size);
+    }
+    return static_cast<char*>(buf);
+  }
+  // Give a buffer back to the pool.
+  // The smallest buffer is freed if too many are pooled.
+  static void release (char* buf, size_t size)
+  {
+    if (size > theirMaxBytes) {
+      free (buf);
+      return;
+    }
+    std::lock_guard<std::mutex> lock(theirMutex);
+    theirFree.push_back (std::make_pair (size, buf));
+    theirBytes += size;
+    while (theirFree.size() > theirMaxFree  ||  theirBytes > theirMaxBytes) {
+      size_t inx = 0;
+      for (size_t i=1; i<theirFree.size(); ++i) {
+        if (theirFree[i].first < theirFree[inx].first) {
+          inx = i;
+        }
+      }
+      free (theirFree[inx].second);
+      theirBytes -= theirFree[inx].first;
+      theirFree.erase (theirFree.begin() + inx);
+    }
+  }
+  // Free all buffers in the pool.
+  static void clear()
+  {
+    std::lock_guard<std::mutex> lock(theirMutex);
+    for (size_t i=0; i<theirFree.size(); ++i) {
+      free (theirFree[i].second);
+    }
+    theirFree.clear();
+    theirBytes = 0;
+  }
+private:
+  static std::mutex theirMutex;
+  static std::vector<std::pair<size_t,char*>> theirFree;
+  static size_t theirBytes;
+  static const size_t theirMaxFree  = 4;
+  static const size_t theirMaxBytes = 64*1024*1024;
+};
+
+std::mutex BucketFileBufferPool::theirMutex;
+std::vector<std::pair<size_t,char*>> BucketFileBufferPool::theirFree;
+size_t BucketFileBufferPool::theirBytes = 0;
+
+
 BucketFile::BucketFile (const String& fileName,
                         uInt bufSizeFile, Bool mappedFile,
-                        const std::shared_ptr<MultiFileBase>& mfile)
+                        const std::shared_ptr<MultiFileBase>& mfile,
+                        Bool useODirect)
 : name_p         (Path(fileName).expandedName()),
   isWritable_p   (True),
   isMapped_p     (mappedFile),
@@ -63,7 +155,11 @@ BucketFile::BucketFile (const String& fileName,
   file_p         (),
   mappedFile_p   (0),
   bufferedFile_p (0),
-  mfile_p        (mfile)
+  mfile_p        (mfile),
+  useODirect_p   (useODirect),
+  directFd_p     (-1),
+  snapGen_p      (BucketSnapshotLog::generation() - 1),
+  isView_p       (False)
 {
     // Create the file.
     if (mfile_p) {
@@ -71,15 +167,19 @@ BucketFile::BucketFile (const String& fileName,
       isMapped_p = False;
       bufSize_p  = 0;
     } else {
+      // An existing file is overwritten, so save it for a snapshot.
+      preserveAll();
       fd_p   = FiledesIO::create (name_p.chars());
       file_p.reset (new FiledesIO (fd_p, name_p));
     }
     createMapBuf();
+    openDirect();
 }
 
 BucketFile::BucketFile (const String& fileName, Bool isWritable,
                         uInt bufSizeFile, Bool mappedFile,
-                        const std::shared_ptr<MultiFileBase>& mfile)
+                        const std::shared_ptr<MultiFileBase>& mfile,
+                        Bool useODirect)
 : name_p         (Path(fileName).expandedName()),
   isWritable_p   (isWritable),
   isMapped_p     (mappedFile),
@@ -88,7 +188,11 @@ BucketFile::BucketFile (const String& fileName, Bool isWritable,
   file_p         (),
   mappedFile_p   (0),
   bufferedFile_p (0),
-  mfile_p        (mfile)
+  mfile_p        (mfile),
+  useODirect_p   (useODirect),
+  directFd_p     (-1),
+  snapGen_p      (BucketSnapshotLog::generation() - 1),
+  isView_p       (False)
 {
   if (mfile_p) {
     isMapped_p = False;
@@ -106,13 +210,53 @@ std::shared_ptr<ByteIO> BucketFile::makeFilebufIO (uInt bufferSize)
   if (mfile_p) {
     return file_p;
   }
-  return std::make_shared<FilebufIO>(fd_p, bufferSize);
+  std::shared_ptr<ByteIO> file (std::make_shared<FilebufIO>(fd_p, bufferSize));
+  if (isView_p) {
+    return std::make_shared<BucketSnapshotIO>(file, view_p);
+  }
+  if (snapshotLog()) {
+    return std::make_shared<BucketSnapshotIO>(file, snapLog_p);
+  }
+  return file;
+}
+
+BucketSnapshotLog* BucketFile::snapshotLog()
+{
+    // Only look up the log if the registry has changed.
+    if (!mfile_p) {
+        uInt gen = BucketSnapshotLog::generation();
+        if (gen != snapGen_p) {
+            snapLog_p = BucketSnapshotLog::getActive (name_p);
+            snapGen_p = gen;
+        }
+    }
+    return snapLog_p.get();
+}
+
+void BucketFile::preserveAll()
+{
+    if (!mfile_p) {
+        std::shared_ptr<BucketSnapshotLog> log =
+                                   BucketSnapshotLog::getActive (name_p);
+        if (log  &&  File(name_p).exists()) {
+            int fd = FiledesIO::open (name_p.chars(), False);
+            try {
+                FiledesIO file (fd, name_p);
+                log->preserveAll (file);
+            } catch (...) {
+                FiledesIO::close (fd);
+                throw;
+            }
+            FiledesIO::close (fd);
+        }
+    }
 }
 
 
 void BucketFile::close()
 {
     if (file_p) {
+        closeDirect();
         deleteMapBuf();
 	file_p.reset();
         FiledesIO::close (fd_p);
@@ -127,14 +271,90 @@ void BucketFile::open()
       if (mfile_p) {
         file_p.reset (new MFFileIO (mfile_p, name_p,
                                     isWritable_p ? ByteIO::Update : ByteIO::Old));
+      } else if (BucketSnapshotView::get (name_p, view_p)) {
+        // Read the file as it was at the time of the snapshot.
+        isView_p     = True;
+        isMapped_p   = False;
+        bufSize_p    = 0;
+        useODirect_p = False;
+        fd_p   = FiledesIO::open (view_p.baseName.chars(), False);
+        file_p.reset (new BucketSnapshotIO
+                      (std::make_shared<FiledesIO>(fd_p, view_p.baseName),
+                       view_p));
       } else {
         fd_p   = FiledesIO::open (name_p.chars(), isWritable_p);
         file_p.reset (new FiledesIO (fd_p, name_p));
       }
       createMapBuf();
+      openDirect();
     }
 }
 
+void BucketFile::openDirect()
+{
+    closeDirect();
+    // O_DIRECT can only be used for an ordinary unbuffered file.
+    if (useODirect_p  &&  !mfile_p  &&  isCached()) {
+#ifdef HAVE_O_DIRECT
+        // Some file systems (e.g. tmpfs) do not support O_DIRECT and the
+        // open fails. Then the normal file is used.
+        directFd_p = trace2OPEN ((char*)name_p.chars(), O_RDONLY | O_DIRECT);
+        if (directFd_p < 0) {
+            directFd_p = -1;
+        }
+#endif
+    }
+}
+
+void BucketFile::closeDirect()
+{
+    if (directFd_p >= 0) {
+        FiledesIO::close (directFd_p);
+        directFd_p = -1;
+    }
+}
+
+Int64 BucketFile::readDirect (void* buffer, uInt length, Int64 offset)
+{
+    // Read the aligned blocks containing the requested data.
+    // Read directly into the caller's buffer if it is properly aligned.
+    Int64 start = offset / bf_od_align * bf_od_align;
+    Int64 end   = (offset + length + bf_od_align - 1) / bf_od_align * bf_od_align;
+    size_t size = end - start;
+    Bool useBuffer = (start == offset  &&  size == length  &&
+                      size_t(buffer) % bf_od_align == 0);
+    size_t bufSize = size;
+    char* buf = (useBuffer  ?  static_cast<char*>(buffer) :
+                 BucketFileBufferPool::get (bufSize));
+    Int64 nread = ::tracePREAD (directFd_p, buf, size, start);
+    int error = errno;
+    Int64 n = -1;
+    if (nread >= 0) {
+        n = std::max (Int64(0), std::min (nread - (offset - start),
+                                          Int64(length)));
+        if (!useBuffer  &&  n > 0) {
+            memcpy (buffer, buf + (offset - start), n);
+        }
+    }
+    if (!useBuffer) {
+        BucketFileBufferPool::release (buf, bufSize);
+    }
+    // Like the buffered read (see FiledesIO::read), a failed or short
+    // read is an error. EINVAL means that O_DIRECT cannot be used.
+    if (nread < 0  &&  error != EINVAL) {
+        throw AipsError ("BucketFile::read " + name_p +
+                         " - error returned by system call: " +
+                         strerror(error));
+    }
+    if (n >= 0  &&  n < Int64(length)) {
+        throw AipsError ("BucketFile::read - incorrect number of bytes ("
+                         + String::toString(n) + " out of "
+                         + String::toString(length) + ") read for file "
+                         + name_p);
+    }
+    return n;
+}
+
 void BucketFile::createMapBuf()
 {
     deleteMapBuf();
@@ -158,6 +378,7 @@ void BucketFile::deleteMapBuf()
 
 void BucketFile::remove()
 {
+    preserveAll();
     close();
     if (mfile_p) {
       // Remove the file from the MultiFileBase. Note it might not exist yet.
@@ -174,6 +395,10 @@ void BucketFile::remove()
 
 void BucketFile::fsync()
 {
+    // The snapshot log must be on disk before the changed file.
+    if (snapLog_p) {
+        snapLog_p->fsync();
+    }
     file_p->fsync();
 }
 
@@ -200,11 +425,72 @@ void BucketFile::setRW()
 
 uInt BucketFile::read (void* buffer, uInt length)
 {
+  if (directFd_p >= 0) {
+    // Read at the current position and move the file pointer accordingly.
+    Int64 offset = file_p->seek (0, ByteIO::Current);
+    Int64 n = readDirect (buffer, length, offset);
+    if (n >= 0) {
+      file_p->seek (offset + n, ByteIO::Begin);
+      return n;
+    }
+    // O_DIRECT is not supported by the file system; use the normal file.
+    closeDirect();
+  }
   return file_p->read (length, buffer);
 }
 
+const char* BucketFile::readBuffer (char*& buffer, size_t& bufSize,
+                                    uInt length, Int64 offset)
+{
+  if (directFd_p >= 0) {
+    // Read the aligned blocks containing the data into an aligned buffer.
+    Int64 start = offset / bf_od_align * bf_od_align;
+    Int64 end   = (offset + length + bf_od_align - 1) / bf_od_align * bf_od_align;
+    bufSize = end - start;
+    buffer  = BucketFileBufferPool::get (bufSize);
+    Int64 nread = ::tracePREAD (directFd_p, buffer, end - start, start);
+    if (nread >= 0) {
+      if (nread < offset + length - start) {
+        BucketFileBufferPool::release (buffer, bufSize);
+        throw AipsError ("BucketFile: read beyond end of file " + name_p);
+      }
+      return buffer + (offset - start);
+    }
+    BucketFileBufferPool::release (buffer, bufSize);
+    if (errno != EINVAL) {
+      throw AipsError ("BucketFile: read error in file " + name_p +
+                       ": " + strerror(errno));
+    }
+    // O_DIRECT is not supported by the file system; use the normal file.
+    closeDirect();
+  }
+  bufSize = length;
+  buffer  = BucketFileBufferPool::get (bufSize);
+  try {
+    seek (offset);
+    file_p->read (length, buffer);
+  } catch (...) {
+    BucketFileBufferPool::release (buffer, bufSize);
+    throw;
+  }
+  return buffer;
+}
+
+void BucketFile::releaseBuffer (char* buffer, size_t bufSize)
+{
+  BucketFileBufferPool::release (buffer, bufSize);
+}
+
+void BucketFile::clearBufferPool()
+{
+  BucketFileBufferPool::clear();
+}
+
 uInt BucketFile::write (const void* buffer, uInt length)
 {
+  if (snapshotLog()) {
+    snapLog_p->preserve (*file_p, file_p->seek (0, ByteIO::Current), length);
+  }
   file_p->write (length, buffer);
     return length;
 }
@@ -31,6 +31,7 @@
 #include <casacore/casa/IO/ByteIO.h>
 #include <casacore/casa/IO/MMapfdIO.h>
 #include <casacore/casa/IO/FilebufIO.h>
+#include <casacore/casa/IO/BucketSnapshot.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <unistd.h>
 #include <memory>
@@ -77,6 +78,25 @@ class MultiFileBase;
 //       the access using the FilebufIO member.
 // </ul>
 // A MultiFileBase file can only be accessed in the unbuffered way.
+// <p>
+// An unbuffered ordinary file can be read using O_DIRECT (if supported by
+// the OS and the file system) to bypass the kernel's file cache. It is
+// meant for streaming through large files without evicting other data
+// from the cache. The data are read into aligned buffers (taken from a
+// process-wide pool) and copied to the caller's buffer, so reads do not
+// need to be aligned. Writes are still done through the file cache.
+// If the file cannot be opened with O_DIRECT or a direct read fails
+// because it is not supported, the normal file is used silently.
+// <p>
+// An ordinary file takes part in copy-on-write snapshots (see class
+// BucketSnapshotLog). If a snapshot log is active for the file, the
+// original contents of the blocks are saved in the log before they are
+// overwritten by <src>write</src> or by the object made by
+// <src>makeFilebufIO</src>. The same is done before the file is removed
+// or recreated. Writes done through the mapped or buffered file object
+// are not seen, so a snapshotted file should be accessed unbuffered.
+// <br>If a snapshot view is registered for the file name, the file is
+// opened read-only as it was at the time of the snapshot.
 // </synopsis> 
 
 // <motivation>
@@ -110,9 +130,12 @@ public:
     // It can be indicated if a MMapfdIO and/or FilebufIO object must be
     // created for the file. If a MultiFileBase is used, memory-mapped IO
     // cannot be used and mappedFile is ignored.
+    // <br>If useODirect=True, the file is read using O_DIRECT if possible.
+    // It is ignored for a mapped, buffered, or MultiFileBase file.
     explicit BucketFile (const String& fileName,
                          uInt bufSizeFile=0, Bool mappedFile=False,
-                         const std::shared_ptr<MultiFileBase>& mfile=std::shared_ptr<MultiFileBase>());
+                         const std::shared_ptr<MultiFileBase>& mfile=std::shared_ptr<MultiFileBase>(),
+                         Bool useODirect=False);
 
     // Create a BucketFile object for an existing file.
     // The file should be opened by the <src>open</src>.
@@ -122,7 +145,8 @@ public:
     // cannot be used and mappedFile is ignored.
     BucketFile (const String& fileName, Bool writable,
                 uInt bufSizeFile=0, Bool mappedFile=False,
-                         const std::shared_ptr<MultiFileBase>& mfile=std::shared_ptr<MultiFileBase>());
+                         const std::shared_ptr<MultiFileBase>& mfile=std::shared_ptr<MultiFileBase>(),
+                Bool useODirect=False);
 
     // The destructor closes the file (if open).
     virtual ~BucketFile();
@@ -170,6 +194,21 @@ public:
     // Read bytes from the file.
     virtual uInt read (void* buffer, uInt length);
 
+    // Read bytes at the given offset into a buffer taken from the pool of
+    // aligned buffers used for O_DIRECT reads, so the data are not copied.
+    // It returns a pointer to the data in the buffer. Thereafter the
+    // buffer has to be given back using <src>releaseBuffer</src>.
+    // An exception is thrown if not all bytes could be read.
+    const char* readBuffer (char*& buffer, size_t& bufSize,
+                            uInt length, Int64 offset);
+
+    // Give a buffer obtained with <src>readBuffer</src> back to the pool.
+    // The pool keeps at most a few buffers and 64 MB in total.
+    static void releaseBuffer (char* buffer, size_t bufSize);
+
+    // Free all buffers kept in the pool.
+    static void clearBufferPool();
+
     // Write bytes into the file.
     virtual uInt write (const void* buffer, uInt length);
 
@@ -190,6 +229,10 @@ public:
     Bool isBuffered() const;
     // </group>
 
+    // Is the file read using O_DIRECT?
+    // It is False if O_DIRECT was not asked for or is not supported.
+    Bool isDirect() const;
+
 private:
     // The file name.
     String name_p;
@@ -206,11 +249,40 @@ private:
     FilebufIO* bufferedFile_p;
     // The possibly used MultiFileBase.
     std::shared_ptr<MultiFileBase> mfile_p;
-	    
+    // Should O_DIRECT be used for reading?
+    Bool useODirect_p;
+    // The fd (if used) of the file opened with O_DIRECT.
+    int  directFd_p;
+    // The active snapshot log (if any) and the registry generation
+    // it was looked up for.
+    std::shared_ptr<BucketSnapshotLog> snapLog_p;
+    uInt snapGen_p;
+    // Is the file a view on a snapshot?
+    Bool isView_p;
+    BucketSnapshotView view_p;
+
+    // Get the active snapshot log of the file. It returns a null pointer
+    // if there is none.
+    BucketSnapshotLog* snapshotLog();
+
+    // Save the entire file in the active snapshot log (if any).
+    void preserveAll();
 
     // Create the mapped or buffered file object.
     void createMapBuf();
 
+    // Open the file with O_DIRECT for reading (if asked for and possible).
+    void openDirect();
+
+    // Close the O_DIRECT file.
+    void closeDirect();
+
+    // Read using O_DIRECT at the given offset.
+    // It returns -1 if O_DIRECT reads are not supported for the file.
+    // Like a buffered read, it throws an exception if the read fails
+    // or if fewer bytes than requested could be read.
+    Int64 readDirect (void* buffer, uInt length, Int64 offset);
+
     // Delete the possible mapped or buffered file object.
     void deleteMapBuf();
 };
@@ -231,6 +303,8 @@ inline Bool BucketFile::isMapped() const
     { return isMapped_p; }
 inline Bool BucketFile::isBuffered() const
     { return bufSize_p>0; }
+inline Bool BucketFile::isDirect() const
+    { return directFd_p >= 0; }
 
 
 } //# NAMESPACE CASACORE - END
@@ -0,0 +1,408 @@
+//# BucketSnapshot.cc: Copy-on-write logs for snapshots of bucket files
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/casa/IO/BucketSnapshot.h>
+#include <casacore/casa/IO/FiledesIO.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/Path.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <string.h>
+
+//# The magic value at the start of a log file.
+#define bsl_magic "casaCOW1"
+//# The length of the header of a log file.
+#define bsl_hdrlen 32
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# The registry of open logs, active logs, and views.
+namespace {
+  std::mutex theirRegistryMutex;
+  std::map<String, std::weak_ptr<BucketSnapshotLog>> theirOpenLogs;
+  std::map<String, std::shared_ptr<BucketSnapshotLog>> theirActiveLogs;
+  std::map<String, BucketSnapshotView> theirViews;
+  std::atomic<uInt> theirGeneration (0);
+}
+
+
+BucketSnapshotLog::BucketSnapshotLog (const String& logName, int fd)
+: name_p       (logName),
+  fd_p         (fd),
+  file_p       (new FiledesIO (fd, logName)),
+  fileLength_p (0),
+  blockSize_p  (0),
+  logLength_p  (bsl_hdrlen)
+{}
+
+BucketSnapshotLog::~BucketSnapshotLog()
+{
+  file_p.reset();
+  FiledesIO::close (fd_p);
+}
+
+std::shared_ptr<BucketSnapshotLog> BucketSnapshotLog::create
+                                          (const String& logName,
+                                           const String& fileName,
+                                           uInt blockSize)
+{
+  String name = Path(logName).absoluteName();
+  File file(fileName);
+  Int64 length = (file.exists()  ?  Int64(file.size()) : 0);
+  int fd = FiledesIO::create (name.chars());
+  std::shared_ptr<BucketSnapshotLog> log (new BucketSnapshotLog (name, fd));
+  log->fileLength_p = length;
+  log->blockSize_p  = blockSize;
+  char hdr[bsl_hdrlen];
+  memset (hdr, 0, bsl_hdrlen);
+  memcpy (hdr, bsl_magic, 8);
+  Int64 bs = blockSize;
+  memcpy (hdr+8, &length, 8);
+  memcpy (hdr+16, &bs, 8);
+  log->file_p->pwrite (bsl_hdrlen, 0, hdr);
+  std::lock_guard<std::mutex> lock(theirRegistryMutex);
+  theirOpenLogs[name] = log;
+  return log;
+}
+
+std::shared_ptr<BucketSnapshotLog> BucketSnapshotLog::open
+                                          (const String& logName)
+{
+  String name = Path(logName).absoluteName();
+  std::lock_guard<std::mutex> lock(theirRegistryMutex);
+  auto iter = theirOpenLogs.find (name);
+  if (iter != theirOpenLogs.end()) {
+    std::shared_ptr<BucketSnapshotLog> log = iter->second.lock();
+    if (log) {
+      return log;
+    }
+  }
+  int fd = FiledesIO::open (name.chars(), True);
+  std::shared_ptr<BucketSnapshotLog> log (new BucketSnapshotLog (name, fd));
+  log->readIndex();
+  theirOpenLogs[name] = log;
+  return log;
+}
+
+void BucketSnapshotLog::readIndex()
+{
+  char hdr[bsl_hdrlen];
+  if (file_p->pread (bsl_hdrlen, 0, hdr, False) != bsl_hdrlen  ||
+      memcmp (hdr, bsl_magic, 8) != 0) {
+    throw AipsError ("BucketSnapshotLog: " + name_p +
+                     " is not a snapshot log file");
+  }
+  Int64 bs;
+  memcpy (&fileLength_p, hdr+8, 8);
+  memcpy (&bs, hdr+16, 8);
+  blockSize_p = bs;
+  // Index the blocks. An incomplete last record is ignored.
+  Int64 length = file_p->length();
+  Int64 recLen = 8 + blockSize_p;
+  Int64 offset = bsl_hdrlen;
+  Int64 blockNr;
+  while (offset + recLen <= length) {
+    file_p->pread (8, offset, &blockNr);
+    index_p[blockNr] = offset + 8;
+    offset += recLen;
+  }
+  logLength_p = offset;
+}
+
+void BucketSnapshotLog::preserve (ByteIO& file, Int64 offset, Int64 length)
+{
+  Int64 end = std::min (offset + length, fileLength_p);
+  if (offset >= end) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_p);
+  std::vector<char> buf;
+  for (Int64 bnr = offset / blockSize_p; bnr <= (end-1) / blockSize_p; ++bnr) {
+    if (index_p.find(bnr) == index_p.end()) {
+      if (buf.empty()) {
+        buf.resize (blockSize_p);
+      }
+      Int64 start = bnr * blockSize_p;
+      Int64 size  = std::min (Int64(blockSize_p), fileLength_p - start);
+      Int64 nread = file.pread (size, start, buf.data(), False);
+      memset (buf.data() + std::max(nread, Int64(0)), 0,
+              blockSize_p - std::max(nread, Int64(0)));
+      doAddBlock (bnr, buf.data());
+    }
+  }
+}
+
+Bool BucketSnapshotLog::hasBlock (Int64 blockNr) const
+{
+  std::lock_guard<std::mutex> lock(mutex_p);
+  return index_p.find(blockNr) != index_p.end();
+}
+
+Bool BucketSnapshotLog::readBlock (Int64 blockNr, char* buffer) const
+{
+  Int64 offset;
+  {
+    std::lock_guard<std::mutex> lock(mutex_p);
+    auto iter = index_p.find (blockNr);
+    if (iter == index_p.end()) {
+      return False;
+    }
+    offset = iter->second;
+  }
+  // A saved block never changes, so it can be read without the lock.
+  file_p->pread (blockSize_p, offset, buffer);
+  return True;
+}
+
+void BucketSnapshotLog::addBlock (Int64 blockNr, const char* buffer)
+{
+  if (blockNr < nblocks()) {
+    std::lock_guard<std::mutex> lock(mutex_p);
+    doAddBlock (blockNr, buffer);
+  }
+}
+
+void BucketSnapshotLog::doAddBlock (Int64 blockNr, const char* buffer)
+{
+  if (index_p.find(blockNr) == index_p.end()) {
+    // Write the block number and data in a single call.
+    std::vector<char> rec(8 + blockSize_p);
+    memcpy (rec.data(), &blockNr, 8);
+    memcpy (rec.data() + 8, buffer, blockSize_p);
+    file_p->pwrite (rec.size(), logLength_p, rec.data());
+    index_p[blockNr] = logLength_p + 8;
+    logLength_p += rec.size();
+  }
+}
+
+std::vector<Int64> BucketSnapshotLog::blockNrs() const
+{
+  std::lock_guard<std::mutex> lock(mutex_p);
+  std::vector<Int64> nrs;
+  nrs.reserve (index_p.size());
+  for (const auto& entry : index_p) {
+    nrs.push_back (entry.first);
+  }
+  return nrs;
+}
+
+void BucketSnapshotLog::fsync()
+{
+  file_p->fsync();
+}
+
+void BucketSnapshotLog::setActive (const String& fileName,
+                                   const std::shared_ptr<BucketSnapshotLog>& log)
+{
+  String name = Path(fileName).absoluteName();
+  std::lock_guard<std::mutex> lock(theirRegistryMutex);
+  if (log) {
+    theirActiveLogs[name] = log;
+  } else {
+    theirActiveLogs.erase (name);
+  }
+  theirGeneration++;
+}
+
+std::shared_ptr<BucketSnapshotLog> BucketSnapshotLog::getActive
+                                                  (const String& fileName)
+{
+  String name = Path(fileName).absoluteName();
+  std::lock_guard<std::mutex> lock(theirRegistryMutex);
+  auto iter = theirActiveLogs.find (name);
+  if (iter == theirActiveLogs.end()) {
+    return std::shared_ptr<BucketSnapshotLog>();
+  }
+  return iter->second;
+}
+
+uInt BucketSnapshotLog::generation()
+{
+  return theirGeneration;
+}
+
+
+void BucketSnapshotView::set (const String& viewName,
+                              const BucketSnapshotView& view)
+{
+  String name = Path(viewName).absoluteName();
+  std::lock_guard<std::mutex> lock(theirRegistryMutex);
+  theirViews[name] = view;
+}
+
+Bool BucketSnapshotView::get (const String& viewName,
+                              BucketSnapshotView& view)
+{
+  String name = Path(viewName).absoluteName();
+  std::lock_guard<std::mutex> lock(theirRegistryMutex);
+  auto iter = theirViews.find (name);
+  if (iter == theirViews.end()) {
+    return False;
+  }
+  view = iter->second;
+  return True;
+}
+
+void BucketSnapshotView::remove (const String& prefix)
+{
+  String name = Path(prefix).absoluteName();
+  std::lock_guard<std::mutex> lock(theirRegistryMutex);
+  auto iter = theirViews.lower_bound (name);
+  while (iter != theirViews.end()  &&  iter->first.startsWith (name)) {
+    iter = theirViews.erase (iter);
+  }
+}
+
+
+BucketSnapshotIO::BucketSnapshotIO (const std::shared_ptr<ByteIO>& file,
+                                    const std::shared_ptr<BucketSnapshotLog>& log)
+: file_p   (file),
+  log_p    (log),
+  isView_p (False)
+{}
+
+BucketSnapshotIO::BucketSnapshotIO (const std::shared_ptr<ByteIO>& file,
+                                    const BucketSnapshotView& view)
+: file_p   (file),
+  view_p   (view),
+  isView_p (True)
+{
+  AlwaysAssert (!view.logs.empty(), AipsError);
+}
+
+BucketSnapshotIO::~BucketSnapshotIO()
+{}
+
+void BucketSnapshotIO::write (Int64 size, const void* buf)
+{
+  if (isView_p) {
+    throw AipsError ("BucketSnapshotIO: snapshot of file " + fileName() +
+                     " is not writable");
+  }
+  log_p->preserve (*file_p, file_p->seek (0, ByteIO::Current), size);
+  file_p->write (size, buf);
+}
+
+Int64 BucketSnapshotIO::read (Int64 size, void* buf, Bool throwException)
+{
+  if (!isView_p) {
+    return file_p->read (size, buf, throwException);
+  }
+  // Read the base file and overlay the blocks found in the logs.
+  Int64 offset = file_p->seek (0, ByteIO::Current);
+  Int64 n = std::max (Int64(0), std::min (size, length() - offset));
+  char* cbuf = static_cast<char*>(buf);
+  if (n > 0) {
+    Int64 nread = std::max (Int64(0), file_p->pread (n, offset, cbuf, False));
+    memset (cbuf + nread, 0, n - nread);
+    uInt bs = view_p.logs[0]->blockSize();
+    std::vector<char> block(bs);
+    for (Int64 bnr = offset / bs; bnr <= (offset + n - 1) / bs; ++bnr) {
+      for (const auto& log : view_p.logs) {
+        if (log->readBlock (bnr, block.data())) {
+          Int64 start = std::max (offset, bnr * bs);
+          Int64 end   = std::min (offset + n, (bnr + 1) * bs);
+          memcpy (cbuf + (start - offset), block.data() + (start - bnr*bs),
+                  end - start);
+          break;
+        }
+      }
+    }
+  }
+  file_p->seek (offset + n, ByteIO::Begin);
+  if (n != size  &&  throwException) {
+    throw AipsError ("BucketSnapshotIO::read - incorrect number of bytes ("
+                     + String::toString(n) + " out of "
+                     + String::toString(size) + ") read for file "
+                     + fileName());
+  }
+  return n;
+}
+
+void BucketSnapshotIO::flush()
+{
+  file_p->flush();
+}
+
+void BucketSnapshotIO::fsync()
+{
+  if (log_p) {
+    log_p->fsync();
+  }
+  file_p->fsync();
+}
+
+void BucketSnapshotIO::truncate (Int64 size)
+{
+  if (isView_p) {
+    throw AipsError ("BucketSnapshotIO: snapshot of file " + fileName() +
+                     " is not writable");
+  }
+  log_p->preserve (*file_p, size, log_p->fileLength());
+  file_p->truncate (size);
+}
+
+String BucketSnapshotIO::fileName() const
+{
+  return file_p->fileName();
+}
+
+Int64 BucketSnapshotIO::length()
+{
+  if (isView_p) {
+    return view_p.logs[0]->fileLength();
+  }
+  return file_p->length();
+}
+
+Bool BucketSnapshotIO::isReadable() const
+{
+  return file_p->isReadable();
+}
+
+Bool BucketSnapshotIO::isWritable() const
+{
+  return !isView_p  &&  file_p->isWritable();
+}
+
+Bool BucketSnapshotIO::isSeekable() const
+{
+  return file_p->isSeekable();
+}
+
+Int64 BucketSnapshotIO::doSeek (Int64 offset, ByteIO::SeekOption dir)
+{
+  if (isView_p  &&  dir == ByteIO::End) {
+    return file_p->seek (length() + offset, ByteIO::Begin);
+  }
+  return file_p->seek (offset, dir);
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,297 @@
+//# BucketSnapshot.h: Copy-on-write logs for snapshots of bucket files
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_BUCKETSNAPSHOT_H
+#define CASA_BUCKETSNAPSHOT_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/IO/ByteIO.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+
+// <summary>
+// Copy-on-write log holding the original blocks of a bucket file.
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tTableSnapshot">
+// </reviewed>
+
+// <synopsis>
+// A BucketSnapshotLog holds the contents a file had at the time a snapshot
+// of it was made, but only for the parts of the file that have been
+// changed since then. Before a part of the file is overwritten, the
+// blocks containing it are copied to the log (if not done before).
+// Thus the log is empty when the snapshot is made and only grows
+// with the amount of data changed thereafter.
+// The contents of the file at snapshot time can be obtained by taking
+// a block from the log if it is in there, otherwise from the file.
+// <p>
+// The log file starts with a header containing the length of the file
+// at snapshot time and the block size. It is followed by the saved
+// blocks, each preceded by its block number. The blocks are written
+// in native byte order, because the log is only used together with
+// the file it belongs to. Blocks beyond the original file length are
+// never saved, because they did not exist at snapshot time.
+// <p>
+// The class also contains a process-wide registry telling which log
+// is active for a file, thus in which log the original blocks have to
+// be saved when the file is written. Class BucketFile uses it.
+// Only the log of the latest snapshot of a file needs to be active,
+// because an earlier snapshot finds the blocks changed after the latest
+// snapshot in the later logs (see class BucketSnapshotView).
+// <br>The registry also holds the views on the snapshots of files.
+// A view defines the logs to be used when a file is read as it was
+// at the time of a snapshot.
+// <p>
+// All functions are thread-safe.
+// </synopsis>
+
+// <motivation>
+// Making a checkpoint of a large table by copying it is very expensive.
+// Copy-on-write at the block level makes it cheap.
+// </motivation>
+
+class BucketSnapshotLog
+{
+public:
+  // Create a new (empty) log for the given file.
+  // The current length of the file is taken as the length at snapshot time.
+  // The file does not need to exist, in which case its length is 0.
+  static std::shared_ptr<BucketSnapshotLog> create (const String& logName,
+                                                    const String& fileName,
+                                                    uInt blockSize=16384);
+
+  // Open an existing log. If it is already open in this process,
+  // the same object is returned.
+  static std::shared_ptr<BucketSnapshotLog> open (const String& logName);
+
+  // The destructor closes the log file.
+  ~BucketSnapshotLog();
+
+  // Forbid copy constructor and assignment.
+  // <group>
+  BucketSnapshotLog (const BucketSnapshotLog&) = delete;
+  BucketSnapshotLog& operator= (const BucketSnapshotLog&) = delete;
+  // </group>
+
+  // Get the log file name.
+  const String& name() const
+    { return name_p; }
+
+  // Get the length of the file at snapshot time.
+  Int64 fileLength() const
+    { return fileLength_p; }
+
+  // Get the block size.
+  uInt blockSize() const
+    { return blockSize_p; }
+
+  // Get the number of blocks in the file at snapshot time.
+  Int64 nblocks() const
+    { return (fileLength_p + blockSize_p - 1) / blockSize_p; }
+
+  // Save the blocks of the file overlapping the given byte range that are
+  // not saved yet. It has to be called before the file is written.
+  // The blocks are read from the given file object.
+  void preserve (ByteIO& file, Int64 offset, Int64 length);
+
+  // Save all blocks of the file not saved yet.
+  // It has to be called before the file is truncated or deleted.
+  void preserveAll (ByteIO& file)
+    { preserve (file, 0, fileLength_p); }
+
+  // Is the block saved in the log?
+  Bool hasBlock (Int64 blockNr) const;
+
+  // Read a saved block into the buffer, which must have length blockSize.
+  // It returns False if the block is not saved.
+  // The last block of the file is padded with zeroes.
+  Bool readBlock (Int64 blockNr, char* buffer) const;
+
+  // Save a block if not saved yet (e.g. when merging logs).
+  // The buffer must have length blockSize.
+  void addBlock (Int64 blockNr, const char* buffer);
+
+  // Get the numbers of the saved blocks in ascending order.
+  std::vector<Int64> blockNrs() const;
+
+  // Force the log to be physically written.
+  void fsync();
+
+  // Set the log to be active for the file, so the original blocks are
+  // saved in it when the file is written. An empty pointer removes it.
+  static void setActive (const String& fileName,
+                         const std::shared_ptr<BucketSnapshotLog>& log);
+
+  // Get the active log of the file. An empty pointer is returned if none.
+  static std::shared_ptr<BucketSnapshotLog> getActive (const String& fileName);
+
+  // Get the generation of the registry. It is incremented each time the
+  // registry changes, so a BucketFile only needs to look up its active log
+  // if the generation has changed.
+  static uInt generation();
+
+private:
+  BucketSnapshotLog (const String& logName, int fd);
+
+  // Read the header and the block index from the log file.
+  void readIndex();
+
+  // Save the block if not saved yet. The lock must have been acquired.
+  void doAddBlock (Int64 blockNr, const char* buffer);
+
+  //# Data members.
+  String name_p;
+  int    fd_p;
+  std::unique_ptr<ByteIO> file_p;
+  Int64  fileLength_p;
+  uInt   blockSize_p;
+  Int64  logLength_p;
+  // Map of block number to offset of the block in the log file.
+  std::map<Int64,Int64> index_p;
+  mutable std::mutex mutex_p;
+};
+
+
+
+// <summary>
+// View on a file at the time of a snapshot.
+// </summary>
+
+// <use visibility=local>
+
+// <synopsis>
+// A BucketSnapshotView defines where the contents of a file at snapshot
+// time can be found. The file has to be read as an overlay of the logs
+// of the snapshot and all later snapshots (the first log containing a
+// block wins) on top of the base file, which is the current file or a
+// full copy of it made by a later snapshot.
+// <br>The view is registered under the name of the file in the snapshot,
+// so a BucketFile opened with that name reads it using a BucketSnapshotIO
+// object.
+// </synopsis>
+
+struct BucketSnapshotView
+{
+  // The file containing the blocks not found in the logs.
+  String baseName;
+  // The logs in order of snapshot time (first one is the view's snapshot).
+  std::vector<std::shared_ptr<BucketSnapshotLog>> logs;
+
+  // Register a view under the given (file) name.
+  static void set (const String& viewName, const BucketSnapshotView& view);
+
+  // Get the view registered under the given name.
+  // False is returned if not registered.
+  static Bool get (const String& viewName, BucketSnapshotView& view);
+
+  // Remove the views with names starting with the given prefix.
+  static void remove (const String& prefix);
+};
+
+
+
+// <summary>
+// ByteIO saving or overlaying the blocks of a file in snapshot logs.
+// </summary>
+
+// <use visibility=local>
+
+// <synopsis>
+// A BucketSnapshotIO object wraps the ByteIO object of a file.
+// <ul>
+//  <li> If constructed with a log, the original blocks of the file are
+//       saved in the log before writing into the underlying object.
+//  <li> If constructed with a view, the file is read as it was at the
+//       time of the snapshot. It is read-only and has the length of the
+//       file at that time.
+// </ul>
+// It is used by class BucketFile.
+// </synopsis>
+
+class BucketSnapshotIO : public ByteIO
+{
+public:
+  // Wrap the file object to save the original blocks in the log.
+  BucketSnapshotIO (const std::shared_ptr<ByteIO>& file,
+                    const std::shared_ptr<BucketSnapshotLog>& log);
+
+  // Wrap the base file object to read it through the view.
+  BucketSnapshotIO (const std::shared_ptr<ByteIO>& file,
+                    const BucketSnapshotView& view);
+
+  virtual ~BucketSnapshotIO();
+
+  // Write the buffer at the current position (after saving the blocks).
+  virtual void write (Int64 size, const void* buf);
+
+  // Read into the buffer from the current position.
+  virtual Int64 read (Int64 size, void* buf, Bool throwException=True);
+
+  // Flush, fsync, or truncate the underlying object.
+  // The blocks are saved before truncating.
+  // <group>
+  virtual void flush();
+  virtual void fsync();
+  virtual void truncate (Int64 size);
+  // </group>
+
+  // Get the file name.
+  virtual String fileName() const;
+
+  // Get the length of the file (of the view if a view is used).
+  virtual Int64 length();
+
+  // Get the properties of the underlying object.
+  // The object is not writable if a view is used.
+  // <group>
+  virtual Bool isReadable() const;
+  virtual Bool isWritable() const;
+  virtual Bool isSeekable() const;
+  // </group>
+
+protected:
+  virtual Int64 doSeek (Int64 offset, ByteIO::SeekOption);
+
+private:
+  std::shared_ptr<ByteIO> file_p;
+  std::shared_ptr<BucketSnapshotLog> log_p;
+  BucketSnapshotView view_p;
+  Bool isView_p;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
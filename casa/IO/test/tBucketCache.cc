@@ -38,6 +38,7 @@ void a (Bool);
 void b (Bool);
 void c (uInt bufSize);
 void d (uInt bufSize);
+void e (Bool useODirect);
 
 int main (int argc, const char*[])
 {
@@ -52,6 +53,8 @@ int main (int argc, const char*[])
 //	d (1024);
 //	d (32768);
 //	d (327680);
+	e (False);
+	e (True);
     } catch (std::exception& x) {
 	cout << "Caught an exception: " << x.what() << endl;
 	return 1;
@@ -254,3 +257,43 @@ void d (uInt)
     timer.show();
     cout << "<<<" << endl;
 }
+
+// Prefetch buckets (with or without O_DIRECT) and check them.
+// Note that the buckets start at an offset not aligned for O_DIRECT.
+void e (Bool useODirect)
+{
+    BucketFile file("tBucketCache_tmp.data", False, 0, False,
+                    std::shared_ptr<MultiFileBase>(), useODirect);
+    file.open();
+    Int rec[128];
+    file.read ((char*)rec, 512);
+    BucketCache cache (&file, 512, 32768, rec[0], 20, 0, aToLocal, aFromLocal,
+		       aInitBuffer, aDeleteBuffer);
+    // Bucket 0 is in the cache, so prefetching starts at bucket 1.
+    cache.getBucket(0);
+    if (cache.prefetch (0, 10) != 9) {
+        cout << "Error in nr of prefetched buckets" << endl;
+    }
+    // Prefetching stops at the size of the cache.
+    if (cache.prefetch (10, 100) != 20) {
+        cout << "Error in nr of prefetched buckets" << endl;
+    }
+    for (Int i=0; i<20; i++) {
+	char* buf = cache.getBucket(i+5);
+	if (*(Int*)buf != i+1  ||  *(Int*)(buf+32760) != i+10) {
+	    cout << "Error in prefetched bucket " << i+5 << endl;
+	}
+    }
+    // Reading beyond the end of the file must fail.
+    Bool failed = False;
+    file.seek (file.fileSize() - 100);
+    try {
+        file.read ((char*)rec, 512);
+    } catch (const AipsError&) {
+        failed = True;
+    }
+    if (!failed) {
+        cout << "Short read did not throw an exception" << endl;
+    }
+    BucketFile::clearBufferPool();
+}
@@ -0,0 +1,249 @@
+//# tBucketCacheManager.cc: Test program for class BucketCacheManager
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+
+#include <casacore/casa/IO/BucketCacheManager.h>
+#include <casacore/casa/IO/BucketCache.h>
+#include <casacore/casa/IO/BucketFile.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class BucketCacheManager.
+// </summary>
+
+// The buckets contain the cache number and bucket number in their first
+// and last Int.
+
+const uInt bucketSize = 1024;
+const uInt nbucket = 20;
+
+char* toLocal (void*, const char* data)
+{
+  char* ptr = new char[bucketSize];
+  memcpy (ptr, data, bucketSize);
+  return ptr;
+}
+void fromLocal (void*, char* data, const char* local)
+{
+  memcpy (data, local, bucketSize);
+}
+char* initBuffer (void*)
+{
+  char* ptr = new char[bucketSize];
+  memset (ptr, 0, bucketSize);
+  return ptr;
+}
+void deleteBuffer (void*, char* buffer)
+{
+  delete [] buffer;
+}
+
+void setBucket (char* buf, Int cacheNr, Int bucketNr)
+{
+  memcpy (buf, &cacheNr, sizeof(Int));
+  memcpy (buf + bucketSize - sizeof(Int), &bucketNr, sizeof(Int));
+}
+void checkBucket (const char* buf, Int cacheNr, Int bucketNr)
+{
+  Int v1, v2;
+  memcpy (&v1, buf, sizeof(Int));
+  memcpy (&v2, buf + bucketSize - sizeof(Int), sizeof(Int));
+  AlwaysAssertExit (v1 == cacheNr  &&  v2 == bucketNr);
+}
+
+// A file with its cache.
+struct CachedFile
+{
+  CachedFile (const String& name, uInt cacheSize, Bool create)
+    : file  (create ? new BucketFile(name) : new BucketFile(name, True)),
+      cache (file.get(), 0, bucketSize, create ? 0 : nbucket, cacheSize, 0,
+             toLocal, fromLocal, initBuffer, deleteBuffer)
+  {}
+  std::unique_ptr<BucketFile> file;
+  BucketCache cache;
+};
+
+// Create the files.
+void createFiles (uInt nfile)
+{
+  for (uInt i=0; i<nfile; ++i) {
+    CachedFile cf ("tBucketCacheManager_tmp.data" + String::toString(i),
+                   4, True);
+    for (uInt j=0; j<nbucket; ++j) {
+      char* buf = initBuffer(0);
+      setBucket (buf, i, j);
+      AlwaysAssertExit (cf.cache.addBucket (buf) == j);
+    }
+    cf.cache.flush();
+  }
+  AlwaysAssertExit (BucketCacheManager::memoryUsed() == 0);
+}
+
+std::unique_ptr<CachedFile> openFile (uInt i)
+{
+  return std::unique_ptr<CachedFile>
+    (new CachedFile ("tBucketCacheManager_tmp.data" + String::toString(i),
+                     nbucket, False));
+}
+
+// Read all buckets of a file.
+void readAll (CachedFile& cf, Int cacheNr)
+{
+  for (uInt j=0; j<nbucket; ++j) {
+    checkBucket (cf.cache.getBucket(j), cacheNr, j);
+  }
+}
+
+// Without a maximum all buckets are kept.
+void testUnlimited()
+{
+  BucketCacheManager::setMaxMemory (0);
+  std::unique_ptr<CachedFile> cf0 = openFile(0);
+  std::unique_ptr<CachedFile> cf1 = openFile(1);
+  AlwaysAssertExit (BucketCacheManager::nregistered() == 2);
+  readAll (*cf0, 0);
+  readAll (*cf1, 1);
+  AlwaysAssertExit (BucketCacheManager::memoryUsed() ==
+                    2 * nbucket * bucketSize);
+  cf0.reset();
+  AlwaysAssertExit (BucketCacheManager::memoryUsed() == nbucket * bucketSize);
+  cf1.reset();
+  AlwaysAssertExit (BucketCacheManager::memoryUsed() == 0);
+  AlwaysAssertExit (BucketCacheManager::nregistered() == 0);
+}
+
+// With a maximum the least recently used buckets are removed.
+void testLimited()
+{
+  const uInt maxBuckets = 15;
+  BucketCacheManager::setMaxMemory (maxBuckets * bucketSize);
+  uInt64 nevict = BucketCacheManager::nevicted();
+  std::unique_ptr<CachedFile> cf0 = openFile(0);
+  std::unique_ptr<CachedFile> cf1 = openFile(1);
+  // The first cache cannot hold all its buckets.
+  readAll (*cf0, 0);
+  AlwaysAssertExit (BucketCacheManager::memoryUsed() ==
+                    maxBuckets * bucketSize);
+  AlwaysAssertExit (BucketCacheManager::nevicted() == nevict);
+  readAll (*cf0, 0);
+  // The second cache takes over the memory of the first one.
+  readAll (*cf1, 1);
+  AlwaysAssertExit (BucketCacheManager::memoryUsed() ==
+                    maxBuckets * bucketSize);
+  AlwaysAssertExit (BucketCacheManager::nevicted() > nevict);
+  // The buckets of the first cache can still be read.
+  readAll (*cf0, 0);
+  checkBucket (cf1->cache.getBucket(3), 1, 3);
+  // A changed bucket is not removed by another cache.
+  nevict = BucketCacheManager::nevicted();
+  char* buf = cf1->cache.getBucket(0);
+  setBucket (buf, 11, 0);
+  cf1->cache.setDirty();
+  checkBucket (cf1->cache.getBucket(1), 1, 1);
+  readAll (*cf0, 0);
+  readAll (*cf0, 0);
+  AlwaysAssertExit (BucketCacheManager::nevicted() > nevict);
+  checkBucket (cf1->cache.getBucket(0), 11, 0);
+  setBucket (cf1->cache.getBucket(0), 1, 0);
+  cf1->cache.setDirty();
+  cf1->cache.flush();
+  AlwaysAssertExit (BucketCacheManager::memoryUsed() <=
+                    maxBuckets * bucketSize);
+  cf0.reset();
+  cf1.reset();
+  AlwaysAssertExit (BucketCacheManager::memoryUsed() == 0);
+  BucketCacheManager::setMaxMemory (0);
+}
+
+// A cache used before the maximum was set takes part from its next access.
+void testJoin()
+{
+  const uInt maxBuckets = 15;
+  BucketCacheManager::setMaxMemory (0);
+  std::unique_ptr<CachedFile> cf0 = openFile(0);
+  readAll (*cf0, 0);
+  BucketCacheManager::setMaxMemory (maxBuckets * bucketSize);
+  // Its buckets are counted when it joins.
+  checkBucket (cf0->cache.getBucket(0), 0, 0);
+  AlwaysAssertExit (BucketCacheManager::memoryUsed() == nbucket * bucketSize);
+  // Another cache can remove them.
+  uInt64 nevict = BucketCacheManager::nevicted();
+  std::unique_ptr<CachedFile> cf1 = openFile(1);
+  readAll (*cf1, 1);
+  AlwaysAssertExit (BucketCacheManager::nevicted() > nevict);
+  AlwaysAssertExit (BucketCacheManager::memoryUsed() <=
+                    maxBuckets * bucketSize);
+  readAll (*cf0, 0);
+  cf0.reset();
+  cf1.reset();
+  AlwaysAssertExit (BucketCacheManager::memoryUsed() == 0);
+  BucketCacheManager::setMaxMemory (0);
+}
+
+// Read different files in parallel with a maximum.
+void readThread (uInt i)
+{
+  std::unique_ptr<CachedFile> cf = openFile(i);
+  for (uInt k=0; k<20; ++k) {
+    readAll (*cf, i);
+  }
+}
+
+void testParallel (uInt nfile)
+{
+  BucketCacheManager::setMaxMemory (nbucket * bucketSize);
+  std::vector<std::thread> threads;
+  for (uInt i=0; i<nfile; ++i) {
+    threads.push_back (std::thread (readThread, i));
+  }
+  for (uInt i=0; i<nfile; ++i) {
+    threads[i].join();
+  }
+  AlwaysAssertExit (BucketCacheManager::memoryUsed() == 0);
+  BucketCacheManager::setMaxMemory (0);
+}
+
+int main()
+{
+  try {
+    createFiles (4);
+    testUnlimited();
+    testLimited();
+    testJoin();
+    testParallel (4);
+  } catch (std::exception& x) {
+    cout << "Caught an exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;                           // exit with success status
+}
@@ -32,6 +32,8 @@
 #include <casacore/casa/Json/JsonOut.h>
 #include <casacore/casa/Json/JsonValue.h>
 #include <casacore/casa/Json/JsonParser.h>
+#include <casacore/casa/Json/JsonStreamParser.h>
+#include <casacore/casa/Json/JsonRecordBuilder.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -61,6 +63,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //   <li> <linkto class=JsonOut>JsonKVMap</linkto>
 //    to obtain the results from a parsed JSON file. It is possible to
 //    obtain a (possible nested) sequence as an Array object.
+//   <li> <linkto class=JsonStreamParser>JsonStreamParser</linkto>
+//    to parse a JSON file in a single pass, calling a
+//    <linkto class=JsonHandler>JsonHandler</linkto> for each element.
+//    It is much faster than JsonParser for large files.
+//   <li> <linkto class=JsonRecordBuilder>JsonRecordBuilder</linkto>
+//    to fill a Record directly while parsing with JsonStreamParser.
 // </ul>
 // </synopsis>
 
@@ -35,6 +35,9 @@
 #include <sstream>
 #include <iomanip>
 #include <ctype.h>    //# for iscntrl
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -62,7 +65,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
                        const String& indent)
   {
     AlwaysAssert (itsLevel==0, JsonError);
-    itsStream << '{' << endl;
+    itsStream << "{\n";
     itsIndent       = indent;
     itsIndentStep   = indent;
     itsCommentStart = commentStart;
@@ -85,7 +88,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     AlwaysAssert (itsLevel>0, JsonError);
     writeComment (comment);
     putName (name);
-    itsStream << '{' << endl;
+    itsStream << "{\n";
     itsIndent += itsIndentStep;
     itsLevel++;
     itsFirstName.resize (itsLevel);
@@ -97,7 +100,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsLevel--;
     AlwaysAssert (itsLevel>0, JsonError);
     itsIndent = itsIndent.substr (0, itsIndent.size() - itsIndentStep.size());
-    itsStream << itsIndent << '}' << endl;
+    itsStream << itsIndent << "}\n";
   }
 
   void JsonOut::writeKV (const String& name, const ValueHolder& vh)
@@ -176,7 +179,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       if (!itsCommentEnd.empty()) {
         itsStream << itsCommentEnd;
       }
-      itsStream << endl;
+      itsStream << '\n';
     } 
  }
 
@@ -266,13 +269,73 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     itsStream << '}';
   }
   void JsonOut::put (const char* value)
-    { itsStream << '"' << escapeString(value) << '"'; }
+    { putEscaped (value, strlen(value)); }
   void JsonOut::put (const String& value)
-    { itsStream << '"' << escapeString(value) << '"'; }
+    { putEscaped (value.data(), value.size()); }
+
+  void JsonOut::putEscaped (const char* value, size_t size)
+  {
+    itsStream << '"';
+    // Write unescaped parts in one go.
+    const char* start = value;
+    const char* end   = value + size;
+    for (const char* p=value; p<end; ++p) {
+      const char* esc = 0;
+      switch (*p) {
+      case '\b':
+        esc = "\\b";
+        break;
+      case '\f':
+        esc = "\\f";
+        break;
+      case '\n':
+        esc = "\\n";
+        break;
+      case '\r':
+        esc = "\\r";
+        break;
+      case '\t':
+        esc = "\\t";
+        break;
+      case '"':
+        esc = "\\\"";
+        break;
+      case '\\':
+        esc = "\\\\";
+        break;
+      default:
+        if (! iscntrl(static_cast<unsigned char>(*p))) {
+          continue;
+        }
+      }
+      itsStream.write (start, p - start);
+      start = p+1;
+      if (esc) {
+        itsStream << esc;
+      } else {
+        char buf[8];
+        snprintf (buf, sizeof(buf), "\\u%04X", static_cast<int>(*p));
+        itsStream << buf;
+      }
+    }
+    itsStream.write (start, end - start);
+    itsStream << '"';
+  }
+
+  void JsonOut::putIndent (const String& indent, uInt extra)
+  {
+    static const char spaces[] = "                                ";
+    itsStream << indent;
+    while (extra > 0) {
+      uInt n = std::min (extra, uInt(sizeof(spaces) - 1));
+      itsStream.write (spaces, n);
+      extra -= n;
+    }
+  }
 
   void JsonOut::put (const Record& rec)
   {
-    itsStream << '{' << endl;
+    itsStream << "{\n";
     String oldIndent(itsIndent);
     itsIndent += itsIndentStep;
     itsLevel++;
@@ -78,6 +78,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // The output is formatted pretty nicely. Nested structs are indented with
   // 2 spaces. Arrays are written with a single axis per line; continuation
   // lines are indented properly. String arrays have one value per line.
+  // Array values are streamed directly from the array data (without
+  // creating temporary arrays or strings), so large arrays can be written
+  // efficiently. The stream is flushed only when the outer struct is ended.
   // </synopsis>
 
   // <example>
@@ -215,6 +218,23 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // Write a key and valueholder.
     void writeKV (const String& name, const ValueHolder& vh);
 
+    // Write the values of an array axis as a sequence, where the values
+    // are obtained from the iterator (a pointer for a contiguous array).
+    // For higher axes it recurses for each index of the axis.
+    // The indentation of continuation lines is <src>indent</src> followed
+    // by <src>extra</src> spaces, so no strings need to be built.
+    template <typename ITER>
+    void putArrayAxis (ITER& iter, const IPosition& shape, Int axis,
+                       const String& indent, uInt extra,
+                       Bool firstLine, Bool valueEndl);
+
+    // Write the indentation followed by the given number of spaces.
+    void putIndent (const String& indent, uInt extra);
+
+    // Write a string enclosed in quotes, escaping special characters
+    // while writing.
+    void putEscaped (const char* value, size_t size);
+
     // Put a Record which is written as a {} structure.
     // The Record can be nested.
     void put (const Record&);
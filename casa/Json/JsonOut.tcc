@@ -39,7 +39,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     writeComment (comment);
     putName (name);
     writeKV (name, value);
-    itsStream << endl;
+    itsStream << '\n';
   }
 
   template <typename T>
@@ -75,36 +75,48 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   void JsonOut::putArray (const Array<T>& arr, const String& indent,
                           Bool firstLine, Bool valueEndl)
   {
-    if (!firstLine) itsStream << indent;
+    // The values are written in storage order, so the innermost
+    // (first) axis is written as the innermost sequence.
+    // A contiguous array is accessed using a plain pointer.
+    Int axis = std::max (Int(arr.ndim()) - 1, 0);
+    if (arr.contiguousStorage()) {
+      const T* data = arr.data();
+      putArrayAxis (data, arr.shape(), axis, indent, 0, firstLine, valueEndl);
+    } else {
+      typename Array<T>::const_iterator iter = arr.begin();
+      putArrayAxis (iter, arr.shape(), axis, indent, 0, firstLine, valueEndl);
+    }
+  }
+
+  template <typename ITER>
+  void JsonOut::putArrayAxis (ITER& iter, const IPosition& shape, Int axis,
+                              const String& indent, uInt extra,
+                              Bool firstLine, Bool valueEndl)
+  {
+    if (!firstLine) {
+      putIndent (indent, extra);
+    }
     itsStream << '[';
-    Bool first = True;
-    if (arr.ndim() <= 1) {
-      size_t todo = arr.size();
-      typename Array<T>::const_iterator iterEnd = arr.end();
-      for (typename Array<T>::const_iterator iter=arr.begin();
-           iter!=iterEnd; ++iter) {
-        if (first) {
-          first = False;
-        } else if (!valueEndl) {
-          itsStream << ", ";
-        } else {
-          itsStream << indent << ' ';
+    ssize_t n = (shape.empty()  ?  0 : shape[axis]);
+    if (axis == 0) {
+      for (ssize_t i=0; i<n; ++i) {
+        if (i > 0) {
+          if (valueEndl) {
+            itsStream << ",\n";
+            putIndent (indent, extra+1);
+          } else {
+            itsStream << ", ";
+          }
         }
         put (*iter);
-        todo--;
-        if (valueEndl  &&  todo > 0) {
-          itsStream << ',' << endl;
-        }
+        ++iter;
       }
     } else {
-      ArrayIterator<T> iter(arr, IPosition(1, arr.ndim()-1), False);
-      while (! iter.pastEnd()) {
-        if (!first) {
-          itsStream << ',' << endl;
+      for (ssize_t i=0; i<n; ++i) {
+        if (i > 0) {
+          itsStream << ",\n";
         }
-        putArray (iter.array(), indent+' ', first);
-        first = False;
-        iter.next();
+        putArrayAxis (iter, shape, axis-1, indent, extra+1, i==0, valueEndl);
       }
     }
     itsStream << ']';
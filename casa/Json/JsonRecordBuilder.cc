@@ -0,0 +1,288 @@
+//# JsonRecordBuilder.cc: Fill a Record from the events of a JsonStreamParser
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/casa/Json/JsonRecordBuilder.h>
+#include <casacore/casa/Json/JsonError.h>
+#include <casacore/casa/Arrays/Array.h>
+#include <casacore/casa/BasicMath/Math.h>
+
+namespace casacore {
+
+  JsonRecordBuilder::JsonRecordBuilder()
+    : itsDepth      (0),
+      itsMaxDepth   (0),
+      itsValueDepth (0),
+      itsType       (TpOther)
+  {}
+
+  JsonRecordBuilder::~JsonRecordBuilder()
+  {}
+
+  Record& JsonRecordBuilder::current()
+  {
+    if (itsStack.empty()) {
+      throw JsonError ("JsonRecordBuilder: value outside a struct");
+    }
+    return *itsStack.back();
+  }
+
+  void JsonRecordBuilder::startObject()
+  {
+    if (itsDepth > 0) {
+      throw JsonError ("JsonRecordBuilder: a sequence cannot contain a "
+                       "struct (field " + itsKey + ')');
+    }
+    if (itsStack.empty()) {
+      itsStack.push_back (&itsRecord);
+    } else {
+      // Fill the subrecord in place.
+      Record& parent = current();
+      parent.defineRecord (itsKey, Record());
+      itsStack.push_back (&parent.rwSubRecord (itsKey));
+    }
+  }
+
+  void JsonRecordBuilder::endObject()
+  {
+    itsStack.pop_back();
+  }
+
+  void JsonRecordBuilder::key (const char* name, size_t size)
+  {
+    itsKey.assign (name, size);
+  }
+
+  void JsonRecordBuilder::startArray()
+  {
+    if (itsDepth == 0) {
+      itsMaxDepth   = 0;
+      itsValueDepth = 0;
+      itsType       = TpOther;
+      itsShape.clear();
+    } else {
+      addArrayValue();
+    }
+    itsDepth++;
+    if (itsDepth > itsMaxDepth) {
+      if (itsValueDepth > 0) {
+        throw JsonError ("JsonRecordBuilder: sequence " + itsKey +
+                         " contains scalars and sequences");
+      }
+      itsMaxDepth = itsDepth;
+      itsCount.resize (itsDepth);
+      itsShape.push_back (-1);
+    }
+    itsCount[itsDepth-1] = 0;
+  }
+
+  void JsonRecordBuilder::endArray()
+  {
+    Int64& len = itsShape[itsDepth-1];
+    if (len < 0) {
+      len = itsCount[itsDepth-1];
+    } else if (len != itsCount[itsDepth-1]) {
+      throw JsonError ("JsonRecordBuilder: irregular nested sequence "
+                       "lengths in " + itsKey);
+    }
+    itsDepth--;
+    if (itsDepth == 0) {
+      defineArray();
+    }
+  }
+
+  void JsonRecordBuilder::addArrayValue()
+  {
+    itsCount[itsDepth-1]++;
+  }
+
+  void JsonRecordBuilder::setArrayType (DataType type)
+  {
+    // Set the depth of the scalar values and check it is the innermost.
+    if (itsValueDepth == 0) {
+      itsValueDepth = itsDepth;
+    }
+    if (itsDepth != itsValueDepth  ||  itsDepth != itsMaxDepth) {
+      throw JsonError ("JsonRecordBuilder: sequence " + itsKey +
+                       " contains scalars and sequences");
+    }
+    addArrayValue();
+    if (type == itsType) {
+      return;
+    }
+    if (itsType == TpOther) {
+      itsType = type;
+      return;
+    }
+    if (type == TpBool  ||  type == TpString  ||
+        itsType == TpBool  ||  itsType == TpString) {
+      throw JsonError ("JsonRecordBuilder: sequence " + itsKey +
+                       " has mixed data types");
+    }
+    // Promote the collected values to the higher numeric type.
+    if (type == TpDComplex  &&  itsType != TpDComplex) {
+      if (itsType == TpInt64) {
+        itsComplexes.assign (itsInts.begin(), itsInts.end());
+        itsInts.clear();
+      } else {
+        itsComplexes.assign (itsDoubles.begin(), itsDoubles.end());
+        itsDoubles.clear();
+      }
+      itsType = TpDComplex;
+    } else if (type == TpDouble  &&  itsType == TpInt64) {
+      itsDoubles.assign (itsInts.begin(), itsInts.end());
+      itsInts.clear();
+      itsType = TpDouble;
+    }
+  }
+
+  void JsonRecordBuilder::nullValue()
+  {
+    if (itsDepth == 0) {
+      current().define (itsKey, doubleNaN());
+    } else {
+      setArrayType (itsType == TpOther || itsType == TpInt64 ?
+                    TpDouble : itsType);
+      if (itsType == TpDComplex) {
+        itsComplexes.push_back (DComplex(doubleNaN(), doubleNaN()));
+      } else if (itsType == TpDouble) {
+        itsDoubles.push_back (doubleNaN());
+      } else {
+        throw JsonError ("JsonRecordBuilder: sequence " + itsKey +
+                         " contains a null value");
+      }
+    }
+  }
+
+  void JsonRecordBuilder::boolValue (Bool value)
+  {
+    if (itsDepth == 0) {
+      current().define (itsKey, value);
+    } else {
+      setArrayType (TpBool);
+      itsBools.push_back (value);
+    }
+  }
+
+  void JsonRecordBuilder::intValue (Int64 value)
+  {
+    if (itsDepth == 0) {
+      current().define (itsKey, value);
+    } else {
+      setArrayType (itsType == TpOther  ?  TpInt64 : itsType);
+      switch (itsType) {
+      case TpInt64:
+        itsInts.push_back (value);
+        break;
+      case TpDouble:
+        itsDoubles.push_back (Double(value));
+        break;
+      case TpDComplex:
+        itsComplexes.push_back (DComplex(Double(value), 0.));
+        break;
+      default:
+        throw JsonError ("JsonRecordBuilder: sequence " + itsKey +
+                         " has mixed data types");
+      }
+    }
+  }
+
+  void JsonRecordBuilder::doubleValue (Double value)
+  {
+    if (itsDepth == 0) {
+      current().define (itsKey, value);
+    } else {
+      setArrayType (itsType == TpDComplex  ?  TpDComplex : TpDouble);
+      if (itsType == TpDComplex) {
+        itsComplexes.push_back (DComplex(value, 0.));
+      } else {
+        itsDoubles.push_back (value);
+      }
+    }
+  }
+
+  void JsonRecordBuilder::complexValue (const DComplex& value)
+  {
+    if (itsDepth == 0) {
+      current().define (itsKey, value);
+    } else {
+      setArrayType (TpDComplex);
+      itsComplexes.push_back (value);
+    }
+  }
+
+  void JsonRecordBuilder::stringValue (const char* value, size_t size)
+  {
+    if (itsDepth == 0) {
+      current().define (itsKey, String(value, size));
+    } else {
+      setArrayType (TpString);
+      itsStrings.push_back (String(value, size));
+    }
+  }
+
+  void JsonRecordBuilder::defineArray()
+  {
+    // The innermost sequence is the first axis.
+    IPosition shape(itsMaxDepth);
+    for (uInt i=0; i<itsMaxDepth; ++i) {
+      shape[i] = itsShape[itsMaxDepth-1-i];
+    }
+    // The buffers are shared by the temporary Array, so the values
+    // are copied only once (into the record).
+    Record& rec = current();
+    switch (itsType) {
+    case TpBool:
+      {
+        // std::vector<Bool> has no data(), so copy one by one.
+        Array<Bool> arr(shape);
+        std::copy (itsBools.begin(), itsBools.end(), arr.data());
+        rec.define (itsKey, arr);
+        itsBools.clear();
+      }
+      break;
+    case TpInt64:
+      rec.define (itsKey, Array<Int64>(shape, itsInts.data(), SHARE));
+      itsInts.clear();
+      break;
+    case TpDouble:
+      rec.define (itsKey, Array<Double>(shape, itsDoubles.data(), SHARE));
+      itsDoubles.clear();
+      break;
+    case TpDComplex:
+      rec.define (itsKey, Array<DComplex>(shape, itsComplexes.data(), SHARE));
+      itsComplexes.clear();
+      break;
+    case TpString:
+      rec.define (itsKey, Array<String>(shape, itsStrings.data(), SHARE));
+      itsStrings.clear();
+      break;
+    default:
+      // A sequence without values.
+      rec.define (itsKey, Array<Int>(shape));
+    }
+  }
+
+} // end namespace
@@ -0,0 +1,132 @@
+//# JsonRecordBuilder.h: Fill a Record from the events of a JsonStreamParser
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_JSONRECORDBUILDER_H
+#define CASA_JSONRECORDBUILDER_H
+
+//# Includes
+#include <casacore/casa/Json/JsonStreamParser.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Utilities/DataType.h>
+#include <vector>
+
+namespace casacore {
+
+  // <summary>
+  // Fill a Record from the events of a JsonStreamParser.
+  // </summary>
+
+  // <use visibility=export>
+  // <reviewed reviewer="" date="" tests="tJsonStreamParser">
+  // </reviewed>
+
+  // <synopsis>
+  // JsonRecordBuilder is a <linkto class=JsonHandler>JsonHandler</linkto>
+  // that fills a Record directly from the parsed JSON elements, thus
+  // without creating JsonValue objects. The values are converted like
+  // JsonKVMap::toRecord does:
+  // <ul>
+  //  <li> A bool, integer, floating point, complex or string value is
+  //       stored as Bool, Int64, Double, DComplex or String.
+  //  <li> A null value is stored as a Double NaN (the opposite of JsonOut
+  //       which writes a NaN as null).
+  //  <li> A struct is stored as a subrecord.
+  //  <li> A (nested) sequence is stored as an Array. Nested sequences
+  //       must have equal lengths; the innermost sequence is the first axis
+  //       (like JsonOut writes an Array). The data type of the Array is the
+  //       'highest' type of the values (Int64, Double, DComplex); a null
+  //       value is stored as NaN. Bool and String values cannot be mixed
+  //       with other types. A sequence without values is stored as an
+  //       empty Int array.
+  // </ul>
+  // A JsonError exception is thrown if a sequence contains a struct, has
+  // mixed types, or has irregular nested lengths.
+  // <br>The values of a sequence are collected in buffers which are
+  // reused, so filling many arrays does not reallocate them.
+  // </synopsis>
+
+  class JsonRecordBuilder : public JsonHandler
+  {
+  public:
+    JsonRecordBuilder();
+
+    ~JsonRecordBuilder();
+
+    // Get the resulting record.
+    const Record& record() const
+      { return itsRecord; }
+
+    // The callback functions.
+    // <group>
+    virtual void startObject();
+    virtual void endObject();
+    virtual void key (const char* name, size_t size);
+    virtual void startArray();
+    virtual void endArray();
+    virtual void nullValue();
+    virtual void boolValue (Bool value);
+    virtual void intValue (Int64 value);
+    virtual void doubleValue (Double value);
+    virtual void complexValue (const DComplex& value);
+    virtual void stringValue (const char* value, size_t size);
+    // </group>
+
+  private:
+    // Get the current record to define a field in.
+    // It throws an exception if not inside a struct.
+    Record& current();
+
+    // Count a value in the current sequence and check the nesting.
+    void addArrayValue();
+
+    // Set the data type of the sequence values, converting the values
+    // collected so far if needed.
+    void setArrayType (DataType type);
+
+    // Define the field for the collected sequence.
+    void defineArray();
+
+    //# The resulting record and the stack of (sub)records being filled.
+    Record               itsRecord;
+    std::vector<Record*> itsStack;
+    //# The current field name.
+    String               itsKey;
+    //# The state of the sequence being collected.
+    uInt                 itsDepth;
+    uInt                 itsMaxDepth;
+    uInt                 itsValueDepth;
+    std::vector<Int64>   itsCount;
+    std::vector<Int64>   itsShape;
+    DataType             itsType;
+    std::vector<Bool>    itsBools;
+    std::vector<Int64>   itsInts;
+    std::vector<Double>  itsDoubles;
+    std::vector<DComplex> itsComplexes;
+    std::vector<String>  itsStrings;
+  };
+
+} // end namespace
+
+#endif
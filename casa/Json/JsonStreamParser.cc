@@ -0,0 +1,490 @@
+//# JsonStreamParser.cc: Event-based parser of JSON text
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/casa/Json/JsonStreamParser.h>
+#include <casacore/casa/Json/JsonRecordBuilder.h>
+#include <casacore/casa/Json/JsonError.h>
+#include <casacore/casa/Containers/Record.h>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <ctype.h>
+#include <limits>
+
+namespace casacore {
+
+  // The maximum nesting depth (to avoid stack overflow).
+  static const uInt theirMaxDepth = 1000;
+
+  // Convert the JSON number of the given length to a double.
+  static Double numberToDouble (const char* str, size_t size)
+  {
+    // strtod needs a terminated string and should not parse beyond
+    // the JSON number (e.g. as hex), so copy it.
+    char buf[64];
+    if (size < sizeof(buf)) {
+      memcpy (buf, str, size);
+      buf[size] = 0;
+      return strtod (buf, 0);
+    }
+    return strtod (std::string(str, size).c_str(), 0);
+  }
+
+  static inline Bool isDigit (char ch)
+  {
+    return ch >= '0'  &&  ch <= '9';
+  }
+
+  static inline Bool isWhite (char ch)
+  {
+    return ch == ' '  ||  ch == '\t'  ||  ch == '\n'  ||  ch == '\r'  ||
+           ch == '\f';
+  }
+
+
+  JsonHandler::~JsonHandler()
+  {}
+
+
+  JsonStreamParser::JsonStreamParser (const char* text, size_t size,
+                                      JsonHandler& handler)
+    : itsStart   (text),
+      itsPos     (text),
+      itsEnd     (text + size),
+      itsHandler (handler)
+  {}
+
+  void JsonStreamParser::parse (const char* text, size_t size,
+                                JsonHandler& handler)
+  {
+    JsonStreamParser parser(text, size, handler);
+    parser.parseDocument();
+  }
+
+  void JsonStreamParser::parse (const String& text, JsonHandler& handler)
+  {
+    parse (text.data(), text.size(), handler);
+  }
+
+  void JsonStreamParser::parseFile (const String& fileName,
+                                    JsonHandler& handler)
+  {
+    std::ifstream ifs (fileName.c_str(), std::ios::in | std::ios::binary);
+    if (! ifs) {
+      throw JsonError ("JsonStreamParser: could not open file " + fileName);
+    }
+    // Read the entire file in one go.
+    ifs.seekg (0, std::ios::end);
+    std::string text (size_t(ifs.tellg()), ' ');
+    ifs.seekg (0, std::ios::beg);
+    ifs.read (&text[0], text.size());
+    parse (text.data(), text.size(), handler);
+  }
+
+  Record JsonStreamParser::toRecord (const String& text)
+  {
+    JsonRecordBuilder builder;
+    parse (text, builder);
+    return builder.record();
+  }
+
+  Record JsonStreamParser::fileToRecord (const String& fileName)
+  {
+    JsonRecordBuilder builder;
+    parseFile (fileName, builder);
+    return builder.record();
+  }
+
+  void JsonStreamParser::parseDocument()
+  {
+    skipWhite();
+    if (itsPos == itsEnd  ||  *itsPos != '{') {
+      error ("the JSON text must start with {");
+    }
+    parseObject (0);
+    skipWhite();
+    if (itsPos != itsEnd) {
+      error ("unexpected text after the end of the outer struct");
+    }
+  }
+
+  void JsonStreamParser::parseValue (uInt depth)
+  {
+    if (depth > theirMaxDepth) {
+      error ("too deeply nested");
+    }
+    if (itsPos == itsEnd) {
+      error ("unexpected end of text");
+    }
+    switch (*itsPos) {
+    case '{':
+      if (! parseComplex()) {
+        parseObject (depth);
+      }
+      break;
+    case '[':
+      parseArray (depth);
+      break;
+    case '"':
+      parseString();
+      itsHandler.stringValue (itsBuffer.data(), itsBuffer.size());
+      break;
+    case 't':
+      skipLiteral ("true", 4);
+      itsHandler.boolValue (True);
+      break;
+    case 'f':
+      skipLiteral ("false", 5);
+      itsHandler.boolValue (False);
+      break;
+    case 'n':
+      skipLiteral ("null", 4);
+      itsHandler.nullValue();
+      break;
+    default:
+      parseNumber();
+    }
+  }
+
+  void JsonStreamParser::parseObject (uInt depth)
+  {
+    ++itsPos;                       // skip {
+    itsHandler.startObject();
+    skipWhite();
+    if (itsPos < itsEnd  &&  *itsPos == '}') {
+      ++itsPos;
+      itsHandler.endObject();
+      return;
+    }
+    while (True) {
+      if (itsPos == itsEnd  ||  *itsPos != '"') {
+        error ("expected a field name");
+      }
+      parseString();
+      itsHandler.key (itsBuffer.data(), itsBuffer.size());
+      skipWhite();
+      if (itsPos == itsEnd  ||  *itsPos != ':') {
+        error ("expected : after field name");
+      }
+      ++itsPos;
+      skipWhite();
+      parseValue (depth+1);
+      skipWhite();
+      if (itsPos < itsEnd  &&  *itsPos == ',') {
+        ++itsPos;
+        skipWhite();
+      } else if (itsPos < itsEnd  &&  *itsPos == '}') {
+        ++itsPos;
+        break;
+      } else {
+        error ("expected , or } in struct");
+      }
+    }
+    itsHandler.endObject();
+  }
+
+  void JsonStreamParser::parseArray (uInt depth)
+  {
+    ++itsPos;                       // skip [
+    itsHandler.startArray();
+    skipWhite();
+    if (itsPos < itsEnd  &&  *itsPos == ']') {
+      ++itsPos;
+      itsHandler.endArray();
+      return;
+    }
+    while (True) {
+      parseValue (depth+1);
+      skipWhite();
+      if (itsPos < itsEnd  &&  *itsPos == ',') {
+        ++itsPos;
+        skipWhite();
+      } else if (itsPos < itsEnd  &&  *itsPos == ']') {
+        ++itsPos;
+        break;
+      } else {
+        error ("expected , or ] in sequence");
+      }
+    }
+    itsHandler.endArray();
+  }
+
+  size_t JsonStreamParser::scanNumber (Bool& isInt) const
+  {
+    // JSON is very strict on number representation; see json.org
+    const char* p = itsPos;
+    isInt = True;
+    if (p < itsEnd  &&  *p == '-') ++p;
+    if (p == itsEnd  ||  !isDigit(*p)) return 0;
+    if (*p == '0') {
+      ++p;
+    } else {
+      while (p < itsEnd  &&  isDigit(*p)) ++p;
+    }
+    if (p < itsEnd  &&  *p == '.') {
+      isInt = False;
+      ++p;
+      if (p == itsEnd  ||  !isDigit(*p)) return 0;
+      while (p < itsEnd  &&  isDigit(*p)) ++p;
+    }
+    if (p < itsEnd  &&  (*p == 'e'  ||  *p == 'E')) {
+      isInt = False;
+      ++p;
+      if (p < itsEnd  &&  (*p == '+'  ||  *p == '-')) ++p;
+      if (p == itsEnd  ||  !isDigit(*p)) return 0;
+      while (p < itsEnd  &&  isDigit(*p)) ++p;
+    }
+    return p - itsPos;
+  }
+
+  void JsonStreamParser::parseNumber()
+  {
+    Bool isInt;
+    size_t size = scanNumber (isInt);
+    if (size == 0) {
+      error ("invalid value");
+    }
+    if (isInt) {
+      // Accumulate the digits; an integer exceeding the Int64 range
+      // is handled as a double.
+      const char* p = itsPos;
+      Bool neg = (*p == '-');
+      if (neg) ++p;
+      uInt64 limit = uInt64(std::numeric_limits<Int64>::max()) + (neg ? 1:0);
+      uInt64 val = 0;
+      for (; p < itsPos+size; ++p) {
+        uInt64 digit = *p - '0';
+        if (val > (limit - digit) / 10) {
+          isInt = False;
+          break;
+        }
+        val = val*10 + digit;
+      }
+      if (isInt) {
+        itsHandler.intValue (neg  ?  Int64(0 - val) : Int64(val));
+        itsPos += size;
+        return;
+      }
+    }
+    itsHandler.doubleValue (numberToDouble (itsPos, size));
+    itsPos += size;
+  }
+
+  Bool JsonStreamParser::parseDouble (Double& value)
+  {
+    Bool isInt;
+    size_t size = scanNumber (isInt);
+    if (size == 0) {
+      return False;
+    }
+    value = numberToDouble (itsPos, size);
+    itsPos += size;
+    return True;
+  }
+
+  Bool JsonStreamParser::parseComplex()
+  {
+    // Match {"r":value,"i":value} where only white space is allowed
+    // between the tokens (like JsonParser does).
+    const char* start = itsPos;
+    Double vals[2];
+    const char* keys[2] = {"\"r\"", "\"i\""};
+    ++itsPos;
+    for (int i=0; i<2; ++i) {
+      while (itsPos < itsEnd  &&  isWhite(*itsPos)) ++itsPos;
+      if (itsEnd - itsPos < 3  ||  strncmp (itsPos, keys[i], 3) != 0) {
+        itsPos = start;
+        return False;
+      }
+      itsPos += 3;
+      while (itsPos < itsEnd  &&  isWhite(*itsPos)) ++itsPos;
+      if (itsPos == itsEnd  ||  *itsPos != ':') {
+        itsPos = start;
+        return False;
+      }
+      ++itsPos;
+      while (itsPos < itsEnd  &&  isWhite(*itsPos)) ++itsPos;
+      if (! parseDouble (vals[i])) {
+        itsPos = start;
+        return False;
+      }
+      while (itsPos < itsEnd  &&  isWhite(*itsPos)) ++itsPos;
+      if (itsPos == itsEnd  ||  *itsPos != (i==0 ? ',' : '}')) {
+        itsPos = start;
+        return False;
+      }
+      ++itsPos;
+    }
+    itsHandler.complexValue (DComplex(vals[0], vals[1]));
+    return True;
+  }
+
+  uInt JsonStreamParser::parseHex4()
+  {
+    uInt val = 0;
+    for (int i=0; i<4; ++i) {
+      if (itsPos == itsEnd  ||  !isxdigit(static_cast<unsigned char>(*itsPos))) {
+        error ("invalid \\u escape in string");
+      }
+      char ch = *itsPos++;
+      val = val*16 + (isDigit(ch)  ?  ch-'0' : (tolower(static_cast<unsigned char>(ch)) - 'a' + 10));
+    }
+    return val;
+  }
+
+  void JsonStreamParser::parseString()
+  {
+    ++itsPos;                       // skip "
+    itsBuffer.clear();
+    while (True) {
+      // Find the end of the run of normal characters and append it at once.
+      const char* p = itsPos;
+      while (p < itsEnd  &&  *p != '"'  &&  *p != '\\'  &&  *p != '\n') ++p;
+      itsBuffer.append (itsPos, p);
+      itsPos = p;
+      if (itsPos == itsEnd  ||  *itsPos == '\n') {
+        error ("unterminated string");
+      }
+      if (*itsPos == '"') {
+        ++itsPos;
+        return;
+      }
+      // An escaped character.
+      ++itsPos;
+      if (itsPos == itsEnd) {
+        error ("unterminated string");
+      }
+      char ch = *itsPos++;
+      switch (ch) {
+      case 'b':
+        itsBuffer += '\b';  // backspace
+        break;
+      case 'f':
+        itsBuffer += '\f';  // formfeed
+        break;
+      case 'n':
+        itsBuffer += '\n';  // newline
+        break;
+      case 'r':
+        itsBuffer += '\r';  // carriage return
+        break;
+      case 't':
+        itsBuffer += '\t';  // tab
+        break;
+      case 'u':
+        {
+          // Store as UTF-8. A character outside the Basic Multilingual
+          // Plane is given as a surrogate pair (two \u escapes), which
+          // has to be combined into a single code point.
+          uInt val = parseHex4();
+          if (val >= 0xDC00  &&  val <= 0xDFFF) {
+            error ("unpaired low surrogate in \\u escape");
+          }
+          if (val >= 0xD800  &&  val <= 0xDBFF) {
+            if (itsEnd - itsPos < 2  ||  itsPos[0] != '\\'  ||
+                itsPos[1] != 'u') {
+              error ("unpaired high surrogate in \\u escape");
+            }
+            itsPos += 2;
+            uInt low = parseHex4();
+            if (low < 0xDC00  ||  low > 0xDFFF) {
+              error ("unpaired high surrogate in \\u escape");
+            }
+            val = 0x10000 + ((val - 0xD800) << 10) + (low - 0xDC00);
+          }
+          if (val < 0x80) {
+            itsBuffer += char(val);
+          } else if (val < 0x800) {
+            itsBuffer += char(0xC0 | (val >> 6));
+            itsBuffer += char(0x80 | (val & 0x3F));
+          } else if (val < 0x10000) {
+            itsBuffer += char(0xE0 | (val >> 12));
+            itsBuffer += char(0x80 | ((val >> 6) & 0x3F));
+            itsBuffer += char(0x80 | (val & 0x3F));
+          } else {
+            itsBuffer += char(0xF0 | (val >> 18));
+            itsBuffer += char(0x80 | ((val >> 12) & 0x3F));
+            itsBuffer += char(0x80 | ((val >> 6) & 0x3F));
+            itsBuffer += char(0x80 | (val & 0x3F));
+          }
+        }
+        break;
+      default:
+        itsBuffer += ch;
+      }
+    }
+  }
+
+  void JsonStreamParser::skipWhite()
+  {
+    while (itsPos < itsEnd) {
+      if (isWhite(*itsPos)) {
+        ++itsPos;
+      } else if (*itsPos == '#'  ||
+                 (*itsPos == '/'  &&  itsPos+1 < itsEnd  &&
+                  itsPos[1] == '/')) {
+        // A comment till end-of-line.
+        const char* p = static_cast<const char*>
+          (memchr (itsPos, '\n', itsEnd - itsPos));
+        itsPos = (p  ?  p+1 : itsEnd);
+      } else if (*itsPos == '/'  &&  itsPos+1 < itsEnd  &&
+                 itsPos[1] == '*') {
+        // A C-style comment.
+        const char* p = itsPos + 2;
+        while (p+1 < itsEnd  &&  !(p[0] == '*'  &&  p[1] == '/')) ++p;
+        if (p+1 >= itsEnd) {
+          error ("unterminated comment");
+        }
+        itsPos = p+2;
+      } else {
+        break;
+      }
+    }
+  }
+
+  void JsonStreamParser::skipLiteral (const char* literal, size_t size)
+  {
+    if (size_t(itsEnd - itsPos) < size  ||
+        strncmp (itsPos, literal, size) != 0) {
+      error ("invalid value");
+    }
+    itsPos += size;
+  }
+
+  void JsonStreamParser::error (const String& message) const
+  {
+    size_t line = 1;
+    for (const char* p=itsStart; p<itsPos; ++p) {
+      if (*p == '\n') ++line;
+    }
+    std::ostringstream os;
+    os << "JsonStreamParser: " << message << " at line " << line
+       << " (position " << itsPos - itsStart << ')';
+    throw JsonError (os.str());
+  }
+
+} // end namespace
@@ -0,0 +1,216 @@
+//# JsonStreamParser.h: Event-based parser of JSON text
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_JSONSTREAMPARSER_H
+#define CASA_JSONSTREAMPARSER_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <casacore/casa/BasicSL/Complex.h>
+#include <string>
+
+namespace casacore {
+
+  //# Forward Declarations
+  class Record;
+
+  // <summary>
+  // Interface for the events of the JsonStreamParser.
+  // </summary>
+
+  // <use visibility=export>
+  // <reviewed reviewer="" date="" tests="tJsonStreamParser">
+  // </reviewed>
+
+  // <synopsis>
+  // JsonHandler defines the callback functions called by
+  // <linkto class=JsonStreamParser>JsonStreamParser</linkto> for each
+  // element in the JSON text. A derived class can handle the elements
+  // in any way, for example fill a Record (see
+  // <linkto class=JsonRecordBuilder>JsonRecordBuilder</linkto>).
+  // <br>The names and string values are passed as a pointer and length
+  // in a buffer owned by the parser. They are only valid during the call.
+  // Escaped characters have been translated already.
+  // </synopsis>
+
+  class JsonHandler
+  {
+  public:
+    virtual ~JsonHandler();
+
+    // A struct is started or ended.
+    // <group>
+    virtual void startObject() = 0;
+    virtual void endObject() = 0;
+    // </group>
+
+    // The name of the next field in a struct.
+    virtual void key (const char* name, size_t size) = 0;
+
+    // A sequence is started or ended.
+    // <group>
+    virtual void startArray() = 0;
+    virtual void endArray() = 0;
+    // </group>
+
+    // A value is found.
+    // An integer exceeding the Int64 range is passed as a double.
+    // A struct with only the fields "r" and "i" is passed as a complex value.
+    // <group>
+    virtual void nullValue() = 0;
+    virtual void boolValue (Bool value) = 0;
+    virtual void intValue (Int64 value) = 0;
+    virtual void doubleValue (Double value) = 0;
+    virtual void complexValue (const DComplex& value) = 0;
+    virtual void stringValue (const char* value, size_t size) = 0;
+    // </group>
+  };
+
+
+  // <summary>
+  // Event-based parser of JSON text.
+  // </summary>
+
+  // <use visibility=export>
+  // <reviewed reviewer="" date="" tests="tJsonStreamParser">
+  // </reviewed>
+
+  // <prerequisite>
+  //   <li> <linkto class=JsonParser>JsonParser</linkto>
+  // </prerequisite>
+
+  // <synopsis>
+  // JsonStreamParser parses JSON text in a single pass and calls the
+  // functions of a <linkto class=JsonHandler>JsonHandler</linkto> object
+  // for each element (SAX-style). Unlike
+  // <linkto class=JsonParser>JsonParser</linkto> it does not build a tree
+  // of JsonValue objects, so the memory use does not depend on the size
+  // of the text and the parsing is much faster for large texts.
+  // <br>It accepts the same syntax as JsonParser:
+  // <ul>
+  //  <li> Standard JSON text, where the outer element must be a struct.
+  //  <li> Comments in C, C++ and Python style (/ * * /, // and #).
+  //  <li> Complex numbers written as a struct with fields "r" and "i"
+  //       (in that order).
+  // </ul>
+  // A JsonError exception is thrown in case of a syntax error. Its message
+  // contains the line number and position of the error.
+  // <br>The function <src>toRecord</src> can be used to parse the text
+  // directly into a Record.
+  // </synopsis>
+
+  // <example>
+  // <srcblock>
+  // // Parse a JSON file into a Record.
+  // Record rec = JsonStreamParser::fileToRecord ("metadata.json");
+  // // Count the number of fields using a handler.
+  // class Counter : public JsonHandler { ... };
+  // Counter counter;
+  // JsonStreamParser::parse (text, counter);
+  // </srcblock>
+  // </example>
+
+  // <motivation>
+  // Parsing large JSON texts (e.g., metadata of a table) should be fast
+  // and not need intermediate objects.
+  // </motivation>
+
+  class JsonStreamParser
+  {
+  public:
+    // Parse the text and call the handler for each element.
+    // <group>
+    static void parse (const char* text, size_t size, JsonHandler& handler);
+    static void parse (const String& text, JsonHandler& handler);
+    // </group>
+
+    // Parse the given file and call the handler for each element.
+    static void parseFile (const String& fileName, JsonHandler& handler);
+
+    // Parse the text or file and return the result as a Record
+    // (using a JsonRecordBuilder).
+    // <group>
+    static Record toRecord (const String& text);
+    static Record fileToRecord (const String& fileName);
+    // </group>
+
+  private:
+    JsonStreamParser (const char* text, size_t size, JsonHandler& handler);
+
+    // Parse the outer struct.
+    void parseDocument();
+
+    // Parse a value, where the first character has been checked.
+    void parseValue (uInt depth);
+
+    // Parse a struct or sequence.
+    // <group>
+    void parseObject (uInt depth);
+    void parseArray (uInt depth);
+    // </group>
+
+    // Parse a number and call the handler.
+    void parseNumber();
+
+    // Parse a string (starting at the quote) into itsBuffer.
+    void parseString();
+
+    // Try to parse a complex number (a struct with fields r and i).
+    // It returns False (and does not advance) if not a complex number.
+    Bool parseComplex();
+
+    // Parse a number (in JSON syntax) as a double. It returns False if
+    // not a number. It advances if a number.
+    Bool parseDouble (Double& value);
+
+    // Get the length of the number at the current position (0 if not
+    // a valid JSON number) and tell if it is an integer.
+    size_t scanNumber (Bool& isInt) const;
+
+    // Parse the 4 hex digits of a \u escape.
+    uInt parseHex4();
+
+    // Skip white space and comments.
+    void skipWhite();
+
+    // Skip the expected literal (true, false, null).
+    void skipLiteral (const char* literal, size_t size);
+
+    // Throw a JsonError with the message and current position.
+    void error (const String& message) const;
+
+    //# Data members.
+    const char*  itsStart;
+    const char*  itsPos;
+    const char*  itsEnd;
+    JsonHandler& itsHandler;
+    //# Buffer for a name or string value (reused to avoid allocations).
+    std::string  itsBuffer;
+  };
+
+} // end namespace
+
+#endif
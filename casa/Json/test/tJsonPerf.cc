@@ -0,0 +1,170 @@
+//# tJsonPerf.cc: Measure the performance of JSON writing and parsing
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/Json/JsonStreamParser.h>
+#include <casacore/casa/Json/JsonRecordBuilder.h>
+#include <casacore/casa/Json/JsonKVMap.h>
+#include <casacore/casa/Json/JsonParser.h>
+#include <casacore/casa/Json/JsonOut.h>
+#include <casacore/casa/Containers/ValueHolder.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+
+using namespace casacore;
+
+// This program measures the throughput of writing a large Record
+// as JSON, and of parsing it back using JsonStreamParser (with and
+// without building a Record) and JsonParser.
+// The number of fields can be given as the first argument.
+
+// A handler only counting the values.
+class ValueCounter : public JsonHandler
+{
+public:
+  ValueCounter() : itsCount(0) {}
+  virtual void startObject() {}
+  virtual void endObject() {}
+  virtual void key (const char*, size_t) {}
+  virtual void startArray() {}
+  virtual void endArray() {}
+  virtual void nullValue() { itsCount++; }
+  virtual void boolValue (Bool) { itsCount++; }
+  virtual void intValue (Int64) { itsCount++; }
+  virtual void doubleValue (Double) { itsCount++; }
+  virtual void complexValue (const DComplex&) { itsCount++; }
+  virtual void stringValue (const char*, size_t) { itsCount++; }
+  size_t itsCount;
+};
+
+double elapsed (const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double>
+    (std::chrono::steady_clock::now() - start).count();
+}
+
+void report (const char* name, size_t nbytes, double sec)
+{
+  cout << "  " << name << ": " << sec << " sec  "
+       << nbytes / sec / (1024*1024) << " MB/s" << endl;
+}
+
+// Make a record with the given number of fields, which mimics the
+// keywords of a table (scalars, strings, 1-dim arrays and subrecords).
+Record makeRecord (uInt nfield)
+{
+  Record rec;
+  for (uInt i=0; i<nfield; ++i) {
+    String name = "KEYWORD_" + String::toString(i);
+    switch (i%8) {
+    case 0:
+      {
+        Record sub;
+        sub.define ("unit", "Hz");
+        sub.define ("value", 1.4e9 + i);
+        rec.defineRecord (name, sub);
+      }
+      break;
+    case 1:
+      {
+        Array<Double> arr(IPosition(1,256));
+        indgen (arr, Double(i), 0.125);
+        rec.define (name, arr);
+      }
+      break;
+    case 2:
+    case 3:
+      rec.define (name, "value of keyword " + String::toString(i));
+      break;
+    case 4:
+      rec.define (name, Int64(i));
+      break;
+    default:
+      rec.define (name, i * 1.0001);
+    }
+  }
+  return rec;
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    uInt nfield = 100000;
+    if (argc > 1) {
+      nfield = atoi(argv[1]);
+    }
+    Record rec = makeRecord (nfield);
+    // Write the record.
+    auto start = std::chrono::steady_clock::now();
+    std::ostringstream os;
+    JsonOut jout(os);
+    jout.start();
+    for (uInt i=0; i<rec.nfields(); ++i) {
+      jout.write (rec.name(i), rec.asValueHolder(i));
+    }
+    jout.end();
+    String text = os.str();
+    cout << "JSON text of " << nfield << " fields ("
+         << text.size() / (1024*1024) << " MB)" << endl;
+    report ("JsonOut (string)           ", text.size(), elapsed(start));
+    // Write it to a file.
+    start = std::chrono::steady_clock::now();
+    {
+      JsonOut fout("tJsonPerf_tmp.json");
+      fout.start();
+      for (uInt i=0; i<rec.nfields(); ++i) {
+        fout.write (rec.name(i), rec.asValueHolder(i));
+      }
+      fout.end();
+    }
+    report ("JsonOut (file)             ", text.size(), elapsed(start));
+    // Parse it without building anything.
+    start = std::chrono::steady_clock::now();
+    ValueCounter counter;
+    JsonStreamParser::parse (text, counter);
+    report ("JsonStreamParser (count)   ", text.size(), elapsed(start));
+    // Parse it into a Record.
+    start = std::chrono::steady_clock::now();
+    Record rec2 = JsonStreamParser::toRecord (text);
+    report ("JsonStreamParser (Record)  ", text.size(), elapsed(start));
+    AlwaysAssertExit (rec2.nfields() == rec.nfields());
+    start = std::chrono::steady_clock::now();
+    Record rec4 = JsonStreamParser::fileToRecord ("tJsonPerf_tmp.json");
+    report ("JsonStreamParser (file)    ", text.size(), elapsed(start));
+    AlwaysAssertExit (rec4.nfields() == rec.nfields());
+    // Parse it using the JsonParser.
+    start = std::chrono::steady_clock::now();
+    Record rec3 = JsonParser::parse(text).toRecord();
+    report ("JsonParser (Record)        ", text.size(), elapsed(start));
+    AlwaysAssertExit (rec3.nfields() == rec.nfields());
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
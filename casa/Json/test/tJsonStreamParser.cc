@@ -0,0 +1,239 @@
+//# tJsonStreamParser.cc: Test program for classes JsonStreamParser and JsonRecordBuilder
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/Json/JsonStreamParser.h>
+#include <casacore/casa/Json/JsonRecordBuilder.h>
+#include <casacore/casa/Json/JsonOut.h>
+#include <casacore/casa/Json/JsonError.h>
+#include <casacore/casa/Containers/ValueHolder.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <fstream>
+#include <sstream>
+
+using namespace casacore;
+
+// A handler writing the events in a compact form.
+class EventLogger : public JsonHandler
+{
+public:
+  virtual void startObject()
+    { itsOut << '{'; }
+  virtual void endObject()
+    { itsOut << '}'; }
+  virtual void key (const char* name, size_t size)
+    { itsOut << std::string(name, size) << ':'; }
+  virtual void startArray()
+    { itsOut << '['; }
+  virtual void endArray()
+    { itsOut << ']'; }
+  virtual void nullValue()
+    { itsOut << "N,"; }
+  virtual void boolValue (Bool value)
+    { itsOut << "B" << value << ','; }
+  virtual void intValue (Int64 value)
+    { itsOut << "I" << value << ','; }
+  virtual void doubleValue (Double value)
+    { itsOut << "D" << value << ','; }
+  virtual void complexValue (const DComplex& value)
+    { itsOut << "C" << value.real() << '/' << value.imag() << ','; }
+  virtual void stringValue (const char* value, size_t size)
+    { itsOut << "S<" << std::string(value, size) << ">,"; }
+  std::ostringstream itsOut;
+};
+
+String events (const String& text)
+{
+  EventLogger logger;
+  JsonStreamParser::parse (text, logger);
+  return logger.itsOut.str();
+}
+
+void checkError (const String& text)
+{
+  Bool failed = False;
+  try {
+    JsonStreamParser::toRecord (text);
+  } catch (const JsonError& x) {
+    cout << x.what() << endl;
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+}
+
+void testEvents()
+{
+  AlwaysAssertExit (events("{}") == "{}");
+  AlwaysAssertExit (events(" {\"a\" : 1, \"b\":[true,false,null]} ") ==
+                    "{a:I1,b:[B1,B0,N,]}");
+  // Comments in all styles.
+  AlwaysAssertExit (events("# comment\n{\"a\":-2.5e1, // c++\n"
+                           " /* c */ \"b\":\"x\"}\n# end") ==
+                    "{a:D-25,b:S<x>,}");
+  // Complex values and a struct that is not a complex.
+  AlwaysAssertExit (events("{\"c\":{\"r\":1, \"i\" : -2.5},"
+                           " \"d\":{\"r\":1}}") ==
+                    "{c:C1/-2.5,d:{r:I1,}}");
+  // Escapes (also in names).
+  AlwaysAssertExit (events("{\"a\\\"b\":\"t\\tn\\n\\u0041\\/\\\\\"}") ==
+                    "{a\"b:S<t\tn\nA/\\>,}");
+  // A surrogate pair is a single 4-byte UTF-8 character.
+  AlwaysAssertExit (events("{\"a\":\"\\uD83D\\uDE00\\u00e9\"}") ==
+                    "{a:S<\xF0\x9F\x98\x80\xC3\xA9>,}");
+  // Integers exceeding Int64 are doubles.
+  AlwaysAssertExit (events("{\"a\":9223372036854775807,"
+                           "\"b\":-9223372036854775808,"
+                           "\"c\":9223372036854775808}") ==
+                    "{a:I9223372036854775807,b:I-9223372036854775808,"
+                    "c:D9.22337e+18,}");
+}
+
+void testRecord()
+{
+  Record rec = JsonStreamParser::toRecord
+    ("{\"b\":true, \"i\":34, \"d\":24.3e1, \"c\":{\"r\":3.5,\"i\":-4.6},"
+     " \"s\":\"str\", \"n\":null,"
+     " \"sub\":{\"x\":1, \"subsub\":{\"y\":\"z\"}},"
+     " \"bv\":[true,false], \"iv\":[2,3,-5], \"dv\":[1,2.5,null],"
+     " \"cv\":[1,{\"r\":1,\"i\":2}], \"sv\":[\"a\",\"b\"], \"ev\":[],"
+     " \"arr\":[[[0,1,2,3],[4,5,6,7],[8,9,10,11]],"
+     "[[12,13,14,15],[16,17,18,19],[20,21,22,23]]],"
+     " \"last\":0}");
+  AlwaysAssertExit (rec.nfields() == 15);
+  AlwaysAssertExit (rec.asBool("b") == True);
+  AlwaysAssertExit (rec.dataType("i") == TpInt64  &&  rec.asInt64("i") == 34);
+  AlwaysAssertExit (rec.dataType("d") == TpDouble  &&  rec.asDouble("d") == 243);
+  AlwaysAssertExit (rec.asDComplex("c") == DComplex(3.5,-4.6));
+  AlwaysAssertExit (rec.asString("s") == "str");
+  AlwaysAssertExit (isNaN (rec.asDouble("n")));
+  const Record& sub = rec.subRecord("sub");
+  AlwaysAssertExit (sub.asInt64("x") == 1);
+  AlwaysAssertExit (sub.subRecord("subsub").asString("y") == "z");
+  AlwaysAssertExit (rec.asArrayBool("bv").nelements() == 2);
+  AlwaysAssertExit (rec.dataType("iv") == TpArrayInt64);
+  AlwaysAssertExit (rec.asArrayInt64("iv")(IPosition(1,2)) == -5);
+  Array<Double> dv = rec.asArrayDouble("dv");
+  AlwaysAssertExit (dv(IPosition(1,1)) == 2.5  &&  isNaN(dv(IPosition(1,2))));
+  AlwaysAssertExit (rec.asArrayDComplex("cv")(IPosition(1,1)) ==
+                    DComplex(1,2));
+  AlwaysAssertExit (rec.asArrayString("sv")(IPosition(1,1)) == "b");
+  AlwaysAssertExit (rec.asArrayInt("ev").nelements() == 0);
+  // The innermost sequence is the first axis.
+  Array<Int64> exp(IPosition(3,4,3,2));
+  indgen (exp);
+  AlwaysAssertExit (allEQ (rec.asArrayInt64("arr"), exp));
+  AlwaysAssertExit (rec.asInt64("last") == 0);
+}
+
+void testRoundTrip()
+{
+  // Write a record with JsonOut and read it back.
+  Record rec;
+  Array<Double> darr(IPosition(3,2,3,4));
+  indgen (darr, 0.25);
+  rec.define ("darr", darr);
+  Array<Int64> iarr(IPosition(2,5,2));
+  indgen (iarr, Int64(-3));
+  rec.define ("iarr", iarr);
+  Array<String> sarr(IPosition(2,2,2));
+  sarr(IPosition(2,0,0)) = "a\"b";
+  sarr(IPosition(2,1,1)) = "tab\there";
+  rec.define ("sarr", sarr);
+  rec.define ("carr", Array<DComplex>(IPosition(1,3), DComplex(1,-1)));
+  rec.define ("str", "line1\nline2 \\ \x01");
+  Record sub;
+  sub.define ("bv", Array<Bool>(IPosition(1,3), True));
+  rec.defineRecord ("sub", sub);
+  std::ostringstream os;
+  JsonOut jout(os);
+  jout.start();
+  for (uInt i=0; i<rec.nfields(); ++i) {
+    jout.write (rec.name(i), rec.asValueHolder(i));
+  }
+  jout.end();
+  Record rec2 = JsonStreamParser::toRecord (os.str());
+  AlwaysAssertExit (allEQ (rec2.asArrayDouble("darr"), darr));
+  AlwaysAssertExit (allEQ (rec2.asArrayInt64("iarr"), iarr));
+  AlwaysAssertExit (allEQ (rec2.asArrayString("sarr"), sarr));
+  AlwaysAssertExit (allEQ (rec2.asArrayDComplex("carr"),
+                           rec.asArrayDComplex("carr")));
+  AlwaysAssertExit (rec2.asString("str") == rec.asString("str"));
+  AlwaysAssertExit (allEQ (rec2.subRecord("sub").asArrayBool("bv"), True));
+  // Also via a file.
+  {
+    std::ofstream ofs("tJsonStreamParser_tmp.json");
+    ofs << os.str();
+  }
+  Record rec3 = JsonStreamParser::fileToRecord ("tJsonStreamParser_tmp.json");
+  AlwaysAssertExit (rec3.nfields() == rec.nfields());
+  AlwaysAssertExit (allEQ (rec3.asArrayDouble("darr"), darr));
+}
+
+void testErrors()
+{
+  checkError ("");
+  checkError ("[1,2]");
+  checkError ("{\"a\":1");
+  checkError ("{\"a\":1,}");
+  checkError ("{\"a\" 1}");
+  checkError ("{a:1}");
+  checkError ("{\"a\":01}");
+  checkError ("{\"a\":1.}");
+  checkError ("{\"a\":tru}");
+  checkError ("{\"a\":\"abc}");
+  checkError ("{\"a\":\"ab\nc\"}");
+  checkError ("{\"a\":\"\\u12\"}");
+  checkError ("{\"a\":\"\\uD800\"}");
+  checkError ("{\"a\":\"\\uDC00\"}");
+  checkError ("{\"a\":\"\\uD800\\u0041\"}");
+  checkError ("{\"a\":\"\\uD800x\"}");
+  checkError ("{\"a\":1} x");
+  checkError ("{\"a\":1 /* unterminated}");
+  // Errors found by the Record builder.
+  checkError ("{\"a\":[1,\"s\"]}");
+  checkError ("{\"a\":[true,1]}");
+  checkError ("{\"a\":[[1,2],[3]]}");
+  checkError ("{\"a\":[[1,2],3]}");
+  checkError ("{\"a\":[1,[2]]}");
+  checkError ("{\"a\":[{\"b\":1}]}");
+}
+
+int main()
+{
+  try {
+    testEvents();
+    testRecord();
+    testRoundTrip();
+    testErrors();
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
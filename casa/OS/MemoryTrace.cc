@@ -30,6 +30,7 @@
 #include <casacore/casa/OS/EnvVar.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Exceptions/Error.h>
+#include <sstream>
 #ifdef AIPS_LINUX_DEPR
 # include <malloc.h>
 #endif
@@ -204,6 +205,18 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
   }
 
+  void MemoryTrace::writePoolStatistics()
+  {
+    if (isOpen()) {
+      PoolAllocatorStatistics stats = poolStatistics();
+      std::ostringstream ostr;
+      ostr << "PoolAllocator live=" << stats.liveBytes
+           << " peak=" << stats.peakBytes
+           << " cached=" << stats.cachedBytes;
+      writeBlock (" pool ", ostr.str());
+    }
+  }
+
   std::string MemoryTrace::makeString (const char* name)
   {
 #ifdef AIPS_LINUX_DEPR
@@ -28,6 +28,7 @@
 
 #include <casacore/casa/aips.h>
 #include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/Containers/PoolAllocator.h>
 #include <fstream>
 #include <string>
 
@@ -50,19 +51,27 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // start the trace file is created. The file can be closed at any time,
   // usually at the end of a program. Another start will recreate the file.
   //
-  // The trace file consists of 3 types of lines:
+  // The trace file consists of 4 types of lines:
   // <ul>
   //  <li> An allocation line like "a <address> <caller> <size>"
   //  <li> A deallocation line like "f <address> <caller>"
   //  <li> A line like "begin/end <name>" telling the script the beginning
   //   or end of a code block. It makes it possible to see how memory usage
   //   develops. Such lines can be inserted using the class MemoryTraceBlock.
+  //  <li> A line like "pool PoolAllocator live=<n> peak=<n> cached=<n>"
+  //   written by <src>writePoolStatistics</src>.
   // </ul>
   // All lines start with the number of milliseconds since the start of
   // the program.
   // <p>
   // The script memorytrace.py can be used to interpret the log file and
   // to show the memory usage.
+  // <p>
+  // Blocks allocated by the <linkto class=PoolAllocator>PoolAllocator</linkto>
+  // are reused without calling malloc, so they are traced explicitly in the
+  // trace file. The statistics of the pool (live bytes, peak, and counts
+  // per size class) can be obtained with the function
+  // <src>poolStatistics</src>, also if tracing is off.
   // </synopsis>
 
   class MemoryTrace
@@ -107,6 +116,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // the string constructor.
     static std::string makeString (const char*);
 
+    // Get the statistics of the PoolAllocator.
+    static PoolAllocatorStatistics poolStatistics()
+      { return PoolAllocatorBase::statistics(); }
+
+    // Write the statistics of the PoolAllocator as a block line in
+    // the output file.
+    static void writePoolStatistics();
+
   private:
     static Bool          theirDoTrace;
     static std::ofstream theirFile;
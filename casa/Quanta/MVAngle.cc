@@ -25,15 +25,13 @@
 
 //# Includes
 #include <casacore/casa/Quanta/MVAngle.h>
-#include <casacore/casa/sstream.h>
-#include <casacore/casa/iomanip.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/BasicSL/Constants.h>
 #include <casacore/casa/Quanta/QMath.h>
 #include <casacore/casa/Utilities/MUString.h>
 #include <casacore/casa/System/AppInfo.h>
-//
-#include <casacore/casa/Logging/LogIO.h>
+#include <casacore/casa/Quanta/MVFormatBuffer.h>
+
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 // MVAngle class
@@ -197,9 +195,15 @@ String MVAngle::string(uInt intyp, uInt inprec) const {
 }
 
 String MVAngle::string(const MVAngle::Format &form) const {
-    ostringstream oss;
-    print (oss, form);
-    return oss;
+    char buf[FormatSize];
+    size_t n = format(buf, sizeof(buf), form);
+    if (n < sizeof(buf)) {
+      return String(buf, n);
+    }
+    // Only a very high precision does not fit in the buffer.
+    String str(n, ' ');
+    format(&(str[0]), n+1, form);
+    return str;
 }
 
 Double MVAngle::timeZone() {
@@ -213,6 +217,26 @@ void MVAngle::print(ostream &oss,
 
 void MVAngle::print(ostream &oss,
 		    const MVAngle::Format &form, Bool loc) const {
+    char buf[FormatSize];
+    size_t n = format(buf, sizeof(buf), form, oss.precision(), loc);
+    if (n < sizeof(buf)) {
+      oss << buf;
+    } else {
+      String str(n, ' ');
+      format(&(str[0]), n+1, form, oss.precision(), loc);
+      oss << str;
+    }
+}
+
+size_t MVAngle::format(char *buf, size_t size,
+                       const MVAngle::Format &form, uInt defPrec) const {
+  return format(buf, size, form, defPrec, False);
+}
+
+size_t MVAngle::format(char *buf, size_t size,
+                       const MVAngle::Format &form, uInt defPrec,
+                       Bool loc) const {
+    MVFormatBuffer out(buf, size);
     uInt inprec = form.prec;
     uInt intyp = form.typ;
     uInt i1 = intyp & ~MVAngle::MOD_MASK;
@@ -243,8 +267,7 @@ void MVAngle::print(ostream &oss,
         sep2 = ':';
       }
     }
-    if (inprec == 0) inprec = oss.precision();
-    Char sfill = oss.fill();
+    if (inprec == 0) inprec = defPrec;
     t1 = 1.0;
     if (inprec > 2) t1 /= 60.;
     if (inprec > 4) t1 /= 60.;
@@ -252,12 +275,12 @@ void MVAngle::print(ostream &oss,
     if (inprec > 6) t1 /= std::pow(Double(10), Double(inprec-6));
     if (i1 == MVAngle::ANGLE || ((intyp & MVAngle::DIG2) == MVAngle::DIG2)) {
 	if (t < 0) {
-	  oss << '-';
+	  out.put('-');
 	} else if ((intyp & MVAngle::CLEAN) != MVAngle::CLEAN ||
 		   ((intyp & MVAngle::DIG2) == MVAngle::DIG2)) {
-	  oss << '+';
+	  out.put('+');
 	} else {
-	  oss << ' ';
+	  out.put(' ');
 	}
     }
     // The next 0.1 necessary for some rounding errors
@@ -267,71 +290,74 @@ void MVAngle::print(ostream &oss,
 	if (i1 == MVAngle::ANGLE) {
 	  if ((intyp & MVAngle::DIG2) != MVAngle::DIG2) {
 	    if (h > 999) {
-	      oss << "***";
+	      out.put("***");
 	    } else if ((intyp & MVAngle::CLEAN) != MVAngle::CLEAN) {
-	      oss << setfill('0') << setw(3) << h;
+	      out.putInt(h, 3, '0');
 	    } else {
-	      oss << setfill(' ') << setw(3) << h;
+	      out.putInt(h, 3, ' ');
 	    }
 	  } else {
 	    if (h > 99) {
-	      oss << "**";
+	      out.put("**");
 	    } else if ((intyp & MVAngle::CLEAN) != MVAngle::CLEAN) {
-	      oss << setfill('0') << setw(2) << h;
+	      out.putInt(h, 2, '0');
 	    } else {
-	      oss << setfill(' ') << setw(2) << h;
+	      out.putInt(h, 2, ' ');
 	    }
 	  }
 	} else {
 	  if (h > 99) {
-	    oss << "**";
+	    out.put("**");
 	  } else {
-	    oss << setfill('0') << setw(2) << h;
+	    out.putInt(h, 2, '0');
 	  }
 	}
 	if ((inprec > 2) || ((intyp & MVAngle::CLEAN) != MVAngle::CLEAN)) {
-	    oss << sep1;
+	    out.put(sep1);
 	}
     } else if ((intyp & MVAngle::CLEAN) != MVAngle::CLEAN) {
-	oss << sep1;
+	out.put(sep1);
     }
     if (inprec > 2) {
 	t = std::fmod(t,1.0) *60.;
 	h = ifloor(t);
 	if ((intyp & MVAngle::NO_DM) != MVAngle::NO_DM) {
-	    oss << setfill('0') << setw(2) << h;
+	    out.putInt(h, 2, '0');
 	    if ((inprec > 4) || ((intyp & MVAngle::CLEAN) != MVAngle::CLEAN)) {
-		oss << sep2;
+		out.put(sep2);
 	    }
 	} else if ((intyp & MVAngle::CLEAN) != MVAngle::CLEAN) {
-	    oss << sep2;
+	    out.put(sep2);
 	}
     } else if ((intyp & MVAngle::CLEAN) != MVAngle::CLEAN) {
-	oss << sep2;
+	out.put(sep2);
     }
     if (inprec > 4 && inprec < 7) {
 	t = std::fmod(t,1.0) *60.;
 	h = ifloor(t);
-	oss << setfill('0') << setw(2) << h;
+	out.putInt(h, 2, '0');
     }
     if (inprec > 6) {
       t = std::abs((std::fmod(t, 1.0) - 6.0*t1)*60.);
       // The following was necessary since abs(0) becomes -0 (Solaris at least)
       if (t <= 0.0) t = 0;
-      Int oprec = oss.precision();
-      ios::fmtflags oldb = oss.setf(ios::fixed,ios::floatfield);
-      oss << setfill('0') << setprecision(inprec-6) << setw(inprec-3) << t <<
-	setprecision(oprec);
-      oss.setf(oldb,ios::floatfield);
+      out.putFixed(t, inprec-6, inprec-3);
     }
     if ((intyp & MVAngle::FITS) == MVAngle::FITS) {
       if ((intyp & MVAngle::LOCAL) == MVAngle::LOCAL) {
 	MVAngle my = MVAngle::timeZone() * C::circle;
-	my.print(oss, MVAngle::Format(MVAngle::TIME_CLEAN | MVAngle::DIG2, 4),
-		 True);
+	out.added(my.format(out.freeBuf(), out.freeSize(),
+                            MVAngle::Format(MVAngle::TIME_CLEAN |
+                                            MVAngle::DIG2, 4),
+                            defPrec, True));
       }
     }
-    oss.fill(sfill);
+    return out.finish();
+}
+
+void MVAngle::format(char *buf, size_t width, const Double *rad, size_t n,
+                     const MVAngle::Format &form) {
+  MVFormatBuffer::formatFields<MVAngle> (buf, width, rad, n, form);
 }
 
 const MVAngle &MVAngle::binorm(Double norm) {
@@ -362,7 +388,6 @@ Bool MVAngle::read(Quantity &res, MUString &in, Bool chk) {
   return read (res, in, chk, False);
 }
 Bool MVAngle::read(Quantity &res, MUString &in, Bool chk, Bool throwExcp) {
-  LogIO os(LogOrigin("MVAngle", "read()", WHERE));
   res = Quantity(0.0, "rad");
   in.skipBlank();
   in.push();			// Save position
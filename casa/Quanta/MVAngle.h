@@ -180,10 +180,14 @@ class MUString;
 // formats. <br>
 // For other formatting practice, the output can be written to a String with
 // the string() member function.<br>
+// For listings of many values the format() member functions can be used.
+// They format into a buffer given by the caller, so no String or stream is
+// created. The static format function does so for an array of values.<br>
 // Note that using a temporary format is inherently thread-unsafe because
 // the format is kept in a static variable. Another thread may overwrite
 // the format just set. The only thread-safe way to format an MVTime is using
-// a <src>print</src> or <src>string</src> that accepts a Format object.
+// a <src>print</src>, <src>string</src> or <src>format</src> that accepts
+// a Format object.
 //
 // Strings and input can be converted to an MVAngle (or Quantity) by
 // <src>Bool read(Quantity &out, const String &in)</src> and
@@ -244,6 +248,10 @@ class MVAngle {
 
  public:
 
+  // Size of a buffer large enough to format an angle
+  // (with a precision up to 40).
+  static const size_t FormatSize = 64;
+
   //# Enumerations (should mimic those in MVTime)
   // Format types
   enum formatTypes {
@@ -370,6 +378,23 @@ class MVAngle {
   void print(ostream &oss, const MVAngle::Format &form) const;
   void print(ostream &oss, const MVAngle::Format &form, Bool loc) const;
   // </group>
+  // Format the angle into a buffer of the given size without creating a
+  // String or stream, which is much faster than <src>string</src>.
+  // The output is the same as that of <src>string(form)</src>, but a
+  // precision of 0 in the format means <src>defPrec</src> digits.
+  // Like <src>snprintf</src> the output is null-terminated and truncated
+  // if the buffer is too small, and the length of the full output is
+  // returned. A buffer of <src>FormatSize</src> characters is large
+  // enough for a precision up to 40.
+  size_t format(char *buf, size_t size, const MVAngle::Format &form,
+                uInt defPrec=6) const;
+  // Format the angles (in radians) of an array into consecutive fields
+  // of <src>width</src> characters in the buffer, which must have
+  // <src>n*width</src> characters. The fields are right-adjusted and not
+  // null-terminated; a field is filled with asterisks if the value does
+  // not fit. It can be used to format a column of a listing at once.
+  static void format(char *buf, size_t width, const Double *rad, size_t n,
+                     const MVAngle::Format &form);
   // Set default format
   // <note role=warning>
   // It is thread-unsafe to print using the setFormat functions because they
@@ -403,6 +428,10 @@ class MVAngle {
   // </group>
   
   //# Member functions
+  // Format the angle; if <src>loc</src> is True, the time zone is
+  // formatted.
+  size_t format(char *buf, size_t size, const MVAngle::Format &form,
+                uInt defPrec, Bool loc) const;
 };
 
 // Global functions
@@ -0,0 +1,218 @@
+//# MVFormatBuffer.h: Character buffer used to format MVAngle and MVTime
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef CASA_MVFORMATBUFFER_H
+#define CASA_MVFORMATBUFFER_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Character buffer used to format MVAngle and MVTime
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tMVTime">
+// </reviewed>
+
+// <synopsis>
+// MVFormatBuffer writes characters into a buffer of a given size, much
+// like <src>snprintf</src> does. It is used by the <src>format</src>
+// functions of <linkto class=MVAngle>MVAngle</linkto> and
+// <linkto class=MVTime>MVTime</linkto> to format values without creating
+// a stream or String.
+// <br>Characters not fitting in the buffer are counted, but not written.
+// Function <src>finish</src> null-terminates the buffer and returns the
+// length of the full output.
+// <br>Integers and fixed point numbers are right-adjusted in a field like
+// <src>setw</src> and <src>setfill</src> do on a stream, thus the fill
+// characters are put before a possible sign.
+// </synopsis>
+
+class MVFormatBuffer
+{
+public:
+  // Construct for the given buffer. The size includes the terminating null.
+  MVFormatBuffer (char* buf, size_t size)
+    : itsBuf (buf),
+      itsSize (size),
+      itsLen (0)
+  {}
+
+  // Put a character.
+  void put (char c)
+  {
+    if (itsLen+1 < itsSize) {
+      itsBuf[itsLen] = c;
+    }
+    itsLen++;
+  }
+
+  // Put a null-terminated string.
+  void put (const char* str)
+  {
+    while (*str) {
+      put (*str++);
+    }
+  }
+
+  // Put an integer in a field of the given width.
+  void putInt (Int64 value, uInt width, char fill)
+  {
+    char tmp[32];
+    char* end = tmp + sizeof(tmp) - 1;
+    *end = '\0';
+    char* p = putDigits (end, value < 0 ? 0-uInt64(value) : uInt64(value), 1);
+    if (value < 0) {
+      *--p = '-';
+    }
+    putField (p, end-p, width, fill);
+  }
+
+  // Put a value with the given number of decimals in a field of the
+  // given width filled with zeroes.
+  void putFixed (Double value, uInt ndec, uInt width)
+  {
+    // snprintf is slow, so the digits are made directly if it is sure the
+    // rounding is the same as done by snprintf (which uses the exact
+    // binary value). Because the scaled value is less than 1e9, its
+    // rounding error is less than 1e-7, so the rounding can only differ
+    // if the fraction is very close to 0.5. Then snprintf is used.
+    static const Double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6,
+                                   1e7, 1e8, 1e9};
+    Double scaled = (ndec <= 9  ?  value * pow10[ndec] : -1.);
+    if (scaled >= 0  &&  scaled < 1e9) {
+      Double ipart = std::floor (scaled);
+      Double frac = scaled - ipart;
+      if (std::abs (frac - 0.5) > 1e-6) {
+        uInt64 rounded = uInt64(ipart) + (frac > 0.5 ? 1 : 0);
+        uInt64 scale = uInt64(pow10[ndec]);
+        char tmp[32];
+        char* end = tmp + sizeof(tmp) - 1;
+        *end = '\0';
+        char* p = end;
+        if (ndec > 0) {
+          p = putDigits (p, rounded % scale, ndec);
+          *--p = '.';
+        }
+        p = putDigits (p, rounded / scale, 1);
+        putField (p, end-p, width, '0');
+        return;
+      }
+    }
+    char tmp[64];
+    int n = snprintf (tmp, sizeof(tmp), "%.*f", Int(ndec), value);
+    if (n < Int(sizeof(tmp))) {
+      putField (tmp, n, width, '0');
+    } else {
+      // Only a huge number of decimals does not fit.
+      std::vector<char> big(n+1);
+      snprintf (big.data(), big.size(), "%.*f", Int(ndec), value);
+      putField (big.data(), n, width, '0');
+    }
+  }
+
+  // Get the unused part of the buffer (including the place for the null),
+  // so another function can format into it. Thereafter <src>added</src>
+  // has to be called with the length of its output.
+  // <group>
+  char* freeBuf()
+    { return itsBuf + std::min (itsLen, itsSize); }
+  size_t freeSize() const
+    { return (itsLen < itsSize  ?  itsSize - itsLen : 0); }
+  void added (size_t n)
+    { itsLen += n; }
+  // </group>
+
+  // Null-terminate the buffer and return the length of the full output.
+  size_t finish()
+  {
+    if (itsSize > 0) {
+      itsBuf[std::min (itsLen, itsSize-1)] = '\0';
+    }
+    return itsLen;
+  }
+
+  // Format the values into consecutive fields of <src>width</src>
+  // characters (without null-terminating them). The value is formatted
+  // with the <src>format</src> function of class MV and right-adjusted
+  // in the field. A field is filled with asterisks if its value does not
+  // fit.
+  template<typename MV, typename FORMAT>
+  static void formatFields (char* buf, size_t width, const Double* values,
+                            size_t n, const FORMAT& form)
+  {
+    char tmp[MV::FormatSize];
+    for (size_t i=0; i<n; ++i) {
+      char* field = buf + i*width;
+      size_t len = MV(values[i]).format (tmp, sizeof(tmp), form);
+      if (len > width  ||  len >= sizeof(tmp)) {
+        std::fill (field, field+width, '*');
+      } else {
+        std::fill (field, field+width-len, ' ');
+        memcpy (field+width-len, tmp, len);
+      }
+    }
+  }
+
+private:
+  // Write the digits of the value backwards ending at <src>end</src>,
+  // at least <src>ndig</src> digits (thus with leading zeroes).
+  // It returns the start of the digits.
+  static char* putDigits (char* end, uInt64 value, uInt ndig)
+  {
+    char* p = end;
+    do {
+      *--p = char('0' + value%10);
+      value /= 10;
+    } while (value > 0  ||  uInt(end-p) < ndig);
+    return p;
+  }
+
+  void putField (const char* str, Int len, uInt width, char fill)
+  {
+    for (Int i=len; i<Int(width); ++i) {
+      put (fill);
+    }
+    put (str);
+  }
+
+  char*  itsBuf;
+  size_t itsSize;
+  size_t itsLen;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -28,13 +28,13 @@
 #include <casacore/casa/Quanta/MVAngle.h>
 #include <casacore/casa/Quanta/MVEpoch.h>
 #include <casacore/casa/Utilities/MUString.h>
-#include <casacore/casa/sstream.h>
-#include <casacore/casa/iomanip.h>
 #include <casacore/casa/OS/Time.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/BasicSL/Constants.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Quanta/MVFormatBuffer.h>
+#include <cstdlib>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -355,9 +355,15 @@ String MVTime::string(uInt intyp, uInt inprec) const {
 }
 
 String MVTime::string(const MVTime::Format &form) const {
-    ostringstream oss;
-    print (oss, form);
-    return oss;
+    char buf[FormatSize];
+    size_t n = format(buf, sizeof(buf), form);
+    if (n < sizeof(buf)) {
+      return String(buf, n);
+    }
+    // Only a very high precision does not fit in the buffer.
+    String str(n, ' ');
+    format(&(str[0]), n+1, form);
+    return str;
 }
 
 Double MVTime::timeZone() {
@@ -365,6 +371,20 @@ Double MVTime::timeZone() {
 }  
 void MVTime::print(ostream &oss,
 		    const MVTime::Format &form) const {
+    char buf[FormatSize];
+    size_t n = format(buf, sizeof(buf), form, oss.precision());
+    if (n < sizeof(buf)) {
+      oss << buf;
+    } else {
+      String str(n, ' ');
+      format(&(str[0]), n+1, form, oss.precision());
+      oss << str;
+    }
+}
+
+size_t MVTime::format(char *buf, size_t size,
+                      const MVTime::Format &form, uInt defPrec) const {
+    MVFormatBuffer out(buf, size);
     uInt inprec = form.prec;
     uInt intyp = form.typ;
     uInt i1 = intyp & ~MVTime::MOD_MASK;
@@ -381,59 +401,69 @@ void MVTime::print(ostream &oss,
     atmp(0.0);
 
     if ((intyp & MVTime::DAY) == MVTime::DAY) {
-      oss << loc.dayName();
+      out.put(loc.dayName().c_str());
       if (i1 == MVTime::YMD || i1 == MVTime::DMY ||
 	  i1 == MVTime::MJD ||
 	  (intyp & MVTime::NO_TIME) != MVTime::NO_TIME) {
         if (intyp & MVTime::USE_SPACE) {
-          oss << ' ';
+          out.put(' ');
         } else {
-          oss << '-';
+          out.put('-');
         }
       }
     }
     if (i1 == MVTime::YMD || i1 == MVTime::DMY || i1 == MVTime::FITS) {
       Int c,e,a;
       loc.ymd(c,e,a);			// y,m,d
-      Char sfill = oss.fill();
       if (i1 == MVTime::YMD) {
-	oss << setfill('0') << setw(4) << c << "/" << 
-	  setw(2) << e << "/" << 
-	  setw(2) << a;
+	out.putInt(c, 4, '0');
+	out.put('/');
+	out.putInt(e, 2, '0');
+	out.put('/');
+	out.putInt(a, 2, '0');
       } else if (i1 == MVTime::DMY) {
-	oss << setfill('0') << setw(2) << a << "-" <<
-	  setw(3) << monthName(e) << "-" <<
-	  setw(4) << c;
+	out.putInt(a, 2, '0');
+	out.put('-');
+	out.put(monthName(e).c_str());
+	out.put('-');
+	out.putInt(c, 4, '0');
       } else {				// FITS
-	oss << setfill('0') << setw(4) << c << "-" << 
-	  setw(2) << e << "-" << 
-	  setw(2) << a;
+	out.putInt(c, 4, '0');
+	out.put('-');
+	out.putInt(e, 2, '0');
+	out.put('-');
+	out.putInt(a, 2, '0');
       }
       if ((intyp & MVTime::NO_TIME) != MVTime::NO_TIME) {
         if (intyp & MVTime::USE_SPACE) {
-          oss << ' ';
+          out.put(' ');
 	} else if (i1 == MVTime::FITS) {
-	  oss << "T";
+	  out.put('T');
 	} else {
-	  oss << "/";
+	  out.put('/');
 	}
       }
-      oss.fill(sfill);
     }
     if (i1 == MVTime::MJD) {
       Int c = ifloor(loc);
-      oss << c;
+      out.putInt(c, 0, ' ');
       if ((intyp & MVTime::NO_TIME) != MVTime::NO_TIME) {
-	oss << "/";
+	out.put('/');
       }
     }
     if ((intyp & MVTime::NO_TIME) != MVTime::NO_TIME) {
 	MVAngle::Format ftmp((MVAngle::formatTypes) intyp, inprec);
-	atmp.print(oss, ftmp);
+	out.added(atmp.format(out.freeBuf(), out.freeSize(), ftmp, defPrec));
     }
     if ((intyp & MVTime::USE_Z) == MVTime::USE_Z) {
-        oss << 'Z';
+        out.put('Z');
     }
+    return out.finish();
+}
+
+void MVTime::format(char *buf, size_t width, const Double *mjd, size_t n,
+                    const MVTime::Format &form) {
+  MVFormatBuffer::formatFields<MVTime> (buf, width, mjd, n, form);
 }
 
 Bool MVTime::read(Quantity &res, MUString &in, Bool chk) {
@@ -586,6 +616,112 @@ Bool MVTime::read(Quantity &res, const String &in, Bool chk, Bool throwExcp) {
   return True;
 }
 
+Bool MVTime::read(MVTime &res, const String &in) {
+  Double mjd;
+  if (readFast(mjd, in)) {
+    res = mjd;
+    return True;
+  }
+  Quantity q;
+  if (!read(q, in)) {
+    return False;
+  }
+  res = MVTime(q);
+  return True;
+}
+
+size_t MVTime::read(MVTime *res, const String *in, size_t n) {
+  for (size_t i=0; i<n; ++i) {
+    if (!read(res[i], in[i])) {
+      return i;
+    }
+  }
+  return n;
+}
+
+namespace {
+  // Get an unsigned integer of at most 9 digits.
+  Bool getDigits(const char *&p, const char *end, Int &value) {
+    const char *start = p;
+    value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+      value = value*10 + (*p++ - '0');
+    }
+    return (p > start && p - start <= 9);
+  }
+}
+
+Bool MVTime::readFast(Double &mjd, const String &in) {
+  // The arithmetic is done in the same order as in the general read
+  // function (via MVAngle::read and Quantity), so the result is exactly
+  // the same. Anything deviating from the common formats is left to the
+  // general read function.
+  const char *p = in.c_str();
+  const char *end = p + in.size();
+  Int yy, mm, dd;
+  if (!getDigits(p, end, yy) || p == end) return False;
+  Char sep = *p++;
+  // A year below 1000 means dd-mm-yy.
+  if (!((sep == '-' && yy > 1000) || sep == '/')) return False;
+  if (!getDigits(p, end, mm) || p == end || *p++ != sep) return False;
+  if (!getDigits(p, end, dd)) return False;
+  Double frac = 0;
+  if (p < end) {
+    Char tsep = *p++;
+    if (tsep == ' ') {
+      while (p < end && *p == ' ') p++;
+    } else if (tsep != 'T' && tsep != '/' && tsep != '-') {
+      return False;
+    }
+    Int h, m;
+    if (!getDigits(p, end, h) || p == end || *p++ != ':' ||
+	!getDigits(p, end, m)) {
+      return False;
+    }
+    Double r = h;
+    if (p < end && *p == ':') {
+      const char *sec = ++p;
+      Int ival;
+      if (!getDigits(p, end, ival)) return False;
+      if (p < end && *p == '.') {
+	p++;
+	while (p < end && *p >= '0' && *p <= '9') p++;
+      }
+      if (p < end && (*p == 'e' || *p == 'E')) return False;
+      char *secEnd;
+      Double s = strtod(sec, &secEnd);
+      if (secEnd != p) return False;
+      r += m/60.0 + s/3600.;
+    } else {
+      r += m/60.0;
+    }
+    frac = ((r/240.)*3600.)/360.;
+    if (tsep == 'T' && p < end) {
+      if (*p == '+' || *p == '-') {
+	// Time zone
+	Double s = (*p++ == '-'  ?  -1 : 1);
+	Int tzh;
+	if (!getDigits(p, end, tzh)) return False;
+	Double tz = tzh;
+	if (p < end && *p == ':') {
+	  p++;
+	  Int tzm;
+	  if (!getDigits(p, end, tzm)) return False;
+	  tz += Double(tzm)/60.0;
+	}
+	frac -= s*tz/24.0;
+      } else if (*p == 'Z') {
+	p++;
+      }
+    }
+    if (p != end) return False;
+  }
+  Double day = frac + MVTime(yy, mm, Double(dd)).val;
+  // Convert like MVTime(Quantity) does.
+  mjd = (day * C::day) / C::day;
+  return True;
+}
+
 ostream &operator<<(ostream &os, const MVTime &meas) {
     if (MVTime::interimSet) {
 	MVTime::interimSet = False;
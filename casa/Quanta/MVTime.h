@@ -203,10 +203,14 @@ class Time;
 // formats. <br>
 // For other formatting practice, the output can be written to a String with
 // the string() member functions.<br>
+// For listings of many values the format() member functions can be used.
+// They format into a buffer given by the caller, so no String or stream is
+// created. The static format function does so for an array of values.<br>
 // Note that using a temporary format is inherently thread-unsafe because
 // the format is kept in a static variable. Another thread may overwrite
 // the format just set. The only thread-safe way to format an MVTime is using
-// a <src>print</src> or <src>string</src> that accepts a Format object.
+// a <src>print</src>, <src>string</src> or <src>format</src> that accepts
+// a Format object.
 //
 // Strings and input can be converted to an MVTime (or Quantity) by
 // <src>Bool read(Quantity &out, const String &in)</src> and
@@ -241,6 +245,11 @@ class Time;
 //				is not part of the FITS standard, but of the
 //				underlying ISO standard.</note>
 // </ul>
+// The function <src>read(MVTime&, const String&)</src> converts the
+// common formats <src>ccyy-mm-dd[Thh:mm[:ss[.s]]][Z|+-hh[:mm]]</src> and
+// <src>yyyy/mm/dd[/hh:mm[:ss[.s]]]</src> directly, without creating
+// MUString and Quantity objects. Other strings are converted by the
+// general read function. Another overload converts an array of strings.
 // The time can be expressed as described in 
 // <linkto class=MVAngle>MVAngle</linkto>
 // Examples of valid strings:
@@ -269,6 +278,10 @@ class MVTime {
 
     public:
 
+// Size of a buffer large enough to format a time
+// (with a precision up to 40).
+    static const size_t FormatSize = 96;
+
 //# Enumerations
 // Format types
     enum formatTypes {
@@ -372,6 +385,15 @@ class MVTime {
   static Bool read(Quantity &res, const String &in, Bool chk, Bool throwExcp);
   static Bool read(Quantity &res, MUString &in, Bool chk, Bool throwExcp);
   // </group>
+  // Make res from a date/time string. It gives the same result as
+  // <src>read(Quantity&, const String&)</src> followed by a conversion to
+  // MVTime, but common date/time formats are converted much faster.
+  // It returns False in case of an error.
+  static Bool read(MVTime &res, const String &in);
+  // Convert an array of <src>n</src> date/time strings like the function
+  // above. It stops at the first invalid string and returns the number
+  // of strings converted, thus <src>n</src> if all are valid.
+  static size_t read(MVTime *res, const String *in, size_t n);
 // Get value of date/time (MJD) in given units
 // <group>
     Double day() const;
@@ -412,6 +434,23 @@ class MVTime {
     String string(const MVTime::Format &form) const;
     void print(ostream &oss, const MVTime::Format &form) const;
 // </group>
+// Format the time into a buffer of the given size without creating a
+// String or stream, which is much faster than <src>string</src>.
+// The output is the same as that of <src>string(form)</src>, but a
+// precision of 0 in the format means <src>defPrec</src> digits.
+// Like <src>snprintf</src> the output is null-terminated and truncated
+// if the buffer is too small, and the length of the full output is
+// returned. A buffer of <src>FormatSize</src> characters is large
+// enough for a precision up to 40.
+    size_t format(char *buf, size_t size, const MVTime::Format &form,
+                  uInt defPrec=6) const;
+// Format the times (in MJD) of an array into consecutive fields of
+// <src>width</src> characters in the buffer, which must have
+// <src>n*width</src> characters. The fields are right-adjusted and not
+// null-terminated; a field is filled with asterisks if the value does not
+// fit. It can be used to format a column of a listing at once.
+    static void format(char *buf, size_t width, const Double *mjd, size_t n,
+                       const MVTime::Format &form);
 // Set default format
 // <note role=warning>
 // It is thread-unsafe to print using the setFormat functions because they
@@ -447,6 +486,9 @@ static Double timeZone();
 //# Member functions
   // Get the y,m,d values
   void ymd(Int &yyyy, Int &mm, Int &dd) const;
+  // Convert the common date/time formats without MUString.
+  // False is returned if the string has another format.
+  static Bool readFast(Double &mjd, const String &in);
 };
 
 // Global functions.
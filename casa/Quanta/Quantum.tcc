@@ -220,8 +220,8 @@ Qtype & Quantum<Qtype>::getValue() {
 
 template <class Qtype>
 Qtype Quantum<Qtype>::getValue(const Unit &other, Bool requireConform) const {
-    UnitVal myType = qUnit.getValue();
-    UnitVal otherType = other.getValue();
+    const UnitVal& myType = qUnit.getValue();
+    const UnitVal& otherType = other.getValue();
 	Double myFac = myType.getFac();
 	Double otherFac = otherType.getFac();
 	Double d1 = otherFac/myFac;
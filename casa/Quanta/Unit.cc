@@ -27,6 +27,7 @@
 
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/Quanta/Unit.h>
+#include <casacore/casa/Quanta/UnitMap.h>
 #include <casacore/casa/Utilities/Regex.h>
 #include <casacore/casa/OS/malloc.h>
 #include <stdlib.h>
@@ -217,6 +218,11 @@ void pass_two( char *source, char *dest )
 
 void Unit::check()
 {
+  // A Unit made before from the same string can be taken from the cache.
+  if (UnitMap::getCache(uName, *this)) {
+    return;
+  }
+  const String given(uName);
   if (!UnitVal::check(uName, uVal)) {
     throw (AipsError("Unit::check Illegal unit string '" +
 		     uName + "'"));
@@ -241,6 +247,7 @@ void Unit::check()
     free(b1);
     free(b2);
   }
+  UnitMap::putCache(given, *this);
 }
 
 } //# NAMESPACE CASACORE - END
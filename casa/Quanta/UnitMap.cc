@@ -29,11 +29,51 @@
 #include <casacore/casa/Utilities/MUString.h>
 #include <casacore/casa/Utilities/Regex.h>
 #include <casacore/casa/iostream.h>
+#include <unordered_map>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 // Initialize statics.
 std::mutex UnitMap::fitsMutex;
+std::mutex UnitMap::cacheMutex;
+std::atomic<uInt> UnitMap::cacheGeneration(0);
+
+namespace {
+  // The maximum number of entries in each of a thread's caches.
+  const size_t maxThreadUnits = 1000;
+
+  // Add an entry to a thread's cache. The cache is cleared when full,
+  // so a thread parsing many different unit strings cannot grow it forever.
+  template <typename T>
+  void putThreadCache (std::unordered_map<String, T>& cache,
+                       const String& s, const T& value)
+  {
+    if (cache.size() >= maxThreadUnits) {
+      cache.clear();
+    }
+    cache.insert (std::make_pair(s, value));
+  }
+
+  // The cache of a thread. It is cleared when the generation of the
+  // shared cache has changed.
+  struct ThreadUnitCache {
+    ThreadUnitCache() : generation(0) {}
+    uInt generation;
+    std::unordered_map<String, UnitVal> vals;
+    std::unordered_map<String, Unit> units;
+  };
+
+  ThreadUnitCache& threadUnitCache (uInt generation)
+  {
+    thread_local ThreadUnitCache cache;
+    if (cache.generation != generation) {
+      cache.vals.clear();
+      cache.units.clear();
+      cache.generation = generation;
+    }
+    return cache;
+  }
+}
 
 
   
@@ -44,13 +84,35 @@ UnitMap::~UnitMap() {
 }
 
 Bool UnitMap::getCache(const String& s, UnitVal &val) {
-  map<String, UnitVal>& mapCache = getMapCache();
-  map<String, UnitVal>::iterator pos = mapCache.find(s);
-  if (pos == mapCache.end()) {
-    val = UnitVal();
+  // Look in the thread's cache first, so no locking is needed.
+  ThreadUnitCache& tcache = threadUnitCache (cacheGeneration.load());
+  std::unordered_map<String, UnitVal>::const_iterator tpos =
+    tcache.vals.find(s);
+  if (tpos != tcache.vals.end()) {
+    val = tpos->second;
+    return True;
+  }
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    map<String, UnitVal>& mapCache = getMapCache();
+    map<String, UnitVal>::iterator pos = mapCache.find(s);
+    if (pos == mapCache.end()) {
+      val = UnitVal();
+      return False;
+    }
+    val = pos->second;
+  }
+  putThreadCache (tcache.vals, s, val);
+  return True;
+}
+
+Bool UnitMap::getCache(const String& s, Unit &unit) {
+  ThreadUnitCache& tcache = threadUnitCache (cacheGeneration.load());
+  std::unordered_map<String, Unit>::const_iterator pos = tcache.units.find(s);
+  if (pos == tcache.units.end()) {
     return False;
   }
-  val = pos->second;
+  unit = pos->second;
   return True;
 }
 
@@ -86,12 +148,21 @@ Bool UnitMap::getUnit(const String& s, UnitName &name, UMaps* maps) {
 }
 
 void UnitMap::putCache(const String& s, const UnitVal& val) {
-  map<String, UnitVal>& mapCache = getMapCache();
   if (! s.empty()) {
-    mapCache.insert(map<String, UnitVal>::value_type(s,val));
+    ThreadUnitCache& tcache = threadUnitCache (cacheGeneration.load());
+    {
+      std::lock_guard<std::mutex> lock(cacheMutex);
+      getMapCache().insert(map<String, UnitVal>::value_type(s,val));
+    }
+    putThreadCache (tcache.vals, s, val);
   }
 }
 
+void UnitMap::putCache(const String& s, const Unit& unit) {
+  ThreadUnitCache& tcache = threadUnitCache (cacheGeneration.load());
+  putThreadCache (tcache.units, s, unit);
+}
+
 void UnitMap::putUser(const String& s, const UnitVal& val) {
   const String empty("");
   UnitMap::putUser(s, val, empty);
@@ -259,7 +330,9 @@ Unit UnitMap::toFITS(const Unit &un) {
 }
 
 void UnitMap::clearCache() {
+  std::lock_guard<std::mutex> lock(cacheMutex);
   getMapCache().clear();
+  cacheGeneration++;
 }
 
 void UnitMap::listPref() {
@@ -345,6 +418,7 @@ void UnitMap::listCache() {
 }
 
 void UnitMap::listCache(ostream &os) {
+  std::lock_guard<std::mutex> lock(cacheMutex);
   map<String, UnitVal>& mapCache = getMapCache();
   os  << "Cached unit table (" << mapCache.size() << "):" << endl;
   for (map<String, UnitVal>::iterator i=mapCache.begin();
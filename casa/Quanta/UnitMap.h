@@ -36,6 +36,7 @@
 #include <casacore/casa/Quanta/UnitVal.h>
 #include <casacore/casa/Quanta/UnitName.h>
 
+#include <atomic>
 #include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -181,6 +182,17 @@ const uInt N_FITS = 19;
 // <srcblock>
 // UnitMap::clearCache();
 // </srcblock>
+//
+// The cache is thread-safe. It consists of a cache shared by all threads
+// (protected by a mutex) and a cache per thread which is searched first,
+// so a thread does not need to lock once it has used a unit string.
+// Besides the UnitVal of a unit string, the per-thread cache holds the
+// <linkto class=Unit>Unit</linkto> made from it, so constructing a Unit
+// from a string used before costs a single hash lookup.
+// Clearing the cache (explicitly or by redefining a user unit) makes all
+// threads clear their cache before its next use.
+// Note that the maps of known units are not locked, so defining user units
+// should not be done while other threads use units.
 // </synopsis> 
 //
 // <example>
@@ -229,11 +241,17 @@ public:
 
     // Get a cached definition
     static Bool getCache(const String &s, UnitVal &val);
+
+    // Get the cached Unit made from a unit string.
+    static Bool getCache(const String &s, Unit &unit);
     
     // </group>
-    // Save a definition of a full unit name in the cache (the cache will be
-    // cleared if getting too large (200 entries)
+    // Save a definition of a full unit name in the cache.
     static void putCache(const String &s, const UnitVal &val);
+
+    // Save the Unit made from a unit string in the cache of this thread
+    // (the thread's Unit cache is cleared if getting too large).
+    static void putCache(const String &s, const Unit &unit);
     
     // Define a user defined standard unit. If the unit is being redefined, and it
     // has already been used in a user's <src>Unit</src> variable, the value
@@ -275,7 +293,7 @@ public:
     static void list();
   // </group>
 
-// List all units in cache
+// List all units in the shared cache
   // <group>
     static void listCache(ostream &os);
     static void listCache();
@@ -313,6 +331,8 @@ public:
 // </group>
 
   // Return the different maps
+  // (giveCache returns the shared cache; it should not be used while
+  // other threads are using units).
   // <group>
   static const map<String, UnitName> &givePref();
   static const map<String, UnitName> &giveDef();
@@ -332,6 +352,11 @@ public:
   UnitMap &operator=(const UnitMap &other);
   
   static std::mutex fitsMutex;
+  // Mutex protecting the shared unit cache.
+  static std::mutex cacheMutex;
+  // The generation of the cache. It is incremented by clearCache, which
+  // tells the per-thread caches to clear themselves.
+  static std::atomic<uInt> cacheGeneration;
   
   //# member functions
   // Get the static UMaps struct.
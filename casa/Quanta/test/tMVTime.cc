@@ -27,6 +27,7 @@
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/Quanta/MVTime.h>
+#include <casacore/casa/Quanta/MVAngle.h>
 #include <casacore/casa/BasicMath/Math.h>
 
 #include <casacore/casa/namespace.h>
@@ -53,6 +54,109 @@ void checkTime (const String& str, uInt yy, uInt mm, uInt dd,
   AlwaysAssertExit (tm.minutes() == m);
   AlwaysAssertExit (tm.seconds() == s);
   AlwaysAssertExit (nearAbs(tm.dseconds(), s+ss, 1e-4));
+  // The direct conversion must give exactly the same result.
+  if (chk) {
+    MVTime mvtm2;
+    AlwaysAssertExit (MVTime::read(mvtm2, str));
+    AlwaysAssertExit (mvtm2.day() == mvtm.day());
+  }
+}
+
+// Check that the direct conversion of strings gives the same result as
+// the conversion via Quantity.
+void checkRead (const String& str)
+{
+  Quantity q;
+  Bool ok = MVTime::read(q, str);
+  MVTime mvtm;
+  AlwaysAssertExit (MVTime::read(mvtm, str) == ok);
+  if (ok) {
+    AlwaysAssertExit (mvtm.day() == MVTime(q).day());
+  }
+}
+
+void testRead()
+{
+  const uInt types[] = {MVTime::FITS, MVTime::YMD, MVTime::ISO,
+                        MVTime::YMD_ONLY, MVTime::FITS+MVTime::NO_TIME,
+                        MVTime::YMD+MVTime::CLEAN};
+  const char* zones[] = {"", "Z", "+05:30", "-3", "-11:15"};
+  for (uInt i=0; i<500; ++i) {
+    MVTime time(-100000 + i*531.123456789);
+    for (uInt j=0; j<sizeof(types)/sizeof(types[0]); ++j) {
+      for (uInt prec=4; prec<14; prec+=3) {
+        String str = time.string(types[j], prec);
+        checkRead (str);
+        if (types[j] == MVTime::FITS) {
+          checkRead (str + zones[i%5]);
+        }
+      }
+    }
+  }
+  checkRead ("2017-07-01T11:57:01.5e1");
+  checkRead ("2017-07-01T11:57:.5");
+  checkRead ("2017-07-01T11:57:0x1");
+  checkRead ("2017-07-01 11:57");
+  checkRead ("2017-07-01-11:57:00");
+  checkRead ("2017/07/01.5");
+  checkRead ("2017/07/01/11:57Z");
+  checkRead ("2017-13-01");
+  checkRead ("2017-07-01T");
+  checkRead ("2017-07-01T11");
+  checkRead ("2017-07-01T11:57+");
+  checkRead ("12-07-01");
+  checkRead ("51544.5d");
+  // An array of strings.
+  String strs[] = {"2017-07-01", "2017-07-01T11:57", "x", "2017/07/01"};
+  MVTime times[4];
+  AlwaysAssertExit (MVTime::read(times, strs, 2) == 2);
+  AlwaysAssertExit (MVTime::read(times, strs, 4) == 2);
+  AlwaysAssertExit (nearAbs(times[1].day() - times[0].day(), (11+57/60.)/24,
+                            1e-9));
+}
+
+void testFormat()
+{
+  const uInt types[] = {MVTime::TIME, MVTime::ANGLE, MVTime::YMD,
+                        MVTime::DMY+MVTime::DAY, MVTime::FITS, MVTime::ISO,
+                        MVTime::MJD, MVTime::BOOST, MVTime::TIME_CLEAN_NO_H};
+  char buf[MVTime::FormatSize];
+  for (uInt i=0; i<100; ++i) {
+    MVTime time(-1000 + i*1234.5678901);
+    for (uInt j=0; j<sizeof(types)/sizeof(types[0]); ++j) {
+      for (uInt prec=0; prec<12; ++prec) {
+        String str = time.string(types[j], prec);
+        size_t n = time.format(buf, sizeof(buf),
+                               MVTime::Format(types[j], prec));
+        AlwaysAssertExit (n == str.size()  &&  str == buf);
+        MVAngle angle(time.day());
+        str = angle.string(types[j] & MVAngle::TIME, prec);
+        n = angle.format(buf, sizeof(buf),
+                         MVAngle::Format(types[j] & MVAngle::TIME, prec));
+        AlwaysAssertExit (n == str.size()  &&  str == buf);
+      }
+    }
+  }
+  // A buffer that is too small.
+  MVTime time(51544.5);
+  MVTime::Format fmt(MVTime::YMD, 9);
+  AlwaysAssertExit (time.string(fmt) == "2000/01/01/12:00:00.000");
+  AlwaysAssertExit (time.format(buf, 8, fmt) == 23);
+  AlwaysAssertExit (String(buf) == "2000/01");
+  // The default precision.
+  AlwaysAssertExit (time.format(buf, sizeof(buf), MVTime::Format(), 4) == 6);
+  AlwaysAssertExit (String(buf) == "12:00:");
+  // Fields of an array.
+  Double mjds[] = {51544.5, 51544.75, 51545};
+  char fields[3*10+1];
+  fields[30] = '\0';
+  MVTime::format(fields, 10, mjds, 3, MVTime::Format(MVTime::TIME, 6));
+  AlwaysAssertExit (String(fields) == "  12:00:00  18:00:00  00:00:00");
+  MVTime::format(fields, 6, mjds, 3, MVTime::Format(MVTime::TIME, 6));
+  AlwaysAssertExit (String(fields, 18) == "******************");
+  Double rads[] = {C::pi/4, -C::pi/2};
+  MVAngle::format(fields, 12, rads, 2, MVAngle::Format(MVAngle::ANGLE, 6));
+  AlwaysAssertExit (String(fields, 24) == "  +045.00.00  -090.00.00");
 }
 
 void checkExcp (const String& str)
@@ -71,6 +175,8 @@ void checkExcp (const String& str)
 int main ()
 {
   try {
+    testRead();
+    testFormat();
     Quantity q;
     AlwaysAssertExit (MVTime::read (q, ""));
     AlwaysAssertExit (! MVTime::read (q, "20Nov96-5h20"));
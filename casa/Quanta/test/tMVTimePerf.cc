@@ -0,0 +1,134 @@
+//# tMVTimePerf.cc: Measure the performance of MVTime formatting and parsing
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/Quanta/MVTime.h>
+#include <casacore/casa/Quanta/MVAngle.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+using namespace casacore;
+
+// This program measures the time to format times and angles as strings
+// (with the String and buffer functions) and to convert strings to times
+// (via Quantity and directly).
+// The number of values can be given as the first argument.
+
+double elapsed (const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double>
+    (std::chrono::steady_clock::now() - start).count();
+}
+
+void report (const char* name, size_t n, double sec)
+{
+  cout << "  " << name << ": " << sec << " sec  "
+       << sec / n * 1e9 << " ns/value" << endl;
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    uInt n = 1000000;
+    if (argc > 1) {
+      n = atoi(argv[1]);
+    }
+    std::vector<Double> mjds(n);
+    for (uInt i=0; i<n; ++i) {
+      mjds[i] = 58000 + i * 1.23456789e-3;
+    }
+    cout << n << " values" << endl;
+    MVTime::Format timeFmt(MVTime::TIME, 9);
+    MVTime::Format fitsFmt(MVTime::FITS, 9);
+    MVAngle::Format angleFmt(MVAngle::ANGLE, 9);
+    size_t nchar = 0;
+    // Format times as String.
+    auto start = std::chrono::steady_clock::now();
+    for (uInt i=0; i<n; ++i) {
+      nchar += MVTime(mjds[i]).string(timeFmt).size();
+    }
+    report ("MVTime::string (TIME)        ", n, elapsed(start));
+    // Format times into a buffer.
+    char buf[MVTime::FormatSize];
+    start = std::chrono::steady_clock::now();
+    for (uInt i=0; i<n; ++i) {
+      nchar -= MVTime(mjds[i]).format(buf, sizeof(buf), timeFmt);
+    }
+    report ("MVTime::format (TIME)        ", n, elapsed(start));
+    AlwaysAssertExit (nchar == 0);
+    // Format times into fields.
+    std::vector<char> fields(n*16);
+    start = std::chrono::steady_clock::now();
+    MVTime::format (fields.data(), 16, mjds.data(), n, timeFmt);
+    report ("MVTime::format fields (TIME) ", n, elapsed(start));
+    // Format as FITS.
+    std::vector<String> strs(n);
+    start = std::chrono::steady_clock::now();
+    for (uInt i=0; i<n; ++i) {
+      strs[i] = MVTime(mjds[i]).string(fitsFmt);
+    }
+    report ("MVTime::string (FITS)        ", n, elapsed(start));
+    start = std::chrono::steady_clock::now();
+    for (uInt i=0; i<n; ++i) {
+      MVTime(mjds[i]).format(buf, sizeof(buf), fitsFmt);
+    }
+    report ("MVTime::format (FITS)        ", n, elapsed(start));
+    // Format angles.
+    start = std::chrono::steady_clock::now();
+    for (uInt i=0; i<n; ++i) {
+      nchar += MVAngle(mjds[i]).string(angleFmt).size();
+    }
+    report ("MVAngle::string              ", n, elapsed(start));
+    start = std::chrono::steady_clock::now();
+    for (uInt i=0; i<n; ++i) {
+      nchar -= MVAngle(mjds[i]).format(buf, sizeof(buf), angleFmt);
+    }
+    report ("MVAngle::format              ", n, elapsed(start));
+    AlwaysAssertExit (nchar == 0);
+    // Convert the FITS strings back via Quantity.
+    std::vector<MVTime> times(n);
+    start = std::chrono::steady_clock::now();
+    for (uInt i=0; i<n; ++i) {
+      Quantity q;
+      AlwaysAssertExit (MVTime::read (q, strs[i]));
+      times[i] = MVTime(q);
+    }
+    report ("MVTime::read (Quantity)      ", n, elapsed(start));
+    // Convert them directly.
+    std::vector<MVTime> times2(n);
+    start = std::chrono::steady_clock::now();
+    AlwaysAssertExit (MVTime::read (times2.data(), strs.data(), n) == n);
+    report ("MVTime::read (MVTime array)  ", n, elapsed(start));
+    for (uInt i=0; i<n; ++i) {
+      AlwaysAssertExit (times[i].day() == times2[i].day());
+    }
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,166 @@
+//# tUnitCache.cc: Test the thread-safe unit cache
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/Quanta/UnitMap.h>
+#include <casacore/casa/Quanta/Quantum.h>
+#include <casacore/casa/Quanta/Unit.h>
+#include <casacore/casa/BasicMath/Math.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <thread>
+#include <vector>
+
+using namespace casacore;
+
+// The unit strings used and their factors.
+const char* const theUnits[] = {"km/s", "deg", "Jy/beam_t", "MHz", "h",
+                                "m.s-2", "mas", "kg.m2", "km**2 / s"};
+const Double theFactors[] = {1e3, C::pi/180, 1e-26, 1e6, 3600,
+                             1, C::pi/180/3600e3, 1, 1e6};
+const uInt theNunit = sizeof(theUnits) / sizeof(theUnits[0]);
+
+// Parse the units many times and check the result.
+void parseUnits (uInt seed, Bool& ok)
+{
+  ok = True;
+  for (uInt i=0; i<20000; ++i) {
+    uInt inx = (i+seed) % theNunit;
+    Unit unit(theUnits[inx]);
+    if (!near (unit.getValue().getFac(), theFactors[inx])) {
+      ok = False;
+    }
+    Quantity q(2, unit);
+    if (!near (q.getValue(theUnits[inx]), 2.)  ||
+        !near (q.getBaseValue(), 2 * theFactors[inx])) {
+      ok = False;
+    }
+  }
+}
+
+void testThreads()
+{
+  UnitMap::putUser ("beam_t", UnitVal(1.0, "sr"), "test beam");
+  const uInt nthread = 8;
+  std::vector<std::thread> threads;
+  Bool ok[nthread];
+  for (uInt i=0; i<nthread; ++i) {
+    threads.push_back (std::thread(parseUnits, i, std::ref(ok[i])));
+  }
+  for (uInt i=0; i<nthread; ++i) {
+    threads[i].join();
+    AlwaysAssertExit (ok[i]);
+  }
+  // All strings are in the shared cache now.
+  AlwaysAssertExit (UnitMap::giveCache().find("km/s") !=
+                    UnitMap::giveCache().end());
+}
+
+void testNormalise()
+{
+  // The cached Unit keeps the normalised name.
+  for (uInt i=0; i<2; ++i) {
+    Unit unit("km**2 / s");
+    AlwaysAssertExit (unit.getName() == "km2/s");
+    AlwaysAssertExit (near (unit.getValue().getFac(), 1e6));
+  }
+  // Illegal units are not cached.
+  for (uInt i=0; i<2; ++i) {
+    Bool failed = False;
+    try {
+      Unit unit("km/xyzzy");
+    } catch (const AipsError&) {
+      failed = True;
+    }
+    AlwaysAssertExit (failed);
+  }
+}
+
+void testManyUnits()
+{
+  // Use more different unit strings than fit in a thread's cache,
+  // so it gets cleared (twice to use them after the clears).
+  const char* const prefix[] = {"k", "M", "G", "m", "u", "n", "c", "d"};
+  const Double pfactor[] = {1e3, 1e6, 1e9, 1e-3, 1e-6, 1e-9, 1e-2, 1e-1};
+  for (uInt pass=0; pass<2; ++pass) {
+    for (uInt i=0; i<8; ++i) {
+      for (Int e1=1; e1<=5; ++e1) {
+        for (uInt j=0; j<8; ++j) {
+          for (Int e2=1; e2<=5; ++e2) {
+            String str = String(prefix[i]) + "m" + String::toString(e1) +
+              "." + prefix[j] + "s-" + String::toString(e2);
+            Double fac = pow(pfactor[i], e1) / pow(pfactor[j], e2);
+            AlwaysAssertExit (near (Unit(str).getValue().getFac(), fac));
+            AlwaysAssertExit (near (Quantity(1, str).getBaseValue(), fac));
+          }
+        }
+      }
+    }
+  }
+}
+
+void testRedefine()
+{
+  // Removing a user unit clears the cache of all threads.
+  UnitMap::putUser ("tst_u", UnitVal(2.0, "m"));
+  AlwaysAssertExit (near (Unit("km/tst_u").getValue().getFac(), 500.));
+  Double fac = 0;
+  std::thread thr([&fac]() {fac = Unit("km/tst_u").getValue().getFac();});
+  thr.join();
+  AlwaysAssertExit (near (fac, 500.));
+  UnitMap::removeUser ("tst_u");
+  UnitMap::putUser ("tst_u", UnitVal(4.0, "m"));
+  AlwaysAssertExit (near (Unit("km/tst_u").getValue().getFac(), 250.));
+  std::thread thr2([&fac]() {fac = Unit("km/tst_u").getValue().getFac();});
+  thr2.join();
+  AlwaysAssertExit (near (fac, 250.));
+  UnitMap::removeUser ("tst_u");
+  Bool failed = False;
+  try {
+    Unit unit("km/tst_u");
+  } catch (const AipsError&) {
+    failed = True;
+  }
+  AlwaysAssertExit (failed);
+  // Clearing the cache keeps the units usable.
+  UnitMap::clearCache();
+  AlwaysAssertExit (UnitMap::giveCache().empty());
+  AlwaysAssertExit (near (Quantity(1, "deg").getValue("arcsec"), 3600.));
+}
+
+int main()
+{
+  try {
+    testThreads();
+    testNormalise();
+    testManyUnits();
+    testRedefine();
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,130 @@
+//# tUnitPerf.cc: Measure the performance of unit parsing and conversion
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/casa/Quanta/Quantum.h>
+#include <casacore/casa/Quanta/Unit.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/iostream.h>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace casacore;
+
+// This program measures the time of unit parsing and quantity conversion
+// when done by 1, 2, 4 and 8 threads simultaneously. The number of
+// iterations per thread can be given as the first argument.
+// Each thread does the same amount of work, so with perfect scaling the
+// elapsed time does not change with the number of threads (given enough
+// cores).
+
+// The unit strings used; they are cycled through.
+const char* const theUnits[] = {"km/s", "deg", "Jy/beam", "MHz", "h",
+                                "m.s-2", "mas", "kg.m2"};
+const uInt theNunit = sizeof(theUnits) / sizeof(theUnits[0]);
+
+// Construct Units from strings.
+void parseUnits (uInt niter, Double& result)
+{
+  Double sum = 0;
+  for (uInt i=0; i<niter; ++i) {
+    Unit unit(theUnits[i%theNunit]);
+    sum += unit.getValue().getFac();
+  }
+  result = sum;
+}
+
+// Convert quantities given a unit string (thus parsing it).
+void convertString (uInt niter, Double& result)
+{
+  Quantity freq(1.4, "GHz");
+  Quantity angle(12.5, "deg");
+  Double sum = 0;
+  for (uInt i=0; i<niter; ++i) {
+    sum += freq.getValue ("MHz");
+    sum += angle.getValue ("h");
+  }
+  result = sum;
+}
+
+// Convert quantities given a Unit object.
+void convertUnit (uInt niter, Double& result)
+{
+  Quantity freq(1.4, "GHz");
+  Quantity angle(12.5, "deg");
+  Unit mhz("MHz");
+  Unit hour("h");
+  Double sum = 0;
+  for (uInt i=0; i<niter; ++i) {
+    sum += freq.getValue (mhz);
+    sum += angle.getValue (hour);
+  }
+  result = sum;
+}
+
+// Run the function in the given number of threads and report the time
+// per operation.
+void run (const char* name, void (*func)(uInt, Double&), uInt nop,
+          uInt nthread, uInt niter)
+{
+  std::vector<Double> results(nthread);
+  std::vector<std::thread> threads;
+  auto start = std::chrono::steady_clock::now();
+  for (uInt i=0; i<nthread; ++i) {
+    threads.push_back (std::thread(func, niter, std::ref(results[i])));
+  }
+  for (uInt i=0; i<nthread; ++i) {
+    threads[i].join();
+  }
+  double sec = std::chrono::duration<double>
+    (std::chrono::steady_clock::now() - start).count();
+  for (uInt i=1; i<nthread; ++i) {
+    AlwaysAssertExit (results[i] == results[0]);
+  }
+  cout << "  " << name << " threads=" << nthread << ": " << sec << " sec  "
+       << sec / niter / nop * 1e9 << " ns/op  "
+       << Double(nthread) * niter * nop / sec / 1e6 << " Mop/s" << endl;
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    uInt niter = 1000000;
+    if (argc > 1) {
+      niter = atoi(argv[1]);
+    }
+    cout << niter << " iterations per thread" << endl;
+    for (uInt nthread=1; nthread<=8; nthread*=2) {
+      run ("Unit(string)           ", parseUnits, 1, nthread, niter);
+      run ("Quantity::getValue(str)", convertString, 2, nthread, niter);
+      run ("Quantity::getValue(Unit)", convertUnit, 2, nthread, niter);
+    }
+  } catch (const std::exception& x) {
+    cout << "Unexpected exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -151,6 +151,26 @@ uInt64 SortKey::tryGenSort (Vector<uInt64>& indexVector, uInt64 nrrec, int opt)
     return 0;
 }
 
+Bool SortKey::canRadixSort() const
+{
+    switch (cmpObj_p->dataType()) {
+    case TpBool:
+    case TpChar:
+    case TpUChar:
+    case TpShort:
+    case TpUShort:
+    case TpInt:
+    case TpUInt:
+    case TpInt64:
+    case TpFloat:
+    case TpDouble:
+        return True;
+    default:
+        break;
+    }
+    return False;
+}
+
 
 
 
@@ -259,6 +279,17 @@ void Sort::addKey (SortKey* key)
 }
 
 
+Bool Sort::canRadixSort() const
+{
+    for (size_t i=0; i<nrkey_p; i++) {
+        if (! keys_p[i]->canRadixSort()) {
+            return False;
+        }
+    }
+    return nrkey_p > 0;
+}
+
+
 uInt Sort::sort (Vector<uInt>& indexVector, uInt nrrec,
                  int options, Bool tryGenSort) const
   { return doSort (indexVector, nrrec, options, tryGenSort); }
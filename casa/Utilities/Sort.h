@@ -82,6 +82,19 @@ public:
     int order() const
       { return order_p; }
 
+    // Test if the key can be used in a radix sort, thus if it is a
+    // fixed-width numeric type compared by a plain ObjCompare.
+    Bool canRadixSort() const;
+
+    // Fill <src>keys</src> with the radix sort values of the records given
+    // by the <src>nr</src> indices. The values are unsigned integers
+    // having the same order as the original key values.
+    // If <src>invert</src> is True, the bits are inverted (thus order
+    // is reversed) to handle descending keys.
+    template<typename T>
+    void fillRadixKeys (uInt64* keys, const T* inx, T nr,
+                        Bool invert) const;
+
 protected:
     // sort order; -1 = ascending, 1 = descending
     int               order_p;
@@ -119,7 +132,7 @@ protected:
 // If sorting on a single key with a standard data type is done,
 // Sort will use GenSortIndirect to speed up the sort.
 // <br>
-// Four sort algorithms are provided:
+// Five sort algorithms are provided:
 // <DL>
 //  <DT> <src>Sort::ParSort</src>
 //  <DD> The parallel merge sort is the fastest if it can use multiple threads.
@@ -138,9 +151,23 @@ protected:
 //  <DT> <src>Sort::HeapSort</src>
 //  <DD> Heapsort has O(n*log(n)) behaviour. Its speed is lower than
 //       that of QuickSort, so QuickSort is the default algorithm.
+//  <DT> <src>Sort::RadixSort</src>
+//  <DD> An LSD radix sort has O(n) behaviour and does not need any
+//       comparison function call. It can only be used if all keys are
+//       fixed-width numeric types (Bool, integer, Float or Double) using
+//       the standard comparison (thus not a CompareIntervalInt or so).
+//       Keys are processed from least to most significant key, where only
+//       the bytes that actually differ are used in a pass. It needs extra
+//       arrays for the key values and indices.
+//       If the keys are not suitable, the default algorithm is used.
+//       <br>Note that -0 and 0 are regarded equal, while a NaN is ordered
+//       before -Inf or after Inf depending on its sign bit (the other
+//       algorithms do not define an order for NaN).
 // </DL>
-// The default is to use QuickSort for small arrays or if only a single
-// thread can be used. Otherwise ParSort is the default.
+// The default is to use QuickSort for small arrays.
+// For larger arrays RadixSort is used if all keys are suitable.
+// Otherwise QuickSort is used if only a single thread can be used and
+// ParSort if multiple threads can be used.
 // 
 // All sort algorithms are <em>stable</em>, which means that the original
 // order is kept when keys are equal.
@@ -245,12 +272,13 @@ class Sort
 {
 public:
     // Enumerate the sort options:
-    enum Option {DefaultSort=0,     // ParSort, but QuickSort for small array
+    enum Option {DefaultSort=0,     // RadixSort or ParSort, QuickSort for small array
                  HeapSort=1,        // use Heapsort algorithm
                  InsSort=2,         // use insertion sort algorithm
                  QuickSort=4,       // use Quicksort algorithm
                  ParSort=8,         // use parallel merge sort algorithm
-                 NoDuplicates=16};  // skip data with equal sort keys
+                 NoDuplicates=16,   // skip data with equal sort keys
+                 RadixSort=32};     // use radix sort algorithm
 
     // Enumerate the sort order:
     enum Order {Ascending=-1,
@@ -398,6 +426,13 @@ private:
     void merge (T* inx, T* tmp, T size, T* index,
                 T nparts) const;
 
+    // Do an LSD radix sort. All keys must be suitable for it.
+    template<typename T>
+    T radixSort (T nrrec, T* inx) const;
+
+    // Test if all keys can be used in a radix sort.
+    Bool canRadixSort() const;
+
     // Do a quicksort, optionally skipping duplicates
     // (qkSort is the actual quicksort function).
     // <group>
@@ -30,6 +30,10 @@
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/SortError.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Utilities/Copy.h>
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -37,6 +41,97 @@
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+  // Convert a value to an unsigned integer having the same sort order.
+  // For signed integers the sign bit is flipped. For floating point values
+  // all bits are flipped for negative values, otherwise only the sign bit.
+  // <group>
+  template<typename V>
+  inline uInt64 sortRadixValue (V val)
+  {
+    typedef typename std::make_unsigned<V>::type UV;
+    UV uval = static_cast<UV>(val);
+    if (std::is_signed<V>::value) {
+      uval ^= UV(UV(1) << (8*sizeof(V) - 1));
+    }
+    return uval;
+  }
+  template<>
+  inline uInt64 sortRadixValue (Bool val)
+  {
+    return (val ? 1 : 0);
+  }
+  template<>
+  inline uInt64 sortRadixValue (Float val)
+  {
+    uInt bits;
+    if (val == 0) val = 0;         // -0 and 0 must be equal
+    memcpy (&bits, &val, sizeof(bits));
+    return ((bits & 0x80000000u) != 0  ?  ~bits : bits | 0x80000000u);
+  }
+  template<>
+  inline uInt64 sortRadixValue (Double val)
+  {
+    uInt64 bits;
+    if (val == 0) val = 0;
+    memcpy (&bits, &val, sizeof(bits));
+    const uInt64 sign = uInt64(1) << 63;
+    return ((bits & sign) != 0  ?  ~bits : bits | sign);
+  }
+  // </group>
+
+  // Fill the radix values of a key with data type V.
+  template<typename V, typename T>
+  inline void sortFillRadix (uInt64* keys, const void* data, uInt incr,
+                             const T* inx, T nr, uInt64 mask)
+  {
+    const char* dat = static_cast<const char*>(data);
+    for (T i=0; i<nr; ++i) {
+      keys[i] = mask ^ sortRadixValue
+        (*reinterpret_cast<const V*>(dat + size_t(inx[i])*incr));
+    }
+  }
+
+  template<typename T>
+  void SortKey::fillRadixKeys (uInt64* keys, const T* inx, T nr,
+                               Bool invert) const
+  {
+    uInt64 mask = (invert  ?  ~uInt64(0) : 0);
+    switch (cmpObj_p->dataType()) {
+    case TpBool:
+      sortFillRadix<Bool> (keys, data_p, incr_p, inx, nr, mask);
+      break;
+    case TpChar:
+      sortFillRadix<Char> (keys, data_p, incr_p, inx, nr, mask);
+      break;
+    case TpUChar:
+      sortFillRadix<uChar> (keys, data_p, incr_p, inx, nr, mask);
+      break;
+    case TpShort:
+      sortFillRadix<Short> (keys, data_p, incr_p, inx, nr, mask);
+      break;
+    case TpUShort:
+      sortFillRadix<uShort> (keys, data_p, incr_p, inx, nr, mask);
+      break;
+    case TpInt:
+      sortFillRadix<Int> (keys, data_p, incr_p, inx, nr, mask);
+      break;
+    case TpUInt:
+      sortFillRadix<uInt> (keys, data_p, incr_p, inx, nr, mask);
+      break;
+    case TpInt64:
+      sortFillRadix<Int64> (keys, data_p, incr_p, inx, nr, mask);
+      break;
+    case TpFloat:
+      sortFillRadix<Float> (keys, data_p, incr_p, inx, nr, mask);
+      break;
+    case TpDouble:
+      sortFillRadix<Double> (keys, data_p, incr_p, inx, nr, mask);
+      break;
+    default:
+      throw SortInvOpt();
+    }
+  }
+
   template<typename T>
   T Sort::doSort (Vector<T>& indexVector, T nrrec, int opt,
                   Bool doTryGenSort) const
@@ -68,6 +163,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     if (uInt(nthr) > nrrec) nthr = nrrec;
 #endif
     if (type == DefaultSort) {
+      if (nrrec >= 1000  &&  canRadixSort()) {
+        type = RadixSort;
+      } else {
+        type = (nrrec<1000 || nthr==1  ?  QuickSort : ParSort);
+      }
+    } else if (type == RadixSort  &&  !canRadixSort()) {
       type = (nrrec<1000 || nthr==1  ?  QuickSort : ParSort);
     }
     T n = 0;
@@ -99,6 +200,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         n = insSortNoDup (nrrec, inx);
       }
       break;
+    case RadixSort:
+      n = radixSort (nrrec, inx);
+      if (nodup) {
+        n = insSortNoDup (nrrec, inx);
+      }
+      break;
     default:
       throw SortInvOpt();
     }
@@ -277,6 +384,67 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     }
   }
 
+  template<typename T>
+  T Sort::radixSort (T nrrec, T* inx) const
+  {
+    // The key values and indices are moved between two buffers in each pass.
+    Block<uInt64> keyBuf(2*nrrec);
+    Block<T> inxBuf(nrrec);
+    uInt64* ka = keyBuf.storage();
+    uInt64* kb = ka + nrrec;
+    T* ia = inx;
+    T* ib = inxBuf.storage();
+    // If all keys are descending, sort ascending and reverse the result.
+    // In that way equal keys get descending indices like compare() does.
+    Bool reverse = (order_p == Descending);
+    T count[256];
+    // An LSD radix sort starts with the least significant key.
+    // Each pass is stable, so the order of the previous passes is kept.
+    for (size_t k=nrkey_p; k>0; --k) {
+      const SortKey* key = keys_p[k-1];
+      key->fillRadixKeys (ka, ia, nrrec,
+                          !reverse  &&  key->order() == Descending);
+      // Only the bytes differing in the key values need a pass.
+      uInt64 diff = 0;
+      for (T i=1; i<nrrec; ++i) {
+        diff |= ka[i] ^ ka[0];
+      }
+      for (uInt shift=0; shift<64; shift+=8) {
+        if (((diff >> shift) & 0xff) == 0) {
+          continue;
+        }
+        objset (count, T(0), 256);
+        for (T i=0; i<nrrec; ++i) {
+          count[(ka[i] >> shift) & 0xff]++;
+        }
+        T sum = 0;
+        for (uInt j=0; j<256; ++j) {
+          T nr = count[j];
+          count[j] = sum;
+          sum += nr;
+        }
+        for (T i=0; i<nrrec; ++i) {
+          T pos = count[(ka[i] >> shift) & 0xff]++;
+          kb[pos] = ka[i];
+          ib[pos] = ia[i];
+        }
+        std::swap (ka, kb);
+        std::swap (ia, ib);
+      }
+    }
+    // Copy the result to the output array if needed.
+    if (reverse) {
+      if (ia == inx) {
+        std::reverse (inx, inx+nrrec);
+      } else {
+        std::reverse_copy (ia, ia+nrrec, inx);
+      }
+    } else if (ia != inx) {
+      objcopy (inx, ia, nrrec);
+    }
+    return nrrec;
+  }
+
   template<typename T>
   T Sort::insSort (T nrrec, T* inx) const
   {
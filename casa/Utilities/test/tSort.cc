@@ -288,6 +288,7 @@ int main()
     sortit (Sort::ParSort);
     sortit (Sort::QuickSort);
     sortit (Sort::HeapSort);
+    sortit (Sort::RadixSort);
 
     // Sort a longer array and check its result.
     sortall (Sort::InsSort, Sort::Ascending);
@@ -306,6 +307,10 @@ int main()
     sortall (Sort::ParSort | Sort::NoDuplicates, Sort::Descending);
     sortall (Sort::QuickSort | Sort::NoDuplicates, Sort::Descending);
     sortall (Sort::HeapSort | Sort::NoDuplicates, Sort::Descending);
+    sortall (Sort::RadixSort, Sort::Ascending);
+    sortall (Sort::RadixSort | Sort::NoDuplicates, Sort::Ascending);
+    sortall (Sort::RadixSort, Sort::Descending);
+    sortall (Sort::RadixSort | Sort::NoDuplicates, Sort::Descending);
 
     sort_test_unique();
 
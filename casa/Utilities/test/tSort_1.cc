@@ -27,6 +27,7 @@
 #include <casacore/casa/Utilities/Sort.h>
 #include <casacore/casa/Utilities/GenSort.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/OS/Timer.h>
 #include <casacore/casa/sstream.h>
 #include <casacore/casa/stdlib.h>
@@ -37,6 +38,7 @@
 Bool sortarr (Int*, uInt nr, int);
 Bool sortall (Int*, uInt nr, uInt type);
 Bool sort2 (uInt nr);
+Bool sort3 (uInt nr);
 
 // Define file global variable for cmp-routine.
 static Int* gbla;
@@ -110,7 +112,12 @@ int main(int argc, const char* argv[])
     delete [] a6;
     delete [] a7;
 
-    sort2 (nr);
+    if (! sort2 (nr)) {
+        success = False;
+    }
+    if (! sort3 (nr)) {
+        success = False;
+    }
 
     if (success) {
 	return 0;
@@ -321,6 +328,15 @@ Bool sort2 (uInt nr)
     sort.sort (inx1, vec1.size(), Sort::ParSort);
     cout << "parsort2  ";
     timer.show();
+    timer.mark();
+    Vector<uInt> inx2;
+    sort.sort (inx2, vec1.size(), Sort::RadixSort);
+    cout << "radixsort2";
+    timer.show();
+    if (! allEQ (inx1, inx)  ||  ! allEQ (inx2, inx)) {
+      cout << "Sort results differ" << endl;
+      return False;
+    }
   }
   {
     Timer timer;
@@ -336,3 +352,52 @@ Bool sort2 (uInt nr)
   }
   return True;
 }
+
+// Sort on time (descending), baseline and a random double.
+// It compares the radix sort against the other sorts for mixed key types.
+Bool sort3 (uInt nr)
+{
+  Vector<Double> time(nr);
+  Vector<Int> ant1(nr);
+  Vector<Int> ant2(nr);
+  Vector<Double> val(nr);
+  for (uInt i=0; i<nr; ++i) {
+    time[i] = 4.5e9 + (rand()%100) * 10.;
+    ant1[i] = rand()%45 - 10;
+    ant2[i] = rand()%45;
+    val[i]  = (rand()%1000 - 500) / 7.;
+  }
+  Sort sort;
+  sort.sortKey (time.data(), TpDouble, 0, Sort::Descending);
+  sort.sortKey (ant1.data(), TpInt);
+  sort.sortKey (ant2.data(), TpInt);
+  sort.sortKey (val.data(), TpDouble);
+  Timer timer;
+  Vector<uInt> inx;
+  sort.sort (inx, nr, Sort::QuickSort);
+  cout << "quicksort3";
+  timer.show();
+  timer.mark();
+  Vector<uInt> inx1;
+  sort.sort (inx1, nr, Sort::ParSort);
+  cout << "parsort3  ";
+  timer.show();
+  timer.mark();
+  Vector<uInt> inx2;
+  sort.sort (inx2, nr, Sort::RadixSort);
+  cout << "radixsort3";
+  timer.show();
+  timer.mark();
+  Vector<uInt> inx3;
+  uInt nr3 = sort.sort (inx3, nr, Sort::RadixSort | Sort::NoDuplicates);
+  cout << "radixnodup";
+  timer.show();
+  Vector<uInt> inx4;
+  uInt nr4 = sort.sort (inx4, nr, Sort::ParSort | Sort::NoDuplicates);
+  if (! allEQ (inx1, inx)  ||  ! allEQ (inx2, inx)  ||
+      nr3 != nr4  ||  ! allEQ (inx3, inx4)) {
+    cout << "Sort results differ" << endl;
+    return False;
+  }
+  return True;
+}
@@ -1038,7 +1038,14 @@ void MSLister::listData(const int pageRows,
       // Loop through the rows of the MS. (not rows of MSLister::listData output)
       Bool endOutput=False;
       for (Int tableRow=0; tableRow<nTableRows; tableRow++) {
-        date_p = MVTime(rowTime(tableRow)).string(MVTime::YMD_ONLY);
+        // Format the date and time once per row into a buffer.
+        const MVTime rowMVTime(rowTime(tableRow));
+        char timeBuf[MVTime::FormatSize];
+        rowMVTime.format (timeBuf, sizeof(timeBuf),
+                          MVTime::Format(MVTime::YMD_ONLY));
+        date_p = timeBuf;
+        rowMVTime.format (timeBuf, sizeof(timeBuf),
+                          MVTime::Format(MVTime::TIME, precTime_p));
 
         // The spectral window ID for this row of the MS is 'spwinid(tableRow)'.
 
@@ -1081,7 +1088,7 @@ void MSLister::listData(const int pageRows,
               myout.setf(ios::fixed, ios::floatfield);
               myout.setf(ios::right, ios::adjustfield);
 
-              myout.width(wTime_p);   myout << MVTime(rowTime(tableRow)).string(MVTime::TIME,precTime_p);
+              myout.width(wTime_p);   myout << timeBuf;
               myout.width(wAnt1_p);   myout << antNames1(tableRow);
               myout << "-";
               myout.width(wAnt2_p);   myout << antNames2(tableRow);
@@ -276,7 +276,15 @@ void Adios2StMan::impl::configureAdios()
     }
     if (itsAdiosEngineParams.empty() == false)
     {
-        itsAdiosIO->SetParameters(itsAdiosEngineParams);
+        // The deferred put size is handled by Adios2StMan itself.
+        adios2::Params params = itsAdiosEngineParams;
+        auto itDeferred = params.find(ENGINE_PARAM_DEFERRED_BYTES);
+        if (itDeferred != params.end())
+        {
+            itsMaxDeferredBytes = std::stoull(itDeferred->second);
+            params.erase(itDeferred);
+        }
+        itsAdiosIO->SetParameters(params);
     }
 
     // transport is valid only when it has a valid ADIOS2 transport name
@@ -454,6 +462,7 @@ void Adios2StMan::impl::create64(rownr_t  aNrRows)
     itsRows = aNrRows;
     itsAdiosEngine = std::make_shared<adios2::Engine>(
         itsAdiosIO->Open(fileName() + ".bp", adios2::Mode::Write));
+    itsIsWriting = true;
     for (uInt i = 0; i < ncolumn(); ++i)
     {
         itsColumnPtrBlk[i]->create(itsAdiosEngine, 'w');
@@ -581,8 +590,40 @@ rownr_t Adios2StMan::impl::getNrRows() { return itsRows; }
 
 rownr_t Adios2StMan::impl::resync64(rownr_t /*aNrRows*/) { return itsRows; }
 
+Bool Adios2StMan::impl::reserveDeferredPut(uInt64 nbytes)
+{
+    if (itsDeferredBytes + nbytes > itsMaxDeferredBytes)
+    {
+        performPuts();
+    }
+    if (nbytes > itsMaxDeferredBytes)
+    {
+        return false;
+    }
+    itsDeferredBytes += nbytes;
+    return true;
+}
+
+void Adios2StMan::impl::performPuts()
+{
+    if (itsDeferredBytes == 0)
+    {
+        return;
+    }
+    if (itsAdiosEngine && itsIsWriting)
+    {
+        itsAdiosEngine->PerformPuts();
+    }
+    for (uInt i = 0; i < ncolumn(); ++i)
+    {
+        itsColumnPtrBlk[i]->clearDeferredPuts();
+    }
+    itsDeferredBytes = 0;
+}
+
 Bool Adios2StMan::impl::flush(AipsIO &ios, Bool /*doFsync*/)
 {
+    performPuts();
     ios.putstart(DATA_MANAGER_TYPE, 2);
     ios << itsDataManName;
     // Here we used to write itsStManColumnType (int), but that was an otherwise
@@ -149,17 +149,10 @@ void Adios2StManColumn::arrayColumnVToSelection()
     }
 }
 
-void Adios2StManColumn::scalarColumnCellsVToSelection(const RefRows &rows)
-{
-    RefRowsSliceIter iter(rows);
-    auto row_start = iter.sliceStart();
-    auto row_end = iter.sliceEnd();
-    iter.next();
-    if (!iter.pastEnd()) {
-        throw std::runtime_error("Adios2StManColumn::scalarColumnCellsVToSelection supports single slices");
-    }
+void Adios2StManColumn::arrayCellsToSelection(rownr_t row_start, rownr_t row_count)
+{
     itsAdiosStart[0] = row_start;
-    itsAdiosCount[0] = row_end - row_start + 1;
+    itsAdiosCount[0] = row_count;
     for (size_t i = 1; i < itsAdiosShape.size(); ++i)
     {
         itsAdiosStart[i] = 0;
@@ -177,27 +170,126 @@ void Adios2StManColumn::columnSliceVToSelection(const Slicer &ns)
     columnSliceCellsVToSelection(0, itsStManPtr->getNrRows(), ns);
 }
 
-void Adios2StManColumn::columnSliceCellsVToSelection(const RefRows &rows, const Slicer &ns)
-{
-    RefRowsSliceIter iter(rows);
-    auto row_start = iter.sliceStart();
-    auto row_end = iter.sliceEnd();
-    iter.next();
-    if (!iter.pastEnd()) {
-        throw std::runtime_error("Adios2StManColumn::columnSliceCellsVToSelection supports single slices");
-    }
-    columnSliceCellsVToSelection(row_start, row_end - row_start + 1, ns);
-}
-
 void Adios2StManColumn::columnSliceCellsVToSelection(rownr_t row_start, rownr_t row_count, const Slicer &ns)
 {
+    // A strided slice selects its bounding box; getSliceCells narrows
+    // it to the planes actually needed (ADIOS2 selections have no stride).
     itsAdiosStart[0] = row_start;
     itsAdiosCount[0] = row_count;
     for (size_t i = 1; i < itsAdiosShape.size(); ++i)
     {
         itsAdiosStart[i] = ns.start()(ns.ndim() - i);
-        itsAdiosCount[i] = ns.length()(ns.ndim() - i);
+        itsAdiosCount[i] = ns.end()(ns.ndim() - i) - ns.start()(ns.ndim() - i) + 1;
+    }
+}
+
+void Adios2StManColumn::getSliceCells(const RefRows &rownrs, const Slicer &ns, ArrayBase &data)
+{
+    // ADIOS2 selections have no stride. Along the first axis and the rows
+    // the bounding range is read and the stride is applied while copying.
+    // Along the other strided axes each selected plane is read separately,
+    // so no data of the planes in between are read.
+    const size_t ndim = ns.ndim();
+    IPosition stride(ndim + 1, 1);
+    IPosition outSteps(ndim + 1);
+    IPosition nplane(ndim + 1, 1);
+    Bool strided = False;
+    size_t nelemCell = 1;
+    for (size_t i = 0; i < ndim; ++i)
+    {
+        outSteps[i] = nelemCell;
+        nelemCell *= ns.length()(i);
+        if (ns.stride()(i) != 1)
+        {
+            strided = True;
+            if (i == 0)
+            {
+                stride[0] = ns.stride()(0);
+            }
+            else
+            {
+                nplane[i] = ns.length()(i);
+            }
+        }
+    }
+    outSteps[ndim] = nelemCell;
+    Bool deleteIt;
+    void *dataPtr = data.getVStorage(deleteIt);
+    forEachRowRange(rownrs, True,
+        [&](rownr_t rowStart, rownr_t nrow, rownr_t rowIncr, rownr_t nrDone)
+        {
+            columnSliceCellsVToSelection(rowStart, nrow, ns);
+            if (!strided && rowIncr == 1)
+            {
+                fromAdios(dataPtr, nrDone * nelemCell);
+                return;
+            }
+            stride[ndim] = rowIncr;
+            IPosition plane(ndim + 1, 0);
+            while (True)
+            {
+                size_t offset = nrDone * nelemCell;
+                for (size_t i = 1; i < ndim; ++i)
+                {
+                    if (nplane[i] > 1)
+                    {
+                        itsAdiosStart[ndim - i] = ns.start()(i) + plane[i] * ns.stride()(i);
+                        itsAdiosCount[ndim - i] = 1;
+                        offset += plane[i] * outSteps[i];
+                    }
+                }
+                fromAdiosStrided(dataPtr, offset, stride, outSteps);
+                size_t i = 1;
+                for (; i < ndim; ++i)
+                {
+                    if (++plane[i] < nplane[i]) break;
+                    plane[i] = 0;
+                }
+                if (i >= ndim) break;
+            }
+        });
+    data.putVStorage(dataPtr, deleteIt);
+}
+
+void Adios2StManColumn::putSliceCells(const RefRows &rownrs, const Slicer &ns, const ArrayBase &data)
+{
+    for (size_t i = 0; i < ns.ndim(); ++i)
+    {
+        if (ns.stride()(i) != 1)
+        {
+            throw std::runtime_error("Adios2StManColumn: strided slices cannot be written");
+        }
+    }
+    size_t nelemCell = ns.length().product();
+    Bool deleteIt;
+    const void *dataPtr = data.getVStorage(deleteIt);
+    forEachRowRange(rownrs, False,
+        [&](rownr_t rowStart, rownr_t nrow, rownr_t, rownr_t nrDone)
+        {
+            columnSliceCellsVToSelection(rowStart, nrow, ns);
+            toAdios(dataPtr, nrDone * nelemCell);
+        });
+    data.freeVStorage(dataPtr, deleteIt);
+}
+
+void Adios2StManColumn::fromAdiosRows(void *dataPtr, std::size_t offset, rownr_t rowIncr)
+{
+    if (rowIncr == 1)
+    {
+        fromAdios(dataPtr, offset);
+        return;
+    }
+    const size_t ndim = itsAdiosCount.size();
+    IPosition stride(ndim, 1);
+    IPosition outSteps(ndim);
+    size_t step = 1;
+    for (size_t i = 0; i < ndim; ++i)
+    {
+        outSteps[i] = step;
+        step *= itsAdiosCount[ndim - i - 1];
     }
+    stride[ndim - 1] = rowIncr;
+    fromAdiosStrided(dataPtr, offset, stride, outSteps);
 }
 
 void Adios2StManColumn::putArrayV(rownr_t rownr, const ArrayBase& data)
@@ -238,70 +330,67 @@ void Adios2StManColumn::getScalarColumnV(ArrayBase &data)
 
 void Adios2StManColumn::getScalarColumnCellsV(const RefRows &rownrs, ArrayBase& data)
 {
-    scalarColumnCellsVToSelection(rownrs);
-    fromAdios(&data);
+    Bool deleteIt;
+    void *dataPtr = data.getVStorage(deleteIt);
+    forEachRowRange(rownrs, True,
+        [&](rownr_t rowStart, rownr_t nrow, rownr_t rowIncr, rownr_t nrDone)
+        {
+            itsAdiosStart[0] = rowStart;
+            itsAdiosCount[0] = nrow;
+            fromAdiosRows(dataPtr, nrDone, rowIncr);
+        });
+    data.putVStorage(dataPtr, deleteIt);
 }
 
 void Adios2StManColumn::putScalarColumnCellsV(const RefRows &rownrs, const ArrayBase& data)
 {
-    scalarColumnCellsVToSelection(rownrs);
-    toAdios(&data);
+    Bool deleteIt;
+    const void *dataPtr = data.getVStorage(deleteIt);
+    forEachRowRange(rownrs, False,
+        [&](rownr_t rowStart, rownr_t nrow, rownr_t, rownr_t nrDone)
+        {
+            itsAdiosStart[0] = rowStart;
+            itsAdiosCount[0] = nrow;
+            toAdios(dataPtr, nrDone);
+        });
+    data.freeVStorage(dataPtr, deleteIt);
 }
 
 void Adios2StManColumn::putArrayColumnCellsV (const RefRows& rownrs, const ArrayBase& data)
 {
-    if(rownrs.isSliced())
-    {
-        rownrs.convert();
-    }
+    // Each contiguous range of rows is put as a single block.
     Bool deleteIt;
     const void *dataPtr = data.getVStorage(deleteIt);
-    itsAdiosCount[0] = 1;
-    for (size_t i = 1; i < itsAdiosShape.size(); ++i)
-    {
-        itsAdiosStart[i] = 0;
-        itsAdiosCount[i] = itsAdiosShape[i];
-    }
-    for(uInt i = 0; i < rownrs.rowVector().size(); ++i)
-    {
-        itsAdiosStart[0] = rownrs.rowVector()[i];
-        toAdios(dataPtr, i * itsCasaShape.nelements());
-    }
+    forEachRowRange(rownrs, False,
+        [&](rownr_t rowStart, rownr_t nrow, rownr_t, rownr_t nrDone)
+        {
+            arrayCellsToSelection(rowStart, nrow);
+            toAdios(dataPtr, nrDone * itsCasaShape.nelements());
+        });
     data.freeVStorage(dataPtr, deleteIt);
 }
 
 void Adios2StManColumn::getArrayColumnCellsV (const RefRows& rownrs, ArrayBase &data)
 {
-    if(rownrs.isSliced())
-    {
-        rownrs.convert();
-    }
     Bool deleteIt;
     void *dataPtr = data.getVStorage(deleteIt);
-    itsAdiosCount[0] = 1;
-    for (size_t i = 1; i < itsAdiosShape.size(); ++i)
-    {
-        itsAdiosStart[i] = 0;
-        itsAdiosCount[i] = itsAdiosShape[i];
-    }
-    for(uInt i = 0; i < rownrs.rowVector().size(); ++i)
-    {
-        itsAdiosStart[0] = rownrs.rowVector()[i];
-        fromAdios(dataPtr, i * itsCasaShape.nelements());
-    }
+    forEachRowRange(rownrs, True,
+        [&](rownr_t rowStart, rownr_t nrow, rownr_t rowIncr, rownr_t nrDone)
+        {
+            arrayCellsToSelection(rowStart, nrow);
+            fromAdiosRows(dataPtr, nrDone * itsCasaShape.nelements(), rowIncr);
+        });
     data.putVStorage(dataPtr, deleteIt);
 }
 
 void Adios2StManColumn::getSliceV(rownr_t aRowNr, const Slicer &ns, ArrayBase& data)
 {
-    sliceVToSelection(aRowNr, ns);
-    fromAdios(&data);
+    getSliceCells(RefRows(aRowNr, aRowNr), ns, data);
 }
 
 void Adios2StManColumn::putSliceV(rownr_t aRowNr, const Slicer &ns, const ArrayBase& data)
 {
-    sliceVToSelection(aRowNr, ns);
-    toAdios(&data);
+    putSliceCells(RefRows(aRowNr, aRowNr), ns, data);
 }
 
 void Adios2StManColumn::getArrayColumnV(ArrayBase& data)
@@ -318,28 +407,30 @@ void Adios2StManColumn::putArrayColumnV(const ArrayBase& data)
 
 void Adios2StManColumn::putColumnSliceV(const Slicer &ns, const ArrayBase& data)
 {
-    columnSliceVToSelection(ns);
-    toAdios(&data);
+    if (itsStManPtr->getNrRows() > 0)
+    {
+        putSliceCells(RefRows(0, itsStManPtr->getNrRows() - 1), ns, data);
+    }
 }
 
 void Adios2StManColumn::getColumnSliceV(const Slicer &ns, ArrayBase& data)
 {
-    columnSliceVToSelection(ns);
-    fromAdios(&data);
+    if (itsStManPtr->getNrRows() > 0)
+    {
+        getSliceCells(RefRows(0, itsStManPtr->getNrRows() - 1), ns, data);
+    }
 }
 
 void Adios2StManColumn::getColumnSliceCellsV(const RefRows& rownrs,
                                   const Slicer& slicer, ArrayBase& data)
 {
-    columnSliceCellsVToSelection(rownrs, slicer);
-    fromAdios(&data);
+    getSliceCells(rownrs, slicer, data);
 }
 
 void Adios2StManColumn::putColumnSliceCellsV(const RefRows& rownrs,
                                    const Slicer& slicer, const ArrayBase& data)
 {
-    columnSliceCellsVToSelection(rownrs, slicer);
-    toAdios(&data);
+    putSliceCells(rownrs, slicer, data);
 }
 
 
@@ -26,7 +26,9 @@
 #ifndef ADIOS2STMANCOLUMN_H
 #define ADIOS2STMANCOLUMN_H
 
+#include <deque>
 #include <unordered_map>
+#include <vector>
 #include <casacore/casa/Arrays/Array.h>
 #include <casacore/tables/DataMan/StManColumnBase.h>
 #include <casacore/tables/Tables/RefRows.h>
@@ -53,6 +55,10 @@ public:
     int getDataType();
     String getColumnName();
 
+    // Release the buffers of the deferred puts.
+    // It must be called after the engine has performed the puts.
+    virtual void clearDeferredPuts() = 0;
+
 protected:
 
     // scalar get/put
@@ -116,18 +122,42 @@ private:
     virtual void fromAdios(ArrayBase *arrayPtr) = 0;
     virtual void toAdios(const void *dataPtr, std::size_t offset=0) = 0;
     virtual void fromAdios(void *dataPtr, std::size_t offset=0) = 0;
+    // Get the box set in the selection and copy the elements at every
+    // stride-th position (in casa order, the rows last) into dataPtr.
+    // The element at box position p is stored at offset + sum(p/stride*outSteps).
+    virtual void fromAdiosStrided(void *dataPtr, std::size_t offset,
+                                  const IPosition &stride,
+                                  const IPosition &outSteps) = 0;
+    // Get the full cells of the rows set in the selection and copy
+    // every rowIncr-th row into dataPtr.
+    void fromAdiosRows(void *dataPtr, std::size_t offset, rownr_t rowIncr);
+
+    // Call func(firstRow, nrow, rowIncr, nrDone) for the rows in rownrs,
+    // where nrDone is the number of rows handled before.
+    // Each contiguous range of rows is a single call with rowIncr 1.
+    // For a get (forGet=True) a strided range with an increment up to
+    // MAX_GET_ROW_INCR is also a single call covering its bounding range,
+    // so the caller must keep every rowIncr-th row. Otherwise the rows of
+    // a strided range are handled one by one, because a put of the
+    // bounding range would overwrite the rows in between.
+    template <typename Func>
+    void forEachRowRange(const RefRows &rownrs, Bool forGet, Func func);
+
+    // Get or put the given slice in the rows of rownrs.
+    // The rows are handled as contiguous blocks where possible.
+    void getSliceCells(const RefRows &rownrs, const Slicer &ns, ArrayBase &data);
+    void putSliceCells(const RefRows &rownrs, const Slicer &ns, const ArrayBase &data);
 
 
 protected:
     void scalarToSelection(rownr_t rownr);
     void scalarColumnVToSelection();
-    void scalarColumnCellsVToSelection(const RefRows &rownrs);
     void arrayVToSelection(rownr_t rownr);
     void arrayColumnVToSelection();
     void sliceVToSelection(rownr_t rownr, const Slicer &ns);
     void columnSliceVToSelection(const Slicer &ns);
-    void columnSliceCellsVToSelection(const RefRows &rows, const Slicer &ns);
-    void columnSliceCellsVToSelection(rownr_t row_start, rownr_t row_end, const Slicer &ns);
+    void columnSliceCellsVToSelection(rownr_t row_start, rownr_t row_count, const Slicer &ns);
+    void arrayCellsToSelection(rownr_t row_start, rownr_t row_count);
 
     Adios2StMan::impl *itsStManPtr;
 
@@ -142,6 +172,10 @@ protected:
     adios2::Dims itsAdiosShape = {std::numeric_limits<rownr_t>::max()};
     adios2::Dims itsAdiosStart = {0};
     adios2::Dims itsAdiosCount = {1};
+
+    // The maximum row increment for which a get reads the bounding range
+    // of the rows instead of reading the rows one by one.
+    static constexpr rownr_t MAX_GET_ROW_INCR = 4;
 }; // class Adios2StManColumn
 
 
@@ -166,16 +200,43 @@ public:
         }
     }
 
+    void clearDeferredPuts()
+    {
+        itsDeferredBuffers.clear();
+    }
+
 private:
     adios2::Variable<T> itsAdiosVariable;
+    // The copies of the data of the deferred puts. They must stay alive
+    // until the engine has performed the puts.
+    std::deque<std::vector<T>> itsDeferredBuffers;
 
     void toAdios(const void *data, std::size_t offset)
     {
-        const T *tData = static_cast<const T *>(data);
+        const T *tData = static_cast<const T *>(data) + offset;
         if(!isShapeFixed)
             itsAdiosVariable.SetShape(itsAdiosShape);
         itsAdiosVariable.SetSelection({itsAdiosStart, itsAdiosCount});
-        itsAdiosEngine->Put<T>(itsAdiosVariable, tData + offset, adios2::Mode::Sync);
+        std::size_t nelem = 1;
+        for (auto c : itsAdiosCount)
+        {
+            nelem *= c;
+        }
+        if (itsStManPtr->reserveDeferredPut(nelem * sizeof(T)))
+        {
+            // Put in deferred mode, so the engine can aggregate the puts of
+            // many rows into a single write. The caller's data can be a
+            // temporary, hence it is copied.
+            itsDeferredBuffers.emplace_back(tData, tData + nelem);
+            itsAdiosEngine->Put<T>(itsAdiosVariable,
+                                   itsDeferredBuffers.back().data(),
+                                   adios2::Mode::Deferred);
+        }
+        else
+        {
+            // The data exceed the limit, so put them without a copy.
+            itsAdiosEngine->Put<T>(itsAdiosVariable, tData, adios2::Mode::Sync);
+        }
     }
 
     void fromAdios(void *data, std::size_t offset)
@@ -185,6 +246,45 @@ private:
         itsAdiosEngine->Get<T>(itsAdiosVariable, tData + offset, adios2::Mode::Sync);
     }
 
+    void fromAdiosStrided(void *data, std::size_t offset,
+                          const IPosition &stride, const IPosition &outSteps)
+    {
+        // The box shape in casa order is the reversed adios count.
+        const uInt ndim = itsAdiosCount.size();
+        IPosition shape(ndim);
+        IPosition steps(ndim);
+        size_t step = 1;
+        for (uInt i = 0; i < ndim; ++i)
+        {
+            size_t boxLen = itsAdiosCount[ndim - i - 1];
+            shape[i] = (boxLen - 1) / stride[i] + 1;
+            steps[i] = step * stride[i];
+            step *= boxLen;
+        }
+        std::vector<T> box(step);
+        itsAdiosVariable.SetSelection({itsAdiosStart, itsAdiosCount});
+        itsAdiosEngine->Get<T>(itsAdiosVariable, box.data(), adios2::Mode::Sync);
+        T *tData = static_cast<T *>(data) + offset;
+        IPosition pos(ndim, 0);
+        size_t nelem = shape.product();
+        for (size_t n = 0; n < nelem; ++n)
+        {
+            size_t inx = 0;
+            size_t outInx = 0;
+            for (uInt i = 0; i < ndim; ++i)
+            {
+                inx += pos[i] * steps[i];
+                outInx += pos[i] * outSteps[i];
+            }
+            tData[outInx] = box[inx];
+            for (uInt i = 0; i < ndim; ++i)
+            {
+                if (++pos[i] < shape[i]) break;
+                pos[i] = 0;
+            }
+        }
+    }
+
     void toAdios(const ArrayBase *arrayPtr)
     {
         Bool deleteIt;
@@ -203,6 +303,36 @@ private:
 
 }; // class Adios2StManColumnT
 
+
+template <typename Func>
+void Adios2StManColumn::forEachRowRange(const RefRows &rownrs, Bool forGet,
+                                        Func func)
+{
+    rownr_t nrDone = 0;
+    for (RefRowsSliceIter iter(rownrs); !iter.pastEnd(); iter.next())
+    {
+        rownr_t rowStart = iter.sliceStart();
+        rownr_t rowIncr = iter.sliceIncr();
+        rownr_t nrow = (iter.sliceEnd() - rowStart) / rowIncr + 1;
+        if (rowIncr == 1)
+        {
+            func(rowStart, nrow, 1, nrDone);
+        }
+        else if (forGet && rowIncr <= MAX_GET_ROW_INCR)
+        {
+            func(rowStart, (nrow - 1) * rowIncr + 1, rowIncr, nrDone);
+        }
+        else
+        {
+            for (rownr_t i = 0; i < nrow; ++i)
+            {
+                func(rowStart + i * rowIncr, 1, 1, nrDone + i);
+            }
+        }
+        nrDone += nrow;
+    }
+}
+
 class Adios2StManColumnString : public Adios2StManColumnT<std::string>
 {
 public:
@@ -81,6 +81,14 @@ public:
     Record dataManagerSpec() const;
     rownr_t getNrRows();
 
+    // Reserve room for a deferred put of the given size.
+    // If the deferred puts would exceed the limit, the pending ones are
+    // performed first. It returns False if the put itself exceeds the
+    // limit; the caller must then put the data in sync mode.
+    Bool reserveDeferredPut(uInt64 nbytes);
+    // Let the engine perform the deferred puts and release their buffers.
+    void performPuts();
+
 private:
     Adios2StMan &parent;
     String itsDataManName = "Adios2StMan";
@@ -90,6 +98,13 @@ private:
     std::shared_ptr<adios2::ADIOS> itsAdios;
     std::shared_ptr<adios2::IO> itsAdiosIO;
     std::shared_ptr<adios2::Engine> itsAdiosEngine;
+    Bool itsIsWriting {false};
+
+    // The number of bytes held by deferred puts.
+    uInt64 itsDeferredBytes {0};
+    // The maximum number of bytes held by deferred puts before they are
+    // performed. It can be set by the ENGINEPARAMS field DeferredPutBytes.
+    uInt64 itsMaxDeferredBytes {64 * 1024 * 1024};
 
 #ifdef HAVE_MPI
     // MPI communicator to be used by all instances of this storage manager
@@ -119,6 +134,8 @@ private:
     static constexpr const char *SPEC_FIELD_TRANSPORT_PARAMS = "TRANSPORTPARAMS";
     // The name of the specification field for the ADIOS2 operator parameters
     static constexpr const char *SPEC_FIELD_OPERATOR_PARAMS = "OPERATORPARAMS";
+    // The name of the (casacore) engine parameter for the deferred put size
+    static constexpr const char *ENGINE_PARAM_DEFERRED_BYTES = "DeferredPutBytes";
 
     void configureAdios();
     uInt ncolumn() const { return parent.ncolumn(); }
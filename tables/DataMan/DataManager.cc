@@ -45,6 +45,7 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/PlainTable.h>
 #include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/OS/DynLib.h>
 #include <casacore/tables/DataMan/DataManError.h>
@@ -155,6 +156,11 @@ void DataManager::setMaximumCacheSize (uInt)
 void DataManager::showCacheStatistics (ostream&) const
 {}
 
+Vector<String> DataManager::snapshotFiles()
+{
+    return Vector<String>();
+}
+
 void DataManager::setTsmOption (const TSMOption& tsmOption)
 {
   AlwaysAssert (!multiFile_p, AipsError);
@@ -350,6 +350,13 @@ public:
     // Show the data manager's IO statistics. By default it does nothing.
     virtual void showCacheStatistics (std::ostream&) const;
 
+    // Get the names of the files that are only written through a
+    // BucketFile using the unbuffered (cached) mode, thus can take part
+    // in copy-on-write snapshots (see class TableSnapshot). The other files
+    // of the data manager are copied when a snapshot is made.
+    // <br>The default implementation returns no files.
+    virtual Vector<String> snapshotFiles();
+
     // Create a column in the data manager on behalf of a table column.
     // It calls makeXColumn and checks the data type.
     // <group>
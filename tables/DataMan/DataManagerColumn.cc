@@ -88,6 +88,29 @@ Bool DataManagerColumn::canChangeShape() const
     return False;
 }
 
+Bool DataManagerColumn::isDictEncoded() const
+{
+    return False;
+}
+
+Int DataManagerColumn::getDictCode (rownr_t)
+{
+    throw (DataManInvOper ("DataManagerColumn::getDictCode not possible"
+                           " for column " + columnName()));
+}
+
+Int DataManagerColumn::findDictCode (const String&)
+{
+    throw (DataManInvOper ("DataManagerColumn::findDictCode not possible"
+                           " for column " + columnName()));
+}
+
+uInt64 DataManagerColumn::dictGeneration()
+{
+    throw (DataManInvOper ("DataManagerColumn::dictGeneration not possible"
+                           " for column " + columnName()));
+}
+
 
 String DataManagerColumn::dataTypeId() const
     { return String(); }
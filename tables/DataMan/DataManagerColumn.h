@@ -227,6 +227,27 @@ public:
     // Default is no.
     virtual Bool canChangeShape() const;
 
+    // Is the column a scalar String column stored with dictionary encoding?
+    // In that case each distinct value has an integer code, so values
+    // can be compared using their codes instead of the strings.
+    // Default is no.
+    virtual Bool isDictEncoded() const;
+
+    // Get the dictionary code of the value in the given row.
+    // By default it throws a "not possible" exception.
+    virtual Int getDictCode (rownr_t rownr);
+
+    // Get the dictionary code of the given value. It returns -1 if the
+    // value is not in the dictionary.
+    // By default it throws a "not possible" exception.
+    virtual Int findDictCode (const String& value);
+
+    // Get the generation of the dictionary. It changes each time values
+    // are added to the dictionary, so a value not found by findDictCode
+    // needs to be looked up again only if the generation has changed.
+    // By default it throws a "not possible" exception.
+    virtual uInt64 dictGeneration();
+
     // Get access to the ColumnCache object.
     // <group>
     ColumnCache& columnCache()
@@ -32,6 +32,7 @@
 #include <casacore/tables/DataMan/StArrayFile.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Utilities/ValType.h>
 #include <casacore/casa/IO/BucketCache.h>
 #include <casacore/casa/IO/BucketFile.h>
@@ -203,6 +204,14 @@ void ISMBase::showCacheStatistics (ostream& os) const
     }
 }
 
+Vector<String> ISMBase::snapshotFiles()
+{
+    if (multiFile()) {
+	return Vector<String>();
+    }
+    return Vector<String> (1, fileName());
+}
+
 void ISMBase::showIndexStatistics (ostream& os)
 {
     if (index_p != 0) {
@@ -154,6 +154,10 @@ public:
     // Show the statistics of all caches used.
     virtual void showCacheStatistics (ostream& os) const;
 
+    // Get the bucket file, which can be snapshotted using copy-on-write
+    // if no MultiFile is used.
+    virtual Vector<String> snapshotFiles();
+
     // Show the index statistics.
     void showIndexStatistics (ostream& os);
 
@@ -28,6 +28,7 @@
 #include <casacore/tables/DataMan/MSMDirColumn.h>
 #include <casacore/tables/DataMan/MSMIndColumn.h>
 #include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Utilities/Assert.h>
 
 
@@ -38,7 +39,9 @@ MSMBase::MSMBase()
   nrrow_p       (0),
   nrrowCreate_p (0),
   colSet_p      (0),
-  hasPut_p      (False)
+  hasPut_p      (False),
+  maxMemory_p   (0),
+  memUsed_p     (0)
 {}
 
 MSMBase::MSMBase (const String& storageManagerName)
@@ -47,16 +50,35 @@ MSMBase::MSMBase (const String& storageManagerName)
   nrrow_p       (0),
   nrrowCreate_p (0),
   colSet_p      (0),
-  hasPut_p      (False)
+  hasPut_p      (False),
+  maxMemory_p   (0),
+  memUsed_p     (0)
 {}
 
-MSMBase::MSMBase (const String& storageManagerName, const Record&)
+MSMBase::MSMBase (const String& storageManagerName, const Record& spec)
 : DataManager   (),
   stmanName_p   (storageManagerName),
   nrrow_p       (0),
   nrrowCreate_p (0),
   colSet_p      (0),
-  hasPut_p      (False)
+  hasPut_p      (False),
+  maxMemory_p   (0),
+  memUsed_p     (0)
+{
+  if (spec.isDefined ("MAXMEMORY")) {
+    maxMemory_p = spec.asInt64 ("MAXMEMORY");
+  }
+}
+
+MSMBase::MSMBase (const String& storageManagerName, uInt64 maxMemory)
+: DataManager   (),
+  stmanName_p   (storageManagerName),
+  nrrow_p       (0),
+  nrrowCreate_p (0),
+  colSet_p      (0),
+  hasPut_p      (False),
+  maxMemory_p   (maxMemory),
+  memUsed_p     (0)
 {}
 
 MSMBase::~MSMBase()
@@ -68,7 +90,7 @@ MSMBase::~MSMBase()
 
 DataManager* MSMBase::clone() const
 {
-  MSMBase* smp = new MSMBase (stmanName_p);
+  MSMBase* smp = new MSMBase (stmanName_p, maxMemory_p);
   return smp;
 }
 
@@ -89,6 +111,41 @@ String MSMBase::dataManagerName() const
   return stmanName_p;
 }
 
+Record MSMBase::dataManagerSpec() const
+{
+  Record rec;
+  if (maxMemory_p > 0) {
+    rec.define ("MAXMEMORY", Int64(maxMemory_p));
+  }
+  return rec;
+}
+
+Record MSMBase::getProperties() const
+{
+  Record rec;
+  rec.define ("MaxMemory", Int64(maxMemory_p));
+  return rec;
+}
+
+void MSMBase::setProperties (const Record& rec)
+{
+  if (rec.isDefined("MaxMemory")) {
+    maxMemory_p = rec.asInt64 ("MaxMemory");
+  }
+}
+
+void MSMBase::reserveMemory (uInt64 nbytes)
+{
+  if (maxMemory_p > 0  &&  memUsed_p + nbytes > maxMemory_p) {
+    throw DataManError ("MemoryStMan " + stmanName_p +
+                        ": allocating " + String::toString(nbytes) +
+                        " bytes exceeds the memory budget of " +
+                        String::toString(maxMemory_p) + " bytes (" +
+                        String::toString(memUsed_p) + " in use)");
+  }
+  memUsed_p += nbytes;
+}
+
 //# Does the storage manager allow to add rows? (yes)
 Bool MSMBase::canAddRow() const
 {
@@ -80,6 +80,10 @@ public:
   MSMBase (const String& storageManagerName, const Record&);
   // </group>
 
+  // Create a memory storage manager with the given name and a budget
+  // for the memory it can use (0 means unlimited).
+  MSMBase (const String& storageManagerName, uInt64 maxMemory);
+
   virtual ~MSMBase();
 
   // Clone this object.
@@ -92,6 +96,45 @@ public:
   // Get the name given to this storage manager.
   virtual String dataManagerName() const;
 
+  // Make a record containing the data manager specifications.
+  // It contains the memory budget (MAXMEMORY) if one is set.
+  virtual Record dataManagerSpec() const;
+
+  // Get data manager properties that can be modified.
+  // It is only MaxMemory, the memory budget in bytes (0 is unlimited).
+  virtual Record getProperties() const;
+
+  // Modify data manager properties.
+  // Only MaxMemory can be used. It can be set lower than the memory
+  // already in use, in which case further allocations will fail.
+  virtual void setProperties (const Record& spec);
+
+  // Get or set the memory budget in bytes (0 means unlimited).
+  // <group>
+  uInt64 maxMemory() const
+    { return maxMemory_p; }
+  void setMaxMemory (uInt64 maxMemory)
+    { maxMemory_p = maxMemory; }
+  // </group>
+
+  // Get the number of bytes allocated for the data of the columns.
+  uInt64 memoryUsed() const
+    { return memUsed_p; }
+
+  // Account for memory to be allocated by a column.
+  // A DataManError is thrown if the memory budget would be exceeded,
+  // so a column can reserve before allocating the memory.
+  void reserveMemory (uInt64 nbytes);
+
+  // Can the given number of bytes be reserved without exceeding the
+  // memory budget?
+  Bool canReserve (uInt64 nbytes) const
+    { return maxMemory_p == 0  ||  memUsed_p + nbytes <= maxMemory_p; }
+
+  // Account for memory freed by a column.
+  void releaseMemory (uInt64 nbytes)
+    { memUsed_p -= (nbytes < memUsed_p  ?  nbytes : memUsed_p); }
+
   // Set the hasPut_p flag. In this way the StManAipsIOColumn objects
   // can indicate that data have been put.
   void setHasPut()
@@ -192,6 +235,9 @@ protected:
   PtrBlock<MSMColumn*> colSet_p;
   // Has anything been put since the last flush?
   Bool    hasPut_p;
+  // The memory budget (0 is unlimited) and the memory in use.
+  uInt64  maxMemory_p;
+  uInt64  memUsed_p;
 };
 
 
@@ -0,0 +1,135 @@
+//# MSMCellPool.cc: Memory storage manager pool for fixed size cells
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/MSMCellPool.h>
+#include <casacore/tables/DataMan/MSMBase.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# The first slab holds 16 cells; the slab size doubles until it holds
+//# about 4 MByte.
+#define MSMPOOL_MINCELLS 16
+#define MSMPOOL_MAXBYTES (4*1024*1024)
+
+MSMCellPool::MSMCellPool (MSMBase* smptr, size_t cellSize)
+: stmanPtr_p  (smptr),
+  cellSize_p  (0),
+  nrPerSlab_p (MSMPOOL_MINCELLS),
+  next_p      (0),
+  nrLeft_p    (0),
+  freeList_p  (0),
+  nbytes_p    (0)
+{
+  setCellSize (cellSize);
+}
+
+MSMCellPool::~MSMCellPool()
+{
+  clear();
+}
+
+void MSMCellPool::setCellSize (size_t cellSize)
+{
+  clear();
+  // Round up to the alignment of any type; a cell must be able to hold
+  // the free list pointer.
+  const size_t align = alignof(std::max_align_t);
+  cellSize_p = (cellSize + align - 1) / align * align;
+  if (cellSize_p == 0) {
+    cellSize_p = align;
+  }
+}
+
+void MSMCellPool::clear()
+{
+  for (size_t i=0; i<slabs_p.size(); ++i) {
+    delete [] slabs_p[i];
+  }
+  slabs_p.clear();
+  if (stmanPtr_p) {
+    stmanPtr_p->releaseMemory (nbytes_p);
+  }
+  nbytes_p    = 0;
+  nrPerSlab_p = MSMPOOL_MINCELLS;
+  next_p      = 0;
+  nrLeft_p    = 0;
+  freeList_p  = 0;
+}
+
+void MSMCellPool::addSlab()
+{
+  uInt64 nbytes = uInt64(nrPerSlab_p) * cellSize_p;
+  // Check the budget before allocating.
+  if (stmanPtr_p) {
+    stmanPtr_p->reserveMemory (nbytes);
+  }
+  try {
+    next_p = new char[nbytes];
+  } catch (...) {
+    if (stmanPtr_p) {
+      stmanPtr_p->releaseMemory (nbytes);
+    }
+    throw;
+  }
+  slabs_p.push_back (next_p);
+  nbytes_p += nbytes;
+  nrLeft_p  = nrPerSlab_p;
+  if (2 * nrPerSlab_p * cellSize_p <= MSMPOOL_MAXBYTES) {
+    nrPerSlab_p *= 2;
+  }
+}
+
+void* MSMCellPool::alloc()
+{
+  if (freeList_p) {
+    void* cell = freeList_p;
+    freeList_p = *static_cast<void**>(cell);
+    return cell;
+  }
+  if (nrLeft_p == 0) {
+    addSlab();
+  }
+  void* cell = next_p;
+  next_p += cellSize_p;
+  nrLeft_p--;
+  return cell;
+}
+
+Bool MSMCellPool::canAlloc() const
+{
+  return freeList_p != 0  ||  nrLeft_p > 0  ||  stmanPtr_p == 0  ||
+         stmanPtr_p->canReserve (uInt64(nrPerSlab_p) * cellSize_p);
+}
+
+void MSMCellPool::free (void* cell)
+{
+  if (cell) {
+    *static_cast<void**>(cell) = freeList_p;
+    freeList_p = cell;
+  }
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,134 @@
+//# MSMCellPool.h: Memory storage manager pool for fixed size cells
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_MSMCELLPOOL_H
+#define TABLES_MSMCELLPOOL_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <cstddef>
+#include <vector>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward declarations
+class MSMBase;
+
+
+// <summary>
+// Memory storage manager pool for fixed size cells
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="UNKNOWN" date="" tests="tMemoryStMan">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> MSMBase
+//   <li> MSMDirColumn
+// </prerequisite>
+
+// <synopsis>
+// MSMCellPool hands out memory for the cells of a column with a fixed
+// cell size (such as the fixed shape arrays in an MSMDirColumn).
+// Instead of allocating each cell separately, cells are carved out of
+// slabs holding many cells. The slab size doubles until a slab holds
+// about 4 MByte, so the number of allocations grows logarithmically
+// with the number of cells.
+// A freed cell is put on a free list and reused by the next allocation,
+// so adding and removing rows does not fragment memory.
+// The slabs are only returned when the pool is cleared or destructed.
+// <p>
+// The cells are suitably aligned for any data type. They are not
+// initialized; the caller has to construct objects (e.g. String)
+// in them if needed.
+// <br>The memory used by the slabs is accounted for in the storage
+// manager, which throws an exception if its memory budget is exceeded.
+// A column can use <src>canAlloc</src> to find out beforehand and
+// reuse one of its own cells instead (see MSMDirColumn).
+// </synopsis>
+
+class MSMCellPool
+{
+public:
+  // Create a pool for cells of the given size (in bytes) that accounts
+  // its memory in the given storage manager.
+  explicit MSMCellPool (MSMBase* smptr, size_t cellSize=0);
+
+  // Free all slabs.
+  ~MSMCellPool();
+
+  // Forbid copy constructor.
+  MSMCellPool (const MSMCellPool&) = delete;
+
+  // Forbid assignment.
+  MSMCellPool& operator= (const MSMCellPool&) = delete;
+
+  // Set the cell size. It frees all slabs, so it should only be done
+  // if no cells are in use.
+  void setCellSize (size_t cellSize);
+
+  // Get a cell.
+  void* alloc();
+
+  // Can a cell be allocated without exceeding the memory budget?
+  Bool canAlloc() const;
+
+  // Return a cell to the pool.
+  void free (void* cell);
+
+  // Free all slabs. All cells given out become invalid.
+  void clear();
+
+  // Get the number of bytes allocated for the slabs.
+  uInt64 nbytes() const
+    { return nbytes_p; }
+
+private:
+  // Allocate a new slab.
+  void addSlab();
+
+  MSMBase*           stmanPtr_p;
+  // The cell size rounded up for alignment.
+  size_t             cellSize_p;
+  // The number of cells in the next slab.
+  size_t             nrPerSlab_p;
+  std::vector<char*> slabs_p;
+  // Next free cell and number of free cells in the last slab.
+  char*              next_p;
+  size_t             nrLeft_p;
+  // Free list of returned cells (linked through the cells).
+  void*              freeList_p;
+  uInt64             nbytes_p;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
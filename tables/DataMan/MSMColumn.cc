@@ -47,7 +47,8 @@ MSMColumn::MSMColumn (MSMBase* smptr, int dataType, Bool byPtr)
   nralloc_p  (0),
   nrext_p    (0),
   data_p     (EXTBLSZ,static_cast<void*>(0)),
-  ncum_p     (EXTBLSZ,(rownr_t)0)
+  ncum_p     (EXTBLSZ,(rownr_t)0),
+  extSize_p  (EXTBLSZ,(rownr_t)0)
 {}
 
 MSMColumn::~MSMColumn()
@@ -81,9 +82,18 @@ void MSMColumn::resize (rownr_t nr)
     //#cout << "resize internal blocks " << nrext_p << endl;
     data_p.resize(nrext_p + 1+EXTBLSZ);
     ncum_p.resize(nrext_p + 1+EXTBLSZ);
+    extSize_p.resize(nrext_p + 1+EXTBLSZ);
   }
   //# Allocate another block of the correct data type.
-  data_p[nrext_p+1] = allocData (nr-nralloc_p, byPtr_p);
+  //# Account for its memory first, which fails if over budget.
+  extSize_p[nrext_p+1] = nr-nralloc_p;
+  stmanPtr_p->reserveMemory (extBytes (nrext_p+1));
+  try {
+    data_p[nrext_p+1] = allocData (nr-nralloc_p, byPtr_p);
+  } catch (...) {
+    stmanPtr_p->releaseMemory (extBytes (nrext_p+1));
+    throw;
+  }
   //#cout << "allocated new block " << nr-nralloc_p << endl;
   nrext_p++;
   ncum_p[nrext_p] = nr;
@@ -461,9 +471,11 @@ void MSMColumn::remove (rownr_t index)
   //# If the extension contains only this element, remove the extension.
   if (nrval == 1) {
     deleteData (datap, byPtr_p);
+    stmanPtr_p->releaseMemory (extBytes (extnr));
     for (uInt i=extnr; i<nrext_p; i++) {
       data_p[i] = data_p[i+1];
       ncum_p[i] = ncum_p[i+1];
+      extSize_p[i] = extSize_p[i+1];
     }
     ncum_p[nrext_p] = 0;
     nrext_p--;
@@ -514,6 +526,7 @@ void MSMColumn::deleteAll()
 {
   for (uInt i=1; i<=nrext_p; i++) {
     deleteData (data_p[i], byPtr_p);
+    stmanPtr_p->releaseMemory (extBytes (i));
   }
   nralloc_p = 0;
   nrext_p   = 0;
@@ -201,6 +201,8 @@ protected:
   Block<void*> data_p;
   // The cumulative nr of rows in all extensions.
   Block<rownr_t> ncum_p;
+  // The nr of values allocated in each extension.
+  Block<rownr_t> extSize_p;
 
   // Find the extension in which the row number is.
   // If the flag is true, it also sets the columnCache object.
@@ -209,6 +211,10 @@ protected:
   // Allocate an extension with the data type of the column.
   void* allocData (rownr_t nrval, Bool byPtr);
 
+  // Get the nr of bytes used by the given extension.
+  uInt64 extBytes (uInt extnr) const
+    { return extSize_p[extnr] * (byPtr_p  ?  sizeof(void*) : elemSize()); }
+
   // Delete all extensions.
   // Possible underlying data (as used by StManArrayColumnMemory)
   // will not be deleted and should have been deleted beforehand.
@@ -33,22 +33,34 @@
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Utilities/Copy.h>
 #include <casacore/tables/DataMan/DataManError.h>
+#include <casacore/casa/IO/RegularFileIO.h>
+#include <casacore/casa/OS/RegularFile.h>
+#include <casacore/casa/System/AppInfo.h>
 #include <casacore/casa/string.h>                           // for memcpy
+#include <new>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 MSMDirColumn::MSMDirColumn (MSMBase* smptr, int dataType)
 : MSMColumn (smptr, dataType, True),
-  nrelem_p  (0)
+  nrelem_p    (0),
+  pool_p      (smptr),
+  clock_p     (0),
+  spillFile_p (0),
+  nrSlot_p    (0)
 {}
 
 MSMDirColumn::~MSMDirColumn()
 {
-  rownr_t nr = stmanPtr_p->nrow();
-  for (rownr_t i=0; i<nr; i++) {
-    deleteArray (i);
+  //# Strings have to be destructed; other cells are freed by the pool.
+  if (dtype() == TpString) {
+    rownr_t nr = stmanPtr_p->nrow();
+    for (rownr_t i=0; i<nr; i++) {
+      deleteArray (i);
+    }
   }
+  delete spillFile_p;
 }
 
 
@@ -56,6 +68,7 @@ void MSMDirColumn::setShapeColumn (const IPosition& shape)
 {
   shape_p  = shape;
   nrelem_p = shape.product();
+  pool_p.setCellSize (nrelem_p * elemSize());
 }
 
 
@@ -63,10 +76,24 @@ void MSMDirColumn::addRow (rownr_t nrnew, rownr_t nrold)
 {
   //# Extend data blocks if needed.
   MSMColumn::addRow (nrnew, nrold);
-  //# Allocate the fixed shape data arrays.
+  if (!spillSlot_p.empty()) {
+    spillSlot_p.resize (nralloc_p, -1);
+    recent_p.resize (nralloc_p, False);
+  }
+  //# Allocate the fixed shape data arrays from the pool.
+  //# Rows can already have an array if an earlier addRow failed halfway.
   void* ptr;
   for (; nrold<nrnew; nrold++) {
-    ptr = allocData (nrelem_p, False);
+    if (getArrayPtr (nrold) != 0  ||  isSpilled (nrold)) {
+      continue;
+    }
+    ptr = allocCell (nrold);
+    if (dtype() == TpString) {
+      String* str = static_cast<String*>(ptr);
+      for (rownr_t i=0; i<nrelem_p; i++) {
+        new (str+i) String();
+      }
+    }
     putArrayPtr (nrold, ptr);
   }
 }
@@ -75,7 +102,7 @@ void MSMDirColumn::doCreate (rownr_t nrrow)
 {
   addRow (nrrow, 0);
   for (rownr_t i=0; i<nrrow; i++) {
-    initData (getArrayPtr(i), nrelem_p);
+    initData (cellPtr(i), nrelem_p);
   } 
 }
 
@@ -93,11 +120,11 @@ void MSMDirColumn::getArrayV (rownr_t rownr, ArrayBase& arr)
     void* data = arr.getVStorage (deleteIt);
     if (dtype() == TpString) {
       objcopy (static_cast<String*>(data),
-               static_cast<const String*>(getArrayPtr (rownr)),
+               static_cast<const String*>(cellPtr (rownr)),
                nrelem_p);
     } else {
       memcpy (static_cast<char*>(data),
-              static_cast<const char*>(getArrayPtr (rownr)),
+              static_cast<const char*>(cellPtr (rownr)),
               elemSize() * nrelem_p);
     }
     arr.putVStorage (data, deleteIt);
@@ -108,11 +135,11 @@ void MSMDirColumn::putArrayV (rownr_t rownr, const ArrayBase& arr)
     Bool deleteIt;
     const void* data = arr.getVStorage (deleteIt);
     if (dtype() == TpString) {
-      objcopy (static_cast<String*>(getArrayPtr (rownr)),
+      objcopy (static_cast<String*>(cellPtr (rownr)),
                static_cast<const String*>(data),
                nrelem_p);
     } else {
-      memcpy (static_cast<char*>(getArrayPtr (rownr)),
+      memcpy (static_cast<char*>(cellPtr (rownr)),
               static_cast<const char*>(data),
               elemSize() * nrelem_p);
     }
@@ -214,13 +241,124 @@ void MSMDirColumn::remove (rownr_t rownr)
 {
   deleteArray (rownr);
   MSMColumn::remove (rownr);
+  if (!spillSlot_p.empty()) {
+    spillSlot_p.erase (spillSlot_p.begin() + rownr);
+    recent_p.erase (recent_p.begin() + rownr);
+    if (clock_p > rownr) {
+      clock_p--;
+    }
+    if (clock_p >= spillSlot_p.size()) {
+      clock_p = 0;
+    }
+  }
 }
 
 
 void MSMDirColumn::deleteArray (rownr_t rownr)
 {
+  if (isSpilled (rownr)) {
+    freeSlot_p.push_back (spillSlot_p[rownr]);
+    spillSlot_p[rownr] = -1;
+    return;
+  }
   void* datap = getArrayPtr (rownr);
-  deleteData (datap, False);
+  if (datap != 0) {
+    if (dtype() == TpString) {
+      String* str = static_cast<String*>(datap);
+      for (rownr_t i=0; i<nrelem_p; i++) {
+        str[i].~String();
+      }
+    }
+    pool_p.free (datap);
+    putArrayPtr (rownr, 0);
+  }
+}
+
+
+void* MSMDirColumn::cellPtr (rownr_t rownr)
+{
+  if (spillSlot_p.empty()) {
+    return getArrayPtr (rownr);
+  }
+  recent_p[rownr] = True;
+  Int64 slot = spillSlot_p[rownr];
+  if (slot < 0) {
+    return getArrayPtr (rownr);
+  }
+  //# Read the spilled array back into memory.
+  Int64 nbytes = elemSize() * nrelem_p;
+  void* ptr = allocCell (rownr);
+  try {
+    spillFile_p->pread (nbytes, slot * nbytes, ptr);
+  } catch (...) {
+    pool_p.free (ptr);
+    throw;
+  }
+  freeSlot_p.push_back (slot);
+  spillSlot_p[rownr] = -1;
+  putArrayPtr (rownr, ptr);
+  return ptr;
+}
+
+void* MSMDirColumn::allocCell (rownr_t keep)
+{
+  //# Strings cannot be spilled.
+  if (dtype() != TpString  &&  !pool_p.canAlloc()) {
+    void* ptr = spillCell (keep);
+    if (ptr != 0) {
+      return ptr;
+    }
+  }
+  //# This throws if the memory budget is exceeded.
+  return pool_p.alloc();
+}
+
+void* MSMDirColumn::spillCell (rownr_t keep)
+{
+  if (spillSlot_p.empty()) {
+    spillSlot_p.resize (nralloc_p, -1);
+    recent_p.resize (nralloc_p, False);
+    clock_p = 0;
+  }
+  //# Use the clock algorithm to find a cold array. Going round twice
+  //# is enough, because the first round clears the recent flags.
+  rownr_t nrrow = spillSlot_p.size();
+  for (rownr_t i=0; i<2*nrrow; ++i) {
+    rownr_t rownr = clock_p;
+    if (++clock_p >= nrrow) {
+      clock_p = 0;
+    }
+    if (rownr == keep  ||  spillSlot_p[rownr] >= 0) {
+      continue;
+    }
+    if (recent_p[rownr]) {
+      recent_p[rownr] = False;
+      continue;
+    }
+    void* ptr = getArrayPtr (rownr);
+    if (ptr == 0) {
+      continue;
+    }
+    //# Write the array into a free slot of the spill file, which is
+    //# created when needed and deleted when the column is destructed.
+    if (spillFile_p == 0) {
+      spillFile_p = new RegularFileIO
+        (RegularFile (AppInfo::workFileName (0, "MSMspill_")),
+         ByteIO::Scratch);
+    }
+    Int64 nbytes = elemSize() * nrelem_p;
+    Int64 slot = (freeSlot_p.empty()  ?  nrSlot_p : freeSlot_p.back());
+    spillFile_p->pwrite (nbytes, slot * nbytes, ptr);
+    if (freeSlot_p.empty()) {
+      nrSlot_p++;
+    } else {
+      freeSlot_p.pop_back();
+    }
+    spillSlot_p[rownr] = slot;
+    putArrayPtr (rownr, 0);
+    return ptr;
+  }
+  return 0;
 }
 
 } //# NAMESPACE CASACORE - END
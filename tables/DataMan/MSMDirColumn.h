@@ -30,11 +30,17 @@
 //# Includes
 #include <casacore/casa/aips.h>
 #include <casacore/tables/DataMan/MSMColumn.h>
+#include <casacore/tables/DataMan/MSMCellPool.h>
 #include <casacore/casa/Arrays/Array.h>
+#include <vector>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+//# Forward declarations
+class RegularFileIO;
+
+
 // <summary>
 // Memory storage manager for table arrays
 // </summary>
@@ -53,6 +59,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // <synopsis> 
 // MSMDirColumn handles arrays in a table column.
 // It only keeps them in memory, so they are not persistent.
+// The arrays are allocated from an
+// <linkto class=MSMCellPool>MSMCellPool</linkto>, so rows can be added
+// without allocating memory for each array separately.
+// <p>
+// If the memory budget of the storage manager does not allow to allocate
+// another array, a cold array is spilled to a scratch file and its memory
+// is reused. A clock algorithm selects the array to spill; it skips
+// arrays accessed since it last passed them. A spilled array is read back
+// when accessed (which can spill another one). Only when there is no
+// array to spill, the memory budget exception is thrown.
+// String arrays are never spilled.
 // </synopsis> 
 
 //# <todo asof="$DATE:$">
@@ -120,24 +137,54 @@ private:
   template<typename T>
   inline void doGetSlice (rownr_t rownr, const Slicer& slicer, Array<T>& data)
   {
-    Array<T> arr(shape_p, static_cast<T*>(getArrayPtr (rownr)), SHARE);
+    Array<T> arr(shape_p, static_cast<T*>(cellPtr (rownr)), SHARE);
     data = arr(slicer);
   }
 
   template<typename T>
   inline void doPutSlice (rownr_t rownr, const Slicer& slicer, const Array<T>& data)
   {
-    Array<T> arr(shape_p, static_cast<T*>(getArrayPtr (rownr)), SHARE);
+    Array<T> arr(shape_p, static_cast<T*>(cellPtr (rownr)), SHARE);
     arr(slicer) = data;
   }
 
   // Delete the array in the given row.
   void deleteArray (rownr_t rownr);
 
+  // Get the pointer to the array in the given row.
+  // A spilled array is read back into memory.
+  void* cellPtr (rownr_t rownr);
+
+  // Get the memory for an array from the pool. If the memory budget
+  // does not allow it, a cold array (not in the given row) is spilled
+  // and its memory is used.
+  void* allocCell (rownr_t keep);
+
+  // Spill a cold array (not in the given row) to the spill file and
+  // return its memory. It returns 0 if no array can be spilled.
+  void* spillCell (rownr_t keep);
+
+  // Is the array in the given row spilled?
+  Bool isSpilled (rownr_t rownr) const
+    { return !spillSlot_p.empty()  &&  spillSlot_p[rownr] >= 0; }
+
   // The shape of the array.
   IPosition shape_p;
   // The nr of elements in the array.
   rownr_t nrelem_p;
+  // The pool the arrays are allocated from.
+  MSMCellPool pool_p;
+  // The slot in the spill file of the array in each row (-1 is in memory)
+  // and the flag telling if it was accessed recently.
+  // They are empty until the first array is spilled.
+  std::vector<Int64> spillSlot_p;
+  std::vector<Bool>  recent_p;
+  // The next row the clock looks at.
+  rownr_t            clock_p;
+  // The spill file (deleted when closed) and its free slots.
+  RegularFileIO*     spillFile_p;
+  Int64              nrSlot_p;
+  std::vector<Int64> freeSlot_p;
 
 };
 
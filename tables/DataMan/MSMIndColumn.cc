@@ -68,10 +68,16 @@ void MSMIndColumn::setShape (rownr_t rownr, const IPosition& shape)
     if (ptr->shape().isEqual (shape)) {
       return;
     }
-    delete ptr;
+    deleteArray (rownr);
+  }
+  // Create the array after accounting for its memory.
+  stmanPtr_p->reserveMemory (shape.product() * elemSize());
+  try {
+    ptr = new Data (shape, dataType(), elemSize());
+  } catch (...) {
+    stmanPtr_p->releaseMemory (shape.product() * elemSize());
+    throw;
   }
-  // Create the array.
-  ptr = new Data (shape, dataType(), elemSize());
   putArrayPtr (rownr, ptr);
 }
 
@@ -273,7 +279,12 @@ void MSMIndColumn::remove (rownr_t rownr)
 void MSMIndColumn::deleteArray (rownr_t rownr)
 {
   // Remove the array for this row (if there).
-  delete MSMINDCOLUMN_GETDATA(rownr);
+  Data* ptr = MSMINDCOLUMN_GETDATA(rownr);
+  if (ptr != 0) {
+    stmanPtr_p->releaseMemory (ptr->shape().product() * elemSize());
+    delete ptr;
+    putArrayPtr (rownr, 0);
+  }
 }
 
 
@@ -37,6 +37,10 @@ MemoryStMan::MemoryStMan (const String& storageManagerName)
 : MSMBase (storageManagerName)
 {}
 
+MemoryStMan::MemoryStMan (const String& storageManagerName, uInt64 maxMemory)
+: MSMBase (storageManagerName, maxMemory)
+{}
+
 
 MemoryStMan::~MemoryStMan()
 {}
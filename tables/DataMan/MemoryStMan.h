@@ -69,6 +69,19 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // process changed data or added or deleted rows. If the number or rows
 // has changed, rows will be added or deleted as needed. Row deletion
 // will be done at the end of the table.
+// <p>
+// The arrays in fixed shape columns are allocated from slabs holding
+// many arrays (see <linkto class=MSMCellPool>MSMCellPool</linkto>),
+// which avoids fragmentation and many small allocations.
+// <br>Optionally a memory budget (in bytes) can be given, which can also
+// be set using the MAXMEMORY field in the data manager specification or
+// the MaxMemory property. If adding rows or arrays would exceed the
+// budget, the least recently used arrays of the fixed shape (non-String)
+// column are spilled to a scratch file and read back when accessed
+// (see <linkto class=MSMDirColumn>MSMDirColumn</linkto>).
+// If nothing can be spilled, a DataManError exception is thrown instead
+// of exhausting the memory of the machine. The table itself stays valid
+// in that case.
 // </synopsis> 
 
 //# <todo asof="$DATE:$">
@@ -88,6 +101,10 @@ public:
   // add a column to this storage manager.
   MemoryStMan (const String& storageManagerName);
 
+  // Create an Memory storage manager with the given name that can
+  // use at most <src>maxMemory</src> bytes (0 means unlimited).
+  MemoryStMan (const String& storageManagerName, uInt64 maxMemory);
+
   ~MemoryStMan();
 };
 
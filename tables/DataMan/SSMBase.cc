@@ -34,6 +34,7 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/casa/Containers/BlockIO.h>
 #include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Utilities/ValType.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/IO/BucketCache.h>
@@ -72,7 +73,11 @@ SSMBase::SSMBase (Int aBucketSize, uInt aCacheSize)
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsDictBucket        (-1),
+  itsDictOffset        (0),
+  itsDictLength        (0),
+  itsDictChanged       (False)
 { 
   if (aBucketSize < 0) {
     itsBucketRows = -aBucketSize;
@@ -104,7 +109,11 @@ SSMBase::SSMBase (const String& aDataManName,
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsDictBucket        (-1),
+  itsDictOffset        (0),
+  itsDictLength        (0),
+  itsDictChanged       (False)
 { 
   if (aBucketSize < 0) {
     itsBucketRows = -aBucketSize;
@@ -136,7 +145,11 @@ SSMBase::SSMBase (const String& aDataManName,
   itsFirstFreeBucket   (-1),
   itsBucketSize        (0),
   itsBucketRows        (0),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsDictBucket        (-1),
+  itsDictOffset        (0),
+  itsDictLength        (0),
+  itsDictChanged       (False)
 { 
   // Get nr of rows per bucket if defined.
   if (spec.isDefined ("BUCKETROWS")) {
@@ -155,6 +168,9 @@ SSMBase::SSMBase (const String& aDataManName,
   if (spec.isDefined ("PERSCACHESIZE")) {
     itsPersCacheSize = max(2, spec.asInt ("PERSCACHESIZE"));
   }
+  if (spec.isDefined ("DICTCOLUMNS")) {
+    setDictColumns (spec.asArrayString ("DICTCOLUMNS"));
+  }
 }
 
 SSMBase::SSMBase (const SSMBase& that)
@@ -177,7 +193,12 @@ SSMBase::SSMBase (const SSMBase& that)
   itsFirstFreeBucket   (-1),
   itsBucketSize        (that.itsBucketSize),
   itsBucketRows        (that.itsBucketRows),
-  isDataChanged        (False)
+  isDataChanged        (False),
+  itsDictColumns       (that.itsDictColumns),
+  itsDictBucket        (-1),
+  itsDictOffset        (0),
+  itsDictLength        (0),
+  itsDictChanged       (False)
 {}
 
 SSMBase::~SSMBase()
@@ -215,9 +236,26 @@ Record SSMBase::dataManagerSpec() const
   rec.define ("BUCKETSIZE", Int(itsBucketSize));
   rec.define ("PERSCACHESIZE", Int(itsPersCacheSize));
   rec.define ("IndexLength", Int(itsIndexLength));
+  // Define the dictionary encoded columns (also for an existing table).
+  std::set<String> dictColumns (itsDictColumns);
+  for (uInt i=0; i<ncolumn(); i++) {
+    if (itsPtrColumn[i]->isDictEncoded()) {
+      dictColumns.insert (itsPtrColumn[i]->columnName());
+    }
+  }
+  if (! dictColumns.empty()) {
+    rec.define ("DICTCOLUMNS",
+                Vector<String>(std::vector<String>(dictColumns.begin(),
+                                                   dictColumns.end())));
+  }
   return rec;
 }
 
+void SSMBase::setDictColumns (const Vector<String>& columnNames)
+{
+  itsDictColumns.insert (columnNames.begin(), columnNames.end());
+}
+
 Record SSMBase::getProperties() const
 {
   // Make sure the cache is initialized, so the header has certainly been read.
@@ -273,6 +311,14 @@ void SSMBase::showCacheStatistics (ostream& anOs) const
   }
 }
 
+Vector<String> SSMBase::snapshotFiles()
+{
+  if (multiFile()) {
+    return Vector<String>();
+  }
+  return Vector<String> (1, fileName());
+}
+
 void SSMBase::showIndexStatistics (ostream & anOs) const
 {
   uInt aNrIdx=itsPtrIndex.nelements();
@@ -283,7 +329,7 @@ void SSMBase::showIndexStatistics (ostream & anOs) const
   }
 }
 
-DataManagerColumn* SSMBase::makeScalarColumn (const String&,
+DataManagerColumn* SSMBase::makeScalarColumn (const String& aName,
 					      int aDataType,
 					      const String&)
 {
@@ -293,6 +339,9 @@ DataManagerColumn* SSMBase::makeScalarColumn (const String&,
     itsPtrColumn.resize (itsPtrColumn.nelements() + 32);
   }
   SSMColumn* aColumn = new SSMColumn (this, aDataType, ncolumn());
+  if (aDataType == TpString  &&  itsDictColumns.count (aName) > 0) {
+    aColumn->setDictEncoded (True);
+  }
   itsPtrColumn[ncolumn()] = aColumn;
   return aColumn;
 }
@@ -374,6 +423,7 @@ void SSMBase::makeCache()
 
     if (forceFill) {
       readIndexBuckets();
+      readDictionaries();
     }
   }
 }
@@ -431,6 +481,14 @@ void SSMBase::readHeader()
   anOs >> itsIndexLength;               // length of index
   uInt nrinx;
   anOs >> nrinx;                        // Nr of indices
+  itsDictBucket = -1;
+  itsDictOffset = 0;
+  itsDictLength = 0;
+  if (version >= 4) {
+    anOs >> itsDictBucket;              // Location of the dictionaries
+    anOs >> itsDictOffset;
+    anOs >> itsDictLength;
+  }
 
   if (itsStringHandler == 0) {
     itsStringHandler = new SSMStringHandler(this);
@@ -507,6 +565,9 @@ void SSMBase::readIndexBuckets()
 
 void SSMBase::writeIndex()
 {
+  if (itsDictChanged) {
+    writeDictionaries();
+  }
   std::shared_ptr<TypeIO> aTio;
   std::shared_ptr<TypeIO> aMio;
   auto aMemBuf = std::make_shared<MemoryIO>();
@@ -612,7 +673,11 @@ void SSMBase::writeIndex()
   // Write a few items at the beginning of the file  AipsIO anOs (aTio);
   // The endian switch is a new feature. So only put it if little endian
   // is used. In that way older software can read newer tables.
-  if (asBigEndian()) {
+  // Version 4 (with dictionaries) is only used if dictionaries are stored.
+  if (itsDictBucket >= 0) {
+    anOs.putstart("StandardStMan", 4);
+    anOs << asBigEndian();
+  } else if (asBigEndian()) {
     anOs.putstart("StandardStMan", 2);
   } else {
     anOs.putstart("StandardStMan", 3);
@@ -629,6 +694,11 @@ void SSMBase::writeIndex()
   anOs << itsLastStringBucket;          // Last String bucket in use
   anOs << idxLength;                    // length of index
   anOs << uInt(itsPtrIndex.nelements());// Nr of indices
+  if (itsDictBucket >= 0) {
+    anOs << itsDictBucket;              // Location of the dictionaries
+    anOs << itsDictOffset;
+    anOs << itsDictLength;
+  }
   
   anOs.putend();  
   anOs.close();
@@ -638,6 +708,102 @@ void SSMBase::writeIndex()
   itsFile->fsync();
 }
 
+void SSMBase::readDictionaries()
+{
+  // Initialize the dictionaries, so columns not found are empty.
+  for (uInt i=0; i<ncolumn(); i++) {
+    if (itsPtrColumn[i]->isDictEncoded()) {
+      itsPtrColumn[i]->setDictionary (std::vector<String>());
+    }
+  }
+  itsDictChanged = False;
+  if (itsDictBucket < 0) {
+    return;
+  }
+  String blob;
+  itsStringHandler->get (blob, itsDictBucket, itsDictOffset, itsDictLength);
+  auto aMemBuf = std::make_shared<MemoryIO>(blob.data(), blob.size());
+  std::shared_ptr<TypeIO> aMio;
+  if (asBigEndian()) {
+    aMio.reset (new CanonicalIO (aMemBuf));
+  } else {
+    aMio.reset (new LECanonicalIO (aMemBuf));
+  }
+  AipsIO anMOs (aMio);
+  anMOs.getstart ("SSMDict");
+  uInt nrcol;
+  anMOs >> nrcol;
+  for (uInt i=0; i<nrcol; i++) {
+    String name;
+    uInt nrval;
+    anMOs >> name >> nrval;
+    std::vector<String> dict(nrval);
+    for (uInt j=0; j<nrval; j++) {
+      anMOs >> dict[j];
+    }
+    // Find the column (it might have been removed).
+    for (uInt k=0; k<ncolumn(); k++) {
+      if (itsPtrColumn[k]->isDictEncoded()  &&
+          itsPtrColumn[k]->columnName() == name) {
+        itsPtrColumn[k]->setDictionary (dict);
+      }
+    }
+  }
+  anMOs.getend();
+  anMOs.close();
+}
+
+void SSMBase::writeDictionaries()
+{
+  std::vector<SSMColumn*> cols;
+  for (uInt i=0; i<ncolumn(); i++) {
+    if (itsPtrColumn[i]->isDictEncoded()) {
+      cols.push_back (itsPtrColumn[i]);
+    }
+  }
+  if (cols.empty()) {
+    // Remove the dictionaries (all such columns have been removed).
+    if (itsDictBucket >= 0) {
+      itsStringHandler->remove (itsDictBucket, itsDictOffset, itsDictLength);
+      itsDictBucket = -1;
+      itsDictOffset = 0;
+      itsDictLength = 0;
+    }
+  } else {
+    // Write the dictionaries in canonical format into a memory buffer.
+    auto aMemBuf = std::make_shared<MemoryIO>();
+    std::shared_ptr<TypeIO> aMio;
+    if (asBigEndian()) {
+      aMio.reset (new CanonicalIO (aMemBuf));
+    } else {
+      aMio.reset (new LECanonicalIO (aMemBuf));
+    }
+    AipsIO anMOs (aMio);
+    anMOs.putstart ("SSMDict", 1);
+    anMOs << uInt(cols.size());
+    for (SSMColumn* col : cols) {
+      const std::vector<String>& dict = col->getDictionary();
+      anMOs << col->columnName() << uInt(dict.size());
+      for (const String& value : dict) {
+        anMOs << value;
+      }
+    }
+    anMOs.putend();
+    anMOs.close();
+    // Store the buffer as a single string in the string buckets.
+    // It reuses the current location if the dictionaries still fit.
+    String blob (reinterpret_cast<const char*>(aMemBuf->getBuffer()),
+                 aMemBuf->length());
+    if (itsDictBucket < 0) {
+      itsDictBucket = 0;
+      itsDictOffset = 0;
+      itsDictLength = 0;
+    }
+    itsStringHandler->put (itsDictBucket, itsDictOffset, itsDictLength, blob);
+  }
+  itsDictChanged = False;
+}
+
 void SSMBase::setBucketDirty()
 {
   itsCache->setDirty();
@@ -936,6 +1102,11 @@ void SSMBase::recreate()
   
   itsStringHandler = new SSMStringHandler(this);
   itsStringHandler->init();
+  // The dictionaries have to be written again.
+  itsDictBucket  = -1;
+  itsDictOffset  = 0;
+  itsDictLength  = 0;
+  itsDictChanged = True;
 
   // Let the column objects create something (if needed)
   uInt aNrCol = ncolumn();
@@ -970,10 +1141,20 @@ Bool SSMBase::flush (AipsIO& ios, Bool doFsync)
   if (itsIosFile) {
     itsIosFile->flush(doFsync);
   }
-  ios.putstart ("SSM", 2);
+  // Version 3 (with dictionary flags) is only used if needed.
+  Block<Bool> dictFlags (ncolumn(), False);
+  Bool hasDict = False;
+  for (uInt i=0; i<ncolumn(); i++) {
+    dictFlags[i] = itsPtrColumn[i]->isDictEncoded();
+    hasDict = hasDict || dictFlags[i];
+  }
+  ios.putstart ("SSM", hasDict ? 3 : 2);
   ios << itsDataManName;
   putBlock (ios, itsColumnOffset, itsColumnOffset.nelements());
   putBlock (ios, itsColIndexMap,  itsColIndexMap.nelements());
+  if (hasDict) {
+    putBlock (ios, dictFlags, dictFlags.nelements());
+  }
   ios.putend();
   return changed;
 }
@@ -994,6 +1175,9 @@ rownr_t SSMBase::resync64 (rownr_t aNrRows)
   if (itsStringHandler != 0) {
     itsStringHandler->resync();
   }
+  if (itsCache != 0) {
+    readDictionaries();
+  }
 
   uInt aNrCol = ncolumn();
   if (itsIosFile != 0) {
@@ -1016,10 +1200,17 @@ void SSMBase::create64 (rownr_t aNrRows)
 rownr_t SSMBase::open64 (rownr_t aRowNr, AipsIO& ios)
 {
   itsNrRows = aRowNr;
-  ios.getstart ("SSM");
+  uInt version = ios.getstart ("SSM");
   ios >> itsDataManName;
   getBlock (ios,itsColumnOffset);
   getBlock (ios,itsColIndexMap);
+  if (version >= 3) {
+    Block<Bool> dictFlags;
+    getBlock (ios, dictFlags);
+    for (uInt i=0; i<dictFlags.nelements(); i++) {
+      itsPtrColumn[i]->setDictEncoded (dictFlags[i]);
+    }
+  }
   ios.getend();
   
   itsFile = new BucketFile (fileName(), table().isWritable(),
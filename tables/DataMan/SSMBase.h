@@ -31,6 +31,8 @@
 #include <casacore/casa/aips.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/casa/Containers/Block.h>
+#include <casacore/casa/Arrays/ArrayFwd.h>
+#include <set>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -127,6 +129,13 @@ class SSMStringHandler;
 // handled by class <linkto class=StIndArray>StIndArray</linkto>
 // which uses an extra file to store the arrays.
 // <p>
+// Scalar String columns can be stored with dictionary encoding, which is
+// useful if a column contains many repeated values. The data bucket then
+// contains an Int code per row, while the distinct values of a column are
+// kept in a dictionary (in memory). The dictionaries of all columns are
+// stored as a single blob in the string buckets; its bucketnr, offset,
+// and length are stored in the header.
+// <p>
 // Index buckets are used by SSMBase to make the SSMIndex data persistent.
 // It uses alternately 2 sets of index buckets. In that way there is
 // always an index availanle in case the system crashes.
@@ -198,6 +207,11 @@ public:
 
   // Get the version of the class.
   uInt getVersion() const;
+
+  // Use dictionary encoding for the given scalar String columns.
+  // It has to be done before the columns are bound to the storage manager.
+  // It can also be given as DICTCOLUMNS in the specification record.
+  void setDictColumns (const Vector<String>& columnNames);
   
   // Set the cache size (in buckets).
   // If <src>canExceedNrBuckets=True</src>, the given cache size can be
@@ -217,6 +231,10 @@ public:
   // Show the statistics of all caches used.
   virtual void showCacheStatistics (ostream& anOs) const;
 
+  // Get the bucket file, which can be snapshotted using copy-on-write
+  // if no MultiFile is used.
+  virtual Vector<String> snapshotFiles();
+
   // Show statistics of all indices used.
   void showIndexStatistics (ostream & anOs) const;
 
@@ -284,6 +302,14 @@ public:
   // Return a pointer to the (one and only) StringHandler object.
   SSMStringHandler* getStringHandler();
 
+  // Make sure the dictionaries of an existing table have been read.
+  // They are read when the cache is constructed.
+  void initDictionaries();
+
+  // Tell that the dictionary of a column has changed, so the
+  // dictionaries have to be written when flushing.
+  void setDictChanged();
+
   // <group>
   // Callbacks for BucketCache access.
   static char* readCallBack (void* anOwner, const char* aBucketStorage);
@@ -389,6 +415,14 @@ private:
   // Write the header and the indices.
   void writeIndex();
 
+  // Read the dictionaries of the dictionary encoded columns from the
+  // string buckets.
+  void readDictionaries();
+
+  // Write the dictionaries of the dictionary encoded columns into the
+  // string buckets.
+  void writeDictionaries();
+
 
   //# Declare member variables.
   // Name of data manager.
@@ -458,6 +492,17 @@ private:
   
   // Has the data changed since the last flush?
   Bool isDataChanged;
+
+  // The names of the columns to be stored with dictionary encoding.
+  std::set<String> itsDictColumns;
+
+  // Bucketnr, offset, and length of the dictionaries in the string buckets.
+  Int itsDictBucket;
+  Int itsDictOffset;
+  Int itsDictLength;
+
+  // Has a dictionary changed since the last flush?
+  Bool itsDictChanged;
 };
 
 
@@ -504,6 +549,17 @@ inline SSMStringHandler* SSMBase::getStringHandler()
   return itsStringHandler;
 }
 
+inline void SSMBase::initDictionaries()
+{
+  getCache();
+}
+
+inline void SSMBase::setDictChanged()
+{
+  itsDictChanged = True;
+  isDataChanged  = True;
+}
+
 
 
 } //# NAMESPACE CASACORE - END
@@ -35,6 +35,7 @@
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/OS/CanonicalConversion.h>
 #include <casacore/casa/OS/LECanonicalConversion.h>
+#include <casacore/tables/DataMan/DataManError.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -48,7 +49,9 @@ SSMColumn::SSMColumn (SSMBase* aParent, int aDataType, uInt aColNr)
   itsMaxLen      (0),
   itsNrElem      (1),
   itsNrCopy      (0),
-  itsData        (0)
+  itsData        (0),
+  itsDictEncoded (False),
+  itsDictGeneration (0)
 {
   init();
 }
@@ -71,6 +74,85 @@ void SSMColumn::setMaxLength (uInt maxLength)
     init();
 }
 
+void SSMColumn::setDictEncoded (Bool dictEncoded)
+{
+    itsDictEncoded = dictEncoded;
+    if (itsDictEncoded) {
+      setDictionary (std::vector<String>());
+    }
+    init();
+}
+
+void SSMColumn::setDictionary (const std::vector<String>& aDict)
+{
+    itsDict = aDict;
+    // Code 0 is always the empty string (the value of a new row).
+    if (itsDict.empty()) {
+      itsDict.push_back (String());
+    }
+    itsDictIndex.clear();
+    for (uInt i=0; i<itsDict.size(); i++) {
+      itsDictIndex[itsDict[i]] = i;
+    }
+    itsDictGeneration++;
+}
+
+Int SSMColumn::getDictCode (rownr_t aRowNr)
+{
+    if (! itsDictEncoded) {
+      return StManColumnBase::getDictCode (aRowNr);
+    }
+    // Finding the row also reads the dictionaries if needed.
+    rownr_t aStartRow;
+    rownr_t anEndRow;
+    char* buf = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow,
+                                 columnName());
+    Int code;
+    itsReadFunc (&code, buf+(aRowNr-aStartRow)*itsExternalSizeBytes,
+                 itsNrCopy);
+    if (code < 0  ||  code >= Int(itsDict.size())) {
+      throw DataManError ("SSMColumn: invalid dictionary code " +
+                          String::toString(code) + " in row " +
+                          String::toString(aRowNr) + " of column " +
+                          columnName());
+    }
+    return code;
+}
+
+Int SSMColumn::findDictCode (const String& aValue)
+{
+    if (! itsDictEncoded) {
+      return StManColumnBase::findDictCode (aValue);
+    }
+    itsSSMPtr->initDictionaries();
+    std::map<String,Int>::const_iterator iter = itsDictIndex.find (aValue);
+    return (iter == itsDictIndex.end()  ?  -1 : iter->second);
+}
+
+uInt64 SSMColumn::dictGeneration()
+{
+    if (! itsDictEncoded) {
+      return StManColumnBase::dictGeneration();
+    }
+    itsSSMPtr->initDictionaries();
+    return itsDictGeneration;
+}
+
+Int SSMColumn::getOrAddDictCode (const String& aValue)
+{
+    itsSSMPtr->initDictionaries();
+    std::map<String,Int>::const_iterator iter = itsDictIndex.find (aValue);
+    if (iter != itsDictIndex.end()) {
+      return iter->second;
+    }
+    Int code = itsDict.size();
+    itsDict.push_back (aValue);
+    itsDictIndex[aValue] = code;
+    itsDictGeneration++;
+    itsSSMPtr->setDictChanged();
+    return code;
+}
+
 uInt SSMColumn::ndim (rownr_t)
 {
     return itsShape.nelements();
@@ -117,7 +199,7 @@ void SSMColumn::deleteRow(rownr_t aRowNr)
   rownr_t anERow;
   int aDT = dataType();
 
-  if (aDT == TpString  &&  itsMaxLen == 0) {
+  if (aDT == TpString  &&  itsMaxLen == 0  &&  !itsDictEncoded) {
     Int buf[3];
     getRowValue(buf, aRowNr);
     if (buf[2] > 8 ) {
@@ -249,7 +331,9 @@ void SSMColumn::getDComplex (rownr_t aRowNr,DComplex* aValue)
 
 void SSMColumn::getString (rownr_t aRowNr, String* aValue)
 {
-  if (itsMaxLen > 0) {
+  if (itsDictEncoded) {
+    *aValue = itsDict[getDictCode (aRowNr)];
+  } else if (itsMaxLen > 0) {
     // Allocate the maximum number of characters needed
     // The +1 is to correct for the incorrect use of the chars() function
     // Should be changed to use real Char*
@@ -422,8 +506,17 @@ void SSMColumn::putDComplex (rownr_t aRowNr, const DComplex* aValue)
 
 void SSMColumn::putString (rownr_t aRowNr, const String* aValue)
 {
-  // Fixed length strings are written directly.
-  if (itsMaxLen > 0) {
+  if (itsDictEncoded) {
+    // Store the code of the value (truncated to the maximum length).
+    Int code;
+    if (itsMaxLen > 0  &&  aValue->length() > itsMaxLen) {
+      code = getOrAddDictCode (aValue->substr (0, itsMaxLen));
+    } else {
+      code = getOrAddDictCode (*aValue);
+    }
+    putValue (aRowNr, &code);
+  } else if (itsMaxLen > 0) {
+    // Fixed length strings are written directly.
     rownr_t aStartRow;
     rownr_t anEndRow;
     char*   aDummy = itsSSMPtr->find (aRowNr, itsColNr, aStartRow, anEndRow,
@@ -491,7 +584,19 @@ void SSMColumn::putValueShortString(rownr_t aRowNr, const void* aValue,
 
 void SSMColumn::getScalarColumnV (ArrayBase& aDataPtr)
 {
-  if (dtype() == TpString) {
+  if (itsDictEncoded) {
+    // Get all codes and decode them.
+    Vector<String>& vec = static_cast<Vector<String>&>(aDataPtr);
+    std::vector<Int> codes(vec.nelements());
+    getColumnValue (codes.data(), codes.size());
+    for (uInt64 i=0; i<codes.size(); i++) {
+      if (codes[i] < 0  ||  codes[i] >= Int(itsDict.size())) {
+        throw DataManError ("SSMColumn: invalid dictionary code in column " +
+                            columnName());
+      }
+      vec[i] = itsDict[codes[i]];
+    }
+  } else if (dtype() == TpString) {
     Vector<String>& vec = static_cast<Vector<String>&>(aDataPtr);
     for (uInt64 i=0; i<aDataPtr.nelements(); i++) {
       getString (i, &(vec[i]));
@@ -527,6 +632,7 @@ void SSMColumn::getColumnValue(void* anArray,rownr_t aNrRows)
 void SSMColumn::putScalarColumnV (const ArrayBase& aDataPtr)
 {
   if (dtype() == TpString) {
+    // Note that putString encodes the value for a dictionary encoded column.
     const Vector<String>& vec = static_cast<const Vector<String>&>(aDataPtr);
     for (uInt64 i=0 ; i<aDataPtr.nelements(); i++) {
       putString (i, &(vec[i]));
@@ -565,7 +671,10 @@ void SSMColumn::putColumnValue(const void* anArray,rownr_t aNrRows)
 
 void SSMColumn::removeColumn()
 {
-  if (dataType() == TpString  &&  itsMaxLen == 0) {
+  if (itsDictEncoded) {
+    // The dictionaries have to be written without this column.
+    itsSSMPtr->setDictChanged();
+  } else if (dataType() == TpString  &&  itsMaxLen == 0) {
     Int buf[3];
     for (rownr_t i=0; i<itsSSMPtr->getNRow(); i++) {
       getRowValue(buf, i);
@@ -583,8 +692,16 @@ void SSMColumn::init()
   Bool asBigEndian = itsSSMPtr->asBigEndian();
   itsNrCopy = itsNrElem;
   if (aDT == TpString) {
-    // Fixed length strings are written directly.
-    if (itsMaxLen > 0) {
+    if (itsDictEncoded) {
+      // Dictionary encoded strings are written as an Int code.
+      itsLocalSize = ValType::getTypeSize(TpInt);
+      itsExternalSizeBytes = ValType::getCanonicalSize (TpInt, asBigEndian);
+      uInt aNRel;
+      ValType::getCanonicalFunc (TpInt, itsReadFunc, itsWriteFunc, aNRel,
+				 asBigEndian);
+      itsNrCopy = aNRel;
+    } else if (itsMaxLen > 0) {
+      // Fixed length strings are written directly.
       itsNrCopy = itsMaxLen;
       itsLocalSize = itsNrCopy;
       itsExternalSizeBytes = itsNrCopy;
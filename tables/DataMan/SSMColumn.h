@@ -34,6 +34,8 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/OS/Conversion.h>
+#include <map>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -82,6 +84,12 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // length of the string. However, it the string is short enough (ie. <=
 // 8 characters), the string is stored directly in data bucket using
 // the space for bucketnr and offset.
+// <br>A scalar String column can also be stored with dictionary encoding.
+// In that case the data bucket contains an Int code per row, which is the
+// index of the value in the column's dictionary of distinct values.
+// Code 0 is the empty string, so new rows contain an empty string.
+// The dictionary is kept in memory and never shrinks; it is stored
+// by <linkto class=SSMBase>SSMBase</linkto>.
 // <p>
 // The class maintains a cache of the data in the bucket last read.
 // This cache is used by the higher level table classes to get faster
@@ -120,6 +128,28 @@ public:
   // a fixed length.
   virtual void setMaxLength (uInt maxLength);
 
+  // Set if a scalar String column is stored with dictionary encoding.
+  // It is called right after the constructor.
+  void setDictEncoded (Bool dictEncoded);
+
+  // Is the column stored with dictionary encoding?
+  virtual Bool isDictEncoded() const;
+
+  // Get the dictionary code of the value in the given row.
+  virtual Int getDictCode (rownr_t aRowNr);
+
+  // Get the dictionary code of a value (-1 if not in the dictionary).
+  virtual Int findDictCode (const String& aValue);
+
+  // Get the generation of the dictionary (incremented when it changes).
+  virtual uInt64 dictGeneration();
+
+  // Get or set the dictionary (used by SSMBase to read or write it).
+  // <group>
+  const std::vector<String>& getDictionary() const;
+  void setDictionary (const std::vector<String>& aDict);
+  // </group>
+
   // Get the dimensionality of the item in the given row.
   virtual uInt ndim (rownr_t aRowNr);
   
@@ -257,6 +287,13 @@ protected:
   Conversion::ValueFunction* itsWriteFunc;
   // Pointer to a convert function for reading.
   Conversion::ValueFunction* itsReadFunc;
+  // Is the column stored with dictionary encoding?
+  Bool              itsDictEncoded;
+  // The dictionary and the index to find the code of a value.
+  std::vector<String>  itsDict;
+  std::map<String,Int> itsDictIndex;
+  // Incremented each time the dictionary is set or a value is added.
+  uInt64               itsDictGeneration;
   
 private:
   // Initialize part of the object.
@@ -266,6 +303,9 @@ private:
 
   // Get the pointer to the cache. It is created if not done yet.
   char* getDataPtr();
+
+  // Get the code of a value, where a new value is added to the dictionary.
+  Int getOrAddDictCode (const String& aValue);
 };
 
 
@@ -287,6 +327,16 @@ inline char* SSMColumn::getDataPtr()
   return static_cast<char*>(itsData);
 }
 
+inline Bool SSMColumn::isDictEncoded() const
+{
+  return itsDictEncoded;
+}
+
+inline const std::vector<String>& SSMColumn::getDictionary() const
+{
+  return itsDict;
+}
+
 inline uInt SSMColumn::getColNr()
 {
   return itsColNr;
@@ -104,6 +104,18 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 // <p>
 // As said above all string arrays and variable length scalar strings
 // are stored in separate string buckets. 
+// <p>
+// Scalar String columns containing many repeated values (e.g. names or
+// labels) can be stored with dictionary encoding. The data buckets then
+// contain an integer code per row, while each distinct value is stored
+// only once in a dictionary per column. It makes the table smaller and
+// makes it possible to compare values using their codes (which TaQL does
+// for == and != comparisons of such a column with a constant).
+// Note that the dictionary is kept in memory and never shrinks, so it
+// should only be used for columns with a limited number of distinct values.
+// The columns to encode can be set using function
+// <src>setDictColumns</src> or by field DICTCOLUMNS in the
+// data manager specification record.
 // </synopsis>
 
 // <motivation>
@@ -137,6 +149,16 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //   newtab.bindAll ("column1", stman);       // bind all columns to st.man.
 //   Table tab(newtab);                       // actually create table
 // </srcblock>
+//
+// The following example shows how to store column SOURCE with dictionary
+// encoding.
+// <srcblock>
+//   SetupNewTable newtab("name.data", tableDesc, Table::New);
+//   StandardStMan stman;
+//   stman.setDictColumns (Vector<String>(1, "SOURCE"));
+//   newtab.bindAll (stman);
+//   Table tab(newtab);
+// </srcblock>
 // </example>
 
 //# <todo asof="$DATE:$">
@@ -1005,12 +1005,17 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     uInt dataOffset;
     size_t sectionOffset;
     uInt tileNr = expandedTilesPerDim_p.offset (tilePos);
+    // When reading with O_DIRECT, read consecutive tiles in a single block.
+    Bool prefetch = !writeFlag  &&  filePtr_p->bucketFile()->isDirect();
 
     while (True) {
 //      cout << "tilePos=" << tilePos << endl;
 //      cout << "tileNr=" << tileNr << endl;
 //      cout << "start=" << startPixel << endl;
 //      cout << "end=" << endPixel << endl;
+        if (prefetch  &&  tilePos(0) == startTile_p(0)) {
+            cachePtr->prefetch (tileNr, nrConsecutiveTiles (tilePos));
+        }
         // Get the tile from the cache.
         // Set it to dirty if we are writing.
         char* dataArray = cachePtr->getBucket (tileNr);
@@ -1097,6 +1102,20 @@ void TSMCube::accessSection (const IPosition& start, const IPosition& end,
     }
 }
 
+uInt TSMCube::nrConsecutiveTiles (const IPosition& tilePos) const
+{
+    // The tiles in the first axis are consecutive. If the section contains
+    // all tiles in an axis, the tiles in the next axis are also consecutive.
+    uInt64 nr = 1;
+    for (uInt i=0; i<nrdim_p; i++) {
+        nr *= 1 + endTile_p(i) - tilePos(i);
+        if (tilePos(i) != 0  ||  endTile_p(i) != tilesPerDim_p(i) - 1) {
+            break;
+        }
+    }
+    return std::min (nr, uInt64(nrTiles_p));
+}
+
 void TSMCube::accessLine (char* section, uInt pixelOffset,
                           uInt localPixelSize,
                           Bool writeFlag, BucketCache* cachePtr,
@@ -34,6 +34,7 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/OS/Conversion.h>
 #include <casacore/casa/iosfwd.h>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -89,6 +90,11 @@ template<class T> class Block;
 // The description of class
 // <linkto class=ROTiledStManAccessor>ROTiledStManAccessor</linkto>
 // contains a discussion about the effect of setting the maximum cache size.
+// <p>
+// The cache and the state used while accessing a section are not
+// thread-safe. Therefore TSMDataColumn locks the mutex of the hypercube
+// while accessing it, so threads putting data into the same hypercube
+// (e.g. each into its own range of rows) are serialized.
 // </synopsis> 
 
 // <motivation>
@@ -291,6 +297,10 @@ public:
     void setLastColSlice (const IPosition& slice);
     // </group>
 
+    // Get the mutex to be locked while accessing the hypercube.
+    std::mutex& accessMutex()
+      { return accessMutex_p; }
+
 protected:
     // Initialize the various variables.
     // <group>
@@ -331,6 +341,11 @@ private:
 		     uInt endPixelInLastTile,
 		     uInt lineIndex);
 
+    // Get the number of tiles, starting at the given tile position,
+    // that are needed in the current section and are consecutive in the
+    // file. It is used to read them in a single block using O_DIRECT.
+    uInt nrConsecutiveTiles (const IPosition& tilePos) const;
+
     // Define the callback functions for the BucketCache.
     // <group>
     static char* readCallBack (void* owner, const char* external);
@@ -398,6 +413,8 @@ protected:
     AccessType      lastColAccess_p;
     // The slice shape of the last column access to a slice.
     IPosition       lastColSlice_p;
+    // The mutex serializing the accesses of TSMDataColumn.
+    std::mutex      accessMutex_p;
 
     // IPosition variables used in accessSection(); declared here
     // as member variables to avoid significant construction and
@@ -164,6 +164,8 @@ void TSMDataColumn::accessCell (rownr_t rownr, const void* dataPtr,
     // It also gives the position of the row in the hypercube.
     IPosition end;
     TSMCube* hypercube = stmanPtr_p->getHypercube (rownr, end);
+    // Threads accessing the same hypercube have to be serialized.
+    std::lock_guard<std::mutex> lock(hypercube->accessMutex());
     IPosition start (end);
     for (uInt i=0; i<stmanPtr_p->nrCoordVector(); i++) {
 	start(i) = 0;
@@ -187,6 +189,7 @@ void TSMDataColumn::accessCellSlice (rownr_t rownr, const Slicer& ns,
 {
     IPosition end;
     TSMCube* hypercube = stmanPtr_p->getHypercube (rownr, end);
+    std::lock_guard<std::mutex> lock(hypercube->accessMutex());
     IPosition endcp (end);
     IPosition start (end);
     IPosition stride (end.nelements(), 1);
@@ -230,6 +233,7 @@ void TSMDataColumn::accessColumn (const void* dataPtr, Bool writeFlag)
 {
     // Get the single hypercube and the shape of the hypercube.
     TSMCube* hypercube = stmanPtr_p->singleHypercube();
+    std::lock_guard<std::mutex> lock(hypercube->accessMutex());
     IPosition end (hypercube->cubeShape());
     end -= 1;
     IPosition start (end.nelements(), 0);
@@ -248,6 +252,7 @@ void TSMDataColumn::accessColumnSlice (const Slicer& ns,
 {
     // Get the single hypercube and the shape of the hypercube.
     TSMCube* hypercube = stmanPtr_p->singleHypercube();
+    std::lock_guard<std::mutex> lock(hypercube->accessMutex());
     IPosition end (hypercube->cubeShape());
     end -= 1;
     IPosition endcp (end);
@@ -458,6 +463,7 @@ void TSMDataColumn::accessFullCells (TSMCube* hypercube,
 				     const IPosition& end,
 				     const IPosition& incr)
 {
+  std::lock_guard<std::mutex> lock(hypercube->accessMutex());
   //  cout << "accessFullCells " << start << end << incr << endl;
   // Size the cache if the user has not done it.
   if (! stmanPtr_p->userSetCache (0)) {
@@ -477,6 +483,7 @@ void TSMDataColumn::accessSlicedCells (TSMCube* hypercube,
 				       const IPosition& end,
 				       const IPosition& incr)
 {
+  std::lock_guard<std::mutex> lock(hypercube->accessMutex());
   //  cout << "accessSlicedCells " << start << end << incr << endl;
   // Size the cache if the user has not done it.
   if (! stmanPtr_p->userSetCache (0)) {
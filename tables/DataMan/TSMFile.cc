@@ -51,7 +51,8 @@ TSMFile::TSMFile (const TiledStMan* stman, uInt fileSequenceNr,
     if (tsmOpt.option() == TSMOption::Buffer) {
       bufSize = tsmOpt.bufferSize();
     }
-    file_p = new BucketFile (fileName, bufSize, mapOpt, mfile);
+    Bool directOpt = tsmOpt.option() == TSMOption::Direct;
+    file_p = new BucketFile (fileName, bufSize, mapOpt, mfile, directOpt);
 }
 
 TSMFile::TSMFile (const String& fileName, Bool writable,
@@ -67,7 +68,9 @@ TSMFile::TSMFile (const String& fileName, Bool writable,
     if (tsmOpt.option() == TSMOption::Buffer) {
       bufSize = tsmOpt.bufferSize();
     }
-    file_p = new BucketFile (fileName, writable, bufSize, mapOpt, mfile);
+    Bool directOpt = tsmOpt.option() == TSMOption::Direct;
+    file_p = new BucketFile (fileName, writable, bufSize, mapOpt, mfile,
+                             directOpt);
 }
 
 TSMFile::TSMFile (const TiledStMan* stman, AipsIO& ios, uInt seqnr,
@@ -88,8 +91,9 @@ TSMFile::TSMFile (const TiledStMan* stman, AipsIO& ios, uInt seqnr,
     if (tsmOpt.option() == TSMOption::Buffer) {
       bufSize = tsmOpt.bufferSize();
     }
+    Bool directOpt = tsmOpt.option() == TSMOption::Direct;
     file_p = new BucketFile (fileName, stman->table().isWritable(),
-                             bufSize, mapOpt, mfile);
+                             bufSize, mapOpt, mfile, directOpt);
 }
 
 TSMFile::~TSMFile()
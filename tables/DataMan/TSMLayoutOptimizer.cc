@@ -0,0 +1,576 @@
+//# TSMLayoutOptimizer.cc: Choose and apply a tile shape for a tiled column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/tables/DataMan/TSMLayoutOptimizer.h>
+#include <casacore/tables/DataMan/TiledStManAccessor.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/ColumnDesc.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/OS/Path.h>
+#include <casacore/casa/Utilities/ValType.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <list>
+#include <set>
+#include <unordered_map>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+  namespace {
+
+    // Parse a shape like [1,2,3].
+    Bool parseShape (const String& str, IPosition& shape)
+    {
+      if (str.size() < 2  ||  str[0] != '['  ||  str[str.size()-1] != ']') {
+        return False;
+      }
+      std::vector<ssize_t> vals;
+      String s = str.substr (1, str.size()-2);
+      std::istringstream iss(s);
+      std::string part;
+      while (std::getline (iss, part, ',')) {
+        if (! part.empty()) {
+          vals.push_back (atoll(part.c_str()));
+        }
+      }
+      shape.resize (vals.size());
+      for (uInt i=0; i<vals.size(); ++i) {
+        shape[i] = vals[i];
+      }
+      return True;
+    }
+
+    // Split the blc, trc, and inc of a slice written as [..][..][..].
+    Bool parseSlice (const String& str, IPosition& blc, IPosition& trc)
+    {
+      size_t e1 = str.find (']');
+      size_t e2 = str.find (']', e1+1);
+      if (e1 == String::npos  ||  e2 == String::npos) {
+        return False;
+      }
+      return parseShape (str.substr(0, e1+1), blc)  &&
+             parseShape (str.substr(e1+1, e2-e1), trc);
+    }
+
+    // Parse the row specification (start[:end[:inc]],...) written by
+    // TableTrace. Each element gets start, end, inc.
+    void parseRows (const String& str, Int64 nrow,
+                    std::vector<Int64>& rows)
+    {
+      rows.clear();
+      if (str == "*") {
+        rows.push_back (0);
+        rows.push_back (nrow-1);
+        rows.push_back (1);
+        return;
+      }
+      std::istringstream iss(str);
+      std::string part;
+      while (std::getline (iss, part, ',')) {
+        Int64 v[3] = {0, -1, 1};
+        std::istringstream piss(part);
+        std::string num;
+        int n = 0;
+        while (n < 3  &&  std::getline (piss, num, ':')) {
+          v[n++] = atoll(num.c_str());
+        }
+        if (n == 1) {
+          v[1] = v[0];
+        }
+        rows.push_back (v[0]);
+        rows.push_back (v[1]);
+        rows.push_back (std::max(v[2], Int64(1)));
+      }
+    }
+
+    template<typename T>
+    void copyRange (Table& table, const String& from, const String& to,
+                    rownr_t start, rownr_t nrow)
+    {
+      Slicer rowRange (IPosition(1,start), IPosition(1,nrow));
+      ArrayColumn<T> inCol(table, from);
+      ArrayColumn<T> outCol(table, to);
+      outCol.putColumnRange (rowRange, inCol.getColumnRange(rowRange));
+    }
+
+    void copyChunk (DataType dtype, Table& table,
+                    const String& from, const String& to,
+                    rownr_t start, rownr_t nrow)
+    {
+      switch (dtype) {
+      case TpBool:
+        copyRange<Bool> (table, from, to, start, nrow);
+        break;
+      case TpUChar:
+        copyRange<uChar> (table, from, to, start, nrow);
+        break;
+      case TpShort:
+        copyRange<Short> (table, from, to, start, nrow);
+        break;
+      case TpUShort:
+        copyRange<uShort> (table, from, to, start, nrow);
+        break;
+      case TpInt:
+        copyRange<Int> (table, from, to, start, nrow);
+        break;
+      case TpUInt:
+        copyRange<uInt> (table, from, to, start, nrow);
+        break;
+      case TpInt64:
+        copyRange<Int64> (table, from, to, start, nrow);
+        break;
+      case TpFloat:
+        copyRange<Float> (table, from, to, start, nrow);
+        break;
+      case TpDouble:
+        copyRange<Double> (table, from, to, start, nrow);
+        break;
+      case TpComplex:
+        copyRange<Complex> (table, from, to, start, nrow);
+        break;
+      case TpDComplex:
+        copyRange<DComplex> (table, from, to, start, nrow);
+        break;
+      default:
+        throw TableError ("TSMLayoutOptimizer::retile: unsupported data type"
+                          " of column " + from);
+      }
+    }
+
+  } //# end anonymous namespace
+
+
+  TSMLayoutOptimizer::TSMLayoutOptimizer (const IPosition& cubeShape,
+                                          uInt pixelSize)
+    : itsCubeShape   (cubeShape),
+      itsPixelSize   (pixelSize),
+      itsCacheSize   (128*1024*1024),
+      itsSeekCost    (64*1024),
+      itsMaxAccesses (10000),
+      itsNAccess     (0)
+  {
+    if (cubeShape.empty()  ||  cubeShape.product() <= 0  ||  pixelSize == 0) {
+      throw AipsError ("TSMLayoutOptimizer: empty cube shape or pixel size");
+    }
+  }
+
+  TSMLayoutOptimizer::TSMLayoutOptimizer (const Table& table,
+                                          const String& columnName)
+    : itsPixelSize   (0),
+      itsCacheSize   (128*1024*1024),
+      itsSeekCost    (64*1024),
+      itsMaxAccesses (10000),
+      itsNAccess     (0)
+  {
+    if (table.nrow() == 0) {
+      throw TableError ("TSMLayoutOptimizer: table " + table.tableName() +
+                        " is empty");
+    }
+    ROTiledStManAccessor acc(table, columnName, True);
+    itsCubeShape = acc.hypercubeShape (0);
+    itsTileShape = acc.tileShape (0);
+    itsCubeShape[itsCubeShape.size() - 1] = table.nrow();
+    DataType dtype = table.tableDesc().columnDesc(columnName).dataType();
+    itsPixelSize = ValType::getTypeSize (dtype);
+  }
+
+  void TSMLayoutOptimizer::addAccess (const IPosition& blc,
+                                      const IPosition& trc)
+  {
+    if (blc.size() != itsCubeShape.size()  ||
+        trc.size() != itsCubeShape.size()) {
+      throw AipsError ("TSMLayoutOptimizer::addAccess: blc or trc has"
+                       " incorrect length");
+    }
+    itsNAccess++;
+    if (itsAccesses.size() < itsMaxAccesses) {
+      IPosition b(blc);
+      IPosition t(trc);
+      for (uInt i=0; i<b.size(); ++i) {
+        b[i] = std::max(ssize_t(0), std::min(b[i], itsCubeShape[i]-1));
+        t[i] = std::max(b[i], std::min(t[i], itsCubeShape[i]-1));
+      }
+      itsAccesses.push_back (std::make_pair (b, t));
+    }
+  }
+
+  void TSMLayoutOptimizer::addTraversal (const IPosition& cursorShape)
+  {
+    uInt ndim = itsCubeShape.size();
+    if (cursorShape.size() != ndim) {
+      throw AipsError ("TSMLayoutOptimizer::addTraversal: cursor shape has"
+                       " incorrect length");
+    }
+    IPosition blc(ndim, 0);
+    while (True) {
+      IPosition trc(blc + cursorShape - 1);
+      addAccess (blc, trc);
+      uInt i;
+      for (i=0; i<ndim; ++i) {
+        blc[i] += cursorShape[i];
+        if (blc[i] < itsCubeShape[i]) {
+          break;
+        }
+        blc[i] = 0;
+      }
+      if (i == ndim) {
+        break;
+      }
+    }
+  }
+
+  uInt TSMLayoutOptimizer::addTrace (const String& traceFile,
+                                     const String& columnName,
+                                     const String& tableName)
+  {
+    std::ifstream ifs(traceFile.c_str());
+    if (! ifs) {
+      throw AipsError ("TSMLayoutOptimizer: could not open trace file " +
+                       traceFile);
+    }
+    String absName;
+    if (! tableName.empty()) {
+      absName = Path(tableName).absoluteName();
+    }
+    uInt ndim = itsCubeShape.size();
+    Int64 nrow = itsCubeShape[ndim-1];
+    IPosition cellShape (itsCubeShape.getFirst (ndim-1));
+    // Keep track of the table ids used for the requested table.
+    std::set<String> tabIds;
+    std::vector<Int64> rows;
+    uInt nfound = 0;
+    std::string line;
+    while (std::getline (ifs, line)) {
+      if (line.empty()  ||  line[0] == '#') {
+        continue;
+      }
+      std::istringstream iss(line);
+      std::vector<String> words;
+      std::string word;
+      while (iss >> word) {
+        words.push_back (word);
+      }
+      if (words.size() < 4  ||  words[1].size() != 1) {
+        continue;
+      }
+      char oper = words[1][0];
+      const String& tabId = words[2];
+      if (oper == 'o'  ||  oper == 'n') {
+        if (absName.empty()  ||  Path(words[3]).absoluteName() == absName) {
+          tabIds.insert (tabId);
+        }
+        continue;
+      } else if (oper == 'c') {
+        if (! absName.empty()) {
+          tabIds.erase (tabId);
+        }
+        continue;
+      } else if (oper != 'r'  &&  oper != 'w') {
+        continue;
+      }
+      // Only array accesses of the column (which have a shape) are used.
+      if (words[3] != columnName  ||  words.size() < 6  ||
+          (!absName.empty()  &&  tabIds.find(tabId) == tabIds.end())) {
+        continue;
+      }
+      IPosition blc(ndim, 0);
+      IPosition trc(itsCubeShape - 1);
+      if (words.size() > 6) {
+        IPosition sblc, strc;
+        if (! parseSlice (words[6], sblc, strc)  ||  sblc.size() != ndim-1) {
+          continue;
+        }
+        for (uInt i=0; i<ndim-1; ++i) {
+          blc[i] = sblc[i];
+          trc[i] = strc[i];
+        }
+      } else {
+        for (uInt i=0; i<ndim-1; ++i) {
+          trc[i] = cellShape[i] - 1;
+        }
+      }
+      parseRows (words[4], nrow, rows);
+      for (uInt i=0; i+2<rows.size(); i+=3) {
+        if (rows[i+2] == 1) {
+          blc[ndim-1] = rows[i];
+          trc[ndim-1] = rows[i+1];
+          addAccess (blc, trc);
+        } else {
+          for (Int64 r=rows[i]; r<=rows[i+1]; r+=rows[i+2]) {
+            blc[ndim-1] = r;
+            trc[ndim-1] = r;
+            addAccess (blc, trc);
+          }
+        }
+      }
+      nfound++;
+    }
+    return nfound;
+  }
+
+  Double TSMLayoutOptimizer::cost (const IPosition& tileShape) const
+  {
+    uInt ndim = itsCubeShape.size();
+    if (tileShape.size() != ndim  ||  tileShape.product() <= 0) {
+      throw AipsError ("TSMLayoutOptimizer::cost: invalid tile shape");
+    }
+    if (itsAccesses.empty()) {
+      return 0;
+    }
+    uInt64 tileBytes = uInt64(tileShape.product()) * itsPixelSize;
+    uInt64 capacity = std::max (uInt64(1), itsCacheSize / tileBytes);
+    IPosition nrTiles ((itsCubeShape + tileShape - 1) / tileShape);
+    // Simulate an LRU cache of tile numbers.
+    std::list<Int64> lru;
+    std::unordered_map<Int64, std::list<Int64>::iterator> inCache;
+    uInt64 nmiss = 0;
+    for (const auto& acc : itsAccesses) {
+      IPosition stTile (acc.first / tileShape);
+      IPosition endTile (acc.second / tileShape);
+      IPosition ntile (endTile - stTile + 1);
+      uInt64 nt = ntile.product();
+      if (nt > capacity) {
+        // All tiles are read; the cache is filled with the last ones.
+        // Only their number matters for the next accesses, so the cache
+        // is cleared to keep it simple.
+        nmiss += nt;
+        lru.clear();
+        inCache.clear();
+        continue;
+      }
+      IPosition pos(stTile);
+      while (True) {
+        Int64 tileNr = 0;
+        for (Int i=ndim-1; i>=0; --i) {
+          tileNr = tileNr * nrTiles[i] + pos[i];
+        }
+        auto iter = inCache.find (tileNr);
+        if (iter == inCache.end()) {
+          nmiss++;
+          if (lru.size() >= capacity) {
+            inCache.erase (lru.back());
+            lru.pop_back();
+          }
+          lru.push_front (tileNr);
+          inCache[tileNr] = lru.begin();
+        } else {
+          lru.splice (lru.begin(), lru, iter->second);
+        }
+        uInt i;
+        for (i=0; i<ndim; ++i) {
+          if (++pos[i] <= endTile[i]) {
+            break;
+          }
+          pos[i] = stTile[i];
+        }
+        if (i == ndim) {
+          break;
+        }
+      }
+    }
+    return Double(nmiss) * (tileBytes + itsSeekCost) *
+           (Double(itsNAccess) / itsAccesses.size());
+  }
+
+  std::vector<IPosition> TSMLayoutOptimizer::candidates
+                                               (uInt64 tileBytes) const
+  {
+    uInt ndim = itsCubeShape.size();
+    uInt64 maxPixels = std::max (uInt64(1), tileBytes / itsPixelSize);
+    // Determine the possible lengths per axis.
+    std::vector<std::vector<ssize_t>> lengths(ndim);
+    for (uInt i=0; i<ndim; ++i) {
+      std::set<ssize_t> lens;
+      ssize_t len = itsCubeShape[i];
+      for (ssize_t k=1; k<=8; ++k) {
+        lens.insert ((len + k - 1) / k);
+      }
+      for (ssize_t p=1; p<len; p*=2) {
+        lens.insert (p);
+      }
+      for (ssize_t l : lens) {
+        if (uInt64(l) <= maxPixels) {
+          lengths[i].push_back (l);
+        }
+      }
+    }
+    // Form all combinations with a size between half and the full size.
+    std::vector<IPosition> result;
+    IPosition inx(ndim, 0);
+    IPosition shape(ndim);
+    while (True) {
+      uInt64 npix = 1;
+      for (uInt i=0; i<ndim; ++i) {
+        shape[i] = lengths[i][inx[i]];
+        npix *= shape[i];
+      }
+      if (npix <= maxPixels  &&  2*npix >= maxPixels) {
+        result.push_back (shape);
+      }
+      uInt i;
+      for (i=0; i<ndim; ++i) {
+        if (++inx[i] < ssize_t(lengths[i].size())) {
+          break;
+        }
+        inx[i] = 0;
+      }
+      if (i == ndim) {
+        break;
+      }
+    }
+    // If the cube is smaller than a tile, use the full cube.
+    if (result.empty()  &&  uInt64(itsCubeShape.product()) <= maxPixels) {
+      result.push_back (itsCubeShape);
+    }
+    return result;
+  }
+
+  IPosition TSMLayoutOptimizer::bestTileShape (uInt64 tileBytes) const
+  {
+    if (itsAccesses.empty()) {
+      throw AipsError ("TSMLayoutOptimizer::bestTileShape: no accesses given");
+    }
+    std::vector<IPosition> cands = candidates (tileBytes);
+    IPosition best;
+    Double bestCost = 0;
+    // Only change the current tile shape if another one is really better.
+    if (! itsTileShape.empty()) {
+      best = itsTileShape;
+      bestCost = cost (itsTileShape);
+    }
+    for (const IPosition& shape : cands) {
+      Double c = cost (shape);
+      if (best.empty()  ||  c < bestCost) {
+        best = shape;
+        bestCost = c;
+      }
+    }
+    if (best.empty()) {
+      throw AipsError ("TSMLayoutOptimizer::bestTileShape: no candidate"
+                       " tile shapes found");
+    }
+    return best;
+  }
+
+  String TSMLayoutOptimizer::retile (Table& table, const String& columnName,
+                                     const IPosition& tileShape,
+                                     uInt64 maxChunkBytes)
+  {
+    if (! table.isWritable()) {
+      throw TableError ("TSMLayoutOptimizer::retile: table " +
+                        table.tableName() + " is not writable");
+    }
+    // Check that the column is the only one in its tiled storage manager.
+    Record dminfo = table.dataManagerInfo();
+    Bool found = False;
+    for (uInt i=0; i<dminfo.nfields(); ++i) {
+      const Record& rec = dminfo.subRecord(i);
+      Vector<String> cols (rec.asArrayString ("COLUMNS"));
+      if (std::find (cols.begin(), cols.end(), columnName) != cols.end()) {
+        found = True;
+        String type = rec.asString ("TYPE");
+        if (! type.startsWith ("Tiled")) {
+          throw TableError ("TSMLayoutOptimizer::retile: column " +
+                            columnName + " is not stored with a tiled"
+                            " storage manager");
+        }
+        if (cols.size() != 1) {
+          throw TableError ("TSMLayoutOptimizer::retile: column " +
+                            columnName + " shares its data manager " +
+                            rec.asString("NAME") + " with other columns");
+        }
+      }
+    }
+    if (! found) {
+      throw TableError ("TSMLayoutOptimizer::retile: column " + columnName +
+                        " does not exist");
+    }
+    // Find unique names for the temporary column and the data manager.
+    String tmpName = columnName + "_RETILE";
+    for (uInt i=0; table.tableDesc().isColumn(tmpName); ++i) {
+      tmpName = columnName + "_RETILE" + String::toString(i);
+    }
+    String dmName = columnName + "_TSM";
+    for (uInt i=0; ; ++i) {
+      Bool used = False;
+      for (uInt j=0; j<dminfo.nfields(); ++j) {
+        if (dminfo.subRecord(j).asString("NAME") == dmName) {
+          used = True;
+          break;
+        }
+      }
+      if (! used) break;
+      dmName = columnName + "_TSM" + String::toString(i);
+    }
+    // Add the new column with the same description.
+    TableDesc td;
+    td.addColumn (table.tableDesc().columnDesc(columnName), tmpName);
+    ColumnDesc& cd = td.rwColumnDesc (tmpName);
+    cd.dataManagerType() = "TiledShapeStMan";
+    cd.dataManagerGroup() = dmName;
+    TiledShapeStMan tsm(dmName, tileShape);
+    table.addColumn (td, tsm);
+    // Copy the data. Fixed shape arrays are copied in chunks of rows
+    // aligned to the tiles; others per row.
+    const ColumnDesc& cdesc = table.tableDesc().columnDesc(columnName);
+    rownr_t nrow = table.nrow();
+    if (cdesc.isFixedShape()  &&  cdesc.shape().size() > 0) {
+      uInt64 cellBytes = cdesc.shape().product() *
+                         ValType::getTypeSize(cdesc.dataType());
+      rownr_t tileRows = std::max (ssize_t(1), tileShape.last());
+      rownr_t chunkRows = maxChunkBytes / std::max(cellBytes, uInt64(1));
+      chunkRows = std::max (tileRows, chunkRows / tileRows * tileRows);
+      for (rownr_t row=0; row<nrow; row+=chunkRows) {
+        copyChunk (cdesc.dataType(), table, columnName, tmpName,
+                   row, std::min(chunkRows, nrow-row));
+      }
+    } else {
+      TableColumn inCol(table, columnName);
+      TableColumn outCol(table, tmpName);
+      for (rownr_t row=0; row<nrow; ++row) {
+        if (inCol.isDefined (row)) {
+          outCol.put (row, inCol, row);
+        }
+      }
+    }
+    // Replace the old column by the new one.
+    table.removeColumn (columnName);
+    table.renameColumn (columnName, tmpName);
+    table.flush();
+    return dmName;
+  }
+
+
+} //# NAMESPACE CASACORE - END
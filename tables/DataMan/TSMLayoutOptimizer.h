@@ -0,0 +1,185 @@
+//# TSMLayoutOptimizer.h: Choose and apply a tile shape for a tiled column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TSMLAYOUTOPTIMIZER_H
+#define TABLES_TSMLAYOUTOPTIMIZER_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/BasicSL/String.h>
+#include <vector>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class Table;
+
+
+// <summary>
+// Choose and apply a tile shape for a tiled column.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tTSMLayoutOptimizer">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TiledStMan>TiledStMan</linkto>
+//   <li> <linkto class=TableTrace>TableTrace</linkto>
+// </prerequisite>
+
+// <synopsis>
+// The tile shape of a column in a tiled storage manager is chosen when
+// the column is created, usually for the access pattern expected at that
+// time. If the dominant access pattern changes (e.g. from time-major
+// imaging to channel-major calibration), the tiles can become a very bad
+// match resulting in many more tiles being read than needed.
+// <br>TSMLayoutOptimizer evaluates candidate tile shapes for a sample
+// of accesses of a hypercube and can rewrite a column with the best one.
+// <p>
+// The accesses are boxes in the hypercube (of which the last axis is the
+// row axis). They can be given explicitly, as a traversal of the cube
+// with a cursor shape, or be read from a file written by
+// <linkto class=TableTrace>TableTrace</linkto>. In the latter case the
+// row numbers are used as the positions on the row axis, which is true
+// for a single hypercube (e.g. TiledColumnStMan or a TiledShapeStMan
+// column with fixed shape).
+// <br>Only the first <src>maxAccesses</src> accesses are kept, but the
+// cost is scaled with the total number of accesses added.
+// <p>
+// The cost model follows the behaviour of the TSMCube cache. The tiles
+// touched by an access are accessed in the order TSMCube uses (first axis
+// varying fastest) and kept in an LRU cache of the given size. The cost of
+// a tile not in the cache is its size in bytes plus a fixed seek cost
+// (also expressed in bytes). The cost of a tile shape is the total cost of
+// all accesses.
+// <br>Candidate tile shapes have a tile size near a given number of bytes.
+// For each axis the lengths tried are the full axis length, its
+// fractions 1/2 to 1/8 (rounded up) and the powers of 2.
+// <p>
+// The static function <src>retile</src> rewrites a column with another tile
+// shape. It adds a temporary column bound to a new TiledShapeStMan, copies
+// the data in chunks of rows (so the table is never held in memory),
+// removes the old column, and renames the new one.
+// The program <src>retiletable</src> uses this class.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   Table tab("my.ms", Table::Update);
+//   TSMLayoutOptimizer opt(tab, "DATA");
+//   opt.addTrace ("trace.log", "DATA");
+//   IPosition tileShape = opt.bestTileShape (1024*1024);
+//   TSMLayoutOptimizer::retile (tab, "DATA", tileShape);
+// </srcblock>
+// </example>
+
+class TSMLayoutOptimizer
+{
+public:
+  // Construct for a hypercube with the given shape and pixel size (in bytes).
+  TSMLayoutOptimizer (const IPosition& cubeShape, uInt pixelSize);
+
+  // Construct for the hypercube of the given column in a tiled storage
+  // manager. If multiple hypercubes are used, the one containing row 0
+  // is taken, but the row axis gets the number of rows in the table.
+  TSMLayoutOptimizer (const Table& table, const String& columnName);
+
+  // Get the cube shape.
+  const IPosition& cubeShape() const
+    { return itsCubeShape; }
+
+  // Get the current tile shape (if constructed from a column).
+  const IPosition& currentTileShape() const
+    { return itsTileShape; }
+
+  // Set the size of the tile cache (in bytes) used in the cost model.
+  // The default is 128 MiB.
+  void setCacheSize (uInt64 nbytes)
+    { itsCacheSize = nbytes; }
+
+  // Set the cost (in bytes) of a seek, thus of reading a tile in addition
+  // to its size. The default is 64 KiB.
+  void setSeekCost (uInt64 nbytes)
+    { itsSeekCost = nbytes; }
+
+  // Set the maximum number of accesses kept. The default is 10000.
+  void setMaxAccesses (uInt n)
+    { itsMaxAccesses = n; }
+
+  // Add an access of the box blc-trc in the hypercube.
+  void addAccess (const IPosition& blc, const IPosition& trc);
+
+  // Add the accesses of a traversal of the entire hypercube with the given
+  // cursor shape (first axis varying fastest).
+  void addTraversal (const IPosition& cursorShape);
+
+  // Add the reads and writes of the column found in the TableTrace file.
+  // If a table name is given, only the accesses of that table are used.
+  // It returns the number of accesses found.
+  uInt addTrace (const String& traceFile, const String& columnName,
+                 const String& tableName=String());
+
+  // Get the total number of accesses added.
+  uInt64 naccess() const
+    { return itsNAccess; }
+
+  // Get the cost of the accesses for the given tile shape.
+  Double cost (const IPosition& tileShape) const;
+
+  // Get the candidate tile shapes with a size of about the given nr of bytes.
+  std::vector<IPosition> candidates (uInt64 tileBytes) const;
+
+  // Get the best candidate tile shape. The current tile shape (if known)
+  // is taken into account as well.
+  IPosition bestTileShape (uInt64 tileBytes) const;
+
+  // Rewrite the column in the table with the given tile shape.
+  // The column must be the only column in its tiled storage manager.
+  // The data are copied in chunks of at most <src>maxChunkBytes</src>.
+  // It returns the name of the new data manager.
+  static String retile (Table& table, const String& columnName,
+                        const IPosition& tileShape,
+                        uInt64 maxChunkBytes=64*1024*1024);
+
+private:
+  //# Data members.
+  IPosition itsCubeShape;
+  IPosition itsTileShape;
+  uInt      itsPixelSize;
+  uInt64    itsCacheSize;
+  uInt64    itsSeekCost;
+  uInt      itsMaxAccesses;
+  uInt64    itsNAccess;
+  std::vector<std::pair<IPosition,IPosition>> itsAccesses;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
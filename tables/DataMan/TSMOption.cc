@@ -46,6 +46,8 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
         itsOption = TSMOption::MMap;
       } else if (opt == "cache") {
         itsOption = TSMOption::Cache;
+      } else if (opt == "direct") {
+        itsOption = TSMOption::Direct;
         ///      } else if (opt == "buffer") {
         ///        itsOption = TSMOption::Buffer;
       } else if (opt == "default32") {
@@ -78,6 +78,14 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //  <li> <src>TSMOption::Buffer</src>
 //       Use buffered file IO without.
 //       The buffer size can be given as a constructor argument.
+//  <li> <src>TSMOption::Direct</src>
+//       Use unbuffered file IO with internal TSM caching like
+//       <src>TSMOption::Cache</src>, but read the data files using O_DIRECT
+//       to bypass the kernel's file cache. Consecutive tiles are read in
+//       large aligned blocks. It is meant for streaming through very large
+//       tables without evicting all other data from the kernel's cache.
+//       If the OS or file system does not support O_DIRECT, normal reads
+//       are done.
 //  <li> <src>TSMOption::Default</src>
 //       Use default. This is MMap for existing files on 64-bit systems,
 //       otherwise Buffer.
@@ -94,6 +102,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //    <li> <src>mmapold</src> (or <src>mapold</src>) means TSMMap for existing
 //         tables and TSMDefault for new tables.
 //    <li> <src>buffer</src> means TSMBuffer.
+//    <li> <src>direct</src> means TSMDirect.
 //    <li> <src>default</src> means TSMDefault.
 //   </ul>
 //       It defaults to value <src>default</src>.
@@ -125,7 +134,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
       // Use default.
       Default,
       // Use as defined in the aipsrc file.
-      Aipsrc
+      Aipsrc,
+      // Use unbuffered O_DIRECT file IO with internal TSM caching.
+      Direct
     };
 
     // Create an option object.
@@ -459,13 +459,16 @@ TSMCube* TiledShapeStMan::getHypercube (rownr_t rownr)
     // Test if the row number is in the most recently used interval.
     // See description in function updateRowMap (about line 340)
     // how intervals are defined.
-    if (lastHC_p < 0  ||  rownr > rowMap_p[lastHC_p]
-    ||  (lastHC_p > 0  &&  rownr <= rowMap_p[lastHC_p-1])) {
+    // Use a local copy, so other threads cannot change it underneath.
+    Int lastHC = lastHC_p;
+    if (lastHC < 0  ||  rownr > rowMap_p[lastHC]
+    ||  (lastHC > 0  &&  rownr <= rowMap_p[lastHC-1])) {
         Bool found;
-	lastHC_p = binarySearchBrackets (found, rowMap_p, rownr,
-					 nrUsedRowMap_p);
+	lastHC = binarySearchBrackets (found, rowMap_p, rownr,
+				       nrUsedRowMap_p);
+	lastHC_p = lastHC;
     }
-    return cubeSet_p[cubeMap_p[lastHC_p]];
+    return cubeSet_p[cubeMap_p[lastHC]];
 }
 
 TSMCube* TiledShapeStMan::getHypercube (rownr_t rownr, IPosition& position)
@@ -486,13 +489,16 @@ TSMCube* TiledShapeStMan::getHypercube (rownr_t rownr, IPosition& position)
     // Test if the row number is in the most recently used interval.
     // See description in function updateRowMap (about line 340)
     // how intervals are defined.
-    if (lastHC_p < 0  ||  rownr > rowMap_p[lastHC_p]
-    ||  (lastHC_p > 0  &&  rownr <= rowMap_p[lastHC_p-1])) {
+    // Use a local copy, so other threads cannot change it underneath.
+    Int lastHC = lastHC_p;
+    if (lastHC < 0  ||  rownr > rowMap_p[lastHC]
+    ||  (lastHC > 0  &&  rownr <= rowMap_p[lastHC-1])) {
         Bool found;
-	lastHC_p = binarySearchBrackets (found, rowMap_p, rownr,
-					 nrUsedRowMap_p);
+	lastHC = binarySearchBrackets (found, rowMap_p, rownr,
+				       nrUsedRowMap_p);
+	lastHC_p = lastHC;
     }
-    TSMCube* hypercube = cubeSet_p[cubeMap_p[lastHC_p]];
+    TSMCube* hypercube = cubeSet_p[cubeMap_p[lastHC]];
     const IPosition& shp = hypercube->cubeShape();
     if (position.nelements() != shp.nelements()) {
         position.resize (shp.nelements());
@@ -500,8 +506,8 @@ TSMCube* TiledShapeStMan::getHypercube (rownr_t rownr, IPosition& position)
     position = shp;
     // Add the starting position of the hypercube chunk the row is in.
     if (position.nelements() > 0) {
-        position(nrdim_p - 1) = posMap_p[lastHC_p] -
-	                        (rowMap_p[lastHC_p] - rownr);
+        position(nrdim_p - 1) = posMap_p[lastHC] -
+	                        (rowMap_p[lastHC] - rownr);
     }
     return hypercube;
 }
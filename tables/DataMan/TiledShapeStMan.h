@@ -32,6 +32,7 @@
 #include <casacore/tables/DataMan/TiledStMan.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <atomic>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -312,7 +313,8 @@ private:
     // The nr of elements used in the map blocks.
     uInt nrUsedRowMap_p;
     // The last hypercube found.
-    Int lastHC_p;
+    // It is atomic, because threads accessing different rows update it.
+    std::atomic<Int> lastHC_p;
 };
 
 
@@ -495,6 +495,22 @@ void TiledStMan::showCacheStatistics (ostream& os) const
     }
 }
 
+Vector<String> TiledStMan::snapshotFiles()
+{
+    Vector<String> names(fileSet_p.nelements());
+    uInt nr = 0;
+    for (uInt i=0; i<fileSet_p.nelements(); i++) {
+	if (fileSet_p[i] != 0  &&  !multiFile()) {
+	    BucketFile* file = fileSet_p[i]->bucketFile();
+	    if (file->isCached()) {
+		names[nr++] = file->name();
+	    }
+	}
+    }
+    names.resize (nr, True);
+    return names;
+}
+
 TSMCube* TiledStMan::singleHypercube()
 {
     if (cubeSet_p.nelements() != 1  ||  cubeSet_p[0] == 0) {
@@ -35,6 +35,7 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/OS/Conversion.h>
 #include <casacore/casa/BasicSL/String.h>
+#include <atomic>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -84,7 +85,30 @@ class Record;
 // data cells are consistent.
 // It also contains various data members and functions to make them
 // persistent by writing them into an AipsIO stream.
-// </synopsis> 
+// <p>
+// Each extensible hypercube has its own file and tile cache, while the
+// non-extensible hypercubes share the first file.
+// Therefore multiple threads in the same process can put data in
+// parallel into rows residing in <em>different extensible</em> hypercubes
+// (e.g. one hypercube per thread in a TiledDataStMan, or rows with
+// different shapes in a TiledShapeStMan) provided that:
+// <ul>
+//  <li> Each thread uses its own Table and ArrayColumn objects
+//       (copies of the same table object are fine).
+//  <li> The table is write-locked before the threads start
+//       (e.g. by PermanentLocking or UserLocking), so no thread needs
+//       to acquire or release a lock.
+//  <li> All rows, hypercubes and shapes are created beforehand by a
+//       single thread, because they change the shared bookkeeping.
+//  <li> The table does not use the MultiFile storage option, because
+//       the hypercubes then share the MultiFile.
+// </ul>
+// Threads can also put data into their own range of rows in the same
+// hypercube (e.g. in a TiledColumnStMan), but these puts are serialized
+// because the hypercube has a single tile cache.
+// Flushing the table has to be done after all threads have finished.
+// <br>Writing a table from multiple processes is not supported.
+// </synopsis>
 
 // <motivation>
 // This base class contains the common functionality of all
@@ -262,6 +286,10 @@ public:
     // Show the statistics of all caches used.
     void showCacheStatistics (ostream& os) const;
 
+    // Get the hypercube files, which can be snapshotted using copy-on-write
+    // if they are accessed unbuffered and no MultiFile is used.
+    virtual Vector<String> snapshotFiles();
+
     // Get the length of the data for the given number of pixels.
     // This can be used to calculate the length of a tile.
     uInt64 getLengthOffset (uInt64 nrPixels, Block<uInt>& dataOffset,
@@ -522,7 +550,8 @@ protected:
     // The fixed cell shape.
     IPosition fixedCellShape_p;
     // Has any data changed since the last flush?
-    Bool      dataChanged_p;
+    // It is atomic, because threads writing disjoint hypercubes set it.
+    std::atomic<Bool> dataChanged_p;
 };
 
 
@@ -29,16 +29,67 @@
 #include <casacore/tables/Tables/TableRecord.h>
 #include <casacore/tables/TaQL/TableParse.h>
 #include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/tables/TaQL/ExprNodeRep.h>
+#include <casacore/tables/TaQL/ExprNodeArray.h>
+#include <casacore/tables/Tables/ArrayColumnBase.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/DataMan/DataManError.h>
 #include <casacore/casa/Containers/Record.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/Arrays/Slice.h>
 #include <casacore/casa/Utilities/Copy.h>
+#include <casacore/casa/Utilities/ValType.h>
 #include <casacore/casa/Utilities/Assert.h>
+#include <algorithm>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
-  VirtualTaQLColumn::VirtualTaQLColumn (const String& expr, const String& style)
+//# The default number of rows evaluated at once.
+#define VTC_DEFAULT_CHUNKSIZE 1024
+//# The maximum number of array values evaluated at once.
+#define VTC_MAX_CHUNKVALUES 1048576
+
+namespace {
+  // Evaluate a scalar expression for the given rows.
+  // Arithmetic on integer and real values is done for all rows at once
+  // (see ExprMathNode); other expressions are evaluated row by row by the
+  // TableExprNodeRep base implementation.
+  Array<Int64> evalInt (const TENShPtr& rep, const Vector<rownr_t>& rows)
+  {
+    if (rep->dataType() == TableExprNodeRep::NTInt) {
+      return rep->getColumnInt64 (rows);
+    }
+    return rep->TableExprNodeRep::getColumnInt64 (rows);
+  }
+  Array<Double> evalDouble (const TENShPtr& rep, const Vector<rownr_t>& rows)
+  {
+    if (rep->dataType() == TableExprNodeRep::NTDouble) {
+      return rep->getColumnDouble (rows);
+    } else if (rep->dataType() == TableExprNodeRep::NTInt) {
+      Array<Double> out (IPosition(1, rows.size()));
+      convertArray (out, rep->getColumnInt64 (rows));
+      return out;
+    }
+    return rep->TableExprNodeRep::getColumnDouble (rows);
+  }
+  Array<DComplex> evalDComplex (const TENShPtr& rep,
+                                const Vector<rownr_t>& rows)
+  {
+    if (rep->dataType() == TableExprNodeRep::NTComplex) {
+      return rep->getColumnDComplex (rows);
+    } else if (rep->dataType() == TableExprNodeRep::NTDouble
+           ||  rep->dataType() == TableExprNodeRep::NTInt) {
+      Array<DComplex> out (IPosition(1, rows.size()));
+      convertArray (out, evalDouble (rep, rows));
+      return out;
+    }
+    return rep->TableExprNodeRep::getColumnDComplex (rows);
+  }
+}
+
+VirtualTaQLColumn::VirtualTaQLColumn (const String& expr, const String& style)
 : itsDataType     (TpOther),
   itsIsArray      (False),
   itsIsConst      (False),
@@ -46,8 +97,17 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   itsExpr         (expr),
   itsStyle        (style),
   itsNode         (0),
+  itsMaxLen       (0),
   itsCurArray     (0),
-  itsCurRow       (-1)
+  itsCurRow       (-1),
+  itsChunkSize    (VTC_DEFAULT_CHUNKSIZE),
+  itsUseChunk     (False),
+  itsChunk        (0),
+  itsChunkData    (0),
+  itsChunkElemSize(0),
+  itsChunkStart   (0),
+  itsChunkNrow    (0),
+  itsReadAhead    (1)
 {}
 
 VirtualTaQLColumn::VirtualTaQLColumn (const Record& spec)
@@ -56,8 +116,17 @@ VirtualTaQLColumn::VirtualTaQLColumn (const Record& spec)
   itsIsConst      (False),
   itsTempWritable (False),
   itsNode         (0),
+  itsMaxLen       (0),
   itsCurArray     (0),
-  itsCurRow       (-1)
+  itsCurRow       (-1),
+  itsChunkSize    (VTC_DEFAULT_CHUNKSIZE),
+  itsUseChunk     (False),
+  itsChunk        (0),
+  itsChunkData    (0),
+  itsChunkElemSize(0),
+  itsChunkStart   (0),
+  itsChunkNrow    (0),
+  itsReadAhead    (1)
 {
   if (spec.isDefined ("TAQLCALCEXPR")) {
     itsExpr = spec.asString ("TAQLCALCEXPR");
@@ -65,63 +134,60 @@ VirtualTaQLColumn::VirtualTaQLColumn (const Record& spec)
   if (spec.isDefined ("TAQLSTYLE")) {
     itsStyle = spec.asString ("TAQLSTYLE");
   }
+  if (spec.isDefined ("CHUNKSIZE")) {
+    itsChunkSize = spec.asInt ("CHUNKSIZE");
+  }
 }
 
 VirtualTaQLColumn::~VirtualTaQLColumn()
 {
+  delete itsChunk;
   delete itsCurArray;
   delete itsNode;
 }
 
-void VirtualTaQLColumn::makeCurArray()
+ArrayBase* VirtualTaQLColumn::makeArray() const
 {
-  delete itsCurArray;
-  itsCurArray = 0;
   switch (itsDataType) {
   case TpBool:
-    itsCurArray = new Array<Bool>();
-    break;
+    return new Array<Bool>();
   case TpUChar:
-    itsCurArray = new Array<uChar>();
-    break;
+    return new Array<uChar>();
   case TpShort:
-    itsCurArray = new Array<Short>();
-    break;
+    return new Array<Short>();
   case TpUShort:
-    itsCurArray = new Array<uShort>();
-    break;
+    return new Array<uShort>();
   case TpInt:
-    itsCurArray = new Array<Int>();
-    break;
+    return new Array<Int>();
   case TpUInt:
-    itsCurArray = new Array<uInt>();
-    break;
+    return new Array<uInt>();
   case TpInt64:
-    itsCurArray = new Array<Int64>();
-    break;
+    return new Array<Int64>();
   case TpFloat:
-    itsCurArray = new Array<Float>();
-    break;
+    return new Array<Float>();
   case TpDouble:
-    itsCurArray = new Array<Double>();
-    break;
+    return new Array<Double>();
   case TpComplex:
-    itsCurArray = new Array<Complex>();
-    break;
+    return new Array<Complex>();
   case TpDComplex:
-    itsCurArray = new Array<DComplex>();
-    break;
+    return new Array<DComplex>();
   case TpString:
-    itsCurArray = new Array<String>();
-    break;
+    return new Array<String>();
   default:
-    throw DataManError ("VirtualTaQLColumn::makeCurArray - unknown data type");
+    throw DataManError ("VirtualTaQLColumn::makeArray - unknown data type");
   }
 }
 
+void VirtualTaQLColumn::makeCurArray()
+{
+  delete itsCurArray;
+  itsCurArray = makeArray();
+}
+
 DataManager* VirtualTaQLColumn::clone() const
 {
-  DataManager* dmPtr = new VirtualTaQLColumn (itsExpr, itsStyle);
+  VirtualTaQLColumn* dmPtr = new VirtualTaQLColumn (itsExpr, itsStyle);
+  dmPtr->itsChunkSize = itsChunkSize;
   return dmPtr;
 }
 
@@ -215,6 +281,39 @@ void VirtualTaQLColumn::prepare()
       fillColumnCache();
     }
   }
+  initChunk();
+}
+
+rownr_t VirtualTaQLColumn::resync64 (rownr_t nrrow)
+{
+  invalidateChunk();
+  return nrrow;
+}
+
+void VirtualTaQLColumn::reopenRW()
+{
+  invalidateChunk();
+  itsUseChunk = False;
+}
+
+void VirtualTaQLColumn::initChunk()
+{
+  invalidateChunk();
+  itsUseChunk = (itsNode != 0  &&  !itsIsConst  &&  !itsIsArray  &&
+                 itsChunkSize > 0  &&  !table().isWritable());
+  if (itsUseChunk  &&  itsChunk == 0) {
+    itsChunk = makeArray();
+    itsChunkElemSize = ValType::getTypeSize (DataType(itsDataType));
+  }
+}
+
+void VirtualTaQLColumn::invalidateChunk()
+{
+  itsChunkNrow = 0;
+  // Do not clear the column cache of a constant.
+  if (itsUseChunk) {
+    columnCache().invalidate();
+  }
 }
 
 DataManager* VirtualTaQLColumn::makeObject (const String&,
@@ -242,9 +341,26 @@ Record VirtualTaQLColumn::dataManagerSpec() const
 {
   Record spec;
   spec.define ("TAQLCALCEXPR", itsExpr);
+  spec.define ("CHUNKSIZE", Int(itsChunkSize));
   return spec;
 }
 
+Record VirtualTaQLColumn::getProperties() const
+{
+  Record rec;
+  rec.define ("ChunkSize", Int(itsChunkSize));
+  return rec;
+}
+
+void VirtualTaQLColumn::setProperties (const Record& rec)
+{
+  if (rec.isDefined("ChunkSize")) {
+    Int chunkSize = rec.asInt ("ChunkSize");
+    itsChunkSize = std::max (chunkSize, 0);
+    initChunk();
+  }
+}
+
 void VirtualTaQLColumn::setShapeColumn (const IPosition& aShape)
 {
   itsShape = aShape;
@@ -298,50 +414,99 @@ Bool VirtualTaQLColumn::isShapeDefined (rownr_t)
 
 void VirtualTaQLColumn::getBool (rownr_t rownr, Bool* dataPtr)
 {
-  *dataPtr = itsNode->getBool (rownr);
+  if (itsUseChunk) {
+    *dataPtr = *static_cast<const Bool*>(getChunkValue (rownr));
+  } else {
+    *dataPtr = itsNode->getBool (rownr);
+  }
 }
 void VirtualTaQLColumn::getuChar (rownr_t rownr, uChar* dataPtr)
 {
-  *dataPtr = uChar(itsNode->getInt (rownr));
+  if (itsUseChunk) {
+    *dataPtr = *static_cast<const uChar*>(getChunkValue (rownr));
+  } else {
+    *dataPtr = uChar(itsNode->getInt (rownr));
+  }
 }
 void VirtualTaQLColumn::getShort (rownr_t rownr, Short* dataPtr)
 {
-  *dataPtr = Short(itsNode->getInt (rownr));
+  if (itsUseChunk) {
+    *dataPtr = *static_cast<const Short*>(getChunkValue (rownr));
+  } else {
+    *dataPtr = Short(itsNode->getInt (rownr));
+  }
 }
 void VirtualTaQLColumn::getuShort (rownr_t rownr, uShort* dataPtr)
 {
-  *dataPtr = uShort(itsNode->getInt (rownr));
+  if (itsUseChunk) {
+    *dataPtr = *static_cast<const uShort*>(getChunkValue (rownr));
+  } else {
+    *dataPtr = uShort(itsNode->getInt (rownr));
+  }
 }
 void VirtualTaQLColumn::getInt (rownr_t rownr, Int* dataPtr)
 {
-  *dataPtr = Int(itsNode->getInt (rownr));
+  if (itsUseChunk) {
+    *dataPtr = *static_cast<const Int*>(getChunkValue (rownr));
+  } else {
+    *dataPtr = Int(itsNode->getInt (rownr));
+  }
 }
 void VirtualTaQLColumn::getuInt (rownr_t rownr, uInt* dataPtr)
 {
-  *dataPtr = uInt(itsNode->getInt (rownr));
+  if (itsUseChunk) {
+    *dataPtr = *static_cast<const uInt*>(getChunkValue (rownr));
+  } else {
+    *dataPtr = uInt(itsNode->getInt (rownr));
+  }
 }
 void VirtualTaQLColumn::getInt64 (rownr_t rownr, Int64* dataPtr)
 {
-  *dataPtr = itsNode->getInt (rownr);
+  if (itsUseChunk) {
+    *dataPtr = *static_cast<const Int64*>(getChunkValue (rownr));
+  } else {
+    *dataPtr = itsNode->getInt (rownr);
+  }
 }
 void VirtualTaQLColumn::getfloat (rownr_t rownr, float* dataPtr)
 {
-  *dataPtr = Float(itsNode->getDouble (rownr));
+  if (itsUseChunk) {
+    *dataPtr = *static_cast<const float*>(getChunkValue (rownr));
+  } else {
+    *dataPtr = Float(itsNode->getDouble (rownr));
+  }
 }
 void VirtualTaQLColumn::getdouble (rownr_t rownr, double* dataPtr)
 {
-  *dataPtr = itsNode->getDouble (rownr);
+  if (itsUseChunk) {
+    *dataPtr = *static_cast<const double*>(getChunkValue (rownr));
+  } else {
+    *dataPtr = itsNode->getDouble (rownr);
+  }
 }
 void VirtualTaQLColumn::getComplex (rownr_t rownr, Complex* dataPtr)
 {
-  *dataPtr = Complex(itsNode->getDComplex (rownr));
+  if (itsUseChunk) {
+    *dataPtr = *static_cast<const Complex*>(getChunkValue (rownr));
+  } else {
+    *dataPtr = Complex(itsNode->getDComplex (rownr));
+  }
 }
 void VirtualTaQLColumn::getDComplex (rownr_t rownr, DComplex* dataPtr)
 {
-  *dataPtr = itsNode->getDComplex (rownr);
+  if (itsUseChunk) {
+    *dataPtr = *static_cast<const DComplex*>(getChunkValue (rownr));
+  } else {
+    *dataPtr = itsNode->getDComplex (rownr);
+  }
 }
 void VirtualTaQLColumn::getString (rownr_t rownr, String* dataPtr)
 {
+  if (itsUseChunk) {
+    // The chunk contains the truncated strings.
+    *dataPtr = *static_cast<const String*>(getChunkValue (rownr));
+    return;
+  }
   *dataPtr = itsNode->getString (rownr);
   if (itsMaxLen > 0  &&  dataPtr->size() > itsMaxLen) {
     *dataPtr = dataPtr->substr (0, itsMaxLen);
@@ -464,13 +629,163 @@ void VirtualTaQLColumn::getResult (rownr_t rownr)
   }
 }
 
+void VirtualTaQLColumn::getResults (const Vector<rownr_t>& rownrs,
+                                    ArrayBase& arr)
+{
+  RowNumbers rows(rownrs);
+  if (itsNode->getColumnDataType() == itsDataType) {
+    // The expression has the column's data type, or it is a single column
+    // with that type which is read by a single getColumnCells.
+    switch (itsDataType) {
+    case TpBool:
+      arr.assignBase (itsNode->getColumnBool (rows), False);
+      break;
+    case TpUChar:
+      arr.assignBase (itsNode->getColumnuChar (rows), False);
+      break;
+    case TpShort:
+      arr.assignBase (itsNode->getColumnShort (rows), False);
+      break;
+    case TpUShort:
+      arr.assignBase (itsNode->getColumnuShort (rows), False);
+      break;
+    case TpInt:
+      arr.assignBase (itsNode->getColumnInt (rows), False);
+      break;
+    case TpUInt:
+      arr.assignBase (itsNode->getColumnuInt (rows), False);
+      break;
+    case TpInt64:
+      arr.assignBase (itsNode->getColumnInt64 (rows), False);
+      break;
+    case TpFloat:
+      arr.assignBase (itsNode->getColumnFloat (rows), False);
+      break;
+    case TpDouble:
+      arr.assignBase (itsNode->getColumnDouble (rows), False);
+      break;
+    case TpComplex:
+      arr.assignBase (itsNode->getColumnComplex (rows), False);
+      break;
+    case TpDComplex:
+      arr.assignBase (itsNode->getColumnDComplex (rows), False);
+      break;
+    case TpString:
+      arr.assignBase (itsNode->getColumnString (rows), False);
+      break;
+    default:
+      throw DataManInvDT(itsColumnName);
+    }
+  } else {
+    // Evaluate the expression in its own data type and convert the
+    // results to the column's type.
+    const TENShPtr& rep = itsNode->getRep();
+    switch (itsDataType) {
+    case TpBool:
+      arr.assignBase (rep->TableExprNodeRep::getColumnBool (rows), False);
+      break;
+    case TpUChar:
+      convertArray (static_cast<Array<uChar>&>(arr), evalInt (rep, rows));
+      break;
+    case TpShort:
+      convertArray (static_cast<Array<Short>&>(arr), evalInt (rep, rows));
+      break;
+    case TpUShort:
+      convertArray (static_cast<Array<uShort>&>(arr), evalInt (rep, rows));
+      break;
+    case TpInt:
+      convertArray (static_cast<Array<Int>&>(arr), evalInt (rep, rows));
+      break;
+    case TpUInt:
+      convertArray (static_cast<Array<uInt>&>(arr), evalInt (rep, rows));
+      break;
+    case TpInt64:
+      arr.assignBase (evalInt (rep, rows), False);
+      break;
+    case TpFloat:
+      convertArray (static_cast<Array<Float>&>(arr), evalDouble (rep, rows));
+      break;
+    case TpDouble:
+      arr.assignBase (evalDouble (rep, rows), False);
+      break;
+    case TpComplex:
+      convertArray (static_cast<Array<Complex>&>(arr),
+                    evalDComplex (rep, rows));
+      break;
+    case TpDComplex:
+      arr.assignBase (evalDComplex (rep, rows), False);
+      break;
+    case TpString:
+      arr.assignBase (rep->TableExprNodeRep::getColumnString (rows), False);
+      break;
+    default:
+      throw DataManInvDT(itsColumnName);
+    }
+  }
+  if (itsDataType == TpString  &&  itsMaxLen > 0) {
+    Array<String>& out = static_cast<Array<String>&>(arr);
+    for (Array<String>::iterator iter=out.begin(); iter!=out.end(); ++iter) {
+      if (iter->size() > itsMaxLen) {
+        *iter = iter->substr (0, itsMaxLen);
+      }
+    }
+  }
+}
+
+const void* VirtualTaQLColumn::getChunkValue (rownr_t rownr)
+{
+  // Evaluate the chunk starting at this row if the row is not in the
+  // cached chunk or if the column cache has been invalidated (which is
+  // done when the table lock is released).
+  if (rownr < itsChunkStart  ||  rownr >= itsChunkStart + itsChunkNrow
+  ||  columnCache().dataPtr() != itsChunkData) {
+    // Only read ahead for sequential access, i.e. if the row follows the
+    // previous chunk. The chunk then doubles until the maximum chunk size.
+    // Otherwise only the requested row is evaluated.
+    if (rownr == itsChunkStart + itsChunkNrow) {
+      itsReadAhead = std::min (2*itsReadAhead, itsChunkSize);
+    } else {
+      itsReadAhead = 1;
+    }
+    itsChunkStart = rownr;
+    itsChunkNrow  = std::min (rownr_t(itsReadAhead), table().nrow() - rownr);
+    Vector<rownr_t> rows(itsChunkNrow);
+    indgen (rows, rownr);
+    itsChunk->resize (IPosition(1, itsChunkNrow));
+    getResults (rows, *itsChunk);
+    Bool deleteIt;
+    itsChunkData = static_cast<const char*>
+      (static_cast<const ArrayBase*>(itsChunk)->getVStorage (deleteIt));
+    // Let ScalarColumn::get use the values directly.
+    columnCache().setIncrement (1);
+    columnCache().set (itsChunkStart, itsChunkStart + itsChunkNrow - 1,
+                       itsChunkData);
+  }
+  return itsChunkData + (rownr - itsChunkStart) * itsChunkElemSize;
+}
+
 void VirtualTaQLColumn::getScalarColumnV (ArrayBase& arr)
 {
   if (itsIsConst) {
     // Constant value, so fill the array with the same value.
     fillArray (arr);
   } else {
-    getScalarColumnBase (arr);
+    // Evaluate the expression in chunks of rows.
+    rownr_t nrow  = arr.size();
+    rownr_t chunk = (itsChunkSize > 0  ?  itsChunkSize : VTC_DEFAULT_CHUNKSIZE);
+    Vector<rownr_t> rows;
+    for (rownr_t st=0; st<nrow; st+=chunk) {
+      rownr_t nr = std::min (chunk, nrow-st);
+      rows.resize (nr);
+      indgen (rows, st);
+      if (nr == nrow) {
+        getResults (rows, arr);
+      } else {
+        std::unique_ptr<ArrayBase> part =
+          arr.getSection (Slicer(IPosition(1,st), IPosition(1,nr)));
+        getResults (rows, *part);
+      }
+    }
   }
 }
 void VirtualTaQLColumn::getScalarColumnCellsV (const RefRows& rownrs,
@@ -480,9 +795,184 @@ void VirtualTaQLColumn::getScalarColumnCellsV (const RefRows& rownrs,
     // Constant value, so fill the array with the same value.
     fillArray (arr);
   } else {
-    getScalarColumnCellsBase (rownrs, arr);
+    // Evaluate the expression in chunks of rows.
+    Vector<rownr_t> allRows (rownrs.convert());
+    rownr_t nrow  = allRows.size();
+    rownr_t chunk = (itsChunkSize > 0  ?  itsChunkSize : VTC_DEFAULT_CHUNKSIZE);
+    for (rownr_t st=0; st<nrow; st+=chunk) {
+      rownr_t nr = std::min (chunk, nrow-st);
+      if (nr == nrow) {
+        getResults (allRows, arr);
+      } else {
+        std::unique_ptr<ArrayBase> part =
+          arr.getSection (Slicer(IPosition(1,st), IPosition(1,nr)));
+        getResults (allRows(Slice(st,nr)), *part);
+      }
+    }
+  }
+}
+const TableColumn* VirtualTaQLColumn::arrayColumn() const
+{
+  if (itsNode->getColumnDataType() == itsDataType) {
+    const TableExprNodeArrayColumn* colNode =
+      dynamic_cast<const TableExprNodeArrayColumn*>(itsNode->getRep().get());
+    if (colNode) {
+      return &(colNode->getColumn());
+    }
+  }
+  return 0;
+}
+
+Bool VirtualTaQLColumn::useArrayChunks() const
+{
+  if (itsIsConst) {
+    return False;
+  }
+  TableExprNodeRep::NodeDataType dt = itsNode->getRep()->dataType();
+  switch (itsDataType) {
+  case TpUChar:
+  case TpShort:
+  case TpUShort:
+  case TpInt:
+  case TpUInt:
+  case TpInt64:
+    return dt == TableExprNodeRep::NTInt;
+  case TpFloat:
+  case TpDouble:
+    return (dt == TableExprNodeRep::NTInt  ||
+            dt == TableExprNodeRep::NTDouble);
+  default:
+    break;
+  }
+  return False;
+}
+
+rownr_t VirtualTaQLColumn::arrayChunkSize (const IPosition& cellShape) const
+{
+  rownr_t chunk = (itsChunkSize > 0  ?  itsChunkSize : VTC_DEFAULT_CHUNKSIZE);
+  rownr_t nrval = std::max (cellShape.product(), Int64(1));
+  return std::max (std::min (chunk, VTC_MAX_CHUNKVALUES / nrval), rownr_t(1));
+}
+
+void VirtualTaQLColumn::getArrayResults (const Vector<rownr_t>& rownrs,
+                                         ArrayBase& arr)
+{
+  const TENShPtr& rep = itsNode->getRep();
+  if (rep->dataType() == TableExprNodeRep::NTInt) {
+    Array<Int64> res = rep->getArrayColumnInt (rownrs);
+    if (! res.shape().isEqual (arr.shape())) {
+      throw DataManError ("VirtualTaQLColumn::getArrayResults - shape of "
+                          "result mismatches shape of column " + columnName());
+    }
+    switch (itsDataType) {
+    case TpUChar:
+      convertArray (static_cast<Array<uChar>&>(arr), res);
+      break;
+    case TpShort:
+      convertArray (static_cast<Array<Short>&>(arr), res);
+      break;
+    case TpUShort:
+      convertArray (static_cast<Array<uShort>&>(arr), res);
+      break;
+    case TpInt:
+      convertArray (static_cast<Array<Int>&>(arr), res);
+      break;
+    case TpUInt:
+      convertArray (static_cast<Array<uInt>&>(arr), res);
+      break;
+    case TpInt64:
+      arr.assignBase (res, False);
+      break;
+    case TpFloat:
+      convertArray (static_cast<Array<Float>&>(arr), res);
+      break;
+    case TpDouble:
+      convertArray (static_cast<Array<Double>&>(arr), res);
+      break;
+    default:
+      throw DataManInvDT(itsColumnName);
+    }
+  } else {
+    Array<Double> res = rep->getArrayColumnDouble (rownrs);
+    if (! res.shape().isEqual (arr.shape())) {
+      throw DataManError ("VirtualTaQLColumn::getArrayResults - shape of "
+                          "result mismatches shape of column " + columnName());
+    }
+    switch (itsDataType) {
+    case TpFloat:
+      convertArray (static_cast<Array<Float>&>(arr), res);
+      break;
+    case TpDouble:
+      arr.assignBase (res, False);
+      break;
+    default:
+      throw DataManInvDT(itsColumnName);
+    }
   }
 }
+
+void VirtualTaQLColumn::getArrayColumnV (ArrayBase& arr)
+{
+  const TableColumn* col = (itsIsConst  ?  0 : arrayColumn());
+  if (col) {
+    ArrayColumnBase(*col).acbGetColumn (arr, False);
+  } else if (useArrayChunks()) {
+    // Evaluate the expression in chunks of rows.
+    uInt lastAxis = arr.ndim() - 1;
+    rownr_t nrow  = arr.shape()[lastAxis];
+    rownr_t chunk = arrayChunkSize (arr.shape().getFirst (lastAxis));
+    IPosition start(arr.ndim(), 0);
+    IPosition length(arr.shape());
+    Vector<rownr_t> rows;
+    for (rownr_t st=0; st<nrow; st+=chunk) {
+      rownr_t nr = std::min (chunk, nrow-st);
+      rows.resize (nr);
+      indgen (rows, st);
+      if (nr == nrow) {
+        getArrayResults (rows, arr);
+      } else {
+        start[lastAxis]  = st;
+        length[lastAxis] = nr;
+        std::unique_ptr<ArrayBase> part =
+          arr.getSection (Slicer(start, length));
+        getArrayResults (rows, *part);
+      }
+    }
+  } else {
+    getArrayColumnBase (arr);
+  }
+}
+void VirtualTaQLColumn::getArrayColumnCellsV (const RefRows& rownrs,
+                                              ArrayBase& arr)
+{
+  const TableColumn* col = (itsIsConst  ?  0 : arrayColumn());
+  if (col) {
+    ArrayColumnBase(*col).acbGetColumnCells (rownrs, arr, False);
+  } else if (useArrayChunks()) {
+    // Evaluate the expression in chunks of rows.
+    Vector<rownr_t> allRows (rownrs.convert());
+    uInt lastAxis = arr.ndim() - 1;
+    rownr_t nrow  = allRows.size();
+    rownr_t chunk = arrayChunkSize (arr.shape().getFirst (lastAxis));
+    IPosition start(arr.ndim(), 0);
+    IPosition length(arr.shape());
+    for (rownr_t st=0; st<nrow; st+=chunk) {
+      rownr_t nr = std::min (chunk, nrow-st);
+      if (nr == nrow) {
+        getArrayResults (allRows, arr);
+      } else {
+        start[lastAxis]  = st;
+        length[lastAxis] = nr;
+        std::unique_ptr<ArrayBase> part =
+          arr.getSection (Slicer(start, length));
+        getArrayResults (allRows(Slice(st,nr)), *part);
+      }
+    }
+  } else {
+    getArrayColumnCellsBase (rownrs, arr);
+  }
+}
+
 void VirtualTaQLColumn::fillColumnCache()
 {
   columnCache().setIncrement (0);
@@ -31,10 +31,12 @@
 #include <casacore/tables/DataMan/VirtColEng.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/casa/Arrays/IPosition.h>
+#include <casacore/casa/Arrays/ArrayFwd.h>
 
 namespace casacore {
 //# Forward Declarations
 class TableExprNode;
+class TableColumn;
 
 
 // <category lib=aips module="Tables" sect="Virtual Columns">
@@ -60,6 +62,30 @@ class TableExprNode;
 // Constant expressions are precalculated and cached making the retrieval of
 // e.g. the full column much faster (factor 4).
 // <br>
+// Getting a scalar column or a subset of its cells evaluates the expression
+// in chunks of rows. The arithmetic operators +, -, * and / on integer and
+// real values are evaluated for an entire chunk at once, where a column used
+// in them is read with a single getColumnCells. Other operators and functions
+// are still evaluated row by row within the chunk.
+// Getting an array column or a subset of its cells reads the data at once
+// if the expression is a single array column of the same data type.
+// Other integer and real array expressions are evaluated in chunks of rows
+// (at most 1048576 values per chunk). Array columns used in them are read
+// per chunk and the array operators +, -, * and / are applied to the entire
+// chunk. Other array expressions are evaluated row by row.
+// If the table is not writable, a get of a single scalar also evaluates
+// the expression for a chunk of rows starting at that row and keeps the
+// results in the column cache. The chunk starts with a single row and
+// doubles each time the next row after the chunk is asked for, so random
+// access does not evaluate rows that are not needed, while consecutive
+// gets of a derived column cost about the same as gets of a stored column.
+// The cache is not used for a writable table, because the engine is not
+// notified when the columns used in the expression are changed.
+// The number of rows in a chunk (default 1024) can be given in the
+// specification record (field CHUNKSIZE) or be changed using the
+// property ChunkSize (see <linkto class=RODataManAccessor>
+// RODataManAccessor</linkto>). A value 0 disables the caching.
+// <br>
 // A possible use for a virtual TaQL column is a column in a MeasurementSet
 // containing a constant value. It could also be used for on-the-fly calculation
 // of J2000 UVW-values or HADEC using an expression such as "derivedmscal.newuvw()"
@@ -117,6 +143,14 @@ public:
   // Get the data manager specification.
   virtual Record dataManagerSpec() const;
 
+  // Get data manager properties that can be modified.
+  // It is only ChunkSize (the number of rows evaluated at once).
+  virtual Record getProperties() const;
+
+  // Modify data manager properties.
+  // Only ChunkSize can be used. It invalidates the cached chunk.
+  virtual void setProperties (const Record& spec);
+
   // Return the type name of the engine.
   // (i.e. its class name VirtualTaQLColumn).
   virtual String dataManagerType() const;
@@ -177,6 +211,12 @@ private:
   // Prepare compiles the expression.
   virtual void prepare();
 
+  // Invalidate the cached chunk, because the table might have changed.
+  virtual rownr_t resync64 (rownr_t nrrow);
+
+  // The table becomes writable, so stop caching chunks.
+  virtual void reopenRW();
+
   // Get the scalar value in the given row.
   // <group>
   virtual void getBool     (rownr_t rownr, Bool* dataPtr);
@@ -201,17 +241,56 @@ private:
   // Get the array result into itsCurArray.
   void getResult (rownr_t rownr);
 
+  // Make an empty array of the column's data type.
+  ArrayBase* makeArray() const;
+
   // Make the result cache.
   void makeCurArray();
 
+  // Evaluate the scalar expression for the given rows and store the
+  // results in <src>arr</src> (a vector of the column's data type).
+  void getResults (const Vector<rownr_t>& rownrs, ArrayBase& arr);
+
+  // Can a (non-constant) array expression be evaluated in chunks of rows?
+  // It can for integer and real values.
+  Bool useArrayChunks() const;
+
+  // Get the number of rows in a chunk of arrays with the given shape.
+  rownr_t arrayChunkSize (const IPosition& cellShape) const;
+
+  // Evaluate the array expression for the given rows and store the
+  // results in <src>arr</src> (the arrays of the rows with the row
+  // as the last axis).
+  void getArrayResults (const Vector<rownr_t>& rownrs, ArrayBase& arr);
+
+  // Get a pointer to the value of the given row in the cached chunk.
+  // If the row is not in the chunk, the expression is evaluated for a
+  // chunk starting at the row. The chunk is set as the column cache.
+  // The chunk grows (up to itsChunkSize rows) as long as the rows are
+  // accessed sequentially; for random access it is a single row.
+  const void* getChunkValue (rownr_t rownr);
+
+  // Determine if single gets use the chunk cache and create it if so.
+  void initChunk();
+
+  // Invalidate the cached chunk.
+  void invalidateChunk();
+
   // Get functions implemented by means of their DataManagerColumn::getXXBase
   // counterparts, but optimized for constant expressions.
   // <group>
   virtual void getScalarColumnV (ArrayBase& arr);
   virtual void getScalarColumnCellsV (const RefRows& rownrs,
                                       ArrayBase& arr);
+  virtual void getArrayColumnV (ArrayBase& arr);
+  virtual void getArrayColumnCellsV (const RefRows& rownrs,
+                                     ArrayBase& arr);
   // </group>
 
+  // Get the array column if the expression is just that column
+  // with the same data type (0 otherwise).
+  const TableColumn* arrayColumn() const;
+
   // Fill the ColumnCache object with a constant scalar value.
   void fillColumnCache();
 
@@ -245,6 +324,14 @@ private:
   String     itsString;
   ArrayBase* itsCurArray;             //# array value (constant or in itsCurRow)
   rownr_t    itsCurRow;               //# row of current array value
+  uInt       itsChunkSize;            //# nr of rows evaluated at once
+  Bool       itsUseChunk;             //# cache a chunk for single gets?
+  ArrayBase* itsChunk;                //# scalar values of the cached chunk
+  const char* itsChunkData;           //# pointer to the data in itsChunk
+  uInt       itsChunkElemSize;        //# size of a value in itsChunk
+  rownr_t    itsChunkStart;           //# first row in the cached chunk
+  rownr_t    itsChunkNrow;            //# nr of rows in the cached chunk
+  uInt       itsReadAhead;            //# nr of rows in the next chunk
 };
 
 
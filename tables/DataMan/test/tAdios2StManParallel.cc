@@ -0,0 +1,193 @@
+//# tAdios2StManParallel.cc: Test parallel writes with the ADIOS2 storage manager
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/Adios2StMan.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/RefRows.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/namespace.h>
+
+// This program tests writing a table with the ADIOS2 BP engine from
+// multiple local processes. When built with MPI it is run by mpiexec;
+// each process writes its own block of rows with a single put per
+// column, which the engine aggregates when writing. Without MPI
+// a single process writes all blocks.
+// The data are read back using contiguous, strided and sliced selections.
+
+const uInt nrowPerBlock = 25;
+const IPosition cellShape(2, 4, 6);
+
+// The value of a cell depends on its row number.
+Array<Float> cellValue (rownr_t rownr)
+{
+    Array<Float> arr(cellShape);
+    indgen (arr, Float(rownr * 100));
+    return arr;
+}
+
+void writeBlock (Table &tab, uInt block)
+{
+    rownr_t start = block * nrowPerBlock;
+    Array<Float> data(IPosition(3, cellShape[0], cellShape[1], nrowPerBlock));
+    Vector<Int> ids(nrowPerBlock);
+    for (uInt i = 0; i < nrowPerBlock; ++i)
+    {
+        Array<Float> cell(data[i]);
+        cell = cellValue(start + i);
+        ids[i] = start + i;
+    }
+    Slicer rowRange(IPosition(1, start), IPosition(1, nrowPerBlock));
+    ArrayColumn<Float>(tab, "Data").putColumnRange(rowRange, data);
+    ScalarColumn<Int>(tab, "Id").putColumnRange(rowRange, ids);
+}
+
+void doWrite (const std::string &filename, uInt rank, uInt nproc)
+{
+    TableDesc td("", "1", TableDesc::Scratch);
+    td.addColumn (ScalarColumnDesc<Int>("Id"));
+    td.addColumn (ArrayColumnDesc<Float>("Data", cellShape, ColumnDesc::FixedShape));
+    SetupNewTable newtab(filename, td, Table::New);
+    // Aggregate the data of the processes in a single subfile.
+    std::map<std::string, std::string> engineParams;
+    engineParams["NumAggregators"] = "1";
+    // Keep few deferred puts pending, so they are performed while writing.
+    engineParams["DeferredPutBytes"] = "4096";
+#ifdef HAVE_MPI
+    Adios2StMan stman(MPI_COMM_WORLD, "BPFile", engineParams);
+    newtab.bindAll(stman);
+    Table tab(MPI_COMM_WORLD, newtab, nproc * nrowPerBlock);
+    writeBlock (tab, rank);
+#else
+    Adios2StMan stman("BPFile", engineParams);
+    newtab.bindAll(stman);
+    Table tab(newtab, nproc * nrowPerBlock);
+    for (uInt block = 0; block < nproc; ++block)
+    {
+        writeBlock (tab, block);
+    }
+    (void)rank;
+#endif // HAVE_MPI
+}
+
+void doRead (const std::string &filename, uInt nproc)
+{
+    Table tab(filename);
+    rownr_t nrow = nproc * nrowPerBlock;
+    AlwaysAssertExit (tab.nrow() == nrow);
+    ScalarColumn<Int> idCol(tab, "Id");
+    ArrayColumn<Float> dataCol(tab, "Data");
+    // Read the entire column.
+    Vector<Int> ids = idCol.getColumn();
+    Array<Float> data = dataCol.getColumn();
+    for (rownr_t row = 0; row < nrow; ++row)
+    {
+        AlwaysAssertExit (ids[row] == Int(row));
+        AlwaysAssertExit (allEQ (Array<Float>(data[row]), cellValue(row)));
+    }
+    // Read every third row.
+    RefRows rows(1, nrow - 1, 3);
+    Vector<Int> idsSel = idCol.getColumnCells(rows);
+    Array<Float> dataSel = dataCol.getColumnCells(rows);
+    for (uInt i = 0; i < idsSel.size(); ++i)
+    {
+        AlwaysAssertExit (idsSel[i] == Int(1 + 3*i));
+        AlwaysAssertExit (allEQ (Array<Float>(dataSel[i]), cellValue(1 + 3*i)));
+    }
+    // Read a strided slice of a single cell and of a range of rows.
+    Slicer slicer(IPosition(2, 1, 0), IPosition(2, 2, 3), IPosition(2, 2, 2));
+    for (rownr_t row = 0; row < nrow; row += 7)
+    {
+        AlwaysAssertExit (allEQ (dataCol.getSlice(row, slicer),
+                                 cellValue(row)(slicer)));
+    }
+    Slicer rowRange(IPosition(1, nrowPerBlock - 2), IPosition(1, 5));
+    Array<Float> slices = dataCol.getColumnRange(rowRange, slicer);
+    for (uInt i = 0; i < 5; ++i)
+    {
+        AlwaysAssertExit (allEQ (Array<Float>(slices[i]),
+                                 cellValue(nrowPerBlock - 2 + i)(slicer)));
+    }
+    // Read a contiguous slice of a selection of rows.
+    Slicer box(IPosition(2, 1, 2), IPosition(2, 3, 4));
+    Array<Float> boxes = dataCol.getColumnCells(rows, box);
+    for (uInt i = 0; i < idsSel.size(); ++i)
+    {
+        AlwaysAssertExit (allEQ (Array<Float>(boxes[i]),
+                                 cellValue(1 + 3*i)(box)));
+    }
+    // Read a strided slice of rows with a large increment.
+    RefRows sparseRows(2, nrow - 1, 7);
+    Array<Float> sparse = dataCol.getColumnCells(sparseRows, slicer);
+    Vector<Int> idsSparse = idCol.getColumnCells(sparseRows);
+    for (uInt i = 0; i < idsSparse.size(); ++i)
+    {
+        AlwaysAssertExit (idsSparse[i] == Int(2 + 7*i));
+        AlwaysAssertExit (allEQ (Array<Float>(sparse[i]),
+                                 cellValue(2 + 7*i)(slicer)));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uInt rank = 0;
+    uInt nproc = 4;
+#ifdef HAVE_MPI
+    MPI_Init(&argc, &argv);
+    int mpiRank, mpiSize;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    rank = mpiRank;
+    nproc = mpiSize;
+#else
+    (void)argc;
+    (void)argv;
+#endif // HAVE_MPI
+
+    try
+    {
+        doWrite("tAdios2StManParallel_tmp.table", rank, nproc);
+#ifdef HAVE_MPI
+        MPI_Barrier(MPI_COMM_WORLD);
+#endif // HAVE_MPI
+        doRead("tAdios2StManParallel_tmp.table", nproc);
+    }
+    catch (std::exception &x)
+    {
+        std::cout << "Caught an exception: " << x.what() << std::endl;
+        return 1;
+    }
+
+#ifdef HAVE_MPI
+    MPI_Finalize();
+#endif
+    return 0;
+}
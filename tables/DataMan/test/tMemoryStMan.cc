@@ -31,6 +31,8 @@
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/DataMan/MemoryStMan.h>
+#include <casacore/tables/DataMan/DataManAccessor.h>
+#include <casacore/tables/DataMan/DataManError.h>
 #include <casacore/casa/BasicSL/Complex.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/IO/ArrayIO.h>
@@ -98,6 +100,12 @@ void restoreData(const Table aTable);
 // put/putColumn cache test
 void putColumnTest();
 
+// Test the memory budget.
+void budgetTest();
+
+// Test spilling arrays if over the memory budget.
+void spillTest();
+
 
 int main ()
 {
@@ -136,7 +144,8 @@ int main ()
 	  aNewNrRows(i) = i;
 	}
 	deleteRows      (aNewNrRows);
-
+	budgetTest();
+	spillTest();
 
     } catch (std::exception& x) {
 	cout << "Caught an exception: " << x.what() << endl;
@@ -703,18 +712,141 @@ void putColumnTest()
   saveData(aTable);
 }
 
+void budgetTest()
+{
+  TableDesc td("", "1", TableDesc::Scratch);
+  td.addColumn (ScalarColumnDesc<Int>("Col-1"));
+  td.addColumn (ArrayColumnDesc<Float>("Col-2", IPosition(2,16,16),
+                                       ColumnDesc::Direct));
+  td.addColumn (ArrayColumnDesc<String>("Col-3", IPosition(1,3),
+                                        ColumnDesc::Direct));
+  td.addColumn (ArrayColumnDesc<Int>("Col-4"));
+  SetupNewTable aNewTab("tMemoryStMan_tmp.budget", td, Table::Scratch);
+  MemoryStMan aSm1 ("MSMBudget", 1024*1024);
+  aNewTab.bindAll (aSm1);
+  Table aTable(aNewTab);
+  RODataManAccessor accessor(aTable, "MSMBudget", False);
+  AlwaysAssertExit (accessor.getProperties().asInt64("MaxMemory") ==
+                    1024*1024);
+  ScalarColumn<Int>   col1(aTable, "Col-1");
+  ArrayColumn<Float>  col2(aTable, "Col-2");
+  ArrayColumn<String> col3(aTable, "Col-3");
+  ArrayColumn<Int>    col4(aTable, "Col-4");
+  Matrix<Float> arrf(16, 16);
+  Vector<String> arrs(3);
+  Vector<Int> arri(10);
+  // Add rows until the budget is exhausted.
+  Bool exceeded = False;
+  rownr_t nrow = 0;
+  while (!exceeded  &&  nrow < 100000) {
+    try {
+      aTable.addRow();
+      arrf = Float(nrow);
+      arrs = String::toString(nrow);
+      arri = Int(nrow);
+      col1.put (nrow, nrow);
+      col2.put (nrow, arrf);
+      col3.put (nrow, arrs);
+      col4.put (nrow, arri);
+      nrow++;
+    } catch (const DataManError&) {
+      exceeded = True;
+    }
+  }
+  AlwaysAssertExit (exceeded);
+  AlwaysAssertExit (nrow > 100);
+  // Raising the budget makes it possible to continue.
+  Record prop;
+  prop.define ("MaxMemory", Int64(0));
+  RODataManAccessor(aTable, "MSMBudget", False).setProperties (prop);
+  while (aTable.nrow() > nrow) {
+    aTable.removeRow (aTable.nrow() - 1);
+  }
+  for (uInt i=0; i<10; ++i) {
+    aTable.addRow();
+    arrf = Float(nrow);
+    arrs = String::toString(nrow);
+    arri = Int(nrow);
+    col1.put (nrow, nrow);
+    col2.put (nrow, arrf);
+    col3.put (nrow, arrs);
+    col4.put (nrow, arri);
+    nrow++;
+  }
+  // Remove some rows (reusing their arrays) and check all data.
+  aTable.removeRow (0);
+  aTable.removeRow (nrow/2 - 1);
+  aTable.addRow (2);
+  for (rownr_t i=0; i<aTable.nrow()-2; ++i) {
+    Int v = col1(i);
+    AlwaysAssertExit (v > 0  &&  v != Int(nrow/2));
+    AlwaysAssertExit (allEQ (col2(i), Float(v)));
+    AlwaysAssertExit (allEQ (col3(i), String::toString(v)));
+    AlwaysAssertExit (allEQ (col4(i), v));
+  }
+}
 
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+void spillTest()
+{
+  TableDesc td("", "1", TableDesc::Scratch);
+  td.addColumn (ScalarColumnDesc<Int>("Col-1"));
+  td.addColumn (ArrayColumnDesc<Float>("Col-2", IPosition(2,16,16),
+                                       ColumnDesc::Direct));
+  SetupNewTable aNewTab("tMemoryStMan_tmp.spill", td, Table::Scratch);
+  // The budget holds 48 arrays of 1 KByte (a slab of 16 and one of 32).
+  MemoryStMan aSm1 ("MSMSpill", 64*1024);
+  aNewTab.bindAll (aSm1);
+  Table aTable(aNewTab);
+  RODataManAccessor accessor(aTable, "MSMSpill", False);
+  ScalarColumn<Int>   col1(aTable, "Col-1");
+  ArrayColumn<Float>  col2(aTable, "Col-2");
+  // Far more arrays than fit in the budget can be added and read back.
+  const rownr_t nrow = 500;
+  Matrix<Float> arrf(16, 16);
+  for (rownr_t i=0; i<nrow; ++i) {
+    aTable.addRow();
+    arrf = Float(i);
+    col1.put (i, i);
+    col2.put (i, arrf);
+  }
+  AlwaysAssertExit (accessor.getProperties().asInt64("MaxMemory") ==
+                    64*1024);
+  for (rownr_t i=0; i<nrow; ++i) {
+    AlwaysAssertExit (allEQ (col2(i), Float(i)));
+  }
+  // Access a few rows repeatedly in between the others, so they stay
+  // in memory, and update some rows.
+  for (rownr_t i=0; i<nrow; i+=3) {
+    AlwaysAssertExit (allEQ (col2(i), Float(i)));
+    AlwaysAssertExit (allEQ (col2(1), Float(1)));
+    arrf = Float(2*i);
+    col2.put (i, arrf);
+    col1.put (i, 2*i);
+  }
+  // Slices of spilled arrays can be accessed.
+  Slicer slicer(IPosition(2,1,2), IPosition(2,3,4));
+  for (rownr_t i=0; i<nrow; i+=7) {
+    AlwaysAssertExit (allEQ (col2.getSlice(i, slicer), Float(col1(i))));
+    col2.putSlice (i, slicer, Matrix<Float>(3, 4, Float(col1(i))));
+  }
+  // Remove rows, also spilled ones.
+  aTable.removeRow (0);
+  aTable.removeRow (nrow/2);
+  aTable.removeRow (aTable.nrow() - 1);
+  aTable.addRow (2);
+  arrf = Float(-1);
+  col2.put (aTable.nrow() - 2, arrf);
+  col2.put (aTable.nrow() - 1, arrf);
+  col1.put (aTable.nrow() - 2, -1);
+  col1.put (aTable.nrow() - 1, -1);
+  for (rownr_t i=0; i<aTable.nrow(); ++i) {
+    AlwaysAssertExit (allEQ (col2(i), Float(col1(i))));
+  }
+  // Raising the budget keeps the data.
+  Record prop;
+  prop.define ("MaxMemory", Int64(0));
+  RODataManAccessor(aTable, "MSMSpill", False).setProperties (prop);
+  for (rownr_t i=0; i<aTable.nrow(); ++i) {
+    AlwaysAssertExit (allEQ (col2(i), Float(col1(i))));
+  }
+}
@@ -0,0 +1,212 @@
+//# tSSMDictString.cc: Test dictionary encoded strings in StandardStMan
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/TableColumn.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for dictionary encoded String columns in StandardStMan.
+// </summary>
+
+// The value of a row in the dictionary encoded column.
+String dictValue (rownr_t rownr)
+{
+  static const char* names[] = {"3C286", "3C48", "a_rather_long_source_name",
+                                "", "CasA"};
+  return names[rownr % 5];
+}
+
+// Create a table with a dictionary encoded column Src and a normal
+// column Name.
+void createTable (const String& name, rownr_t nrow, Bool useSpec)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<String>("Src"));
+  td.addColumn (ScalarColumnDesc<String>("Name"));
+  td.addColumn (ScalarColumnDesc<Int>("Id"));
+  SetupNewTable newtab(name, td, Table::New);
+  if (useSpec) {
+    Record spec;
+    spec.define ("DICTCOLUMNS", Vector<String>(1, "Src"));
+    SSMBase ssm ("SSM", spec);
+    newtab.bindAll (ssm);
+  } else {
+    StandardStMan ssm (-16);
+    ssm.setDictColumns (Vector<String>(1, "Src"));
+    newtab.bindAll (ssm);
+  }
+  Table tab(newtab, nrow);
+  ScalarColumn<String> src(tab, "Src");
+  ScalarColumn<String> nam(tab, "Name");
+  ScalarColumn<Int> id(tab, "Id");
+  for (rownr_t i=0; i<nrow; ++i) {
+    src.put (i, dictValue(i));
+    nam.put (i, dictValue(i));
+    id.put (i, i);
+  }
+}
+
+// Check the contents of the table.
+void checkTable (const String& name, rownr_t nrow)
+{
+  Table tab(name);
+  AlwaysAssertExit (tab.nrow() == nrow);
+  Record spec = tab.dataManagerInfo().subRecord(0).subRecord("SPEC");
+  AlwaysAssertExit (spec.isDefined ("DICTCOLUMNS"));
+  AlwaysAssertExit (allEQ (spec.asArrayString("DICTCOLUMNS"),
+                           Vector<String>(1, "Src")));
+  ScalarColumn<String> src(tab, "Src");
+  ScalarColumn<String> nam(tab, "Name");
+  ScalarColumn<Int> id(tab, "Id");
+  AlwaysAssertExit (src.isDictEncoded());
+  AlwaysAssertExit (! nam.isDictEncoded());
+  Vector<String> srcVec = src.getColumn();
+  for (rownr_t i=0; i<nrow; ++i) {
+    String expVal = dictValue(id(i));
+    AlwaysAssertExit (src(i) == expVal);
+    AlwaysAssertExit (srcVec[i] == expVal);
+    AlwaysAssertExit (nam(i) == expVal);
+    AlwaysAssertExit (src.getDictCode(i) == src.findDictCode(expVal));
+  }
+  AlwaysAssertExit (src.findDictCode("unknown") == -1);
+  AlwaysAssertExit (src.findDictCode("") == 0);
+}
+
+// Select on the columns and check if the results are the same.
+void checkSelect (const String& name)
+{
+  Table tab(name);
+  for (uInt i=0; i<6; ++i) {
+    String value = (i<5 ? dictValue(i) : String("unknown"));
+    Table sel1 = tab(tab.col("Src") == value);
+    Table sel2 = tab(tab.col("Name") == value);
+    AlwaysAssertExit (allEQ (sel1.rowNumbers(), sel2.rowNumbers()));
+    sel1 = tab(value != tab.col("Src"));
+    sel2 = tab(value != tab.col("Name"));
+    AlwaysAssertExit (allEQ (sel1.rowNumbers(), sel2.rowNumbers()));
+  }
+  // Select on a selection.
+  Table sel = tab(tab.col("Id") > 10);
+  Table sel1 = sel(sel.col("Src") == "CasA");
+  Table sel2 = sel(sel.col("Name") == "CasA");
+  AlwaysAssertExit (sel1.nrow() > 0);
+  AlwaysAssertExit (allEQ (sel1.rowNumbers(tab), sel2.rowNumbers(tab)));
+}
+
+// Reuse an expression on a value that is added to the dictionary later.
+void checkAbsent (const String& name)
+{
+  Table tab(name, Table::Update);
+  ScalarColumn<String> src(tab, "Src");
+  TableExprNode expr (tab.col("Src") == "Later");
+  AlwaysAssertExit (tab(expr).nrow() == 0);
+  String old = src(3);
+  src.put (3, "Later");
+  Table sel = tab(expr);
+  AlwaysAssertExit (sel.nrow() == 1  &&  sel.rowNumbers(tab)[0] == 3);
+  src.put (3, old);
+  // Only adding a value changes the dictionary generation.
+  TableColumn tcol(tab, "Src");
+  uInt64 gen = tcol.dictGeneration();
+  src.put (4, src(3));
+  src.put (4, dictValue(4));
+  AlwaysAssertExit (tcol.dictGeneration() == gen);
+  // A value added while evaluating is found in the next rows.
+  TableExprNode expr2 (tab.col("Src") == "Later2");
+  Bool val;
+  expr2.get (5, val);
+  AlwaysAssertExit (!val);
+  String old6 = src(6);
+  src.put (6, "Later2");
+  AlwaysAssertExit (tcol.dictGeneration() == gen+1);
+  expr2.get (6, val);
+  AlwaysAssertExit (val);
+  src.put (6, old6);
+}
+
+// Update the table by changing, adding and removing rows.
+void updateTable (const String& name)
+{
+  Table tab(name, Table::Update);
+  ScalarColumn<String> src(tab, "Src");
+  ScalarColumn<String> nam(tab, "Name");
+  ScalarColumn<Int> id(tab, "Id");
+  // Add a new value in a row to be removed.
+  src.put (0, "NewSrc");
+  nam.put (0, "NewSrc");
+  // Change a value to an existing value.
+  src.put (1, dictValue(2));
+  nam.put (1, dictValue(2));
+  id.put (1, 2);
+  tab.removeRow (0);
+  // Added rows are empty strings.
+  rownr_t nrow = tab.nrow();
+  tab.addRow (2);
+  AlwaysAssertExit (src(nrow) == "");
+  id.put (nrow, 3);
+  id.put (nrow+1, 3);
+  nam.put (nrow, "");
+  nam.put (nrow+1, "");
+  // Put the entire column in a new value.
+  Vector<String> vec = src.getColumn();
+  src.putColumn (vec);
+}
+
+int main()
+{
+  try {
+    createTable ("tSSMDictString_tmp.data1", 100, False);
+    checkTable ("tSSMDictString_tmp.data1", 100);
+    checkSelect ("tSSMDictString_tmp.data1");
+    checkAbsent ("tSSMDictString_tmp.data1");
+    updateTable ("tSSMDictString_tmp.data1");
+    checkTable ("tSSMDictString_tmp.data1", 101);
+    checkSelect ("tSSMDictString_tmp.data1");
+    createTable ("tSSMDictString_tmp.data2", 1000, True);
+    checkTable ("tSSMDictString_tmp.data2", 1000);
+    checkSelect ("tSSMDictString_tmp.data2");
+    // Copy the table; the copy also has to be dictionary encoded.
+    Table("tSSMDictString_tmp.data2").deepCopy ("tSSMDictString_tmp.data3",
+                                                Table::New);
+    checkTable ("tSSMDictString_tmp.data3", 1000);
+  } catch (std::exception& x) {
+    cout << "Caught an exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;                           // exit with success status
+}
@@ -0,0 +1,191 @@
+//# tTSMLayoutOptimizer.cc: Test program for class TSMLayoutOptimizer
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/TSMLayoutOptimizer.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/TiledStManAccessor.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/IO/ArrayIO.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <fstream>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class TSMLayoutOptimizer.
+// </summary>
+
+const String tabName = "tTSMLayoutOptimizer_tmp.data";
+
+Array<Float> cellValue (rownr_t row)
+{
+  Array<Float> arr(IPosition(2,4,64));
+  indgen (arr, Float(row*1000));
+  return arr;
+}
+
+void createTable (rownr_t nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("time"));
+  td.addColumn (ArrayColumnDesc<Float>("data", IPosition(2,4,64),
+                                       ColumnDesc::FixedShape));
+  td.defineHypercolumn ("TSMData", 3, stringToVector("data"));
+  SetupNewTable newtab(tabName, td, Table::New);
+  StandardStMan ssm;
+  TiledColumnStMan tsm("TSMData", IPosition(3,4,64,16));
+  newtab.bindAll (ssm);
+  newtab.bindColumn ("data", tsm);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> timeCol(tab, "time");
+  ArrayColumn<Float> dataCol(tab, "data");
+  for (rownr_t i=0; i<nrow; ++i) {
+    timeCol.put (i, i);
+    dataCol.put (i, cellValue(i));
+  }
+}
+
+void testCost()
+{
+  // A cube of 4 pol, 64 channels and 1024 rows.
+  TSMLayoutOptimizer opt(IPosition(3,4,64,1024), 4);
+  opt.setCacheSize (16*1024);
+  // Access all channels of a row at a time.
+  opt.addTraversal (IPosition(3,4,64,1));
+  AlwaysAssertExit (opt.naccess() == 1024);
+  // Tiles containing all channels of a few rows are best.
+  Double costRow  = opt.cost (IPosition(3,4,64,4));
+  Double costChan = opt.cost (IPosition(3,4,1,256));
+  AlwaysAssertExit (costRow < costChan);
+  IPosition best = opt.bestTileShape (4096);
+  AlwaysAssertExit (best[1] == 64);
+  AlwaysAssertExit (best.product() * 4 <= 4096);
+  // Now access a single channel for all rows; that makes the tiles
+  // with few channels better.
+  TSMLayoutOptimizer opt2(IPosition(3,4,64,1024), 4);
+  opt2.setCacheSize (16*1024);
+  opt2.addTraversal (IPosition(3,4,1,1024));
+  AlwaysAssertExit (opt2.cost (IPosition(3,4,1,256)) <
+                    opt2.cost (IPosition(3,4,64,4)));
+  IPosition best2 = opt2.bestTileShape (4096);
+  AlwaysAssertExit (best2[1] < 64);
+  // All candidates must be within the size limits.
+  std::vector<IPosition> cands = opt2.candidates (4096);
+  AlwaysAssertExit (! cands.empty());
+  for (const IPosition& shape : cands) {
+    AlwaysAssertExit (shape.product()*4 <= 4096);
+    AlwaysAssertExit (shape.product()*4 >= 2048);
+  }
+}
+
+void testTrace()
+{
+  TSMLayoutOptimizer opt(Table(tabName), "data");
+  AlwaysAssertExit (opt.cubeShape().isEqual (IPosition(3,4,64,256)));
+  AlwaysAssertExit (opt.currentTileShape().isEqual (IPosition(3,4,64,16)));
+  // Write a trace file as done by TableTrace.
+  {
+    std::ofstream ofs("tTSMLayoutOptimizer_tmp.trace");
+    ofs << "# time oper tabid name row(s) shape blc/trc/inc" << endl;
+    ofs << "# Note: shapes are in Fortran order" << endl << endl;
+    ofs << "12:00:00.000000000 o t=0 " << tabName << ' ' << endl;
+    ofs << "12:00:00.000000001 o t=1 other.tab " << endl;
+    ofs << "12:00:00.000000002 r t=0 data * [4,64,256] [0,3][3,3][1,1]"
+        << endl;
+    ofs << "12:00:00.000000003 r t=0 data 0:9,20:29:3 [4,64,4]" << endl;
+    ofs << "12:00:00.000000004 r t=0 time 5" << endl;
+    ofs << "12:00:00.000000005 r t=1 data 7 [4,64]" << endl;
+    ofs << "12:00:00.000000006 w t=0 data 12 [4,64]" << endl;
+    ofs << "12:00:00.000000007 c t=0 " << tabName << ' ' << endl;
+    ofs << "12:00:00.000000008 r t=0 data 13 [4,64]" << endl;
+  }
+  // The accesses of the other table and after closing are ignored.
+  // The row range with increment results in 4 accesses.
+  uInt n = opt.addTrace ("tTSMLayoutOptimizer_tmp.trace", "data", tabName);
+  AlwaysAssertExit (n == 3);
+  AlwaysAssertExit (opt.naccess() == 1 + 1 + 4 + 1);
+  // Without a table name all table ids are used.
+  TSMLayoutOptimizer opt2(Table(tabName), "data");
+  n = opt2.addTrace ("tTSMLayoutOptimizer_tmp.trace", "data");
+  AlwaysAssertExit (n == 5);
+  AlwaysAssertExit (opt.cost (IPosition(3,4,64,16)) > 0);
+}
+
+void testRetile()
+{
+  {
+    Table tab(tabName, Table::Update);
+    TSMLayoutOptimizer opt(tab, "data");
+    opt.addTraversal (IPosition(3,4,1,256));
+    IPosition tileShape = opt.bestTileShape (64*1024);
+    AlwaysAssertExit (! tileShape.isEqual (opt.currentTileShape()));
+    // Use small chunks to test the chunking.
+    TSMLayoutOptimizer::retile (tab, "data", tileShape, 100000);
+    ROTiledStManAccessor acc(tab, "data", True);
+    AlwaysAssertExit (acc.tileShape(0).isEqual (tileShape));
+  }
+  Table tab(tabName);
+  AlwaysAssertExit (tab.nrow() == 256);
+  AlwaysAssertExit (tab.tableDesc().ncolumn() == 2);
+  ArrayColumn<Float> dataCol(tab, "data");
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    AlwaysAssertExit (allEQ (dataCol(i), cellValue(i)));
+  }
+  // A column in a storage manager other than a tiled one is refused.
+  Table tabw(tabName, Table::Update);
+  Bool ok = False;
+  try {
+    TSMLayoutOptimizer::retile (tabw, "time", IPosition(1,16));
+  } catch (TableError&) {
+    ok = True;
+  }
+  AlwaysAssertExit (ok);
+}
+
+int main()
+{
+  try {
+    testCost();
+    createTable (256);
+    testTrace();
+    testRetile();
+  } catch (std::exception& x) {
+    cout << "Caught an exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;                           // exit with success status
+}
@@ -0,0 +1,159 @@
+//# tTiledDirect.cc: Test and benchmark O_DIRECT reads of tiled storage managers
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/TSMOption.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/Slicer.h>
+#include <casacore/casa/OS/Timer.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <casacore/casa/sstream.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test and benchmark program for O_DIRECT reads of a TiledStMan.
+// </summary>
+
+// This program writes a table with a tiled data column and reads it
+// back sequentially in chunks of rows using the normal cached IO and
+// using TSMOption::Direct (O_DIRECT with multi-tile reads). It checks
+// that both give the correct data and shows the sustained throughput.
+// If the file system does not support O_DIRECT, the normal reads are
+// used by the Direct option, which is also tested in this way.
+// <p>
+// By default a small table is used, so it can run as a regression test.
+// For benchmarking a larger table can be given as:
+// <srcblock>
+//    tTiledDirect nrow [nchan [rowsPerTile [rowsPerRead]]]
+// </srcblock>
+// The table is written in the working directory.
+
+// The value of a cell depends on its row number.
+Array<Complex> cellValue (const IPosition& shape, rownr_t rownr)
+{
+  Array<Complex> arr(shape);
+  indgen (arr, Complex(rownr, 0));
+  return arr;
+}
+
+void createTable (const String& name, const IPosition& cellShape,
+                  rownr_t nrow, uInt rowsPerTile)
+{
+  TableDesc td ("", "1", TableDesc::Scratch);
+  td.addColumn (ArrayColumnDesc<Complex> ("Data", cellShape,
+                                          ColumnDesc::FixedShape));
+  SetupNewTable newtab(name, td, Table::New);
+  TiledColumnStMan sm ("TSMData", IPosition(3, cellShape[0], cellShape[1],
+                                            rowsPerTile));
+  newtab.bindAll (sm);
+  Table tab(newtab, nrow);
+  ArrayColumn<Complex> col(tab, "Data");
+  for (rownr_t row=0; row<nrow; ++row) {
+    col.put (row, cellValue (cellShape, row));
+  }
+}
+
+// Read the table in chunks of rows and return the throughput in MB/s.
+double readTable (const String& name, TSMOption::Option option,
+                  uInt rowsPerRead, Bool check)
+{
+  Table tab(name, Table::Old, TSMOption(option, 0, 0));
+  ArrayColumn<Complex> col(tab, "Data");
+  IPosition cellShape = col.shape(0);
+  Timer timer;
+  double nbytes = 0;
+  for (rownr_t row=0; row<tab.nrow(); row+=rowsPerRead) {
+    rownr_t nr = std::min (rownr_t(rowsPerRead), tab.nrow() - row);
+    Array<Complex> data = col.getColumnRange
+      (Slicer(IPosition(1, row), IPosition(1, nr)));
+    nbytes += data.size() * sizeof(Complex);
+    if (check) {
+      for (rownr_t i=0; i<nr; ++i) {
+        AlwaysAssertExit (allEQ (Array<Complex>(data[i]),
+                                 cellValue (cellShape, row+i)));
+      }
+    }
+  }
+  double time = timer.real();
+  return (time > 0  ?  nbytes / time / (1024*1024) : 0);
+}
+
+int main (int argc, const char* argv[])
+{
+  try {
+    rownr_t nrow = 1000;
+    uInt nchan = 64;
+    uInt rowsPerTile = 16;
+    uInt rowsPerRead = 100;
+    if (argc > 1) {
+      istringstream istr(argv[1]);
+      istr >> nrow;
+    }
+    if (argc > 2) {
+      istringstream istr(argv[2]);
+      istr >> nchan;
+    }
+    if (argc > 3) {
+      istringstream istr(argv[3]);
+      istr >> rowsPerTile;
+    }
+    if (argc > 4) {
+      istringstream istr(argv[4]);
+      istr >> rowsPerRead;
+    }
+    // Only check the data for a small table.
+    Bool check = nrow <= 10000;
+    IPosition cellShape(2, 4, nchan);
+    createTable ("tTiledDirect_tmp.data", cellShape, nrow, rowsPerTile);
+    double cacheRate  = readTable ("tTiledDirect_tmp.data", TSMOption::Cache,
+                                   rowsPerRead, check);
+    double directRate = readTable ("tTiledDirect_tmp.data", TSMOption::Direct,
+                                   rowsPerRead, check);
+    // Read again, now mostly from the kernel's file cache (if not O_DIRECT).
+    double cacheRate2 = readTable ("tTiledDirect_tmp.data", TSMOption::Cache,
+                                   rowsPerRead, False);
+    double directRate2 = readTable ("tTiledDirect_tmp.data", TSMOption::Direct,
+                                    rowsPerRead, False);
+    cout << "Read " << nrow << " rows of shape " << cellShape
+         << " in chunks of " << rowsPerRead << " rows" << endl;
+    cout << "  cached IO:  " << cacheRate << ", " << cacheRate2
+         << " MB/s" << endl;
+    cout << "  direct IO:  " << directRate << ", " << directRate2
+         << " MB/s" << endl;
+  } catch (std::exception& x) {
+    cout << "Caught an exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;                           // exit with success status
+}
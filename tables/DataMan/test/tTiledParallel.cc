@@ -0,0 +1,203 @@
+//# tTiledParallel.cc: Test parallel writes into different tiled hypercubes
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/tables/DataMan/TiledDataStMan.h>
+#include <casacore/tables/DataMan/TiledColumnStMan.h>
+#include <casacore/tables/DataMan/TiledDataStManAccessor.h>
+#include <casacore/tables/DataMan/TiledStManAccessor.h>
+#include <casacore/casa/Containers/Record.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/IO/ArrayIO.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <thread>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for parallel writes into a tiled storage manager.
+// </summary>
+
+// This program tests if multiple threads can put data in parallel into
+// rows residing in different extensible hypercubes of a TiledShapeStMan
+// and a TiledDataStMan. The rows and hypercubes are created beforehand.
+// It also tests threads putting into their own range of rows and into
+// interleaved rows of the single hypercube of a TiledColumnStMan, which
+// are serialized. The data are read back serially and checked.
+
+const uInt nthread = 4;
+const uInt nrowPerThread = 50;
+
+// The value of a cell depends on its row number.
+Array<Float> cellValue (const IPosition& shape, rownr_t rownr)
+{
+  Array<Float> arr(shape);
+  indgen (arr, Float(rownr));
+  return arr;
+}
+
+// Put the rows rownr = thread + i*nthread.
+void putInterleaved (Table tab, uInt thread)
+{
+  ArrayColumn<Float> col(tab, "Data");
+  for (rownr_t row=thread; row<tab.nrow(); row+=nthread) {
+    col.put (row, cellValue (col.shape(row), row));
+  }
+}
+
+// Put the rows of the given hypercube (which are consecutive).
+void putCube (Table tab, uInt thread)
+{
+  ArrayColumn<Float> col(tab, "Data");
+  for (rownr_t i=0; i<nrowPerThread; ++i) {
+    rownr_t row = thread*nrowPerThread + i;
+    col.put (row, cellValue (col.shape(row), row));
+  }
+}
+
+void checkTable (const String& name)
+{
+  Table tab(name);
+  AlwaysAssertExit (tab.nrow() == nthread*nrowPerThread);
+  ArrayColumn<Float> col(tab, "Data");
+  for (rownr_t row=0; row<tab.nrow(); ++row) {
+    AlwaysAssertExit (allEQ (col(row), cellValue (col.shape(row), row)));
+  }
+}
+
+void runThreads (const Table& tab, void (*func)(Table, uInt))
+{
+  std::vector<std::thread> threads;
+  for (uInt i=0; i<nthread; ++i) {
+    threads.push_back (std::thread (func, tab, i));
+  }
+  for (uInt i=0; i<nthread; ++i) {
+    threads[i].join();
+  }
+}
+
+// Each thread writes rows with its own shape, thus its own hypercube.
+// The rows of the threads are interleaved.
+void testShape()
+{
+  TableDesc td ("", "1", TableDesc::Scratch);
+  td.addColumn (ArrayColumnDesc<Float> ("Data", 2));
+  td.defineHypercolumn ("TSMData", 3, stringToVector ("Data"));
+  // Use SepFile, because the hypercubes should not share a MultiFile.
+  SetupNewTable newtab("tTiledParallel_tmp.data1", td, Table::New,
+                       StorageOption(StorageOption::SepFile));
+  TiledShapeStMan sm ("TSMData", IPosition(3,4,8,5));
+  newtab.bindAll (sm);
+  Table tab(newtab, TableLock(TableLock::PermanentLocking));
+  ArrayColumn<Float> col(tab, "Data");
+  tab.addRow (nthread*nrowPerThread);
+  for (rownr_t row=0; row<tab.nrow(); ++row) {
+    col.setShape (row, IPosition(2, 4, 8+row%nthread));
+  }
+  AlwaysAssertExit (ROTiledStManAccessor(tab, "TSMData").nhypercubes()
+                    == nthread + 1);
+  runThreads (tab, putInterleaved);
+  tab.flush();
+}
+
+// Each thread writes the rows of its own hypercube.
+void testData()
+{
+  TableDesc td ("", "1", TableDesc::Scratch);
+  td.addColumn (ArrayColumnDesc<Float> ("Data", IPosition(2,4,8),
+                                        ColumnDesc::FixedShape));
+  td.addColumn (ScalarColumnDesc<Int> ("Id"));
+  td.defineHypercolumn ("TSMData", 3, stringToVector ("Data"),
+                        Vector<String>(), stringToVector ("Id"));
+  // Use SepFile, because the hypercubes should not share a MultiFile.
+  SetupNewTable newtab("tTiledParallel_tmp.data2", td, Table::New,
+                       StorageOption(StorageOption::SepFile));
+  TiledDataStMan sm ("TSMData");
+  newtab.bindAll (sm);
+  Table tab(newtab, TableLock(TableLock::PermanentLocking));
+  TiledDataStManAccessor acc(tab, "TSMData");
+  Record values;
+  for (uInt i=0; i<nthread; ++i) {
+    values.define ("Id", Int(i));
+    acc.addHypercube (IPosition(3,4,8,0), IPosition(3,4,8,5), values);
+    tab.addRow (nrowPerThread);
+    acc.extendHypercube (nrowPerThread, values);
+  }
+  runThreads (tab, putCube);
+  tab.flush();
+}
+
+// Each thread writes its own range of rows in the same hypercube.
+// Thereafter the threads write interleaved rows, so they share tiles.
+void testColumn()
+{
+  TableDesc td ("", "1", TableDesc::Scratch);
+  td.addColumn (ArrayColumnDesc<Float> ("Data", IPosition(2,4,8),
+                                        ColumnDesc::FixedShape));
+  td.defineHypercolumn ("TSMData", 3, stringToVector ("Data"));
+  SetupNewTable newtab("tTiledParallel_tmp.data3", td, Table::New);
+  TiledColumnStMan sm ("TSMData", IPosition(3,4,8,5));
+  newtab.bindAll (sm);
+  Table tab(newtab, TableLock(TableLock::PermanentLocking),
+            nthread*nrowPerThread);
+  AlwaysAssertExit (ROTiledStManAccessor(tab, "TSMData").nhypercubes()
+                    == 1);
+  runThreads (tab, putCube);
+  tab.flush();
+  checkTable ("tTiledParallel_tmp.data3");
+  // Clear the data, so the check after the interleaved puts is valid.
+  ArrayColumn<Float> col(tab, "Data");
+  col.fillColumn (Array<Float>(IPosition(2,4,8), Float(0)));
+  AlwaysAssertExit (allEQ (col(1), Float(0)));
+  runThreads (tab, putInterleaved);
+  tab.flush();
+}
+
+int main()
+{
+  try {
+    testShape();
+    checkTable ("tTiledParallel_tmp.data1");
+    testData();
+    checkTable ("tTiledParallel_tmp.data2");
+    testColumn();
+    checkTable ("tTiledParallel_tmp.data3");
+  } catch (std::exception& x) {
+    cout << "Caught an exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;                           // exit with success status
+}
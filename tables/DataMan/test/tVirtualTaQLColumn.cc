@@ -35,6 +35,8 @@
 #include <casacore/tables/Tables/ArrayColumn.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/tables/DataMan/StManAipsIO.h>
+#include <casacore/tables/DataMan/DataManAccessor.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/TaQL/TableParse.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/Cube.h>
@@ -59,6 +61,8 @@ TableDesc makeDesc();
 void a (const TableDesc&);
 void check(const Table& table, Bool showname);
 void testSelect();
+void testChunk();
+void testArrayColumn();
 void testPerf();
 
 int main ()
@@ -75,6 +79,8 @@ int main ()
 	check (tab2, True);
       }
       testSelect();
+      testChunk();
+      testArrayColumn();
       testPerf();
     } catch (std::exception& x) {
 	cout << "Caught an exception: " << x.what() << endl;
@@ -358,6 +364,108 @@ void testSelect()
   check (subset, False);
 }
 
+// Test the evaluation in chunks of rows for a read-only table.
+void testChunk()
+{
+  Table tab("tVirtualTaQLColumn_tmp.data0");
+  ScalarColumn<float> acalc(tab,"acalc");
+  ScalarColumn<short> acalc3(tab,"acalc3");
+  ScalarColumn<String> acalcaf(tab,"acalcaf");
+  // Use a chunk size not dividing the number of rows.
+  RODataManAccessor acc(tab, "acalc", True);
+  AlwaysAssertExit (acc.getProperties().asInt("ChunkSize") == 1024);
+  Record rec;
+  rec.define ("ChunkSize", 3);
+  acc.setProperties (rec);
+  AlwaysAssertExit (acc.getProperties().asInt("ChunkSize") == 3);
+  Vector<float> acalcvec = acalc.getColumn();
+  Vector<short> acalc3vec = acalc3.getColumn();
+  Vector<String> acalcafvec = acalcaf.getColumn();
+  // Get the rows in reversed order and compare with the full column.
+  for (Int i=tab.nrow()-1; i>=0; --i) {
+    AlwaysAssertExit (acalc(i) == i+10);
+    AlwaysAssertExit (acalcvec(i) == i+10);
+    AlwaysAssertExit (acalc3(i) == acalc3vec(i));
+    AlwaysAssertExit (acalcaf(i) == acalcafvec(i));
+    AlwaysAssertExit (acalcaf(i).size() == 4);
+  }
+  // Random access only evaluates the rows asked for.
+  rownr_t randRows[] = {5, 2, 8, 3, 4, 5, 6};
+  for (uInt j=0; j<7; ++j) {
+    rownr_t i = randRows[j];
+    AlwaysAssertExit (acalc(i) == i+10);
+    AlwaysAssertExit (acalc3(i) == acalc3vec(i));
+  }
+  // Get some cells.
+  RefRows rows(1, 9, 2);
+  Vector<float> cells = acalc.getColumnCells (rows);
+  AlwaysAssertExit (cells.size() == 5);
+  for (uInt i=0; i<cells.size(); ++i) {
+    AlwaysAssertExit (cells(i) == 2*i+11);
+  }
+  // Disable the cache.
+  rec.define ("ChunkSize", 0);
+  acc.setProperties (rec);
+  AlwaysAssertExit (acalc(7) == 17);
+  AlwaysAssertExit (allEQ (acalc.getColumn(), acalcvec));
+}
+
+// Test getting an array column that is a copy of another column
+// and columns that are expressions of it (evaluated in chunks of rows).
+void testArrayColumn()
+{
+  {
+    Table tab("tVirtualTaQLColumn_tmp.data0", Table::Update);
+    VirtualTaQLColumn vtcopy("arr1");
+    VirtualTaQLColumn vtexpr("(arr1 - ab) / 2. + ac");
+    VirtualTaQLColumn vtint("ab * [1,2,3] + ac");
+    tab.addColumn (ArrayColumnDesc<float>("arrcopy"), vtcopy);
+    tab.addColumn (ArrayColumnDesc<double>("arrexpr"), vtexpr);
+    tab.addColumn (ArrayColumnDesc<Int>("arrint"), vtint);
+  }
+  Table tab("tVirtualTaQLColumn_tmp.data0");
+  ArrayColumn<float> arr1(tab, "arr1");
+  ArrayColumn<float> arrcopy(tab, "arrcopy");
+  ArrayColumn<float> arrcalc(tab, "arrcalc");
+  ArrayColumn<double> arrexpr(tab, "arrexpr");
+  ArrayColumn<Int> arrint(tab, "arrint");
+  ScalarColumn<Int> ab(tab, "ab");
+  ScalarColumn<Int> ac(tab, "ac");
+  AlwaysAssertExit (allEQ (arrcopy.getColumn(), arr1.getColumn()));
+  RefRows rows(1, 9, 2);
+  AlwaysAssertExit (allEQ (arrcopy.getColumnCells(rows),
+                           arr1.getColumnCells(rows)));
+  // Use chunks not dividing the number of rows.
+  RODataManAccessor acc(tab, "arrexpr", True);
+  Record rec;
+  rec.define ("ChunkSize", 3);
+  acc.setProperties (rec);
+  Array<float> calc = arrcalc.getColumn();
+  Array<double> expr = arrexpr.getColumn();
+  Array<Int> ints = arrint.getColumn();
+  Array<double> exprCells = arrexpr.getColumnCells (rows);
+  AlwaysAssertExit (expr.shape() == IPosition(4,2,3,4,10));
+  AlwaysAssertExit (ints.shape() == IPosition(2,3,10));
+  Vector<Int> ivec(3);
+  for (uInt i=0; i<tab.nrow(); ++i) {
+    AlwaysAssertExit (allEQ (arrcopy(i), arr1(i)));
+    AlwaysAssertExit (allEQ (arrcalc(i), float(ab(i)) * arr1(i)));
+    AlwaysAssertExit (allEQ (calc[i], arrcalc(i)));
+    Array<double> exp (arr1(i).shape());
+    convertArray (exp, arr1(i));
+    exp = (exp - double(ab(i))) / 2. + double(ac(i));
+    AlwaysAssertExit (allNear (Array<double>(expr[i]), exp, 1e-10));
+    AlwaysAssertExit (allEQ (arrexpr(i), Array<double>(expr[i])));
+    indgen (ivec, ab(i) + ac(i), ab(i));
+    AlwaysAssertExit (allEQ (Array<Int>(ints[i]), ivec));
+    AlwaysAssertExit (allEQ (arrint(i), ivec));
+  }
+  for (uInt i=0; i<5; ++i) {
+    AlwaysAssertExit (allEQ (Array<double>(exprCells[i]),
+                             Array<double>(expr[2*i+1])));
+  }
+}
+
 // Test how getting a column performs.
 void testPerf()
 {
@@ -31,6 +31,7 @@
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Utilities/DataType.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/casa/Quanta/MVTime.h>
@@ -253,8 +254,38 @@ Array<uInt>     TableExprNodeColumn::getColumnuInt (const Vector<rownr_t>& rownr
     ScalarColumn<uInt> col (tabCol_p);
     return col.getColumnCells (rownrs);
 }
+namespace {
+    // Get the cells of a column of type T converted to type U.
+    template<typename T, typename U>
+    Array<U> getConvertedCells (const TableColumn& tabCol,
+                                const Vector<rownr_t>& rownrs)
+    {
+        ScalarColumn<T> col (tabCol);
+        Array<T> arr (col.getColumnCells (rownrs));
+        Array<U> out (arr.shape());
+        convertArray (out, arr);
+        return out;
+    }
+}
+
+// A column of another integer type is converted, so the column can be
+// used by the getColumn functions of an integer expression.
 Array<Int64>    TableExprNodeColumn::getColumnInt64 (const Vector<rownr_t>& rownrs)
 {
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        return getConvertedCells<uChar,Int64> (tabCol_p, rownrs);
+    case TpShort:
+        return getConvertedCells<Short,Int64> (tabCol_p, rownrs);
+    case TpUShort:
+        return getConvertedCells<uShort,Int64> (tabCol_p, rownrs);
+    case TpInt:
+        return getConvertedCells<Int,Int64> (tabCol_p, rownrs);
+    case TpUInt:
+        return getConvertedCells<uInt,Int64> (tabCol_p, rownrs);
+    default:
+        break;
+    }
     ScalarColumn<Int64> col (tabCol_p);
     return col.getColumnCells (rownrs);
 }
@@ -263,8 +294,27 @@ Array<Float>    TableExprNodeColumn::getColumnFloat (const Vector<rownr_t>& rown
     ScalarColumn<Float> col (tabCol_p);
     return col.getColumnCells (rownrs);
 }
+// A column of another real type is converted.
 Array<Double>   TableExprNodeColumn::getColumnDouble (const Vector<rownr_t>& rownrs)
 {
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        return getConvertedCells<uChar,Double> (tabCol_p, rownrs);
+    case TpShort:
+        return getConvertedCells<Short,Double> (tabCol_p, rownrs);
+    case TpUShort:
+        return getConvertedCells<uShort,Double> (tabCol_p, rownrs);
+    case TpInt:
+        return getConvertedCells<Int,Double> (tabCol_p, rownrs);
+    case TpUInt:
+        return getConvertedCells<uInt,Double> (tabCol_p, rownrs);
+    case TpInt64:
+        return getConvertedCells<Int64,Double> (tabCol_p, rownrs);
+    case TpFloat:
+        return getConvertedCells<Float,Double> (tabCol_p, rownrs);
+    default:
+        break;
+    }
     ScalarColumn<Double> col (tabCol_p);
     return col.getColumnCells (rownrs);
 }
@@ -275,6 +325,9 @@ Array<Complex>  TableExprNodeColumn::getColumnComplex (const Vector<rownr_t>& ro
 }
 Array<DComplex> TableExprNodeColumn::getColumnDComplex (const Vector<rownr_t>& rownrs)
 {
+    if (tabCol_p.columnDesc().dataType() == TpComplex) {
+        return getConvertedCells<Complex,DComplex> (tabCol_p, rownrs);
+    }
     ScalarColumn<DComplex> col (tabCol_p);
     return col.getColumnCells (rownrs);
 }
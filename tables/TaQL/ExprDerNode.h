@@ -321,6 +321,8 @@ public:
     const TableColumn& getColumn() const;
 
     // Get the data for the given rows.
+    // getColumnInt64, getColumnDouble and getColumnDComplex also convert
+    // a column of a narrower numeric type.
     Array<Bool>     getColumnBool (const Vector<rownr_t>& rownrs) override;
     Array<uChar>    getColumnuChar (const Vector<rownr_t>& rownrs) override;
     Array<Short>    getColumnShort (const Vector<rownr_t>& rownrs) override;
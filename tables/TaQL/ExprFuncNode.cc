@@ -1113,12 +1113,12 @@ MVTime TableExprFuncNode::getDate (const TableExprId& id)
     switch (funcType_p) {
     case datetimeFUNC:
       {
-        Quantity quant;
-        if (MVTime::read (quant, operands_p[0]->getString(id))) {
-            return quant;
+        MVTime date;
+        String str (operands_p[0]->getString(id));
+        if (MVTime::read (date, str)) {
+            return date;
         }
-        throw (TableInvExpr ("invalid date string " +
-                             operands_p[0]->getString(id)));
+        throw (TableInvExpr ("invalid date string " + str));
       }
     case mjdtodateFUNC:
         return MVTime (operands_p[0]->getDouble(id));
@@ -2548,13 +2548,13 @@ MArray<MVTime> TableExprFuncNodeArray::getArrayDate (const TableExprId& id)
         Bool deleteVal, deleteDat;
         const String* val = values.array().getStorage (deleteVal);
         MVTime* dat = dates.getStorage (deleteDat);
-        Quantity quant;
         size_t n = values.size();
-        for (size_t i=0; i<n; i++) {
-            if (MVTime::read (quant, val[i])) {
-                dat[i] = quant;
-            }
-            throw (TableInvExpr ("invalid date string " + val[i]));
+        size_t nread = MVTime::read (dat, val, n);
+        if (nread < n) {
+            String str (val[nread]);
+            values.array().freeStorage (val, deleteVal);
+            dates.putStorage (dat, deleteDat);
+            throw (TableInvExpr ("invalid date string " + str));
         }
         values.array().freeStorage (val, deleteVal);
         dates.putStorage (dat, deleteDat);
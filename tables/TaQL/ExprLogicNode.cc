@@ -38,6 +38,57 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 // Implement the comparison operators for each data type.
 
+TableExprNodeDictCompare::TableExprNodeDictCompare()
+: col_p     (0),
+  code_p    (-1),
+  checked_p (False),
+  lookedUp_p   (False),
+  generation_p (0)
+{}
+
+Bool TableExprNodeDictCompare::use (const TENShPtr& lnode,
+                                    const TENShPtr& rnode)
+{
+    if (! checked_p) {
+        checked_p = True;
+        // One operand has to be a column, the other one a constant.
+        TableExprNodeColumn* col = dynamic_cast<TableExprNodeColumn*>(lnode.get());
+        TableExprNodeRep* cnst = rnode.get();
+        if (col == 0) {
+            col  = dynamic_cast<TableExprNodeColumn*>(rnode.get());
+            cnst = lnode.get();
+        }
+        if (col != 0  &&  cnst->isConstant()  &&
+            col->getColumn().isDictEncoded()) {
+            col_p   = col;
+            value_p = cnst->getString (TableExprId(0));
+        }
+    }
+    return col_p != 0;
+}
+
+Bool TableExprNodeDictCompare::equal (const TableExprId& id)
+{
+    // Note that the column object can change (by applySelection), so
+    // it is obtained each time.
+    const TableColumn& col = col_p->getColumn();
+    // A code once found stays valid, because the dictionary never shrinks.
+    // An absent value is looked up again only if values have been added
+    // to the dictionary since the previous lookup.
+    if (code_p < 0) {
+        uInt64 generation = col.dictGeneration();
+        if (!lookedUp_p  ||  generation != generation_p) {
+            code_p       = col.findDictCode (value_p);
+            generation_p = generation;
+            lookedUp_p   = True;
+        }
+        if (code_p < 0) {
+            return False;
+        }
+    }
+    return col.getDictCode (id.rownr()) == code_p;
+}
+
 TableExprNodeEQBool::TableExprNodeEQBool (const TableExprNodeRep& node)
 : TableExprNodeBinary (NTBool, node, OtEQ)
 {}
@@ -75,6 +126,9 @@ TableExprNodeEQString::TableExprNodeEQString (const TableExprNodeRep& node)
 {}
 Bool TableExprNodeEQString::getBool (const TableExprId& id)
 {
+    if (dict_p.use (lnode_p, rnode_p)) {
+        return dict_p.equal (id);
+    }
     return lnode_p->getString(id) == rnode_p->getString(id);
 }
 
@@ -132,6 +186,9 @@ TableExprNodeNEString::TableExprNodeNEString (const TableExprNodeRep& node)
 {}
 Bool TableExprNodeNEString::getBool (const TableExprId& id)
 {
+    if (dict_p.use (lnode_p, rnode_p)) {
+        return ! dict_p.equal (id);
+    }
     return lnode_p->getString(id) != rnode_p->getString(id);
 }
 
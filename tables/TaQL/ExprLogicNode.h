@@ -43,6 +43,58 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 //# Binary operators ==, >=, >, <, <=, !=, and IN are recognized.
 //# Also &&, ||, and unary ! are recognized.
 
+//# Forward Declarations
+class TableExprNodeColumn;
+
+
+// <summary>
+// Compare a dictionary encoded String column with a constant
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="UNKNOWN" date="" tests="">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> TableExprNode
+//   <li> TableColumn
+// </prerequisite>
+
+// <synopsis>
+// A scalar String column can be stored with dictionary encoding (see
+// function <src>isDictEncoded</src> in class
+// <linkto class=TableColumn>TableColumn</linkto>). Equal values in such
+// a column have equal integer codes. Hence a comparison of such a column
+// with a constant string can be done by comparing the code in each row
+// with the code of the constant, so the strings do not need to be read.
+// <br>This class is used by the == and != string comparisons. The first
+// time it is used, it tests if one operand is such a column and the
+// other one is a constant.
+// </synopsis>
+
+class TableExprNodeDictCompare
+{
+public:
+    TableExprNodeDictCompare();
+
+    // Can the comparison of the given operands be done on the codes?
+    Bool use (const TENShPtr& lnode, const TENShPtr& rnode);
+
+    // Test if the value for the given id equals the constant.
+    Bool equal (const TableExprId& id);
+
+private:
+    TableExprNodeColumn* col_p;
+    String               value_p;
+    Int                  code_p;
+    Bool                 checked_p;
+    // Dictionary generation at the last lookup of an absent value.
+    Bool                 lookedUp_p;
+    uInt64               generation_p;
+};
+
 
 
 // <summary>
@@ -193,6 +245,8 @@ public:
     TableExprNodeEQString (const TableExprNodeRep&);
     ~TableExprNodeEQString() = default;
     Bool getBool (const TableExprId& id) override;
+private:
+    TableExprNodeDictCompare dict_p;
 };
 
 
@@ -404,6 +458,8 @@ public:
     TableExprNodeNEString (const TableExprNodeRep&);
     ~TableExprNodeNEString() = default;
     Bool getBool (const TableExprId& id) override;
+private:
+    TableExprNodeDictCompare dict_p;
 };
 
 
@@ -26,11 +26,40 @@
 #include <casacore/tables/TaQL/ExprMathNode.h>
 #include <casacore/tables/TaQL/ExprUnitNode.h>
 #include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
 #include <casacore/casa/Quanta/MVTime.h>
 #include <casacore/casa/BasicMath/Math.h>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+namespace {
+    // Get the values of an operand for the given rows.
+    // A constant operand is evaluated only once.
+    Array<Int64> operandInt (const TENShPtr& node,
+                             const Vector<rownr_t>& rownrs)
+    {
+        if (node->isConstant()) {
+            return Array<Int64> (IPosition(1, rownrs.size()),
+                                 node->getInt (TableExprId(0)));
+        }
+        return node->getColumnInt64 (rownrs);
+    }
+    Array<Double> operandDouble (const TENShPtr& node,
+                                 const Vector<rownr_t>& rownrs)
+    {
+        if (node->isConstant()) {
+            return Array<Double> (IPosition(1, rownrs.size()),
+                                  node->getDouble (TableExprId(0)));
+        }
+        if (node->dataType() == TableExprNodeRep::NTInt) {
+            Array<Double> out (IPosition(1, rownrs.size()));
+            convertArray (out, node->getColumnInt64 (rownrs));
+            return out;
+        }
+        return node->getColumnDouble (rownrs);
+    }
+}
+
 // Implement the arithmetic operators for each data type.
 
 TableExprNodePlus::TableExprNodePlus (NodeDataType dt,
@@ -51,6 +80,8 @@ Double TableExprNodePlusInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) + rnode_p->getInt(id); }
 DComplex TableExprNodePlusInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) + rnode_p->getInt(id)); }
+Array<Int64> TableExprNodePlusInt::getColumnInt64 (const Vector<rownr_t>& rownrs)
+    { return operandInt(lnode_p, rownrs) + operandInt(rnode_p, rownrs); }
 
 TableExprNodePlusDouble::TableExprNodePlusDouble (const TableExprNodeRep& node)
 : TableExprNodePlus (NTDouble, node)
@@ -61,6 +92,8 @@ Double TableExprNodePlusDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) + rnode_p->getDouble(id); }
 DComplex TableExprNodePlusDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) + rnode_p->getDouble(id); }
+Array<Double> TableExprNodePlusDouble::getColumnDouble (const Vector<rownr_t>& rownrs)
+    { return operandDouble(lnode_p, rownrs) + operandDouble(rnode_p, rownrs); }
 
 TableExprNodePlusDComplex::TableExprNodePlusDComplex (const TableExprNodeRep& node)
 : TableExprNodePlus (NTComplex, node)
@@ -123,6 +156,8 @@ Double TableExprNodeMinusInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) - rnode_p->getInt(id); }
 DComplex TableExprNodeMinusInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) - rnode_p->getInt(id)); }
+Array<Int64> TableExprNodeMinusInt::getColumnInt64 (const Vector<rownr_t>& rownrs)
+    { return operandInt(lnode_p, rownrs) - operandInt(rnode_p, rownrs); }
 
 TableExprNodeMinusDouble::TableExprNodeMinusDouble (const TableExprNodeRep& node)
 : TableExprNodeMinus (NTDouble, node)
@@ -141,6 +176,8 @@ Double TableExprNodeMinusDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) - rnode_p->getDouble(id); }
 DComplex TableExprNodeMinusDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) - rnode_p->getDouble(id); }
+Array<Double> TableExprNodeMinusDouble::getColumnDouble (const Vector<rownr_t>& rownrs)
+    { return operandDouble(lnode_p, rownrs) - operandDouble(rnode_p, rownrs); }
 
 TableExprNodeMinusDComplex::TableExprNodeMinusDComplex (const TableExprNodeRep& node)
 : TableExprNodeMinus (NTComplex, node)
@@ -196,6 +233,8 @@ Double TableExprNodeTimesInt::getDouble (const TableExprId& id)
     { return lnode_p->getInt(id) * rnode_p->getInt(id); }
 DComplex TableExprNodeTimesInt::getDComplex (const TableExprId& id)
     { return double(lnode_p->getInt(id) * rnode_p->getInt(id)); }
+Array<Int64> TableExprNodeTimesInt::getColumnInt64 (const Vector<rownr_t>& rownrs)
+    { return operandInt(lnode_p, rownrs) * operandInt(rnode_p, rownrs); }
 
 TableExprNodeTimesDouble::TableExprNodeTimesDouble (const TableExprNodeRep& node)
 : TableExprNodeTimes (NTDouble, node)
@@ -206,6 +245,8 @@ Double TableExprNodeTimesDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) * rnode_p->getDouble(id); }
 DComplex TableExprNodeTimesDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) * rnode_p->getDouble(id); }
+Array<Double> TableExprNodeTimesDouble::getColumnDouble (const Vector<rownr_t>& rownrs)
+    { return operandDouble(lnode_p, rownrs) * operandDouble(rnode_p, rownrs); }
 
 TableExprNodeTimesDComplex::TableExprNodeTimesDComplex (const TableExprNodeRep& node)
 : TableExprNodeTimes (NTComplex, node)
@@ -262,6 +303,8 @@ Double TableExprNodeDivideDouble::getDouble (const TableExprId& id)
     { return lnode_p->getDouble(id) / rnode_p->getDouble(id); }
 DComplex TableExprNodeDivideDouble::getDComplex (const TableExprId& id)
     { return lnode_p->getDouble(id) / rnode_p->getDouble(id); }
+Array<Double> TableExprNodeDivideDouble::getColumnDouble (const Vector<rownr_t>& rownrs)
+    { return operandDouble(lnode_p, rownrs) / operandDouble(rnode_p, rownrs); }
 
 TableExprNodeDivideDComplex::TableExprNodeDivideDComplex (const TableExprNodeRep& node)
 : TableExprNodeDivide (NTComplex, node)
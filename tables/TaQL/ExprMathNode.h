@@ -101,6 +101,8 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Int64> getColumnInt64 (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -133,6 +135,8 @@ public:
     ~TableExprNodePlusDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Double> getColumnDouble (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -289,6 +293,8 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Int64> getColumnInt64 (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -321,6 +327,8 @@ public:
     virtual void handleUnits();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Double> getColumnDouble (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -444,6 +452,8 @@ public:
     Int64    getInt      (const TableExprId& id);
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Int64> getColumnInt64 (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -475,6 +485,8 @@ public:
     ~TableExprNodeTimesDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Double> getColumnDouble (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -565,6 +577,8 @@ public:
     ~TableExprNodeDivideDouble();
     Double   getDouble   (const TableExprId& id);
     DComplex getDComplex (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Double> getColumnDouble (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -29,9 +29,121 @@
 #include <casacore/tables/TaQL/MArray.h>
 #include <casacore/tables/TaQL/MArrayMath.h>
 #include <casacore/casa/Quanta/MVTime.h>
+#include <functional>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
+namespace {
+    // An operand of an array operation evaluated for a chunk of rows.
+    // An array operand has the row as its last axis, while a scalar operand
+    // has a value per row (thus its element step is 0).
+    // A constant operand is evaluated only once (thus its row step is 0).
+    template<typename T>
+    struct ChunkOperand
+    {
+        Array<T>  values;
+        IPosition cellShape;           //# empty for a scalar
+        size_t    rowStep;
+        size_t    elemStep;
+    };
+
+    template<typename T>
+    void setOperand (ChunkOperand<T>& op, const Array<T>& values,
+                     Bool isArray, Bool isConstant)
+    {
+        op.values.reference (values);
+        if (! op.values.contiguousStorage()) {
+            op.values.reference (values.copy());
+        }
+        op.rowStep  = 1;
+        op.elemStep = 0;
+        if (isArray) {
+            op.cellShape = values.shape();
+            if (! isConstant  &&  values.ndim() > 0) {
+                op.cellShape.resize (values.ndim() - 1);
+            }
+            op.rowStep  = op.cellShape.product();
+            op.elemStep = 1;
+        }
+        if (isConstant) {
+            op.rowStep = 0;
+        }
+    }
+
+    ChunkOperand<Int64> operandInt (const TENShPtr& node,
+                                    const Vector<rownr_t>& rownrs)
+    {
+        ChunkOperand<Int64> op;
+        Bool isArray = node->valueType() == TableExprNodeRep::VTArray;
+        if (node->isConstant()) {
+            TableExprId id(0);
+            setOperand (op, (isArray  ?  node->getArrayInt(id).array() :
+                             Array<Int64>(IPosition(1,1), node->getInt(id))),
+                        isArray, True);
+        } else {
+            setOperand (op, (isArray  ?  node->getArrayColumnInt(rownrs) :
+                             node->getColumnInt64(rownrs)),
+                        isArray, False);
+        }
+        return op;
+    }
+
+    ChunkOperand<Double> operandDouble (const TENShPtr& node,
+                                        const Vector<rownr_t>& rownrs)
+    {
+        ChunkOperand<Double> op;
+        Bool isArray = node->valueType() == TableExprNodeRep::VTArray;
+        if (node->isConstant()) {
+            TableExprId id(0);
+            setOperand (op, (isArray  ?  node->getArrayDouble(id).array() :
+                             Array<Double>(IPosition(1,1), node->getDouble(id))),
+                        isArray, True);
+        } else if (node->dataType() == TableExprNodeRep::NTInt) {
+            // Convert integer values, which can be evaluated per chunk.
+            Array<Int64> values (isArray  ?  node->getArrayColumnInt(rownrs) :
+                                 node->getColumnInt64(rownrs));
+            Array<Double> dvalues (values.shape());
+            convertArray (dvalues, values);
+            setOperand (op, dvalues, isArray, False);
+        } else {
+            setOperand (op, (isArray  ?  node->getArrayColumnDouble(rownrs) :
+                             node->getColumnDouble(rownrs)),
+                        isArray, False);
+        }
+        return op;
+    }
+
+    // Apply the operator to the operands for all rows of the chunk.
+    template<typename T, typename BinaryOperator>
+    Array<T> operateChunk (const ChunkOperand<T>& left,
+                           const ChunkOperand<T>& right,
+                           size_t nrow, BinaryOperator oper)
+    {
+        if (nrow == 0) {
+            return Array<T>();
+        }
+        if (! (left.cellShape.empty()  ||  right.cellShape.empty()  ||
+               left.cellShape.isEqual (right.cellShape))) {
+            throw TableInvExpr ("Array shapes in expression mismatch");
+        }
+        const IPosition& cellShape = (left.cellShape.empty()  ?
+                                      right.cellShape : left.cellShape);
+        size_t ncell = cellShape.product();
+        Array<T> result (cellShape.concatenate (IPosition(1, nrow)));
+        T* out = result.data();
+        const T* lrow = left.values.data();
+        const T* rrow = right.values.data();
+        for (size_t i=0; i<nrow; ++i) {
+            for (size_t j=0; j<ncell; ++j) {
+                *out++ = oper (lrow[j*left.elemStep], rrow[j*right.elemStep]);
+            }
+            lrow += left.rowStep;
+            rrow += right.rowStep;
+        }
+        return result;
+    }
+}
+
 // Implement the arithmetic operators for each data type.
 
 TableExprNodeArrayPlus::TableExprNodeArrayPlus (NodeDataType dt,
@@ -60,6 +172,13 @@ MArray<Int64> TableExprNodeArrayPlusInt::getArrayInt
     }
     return lnode_p->getArrayInt (id) + rnode_p->getArrayInt (id);
 }
+Array<Int64> TableExprNodeArrayPlusInt::getArrayColumnInt
+                                            (const Vector<rownr_t>& rownrs)
+{
+    return operateChunk (operandInt(lnode_p, rownrs),
+                         operandInt(rnode_p, rownrs),
+                         rownrs.size(), std::plus<Int64>());
+}
 
 TableExprNodeArrayPlusDouble::TableExprNodeArrayPlusDouble
                                             (const TableExprNodeRep& node)
@@ -80,6 +199,13 @@ MArray<Double> TableExprNodeArrayPlusDouble::getArrayDouble
     }
     return lnode_p->getArrayDouble (id) + rnode_p->getArrayDouble (id);
 }
+Array<Double> TableExprNodeArrayPlusDouble::getArrayColumnDouble
+                                            (const Vector<rownr_t>& rownrs)
+{
+    return operateChunk (operandDouble(lnode_p, rownrs),
+                         operandDouble(rnode_p, rownrs),
+                         rownrs.size(), std::plus<Double>());
+}
 
 TableExprNodeArrayPlusDComplex::TableExprNodeArrayPlusDComplex
                                             (const TableExprNodeRep& node)
@@ -184,6 +310,13 @@ MArray<Int64> TableExprNodeArrayMinusInt::getArrayInt
     }
     return lnode_p->getArrayInt (id) - rnode_p->getArrayInt (id);
 }
+Array<Int64> TableExprNodeArrayMinusInt::getArrayColumnInt
+                                            (const Vector<rownr_t>& rownrs)
+{
+    return operateChunk (operandInt(lnode_p, rownrs),
+                         operandInt(rnode_p, rownrs),
+                         rownrs.size(), std::minus<Int64>());
+}
 
 TableExprNodeArrayMinusDouble::TableExprNodeArrayMinusDouble
                                             (const TableExprNodeRep& node)
@@ -204,6 +337,13 @@ MArray<Double> TableExprNodeArrayMinusDouble::getArrayDouble
     }
     return lnode_p->getArrayDouble (id) - rnode_p->getArrayDouble (id);
 }
+Array<Double> TableExprNodeArrayMinusDouble::getArrayColumnDouble
+                                            (const Vector<rownr_t>& rownrs)
+{
+    return operateChunk (operandDouble(lnode_p, rownrs),
+                         operandDouble(rnode_p, rownrs),
+                         rownrs.size(), std::minus<Double>());
+}
 
 TableExprNodeArrayMinusDComplex::TableExprNodeArrayMinusDComplex
                                             (const TableExprNodeRep& node)
@@ -297,6 +437,13 @@ MArray<Int64> TableExprNodeArrayTimesInt::getArrayInt
     }
     return lnode_p->getArrayInt (id) * rnode_p->getArrayInt (id);
 }
+Array<Int64> TableExprNodeArrayTimesInt::getArrayColumnInt
+                                            (const Vector<rownr_t>& rownrs)
+{
+    return operateChunk (operandInt(lnode_p, rownrs),
+                         operandInt(rnode_p, rownrs),
+                         rownrs.size(), std::multiplies<Int64>());
+}
 
 TableExprNodeArrayTimesDouble::TableExprNodeArrayTimesDouble
                                             (const TableExprNodeRep& node)
@@ -317,6 +464,13 @@ MArray<Double> TableExprNodeArrayTimesDouble::getArrayDouble
     }
     return lnode_p->getArrayDouble (id) * rnode_p->getArrayDouble (id);
 }
+Array<Double> TableExprNodeArrayTimesDouble::getArrayColumnDouble
+                                            (const Vector<rownr_t>& rownrs)
+{
+    return operateChunk (operandDouble(lnode_p, rownrs),
+                         operandDouble(rnode_p, rownrs),
+                         rownrs.size(), std::multiplies<Double>());
+}
 
 TableExprNodeArrayTimesDComplex::TableExprNodeArrayTimesDComplex
                                             (const TableExprNodeRep& node)
@@ -382,6 +536,13 @@ MArray<Double> TableExprNodeArrayDivideDouble::getArrayDouble
     }
     return lnode_p->getArrayDouble (id) / rnode_p->getArrayDouble (id);
 }
+Array<Double> TableExprNodeArrayDivideDouble::getArrayColumnDouble
+                                            (const Vector<rownr_t>& rownrs)
+{
+    return operateChunk (operandDouble(lnode_p, rownrs),
+                         operandDouble(rnode_p, rownrs),
+                         rownrs.size(), std::divides<Double>());
+}
 
 TableExprNodeArrayDivideDComplex::TableExprNodeArrayDivideDComplex
                                             (const TableExprNodeRep& node)
@@ -101,6 +101,8 @@ public:
     TableExprNodeArrayPlusInt (const TableExprNodeRep&);
     ~TableExprNodeArrayPlusInt();
     MArray<Int64> getArrayInt (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Int64> getArrayColumnInt (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -132,6 +134,8 @@ public:
     TableExprNodeArrayPlusDouble (const TableExprNodeRep&);
     ~TableExprNodeArrayPlusDouble();
     MArray<Double> getArrayDouble (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Double> getArrayColumnDouble (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -285,6 +289,8 @@ public:
     TableExprNodeArrayMinusInt (const TableExprNodeRep&);
     ~TableExprNodeArrayMinusInt();
     MArray<Int64> getArrayInt (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Int64> getArrayColumnInt (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -315,6 +321,8 @@ public:
     TableExprNodeArrayMinusDouble (const TableExprNodeRep&);
     ~TableExprNodeArrayMinusDouble();
     MArray<Double> getArrayDouble (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Double> getArrayColumnDouble (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -436,6 +444,8 @@ public:
     TableExprNodeArrayTimesInt (const TableExprNodeRep&);
     ~TableExprNodeArrayTimesInt();
     MArray<Int64> getArrayInt (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Int64> getArrayColumnInt (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -466,6 +476,8 @@ public:
     TableExprNodeArrayTimesDouble (const TableExprNodeRep&);
     ~TableExprNodeArrayTimesDouble();
     MArray<Double> getArrayDouble (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Double> getArrayColumnDouble (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -555,6 +567,8 @@ public:
     TableExprNodeArrayDivideDouble (const TableExprNodeRep&);
     ~TableExprNodeArrayDivideDouble();
     MArray<Double> getArrayDouble (const TableExprId& id);
+    // Evaluate the operation for the given rows at once.
+    Array<Double> getArrayColumnDouble (const Vector<rownr_t>& rownrs);
 };
 
 
@@ -607,6 +607,73 @@ Bool TableExprNodeArrayColumn::getColumnDataType (DataType& dt) const
     return True;
 }
 
+namespace {
+    // Read the arrays in the given rows and convert them to type R.
+    template<typename T, typename R>
+    Array<R> readArrayCells (const TableColumn& col,
+                             const Vector<rownr_t>& rownrs)
+    {
+        Array<T> data (ArrayColumn<T>(col).getColumnCells (rownrs));
+        Array<R> out (data.shape());
+        convertArray (out, data);
+        return out;
+    }
+    template<typename T>
+    Array<T> readArrayCells (const TableColumn& col,
+                             const Vector<rownr_t>& rownrs)
+    {
+        return ArrayColumn<T>(col).getColumnCells (rownrs);
+    }
+}
+
+Array<Int64> TableExprNodeArrayColumn::getArrayColumnInt
+(const Vector<rownr_t>& rownrs)
+{
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        return readArrayCells<uChar,Int64> (tabCol_p, rownrs);
+    case TpShort:
+        return readArrayCells<Short,Int64> (tabCol_p, rownrs);
+    case TpUShort:
+        return readArrayCells<uShort,Int64> (tabCol_p, rownrs);
+    case TpInt:
+        return readArrayCells<Int,Int64> (tabCol_p, rownrs);
+    case TpUInt:
+        return readArrayCells<uInt,Int64> (tabCol_p, rownrs);
+    case TpInt64:
+        return readArrayCells<Int64> (tabCol_p, rownrs);
+    default:
+        break;
+    }
+    return TableExprNodeArray::getArrayColumnInt (rownrs);
+}
+
+Array<Double> TableExprNodeArrayColumn::getArrayColumnDouble
+(const Vector<rownr_t>& rownrs)
+{
+    switch (tabCol_p.columnDesc().dataType()) {
+    case TpUChar:
+        return readArrayCells<uChar,Double> (tabCol_p, rownrs);
+    case TpShort:
+        return readArrayCells<Short,Double> (tabCol_p, rownrs);
+    case TpUShort:
+        return readArrayCells<uShort,Double> (tabCol_p, rownrs);
+    case TpInt:
+        return readArrayCells<Int,Double> (tabCol_p, rownrs);
+    case TpUInt:
+        return readArrayCells<uInt,Double> (tabCol_p, rownrs);
+    case TpInt64:
+        return readArrayCells<Int64,Double> (tabCol_p, rownrs);
+    case TpFloat:
+        return readArrayCells<Float,Double> (tabCol_p, rownrs);
+    case TpDouble:
+        return readArrayCells<Double> (tabCol_p, rownrs);
+    default:
+        break;
+    }
+    return TableExprNodeArray::getArrayColumnDouble (rownrs);
+}
+
 
 
 TableExprNodeArrayColumnBool::TableExprNodeArrayColumnBool
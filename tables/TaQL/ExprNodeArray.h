@@ -238,6 +238,13 @@ public:
     // It returns with a True status.
     Bool getColumnDataType (DataType&) const override;
 
+    // Get the arrays in the given rows of a numeric column with a single
+    // getColumnCells and convert them to the data type requested.
+    // <group>
+    Array<Int64>  getArrayColumnInt (const Vector<rownr_t>& rownrs) override;
+    Array<Double> getArrayColumnDouble (const Vector<rownr_t>& rownrs) override;
+    // </group>
+
 protected:
     TableExprInfo tableInfo_p;
     TableColumn   tabCol_p;
@@ -489,6 +489,54 @@ Array<String>   TableExprNodeRep::getColumnString
     return arr;
 }
 
+namespace {
+    // Store the array of a row in the array holding a chunk of rows.
+    // The result is sized using the shape of the first array.
+    template<typename T>
+    void storeArrayRow (Array<T>& result, const Array<T>& arr,
+                        rownr_t inx, rownr_t nrrow)
+    {
+        if (arr.ndim() == 0) {
+            throw TableInvExpr ("getArrayColumn: the array in a row "
+                                "is undefined");
+        }
+        if (inx == 0) {
+            result.resize (arr.shape().concatenate (IPosition(1,nrrow)));
+        } else if (! arr.shape().isEqual
+                   (result.shape().getFirst (result.ndim() - 1))) {
+            throw TableInvExpr ("getArrayColumn: the arrays in the rows "
+                                "have different shapes");
+        }
+        Array<T> part (result[inx]);
+        part = arr;
+    }
+}
+
+Array<Int64>    TableExprNodeRep::getArrayColumnInt
+(const Vector<rownr_t>& rownrs)
+{
+    TableExprId id;
+    rownr_t nrrow = rownrs.size();
+    Array<Int64> arr;
+    for (rownr_t i=0; i<nrrow; i++) {
+      id.setRownr (rownrs[i]);
+      storeArrayRow (arr, getArrayInt(id).array(), i, nrrow);
+    }
+    return arr;
+}
+Array<Double>   TableExprNodeRep::getArrayColumnDouble
+(const Vector<rownr_t>& rownrs)
+{
+    TableExprId id;
+    rownr_t nrrow = rownrs.size();
+    Array<Double> arr;
+    for (rownr_t i=0; i<nrrow; i++) {
+      id.setRownr (rownrs[i]);
+      storeArrayRow (arr, getArrayDouble(id).array(), i, nrrow);
+    }
+    return arr;
+}
+
 // The following can be implemented one time.
 // It is a optimization to remove an OR or AND when one branch is constant.
 // It should be done in TableExprNodeBinary.
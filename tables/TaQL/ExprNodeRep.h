@@ -424,6 +424,16 @@ public:
     virtual Array<String>   getColumnString (const Vector<rownr_t>& rownrs);
     // </group>
 
+    // Get the array value of the expression for the given rows as a single
+    // array with the row as the last axis. It can only be used if the arrays
+    // in all rows have the same shape; otherwise an exception is thrown.
+    // A mask of the values is ignored.
+    // The default implementation evaluates the expression row by row.
+    // <group>
+    virtual Array<Int64>    getArrayColumnInt (const Vector<rownr_t>& rownrs);
+    virtual Array<Double>   getArrayColumnDouble (const Vector<rownr_t>& rownrs);
+    // </group>
+
     // Convert the tree to a number of range vectors which at least
     // select the same things.
     // This function is very useful to convert the expression to
@@ -27,6 +27,13 @@
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/tables/TaQL/ExprNodeSet.h>
 #include <casacore/tables/TaQL/RecordExpr.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/RowNumbers.h>
 #include <casacore/casa/Arrays/Matrix.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/ArrayMath.h>
@@ -1118,11 +1125,101 @@ void doShow()
   expr2.show (cout);
 }
 
+// Check that evaluating arithmetic for many rows at once gives the same
+// result as evaluating it row by row.
+void doColumn()
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Short>("s"));
+  td.addColumn (ScalarColumnDesc<Int>("i"));
+  td.addColumn (ScalarColumnDesc<Float>("f"));
+  SetupNewTable newtab("tExprNode_tmp.tab", td, Table::Scratch);
+  Table tab(newtab, 10);
+  ScalarColumn<Short> scol(tab, "s");
+  ScalarColumn<Int> icol(tab, "i");
+  ScalarColumn<Float> fcol(tab, "f");
+  for (uInt i=0; i<tab.nrow(); ++i) {
+    scol.put (i, 3-i);
+    icol.put (i, i);
+    fcol.put (i, i+0.5);
+  }
+  RowNumbers rows(Vector<rownr_t>(tab.nrow()));
+  indgen (rows);
+  TableExprNode ei (tab.col("i")*2 - tab.col("s") + 1);
+  TableExprNode ed ((tab.col("i") + tab.col("f")) / 4. * tab.col("s")
+                    - tab.col("i"));
+  Vector<Int64> vi (ei.getColumnInt64 (rows));
+  Vector<Double> vd (ed.getColumnDouble (rows));
+  for (uInt i=0; i<tab.nrow(); ++i) {
+    AlwaysAssertExit (vi[i] == ei.getInt(i));
+    AlwaysAssertExit (vi[i] == 3*Int64(i) - 2);
+    AlwaysAssertExit (vd[i] == ed.getDouble(i));
+  }
+  // Evaluate a subset of the rows.
+  RowNumbers sub(Vector<rownr_t>(3));
+  sub[0] = 7; sub[1] = 2; sub[2] = 5;
+  Vector<Double> vsub (ed.getColumnDouble (sub));
+  for (uInt i=0; i<sub.size(); ++i) {
+    AlwaysAssertExit (vsub[i] == vd[sub[i]]);
+  }
+}
+
+// Check that evaluating array arithmetic for many rows at once gives the
+// same result as evaluating it row by row.
+void doArrayColumn()
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("i"));
+  td.addColumn (ArrayColumnDesc<Float>("a", IPosition(2,2,3),
+                                       ColumnDesc::FixedShape));
+  td.addColumn (ArrayColumnDesc<Short>("s", IPosition(2,2,3),
+                                       ColumnDesc::FixedShape));
+  SetupNewTable newtab("tExprNode_tmp.tab", td, Table::Scratch);
+  Table tab(newtab, 10);
+  ScalarColumn<Int> icol(tab, "i");
+  ArrayColumn<Float> acol(tab, "a");
+  ArrayColumn<Short> scol(tab, "s");
+  Matrix<Float> af(2,3);
+  Matrix<Short> as(2,3);
+  for (uInt i=0; i<tab.nrow(); ++i) {
+    indgen (af, Float(i+0.5));
+    indgen (as, Short(3-i));
+    icol.put (i, i);
+    acol.put (i, af);
+    scol.put (i, as);
+  }
+  Matrix<Double> cnst(2,3);
+  indgen (cnst, 1.);
+  Vector<rownr_t> rows(tab.nrow());
+  indgen (rows);
+  TableExprNode ei (tab.col("s") * tab.col("i") - tab.col("s") + 2);
+  TableExprNode ed ((tab.col("a") + tab.col("s")) / 4. * tab.col("i")
+                    - TableExprNode(cnst) * tab.col("a"));
+  Array<Int64> ai (ei.getRep()->getArrayColumnInt (rows));
+  Array<Double> ad (ed.getRep()->getArrayColumnDouble (rows));
+  AlwaysAssertExit (ai.shape() == IPosition(3,2,3,10));
+  AlwaysAssertExit (ad.shape() == IPosition(3,2,3,10));
+  for (uInt i=0; i<tab.nrow(); ++i) {
+    AlwaysAssertExit (allEQ (Array<Int64>(ai[i]), ei.getArrayInt(i)));
+    AlwaysAssertExit (allEQ (Array<Double>(ad[i]), ed.getArrayDouble(i)));
+  }
+  // Evaluate a subset of the rows.
+  Vector<rownr_t> sub(3);
+  sub[0] = 7; sub[1] = 2; sub[2] = 5;
+  Array<Double> asub (ed.getRep()->getArrayColumnDouble (sub));
+  for (uInt i=0; i<sub.size(); ++i) {
+    AlwaysAssertExit (allEQ (Array<Double>(asub[i]),
+                             Array<Double>(ad[sub[i]])));
+  }
+}
+
 int main()
 {
   try {
     doIt();
     doShow();
+    doColumn();
+    doArrayColumn();
   } catch (std::exception& x) {
     cout << "Unexpected exception: " << x.what() << endl;
     return 1;
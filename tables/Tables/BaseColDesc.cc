@@ -29,6 +29,7 @@
 #include <casacore/tables/Tables/ConcatColumn.h>
 #include <casacore/tables/DataMan/DataManager.h>
 #include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/LazyTableRecord.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/IO/AipsIO.h>
 #include <casacore/casa/IO/ArrayIO.h>
@@ -94,7 +95,8 @@ BaseColumnDesc::BaseColumnDesc (const BaseColumnDesc& that)
   isArray_p     (that.isArray_p),
   isTable_p     (that.isTable_p)
 {
-    keySetPtr_p = new TableRecord(*that.keySetPtr_p);
+    keySetPtr_p = new TableRecord();
+    copyKeywordSet (that);
 }
   
 BaseColumnDesc::~BaseColumnDesc ()
@@ -113,7 +115,7 @@ BaseColumnDesc& BaseColumnDesc::operator= (const BaseColumnDesc& that)
     shape_p.resize (that.shape_p.nelements());
     shape_p        = that.shape_p;
     maxLength_p    = that.maxLength_p;
-    *keySetPtr_p   = *that.keySetPtr_p;
+    copyKeywordSet (that);
     isScalar_p     = that.isScalar_p;
     isArray_p      = that.isArray_p;
     isTable_p      = that.isTable_p;
@@ -275,7 +277,7 @@ void BaseColumnDesc::putFile (AipsIO& ios, const TableAttr& parentAttr) const
 	ios << shape_p;
     }
     ios << maxLength_p;
-    keySetPtr_p->putRecord (ios, parentAttr);
+    keywordSet().putRecord (ios, parentAttr);
     putDesc(ios);
 }
 
@@ -300,10 +302,37 @@ void BaseColumnDesc::getFile (AipsIO& ios, const TableAttr& parentAttr)
 	ios >> shape_p;
     }
     ios >> maxLength_p;
-    keySetPtr_p->getRecord (ios, parentAttr);
+    // Only keep the raw keyword set; it is interpreted when needed.
+    lazyKeySet_p.reset();
+    if (keySetPtr_p->nfields() == 0) {
+        lazyKeySet_p = LazyTableRecord::read (ios, parentAttr);
+    }
+    hasLazyKeySet_p = Bool(lazyKeySet_p);
+    if (! lazyKeySet_p) {
+        keySetPtr_p->getRecord (ios, parentAttr);
+    }
     getDesc (ios);
 }
 
+void BaseColumnDesc::getLazyKeywordSet() const
+{
+    std::lock_guard<std::mutex> lock(lazyMutex_p);
+    // Another thread might have read it in the meantime.
+    if (lazyKeySet_p) {
+        lazyKeySet_p->get (*keySetPtr_p);
+        lazyKeySet_p.reset();
+        hasLazyKeySet_p = False;
+    }
+}
+
+void BaseColumnDesc::copyKeywordSet (const BaseColumnDesc& that)
+{
+    std::lock_guard<std::mutex> lock(that.lazyMutex_p);
+    *keySetPtr_p    = *that.keySetPtr_p;
+    lazyKeySet_p    = that.lazyKeySet_p;
+    hasLazyKeySet_p = Bool(lazyKeySet_p);
+}
+
 
 //# Create a RefColumn object from the description.
 RefColumn* BaseColumnDesc::makeRefColumn (RefTable* rtp, BaseColumn* bcp) const
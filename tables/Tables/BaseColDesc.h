@@ -33,6 +33,9 @@
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/iosfwd.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -41,6 +44,7 @@ class AipsIO;
 class ColumnDescSet;
 class TableRecord;
 class TableAttr;
+class LazyTableRecord;
 class BaseColumn;
 class PlainColumn;
 class RefTable;
@@ -122,11 +126,13 @@ public:
     virtual ~BaseColumnDesc ();
 
     // Get access to the set of keywords.
+    // When the description was read from a file, the keywords are
+    // only read at the first access (which is thread-safe).
     // <group>
     TableRecord& rwKeywordSet()
-	{ return *keySetPtr_p; }
+	{ if (hasLazyKeySet_p) getLazyKeywordSet(); return *keySetPtr_p; }
     const TableRecord& keywordSet() const
-	{ return *keySetPtr_p; }
+	{ if (hasLazyKeySet_p) getLazyKeywordSet(); return *keySetPtr_p; }
     // </group>
 
     // Show the column.
@@ -256,6 +262,11 @@ protected:
     IPosition      shape_p;              //# table array shape
     uInt           maxLength_p;          //# maximum value length (for strings)
     TableRecord*   keySetPtr_p;          //# set of keywords
+    //# keywords not read yet (see class LazyTableRecord); the flag tells
+    //# if it is set and the mutex guards reading it
+    mutable std::shared_ptr<LazyTableRecord> lazyKeySet_p;
+    mutable std::atomic<Bool> hasLazyKeySet_p {False};
+    mutable std::mutex lazyMutex_p;
     Bool           isScalar_p;           //# True = column contains scalars
     Bool           isArray_p;            //# True = column contains arrays
     Bool           isTable_p;            //# True = column contains tables
@@ -277,6 +288,13 @@ protected:
     // Get the derived object.
     virtual void getDesc (AipsIO&) = 0;
 
+    // Read the keyword set which has not been read yet by getFile.
+    // It is guarded by a mutex, so concurrent keywordSet calls are fine.
+    void getLazyKeywordSet() const;
+
+    // Copy the keyword set (possibly not read yet) of that description.
+    void copyKeywordSet (const BaseColumnDesc& that);
+
     // Make a PlainColumn object out of the description.
     virtual PlainColumn* makeColumn (ColumnSet*) const = 0;
 
@@ -31,7 +31,8 @@
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 BaseColumn::BaseColumn (const BaseColumnDesc* cdp)
-: colDescPtr_p(cdp)
+: colDescPtr_p(cdp),
+  colDesc_p   (const_cast<BaseColumnDesc*>(cdp))
 {}
 
 BaseColumn::~BaseColumn()
@@ -93,6 +94,29 @@ Bool BaseColumn::canChangeShape() const
     return False;                      // can not be changed
 }
 
+Bool BaseColumn::isDictEncoded() const
+{
+    return False;
+}
+
+Int BaseColumn::getDictCode (rownr_t) const
+{
+  throw (TableInvOper ("getDictCode() not implemented for column " +
+                       colDescPtr_p->name()));
+}
+
+Int BaseColumn::findDictCode (const String&) const
+{
+  throw (TableInvOper ("findDictCode() not implemented for column " +
+                       colDescPtr_p->name()));
+}
+
+uInt64 BaseColumn::dictGeneration() const
+{
+  throw (TableInvOper ("dictGeneration() not implemented for column " +
+                       colDescPtr_p->name()));
+}
+
 void BaseColumn::get (rownr_t, void*) const
 {
   throw (TableInvOper ("get() not implemented for column " +
@@ -1052,7 +1076,6 @@ void BaseColumn::throwPutType (const String& type) const
 
 const ColumnDesc& BaseColumn::columnDesc() const
 {
-  colDesc_p = ColumnDesc(const_cast<BaseColumnDesc*>(colDescPtr_p));
   return colDesc_p;
 }
 
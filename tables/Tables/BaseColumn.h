@@ -149,6 +149,23 @@ public:
     // Default is no.
     virtual Bool canChangeShape() const;
 
+    // Ask the data manager if the column is a scalar String column stored
+    // with dictionary encoding.
+    // Default is no.
+    virtual Bool isDictEncoded() const;
+
+    // Get the dictionary code of the value in the given row.
+    // By default it throws an exception.
+    virtual Int getDictCode (rownr_t rownr) const;
+
+    // Get the dictionary code of the given value (-1 if not found).
+    // By default it throws an exception.
+    virtual Int findDictCode (const String& value) const;
+
+    // Get the generation of the dictionary (changed when values are added).
+    // By default it throws an exception.
+    virtual uInt64 dictGeneration() const;
+
     // Initialize the rows from startRow till endRow (inclusive)
     // with the default value defined in the column description.
     virtual void initialize (rownr_t startRownr, rownr_t endRownr) = 0;
@@ -316,7 +333,8 @@ protected:
 private:
     //# This ColumnDesc object is created to be able to return 
     //# a const ColumnDesc& by function columnDesc().
-    mutable ColumnDesc     colDesc_p;
+    //# It is set once, so columnDesc() can be used by multiple threads.
+    ColumnDesc             colDesc_p;
 };
 
 
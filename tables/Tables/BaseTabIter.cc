@@ -197,8 +197,7 @@ std::shared_ptr<BaseTable> BaseTableIterator::next()
     ++sortIterKeyIdxChangeIt_p;
 
     //# Adjust rownrs in case source table is already a RefTable.
-    Vector<rownr_t>& rownrs = aRefTable_p->rowStorage();
-    sortTab_p->adjustRownrs (aRefTable_p->nrow(), rownrs, False);
+    aRefTable_p->adjustToRoot (*sortTab_p);
     return aBaseTable_p;
 }
 
@@ -243,8 +242,7 @@ std::shared_ptr<BaseTable> BaseTableIterator::noCachedIterBoundariesNext()
       keyChangeAtLastNext_p=String();
     }
     //# Adjust rownrs in case source table is already a RefTable.
-    Vector<rownr_t>& rownrs = itp->rowStorage();
-    sortTab_p->adjustRownrs (itp->nrow(), rownrs, False);
+    itp->adjustToRoot (*sortTab_p);
     return baseTabPtr;
 }
 
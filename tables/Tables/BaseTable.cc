@@ -360,6 +360,12 @@ void BaseTable::writeEnd (AipsIO& ios)
 void BaseTable::setTableChanged()
 {}
 
+void BaseTable::publishCommits()
+{
+    throw (TableInvOper ("Table: cannot publish commits of table " + name_p +
+                         "; it is not a plain table"));
+}
+
 
 void BaseTable::markForDelete (Bool callback, const String& oldName)
 {
@@ -823,7 +829,7 @@ std::shared_ptr<BaseTable> BaseTable::select (const TableExprNode& node,
         }
       }
     }
-    adjustRownrs (resultTable->nrow(), resultTable->rowStorage(), False);
+    resultTable->adjustToRoot (*this);
     return resultBaseTab;
 }
 
@@ -863,6 +869,11 @@ std::shared_ptr<BaseTable> BaseTable::tabAnd (BaseTable* that)
       return this->shared_from_this();                    // that is root
     }
     //# There is no root table involved, so we have to deal with RefTables.
+    //# Use a bit mask if cheaper than sorting and merging the rownrs.
+    if (RefTable::useMask (this->nrow(), that->nrow(), root()->nrow(),
+                           this->rowOrder() && that->rowOrder())) {
+        return logicMask (RefTable::LogicAnd, that);
+    }
     //# Get both rownr arrays which are sorted if not in row order.
     Vector<rownr_t> r1 = this->logicRows();
     Vector<rownr_t> r2 = that->logicRows();
@@ -887,6 +898,11 @@ std::shared_ptr<BaseTable> BaseTable::tabOr (BaseTable* that)
         return root()->shared_from_this();
     }
     //# There is no root table involved, so we have to deal with RefTables.
+    //# Use a bit mask if cheaper than sorting and merging the rownrs.
+    if (RefTable::useMask (this->nrow(), that->nrow(), root()->nrow(),
+                           this->rowOrder() && that->rowOrder())) {
+        return logicMask (RefTable::LogicOr, that);
+    }
     //# Get both rownr arrays which are sorted if not in row order.
     Vector<rownr_t> r1 = this->logicRows();
     Vector<rownr_t> r2 = that->logicRows();
@@ -914,6 +930,11 @@ std::shared_ptr<BaseTable> BaseTable::tabSub (BaseTable* that)
 	return that->tabNot();
     }
     //# There is no root table involved, so we have to deal with RefTables.
+    //# Use a bit mask if cheaper than sorting and merging the rownrs.
+    if (RefTable::useMask (this->nrow(), that->nrow(), root()->nrow(),
+                           this->rowOrder() && that->rowOrder())) {
+        return logicMask (RefTable::LogicSub, that);
+    }
     //# Get both rownr arrays which are sorted if not in row order.
     Vector<rownr_t> r1 = this->logicRows();
     Vector<rownr_t> r2 = that->logicRows();
@@ -940,6 +961,11 @@ std::shared_ptr<BaseTable> BaseTable::tabXor (BaseTable* that)
 	return tabNot();
     }
     //# There is no root table involved, so we have to deal with RefTables.
+    //# Use a bit mask if cheaper than sorting and merging the rownrs.
+    if (RefTable::useMask (this->nrow(), that->nrow(), root()->nrow(),
+                           this->rowOrder() && that->rowOrder())) {
+        return logicMask (RefTable::LogicXor, that);
+    }
     //# Get both rownr arrays which are sorted if not in row order.
     Vector<rownr_t> r1 = this->logicRows();
     Vector<rownr_t> r2 = that->logicRows();
@@ -961,6 +987,10 @@ std::shared_ptr<BaseTable> BaseTable::tabNot()
 	return makeRefTable (True, 0);
     }
     //# There is no root table involved, so we have to deal with RefTables.
+    //# Use a bit mask if cheaper than sorting and negating the rownrs.
+    if (RefTable::useMask (nrow(), 0, root()->nrow(), rowOrder())) {
+        return logicMask (RefTable::LogicNot, 0);
+    }
     //# Get rownr array which is sorted if not in row order.
     Vector<rownr_t> r1 = this->logicRows();
     // Create RefTable which will be in row order.
@@ -980,13 +1010,29 @@ void BaseTable::logicCheck (BaseTable* that)
     }
 }
 
+//# Do the logical operation on the unsorted rownrs using a bit mask.
+std::shared_ptr<BaseTable> BaseTable::logicMask (int oper, BaseTable* that)
+{
+    // Create RefTable which will be in row order.
+    std::shared_ptr<BaseTable> baseTabPtr = makeRefTable (True, 0);
+    RefTable* rtp = dynamic_cast<RefTable*>(baseTabPtr.get());
+    DebugAssert (rtp, AipsError);
+    Vector<rownr_t> rows1 (rowNumbers());
+    Vector<rownr_t> rows2;
+    if (that) {
+        rows2.reference (that->rowNumbers());
+    }
+    rtp->refMask (RefTable::LogicOper(oper), rows1.size(), rows1.data(),
+                  rows2.size(), rows2.data(), root()->nrow());
+    return baseTabPtr;
+}
+
 //# Get the rownrs from the reference table.
-//# Note that rowStorage() throws an exception if it is not a RefTable.
 //# Sort them if not in row order.
 Vector<rownr_t> BaseTable::logicRows()
 {
     AlwaysAssert (!isNull(), AipsError);
-    Vector<rownr_t> rows (rowStorage());
+    Vector<rownr_t> rows (rowNumbers());
     if (rowOrder()) {
       return rows;
     }
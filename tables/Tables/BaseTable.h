@@ -166,6 +166,10 @@ public:
     // Resync the Table object with the table file.
     virtual void resync() = 0;
 
+    // Publish the commits of the table to readers not using read locks.
+    // By default it throws an exception.
+    virtual void publishCommits();
+
     // Get the modify counter.
     virtual uInt getModifyCounter() const = 0;
 
@@ -577,6 +581,11 @@ private:
     // used in the logical operation on the table.
     Vector<rownr_t> logicRows();
 
+    // Do the logical operation (a RefTable::LogicOper) on the tables
+    // using a bit mask of the root table rows, so the rownrs do not need
+    // to be sorted. <src>that</src> is not used (and can be 0) for LogicNot.
+    std::shared_ptr<BaseTable> logicMask (int oper, BaseTable* that);
+
     // Make an empty table description.
     // This is used if one asks for the description of a NullTable.
     // Creating an empty TableDesc in the NullTable takes too much time.
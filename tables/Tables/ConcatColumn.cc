@@ -28,6 +28,7 @@
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/IPosition.h>
 #include <casacore/casa/Utilities/GenSort.h>
+#include <algorithm>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -283,49 +284,69 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 				 ArrayBase& arr,
 				 AccessRowsFunc* accessFunc) const
   {
-    // The rows to access.
-    Vector<rownr_t> rows = rownrs.convert();
-    // We have one or more slices of rows.
-    // Try to access them also in a sliced way, because that is faster.
-    // First make resources.
-    // The row number mapping.
-    const ConcatRows& ccRows = refTabPtr_p->rows();
-    // The RefRows vector for the rownrs to be handled in an underlying table.
-    // Make it as large as needed to avoid resizes.
-    Vector<rownr_t> tabRowNrs(rows.nelements());
-    // The rows are handled by combining them as much as possible in a RefRows
-    // slice. This is possible until a different underlying table needs to
-    // be accessed.
-    // First setup the various loop variables.
+    // Split the rows into parts per underlying table.
+    std::vector<RowsPart> parts;
+    splitRows (rownrs, parts);
+    // No need to make an array section if a single table is accessed.
+    if (parts.size() == 1) {
+      accessFunc (refColPtr_p[parts[0].tableNr], parts[0].rows, ns, arr);
+      return;
+    }
     uInt rowAxis = arr.ndim() - 1;   // row axis in array
     IPosition st(arr.ndim(), 0);     // start of array part
     IPosition sz(arr.shape());       // size of array part
+    for (const RowsPart& part : parts) {
+      st[rowAxis] = part.start;
+      sz[rowAxis] = part.nrow;
+      std::unique_ptr<ArrayBase> section (arr.getSection (Slicer(st, sz)));
+      accessFunc (refColPtr_p[part.tableNr], part.rows, ns, *section);
+    }
+  }
+
+  void ConcatColumn::splitRows (const RefRows& rownrs,
+                                std::vector<RowsPart>& parts) const
+  {
+    const ConcatRows& ccRows = refTabPtr_p->rows();
+    Bool sliced = rownrs.isSliced();
+    // The row numbers (or slices) in the current underlying table.
+    std::vector<rownr_t> tabRows;
     Int lastTabNr = -1;
-    uInt tableNr;
-    // Step through all concat rownrs.
-    for (rownr_t i=0; i<rows.nelements(); ++i) {
-      // Map to the table and rownr in it.
-      ccRows.mapRownr (tableNr, tabRowNrs[i], rows[i]);
-      // An access has to be done if we have another table.
-      if (Int(tableNr) != lastTabNr) {
-	// Access the cells if not the first time.
-	if (lastTabNr >= 0) {
-	  rownr_t nrrow = i - st[rowAxis];
-	  sz[rowAxis] = nrrow;
-	  Vector<rownr_t> rowPart(tabRowNrs(Slice(st[rowAxis], nrrow))); 
-	  std::unique_ptr<ArrayBase> part (arr.getSection (Slicer(st, sz)));
-	  accessFunc (refColPtr_p[lastTabNr], RefRows(rowPart), ns, *part);
-	}
-        st[rowAxis] = i;
-        lastTabNr = tableNr;
+    rownr_t inx   = 0;          // index in the requested rows
+    rownr_t stInx = 0;          // index of the first row of the part
+    uInt    tableNr;
+    rownr_t tabRownr;
+    for (RefRowsSliceIter iter(rownrs); !iter.pastEnd(); iter++) {
+      rownr_t row  = iter.sliceStart();
+      rownr_t end  = iter.sliceEnd();
+      rownr_t incr = iter.sliceIncr();
+      // A slice can span multiple tables, so split it at table boundaries.
+      while (row <= end) {
+        ccRows.mapRownr (tableNr, tabRownr, row);
+        // Note that ccRows[i] is the offset of the next table.
+        rownr_t tabEnd = ccRows[tableNr] - 1;
+        rownr_t nr = (std::min(end, tabEnd) - row) / incr + 1;
+        if (Int(tableNr) != lastTabNr) {
+          if (lastTabNr >= 0) {
+            parts.push_back (RowsPart(lastTabNr, stInx, inx-stInx,
+                                      RefRows(Vector<rownr_t>(tabRows),
+                                              sliced)));
+            tabRows.clear();
+          }
+          stInx = inx;
+          lastTabNr = tableNr;
+        }
+        tabRows.push_back (tabRownr);
+        if (sliced) {
+          tabRows.push_back (tabRownr + (nr-1)*incr);
+          tabRows.push_back (incr);
+        }
+        inx += nr;
+        row += nr*incr;
       }
     }
     if (lastTabNr >= 0) {
-      rownr_t nrrow = rows.nelements() - st[rowAxis];
-      sz[rowAxis] = nrrow;
-      Vector<rownr_t> rowPart(tabRowNrs(Slice(st[rowAxis], nrrow))); 
-      CountedPtr<ArrayBase> part (arr.getSection (Slicer(st, sz)));
-      accessFunc (refColPtr_p[lastTabNr], RefRows(rowPart), ns, *part);
+      parts.push_back (RowsPart(lastTabNr, stInx, inx-stInx,
+                                RefRows(Vector<rownr_t>(tabRows), sliced)));
     }
   }
 
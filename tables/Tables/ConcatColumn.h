@@ -32,7 +32,9 @@
 #include <casacore/tables/Tables/BaseColumn.h>
 #include <casacore/tables/Tables/ColumnCache.h>
 #include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/casa/Arrays/ArrayFwd.h>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -68,6 +70,11 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
   // It calls the corresponding function in the referenced column
   // while converting the given row number to the row number in the
   // referenced table.
+  // <br>A get or put of multiple cells is split into parts, where each part
+  // is a run of consecutive requested rows residing in the same underlying
+  // table. Each part is forwarded as a single call to the underlying column,
+  // keeping the row slices intact. In this way a range of rows residing
+  // in a single table results in a single bulk access of that table.
   // </synopsis> 
 
   // <motivation>
@@ -261,6 +268,28 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     // </group>
 
   protected:
+    // A part of the requested rows residing in a single underlying table.
+    struct RowsPart
+    {
+      RowsPart (uInt tabNr, rownr_t st, rownr_t nr, const RefRows& r)
+        : tableNr(tabNr), start(st), nrow(nr), rows(r)
+      {}
+      // The underlying table.
+      uInt    tableNr;
+      // The index of the first row of the part in the requested rows.
+      rownr_t start;
+      // The number of rows in the part.
+      rownr_t nrow;
+      // The row numbers in the underlying table.
+      RefRows rows;
+    };
+
+    // Split the requested rows into parts, each part being a maximal run
+    // of consecutive requested rows in the same underlying table.
+    // The row numbers of a part are sliced if the requested rows are.
+    void splitRows (const RefRows& rownrs,
+                    std::vector<RowsPart>& parts) const;
+
     // Set the column cache to the cache of the given table.
     // The row numbers will be adjusted as needed.
     void setColumnCache (uInt tableNr, const ColumnCache&) const;
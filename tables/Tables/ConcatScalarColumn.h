@@ -90,6 +90,9 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
     virtual void getScalarColumn (ArrayBase& dataPtr) const;
 
     // Get the vector of some scalar values in a column.
+    // The rows are read with one call per part of consecutive rows in
+    // an underlying table, or with one call per table if the rows
+    // alternate between the tables.
     virtual void getScalarColumnCells (const RefRows& rownrs,
 				       ArrayBase& dataPtr) const;
 
@@ -117,6 +120,15 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 			      Int order);
     // </group>
 
+  private:
+    // Tell if the parts have to be gathered per table, because a table
+    // is used by multiple parts.
+    Bool useGather (const std::vector<RowsPart>& parts) const;
+
+    // Combine the row numbers of the parts residing in the given table.
+    // The buffer is sized to the total number of rows in those parts.
+    RefRows gatherRows (const std::vector<RowsPart>& parts, uInt tableNr,
+                        Vector<T>& buf) const;
   };
 
 } //# NAMESPACE CASACORE - END
@@ -30,7 +30,6 @@
 #include <casacore/tables/Tables/ConcatTable.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
 #include <casacore/casa/Arrays/Vector.h>
-#include <casacore/casa/Utilities/GenSort.h>
 
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
@@ -65,23 +64,33 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 						    ArrayBase& arr) const
   {
     Vector<T>& vec = static_cast<Vector<T>&>(arr);
-    // Get the rownrs as a vector and sort it.
-    // In this way the data will be read in sequential order.
-    Vector<rownr_t> rows = rownrs.convert();
-    Vector<rownr_t> inx;
-    GenSortIndirect<rownr_t,rownr_t>::sort (inx, rows);
-    const ConcatRows& ccRows = refTabPtr_p->rows();
-    rownr_t tabRownr;
-    uInt    tableNr=0;
-    // Map each row to rownr and tablenr.
-    // Note this is pretty fast because it is done in row order.
-    for (rownr_t i=0; i<inx.nelements(); ++i) {
-      rownr_t row = inx[i];
-      ccRows.mapRownr (tableNr, tabRownr, rows[row]);
-      refColPtr_p[tableNr]->get (tabRownr, &(vec[row]));
+    std::vector<RowsPart> parts;
+    splitRows (rownrs, parts);
+    if (! useGather (parts)) {
+      // Each table is accessed once, so get directly into the vector.
+      for (const RowsPart& part : parts) {
+        Vector<T> vecPart (vec(Slice(part.start, part.nrow)));
+        refColPtr_p[part.tableNr]->getScalarColumnCells (part.rows, vecPart);
+      }
+    } else {
+      // The rows alternate between tables. Get all rows of a table at
+      // once and copy the values to their location in the vector.
+      for (uInt tab=0; tab<refColPtr_p.nelements(); ++tab) {
+        Vector<T> buf;
+        RefRows rows = gatherRows (parts, tab, buf);
+        if (buf.size() > 0) {
+          refColPtr_p[tab]->getScalarColumnCells (rows, buf);
+          rownr_t inx = 0;
+          for (const RowsPart& part : parts) {
+            if (part.tableNr == tab) {
+              for (rownr_t i=0; i<part.nrow; ++i) {
+                vec[part.start + i] = buf[inx++];
+              }
+            }
+          }
+        }
+      }
     }
-    // Set the column cache to the last table used.
-    ///setColumnCache (tableNr, refColPtr_p[tableNr]->columnCache());
   }
 
   template<typename T>
@@ -104,25 +113,69 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 						    const ArrayBase& arr)
   {
     const Vector<T>& vec = static_cast<const Vector<T>&>(arr);
-    // Get the rownrs as a vector and sort it.
-    // In this way the data will be read in sequential order.
-    Vector<rownr_t> rows = rownrs.convert();
-    Vector<rownr_t> inx;
-    GenSortIndirect<rownr_t,rownr_t>::sort (inx, rows);
-    const ConcatRows& ccRows = refTabPtr_p->rows();
-    rownr_t tabRownr;
-    uInt    tableNr=0;
-    // Map each row to rownr and tablenr.
-    // Note this is pretty fast because it is done in row order.
-    for (rownr_t i=0; i<inx.nelements(); ++i) {
-      rownr_t row = inx[i];
-      ccRows.mapRownr (tableNr, tabRownr, rows[row]);
-      refColPtr_p[tableNr]->put (tabRownr, &(vec[row]));
+    std::vector<RowsPart> parts;
+    splitRows (rownrs, parts);
+    if (! useGather (parts)) {
+      for (const RowsPart& part : parts) {
+        refColPtr_p[part.tableNr]->putScalarColumnCells
+          (part.rows, vec(Slice(part.start, part.nrow)));
+      }
+    } else {
+      for (uInt tab=0; tab<refColPtr_p.nelements(); ++tab) {
+        Vector<T> buf;
+        RefRows rows = gatherRows (parts, tab, buf);
+        if (buf.size() > 0) {
+          rownr_t inx = 0;
+          for (const RowsPart& part : parts) {
+            if (part.tableNr == tab) {
+              for (rownr_t i=0; i<part.nrow; ++i) {
+                buf[inx++] = vec[part.start + i];
+              }
+            }
+          }
+          refColPtr_p[tab]->putScalarColumnCells (rows, buf);
+        }
+      }
     }
-    // Set the column cache to the last table used.
-    ///setColumnCache (tableNr, refColPtr_p[tableNr]->columnCache());
   }
 
+  template<typename T>
+  Bool ConcatScalarColumn<T>::useGather (const std::vector<RowsPart>& parts)
+    const
+  {
+    if (parts.size() > refColPtr_p.nelements()) {
+      return True;
+    }
+    std::vector<Bool> used (refColPtr_p.nelements(), False);
+    for (const RowsPart& part : parts) {
+      if (used[part.tableNr]) {
+        return True;
+      }
+      used[part.tableNr] = True;
+    }
+    return False;
+  }
+
+  template<typename T>
+  RefRows ConcatScalarColumn<T>::gatherRows (const std::vector<RowsPart>& parts,
+                                             uInt tableNr,
+                                             Vector<T>& buf) const
+  {
+    // Concatenate the row numbers (or slices) of the parts in the table.
+    std::vector<rownr_t> rows;
+    rownr_t nrow = 0;
+    Bool sliced = False;
+    for (const RowsPart& part : parts) {
+      if (part.tableNr == tableNr) {
+        const Vector<rownr_t>& partRows = part.rows.rowVector();
+        rows.insert (rows.end(), partRows.begin(), partRows.end());
+        nrow += part.nrow;
+        sliced = part.rows.isSliced();
+      }
+    }
+    buf.resize (nrow);
+    return RefRows (Vector<rownr_t>(rows), sliced);
+  }
 
   template<class T>
   void ConcatScalarColumn<T>::makeSortKey (Sort& sortobj,
@@ -0,0 +1,54 @@
+//# LazyTableRecord.cc: Deferred reading of a TableRecord from AipsIO
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+
+//# Includes
+#include <casacore/tables/Tables/LazyTableRecord.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/IO/MemoryIO.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+std::shared_ptr<LazyTableRecord> LazyTableRecord::read (AipsIO& ios,
+                                                        const TableAttr& attr)
+{
+    std::shared_ptr<LazyTableRecord> lazy (new LazyTableRecord(attr));
+    if (! ios.getRawObject (lazy->bytes_p)) {
+        lazy.reset();
+    }
+    return lazy;
+}
+
+void LazyTableRecord::get (TableRecord& rec) const
+{
+    std::shared_ptr<ByteIO> mio (new MemoryIO (bytes_p.storage(),
+                                               bytes_p.nelements()));
+    AipsIO ios (mio);
+    rec.getRecord (ios, attr_p);
+}
+
+} //# NAMESPACE CASACORE - END
@@ -0,0 +1,116 @@
+//# LazyTableRecord.h: Deferred reading of a TableRecord from AipsIO
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+
+#ifndef TABLES_LAZYTABLERECORD_H
+#define TABLES_LAZYTABLERECORD_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/TableAttr.h>
+#include <casacore/casa/Containers/Block.h>
+#include <memory>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class AipsIO;
+class TableRecord;
+
+
+// <summary>
+// Deferred reading of a TableRecord from AipsIO
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tLazyTableRecord">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> <linkto class=TableRecord>TableRecord</linkto>
+//   <li> <linkto class=AipsIO>AipsIO</linkto>
+// </prerequisite>
+
+// <synopsis>
+// Opening a table reads its description from the table.dat file. It
+// contains the keyword sets of the table and of all columns.
+// Interpreting those records can take a significant part of the open time
+// if there are many or large keyword sets, while an application opening
+// a table usually looks at only a few of them.
+// <br>A LazyTableRecord object keeps the raw bytes of such a record as
+// read from the AipsIO stream and interprets them only when the record is
+// needed. TableDesc and BaseColumnDesc use it to defer reading their
+// keyword sets until the first call of <src>keywordSet</src> or
+// <src>rwKeywordSet</src>. Because the object is never changed after
+// being read, copies of a description can share it.
+// <br>Note that the subtables in a keyword set are not affected; they are
+// opened on demand by class TableKeyword anyway.
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   std::shared_ptr<LazyTableRecord> lazy = LazyTableRecord::read (ios, attr);
+//   if (! lazy) {
+//     rec.getRecord (ios, attr);     // normal reading
+//   }
+//   ...
+//   if (lazy) {
+//     lazy->get (rec);               // read it when needed
+//   }
+// </srcblock>
+// </example>
+
+class LazyTableRecord
+{
+public:
+    // Read the raw bytes of the next record in the AipsIO stream.
+    // A null pointer is returned if that is not possible (e.g., if the
+    // stream is not seekable), in which case nothing has been read
+    // and the record has to be read in the normal way.
+    static std::shared_ptr<LazyTableRecord> read (AipsIO&, const TableAttr&);
+
+    // Interpret the bytes and read them into the given record,
+    // which must be empty or non-fixed.
+    void get (TableRecord&) const;
+
+    // Get the number of bytes kept.
+    uInt nbytes() const
+        { return bytes_p.nelements(); }
+
+private:
+    explicit LazyTableRecord (const TableAttr& attr)
+      : attr_p (attr)
+    {}
+
+    Block<uChar> bytes_p;
+    TableAttr    attr_p;
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -93,6 +93,30 @@ Bool PlainColumn::isWritable() const
 Bool PlainColumn::isStored() const
     { return dataManPtr_p->isStorageManager(); }
 
+Bool PlainColumn::isDictEncoded() const
+    { return dataColPtr_p->isDictEncoded(); }
+Int PlainColumn::getDictCode (rownr_t rownr) const
+{
+    checkReadLock (True);
+    Int code = dataColPtr_p->getDictCode (rownr);
+    autoReleaseLock();
+    return code;
+}
+Int PlainColumn::findDictCode (const String& value) const
+{
+    checkReadLock (True);
+    Int code = dataColPtr_p->findDictCode (value);
+    autoReleaseLock();
+    return code;
+}
+uInt64 PlainColumn::dictGeneration() const
+{
+    checkReadLock (True);
+    uInt64 generation = dataColPtr_p->dictGeneration();
+    autoReleaseLock();
+    return generation;
+}
+
 ColumnCache& PlainColumn::columnCache()
     { return dataColPtr_p->columnCache(); }
 
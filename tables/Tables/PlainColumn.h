@@ -95,6 +95,14 @@ public:
     // Test if the column is stored (otherwise it is virtual).
     virtual Bool isStored() const;
 
+    // Ask the data manager about dictionary encoding of the column.
+    // <group>
+    virtual Bool isDictEncoded() const;
+    virtual Int getDictCode (rownr_t rownr) const;
+    virtual Int findDictCode (const String& value) const;
+    virtual uInt64 dictGeneration() const;
+    // </group>
+
     // Get access to the column keyword set.
     // <group>
     TableRecord& rwKeywordSet();
@@ -32,6 +32,8 @@
 #include <casacore/tables/Tables/TableLockData.h>
 #include <casacore/tables/Tables/ColumnSet.h>
 #include <casacore/tables/Tables/TableTrace.h>
+#include <casacore/tables/Tables/TableSnapshot.h>
+#include <casacore/tables/Tables/TableCommit.h>
 #include <casacore/tables/Tables/PlainColumn.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Containers/Block.h>
@@ -75,6 +77,7 @@ void PlainTable::PlainTableCommon (SetupNewTable& newtab, rownr_t nrrow,
     tableChanged_p = True;
     addToCache_p   = True;
     lockPtr_p      = 0;
+    commit_p       = 0;
     tsmOption_p    = tsmOption;
     try {
     // Determine and set the endian option.
@@ -172,10 +175,17 @@ PlainTable::PlainTable (AipsIO&, uInt version, const String& tabname,
   tableChanged_p (False),
   addToCache_p   (addToCache),
   lockPtr_p      (0),
+  commit_p       (0),
   tsmOption_p    (tsmOption)
 {
     // Replace default TSM option for existing table.
     tsmOption_p.fillOption (False);
+    // Copy-on-write of snapshots only works for unbuffered access.
+    if (TableSnapshot::attach (name_p)  &&
+        tsmOption_p.option() != TSMOption::Direct) {
+      tsmOption_p = TSMOption (TSMOption::Cache, 0,
+                               tsmOption_p.maxCacheSizeMB());
+    }
     //# Set initially to no write in destructor.
     //# At the end it is reset. In this way nothing is written if
     //# an exception is thrown during initialization.
@@ -188,8 +198,19 @@ PlainTable::PlainTable (AipsIO&, uInt version, const String& tabname,
     lockPtr_p->makeLock (name_p, False,
 		   opt == Table::Old  ?  FileLocker::Read : FileLocker::Write,
 			 locknr);
+    //# If commits are published, a writer publishes its flushes and a
+    //# reader not using read locks gets the sync info of the last commit.
+    if ((opt != Table::Old  ||  !lockPtr_p->readLocking())  &&
+        TableCommit::exists (name_p)) {
+        commit_p = new TableCommit (name_p, opt != Table::Old);
+    }
     if (lockPtr_p->readLocking()) {
         lockPtr_p->acquire (&(lockSync_p.memoryIO()), FileLocker::Read, 0);
+    } else if (commit_p != 0) {
+        commit_p->read (lockSync_p.memoryIO());
+        if (lockSync_p.memoryIO().length() == 0) {
+            lockPtr_p->getInfo (lockSync_p.memoryIO());
+        }
     } else {
         lockPtr_p->getInfo (lockSync_p.memoryIO());
     }
@@ -278,6 +299,13 @@ PlainTable::PlainTable (AipsIO&, uInt version, const String& tabname,
     }
     //# Trace if needed.
     itsTraceId = TableTrace::traceTable (name_p, 'o');
+    //# Get the new commit if the writer committed while opening.
+    //# If it is flushing, the data manager headers might be inconsistent,
+    //# so resync postpones the synchronization to the next resync.
+    if (commit_p != 0  &&  !lockPtr_p->readLocking()  &&
+        (commit_p->changed()  ||  commit_p->inProgress())) {
+        resync();
+    }
 }
 
 
@@ -336,6 +364,7 @@ void PlainTable::closeObject()
     TableTrace::traceClose (name_p);
     //# Delete everything.
     delete lockPtr_p;
+    delete commit_p;
 }
 
 //# Read description and #rows.
@@ -361,6 +390,12 @@ void PlainTable::reopenRW()
     // Do this before reopening subtables, because that might cause
     // recursion (e.g. SORTED_TABLE in the MS).
     option_p = Table::Update;
+    // A writer has to publish the commits.
+    if (TableCommit::exists (name_p)) {
+        delete commit_p;
+        commit_p = 0;
+        commit_p = new TableCommit (name_p, True);
+    }
     // Reopen the storage managers and the subtables in all keyword sets.
     colSetPtr_p->reopenRW();
     keywordSet().reopenRW();
@@ -514,11 +549,74 @@ void PlainTable::flush (Bool fsync, Bool recursive)
     }
 }
 
+void PlainTable::flushAll()
+{
+    if (openedForWrite()) {
+        putFile (True);
+    }
+}
+
+void PlainTable::publishCommits()
+{
+    checkWritable ("publishCommits");
+    if (commit_p == 0) {
+        commit_p = new TableCommit (name_p, True, True);
+    }
+    // Publish the current state of the table as the first commit.
+    putFile (True);
+}
+
 void PlainTable::resync()
 {
     TableTrace::traceFile (itsTraceId, "resync");
-    Bool tableChanged = True;
+    if (! lockPtr_p->readLocking()) {
+        // Commits may have been published after the table was opened.
+        if (commit_p == 0  &&  TableCommit::exists (name_p)) {
+            commit_p = new TableCommit (name_p, isWritable());
+        }
+        if (commit_p != 0) {
+            resyncCommit();
+            return;
+        }
+    }
     lockPtr_p->getInfo (lockSync_p.memoryIO());
+    resyncInfo();
+}
+
+void PlainTable::resyncCommit()
+{
+    // Nothing to do if no new commit has been done.
+    if (! commit_p->changed()) {
+        return;
+    }
+    // Read the last commit and resync the data managers.
+    // The data manager headers are rewritten while the writer flushes,
+    // so postpone the resync until the flush is done (a later resync does
+    // it). Do it again if the writer committed meanwhile.
+    for (uInt i=0; i<100; ++i) {
+        if (commit_p->inProgress()) {
+            commit_p->invalidate();
+            return;
+        }
+        commit_p->read (lockSync_p.memoryIO());
+        try {
+            resyncInfo();
+        } catch (std::exception&) {
+            if (! (commit_p->inProgress()  ||  commit_p->changed())) {
+                throw;
+            }
+        }
+        if (! (commit_p->inProgress()  ||  commit_p->changed())) {
+            return;
+        }
+    }
+    throw TableError ("Table::resync could not get a stable commit of table "
+                      + tableName());
+}
+
+void PlainTable::resyncInfo()
+{
+    Bool tableChanged = True;
     // Older readonly table files may have empty locksync data.
     // Skip the sync-ing in that case.
     uInt ncolumn;
@@ -541,6 +639,15 @@ void PlainTable::resync()
 Bool PlainTable::putFile (Bool always)
 {
     TableTrace::traceFile (itsTraceId, "flush");
+    //# Commits might have been published by another process after this
+    //# table was opened. Tell readers using the commits that a flush is
+    //# in progress.
+    if (commit_p == 0  &&  TableCommit::exists (name_p)) {
+        commit_p = new TableCommit (name_p, True);
+    }
+    if (commit_p != 0) {
+        commit_p->begin();
+    }
     Bool writeTab = always || tableChanged_p;
     Bool written = writeTab;
     {  // use scope to ensure AipsIO is closed (thus flushed) before lockfile
@@ -573,6 +680,9 @@ Bool PlainTable::putFile (Bool always)
 			  colSetPtr_p->dataManChanged());
 	lockPtr_p->putInfo (lockSync_p.memoryIO());
     }
+    if (commit_p != 0) {
+        commit_p->end (lockSync_p.memoryIO());
+    }
     // Clear the change-flags for the next round.
     tableChanged_p = False;
     colSetPtr_p->dataManChanged() = False;
@@ -42,6 +42,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 class SetupNewTable;
 class TableLock;
 class TableLockData;
+class TableCommit;
 class ColumnSet;
 class IPosition;
 class AipsIO;
@@ -180,9 +181,20 @@ public:
     // unless it is executed due to an exception.
     virtual void flush (Bool fsync, Bool recursive);
 
+    // Flush the table and always write the table control information,
+    // so the table files fully represent the table (e.g. for a snapshot).
+    // Normally the number of rows is only kept in the lock file.
+    void flushAll();
+
     // Resync the Table object with the table file.
+    // If commits are published and no read locking is used, the table is
+    // synchronized with the last commit. Nothing is done if no new commit
+    // has been done since the previous resync or if the writer is flushing.
     virtual void resync();
 
+    // Publish the commits of the table (see class TableCommit).
+    virtual void publishCommits();
+
     // Get the modify counter.
     virtual uInt getModifyCounter() const;
 
@@ -290,6 +302,12 @@ private:
     // been written.
     Bool putFile (Bool always);
 
+    // Synchronize the table with the last published commit.
+    void resyncCommit();
+
+    // Synchronize the table with the sync info in lockSync_p.
+    void resyncInfo();
+
     // Synchronize the table after having acquired a lock which says
     // that main table data has changed.
     // It check if the columns did not change.
@@ -308,6 +326,7 @@ private:
     Bool           addToCache_p;       //# Is table added to cache?
     TableLockData* lockPtr_p;          //# pointer to lock object
     TableSyncData  lockSync_p;         //# table synchronization
+    TableCommit*   commit_p;           //# published commits (0 = none)
     Bool           bigEndian_p;        //# True  = big endian canonical
                                        //# False = little endian canonical
     TSMOption      tsmOption_p;
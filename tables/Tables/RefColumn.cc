@@ -93,6 +93,15 @@ Bool RefColumn::isDefined (rownr_t rownr) const
 Bool RefColumn::canChangeShape() const
     { return colPtr_p->canChangeShape(); }
 
+Bool RefColumn::isDictEncoded() const
+    { return colPtr_p->isDictEncoded(); }
+Int RefColumn::getDictCode (rownr_t rownr) const
+    { return colPtr_p->getDictCode (refTabPtr_p->rootRownr(rownr)); }
+Int RefColumn::findDictCode (const String& value) const
+    { return colPtr_p->findDictCode (value); }
+uInt64 RefColumn::dictGeneration() const
+    { return colPtr_p->dictGeneration(); }
+
 
 void RefColumn::get (rownr_t rownr, void* dataPtr) const
     { colPtr_p->get (refTabPtr_p->rootRownr(rownr), dataPtr); }
@@ -114,66 +123,66 @@ void RefColumn::putSlice (rownr_t rownr, const Slicer& ns, const ArrayBase& data
 
 void RefColumn::getScalarColumn (ArrayBase& data) const
 {
-    colPtr_p->getScalarColumnCells (refTabPtr_p->rowNumbers(), data);
+    colPtr_p->getScalarColumnCells (refTabPtr_p->rootRows(), data);
 }
 void RefColumn::getArrayColumn (ArrayBase& data) const
 {
-    colPtr_p->getArrayColumnCells (refTabPtr_p->rowNumbers(), data);
+    colPtr_p->getArrayColumnCells (refTabPtr_p->rootRows(), data);
 }
 void RefColumn::getColumnSlice (const Slicer& ns,
 				ArrayBase& data) const
 {
-    colPtr_p->getColumnSliceCells (refTabPtr_p->rowNumbers(), ns, data); 
+    colPtr_p->getColumnSliceCells (refTabPtr_p->rootRows(), ns, data); 
 }
 void RefColumn::getScalarColumnCells (const RefRows& rownrs,
 				      ArrayBase& data) const
 {
-    colPtr_p->getScalarColumnCells (rownrs.convert(refTabPtr_p->rowNumbers()),
+    colPtr_p->getScalarColumnCells (refTabPtr_p->rootRows(rownrs),
 				    data);
 }
 void RefColumn::getArrayColumnCells (const RefRows& rownrs,
 				     ArrayBase& data) const
 {
-    colPtr_p->getArrayColumnCells (rownrs.convert(refTabPtr_p->rowNumbers()),
+    colPtr_p->getArrayColumnCells (refTabPtr_p->rootRows(rownrs),
 				   data);
 }
 void RefColumn::getColumnSliceCells (const RefRows& rownrs,
 				     const Slicer& ns,
 				     ArrayBase& data) const
 {
-    colPtr_p->getColumnSliceCells (rownrs.convert(refTabPtr_p->rowNumbers()),
+    colPtr_p->getColumnSliceCells (refTabPtr_p->rootRows(rownrs),
 				   ns, data);
 }
 void RefColumn::putScalarColumn (const ArrayBase& data)
 {
-    colPtr_p->putScalarColumnCells (refTabPtr_p->rowNumbers(), data);
+    colPtr_p->putScalarColumnCells (refTabPtr_p->rootRows(), data);
 }
 void RefColumn::putArrayColumn (const ArrayBase& data)
 {
-    colPtr_p->putArrayColumnCells (refTabPtr_p->rowNumbers(), data);
+    colPtr_p->putArrayColumnCells (refTabPtr_p->rootRows(), data);
 }
 void RefColumn::putColumnSlice (const Slicer& ns,
 				const ArrayBase& data)
 {
-    colPtr_p->putColumnSliceCells (refTabPtr_p->rowNumbers(), ns, data); 
+    colPtr_p->putColumnSliceCells (refTabPtr_p->rootRows(), ns, data); 
 }
 void RefColumn::putScalarColumnCells (const RefRows& rownrs,
 				      const ArrayBase& data)
 {
-    colPtr_p->putScalarColumnCells (rownrs.convert(refTabPtr_p->rowNumbers()),
+    colPtr_p->putScalarColumnCells (refTabPtr_p->rootRows(rownrs),
 				    data);
 }
 void RefColumn::putArrayColumnCells (const RefRows& rownrs,
 				     const ArrayBase& data)
 {
-    colPtr_p->putArrayColumnCells (rownrs.convert(refTabPtr_p->rowNumbers()),
+    colPtr_p->putArrayColumnCells (refTabPtr_p->rootRows(rownrs),
 				   data);
 }
 void RefColumn::putColumnSliceCells (const RefRows& rownrs,
 				     const Slicer& ns,
 				     const ArrayBase& data)
 {
-    colPtr_p->putColumnSliceCells (rownrs.convert(refTabPtr_p->rowNumbers()),
+    colPtr_p->putColumnSliceCells (refTabPtr_p->rootRows(rownrs),
 				   ns, data);
 }
 
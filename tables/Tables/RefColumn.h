@@ -138,6 +138,14 @@ public:
     // It can change shape if the underlying column can.
     virtual Bool canChangeShape() const;
 
+    // It is dictionary encoded if the underlying column is.
+    // <group>
+    virtual Bool isDictEncoded() const;
+    virtual Int getDictCode (rownr_t rownr) const;
+    virtual Int findDictCode (const String& value) const;
+    virtual uInt64 dictGeneration() const;
+    // </group>
+
     // Initialize the rows from startRownr till endRownr (inclusive)
     // with the default value defined in the column description (if defined).
     void initialize (rownr_t startRownr, rownr_t endRownr);
@@ -25,6 +25,7 @@
 
 #include <casacore/tables/Tables/RefTable.h>
 #include <casacore/tables/Tables/RefColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/TableDesc.h>
 #include <casacore/tables/Tables/TableLock.h>
@@ -36,10 +37,15 @@
 #include <casacore/casa/IO/ArrayIO.h>
 #include <casacore/casa/Utilities/Copy.h>
 #include <casacore/casa/OS/Path.h>
+#include <casacore/casa/System/AipsrcValue.h>
 #include <casacore/casa/BasicMath/Math.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/BasicSL/STLIO.h>
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -47,6 +53,8 @@ RefTable::RefTable (AipsIO& ios, const String& name, rownr_t nrrow, int opt,
 		    const TableLock& lockOptions, const TSMOption& tsmOption)
 : BaseTable    (name, opt, nrrow),
   rowStorage_p (0),              // initially empty vector of rownrs
+  useRuns_p    (False),
+  lastRun_p    (0),
   changed_p    (False)
 {
     //# Read the file in.
@@ -65,6 +73,8 @@ RefTable::RefTable (BaseTable* btp, Bool order, rownr_t nrall)
   baseTabPtr_p (btp->root()->shared_from_this()),
   rowOrd_p     (order),
   rowStorage_p (nrall),       // allocate vector of rownrs
+  useRuns_p    (nrall == 0),  // use runs if filled by addRownr
+  lastRun_p    (0),
   changed_p    (True)
 {
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
@@ -80,23 +90,26 @@ RefTable::RefTable (BaseTable* btp, const Vector<rownr_t>& rownrs)
   baseTabPtr_p (btp->root()->shared_from_this()),
   rowOrd_p     (True),
   rowStorage_p (0),
+  useRuns_p    (True),
+  lastRun_p    (0),
   changed_p    (True)
 {
     //# Copy the table description and create the columns.
     tdescPtr_p = new TableDesc (btp->tableDesc(), TableDesc::Scratch);
     setup (btp, Vector<String>());
-    rowStorage_p = rownrs;
-    AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
-    const rownr_t* rows = rowStorage_p.data();
     //# Check if the row numbers do not exceed #rows.
+    //# Add them, so they are kept as runs if possible.
     rownr_t nmax = btp->nrow();
-    for (rownr_t i=0; i<nrrow_p; i++) {
-	if (rows[i] >= nmax) {
-            throw (indexError<rownr_t> (rows[i], "RefTable Row vector"));
+    rownr_t nr = rownrs.nelements();
+    nrrow_p = 0;
+    for (rownr_t i=0; i<nr; i++) {
+	if (rownrs[i] >= nmax) {
+            throw (indexError<rownr_t> (rownrs[i], "RefTable Row vector"));
 	}
+        addRownr (rownrs[i]);
     }
     //# Adjust rownrs in case input table is a reference table.
-    rowOrd_p = btp->adjustRownrs (nrrow_p, rowStorage_p, True);
+    rowOrd_p = adjustToRoot (*btp);
     TableTrace::traceRefTable (baseTabPtr_p->tableName(), 's');
 }
 
@@ -105,6 +118,8 @@ RefTable::RefTable (BaseTable* btp, const Vector<Bool>& mask)
   baseTabPtr_p (btp->root()->shared_from_this()),
   rowOrd_p     (btp->rowOrder()),
   rowStorage_p (0),              // initially empty vector of rownrs
+  useRuns_p    (True),
+  lastRun_p    (0),
   changed_p    (True)
 {
     //# Copy the table description and create the columns.
@@ -118,7 +133,7 @@ RefTable::RefTable (BaseTable* btp, const Vector<Bool>& mask)
 	}
     }
     //# Adjust rownrs in case input table is a reference table.
-    rowOrd_p = btp->adjustRownrs (nrrow_p, rowStorage_p, True);
+    rowOrd_p = adjustToRoot (*btp);
     TableTrace::traceRefTable (baseTabPtr_p->tableName(), 's');
 }
 
@@ -127,6 +142,8 @@ RefTable::RefTable (BaseTable* btp, const Vector<String>& columnNames)
   baseTabPtr_p (btp->root()->shared_from_this()),
   rowOrd_p     (btp->rowOrder()),
   rowStorage_p (0),
+  useRuns_p    (True),
+  lastRun_p    (0),
   changed_p    (True)
 {
     //# Create table description by copying the selected columns.
@@ -138,10 +155,17 @@ RefTable::RefTable (BaseTable* btp, const Vector<String>& columnNames)
 	tdescPtr_p->addColumn (td.columnDesc (columnNames(i)));
     }
     setup (btp, columnNames);
-    //# Get the row numbers from the input table.
-    //# Copy them to this table.
-    rowStorage_p = btp->rowNumbers();
-    AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
+    //# Copy the row numbers of the input table.
+    //# All rows of a root table form a single run.
+    const RefTable* rtp = dynamic_cast<const RefTable*>(btp);
+    if (rtp) {
+        rowStorage_p = rtp->rowStorage_p;
+        runs_p       = rtp->runs_p;
+        useRuns_p    = rtp->useRuns_p;
+    } else {
+        nrrow_p = 0;
+        addRun (runs_p, nrrow_p, 0, btp->nrow(), 1);
+    }
     TableTrace::traceRefTable (baseTabPtr_p->tableName(), 'p');
 }
 
@@ -245,11 +269,10 @@ Bool RefTable::adjustRownrs (rownr_t nr, Vector<rownr_t>& rowStorage,
     AlwaysAssert (nr <= rowStorage.size(), AipsError);
     rowStorage.resize (nr, True);
     AlwaysAssert (rowStorage.contiguousStorage(), AipsError);
-    const rownr_t* rows = rowStorage_p.data();
     rownr_t* rownrs = rowStorage.data();
     Bool rowOrder = True;
     for (rownr_t i=0; i<nr; i++) {
-	rownrs[i] = rows[rownrs[i]];
+	rownrs[i] = rootRownr (rownrs[i]);
     }
     if (determineOrder) {
 	for (rownr_t i=1; i<nr; i++) {
@@ -270,12 +293,24 @@ void RefTable::writeRefTable (Bool)
     //# Do this only when something has changed.
     if (changed_p) {
         TableTrace::traceRefTable (baseTabPtr_p->tableName(), 'w');
-        // Write old version if all row numbers fit in 32 bits.
+        // Write the row numbers as slices (in version 4) if that saves
+        // at least half of the space. It can be switched off in the aipsrc
+        // file, because older casacore versions cannot read version 4.
+        static uInt compactReg = AipsrcValue<Bool>::registerRC
+                                  ("table.reftable.compactrows", True);
         Int version = 3;
-        if (nrrow_p < std::numeric_limits<uInt>::max()  &&
-            baseTabPtr_p->nrow() < std::numeric_limits<uInt>::max()  &&
-            allLT (rowStorage_p, rownr_t(std::numeric_limits<uInt>::max()))) {
-          version = 2;
+        Vector<rownr_t> rownrs;
+        if (AipsrcValue<Bool>::get(compactReg)  &&  rootRows().isSliced()  &&
+            rootRows().rowVector().size() <= nrrow_p/2) {
+          version = 4;
+        } else {
+          rownrs.reference (rowNumbers());
+          if (nrrow_p < std::numeric_limits<uInt>::max()  &&
+              baseTabPtr_p->nrow() < std::numeric_limits<uInt>::max()  &&
+              allLT (rownrs, rownr_t(std::numeric_limits<uInt>::max()))) {
+            // Write old version if all row numbers fit in 32 bits.
+            version = 2;
+          }
         }
 	AipsIO ios;
 	writeStart (ios, True);
@@ -300,22 +335,27 @@ void RefTable::writeRefTable (Bool)
           ios << rowOrd_p;
           ios << nrrow_p;
         }
-        // Do not write more than 2**20 rownrs at once (CAS-7020).
-        Vector<uInt> rows32;
-        if (version == 2) {
-          rows32.resize (nrrow_p);
-          convertArray (rows32, rowStorage_p(Slice(0, nrrow_p)));
-        }
-        const uInt* rows32p = rows32.data();
-        rownr_t done = 0;
-        while (done < nrrow_p) {
-          rownr_t todo = std::min(nrrow_p-done, rownr_t(1048576));
+        if (version == 4) {
+          // Write the start,end,incr triplets of the slices.
+          ios << rootRows().rowVector();
+        } else {
+          // Do not write more than 2**20 rownrs at once (CAS-7020).
+          Vector<uInt> rows32;
           if (version == 2) {
-            ios.put (todo, rows32p+done, False);
-          } else {
-            ios.put (todo, rowStorage_p.data()+done, False);
+            rows32.resize (nrrow_p);
+            convertArray (rows32, rownrs);
+          }
+          const uInt* rows32p = rows32.data();
+          rownr_t done = 0;
+          while (done < nrrow_p) {
+            rownr_t todo = std::min(nrrow_p-done, rownr_t(1048576));
+            if (version == 2) {
+              ios.put (todo, rows32p+done, False);
+            } else {
+              ios.put (todo, rownrs.data()+done, False);
+            }
+            done += todo;
           }
-          done += todo;
         }
 	ios.putend();
 	writeEnd (ios);
@@ -333,7 +373,7 @@ void RefTable::getRef (AipsIO& ios, int opt, const TableLock& lockOptions,
     String rootName;
     rownr_t rootNrow, nrrow;
     Int version = ios.getstart ("RefTable");
-    if (version > 3) {
+    if (version > 4) {
       throw TableError ("RefTable version " + String::toString(version) +
                         " not supported by this version of Cassacore");
     }
@@ -353,27 +393,49 @@ void RefTable::getRef (AipsIO& ios, int opt, const TableLock& lockOptions,
       nrrow = n2;
     }
     DebugAssert (nrrow == nrrow_p, AipsError);
-    //# Resize the block of rownrs and read them in.
-    rowStorage_p.resize (nrrow);
-    AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
-    rownr_t* rows = rowStorage_p.data();
     rownr_t done = 0;
-    // Do not read more than 2**20 rows at once (CAS-7020).
-    if (version > 2) {
-      while (done < nrrow) {
-        rownr_t todo = std::min(nrrow_p-done, rownr_t(1048576));
-        ios.get (todo, rows+done);
-        done += todo;
+    if (version > 3) {
+      // The row numbers are stored as slices (start,end,incr),
+      // which are kept as runs.
+      Vector<rownr_t> slices;
+      ios >> slices;
+      AlwaysAssert (slices.size() % 3 == 0, AipsError);
+      runs_p.clear();
+      for (size_t i=0; i<slices.size(); i+=3) {
+        AlwaysAssert (slices[i] <= slices[i+1]  &&  slices[i+2] > 0,
+                      AipsError);
+        addRun (runs_p, done, slices[i],
+                (slices[i+1] - slices[i]) / slices[i+2] + 1, slices[i+2]);
+      }
+      AlwaysAssert (done == nrrow, AipsError);
+      useRuns_p = True;
+      if (tooManyRuns (runs_p.size(), nrrow)) {
+        expandRows();
       }
     } else {
-      Vector<uInt> rows(nrrow);
-      uInt* p = rows.data();
-      while (done < nrrow) {
-        rownr_t todo = std::min(nrrow_p-done, rownr_t(1048576));
-        ios.get (todo, p+done);
-        done += todo;
+      //# Resize the block of rownrs and read them in.
+      //# Do not read more than 2**20 rows at once (CAS-7020).
+      useRuns_p = False;
+      rowStorage_p.resize (nrrow);
+      AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
+      if (version > 2) {
+        rownr_t* rows = rowStorage_p.data();
+        while (done < nrrow) {
+          rownr_t todo = std::min(nrrow_p-done, rownr_t(1048576));
+          ios.get (todo, rows+done);
+          done += todo;
+        }
+      } else {
+        Vector<uInt> rows(nrrow);
+        uInt* p = rows.data();
+        while (done < nrrow) {
+          rownr_t todo = std::min(nrrow_p-done, rownr_t(1048576));
+          ios.get (todo, p+done);
+          done += todo;
+        }
+        convertArray (rowStorage_p, rows);
       }
-      convertArray (rowStorage_p, rows);
+      compactRows();
     }
     ios.getend();
     //# Now read in the root table referenced to.
@@ -524,6 +586,15 @@ void RefTable::addRefCol (const TableDesc& tdesc)
 //# Add a row number of the root table.
 void RefTable::addRownr (rownr_t rnr)
 {
+    if (useRuns_p) {
+        addRun (runs_p, nrrow_p, rnr, 1, 1);
+        if (tooManyRuns (runs_p.size(), nrrow_p)) {
+            expandRows();
+        }
+        changed_p = True;
+        rootRows_p.reset();
+        return;
+    }
     rownr_t nrow = rowStorage_p.nelements();
     if (nrrow_p >= nrow) {
         nrow = max ( nrow + 1024, rownr_t(1.2f * nrow));
@@ -532,11 +603,21 @@ void RefTable::addRownr (rownr_t rnr)
     }
     rowStorage_p[nrrow_p++] = rnr;
     changed_p = True;
+    rootRows_p.reset();
 }
 
 //# Add a row number range of the root table.
 void RefTable::addRownrRange (rownr_t startRownr, rownr_t endRownr)
 {
+    if (useRuns_p) {
+        addRun (runs_p, nrrow_p, startRownr, endRownr - startRownr + 1, 1);
+        if (tooManyRuns (runs_p.size(), nrrow_p)) {
+            expandRows();
+        }
+        changed_p = True;
+        rootRows_p.reset();
+        return;
+    }
     rownr_t nrow = rowStorage_p.nelements();
     rownr_t new_nrrow_p = nrrow_p + endRownr - startRownr + 1;
     if (new_nrrow_p > nrow) {
@@ -548,6 +629,7 @@ void RefTable::addRownrRange (rownr_t startRownr, rownr_t endRownr)
     std::iota(rows + nrrow_p, rows + new_nrrow_p, startRownr);
     nrrow_p = new_nrrow_p;
     changed_p = True;
+    rootRows_p.reset();
 }
 
 //# Set exact number of rows.
@@ -556,9 +638,14 @@ void RefTable::setNrrow (rownr_t nrrow)
     if (nrrow > nrrow_p) {
 	throw (TableError ("RefTable::setNrrow: exceeds current nrrow"));
     }
-    AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
+    if (useRuns_p) {
+        while (!runs_p.empty()  &&  runs_p.back().first >= nrrow) {
+            runs_p.pop_back();
+        }
+    }
     nrrow_p = nrrow;
     changed_p = True;
+    rootRows_p.reset();
 }
 
 
@@ -709,19 +796,190 @@ BaseColumn* RefTable::getColumn (uInt columnIndex) const
     
 
 Vector<rownr_t>& RefTable::rowStorage()
-    { return rowStorage_p; }
+{
+    expandRows();
+    rootRows_p.reset();
+    return rowStorage_p;
+}
+
+Bool RefTable::adjustToRoot (const BaseTable& table)
+{
+    const RefTable* rtp = dynamic_cast<const RefTable*>(&table);
+    if (rtp == 0) {
+        return True;            // no RefTable, so rownrs are in the root
+    }
+    if (! useRuns_p) {
+        Bool rowOrder = rtp->adjustRownrs (nrrow_p, rowStorage_p, True);
+        compactRows();
+        rootRows_p.reset();
+        return rowOrder;
+    }
+    // Add the converted row numbers of the runs to new runs.
+    std::vector<RowRun> runs;
+    runs.swap (runs_p);
+    rownr_t nrrow = nrrow_p;
+    nrrow_p = 0;
+    Bool rowOrder = True;
+    rownr_t last = 0;
+    for (size_t i=0; i<runs.size(); i++) {
+        rownr_t nr = (i+1 < runs.size()  ?  runs[i+1].first : nrrow) -
+                     runs[i].first;
+        for (rownr_t j=0; j<nr; j++) {
+            rownr_t rownr = rtp->rootRownr (runs[i].start + j*runs[i].incr);
+            if (nrrow_p > 0  &&  rownr <= last) {
+                rowOrder = False;
+            }
+            last = rownr;
+            addRownr (rownr);
+        }
+    }
+    return rowOrder;
+}
 
 //# Convert a vector of row numbers to row numbers in this table.
 Vector<rownr_t> RefTable::rootRownr (const Vector<rownr_t>& rownrs) const
 {
-    const rownr_t* rows = rowStorage_p.data();
     rownr_t nrow = rownrs.nelements();
     Vector<rownr_t> rnr(nrow);
     for (rownr_t i=0; i<nrow; i++) {
-	rnr(i) = rows[rownrs(i)];
+	rnr(i) = rootRownr (rownrs(i));
     }
     return rnr;
 }
+
+size_t RefTable::runIndex (rownr_t rownr) const
+{
+    // Rows are mostly accessed in order, so first try the run used last
+    // and the next one before doing a binary search.
+    size_t nruns = runs_p.size();
+    size_t inx = lastRun_p.load (std::memory_order_relaxed);
+    if (inx < nruns  &&  rownr >= runs_p[inx].first) {
+        if (inx+1 == nruns  ||  rownr < runs_p[inx+1].first) {
+            return inx;
+        }
+        inx++;
+        if (inx+1 == nruns  ||  rownr < runs_p[inx+1].first) {
+            lastRun_p.store (inx, std::memory_order_relaxed);
+            return inx;
+        }
+    }
+    // Find the last run starting at or before the row.
+    // Note that the first run starts at row 0.
+    size_t st  = 0;
+    size_t end = nruns;
+    while (end - st > 1) {
+        size_t mid = (st + end) / 2;
+        if (runs_p[mid].first <= rownr) {
+            st = mid;
+        } else {
+            end = mid;
+        }
+    }
+    lastRun_p.store (st, std::memory_order_relaxed);
+    return st;
+}
+
+rownr_t RefTable::runRownr (rownr_t rownr) const
+{
+    const RowRun& run = runs_p[runIndex(rownr)];
+    return run.start + (rownr - run.first) * run.incr;
+}
+
+// Runs take 3 values each, so they are used if that is at most half of
+// the row numbers. A few runs are always fine.
+Bool RefTable::tooManyRuns (size_t nruns, rownr_t nrow)
+{
+    return nruns > 64  &&  nruns > nrow/6;
+}
+
+void RefTable::addRun (std::vector<RowRun>& runs, rownr_t& nrrow,
+                       rownr_t start, rownr_t nrow, rownr_t incr)
+{
+    if (nrow == 0) {
+        return;
+    }
+    if (nrow == 1) {
+        incr = 1;
+    }
+    // Extend the last run if possible. A run with a single row can be
+    // extended with any (positive) increment.
+    if (! runs.empty()) {
+        RowRun& last = runs.back();
+        rownr_t nlast = nrrow - last.first;
+        if (nlast == 1) {
+            if (start > last.start  &&
+                (nrow == 1  ||  start - last.start == incr)) {
+                last.incr = start - last.start;
+                nrrow += nrow;
+                return;
+            }
+        } else if (start == last.start + nlast*last.incr  &&
+                   (nrow == 1  ||  incr == last.incr)) {
+            nrrow += nrow;
+            return;
+        }
+    }
+    RowRun run = {nrrow, start, incr};
+    runs.push_back (run);
+    nrrow += nrow;
+}
+
+Bool RefTable::makeRuns (std::vector<RowRun>& runs,
+                         const rownr_t* rows, rownr_t nrow)
+{
+    rownr_t nr = 0;
+    for (rownr_t i=0; i<nrow; i++) {
+        addRun (runs, nr, rows[i], 1, 1);
+        if (tooManyRuns (runs.size(), nrow)) {
+            return False;
+        }
+    }
+    return True;
+}
+
+RefRows RefTable::runsToRows (const std::vector<RowRun>& runs, rownr_t nrow)
+{
+    Vector<rownr_t> slices(3*runs.size());
+    for (size_t i=0; i<runs.size(); i++) {
+        rownr_t nr = (i+1 < runs.size()  ?  runs[i+1].first : nrow) -
+                     runs[i].first;
+        slices[3*i]   = runs[i].start;
+        slices[3*i+1] = runs[i].start + (nr-1) * runs[i].incr;
+        slices[3*i+2] = runs[i].incr;
+    }
+    return RefRows (slices, True);
+}
+
+void RefTable::expandRows()
+{
+    if (useRuns_p) {
+        Vector<rownr_t> rows(nrrow_p);
+        rownr_t* data = rows.data();
+        for (size_t i=0; i<runs_p.size(); i++) {
+            rownr_t nr = (i+1 < runs_p.size()  ?  runs_p[i+1].first : nrrow_p)
+                         - runs_p[i].first;
+            for (rownr_t j=0; j<nr; j++) {
+                *data++ = runs_p[i].start + j*runs_p[i].incr;
+            }
+        }
+        rowStorage_p.reference (rows);
+        std::vector<RowRun>().swap (runs_p);
+        useRuns_p = False;
+    }
+}
+
+void RefTable::compactRows()
+{
+    if (! useRuns_p) {
+        std::vector<RowRun> runs;
+        if (makeRuns (runs, rowStorage_p.data(), nrrow_p)) {
+            runs_p.swap (runs);
+            rowStorage_p.resize (0);
+            useRuns_p = True;
+            lastRun_p = 0;
+        }
+    }
+}
 	
 
 BaseTable* RefTable::root()
@@ -731,6 +989,13 @@ Bool RefTable::rowOrder() const
 
 Vector<rownr_t> RefTable::rowNumbers() const
 {
+    if (useRuns_p) {
+        Vector<rownr_t> vec(nrrow_p);
+        for (rownr_t i=0; i<nrrow_p; i++) {
+            vec[i] = runRownr (i);
+        }
+        return vec;
+    }
     if (nrrow_p == rowStorage_p.nelements()) {
 	return rowStorage_p;
     }
@@ -738,6 +1003,59 @@ Vector<rownr_t> RefTable::rowNumbers() const
     return vec(Slice(0, nrrow_p));
 }
 
+RefRows RefTable::rootRows() const
+{
+    if (! rootRows_p) {
+        if (useRuns_p) {
+            rootRows_p.reset (new RefRows (runsToRows (runs_p, nrrow_p)));
+        } else {
+            // Use slices only if they take little memory.
+            std::vector<RowRun> runs;
+            if (makeRuns (runs, rowStorage_p.data(), nrrow_p)) {
+                rootRows_p.reset (new RefRows (runsToRows (runs, nrrow_p)));
+            } else {
+                rootRows_p.reset (new RefRows (rowNumbers()));
+            }
+        }
+    }
+    return *rootRows_p;
+}
+
+RefRows RefTable::rootRows (const RefRows& rownrs) const
+{
+    std::vector<RowRun> runs;
+    rownr_t nrow = 0;
+    if (useRuns_p) {
+        // Convert each slice by mapping its parts in the runs.
+        RefRowsSliceIter iter(rownrs);
+        while (! iter.pastEnd()) {
+            rownr_t rownr = iter.sliceStart();
+            rownr_t incr  = iter.sliceIncr();
+            while (rownr <= iter.sliceEnd()) {
+                size_t inx = runIndex (rownr);
+                const RowRun& run = runs_p[inx];
+                rownr_t start = run.start + (rownr - run.first) * run.incr;
+                rownr_t runEnd = (inx+1 < runs_p.size()  ?
+                                  runs_p[inx+1].first : nrrow_p) - 1;
+                rownr_t nr = (std::min(iter.sliceEnd(), runEnd) - rownr)
+                             / incr + 1;
+                addRun (runs, nrow, start, nr, incr*run.incr);
+                rownr += nr*incr;
+            }
+            if (tooManyRuns (runs.size(), rownrs.nrows())) {
+                return RefRows (rootRownr (rownrs.convert()));
+            }
+            iter++;
+        }
+        return runsToRows (runs, nrow);
+    }
+    RowNumbers rows (rownrs.convert (rowStorage_p));
+    if (makeRuns (runs, rows.data(), rows.size())) {
+        return runsToRows (runs, rows.size());
+    }
+    return RefRows (rows);
+}
+
 
 Bool RefTable::checkAddColumn (const String& name, Bool addToParent)
 {
@@ -817,18 +1135,50 @@ void RefTable::removeRow (rownr_t rownr)
     if (rownr >= nrrow_p) {
 	throw (TableInvOper ("removeRow: rownr out of bounds"));
     }
-    rownr_t* rows = rowStorage_p.data();
-    if (rownr < nrrow_p - 1) {
-	objmove (rows+rownr, rows+rownr+1, nrrow_p-rownr-1);
+    if (useRuns_p) {
+        size_t inx = runIndex (rownr);
+        RowRun& run = runs_p[inx];
+        rownr_t nr = (inx+1 < runs_p.size()  ?  runs_p[inx+1].first : nrrow_p)
+                     - run.first;
+        rownr_t pos = rownr - run.first;
+        // The runs after the one containing the row start one row earlier.
+        size_t shift = inx+1;
+        if (nr == 1) {
+            runs_p.erase (runs_p.begin() + inx);
+            shift = inx;
+        } else if (pos == 0) {
+            run.start += run.incr;
+        } else if (pos < nr-1) {
+            // Split the run; the second part starts after the removed row.
+            RowRun second = {rownr+1, run.start + (pos+1)*run.incr, run.incr};
+            runs_p.insert (runs_p.begin() + inx + 1, second);
+        }
+        for (size_t i=shift; i<runs_p.size(); i++) {
+            runs_p[i].first--;
+        }
+        nrrow_p--;
+        if (tooManyRuns (runs_p.size(), nrrow_p)) {
+            expandRows();
+        }
+    } else {
+        rownr_t* rows = rowStorage_p.data();
+        if (rownr < nrrow_p - 1) {
+            objmove (rows+rownr, rows+rownr+1, nrrow_p-rownr-1);
+        }
+        nrrow_p--;
     }
-    nrrow_p--;
     changed_p = True;
+    rootRows_p.reset();
 }
 
 void RefTable::removeAllRow ()
 {
     nrrow_p=0;
+    runs_p.clear();
+    rowStorage_p.resize (0);
+    useRuns_p = True;
     changed_p = True;
+    rootRows_p.reset();
 }
 
 void RefTable::removeColumn (const Vector<String>& columnNames)
@@ -879,6 +1229,7 @@ void RefTable::refAnd (rownr_t nr1, const rownr_t* inx1,
 		       rownr_t nr2, const rownr_t* inx2)
 {
     rownr_t allrow = (nr1 < nr2  ?  nr1 : nr2);  // max #output rows
+    expandRows();
     rowStorage_p.resize (allrow);             // allocate output storage
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
     rownr_t* rows = rowStorage_p.data();
@@ -908,7 +1259,9 @@ void RefTable::refAnd (rownr_t nr1, const rownr_t* inx1,
 	    }
 	}
     }
+    compactRows();
     changed_p = True;
+    rootRows_p.reset();
 }
 
 // Or 2 index arrays, which are both in ascending order.
@@ -916,6 +1269,7 @@ void RefTable::refOr (rownr_t nr1, const rownr_t* inx1,
 		      rownr_t nr2, const rownr_t* inx2)
 {
     rownr_t allrow = nr1 + nr2;                  // max #output rows
+    expandRows();
     rowStorage_p.resize (allrow);             // allocate output storage
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
     rownr_t* rows = rowStorage_p.data();
@@ -947,7 +1301,9 @@ void RefTable::refOr (rownr_t nr1, const rownr_t* inx1,
 	    }
 	}
     }
+    compactRows();
     changed_p = True;
+    rootRows_p.reset();
 }
 
 // Subtract 2 index arrays, which are both in ascending order.
@@ -955,6 +1311,7 @@ void RefTable::refSub (rownr_t nr1, const rownr_t* inx1,
 		       rownr_t nr2, const rownr_t* inx2)
 {
     rownr_t allrow = nr1;                        // max #output rows
+    expandRows();
     rowStorage_p.resize (allrow);             // allocate output storage
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
     rownr_t* rows = rowStorage_p.data();
@@ -984,7 +1341,9 @@ void RefTable::refSub (rownr_t nr1, const rownr_t* inx1,
 	    }
 	}
     }
+    compactRows();
     changed_p = True;
+    rootRows_p.reset();
 }
 
 // Xor 2 index arrays, which are both in ascending order.
@@ -992,6 +1351,7 @@ void RefTable::refXor (rownr_t nr1, const rownr_t* inx1,
 		       rownr_t nr2, const rownr_t* inx2)
 {
     rownr_t allrow = nr1 + nr2;                  // max #output rows
+    expandRows();
     rowStorage_p.resize (allrow);             // allocate output storage
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
     rownr_t* rows = rowStorage_p.data();
@@ -1022,7 +1382,9 @@ void RefTable::refXor (rownr_t nr1, const rownr_t* inx1,
 	    }
 	}
     }
+    compactRows();
     changed_p = True;
+    rootRows_p.reset();
 }
 
 // Negate a table.
@@ -1032,6 +1394,7 @@ void RefTable::refNot (rownr_t nr, const rownr_t* inx, rownr_t nrtot)
     // The original table has NRTOT rows.
     // So loop through the inx-array and store all rownrs not in the array.
     rownr_t allrow = nrtot - nr;                 // #output rows
+    expandRows();
     rowStorage_p.resize (allrow);             // allocate output storage
     AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
     rownr_t* rows = rowStorage_p.data();
@@ -1046,7 +1409,356 @@ void RefTable::refNot (rownr_t nr, const rownr_t* inx, rownr_t nrtot)
     for (j=start; j<nrtot; j++) {             // handle last interval
 	rows[nrrow_p++] = j;
     }
+    compactRows();
+    changed_p = True;
+    rootRows_p.reset();
+}
+
+namespace {
+
+  // Count the set bits in a word.
+  inline uInt countBits (uInt64 word)
+  {
+#if defined(__GNUC__)
+    return __builtin_popcountll (word);
+#else
+    uInt n = 0;
+    for (; word != 0; word &= word - 1) {
+      n++;
+    }
+    return n;
+#endif
+  }
+
+  // Get the index of the lowest set bit in a word (which must not be 0).
+  inline uInt lowestBit (uInt64 word)
+  {
+#if defined(__GNUC__)
+    return __builtin_ctzll (word);
+#else
+    uInt n = 0;
+    for (; (word & 1) == 0; word >>= 1) {
+      n++;
+    }
+    return n;
+#endif
+  }
+
+  // A compressed bit mask of row numbers organized like a roaring bitmap.
+  // The rows are divided in chunks of 65536 rows. A chunk without set bits
+  // is not stored. A sparse chunk is stored as the sorted (16-bit) offsets
+  // of its rows, a dense chunk (more than 4096 rows) as a bitmap.
+  // So the memory used is proportional to the number of rows set,
+  // not to the number of rows in the root table.
+  class RowMask
+  {
+  public:
+    explicit RowMask (rownr_t nrtot)
+      : itsNrtot (nrtot)
+    {}
+
+    // Set the bits of the given rows (in any order).
+    void set (rownr_t nr, const rownr_t* rows);
+
+    // Combine with the mask of another set of rows.
+    void combine (RefTable::LogicOper oper, const RowMask& that);
+
+    // Invert the bits of all rows in the root table.
+    void invert();
+
+    // Get the number of set bits.
+    rownr_t count() const;
+
+    // Store the row numbers of the set bits in ascending order.
+    void getRows (rownr_t* rows) const;
+
+  private:
+    enum {ChunkShift = 16,
+          ChunkSize  = 65536,
+          ChunkWords = 1024,
+          MaxOffsets = 4096};
+    struct Chunk {
+      std::vector<uShort> offsets;     //# sorted row offsets if sparse
+      std::vector<uInt64> bits;        //# bitmap if dense
+      Bool empty() const
+        { return offsets.empty()  &&  bits.empty(); }
+    };
+
+    // Convert a chunk to a bitmap.
+    static void toBits (Chunk& chunk);
+    // Get the bitmap of a chunk stored as offsets.
+    static void getBits (const Chunk& chunk, std::vector<uInt64>& bits);
+    // Convert a bitmap to offsets if sparse enough.
+    static void compact (Chunk& chunk);
+    // Combine the rows of two chunks.
+    static void combineChunk (RefTable::LogicOper oper,
+                              Chunk& chunk, const Chunk& that);
+
+    rownr_t                 itsNrtot;
+    std::map<rownr_t,Chunk> itsChunks;
+  };
+
+  void RowMask::set (rownr_t nr, const rownr_t* rows)
+  {
+    // Successive rows are usually in the same chunk, so remember the last.
+    Chunk* chunk = 0;
+    rownr_t lastKey = 0;
+    for (rownr_t i=0; i<nr; i++) {
+      rownr_t key = rows[i] >> ChunkShift;
+      if (chunk == 0  ||  key != lastKey) {
+        chunk = &(itsChunks[key]);
+        lastKey = key;
+      }
+      uInt offset = rows[i] & (ChunkSize-1);
+      if (chunk->bits.empty()) {
+        chunk->offsets.push_back (offset);
+        if (chunk->offsets.size() > MaxOffsets) {
+          toBits (*chunk);
+        }
+      } else {
+        chunk->bits[offset >> 6] |= uInt64(1) << (offset & 63);
+      }
+    }
+    // Sort the offsets and remove duplicate rows.
+    for (std::map<rownr_t,Chunk>::iterator iter=itsChunks.begin();
+         iter!=itsChunks.end(); ++iter) {
+      std::vector<uShort>& offsets = iter->second.offsets;
+      std::sort (offsets.begin(), offsets.end());
+      offsets.erase (std::unique (offsets.begin(), offsets.end()),
+                     offsets.end());
+      compact (iter->second);
+    }
+  }
+
+  void RowMask::combine (RefTable::LogicOper oper, const RowMask& that)
+  {
+    if (oper == RefTable::LogicAnd) {
+      // Chunks not in the other mask become empty.
+      std::map<rownr_t,Chunk>::iterator iter = itsChunks.begin();
+      while (iter != itsChunks.end()) {
+        if (that.itsChunks.find (iter->first) == that.itsChunks.end()) {
+          iter = itsChunks.erase (iter);
+        } else {
+          ++iter;
+        }
+      }
+    }
+    for (std::map<rownr_t,Chunk>::const_iterator thatIter =
+           that.itsChunks.begin();
+         thatIter != that.itsChunks.end(); ++thatIter) {
+      std::map<rownr_t,Chunk>::iterator iter =
+        itsChunks.find (thatIter->first);
+      if (iter == itsChunks.end()) {
+        if (oper == RefTable::LogicOr  ||  oper == RefTable::LogicXor) {
+          itsChunks[thatIter->first] = thatIter->second;
+        }
+      } else {
+        combineChunk (oper, iter->second, thatIter->second);
+        if (iter->second.empty()) {
+          itsChunks.erase (iter);
+        }
+      }
+    }
+  }
+
+  void RowMask::invert()
+  {
+    rownr_t nrchunk = (itsNrtot + ChunkSize - 1) / ChunkSize;
+    for (rownr_t key=0; key<nrchunk; key++) {
+      Chunk& chunk = itsChunks[key];
+      toBits (chunk);
+      for (uInt i=0; i<ChunkWords; i++) {
+        chunk.bits[i] = ~chunk.bits[i];
+      }
+      // Clear the bits of the non-existing rows in the last chunk.
+      rownr_t nrow = std::min (itsNrtot - key*ChunkSize, rownr_t(ChunkSize));
+      if (nrow < ChunkSize) {
+        uInt nrfull = nrow / 64;
+        if (nrow % 64 != 0) {
+          chunk.bits[nrfull++] &= (uInt64(1) << (nrow % 64)) - 1;
+        }
+        std::fill (chunk.bits.begin() + nrfull, chunk.bits.end(), 0);
+      }
+      compact (chunk);
+      if (chunk.empty()) {
+        itsChunks.erase (key);
+      }
+    }
+  }
+
+  rownr_t RowMask::count() const
+  {
+    rownr_t nr = 0;
+    for (std::map<rownr_t,Chunk>::const_iterator iter=itsChunks.begin();
+         iter!=itsChunks.end(); ++iter) {
+      const Chunk& chunk = iter->second;
+      nr += chunk.offsets.size();
+      for (size_t i=0; i<chunk.bits.size(); i++) {
+        nr += countBits (chunk.bits[i]);
+      }
+    }
+    return nr;
+  }
+
+  void RowMask::getRows (rownr_t* rows) const
+  {
+    for (std::map<rownr_t,Chunk>::const_iterator iter=itsChunks.begin();
+         iter!=itsChunks.end(); ++iter) {
+      rownr_t start = iter->first << ChunkShift;
+      const Chunk& chunk = iter->second;
+      for (size_t i=0; i<chunk.offsets.size(); i++) {
+        *rows++ = start + chunk.offsets[i];
+      }
+      for (size_t i=0; i<chunk.bits.size(); i++) {
+        uInt64 bits = chunk.bits[i];
+        while (bits != 0) {
+          *rows++ = start + 64*i + lowestBit (bits);
+          bits &= bits - 1;               // clear lowest set bit
+        }
+      }
+    }
+  }
+
+  void RowMask::toBits (Chunk& chunk)
+  {
+    if (chunk.bits.empty()) {
+      getBits (chunk, chunk.bits);
+      std::vector<uShort>().swap (chunk.offsets);
+    }
+  }
+
+  void RowMask::getBits (const Chunk& chunk, std::vector<uInt64>& bits)
+  {
+    bits.assign (ChunkWords, 0);
+    for (size_t i=0; i<chunk.offsets.size(); i++) {
+      uInt offset = chunk.offsets[i];
+      bits[offset >> 6] |= uInt64(1) << (offset & 63);
+    }
+  }
+
+  void RowMask::compact (Chunk& chunk)
+  {
+    rownr_t nr = 0;
+    for (size_t i=0; i<chunk.bits.size(); i++) {
+      nr += countBits (chunk.bits[i]);
+    }
+    if (nr <= MaxOffsets) {
+      chunk.offsets.reserve (chunk.offsets.size() + nr);
+      for (size_t i=0; i<chunk.bits.size(); i++) {
+        uInt64 bits = chunk.bits[i];
+        while (bits != 0) {
+          chunk.offsets.push_back (64*i + lowestBit (bits));
+          bits &= bits - 1;
+        }
+      }
+      std::vector<uInt64>().swap (chunk.bits);
+    }
+  }
+
+  void RowMask::combineChunk (RefTable::LogicOper oper,
+                              Chunk& chunk, const Chunk& that)
+  {
+    if (chunk.bits.empty()  &&  that.bits.empty()) {
+      // Merge the sorted offsets.
+      const std::vector<uShort>& off1 = chunk.offsets;
+      const std::vector<uShort>& off2 = that.offsets;
+      std::vector<uShort> result;
+      std::back_insert_iterator<std::vector<uShort> > out(result);
+      switch (oper) {
+      case RefTable::LogicAnd:
+        std::set_intersection (off1.begin(), off1.end(),
+                               off2.begin(), off2.end(), out);
+        break;
+      case RefTable::LogicOr:
+        std::set_union (off1.begin(), off1.end(),
+                        off2.begin(), off2.end(), out);
+        break;
+      case RefTable::LogicSub:
+        std::set_difference (off1.begin(), off1.end(),
+                             off2.begin(), off2.end(), out);
+        break;
+      case RefTable::LogicXor:
+        std::set_symmetric_difference (off1.begin(), off1.end(),
+                                       off2.begin(), off2.end(), out);
+        break;
+      default:
+        throw TableInvLogic();
+      }
+      chunk.offsets.swap (result);
+      if (chunk.offsets.size() > MaxOffsets) {
+        toBits (chunk);
+      }
+      return;
+    }
+    // Combine the bitmaps.
+    toBits (chunk);
+    std::vector<uInt64> thatBits;
+    const uInt64* bits2 = that.bits.data();
+    if (that.bits.empty()) {
+      getBits (that, thatBits);
+      bits2 = thatBits.data();
+    }
+    uInt64* bits1 = chunk.bits.data();
+    switch (oper) {
+    case RefTable::LogicAnd:
+      for (uInt i=0; i<ChunkWords; i++) bits1[i] &= bits2[i];
+      break;
+    case RefTable::LogicOr:
+      for (uInt i=0; i<ChunkWords; i++) bits1[i] |= bits2[i];
+      break;
+    case RefTable::LogicSub:
+      for (uInt i=0; i<ChunkWords; i++) bits1[i] &= ~bits2[i];
+      break;
+    case RefTable::LogicXor:
+      for (uInt i=0; i<ChunkWords; i++) bits1[i] ^= bits2[i];
+      break;
+    default:
+      throw TableInvLogic();
+    }
+    compact (chunk);
+  }
+
+} //# end anonymous namespace
+
+// Tell if a bit mask is cheaper than merging the (sorted) index arrays.
+// Filling and scanning the mask costs about one operation per row in
+// its sparse parts and one per 64 root rows in its dense parts, while
+// merging costs a few (badly predictable) branches per row and sorting
+// an unordered index array much more.
+Bool RefTable::useMask (rownr_t nr1, rownr_t nr2, rownr_t nrtot,
+                        Bool inOrder)
+{
+    if (inOrder) {
+        rownr_t nrword = (nrtot + 63) / 64;
+        return nrword <= (nr1 + nr2) / 4;
+    }
+    return True;
+}
+
+// Do a logical operation on 2 index arrays using compressed bit masks.
+void RefTable::refMask (LogicOper oper,
+                        rownr_t nr1, const rownr_t* inx1,
+                        rownr_t nr2, const rownr_t* inx2, rownr_t nrtot)
+{
+    RowMask mask1(nrtot);
+    mask1.set (nr1, inx1);
+    if (oper == LogicNot) {
+        mask1.invert();
+    } else {
+        RowMask mask2(nrtot);
+        mask2.set (nr2, inx2);
+        mask1.combine (oper, mask2);
+    }
+    // Count the selected rows to allocate the exact output size.
+    rownr_t allrow = mask1.count();
+    expandRows();
+    rowStorage_p.resize (allrow);             // allocate output storage
+    AlwaysAssert (rowStorage_p.contiguousStorage(), AipsError);
+    mask1.getRows (rowStorage_p.data());
+    nrrow_p = allrow;
+    compactRows();
     changed_p = True;
+    rootRows_p.reset();
 }
 
 } //# NAMESPACE CASACORE - END
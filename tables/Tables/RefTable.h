@@ -32,13 +32,16 @@
 #include <casacore/tables/Tables/BaseTable.h>
 #include <casacore/casa/BasicSL/String.h>
 #include <casacore/casa/Arrays/Vector.h>
+#include <atomic>
 #include <map>
+#include <vector>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
 //# Forward Declarations
 class TSMOption;
 class RefColumn;
+class RefRows;
 class AipsIO;
 
 
@@ -71,8 +74,22 @@ class AipsIO;
 // It acts to the user as a normal table. All gets and puts are
 // handled by RefColumn which directs them to the referenced column
 // while (if needed) converting the given row number to the row number
-// in the referenced table. For that purpose RefTable maintains a
-// Vector of the row numbers in the referenced table.
+// in the referenced table. For that purpose RefTable maintains the
+// row numbers in the referenced table. As long as it saves memory, they
+// are kept as runs of row numbers with a constant increment, so a
+// selection of a few blocks of rows (or a projection) takes hardly any
+// memory. Otherwise they are kept in a Vector.
+// <br>Gets and puts of an entire column or of a set of cells are passed
+// on with the row numbers collapsed into ranges (see
+// <linkto class=RefRows>RefRows</linkto>) where possible, so the data
+// managers of the referenced table can access contiguous blocks of rows
+// sequentially.
+// <br>When the RefTable is written, the row numbers are stored as ranges
+// if that takes at most half of the space. A selection consisting of a few
+// blocks of rows then takes only a few bytes on disk. Note that such a
+// RefTable (version 4) cannot be read by casacore versions older than this
+// one. If that is needed, the aipsrc variable
+// <src>table.reftable.compactrows</src> can be set to False.
 //
 // The RefTable constructor acts in a way that it will always reference
 // the original table. This means that if a select is done on a RefTable,
@@ -86,9 +103,6 @@ class AipsIO;
 
 // <todo asof="$DATE:$">
 //# A List of bugs, limitations, extensions or planned refinements.
-//   <li> Maybe not allocating the row number vector for a projection.
-//          This saves space and time, but each rownr conversion will
-//          take a bit more time because it has to test if there is a vector.
 //   <li> Maybe maintain a Vector<String> telling on which columns
 //          the table is ordered. This may speed up selection, but
 //          it is hard to check if the order is changed by a put.
@@ -306,13 +320,30 @@ public:
     // This converts the given row numbers to row numbers in the root table.
     Vector<rownr_t> rootRownr (const Vector<rownr_t>& rownrs) const;
 
+    // Get the row numbers in the root table as a RefRows object, where
+    // runs of row numbers with a constant stride are collapsed into slices.
+    // The result of the first version is cached until the rows change.
+    // The second version converts the given row numbers in this table.
+    // <group>
+    RefRows rootRows() const;
+    RefRows rootRows (const RefRows& rownrs) const;
+    // </group>
+
     // Tell if the table is in row order.
     virtual Bool rowOrder() const;
 
     // Get row number vector.
-    // This is used by the BaseTable logic and sort routines.
+    // This is used by the BaseTable sort routine.
+    // Because the caller can change the row numbers, the row numbers are
+    // not kept as runs anymore and the cached rootRows() are invalidated.
     virtual Vector<rownr_t>& rowStorage();
 
+    // Convert the row numbers added to this table, which are row numbers
+    // in the given table, to row numbers in the root table (as done by
+    // <src>adjustRownrs</src> of the given table).
+    // It returns True if the resulting row numbers are in ascending order.
+    Bool adjustToRoot (const BaseTable& table);
+
     // Add a rownr to reference table.
     void addRownr (rownr_t rownr);
 
@@ -335,13 +366,39 @@ void addRownrRange (rownr_t startRownr, rownr_t endRownr);
     void refXor (rownr_t nr1, const rownr_t* rows1, rownr_t nr2, const rownr_t* rows2);
     void refNot (rownr_t nr1, const rownr_t* rows1, rownr_t nrmain);
 
+    // Do a logical operation on the row numbers of 2 tables using a
+    // compressed bit mask of the <src>nrmain</src> rows in the root table.
+    // Its memory use is proportional to the number of rows selected.
+    // Unlike refAnd, etc. the row numbers do not need to be in ascending
+    // order, but the resulting row numbers are.
+    // For LogicNot the second table is ignored.
+    enum LogicOper {LogicAnd, LogicOr, LogicSub, LogicXor, LogicNot};
+    void refMask (LogicOper oper,
+                  rownr_t nr1, const rownr_t* rows1,
+                  rownr_t nr2, const rownr_t* rows2, rownr_t nrmain);
+
+    // Tell if refMask is cheaper than sorting (if needed) and merging
+    // the row numbers using refAnd, etc.
+    static Bool useMask (rownr_t nr1, rownr_t nr2, rownr_t nrmain,
+                         Bool inOrder);
+
 private:
     std::shared_ptr<BaseTable> baseTabPtr_p;//# pointer to parent table
     Bool            rowOrd_p;               //# True = table is in row order
     Vector<rownr_t> rowStorage_p;           //# row numbers in parent table
+    //# A run of row numbers with a constant increment.
+    struct RowRun {
+        rownr_t first;                      //# first row in this table
+        rownr_t start;                      //# its row number in parent
+        rownr_t incr;                       //# increment in parent
+    };
+    std::vector<RowRun> runs_p;             //# row numbers as runs
+    Bool            useRuns_p;              //# True = runs_p is used
+    mutable std::atomic<size_t> lastRun_p;  //# run used last by rootRownr
     std::map<String,String> nameMap_p;      //# map to column name in parent
     std::map<String,RefColumn*> colMap_p;   //# map name to column
     Bool            changed_p;              //# True = changed since last write
+    mutable std::shared_ptr<RefRows> rootRows_p; //# cached rootRows() (0 = invalid)
 
     // Get the names of the tables this table consists of.
     virtual void getPartNames (Block<String>& names, Bool recursive) const;
@@ -377,6 +434,35 @@ private:
     // added to the parent table first.
     Bool checkAddColumn (const String& name, Bool addToParent);
 
+    // Get the index of the run containing the given row.
+    size_t runIndex (rownr_t rownr) const;
+
+    // Get the row number in the parent from the runs.
+    rownr_t runRownr (rownr_t rownr) const;
+
+    // Tell if the given number of runs takes too much memory compared
+    // to a vector of row numbers.
+    static Bool tooManyRuns (size_t nruns, rownr_t nrow);
+
+    // Add <src>nrow</src> row numbers with the given increment to the runs,
+    // where <src>nrrow</src> is the number of row numbers in the runs.
+    static void addRun (std::vector<RowRun>& runs, rownr_t& nrrow,
+                        rownr_t start, rownr_t nrow, rownr_t incr);
+
+    // Make runs from the given row numbers. It stops and returns False
+    // as soon as it appears to take too many runs.
+    static Bool makeRuns (std::vector<RowRun>& runs,
+                          const rownr_t* rows, rownr_t nrow);
+
+    // Make a RefRows object containing the slices of the runs.
+    static RefRows runsToRows (const std::vector<RowRun>& runs, rownr_t nrow);
+
+    // Put the row numbers in rowStorage_p instead of in the runs.
+    void expandRows();
+
+    // Keep the row numbers as runs if that saves enough memory.
+    void compactRows();
+
     // Add a column.
     void addRefCol (const ColumnDesc& cd);
     // Add multiple columns.
@@ -386,7 +472,7 @@ private:
 
 
 inline rownr_t RefTable::rootRownr (rownr_t rnr) const
-    { return rowStorage_p[rnr]; }
+    { return (useRuns_p  ?  runRownr(rnr) : rowStorage_p[rnr]); }
 
 
 
@@ -165,6 +165,7 @@ friend class TableIterator;
 friend class RODataManAccessor;
 friend class TableExprNode;
 friend class TableExprNodeRep;
+friend class TableSnapshot;
 
 public:
     // Define the possible options how a table can be opened.
@@ -473,8 +474,29 @@ public:
     // if the table lock option is UserNoReadLocking or AutoNoReadLocking.
     // In that cases the table system does not acquire a read-lock, thus
     // does not synchronize itself automatically.
+    // <br>If the writer publishes its commits (see <src>publishCommits</src>),
+    // the table is synchronized with the last commit, thus the last flushed
+    // number of rows and data manager state. Nothing is done if no commit
+    // has been done since the previous resync, so it can be called often.
+    // It never waits for the writer; if the writer is flushing, the
+    // synchronization is done by a later resync.
     void resync();
 
+    // Let the table publish its commits, i.e. its flushes.
+    // It is a persistent setting of the plain table, so every process
+    // writing the table publishes its commits thereafter, also a process
+    // that opened the table before (from its next flush on).
+    // A process reading the table with one of the NoReadLocking options
+    // sees the state of the last commit (at open and at each
+    // <src>resync</src>) without taking a lock, so it does not slow down
+    // the writer. This is meant for quick-look tools reading a table
+    // that is being filled.
+    // <br>Note that only the committed number of rows and data manager
+    // state are consistent. Changes of rows already committed become
+    // visible when their buckets are read, as without commits.
+    // <br>An exception is thrown if the table is not a writable plain table.
+    void publishCommits();
+
     // Test if the object is null, i.e. does not reference a proper table.
     // This is the case if the default constructor is used.
     Bool isNull() const
@@ -1107,6 +1129,8 @@ inline void Table::flush (Bool fsync, Bool recursive)
     { baseTabPtr_p->flush (fsync, recursive); }
 inline void Table::resync()
     { baseTabPtr_p->resync(); }
+inline void Table::publishCommits()
+    { baseTabPtr_p->publishCommits(); }
 
 inline const StorageOption& Table::storageOption() const
     { return baseTabPtr_p->storageOption(); }
@@ -201,6 +201,24 @@ public:
     Bool canChangeShape() const
         { return canChangeShape_p; }
 
+    // Is the column a scalar String column stored with dictionary encoding?
+    // In that case equal values have equal integer codes, which can be
+    // used to compare values without getting the strings (e.g. in TaQL).
+    // <br>findDictCode returns -1 if the value is not in the dictionary.
+    // <br>dictGeneration changes each time values are added to the
+    // dictionary, so an absent value only needs to be looked up again
+    // if the generation has changed.
+    // <group>
+    Bool isDictEncoded() const
+        { return baseColPtr_p->isDictEncoded(); }
+    Int getDictCode (rownr_t rownr) const
+	{ TABLECOLUMNCHECKROW(rownr); return baseColPtr_p->getDictCode (rownr); }
+    Int findDictCode (const String& value) const
+        { return baseColPtr_p->findDictCode (value); }
+    uInt64 dictGeneration() const
+        { return baseColPtr_p->dictGeneration(); }
+    // </group>
+
     // Get the global #dimensions of an array (ie. for all cells in column).
     // This is always set for fixed shape arrays.
     // Otherwise, 0 will be returned.
@@ -0,0 +1,210 @@
+//# TableCommit.cc: Class to publish the commits of a table to lock-free readers
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/tables/Tables/TableCommit.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/casa/IO/FiledesIO.h>
+#include <casacore/casa/IO/MemoryIO.h>
+#include <casacore/casa/OS/CanonicalConversion.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Size of the file header and of a record header.
+#define TC_HEADERSIZE 24
+#define TC_RECHEADERSIZE 12
+
+TableCommit::TableCommit (const String& tableName, Bool writable,
+                          Bool create)
+: itsName     (fileName (tableName)),
+  itsFD       (-1),
+  itsWritable (writable || create),
+  itsSeqNr    (0)
+{
+    if (create  &&  !File(itsName).exists()) {
+        itsFD = FiledesIO::create (itsName.chars());
+        Int64 header[3] = {0, 0, 0};
+        writeValues (header, 3, 0);
+    } else {
+        itsFD = FiledesIO::open (itsName.chars(), itsWritable);
+        // A reader has not read any commit yet.
+        itsSeqNr = -1;
+        if (itsWritable) {
+            // A writer which crashed may have left a flush in progress.
+            Int64 header[2];
+            readValues (header, 2, 0);
+            if (header[0] != header[1]) {
+                writeValues (header+1, 1, 0);
+            }
+            itsSeqNr = header[1];
+        }
+    }
+}
+
+TableCommit::~TableCommit()
+{
+    FiledesIO::close (itsFD);
+}
+
+Bool TableCommit::exists (const String& tableName)
+{
+    return File(fileName(tableName)).exists();
+}
+
+String TableCommit::fileName (const String& tableName)
+{
+    return tableName + "/table.commit";
+}
+
+void TableCommit::readValues (Int64* values, uInt nvalues, Int64 offset) const
+{
+    uChar buf[3*8];
+    AlwaysAssert (nvalues <= 3, AipsError);
+    if (::pread (itsFD, buf, 8*nvalues, offset) != Int64(8*nvalues)) {
+        throw TableError ("TableCommit: could not read " + itsName);
+    }
+    CanonicalConversion::toLocal (values, buf, nvalues);
+}
+
+void TableCommit::writeValues (const Int64* values, uInt nvalues,
+                               Int64 offset)
+{
+    uChar buf[3*8];
+    AlwaysAssert (nvalues <= 3, AipsError);
+    CanonicalConversion::fromLocal (buf, values, nvalues);
+    if (::pwrite (itsFD, buf, 8*nvalues, offset) != Int64(8*nvalues)) {
+        throw TableError ("TableCommit: could not write " + itsName);
+    }
+}
+
+Int64 TableCommit::sequence() const
+{
+    Int64 seqnr;
+    readValues (&seqnr, 1, 8);
+    return seqnr;
+}
+
+Bool TableCommit::inProgress() const
+{
+    Int64 header[2];
+    readValues (header, 2, 0);
+    return header[0] != header[1];
+}
+
+void TableCommit::begin()
+{
+    AlwaysAssert (itsWritable, AipsError);
+    Int64 seqnr = sequence() + 1;
+    writeValues (&seqnr, 1, 0);
+}
+
+void TableCommit::end (const MemoryIO& info)
+{
+    AlwaysAssert (itsWritable, AipsError);
+    // Get the current record (another process might have written it).
+    Int64 index[2];
+    readValues (index, 2, 8);
+    Int64 curLength = 0;
+    if (index[1] > 0) {
+        uChar lbuf[4];
+        uInt leng;
+        if (::pread (itsFD, lbuf, 4, index[1] + 8) != 4) {
+            throw TableError ("TableCommit: could not read " + itsName);
+        }
+        CanonicalConversion::toLocal (leng, lbuf);
+        curLength = TC_RECHEADERSIZE + leng;
+    }
+    // Write the new record where it does not overlap the current one.
+    uInt leng = const_cast<MemoryIO&>(info).length();
+    Int64 offset = TC_HEADERSIZE;
+    if (index[1] > 0  &&  offset + TC_RECHEADERSIZE + leng > index[1]) {
+        offset = index[1] + curLength;
+    }
+    Int64 seqnr = index[0] + 1;
+    std::vector<uChar> buf(TC_RECHEADERSIZE + leng);
+    CanonicalConversion::fromLocal (buf.data(), seqnr);
+    CanonicalConversion::fromLocal (buf.data() + 8, leng);
+    if (leng > 0) {
+        memcpy (buf.data() + TC_RECHEADERSIZE, info.getBuffer(), leng);
+    }
+    if (::pwrite (itsFD, buf.data(), buf.size(), offset) != Int64(buf.size())) {
+        throw TableError ("TableCommit: could not write " + itsName);
+    }
+    // Switch to the new record, which also ends the flush.
+    Int64 header[3] = {seqnr, seqnr, offset};
+    writeValues (header+1, 2, 8);
+    writeValues (header, 1, 0);
+    itsSeqNr = seqnr;
+}
+
+void TableCommit::read (MemoryIO& info)
+{
+    // The record of the last commit can only be overwritten after two more
+    // commits, so reading is retried in the rare case that the last commit
+    // changed while reading.
+    for (uInt i=0; i<1000; ++i) {
+        Int64 index[2];
+        readValues (index, 2, 8);
+        uInt leng = 0;
+        std::vector<uChar> buf;
+        if (index[1] > 0) {
+            uChar hbuf[TC_RECHEADERSIZE];
+            if (::pread (itsFD, hbuf, TC_RECHEADERSIZE, index[1])
+                != TC_RECHEADERSIZE) {
+                continue;
+            }
+            Int64 seqnr;
+            CanonicalConversion::toLocal (seqnr, hbuf);
+            CanonicalConversion::toLocal (leng, hbuf+8);
+            if (seqnr != index[0]) {
+                continue;
+            }
+            buf.resize (leng);
+            if (leng > 0  &&  ::pread (itsFD, buf.data(), leng,
+                                       index[1] + TC_RECHEADERSIZE)
+                              != Int64(leng)) {
+                continue;
+            }
+        }
+        if (sequence() == index[0]) {
+            info.clear();
+            if (leng > 0) {
+                info.write (leng, buf.data());
+            }
+            info.seek (Int64(0));
+            itsSeqNr = index[0];
+            return;
+        }
+    }
+    throw TableError ("TableCommit: could not read the last commit from "
+                      + itsName);
+}
+
+} //# NAMESPACE CASACORE - END
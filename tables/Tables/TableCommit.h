@@ -0,0 +1,155 @@
+//# TableCommit.h: Class to publish the commits of a table to lock-free readers
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TABLECOMMIT_H
+#define TABLES_TABLECOMMIT_H
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/casa/BasicSL/String.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+//# Forward Declarations
+class MemoryIO;
+
+
+// <summary>
+// Class to publish the commits of a table to lock-free readers.
+// </summary>
+
+// <use visibility=local>
+
+// <reviewed reviewer="" date="" tests="tTableCommit" demos="">
+// </reviewed>
+
+// <prerequisite>
+//    <li> class <linkto class=TableSyncData>TableSyncData</linkto>
+//    <li> class <linkto class=TableLock>TableLock</linkto>
+// </prerequisite>
+
+// <synopsis>
+// A process reading a table with one of the NoReadLocking options does
+// not acquire a lock, so it does not interfere with the process writing
+// the table. However, the synchronization data in the lock file and the
+// data manager headers can be read while the writer is updating them.
+// <br>If commits are published for a table (using
+// <src>Table::publishCommits</src>), the writer also writes the
+// synchronization data of each flush (the number of rows and change
+// counters of the data managers) to the file <src>table.commit</src>.
+// The data are double buffered. After the flush the new data are written
+// as a record that does not overlap the record of the previous commit.
+// Thereafter the index in the file header is switched to the new record.
+// Thus a reader always finds a complete record for the last commit and
+// never has to wait for the writer. It only has to read again in the
+// rare case that the writer finished two more commits while it was
+// reading, which is detected by the commit number in the header and
+// in the record.
+// <br>The header also tells if the writer is flushing, so a reader can
+// postpone rereading the data manager headers until the flush is done
+// (see <src>PlainTable::resync</src>).
+// <p>
+// The file starts with three canonical Int64 values: the number of the
+// commit being flushed, the number of the last commit, and the file offset
+// of its record (0 if none). A record consists of its commit number
+// (canonical Int64), the length (canonical uInt), and the contents of the
+// synchronization data. A new record is written at the start of the record
+// area if it fits before the current record, otherwise right after it.
+// </synopsis>
+
+
+class TableCommit
+{
+public:
+    // Open the commit file of the table.
+    // If it does not exist and <src>create=True</src>, it is created
+    // (with commit number 0 and no synchronization data).
+    // Otherwise an exception is thrown if it does not exist.
+    TableCommit (const String& tableName, Bool writable, Bool create=False);
+
+    ~TableCommit();
+
+    // Copy constructor is forbidden.
+    TableCommit (const TableCommit& that) = delete;
+
+    // Assignment is forbidden.
+    TableCommit& operator= (const TableCommit& that) = delete;
+
+    // Test if commits are published for the table.
+    static Bool exists (const String& tableName);
+
+    // Get the name of the commit file of the table.
+    static String fileName (const String& tableName);
+
+    // Tell readers that the table is being flushed.
+    void begin();
+
+    // End the flush by writing its synchronization data as a new record
+    // and switching the header to it.
+    void end (const MemoryIO& info);
+
+    // Get the number of the last commit.
+    Int64 sequence() const;
+
+    // Get the number of the commit last read or written.
+    Int64 generation() const
+      { return itsSeqNr; }
+
+    // Read the synchronization data of the last commit.
+    // It does not wait for a flush in progress.
+    // The number of the commit read is kept, so <src>changed</src>
+    // tells if another commit has been done.
+    void read (MemoryIO& info);
+
+    // Test if another commit has been done since the last <src>read</src>.
+    Bool changed() const
+      { return sequence() != itsSeqNr; }
+
+    // Test if the writer is flushing the table.
+    Bool inProgress() const;
+
+    // Forget the commit read, so <src>changed</src> returns True.
+    void invalidate()
+      { itsSeqNr = -1; }
+
+private:
+    String itsName;
+    int    itsFD;
+    Bool   itsWritable;
+    Int64  itsSeqNr;
+
+    // Read or write Int64 values at the given offset.
+    // <group>
+    void readValues (Int64* values, uInt nvalues, Int64 offset) const;
+    void writeValues (const Int64* values, uInt nvalues, Int64 offset);
+    // </group>
+};
+
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
@@ -27,6 +27,7 @@
 #include <casacore/tables/Tables/TabPath.h>
 #include <casacore/tables/Tables/TableRecord.h>
 #include <casacore/tables/Tables/TableAttr.h>
+#include <casacore/tables/Tables/LazyTableRecord.h>
 #include <casacore/tables/Tables/TableError.h>
 #include <casacore/casa/Arrays/Vector.h>
 #include <casacore/casa/Arrays/Slice.h>
@@ -216,7 +217,12 @@ void TableDesc::copy (const TableDesc& td, const TabPath& tdpath,
 	vers_p = td.vers_p;
     }
     comm_p = td.comm_p;
-    *key_p = *(td.key_p);
+    {
+        std::lock_guard<std::mutex> lock(td.lazyMutex_p);
+        *key_p = *(td.key_p);
+        lazyKey_p = td.lazyKey_p;
+        hasLazyKey_p = Bool(lazyKey_p);
+    }
     *privKey_p = *(td.privKey_p);
     if (copyColumns) {
         col_p  = td.col_p;
@@ -253,14 +259,16 @@ void TableDesc::add (const TableDesc& that, Bool addKeywordSet)
 	throw (TableInvOper ("TableDesc::add; hypercolumns not disjoint"));
     }
     if (addKeywordSet) {
-	if (! key_p->description().isDisjoint (that.key_p->description())) {
+	if (! keywordSet().description().isDisjoint
+                                   (that.keywordSet().description())) {
 	    throw (TableInvOper ("TableDesc::add; keywords not disjoint"));
 	}
     }
     col_p.add (that.col_p);
     privKey_p->merge (*that.privKey_p, RecordInterface::ThrowOnDuplicates);
     if (addKeywordSet) {
-	key_p->merge (*that.key_p, RecordInterface::ThrowOnDuplicates);
+	rwKeywordSet().merge (that.keywordSet(),
+                              RecordInterface::ThrowOnDuplicates);
     }
 }
 
@@ -279,8 +287,8 @@ void TableDesc::show (ostream& os) const
     os << endl;
     os << "---------" << endl;
     os << "  Comment: " << comm_p << endl;
-    os << "  #Keywords = " << key_p->nfields() << endl;;
-    os << key_p->description();
+    os << "  #Keywords = " << keywordSet().nfields() << endl;;
+    os << keywordSet().description();
     os << "  #Columns  = " << ncolumn() << endl;;
     os << privKey_p->description();
     col_p.show (os);
@@ -293,7 +301,7 @@ void TableDesc::putFile (AipsIO& ios, const TableAttr& parentAttr) const
     ios << name_p;
     ios << vers_p;
     ios << comm_p;
-    key_p->putRecord (ios, parentAttr);
+    keywordSet().putRecord (ios, parentAttr);
     ios << *privKey_p;
     col_p.putFile (ios, parentAttr);
     ios.putend ();
@@ -305,7 +313,15 @@ void TableDesc::getFile (AipsIO& ios, const TableAttr& parentAttr)
     ios >> name_p;
     ios >> vers_p;
     ios >> comm_p;
-    key_p->getRecord (ios, parentAttr);
+    // Only keep the raw keyword set; it is interpreted when needed.
+    lazyKey_p.reset();
+    if (key_p->nfields() == 0) {
+        lazyKey_p = LazyTableRecord::read (ios, parentAttr);
+    }
+    hasLazyKey_p = Bool(lazyKey_p);
+    if (! lazyKey_p) {
+        key_p->getRecord (ios, parentAttr);
+    }
     // Version 1 does not contain privKey_p.
     if (tvers != 1) {
 	ios >> *privKey_p;
@@ -314,6 +330,17 @@ void TableDesc::getFile (AipsIO& ios, const TableAttr& parentAttr)
     ios.getend ();
 }
 
+void TableDesc::getLazyKeywordSet() const
+{
+    std::lock_guard<std::mutex> lock(lazyMutex_p);
+    // Another thread might have read it in the meantime.
+    if (lazyKey_p) {
+        lazyKey_p->get (*key_p);
+        lazyKey_p.reset();
+        hasLazyKey_p = False;
+    }
+}
+
 
 
 //# Rename a column.
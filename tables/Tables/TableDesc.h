@@ -34,7 +34,10 @@
 #include <casacore/casa/iosfwd.h>
 #include <casacore/casa/Arrays/ArrayFwd.h>
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 
 namespace casacore { //# NAMESPACE CASACORE - BEGIN
 
@@ -42,6 +45,7 @@ namespace casacore { //# NAMESPACE CASACORE - BEGIN
 class TableRecord;
 class TableAttr;
 class TabPath;
+class LazyTableRecord;
 
 // <summary>
 // Define the structure of a Casacore table
@@ -265,6 +269,8 @@ public:
     void add (const TableDesc& other, Bool addKeywordSet = True);
 
     // Get access to the keyword set.
+    // When the description was read from a file, the keywords are
+    // only read at the first access (which is thread-safe).
     // <group>
     TableRecord& rwKeywordSet();
     const TableRecord& keywordSet() const;
@@ -493,6 +499,11 @@ private:
     //# Note: the TableRecords are done as pointer, otherwise TableRecord.h
     //# needs to be included leading to a mutual include.
     TableRecord*       key_p;           //# user set of keywords
+    //# keywords not read yet (see class LazyTableRecord); the flag tells
+    //# if it is set and the mutex guards reading it
+    mutable std::shared_ptr<LazyTableRecord> lazyKey_p;
+    mutable std::atomic<Bool> hasLazyKey_p {False};
+    mutable std::mutex lazyMutex_p;
     TableRecord*       privKey_p;       //# Private set of keywords
     ColumnDescSet      col_p;           //# set of column names + indices
     Bool               swwrite_p;       //# True = description can be written
@@ -505,6 +516,10 @@ private:
     // Initialize and copy a table description.
     void copy (const TableDesc&, const TabPath&, Bool copyColumns);
 
+    // Read the keyword set which has not been read yet by getFile.
+    // It is guarded by a mutex, so concurrent keywordSet calls are fine.
+    void getLazyKeywordSet() const;
+
     // Throw an invalid hypercolumn exception.
     void throwHypercolumn (const String& hyperColumnName,
 			   const String& message);
@@ -554,9 +569,9 @@ inline const String& TableDesc::version () const
 
 //# Get access to the sets of keywords.
 inline TableRecord& TableDesc::rwKeywordSet ()
-    { return *key_p; }
+    { if (hasLazyKey_p) getLazyKeywordSet(); return *key_p; }
 inline const TableRecord& TableDesc::keywordSet () const
-    { return *key_p; }
+    { if (hasLazyKey_p) getLazyKeywordSet(); return *key_p; }
 inline const TableRecord& TableDesc::privateKeywordSet () const
     { return *privKey_p; }
 
@@ -78,6 +78,7 @@ void TableRecordRep::restructure (const RecordDesc& newDescription,
     delete_myself (desc_p.nfields());
     desc_p  = newDescription;
     nused_p = desc_p.nfields();
+    reserveScalarSlots (desc_p);
     datavec_p.resize (nused_p);
     datavec_p = static_cast<void*>(0);
     data_p.resize (nused_p);
@@ -0,0 +1,421 @@
+//# TableSnapshot.cc: Class with static functions for table snapshots
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+//# Includes
+#include <casacore/tables/Tables/TableSnapshot.h>
+#include <casacore/tables/Tables/PlainTable.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/DataMan/DataManager.h>
+#include <casacore/casa/IO/BucketSnapshot.h>
+#include <casacore/casa/IO/FiledesIO.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/OS/Directory.h>
+#include <casacore/casa/OS/Path.h>
+#include <casacore/casa/OS/DOos.h>
+#include <casacore/casa/fstream.h>
+#include <algorithm>
+#include <set>
+#include <vector>
+#include <string.h>
+
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+namespace {
+
+  // The directory containing the snapshots of a table.
+  String rootName (const String& tableName)
+  {
+    return tableName + "/table.snapshots";
+  }
+
+  // Read the names of the snapshots (in order of creation).
+  std::vector<String> readNames (const String& tableName)
+  {
+    std::vector<String> names;
+    String fileName = rootName(tableName) + "/names";
+    if (File(fileName).exists()) {
+      std::ifstream ifs (fileName.chars());
+      std::string line;
+      while (std::getline (ifs, line)) {
+        if (! line.empty()) {
+          names.push_back (line);
+        }
+      }
+    }
+    return names;
+  }
+
+  void writeNames (const String& tableName, const std::vector<String>& names)
+  {
+    String fileName = rootName(tableName) + "/names";
+    std::ofstream ofs (fileName.chars(), std::ios::trunc);
+    for (const String& name : names) {
+      ofs << name << std::endl;
+    }
+    if (! ofs) {
+      throw TableError ("TableSnapshot: could not write " + fileName);
+    }
+  }
+
+  // Find the index of the snapshot. An exception is thrown if unknown.
+  uInt findName (const String& tableName, const std::vector<String>& names,
+                 const String& name)
+  {
+    for (uInt i=0; i<names.size(); ++i) {
+      if (names[i] == name) {
+        return i;
+      }
+    }
+    throw TableError ("TableSnapshot: table " + tableName +
+                      " has no snapshot " + name);
+  }
+
+  // Get the names of the files snapshotted using copy-on-write
+  // (without the .cow extension).
+  Vector<String> cowFiles (const String& snapDir)
+  {
+    Vector<String> files = DOos::fileNames (snapDir, "*.cow", "r");
+    for (uInt i=0; i<files.size(); ++i) {
+      files[i] = files[i].before (files[i].size() - 4);
+    }
+    return files;
+  }
+
+  // Get the names of the regular files in a table or snapshot directory,
+  // except the lock file.
+  std::vector<String> plainFiles (const String& dirName)
+  {
+    Vector<String> files = DOos::fileNames (dirName, "", "r");
+    std::vector<String> result;
+    for (const String& file : files) {
+      if (file != "table.lock") {
+        result.push_back (file);
+      }
+    }
+    return result;
+  }
+
+  // Get the logs containing the contents of the file at the time of the
+  // snapshot k, thus the logs of snapshot k till the first later snapshot
+  // that copied the file. The base file is that copy or the table's file.
+  BucketSnapshotView makeView (const String& tableName,
+                               const std::vector<String>& names,
+                               uInt k, const String& file)
+  {
+    BucketSnapshotView view;
+    view.baseName = tableName + '/' + file;
+    for (uInt j=k; j<names.size(); ++j) {
+      String dirName = TableSnapshot::snapshotName (tableName, names[j]);
+      if (File(dirName + '/' + file + ".cow").exists()) {
+        view.logs.push_back (BucketSnapshotLog::open
+                             (dirName + '/' + file + ".cow"));
+      } else {
+        if (File(dirName + '/' + file).exists()) {
+          view.baseName = dirName + '/' + file;
+        }
+        break;
+      }
+    }
+    return view;
+  }
+
+  // Activate or deactivate the logs of the given snapshot.
+  void activate (const String& tableName, const String& snapDir, Bool active)
+  {
+    Vector<String> files = cowFiles (snapDir);
+    for (const String& file : files) {
+      String fileName = tableName + '/' + file;
+      if (active) {
+        BucketSnapshotLog::setActive
+          (fileName, BucketSnapshotLog::open (snapDir + '/' + file + ".cow"));
+      } else {
+        BucketSnapshotLog::setActive (fileName,
+                                      std::shared_ptr<BucketSnapshotLog>());
+      }
+    }
+  }
+
+  // Check that the snapshots of the table are not open.
+  void checkNotOpen (const String& tableName, const std::vector<String>& names)
+  {
+    for (const String& name : names) {
+      if (Table::isOpened (TableSnapshot::snapshotName (tableName, name))) {
+        throw TableError ("TableSnapshot: snapshot " + name + " of table " +
+                          tableName + " is still open");
+      }
+    }
+  }
+
+} //# end anonymous namespace
+
+
+String TableSnapshot::snapshotName (const String& tableName,
+                                    const String& name)
+{
+  return rootName (Path(tableName).absoluteName()) + '/' + name;
+}
+
+Vector<String> TableSnapshot::names (const String& tableName)
+{
+  std::vector<String> names = readNames (Path(tableName).absoluteName());
+  return Vector<String> (names.begin(), names.end());
+}
+
+void TableSnapshot::create (Table& table, const String& name)
+{
+  if (name.empty()  ||  name.contains('/')) {
+    throw TableError ("TableSnapshot: invalid snapshot name '" + name + "'");
+  }
+  if (table.tableType() != Table::Plain) {
+    throw TableError ("TableSnapshot: only a plain table can be snapshotted");
+  }
+  if (table.isMultiUsed()) {
+    throw TableError ("TableSnapshot: table " + table.tableName() +
+                      " is used by another process");
+  }
+  const String& tableName = table.tableName();
+  std::vector<String> names = readNames (tableName);
+  for (const String& nm : names) {
+    if (nm == name) {
+      throw TableError ("TableSnapshot: table " + tableName +
+                        " already has a snapshot " + name);
+    }
+  }
+  // Write all data and the table control info before the snapshot is made.
+  dynamic_cast<PlainTable*>(table.baseTablePtr())->flushAll();
+  // Get the files that can be snapshotted using copy-on-write.
+  std::set<String> cowSet;
+  std::set<DataManager*> dmSet;
+  const TableDesc& td = table.tableDesc();
+  for (uInt i=0; i<td.ncolumn(); ++i) {
+    dmSet.insert (table.findDataManager (td[i].name(), True));
+  }
+  for (DataManager* dm : dmSet) {
+    Vector<String> files = dm->snapshotFiles();
+    for (const String& file : files) {
+      cowSet.insert (Path(file).baseName());
+    }
+  }
+  // Create the snapshot directory. Make the logs for the copy-on-write
+  // files and copy the other ones.
+  String snapDir = snapshotName (tableName, name);
+  if (! File(rootName(tableName)).exists()) {
+    Directory(rootName(tableName)).create();
+  }
+  Directory(snapDir).create();
+  std::vector<std::pair<String,std::shared_ptr<BucketSnapshotLog>>> logs;
+  for (const String& file : plainFiles (tableName)) {
+    if (cowSet.find(file) != cowSet.end()) {
+      logs.push_back (std::make_pair (tableName + '/' + file,
+                                      BucketSnapshotLog::create
+                                      (snapDir + '/' + file + ".cow",
+                                       tableName + '/' + file)));
+    } else {
+      DOos::copy (snapDir + '/' + file, tableName + '/' + file);
+    }
+  }
+  // Only the logs of the latest snapshot are active.
+  if (! names.empty()) {
+    activate (tableName, snapshotName (tableName, names.back()), False);
+  }
+  names.push_back (name);
+  writeNames (tableName, names);
+  for (const auto& log : logs) {
+    BucketSnapshotLog::setActive (log.first, log.second);
+  }
+}
+
+Table TableSnapshot::open (const String& tableName, const String& name,
+                           const TableLock& lockOptions)
+{
+  String tabName = Path(tableName).absoluteName();
+  std::vector<String> names = readNames (tabName);
+  uInt k = findName (tabName, names, name);
+  String snapDir = snapshotName (tabName, name);
+  // Register the views on the copy-on-write files.
+  Vector<String> files = cowFiles (snapDir);
+  for (const String& file : files) {
+    BucketSnapshotView::set (snapDir + '/' + file,
+                             makeView (tabName, names, k, file));
+  }
+  return Table (snapDir, lockOptions, Table::Old,
+                TSMOption (TSMOption::Cache));
+}
+
+void TableSnapshot::restore (const String& tableName, const String& name)
+{
+  String tabName = Path(tableName).absoluteName();
+  if (Table::isOpened (tabName)) {
+    throw TableError ("TableSnapshot::restore: table " + tabName +
+                      " is still open");
+  }
+  std::vector<String> names = readNames (tabName);
+  uInt k = findName (tabName, names, name);
+  checkNotOpen (tabName, names);
+  BucketSnapshotView::remove (rootName (tabName));
+  String snapDir = snapshotName (tabName, name);
+  // Restore the copy-on-write files by applying the logs in reverse order
+  // on top of the base file.
+  Vector<String> files = cowFiles (snapDir);
+  for (const String& file : files) {
+    String fileName = tabName + '/' + file;
+    BucketSnapshotView view = makeView (tabName, names, k, file);
+    if (view.baseName != fileName) {
+      DOos::copy (fileName, view.baseName);
+    }
+    int fd = (File(fileName).exists()  ?
+              FiledesIO::open (fileName.chars(), True) :
+              FiledesIO::create (fileName.chars()));
+    FiledesIO fio (fd, fileName);
+    for (Int i=view.logs.size()-1; i>=0; --i) {
+      const BucketSnapshotLog& log = *view.logs[i];
+      std::vector<char> block(log.blockSize());
+      for (Int64 bnr : log.blockNrs()) {
+        log.readBlock (bnr, block.data());
+        fio.pwrite (log.blockSize(), bnr * log.blockSize(), block.data());
+      }
+    }
+    fio.truncate (view.logs[0]->fileLength());
+    fio.fsync();
+    FiledesIO::close (fd);
+  }
+  // Copy the other files back and remove the files created later.
+  std::vector<String> snapFiles = plainFiles (snapDir);
+  std::set<String> fileSet (files.begin(), files.end());
+  for (const String& file : snapFiles) {
+    if (! (file.size() > 4  &&  file.substr (file.size()-4) == ".cow")) {
+      DOos::copy (tabName + '/' + file, snapDir + '/' + file);
+      fileSet.insert (file);
+    }
+  }
+  for (const String& file : plainFiles (tabName)) {
+    if (fileSet.find(file) == fileSet.end()) {
+      DOos::remove (tabName + '/' + file, False);
+    }
+  }
+  // The lock file contains the number of rows of the current table,
+  // so remove it. It is recreated when the table is opened.
+  DOos::remove (tabName + "/table.lock", False, False);
+  // Remove the later snapshots and start with empty logs.
+  activate (tabName, snapshotName (tabName, names.back()), False);
+  for (uInt j=k+1; j<names.size(); ++j) {
+    DOos::remove (snapshotName (tabName, names[j]), True);
+  }
+  names.resize (k+1);
+  writeNames (tabName, names);
+  for (const String& file : files) {
+    BucketSnapshotLog::create (snapDir + '/' + file + ".cow",
+                               tabName + '/' + file);
+  }
+  activate (tabName, snapDir, True);
+}
+
+void TableSnapshot::remove (const String& tableName, const String& name)
+{
+  String tabName = Path(tableName).absoluteName();
+  std::vector<String> names = readNames (tabName);
+  uInt k = findName (tabName, names, name);
+  checkNotOpen (tabName, names);
+  BucketSnapshotView::remove (rootName (tabName));
+  String snapDir = snapshotName (tabName, name);
+  // The blocks changed after this snapshot, but not after the previous
+  // one, are only saved in this snapshot. Move them to the previous one.
+  if (k > 0) {
+    String prevDir = snapshotName (tabName, names[k-1]);
+    Vector<String> files = cowFiles (prevDir);
+    for (const String& file : files) {
+      std::shared_ptr<BucketSnapshotLog> prevLog =
+        BucketSnapshotLog::open (prevDir + '/' + file + ".cow");
+      std::vector<char> block(prevLog->blockSize());
+      String cowName = snapDir + '/' + file + ".cow";
+      String copyName = snapDir + '/' + file;
+      if (File(cowName).exists()) {
+        std::shared_ptr<BucketSnapshotLog> log =
+          BucketSnapshotLog::open (cowName);
+        for (Int64 bnr : log->blockNrs()) {
+          if (! prevLog->hasBlock (bnr)) {
+            log->readBlock (bnr, block.data());
+            prevLog->addBlock (bnr, block.data());
+          }
+        }
+      } else if (File(copyName).exists()) {
+        int fd = FiledesIO::open (copyName.chars());
+        FiledesIO fio (fd, copyName);
+        for (Int64 bnr=0; bnr<prevLog->nblocks(); ++bnr) {
+          if (! prevLog->hasBlock (bnr)) {
+            Int64 n = fio.pread (block.size(), bnr * block.size(),
+                                 block.data(), False);
+            memset (block.data() + std::max(n, Int64(0)), 0,
+                    block.size() - std::max(n, Int64(0)));
+            prevLog->addBlock (bnr, block.data());
+          }
+        }
+        FiledesIO::close (fd);
+      }
+      prevLog->fsync();
+    }
+  }
+  // If it is the latest snapshot, the previous one becomes active.
+  Bool isLatest = (k == names.size() - 1);
+  if (isLatest) {
+    activate (tabName, snapDir, False);
+  }
+  DOos::remove (snapDir, True);
+  names.erase (names.begin() + k);
+  writeNames (tabName, names);
+  if (isLatest  &&  k > 0) {
+    activate (tabName, snapshotName (tabName, names[k-1]), True);
+  }
+}
+
+Bool TableSnapshot::attach (const String& tableName)
+{
+  String tabName = Path(tableName).absoluteName();
+  if (! File(rootName(tabName) + "/names").exists()) {
+    return False;
+  }
+  std::vector<String> names = readNames (tabName);
+  if (names.empty()) {
+    return False;
+  }
+  // Activate the logs of the latest snapshot if not done yet.
+  String snapDir = snapshotName (tabName, names.back());
+  Vector<String> files = cowFiles (snapDir);
+  for (const String& file : files) {
+    String fileName = tabName + '/' + file;
+    String logName = Path(snapDir + '/' + file + ".cow").absoluteName();
+    std::shared_ptr<BucketSnapshotLog> log =
+      BucketSnapshotLog::getActive (fileName);
+    if (!log  ||  log->name() != logName) {
+      BucketSnapshotLog::setActive (fileName,
+                                    BucketSnapshotLog::open (logName));
+    }
+  }
+  return True;
+}
+
+} //# NAMESPACE CASACORE - END
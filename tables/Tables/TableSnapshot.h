@@ -0,0 +1,149 @@
+//# TableSnapshot.h: Class with static functions for table snapshots
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This library is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU Library General Public License as published by
+//# the Free Software Foundation; either version 2 of the License, or (at your
+//# option) any later version.
+//#
+//# This library is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Library General Public
+//# License for more details.
+//#
+//# You should have received a copy of the GNU Library General Public License
+//# along with this library; if not, write to the Free Software Foundation,
+//# Inc., 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#ifndef TABLES_TABLESNAPSHOT_H
+#define TABLES_TABLESNAPSHOT_H
+
+
+//# Includes
+#include <casacore/casa/aips.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableLock.h>
+#include <casacore/casa/Arrays/Vector.h>
+#include <casacore/casa/BasicSL/String.h>
+
+namespace casacore { //# NAMESPACE CASACORE - BEGIN
+
+// <summary>
+// Class with static functions for copy-on-write snapshots of a table.
+// </summary>
+
+// <use visibility=export>
+
+// <reviewed reviewer="" date="" tests="tTableSnapshot">
+// </reviewed>
+
+// <prerequisite>
+//# Classes you should understand before using this one.
+//   <li> Table
+//   <li> BucketSnapshotLog
+// </prerequisite>
+
+// <synopsis>
+// TableSnapshot makes cheap checkpoints of a plain table, for example
+// before flagging or calibrating it. Instead of copying the table,
+// the bucket files of StandardStMan, IncrementalStMan, and the hypercube
+// files of the TiledStMan storage managers are snapshotted using
+// copy-on-write. A snapshot records only the blocks of these files that
+// are changed after it has been made (see class BucketSnapshotLog),
+// so making it takes very little time and space.
+// All other files of the table (e.g. table.dat and the files of other
+// data managers) are small and are copied.
+// <p>
+// The snapshots are kept in the subdirectory <src>table.snapshots</src>
+// of the table. Each snapshot has its own directory containing the
+// copied files and the copy-on-write logs.
+// <br>The following functions are available:
+// <ul>
+//  <li> <src>create</src> makes a snapshot of the table.
+//  <li> <src>names</src> gives the names of the snapshots in order of
+//       creation.
+//  <li> <src>open</src> opens a snapshot as a read-only table. The blocks
+//       not changed since the snapshot are read from the table's files.
+//  <li> <src>restore</src> puts the table back in the state of a snapshot.
+//       The later snapshots are removed.
+//  <li> <src>remove</src> removes a snapshot. Its blocks still needed
+//       by the previous snapshot are moved to that snapshot.
+// </ul>
+// Note the following:
+// <ul>
+//  <li> A snapshot only contains the table itself, not its subtables.
+//  <li> Only the process making a snapshot and processes opening the
+//       table thereafter save the changed blocks. Therefore the table
+//       must not be used by other processes when the snapshot is made.
+//  <li> A table having snapshots is opened with the TSMOption
+//       <src>Cache</src> (unless <src>Direct</src> is given), because only
+//       unbuffered writes take part in copy-on-write. If a TiledStMan uses
+//       memory-mapped or buffered IO when the snapshot is made, its files
+//       are copied.
+//  <li> Files in a MultiFile container are copied.
+//  <li> A snapshot opened as a table must be closed before the snapshots
+//       of the table are restored or removed.
+// </ul>
+// </synopsis>
+
+// <example>
+// <srcblock>
+//   Table tab("my.ms", Table::Update);
+//   TableSnapshot::create (tab, "beforeFlagging");
+//   ... flag the data in tab
+//   // Look at the old flags.
+//   Table old = TableSnapshot::open ("my.ms", "beforeFlagging");
+//   ...
+//   // Go back to the old state.
+//   old = Table();
+//   tab = Table();
+//   TableSnapshot::restore ("my.ms", "beforeFlagging");
+// </srcblock>
+// </example>
+
+class TableSnapshot
+{
+public:
+  // Make a snapshot with the given name of a plain table.
+  // The table is flushed first. An exception is thrown if a snapshot
+  // with that name already exists or if the table is used by another process.
+  static void create (Table& table, const String& name);
+
+  // Get the names of the snapshots of the table in order of creation.
+  static Vector<String> names (const String& tableName);
+
+  // Open the given snapshot of the table as a read-only table.
+  static Table open (const String& tableName, const String& name,
+                     const TableLock& lockOptions =
+                                   TableLock(TableLock::AutoNoReadLocking));
+
+  // Restore the table to the state of the given snapshot.
+  // The snapshot is kept, but all later snapshots are removed.
+  // The table and its snapshots must not be open.
+  static void restore (const String& tableName, const String& name);
+
+  // Remove the given snapshot.
+  // The table snapshots must not be open.
+  static void remove (const String& tableName, const String& name);
+
+  // Get the name of the directory holding the given snapshot.
+  static String snapshotName (const String& tableName, const String& name);
+
+  // Activate the copy-on-write logs of the latest snapshot of the table.
+  // It returns False if the table has no snapshots.
+  // It is called when a plain table is opened.
+  static Bool attach (const String& tableName);
+};
+
+
+} //# NAMESPACE CASACORE - END
+
+#endif
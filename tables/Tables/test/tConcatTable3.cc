@@ -32,6 +32,8 @@
 #include <casacore/tables/TaQL/ExprNode.h>
 #include <casacore/casa/IO/ArrayIO.h>
 #include <casacore/casa/Arrays/ArrayUtil.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
 #include <casacore/casa/Containers/Block.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
@@ -86,6 +88,50 @@ void checkTable (Int stval, uInt nrow)
   }
 }
 
+// Check getting and putting ranges and cells spanning multiple tables.
+void checkCells()
+{
+  Table tab("tConcatTable3_tmp.conctab", Table::Update);
+  ScalarColumn<Int> aint(tab, "aint");
+  // A strided range spanning all tables.
+  Vector<Int> vec = aint.getColumnRange (Slicer(IPosition(1,3), IPosition(1,31),
+                                                IPosition(1,3),
+                                                Slicer::endIsLast));
+  AlwaysAssertExit (vec.size() == 10);
+  for (uInt i=0; i<vec.size(); ++i) {
+    AlwaysAssertExit (vec[i] == Int(3+3*i));
+  }
+  // Multiple slices, partly in the same table.
+  Vector<rownr_t> slices(9);
+  slices[0] = 8;  slices[1] = 12; slices[2] = 2;
+  slices[3] = 29; slices[4] = 34; slices[5] = 1;
+  slices[6] = 0;  slices[7] = 4;  slices[8] = 4;
+  vec = aint.getColumnCells (RefRows(slices, True));
+  AlwaysAssertExit (vec.size() == 11);
+  Int expSliced[] = {8,10,12,29,30,31,32,33,34,0,4};
+  for (uInt i=0; i<vec.size(); ++i) {
+    AlwaysAssertExit (vec[i] == expSliced[i]);
+  }
+  // Individual rows alternating between the tables.
+  Vector<rownr_t> rows(6);
+  rows[0] = 31; rows[1] = 2; rows[2] = 15;
+  rows[3] = 5;  rows[4] = 33; rows[5] = 14;
+  vec = aint.getColumnCells (rows);
+  for (uInt i=0; i<rows.size(); ++i) {
+    AlwaysAssertExit (vec[i] == Int(rows[i]));
+  }
+  // Put negated values in those rows and check them.
+  aint.putColumnCells (rows, -vec);
+  for (uInt i=0; i<rows.size(); ++i) {
+    AlwaysAssertExit (aint(rows[i]) == -Int(rows[i]));
+  }
+  AlwaysAssertExit (allEQ (aint.getColumnCells(rows), -vec));
+  aint.putColumnCells (RefRows(slices, True), Vector<Int>(11, 0));
+  for (uInt i=0; i<11; ++i) {
+    AlwaysAssertExit (aint(expSliced[i]) == 0);
+  }
+}
+
 void concatTables()
 {
   Block<String> names(3);
@@ -104,6 +150,7 @@ int main()
     createTable ("tConcatTable3_tmp.tab3", 30, 5);
     concatTables();
     checkTable (0, 35);
+    checkCells();
   } catch (std::exception& x) {
     cout << "Exception caught: " << x.what() << endl;
     return 1;
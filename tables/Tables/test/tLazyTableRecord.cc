@@ -0,0 +1,217 @@
+//# tLazyTableRecord.cc: Test deferred reading of keyword sets
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+
+#include <casacore/tables/Tables/LazyTableRecord.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/TableRecord.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/casa/IO/AipsIO.h>
+#include <casacore/casa/IO/MemoryIO.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for class LazyTableRecord.
+// </summary>
+
+// This program tests if the keyword sets of a table and its columns,
+// which are read when first accessed, are correct in various situations.
+
+
+// Fill a keyword set with some values.
+void fillKeys (TableRecord& rec, Int value)
+{
+  rec.define ("i4", value);
+  rec.define ("str", "str" + String::toString(value));
+  Vector<Double> vec(5);
+  indgen (vec, Double(value));
+  rec.define ("arr", vec);
+  TableRecord sub;
+  sub.define ("i4", value+1);
+  rec.defineRecord ("sub", sub);
+}
+
+// Check a keyword set filled by fillKeys.
+void checkKeys (const TableRecord& rec, Int value)
+{
+  AlwaysAssertExit (rec.nfields() >= 4);
+  AlwaysAssertExit (rec.asInt("i4") == value);
+  AlwaysAssertExit (rec.asString("str") == "str" + String::toString(value));
+  Vector<Double> vec(5);
+  indgen (vec, Double(value));
+  AlwaysAssertExit (allEQ (rec.asArrayDouble("arr"), vec));
+  AlwaysAssertExit (rec.subRecord("sub").asInt("i4") == value+1);
+}
+
+void createTable (const String& name)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("col1"));
+  td.addColumn (ScalarColumnDesc<Int>("col2"));
+  SetupNewTable newtab(name, td, Table::New);
+  Table tab(newtab, 10);
+  fillKeys (tab.rwKeywordSet(), 1);
+  fillKeys (TableColumn(tab, "col1").rwKeywordSet(), 2);
+  fillKeys (TableColumn(tab, "col2").rwKeywordSet(), 3);
+  // Add a subtable.
+  SetupNewTable subtab(name + "/SUB", td, Table::New);
+  Table sub(subtab, 5);
+  fillKeys (sub.rwKeywordSet(), 4);
+  tab.rwKeywordSet().defineTable ("SUB", sub);
+}
+
+void checkTable (const String& name)
+{
+  Table tab(name);
+  checkKeys (tab.keywordSet(), 1);
+  checkKeys (TableColumn(tab, "col1").keywordSet(), 2);
+  checkKeys (TableColumn(tab, "col2").keywordSet(), 3);
+  Table sub = tab.keywordSet().asTable ("SUB");
+  AlwaysAssertExit (sub.nrow() == 5);
+  checkKeys (sub.keywordSet(), 4);
+}
+
+// Copy the descriptions before the keywords are accessed.
+void checkCopy (const String& name)
+{
+  std::unique_ptr<TableDesc> td;
+  {
+    Table tab(name);
+    td.reset (new TableDesc (tab.tableDesc(), "", "", TableDesc::Scratch));
+  }
+  checkKeys (td->keywordSet(), 1);
+  checkKeys ((*td)["col1"].keywordSet(), 2);
+  ColumnDesc cd ((*td)["col2"]);
+  checkKeys (cd.keywordSet(), 3);
+  // Copying a table has to copy the keywords.
+  Table(name).deepCopy (name + "_copy", Table::New);
+  checkTable (name + "_copy");
+}
+
+// Update some keywords without accessing the others.
+void updateTable (const String& name)
+{
+  {
+    Table tab(name, Table::Update);
+    TableColumn(tab, "col2").rwKeywordSet().define ("new", 10);
+  }
+  checkTable (name);
+  {
+    Table tab(name);
+    AlwaysAssertExit (TableColumn(tab, "col2").keywordSet().asInt("new")
+                      == 10);
+  }
+  // Rename the table; the subtable has to be found.
+  {
+    Table tab(name, Table::Update);
+    tab.rename (name + "_ren", Table::New);
+  }
+  checkTable (name + "_ren");
+}
+
+// Access the keywords (not read yet) from multiple threads at the same time.
+void checkThreads (const String& name)
+{
+  std::unique_ptr<TableDesc> td;
+  {
+    Table tab(name);
+    td.reset (new TableDesc (tab.tableDesc(), "", "", TableDesc::Scratch));
+  }
+  const TableDesc& ctd = *td;
+  std::vector<std::thread> threads;
+  for (uInt i=0; i<4; ++i) {
+    threads.push_back (std::thread ([&ctd]() {
+          checkKeys (ctd.keywordSet(), 1);
+          checkKeys (ctd["col1"].keywordSet(), 2);
+          checkKeys (ctd["col2"].keywordSet(), 3);
+        }));
+  }
+  for (std::thread& thr : threads) {
+    thr.join();
+  }
+}
+
+// Test reading and interpreting the raw bytes of a nested object.
+void testRawObject()
+{
+  std::shared_ptr<MemoryIO> mio (new MemoryIO());
+  TableRecord rec;
+  fillKeys (rec, 5);
+  {
+    AipsIO ios (mio);
+    ios.putstart ("Test", 1);
+    ios << Int(1);
+    rec.putRecord (ios, TableAttr());
+    ios << Int(2);
+    ios.putend();
+  }
+  mio->seek (0);
+  AipsIO ios (mio);
+  AlwaysAssertExit (ios.getstart ("Test") == 1);
+  Int value;
+  ios >> value;
+  AlwaysAssertExit (value == 1);
+  std::shared_ptr<LazyTableRecord> lazy = LazyTableRecord::read (ios,
+                                                                 TableAttr());
+  AlwaysAssertExit (lazy.get() != 0);
+  ios >> value;
+  AlwaysAssertExit (value == 2);
+  ios.getend();
+  TableRecord rec2;
+  lazy->get (rec2);
+  checkKeys (rec2, 5);
+  // It can be interpreted multiple times.
+  TableRecord rec3;
+  lazy->get (rec3);
+  checkKeys (rec3, 5);
+}
+
+int main()
+{
+  try {
+    testRawObject();
+    createTable ("tLazyTableRecord_tmp.data");
+    checkTable ("tLazyTableRecord_tmp.data");
+    checkCopy ("tLazyTableRecord_tmp.data");
+    checkThreads ("tLazyTableRecord_tmp.data");
+    updateTable ("tLazyTableRecord_tmp.data");
+  } catch (std::exception& x) {
+    cout << "Caught an exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;                           // exit with success status
+}
@@ -28,15 +28,23 @@
 #include <casacore/tables/Tables/Table.h>
 #include <casacore/tables/Tables/ScaColDesc.h>
 #include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/RefRows.h>
+#include <casacore/tables/TaQL/ExprNode.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/IO/RegularFileIO.h>
+#include <casacore/casa/System/AipsrcValue.h>
 #include <casacore/casa/Utilities/Assert.h>
 #include <casacore/casa/Exceptions/Error.h>
 #include <casacore/casa/iostream.h>
 #include <casacore/casa/stdio.h>
+#include <numeric>
+#include <vector>
 
 #include <casacore/casa/namespace.h>
 
 // <summary>
-// Test program for RefTable::addColumn
+// Test program for RefTable::addColumn and for RefTables with row ranges
 // </summary>
 
 void readTab (const String& tabName, uInt nrow, uInt ncol)
@@ -106,6 +114,211 @@ void makeRef()
   readTab ("tRefTable_tmp.dataref", 10, 4);
 }
 
+// Make a RefTable of the given rows and check that column gets and puts
+// on it are done correctly after it has been written and read back.
+// If the rows form a few blocks, the row numbers are stored as ranges.
+void checkRef (const Vector<rownr_t>& rownrs, const String& name)
+{
+  Table tab("tRefTable_tmp.data", Table::Update);
+  Table reftab = tab(rownrs);
+  reftab.rename (name, Table::New);
+  reftab.flush();
+  Table seltab(name, Table::Update);
+  AlwaysAssertExit (seltab.nrow() == rownrs.size());
+  AlwaysAssertExit (allEQ (seltab.rowNumbers(tab), rownrs));
+  ScalarColumn<Int> ab(seltab, "ab");
+  Vector<Int> vals = ab.getColumn();
+  for (uInt i=0; i<rownrs.size(); ++i) {
+    AlwaysAssertExit (vals[i] == Int(rownrs[i]));
+  }
+  Vector<rownr_t> cells(3);
+  cells[0] = 1;
+  cells[1] = 2;
+  cells[2] = 5;
+  vals = ab.getColumnCells (RefRows(cells));
+  for (uInt i=0; i<cells.size(); ++i) {
+    AlwaysAssertExit (vals[i] == Int(rownrs[cells[i]]));
+  }
+  vals = ab.getColumnRange (Slicer(IPosition(1,2), IPosition(1,4)));
+  for (uInt i=0; i<4; ++i) {
+    AlwaysAssertExit (vals[i] == Int(rownrs[i+2]));
+  }
+  // Put via the RefTable and check in the parent.
+  ScalarColumn<Int> acref(seltab, "ac");
+  Vector<Int> acvals = acref.getColumn();
+  acref.putColumn (acvals * 10);
+  ScalarColumn<Int> ac(tab, "ac");
+  for (uInt i=0; i<rownrs.size(); ++i) {
+    AlwaysAssertExit (ac(rownrs[i]) == 10*Int(rownrs[i]+1));
+  }
+  acref.putColumn (acvals);
+}
+
+// Get the version of the RefTable object in the table.dat file.
+// It is the (canonical) uInt following the second RefTable type name
+// (the first one is the table type).
+uInt refVersion (const String& name)
+{
+  RegularFileIO file (RegularFile(name + "/table.dat"));
+  Vector<uChar> buf(file.length());
+  file.read (buf.size(), buf.data());
+  String str ((const char*)(buf.data()), buf.size());
+  String::size_type pos = str.find ("RefTable");
+  AlwaysAssertExit (pos != String::npos);
+  pos = str.find ("RefTable", pos + 8);
+  AlwaysAssertExit (pos != String::npos);
+  const uChar* vers = buf.data() + pos + 8;
+  return (uInt(vers[0]) << 24) + (uInt(vers[1]) << 16) +
+         (uInt(vers[2]) << 8) + vers[3];
+}
+
+void checkRefs()
+{
+  // Rows in a single block.
+  Vector<rownr_t> rownrs(8);
+  indgen (rownrs, rownr_t(2));
+  checkRef (rownrs, "tRefTable_tmp.datablk");
+  // Scattered rows.
+  rownrs.resize (7);
+  rownrs[0] = 0;
+  rownrs[1] = 1;
+  rownrs[2] = 2;
+  rownrs[3] = 5;
+  rownrs[4] = 7;
+  rownrs[5] = 8;
+  rownrs[6] = 9;
+  checkRef (rownrs, "tRefTable_tmp.datasct");
+  // Rows in a single block are stored as a range (unless disabled).
+  rownrs.resize (8);
+  indgen (rownrs, rownr_t(2));
+  uInt compactReg = AipsrcValue<Bool>::registerRC
+                      ("table.reftable.compactrows", True);
+  AipsrcValue<Bool>::set (compactReg, False);
+  checkRef (rownrs, "tRefTable_tmp.datablkc");
+  AipsrcValue<Bool>::set (compactReg, True);
+  AlwaysAssertExit (refVersion("tRefTable_tmp.datablk") == 4);
+  AlwaysAssertExit (refVersion("tRefTable_tmp.datasct") < 4);
+  AlwaysAssertExit (refVersion("tRefTable_tmp.datablkc") < 4);
+}
+
+// Check that the row numbers and values of a selection are as expected.
+void checkSel (const Table& tab, const Table& sel,
+               const std::vector<rownr_t>& rows)
+{
+  AlwaysAssertExit (sel.nrow() == rows.size());
+  AlwaysAssertExit (allEQ (sel.rowNumbers(tab), Vector<rownr_t>(rows)));
+  Vector<Int> ids = ScalarColumn<Int>(sel, "id").getColumn();
+  for (uInt i=0; i<rows.size(); ++i) {
+    AlwaysAssertExit (ids[i] == Int(rows[i]));
+  }
+  // Get every third row (which crosses the runs of rows).
+  if (rows.size() > 0) {
+    ids = ScalarColumn<Int>(sel, "id").getColumnCells
+      (RefRows(0, rows.size()-1, 3));
+    for (uInt i=0; i<ids.size(); ++i) {
+      AlwaysAssertExit (ids[i] == Int(rows[3*i]));
+    }
+  }
+}
+
+// A selection of blocks or strided rows is kept in memory as runs of rows.
+// Check selecting from it, removing rows from it, and writing it.
+void checkRuns()
+{
+  const rownr_t nrow = 1000;
+  TableDesc td("", "1", TableDesc::Scratch);
+  td.addColumn (ScalarColumnDesc<Int>("id"));
+  SetupNewTable newtab("tRefTable_tmp.runs", td, Table::New);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> id(tab, "id");
+  for (rownr_t i=0; i<nrow; ++i) {
+    id.put (i, i);
+  }
+  std::vector<rownr_t> rows;
+  for (rownr_t i=100; i<300; ++i) rows.push_back (i);
+  for (rownr_t i=500; i<900; i+=4) rows.push_back (i);
+  rows.push_back (950);
+  Table sel = tab(Vector<rownr_t>(rows));
+  checkSel (tab, sel, rows);
+  // Select from the selection.
+  Table sel2 = sel(sel.col("id") >= 200);
+  std::vector<rownr_t> rows2 (rows.begin() + 100, rows.end());
+  checkSel (tab, sel2, rows2);
+  // Remove the first, a middle and the last row of runs.
+  rownr_t rem[] = {0, 50, 98, 99, 150, rows2.size()-10};
+  for (uInt i=0; i<6; ++i) {
+    sel2.removeRow (rem[i]);
+    rows2.erase (rows2.begin() + rem[i]);
+    checkSel (tab, sel2, rows2);
+  }
+  // Write and read it back.
+  sel2.rename ("tRefTable_tmp.runsref", Table::New);
+  sel2.flush();
+  AlwaysAssertExit (refVersion("tRefTable_tmp.runsref") == 4);
+  checkSel (tab, Table("tRefTable_tmp.runsref"), rows2);
+  // Projecting the table keeps all rows as a single run.
+  std::vector<rownr_t> all(nrow);
+  std::iota (all.begin(), all.end(), 0);
+  checkSel (tab, tab.project(Block<String>(1, "id")), all);
+}
+
+// Check that the rows of a logical operation result match the mask.
+void checkRows (const Table& tab, const Vector<Bool>& expect)
+{
+  Vector<rownr_t> rows = tab.rowNumbers();
+  AlwaysAssertExit (rows.size() == ntrue(expect));
+  for (rownr_t i=0; i<rows.size(); ++i) {
+    AlwaysAssertExit (expect[rows[i]]);
+    AlwaysAssertExit (i == 0  ||  rows[i] > rows[i-1]);
+  }
+}
+
+// Check the logical operations on tables.
+// Depending on density and order of the row numbers, they are done
+// by merging the sorted row numbers or by using a bit mask.
+// The bit mask is divided in chunks of 65536 rows, which are stored
+// as a list of rows if sparse, so use a table with multiple chunks.
+void checkLogic (const String& name, rownr_t nrow)
+{
+  SetupNewTable newtab(name,
+                       TableDesc("", "1", TableDesc::Scratch), Table::New);
+  Table tab(newtab, nrow);
+  // Make a sparse and a dense selection in row order, a selection
+  // with its rows in reversed order, and a selection with alternating
+  // dense and sparse blocks of rows.
+  Vector<Bool> sparse(nrow), dense(nrow), unord(nrow), block(nrow);
+  std::vector<rownr_t> rs, rd, ru, rb;
+  for (rownr_t i=0; i<nrow; ++i) {
+    sparse[i] = (i%97 == 3);
+    dense[i]  = (i%3 != 0);
+    unord[i]  = (i%5 < 2);
+    block[i]  = ((i/50000)%2 == 0  ?  i%4 == 0 : i%1000 == 1);
+    if (sparse[i]) rs.push_back (i);
+    if (dense[i])  rd.push_back (i);
+    if (block[i])  rb.push_back (i);
+  }
+  for (rownr_t i=nrow; i>0; --i) {
+    if (unord[i-1]) ru.push_back (i-1);
+  }
+  Table tsparse = tab(Vector<rownr_t>(rs));
+  Table tdense  = tab(Vector<rownr_t>(rd));
+  Table tunord  = tab(Vector<rownr_t>(ru));
+  Table tblock  = tab(Vector<rownr_t>(rb));
+  const Table* tabs[]   = {&tsparse, &tdense, &tunord, &tblock};
+  const Vector<Bool>* masks[] = {&sparse, &dense, &unord, &block};
+  for (uInt i=0; i<4; ++i) {
+    checkRows (!*tabs[i], !*masks[i]);
+    for (uInt j=0; j<4; ++j) {
+      checkRows (*tabs[i] & *tabs[j], *masks[i] && *masks[j]);
+      checkRows (*tabs[i] | *tabs[j], *masks[i] || *masks[j]);
+      checkRows (*tabs[i] - *tabs[j], *masks[i] && !*masks[j]);
+      checkRows (*tabs[i] ^ *tabs[j], *masks[i] != *masks[j]);
+    }
+  }
+  // Operations on a result of an operation (with exact row storage).
+  checkRows ((tsparse | tunord) & tdense, (sparse || unord) && dense);
+}
+
 int main()
 {
   try {
@@ -113,6 +326,10 @@ int main()
     makeRef();
     readTab ("tRefTable_tmp.data", 10, 5);
     readTab ("tRefTable_tmp.dataref", 10, 4);
+    checkRefs();
+    checkRuns();
+    checkLogic ("tRefTable_tmp.logic", 10000);
+    checkLogic ("tRefTable_tmp.logic2", 200000);
   } catch (std::exception& x) {
     cout << "Caught an exception: " << x.what() << endl;
     return 1;
@@ -0,0 +1,282 @@
+//# tTableCommit.cc: Test lock-free readers of a table publishing its commits
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/TableCommit.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/IO/MemoryIO.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for lock-free readers of a table publishing its commits.
+// </summary>
+
+// A child process appends rows to a table while holding a permanent
+// write lock. The parent process reads the table without locking and
+// checks that it sees the committed rows after each resync.
+// Pipes are used to step both processes.
+
+const String tabName = "tTableCommit_tmp.data";
+
+Array<Float> arrValue (rownr_t row)
+{
+  Array<Float> arr(IPosition(2,4,16));
+  indgen (arr, Float(row*100));
+  return arr;
+}
+
+void createTable()
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("ssm"));
+  td.addColumn (ScalarColumnDesc<Int>("ism"));
+  td.addColumn (ArrayColumnDesc<Float>("tsm", IPosition(2,4,16),
+                                       ColumnDesc::FixedShape));
+  SetupNewTable newtab(tabName, td, Table::New);
+  StandardStMan ssm("SSM", 512);
+  IncrementalStMan ism("ISM", 512);
+  TiledShapeStMan tsm("TSM", IPosition(3,4,16,8));
+  newtab.bindColumn ("ssm", ssm);
+  newtab.bindColumn ("ism", ism);
+  newtab.bindColumn ("tsm", tsm);
+  Table tab(newtab);
+  // Publishing is not possible for a reference table.
+  Bool ok = False;
+  try {
+    Table ref = tab.project (Block<String>(1, "ssm"));
+    ref.publishCommits();
+  } catch (AipsError&) {
+    ok = True;
+  }
+  AlwaysAssertExit (ok);
+  tab.publishCommits();
+  AlwaysAssertExit (TableCommit::exists (tabName));
+}
+
+void addRows (Table& tab, rownr_t nrow)
+{
+  ScalarColumn<Int> ssmCol(tab, "ssm");
+  ScalarColumn<Int> ismCol(tab, "ism");
+  ArrayColumn<Float> tsmCol(tab, "tsm");
+  rownr_t start = tab.nrow();
+  tab.addRow (nrow);
+  for (rownr_t i=start; i<start+nrow; ++i) {
+    ssmCol.put (i, i);
+    ismCol.put (i, i/4);
+    tsmCol.put (i, arrValue(i));
+  }
+}
+
+void checkTable (const Table& tab, rownr_t nrow)
+{
+  AlwaysAssertExit (tab.nrow() == nrow);
+  ScalarColumn<Int> ssmCol(tab, "ssm");
+  ScalarColumn<Int> ismCol(tab, "ism");
+  ArrayColumn<Float> tsmCol(tab, "tsm");
+  for (rownr_t i=0; i<nrow; ++i) {
+    AlwaysAssertExit (ssmCol(i) == Int(i));
+    AlwaysAssertExit (ismCol(i) == Int(i/4));
+    AlwaysAssertExit (allEQ (tsmCol(i), arrValue(i)));
+  }
+}
+
+void testCommitFile()
+{
+  // A reader gets the last commit, also while a flush is in progress.
+  TableCommit writer(tabName, True);
+  TableCommit reader(tabName, False);
+  MemoryIO orgInfo;
+  reader.read (orgInfo);
+  AlwaysAssertExit (orgInfo.length() > 0);
+  MemoryIO info;
+  Int64 gen = reader.generation();
+  AlwaysAssertExit (! reader.changed());
+  AlwaysAssertExit (! reader.inProgress());
+  writer.begin();
+  AlwaysAssertExit (reader.inProgress());
+  AlwaysAssertExit (! reader.changed());
+  reader.read (info);
+  AlwaysAssertExit (reader.generation() == gen);
+  AlwaysAssertExit (info.length() == orgInfo.length());
+  MemoryIO newInfo;
+  newInfo.write (3, "abc");
+  writer.end (newInfo);
+  AlwaysAssertExit (! reader.inProgress());
+  AlwaysAssertExit (reader.changed());
+  reader.read (info);
+  AlwaysAssertExit (reader.generation() == gen+1);
+  AlwaysAssertExit (info.length() == 3);
+  AlwaysAssertExit (memcmp (info.getBuffer(), "abc", 3) == 0);
+  // Commits of varying sizes must not overwrite the last one.
+  for (uInt i=0; i<50; ++i) {
+    uInt leng = (i*37) % 200;
+    std::vector<uChar> data(leng, uChar(i));
+    MemoryIO dataInfo;
+    dataInfo.write (leng, data.data());
+    writer.begin();
+    reader.read (info);
+    AlwaysAssertExit (reader.generation() == gen+1+i);
+    writer.end (dataInfo);
+    reader.read (info);
+    AlwaysAssertExit (reader.generation() == gen+2+i);
+    AlwaysAssertExit (info.length() == leng);
+    AlwaysAssertExit (leng == 0  ||
+                      memcmp (info.getBuffer(), data.data(), leng) == 0);
+  }
+  // Publish the original sync data again.
+  writer.begin();
+  writer.end (orgInfo);
+  reader.read (info);
+  AlwaysAssertExit (reader.generation() == gen+52);
+}
+
+// A writer that opened the table before commits were published, starts
+// publishing at its next flush.
+void testLateWriter()
+{
+  const String name = "tTableCommit_tmp.late";
+  {
+    TableDesc td;
+    td.addColumn (ScalarColumnDesc<Int>("ssm"));
+    SetupNewTable newtab(name, td, Table::New);
+    Table tab(newtab, 5);
+  }
+  Table tab(name, Table::Update);
+  // Another process enables publishing.
+  { TableCommit create(name, True, True); }
+  TableCommit reader(name, False);
+  MemoryIO info;
+  reader.read (info);
+  AlwaysAssertExit (info.length() == 0);
+  tab.addRow (3);
+  tab.flush();
+  AlwaysAssertExit (reader.changed());
+  reader.read (info);
+  AlwaysAssertExit (info.length() > 0);
+}
+
+// Write a step number to the pipe and wait for it.
+void sendStep (int fd, char step)
+{
+  AlwaysAssertExit (write (fd, &step, 1) == 1);
+}
+char recvStep (int fd)
+{
+  char step;
+  AlwaysAssertExit (read (fd, &step, 1) == 1);
+  return step;
+}
+
+int writer (int toReader, int fromReader)
+{
+  try {
+    Table tab(tabName, TableLock(TableLock::PermanentLocking),
+              Table::Update);
+    for (int step=1; step<=3; ++step) {
+      addRows (tab, 100);
+      tab.flush();
+      sendStep (toReader, step);
+      recvStep (fromReader);
+    }
+    // Rows not flushed yet are not seen by the reader.
+    addRows (tab, 50);
+    sendStep (toReader, 4);
+    recvStep (fromReader);
+  } catch (std::exception& x) {
+    cout << "Writer caught an exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}
+
+void reader (int fromWriter, int toWriter, pid_t pid)
+{
+  // The writer holds a permanent write lock, so this reader cannot
+  // take a lock.
+  Table tab(tabName, TableLock(TableLock::AutoNoReadLocking));
+  rownr_t nrow = tab.nrow();
+  AlwaysAssertExit (nrow == 10  ||  nrow == 110);
+  for (int step=1; step<=3; ++step) {
+    AlwaysAssertExit (recvStep (fromWriter) == step);
+    tab.resync();
+    checkTable (tab, 10 + step*100);
+    // A resync without a new commit does nothing.
+    tab.resync();
+    checkTable (tab, 10 + step*100);
+    sendStep (toWriter, step);
+  }
+  AlwaysAssertExit (recvStep (fromWriter) == 4);
+  tab.resync();
+  checkTable (tab, 310);
+  sendStep (toWriter, 4);
+  // The writer closes the table, which commits the last rows.
+  int status;
+  AlwaysAssertExit (waitpid (pid, &status, 0) == pid);
+  AlwaysAssertExit (WIFEXITED(status)  &&  WEXITSTATUS(status) == 0);
+  tab.resync();
+  checkTable (tab, 360);
+}
+
+int main()
+{
+  try {
+    createTable();
+    {
+      Table tab(tabName, Table::Update);
+      addRows (tab, 10);
+    }
+    testCommitFile();
+    testLateWriter();
+    int toReader[2], toWriter[2];
+    AlwaysAssertExit (pipe(toReader) == 0  &&  pipe(toWriter) == 0);
+    pid_t pid = fork();
+    AlwaysAssertExit (pid >= 0);
+    if (pid == 0) {
+      _exit (writer (toReader[1], toWriter[0]));
+    }
+    reader (toReader[0], toWriter[1], pid);
+  } catch (std::exception& x) {
+    cout << "Caught an exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;                           // exit with success status
+}
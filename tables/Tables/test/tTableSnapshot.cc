@@ -0,0 +1,209 @@
+//# tTableSnapshot.cc: Test copy-on-write snapshots of a table
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/Tables/TableSnapshot.h>
+#include <casacore/tables/Tables/TableDesc.h>
+#include <casacore/tables/Tables/SetupNewTab.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/tables/Tables/ScaColDesc.h>
+#include <casacore/tables/Tables/ArrColDesc.h>
+#include <casacore/tables/Tables/ScalarColumn.h>
+#include <casacore/tables/Tables/ArrayColumn.h>
+#include <casacore/tables/Tables/TableError.h>
+#include <casacore/tables/DataMan/StandardStMan.h>
+#include <casacore/tables/DataMan/IncrementalStMan.h>
+#include <casacore/tables/DataMan/TiledShapeStMan.h>
+#include <casacore/casa/Arrays/ArrayMath.h>
+#include <casacore/casa/Arrays/ArrayLogical.h>
+#include <casacore/casa/OS/File.h>
+#include <casacore/casa/Utilities/Assert.h>
+#include <casacore/casa/Exceptions/Error.h>
+#include <casacore/casa/iostream.h>
+#include <vector>
+
+#include <casacore/casa/namespace.h>
+
+// <summary>
+// Test program for copy-on-write snapshots of a table.
+// </summary>
+
+// The table has a StandardStMan, IncrementalStMan and TiledShapeStMan
+// column. Each row is written with a generation number, which is kept
+// in a vector (the state). The state at the time of a snapshot is kept
+// to check the snapshot and the restored table.
+
+const String tabName = "tTableSnapshot_tmp.data";
+
+Int cellValue (rownr_t row, Int gen)
+{
+  return row*100 + gen;
+}
+
+Array<Float> arrValue (rownr_t row, Int gen)
+{
+  Array<Float> arr(IPosition(2,8,32));
+  indgen (arr, Float(cellValue(row, gen)));
+  return arr;
+}
+
+void createTable (std::vector<Int>& state, rownr_t nrow)
+{
+  TableDesc td;
+  td.addColumn (ScalarColumnDesc<Int>("ssm"));
+  td.addColumn (ScalarColumnDesc<Int>("ism"));
+  td.addColumn (ArrayColumnDesc<Float>("tsm", IPosition(2,8,32),
+                                       ColumnDesc::FixedShape));
+  SetupNewTable newtab(tabName, td, Table::New,
+                       StorageOption(StorageOption::SepFile));
+  StandardStMan ssm("SSM", 1024);
+  IncrementalStMan ism("ISM", 1024);
+  TiledShapeStMan tsm("TSM", IPosition(3,8,32,4));
+  newtab.bindColumn ("ssm", ssm);
+  newtab.bindColumn ("ism", ism);
+  newtab.bindColumn ("tsm", tsm);
+  Table tab(newtab, nrow);
+  ScalarColumn<Int> ssmCol(tab, "ssm");
+  ScalarColumn<Int> ismCol(tab, "ism");
+  ArrayColumn<Float> tsmCol(tab, "tsm");
+  state.resize (nrow);
+  for (rownr_t i=0; i<nrow; ++i) {
+    state[i] = 0;
+    ssmCol.put (i, cellValue(i, 0));
+    ismCol.put (i, cellValue(i, 0));
+    tsmCol.put (i, arrValue(i, 0));
+  }
+}
+
+// Write the given rows with a new generation.
+void updateRows (Table& tab, std::vector<Int>& state,
+                 rownr_t start, rownr_t end, Int gen)
+{
+  ScalarColumn<Int> ssmCol(tab, "ssm");
+  ScalarColumn<Int> ismCol(tab, "ism");
+  ArrayColumn<Float> tsmCol(tab, "tsm");
+  if (end > tab.nrow()) {
+    tab.addRow (end - tab.nrow());
+    state.resize (end);
+  }
+  for (rownr_t i=start; i<end; ++i) {
+    state[i] = gen;
+    ssmCol.put (i, cellValue(i, gen));
+    ismCol.put (i, cellValue(i, gen));
+    tsmCol.put (i, arrValue(i, gen));
+  }
+  tab.flush();
+}
+
+void checkTable (const Table& tab, const std::vector<Int>& state)
+{
+  AlwaysAssertExit (tab.nrow() == state.size());
+  ScalarColumn<Int> ssmCol(tab, "ssm");
+  ScalarColumn<Int> ismCol(tab, "ism");
+  ArrayColumn<Float> tsmCol(tab, "tsm");
+  for (rownr_t i=0; i<tab.nrow(); ++i) {
+    AlwaysAssertExit (ssmCol(i) == cellValue(i, state[i]));
+    AlwaysAssertExit (ismCol(i) == cellValue(i, state[i]));
+    AlwaysAssertExit (allEQ (tsmCol(i), arrValue(i, state[i])));
+  }
+}
+
+void checkSnapshot (const String& name, const std::vector<Int>& state)
+{
+  Table snap = TableSnapshot::open (tabName, name);
+  AlwaysAssertExit (! snap.isWritable());
+  checkTable (snap, state);
+}
+
+int main()
+{
+  try {
+    std::vector<Int> state0, state1, state2;
+    createTable (state0, 200);
+    {
+      Table tab(tabName, Table::Update);
+      TableSnapshot::create (tab, "s1");
+      AlwaysAssertExit (File(tabName + "/table.snapshots/s1/table.f0.cow").exists());
+      // A snapshot name can only be used once.
+      Bool ok = False;
+      try {
+        TableSnapshot::create (tab, "s1");
+      } catch (TableError&) {
+        ok = True;
+      }
+      AlwaysAssertExit (ok);
+      state1 = state0;
+      updateRows (tab, state1, 10, 30, 1);
+      updateRows (tab, state1, 190, 250, 1);
+      checkSnapshot ("s1", state0);
+      TableSnapshot::create (tab, "s2");
+      state2 = state1;
+      updateRows (tab, state2, 20, 60, 2);
+      checkTable (tab, state2);
+      checkSnapshot ("s1", state0);
+      checkSnapshot ("s1", state0);
+      checkSnapshot ("s2", state1);
+    }
+    AlwaysAssertExit (TableSnapshot::names(tabName).size() == 2);
+    AlwaysAssertExit (TableSnapshot::names(tabName)[1] == "s2");
+    // Reopen the table; the changed blocks still have to be saved.
+    std::vector<Int> state3(state2);
+    {
+      Table tab(tabName, Table::Update);
+      updateRows (tab, state3, 0, 15, 3);
+      updateRows (tab, state3, 100, 120, 3);
+      checkTable (tab, state3);
+    }
+    checkSnapshot ("s1", state0);
+    checkSnapshot ("s2", state1);
+    // Removing the latest snapshot has to keep the first one intact.
+    TableSnapshot::remove (tabName, "s2");
+    AlwaysAssertExit (TableSnapshot::names(tabName).size() == 1);
+    checkSnapshot ("s1", state0);
+    {
+      Table tab(tabName, Table::Update);
+      updateRows (tab, state3, 150, 170, 4);
+    }
+    checkSnapshot ("s1", state0);
+    // Restore the table and check it has the original contents.
+    TableSnapshot::restore (tabName, "s1");
+    checkTable (Table(tabName), state0);
+    // The snapshot can be used again after the restore.
+    state3 = state0;
+    {
+      Table tab(tabName, Table::Update);
+      updateRows (tab, state3, 0, 200, 5);
+      checkTable (tab, state3);
+    }
+    checkSnapshot ("s1", state0);
+    TableSnapshot::restore (tabName, "s1");
+    checkTable (Table(tabName), state0);
+    TableSnapshot::remove (tabName, "s1");
+    AlwaysAssertExit (TableSnapshot::names(tabName).size() == 0);
+  } catch (std::exception& x) {
+    cout << "Caught an exception: " << x.what() << endl;
+    return 1;
+  }
+  return 0;                           // exit with success status
+}
@@ -0,0 +1,123 @@
+//# retiletable.cc: This program chooses and applies the tile shape of a column
+//# Copyright (C) 2026
+//# Associated Universities, Inc. Washington DC, USA.
+//#
+//# This program is free software; you can redistribute it and/or modify it
+//# under the terms of the GNU General Public License as published by the Free
+//# Software Foundation; either version 2 of the License, or (at your option)
+//# any later version.
+//#
+//# This program is distributed in the hope that it will be useful, but WITHOUT
+//# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+//# FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+//# more details.
+//#
+//# You should have received a copy of the GNU General Public License along
+//# with this program; if not, write to the Free Software Foundation, Inc.,
+//# 675 Massachusetts Ave, Cambridge, MA 02139, USA.
+//#
+//# Correspondence concerning AIPS++ should be addressed as follows:
+//#        Internet email: aips2-request@nrao.edu.
+//#        Postal address: AIPS++ Project Office
+//#                        National Radio Astronomy Observatory
+//#                        520 Edgemont Road
+//#                        Charlottesville, VA 22903-2475 USA
+
+#include <casacore/tables/DataMan/TSMLayoutOptimizer.h>
+#include <casacore/tables/Tables/Table.h>
+#include <casacore/casa/Inputs/Input.h>
+#include <casacore/casa/Containers/Block.h>
+#include <iostream>
+
+using namespace casacore;
+using namespace std;
+
+// Convert the values given for a shape parameter.
+IPosition toShape (const Block<Int>& values)
+{
+  IPosition shape(values.size());
+  for (uInt i=0; i<values.size(); ++i) {
+    shape[i] = values[i];
+  }
+  return shape;
+}
+
+int main (int argc, char* argv[])
+{
+  try {
+    // Read the input parameters.
+    Input inputs(1);
+    inputs.version("2026Oct18");
+    inputs.create("in", "", "Input table", "string");
+    inputs.create("column", "", "Tiled column to optimize", "string");
+    inputs.create("trace", "", "TableTrace file with the column accesses",
+                  "string");
+    inputs.create("traversal", "",
+                  "Cursor shape of a traversal to add (incl. row axis)",
+                  "string");
+    inputs.create("tilesize", "1024", "Tile size to aim at (KiB)", "int");
+    inputs.create("cachesize", "128", "Tile cache size (MiB)", "int");
+    inputs.create("tileshape", "",
+                  "Tile shape to use instead of the best one", "string");
+    inputs.create("apply", "F", "Rewrite the column with the new tile shape?",
+                  "bool");
+    inputs.readArguments(argc, argv);
+
+    String in     (inputs.getString("in"));
+    String column (inputs.getString("column"));
+    if (in.empty()  ||  column.empty()) {
+      cerr << "in and column must be given" << endl;
+      return 1;
+    }
+    String trace     (inputs.getString("trace"));
+    String traversal (inputs.getString("traversal"));
+    Int  tileSize  = inputs.getInt ("tilesize");
+    Int  cacheSize = inputs.getInt ("cachesize");
+    String tileShapeStr (inputs.getString("tileshape"));
+    Bool apply     = inputs.getBool("apply");
+
+    Table tab(in, apply ? Table::Update : Table::Old);
+    TSMLayoutOptimizer opt(tab, column);
+    opt.setCacheSize (uInt64(cacheSize) * 1024*1024);
+    if (! trace.empty()) {
+      uInt n = opt.addTrace (trace, column, in);
+      cout << "Found " << n << " accesses of column " << column
+           << " in " << trace << endl;
+    }
+    if (! traversal.empty()) {
+      opt.addTraversal (toShape (inputs.getIntArray("traversal")));
+    }
+    cout << "Hypercube shape:    " << opt.cubeShape() << endl;
+    IPosition tileShape;
+    if (! tileShapeStr.empty()) {
+      tileShape = toShape (inputs.getIntArray("tileshape"));
+    } else if (opt.naccess() == 0) {
+      cerr << "No accesses found; use trace or traversal" << endl;
+      return 1;
+    } else {
+      tileShape = opt.bestTileShape (uInt64(tileSize) * 1024);
+    }
+    if (opt.naccess() > 0) {
+      cout << "Current tile shape: " << opt.currentTileShape()
+           << "  cost=" << opt.cost(opt.currentTileShape()) << endl;
+      cout << "New tile shape:     " << tileShape
+           << "  cost=" << opt.cost(tileShape) << endl;
+    } else {
+      cout << "Current tile shape: " << opt.currentTileShape() << endl;
+      cout << "New tile shape:     " << tileShape << endl;
+    }
+    if (apply) {
+      if (tileShape.isEqual (opt.currentTileShape())) {
+        cout << "Tile shape is unchanged; column is not rewritten" << endl;
+      } else {
+        String dmName = TSMLayoutOptimizer::retile (tab, column, tileShape);
+        cout << "Rewritten column " << column << " using data manager "
+             << dmName << endl;
+      }
+    }
+  } catch (std::exception& x) {
+    cerr << x.what() << endl;
+    return 1;
+  }
+  return 0;
+}